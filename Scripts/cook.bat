@@ -22,6 +22,15 @@ echo ============================================================
 echo Project: %PROJECT_FILE%
 echo.
 
+REM SpecPack JSON -> SpecPacks.tpfspec (validated; fails the cook on bad packs)
+"%UE_CMD%" "%PROJECT_FILE%" -run=SpecPackCook
+
+if %ERRORLEVEL% NEQ 0 (
+    echo.
+    echo [ERROR] SpecPack cook failed with error code %ERRORLEVEL%
+    exit /b %ERRORLEVEL%
+)
+
 "%UE_CMD%" "%PROJECT_FILE%" -run=cook -targetplatform=%COOK_PLATFORM% -iterate -unversioned
 
 if %ERRORLEVEL% NEQ 0 (
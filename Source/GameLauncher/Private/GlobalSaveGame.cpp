@@ -4,6 +4,7 @@
 #include "GlobalSaveGame.h"
 #include "GameFramework/GameUserSettings.h"
 #include "Kismet/GameplayStatics.h"
+#include "Misc/CoreDelegates.h"
 
 UGlobalSaveGame::UGlobalSaveGame()
 {
@@ -43,9 +44,9 @@ void UGlobalSaveGame::InitializeDefaults()
 	UE_LOG(LogTemp, Log, TEXT("GlobalSaveGame::InitializeDefaults - Initialized with system defaults"));
 }
 
-void UGlobalSaveGame::ApplySettings()
+void UGlobalSaveGame::ApplySettings(bool bDeferDisplayChanges)
 {
-	ApplyGraphicsSettings();
+	ApplyGraphicsSettings(bDeferDisplayChanges);
 	ApplyAudioSettings();
 	ApplyInputSettings();
 
@@ -57,8 +58,12 @@ void UGlobalSaveGame::CaptureCurrentSettings()
 	// Capture from engine
 	if (UGameUserSettings* Settings = UGameUserSettings::GetGameUserSettings())
 	{
-		Resolution = Settings->GetScreenResolution();
-		WindowMode = Settings->GetFullscreenMode();
+		// A deferred display change has not reached the engine yet; keep ours
+		if (!DeferredDisplayHandle.IsValid())
+		{
+			Resolution = Settings->GetScreenResolution();
+			WindowMode = Settings->GetFullscreenMode();
+		}
 		bVSyncEnabled = Settings->IsVSyncEnabled();
 		ViewDistanceQuality = Settings->GetViewDistanceQuality();
 		AntiAliasingQuality = Settings->GetAntiAliasingQuality();
@@ -128,7 +133,7 @@ void UGlobalSaveGame::ApplyGraphicsPreset(EGraphicsQuality Preset)
 // Protected Methods
 // ========================================
 
-void UGlobalSaveGame::ApplyGraphicsSettings()
+void UGlobalSaveGame::ApplyGraphicsSettings(bool bDeferDisplayChanges)
 {
 	UGameUserSettings* Settings = UGameUserSettings::GetGameUserSettings();
 	if (!Settings)
@@ -137,35 +142,109 @@ void UGlobalSaveGame::ApplyGraphicsSettings()
 		return;
 	}
 
-	// Apply resolution and window mode
-	Settings->SetScreenResolution(Resolution);
-	Settings->SetFullscreenMode(WindowMode);
-	Settings->SetVSyncEnabled(bVSyncEnabled);
+	// Only touch what differs from the engine's current state; on a normal startup
+	// GameUserSettings.ini already matches and nothing is applied
+	bool bChanged = false;
+
+	if (Settings->IsVSyncEnabled() != bVSyncEnabled)
+	{
+		Settings->SetVSyncEnabled(bVSyncEnabled);
+		bChanged = true;
+	}
+
+	// Frame rate limit (0 = unlimited)
+	const float DesiredFrameRateLimit = FrameRateLimit > 0 ? static_cast<float>(FrameRateLimit) : 0.0f;
+	if (!FMath::IsNearlyEqual(Settings->GetFrameRateLimit(), DesiredFrameRateLimit))
+	{
+		Settings->SetFrameRateLimit(DesiredFrameRateLimit);
+		bChanged = true;
+	}
+
+	// Individual quality settings
+	auto ApplyQuality = [&bChanged](int32 Current, int32 Desired, auto&& Setter)
+	{
+		if (Current != Desired)
+		{
+			Setter(Desired);
+			bChanged = true;
+		}
+	};
+	ApplyQuality(Settings->GetViewDistanceQuality(), ViewDistanceQuality, [Settings](int32 Value) { Settings->SetViewDistanceQuality(Value); });
+	ApplyQuality(Settings->GetAntiAliasingQuality(), AntiAliasingQuality, [Settings](int32 Value) { Settings->SetAntiAliasingQuality(Value); });
+	ApplyQuality(Settings->GetShadowQuality(), ShadowQuality, [Settings](int32 Value) { Settings->SetShadowQuality(Value); });
+	ApplyQuality(Settings->GetPostProcessingQuality(), PostProcessQuality, [Settings](int32 Value) { Settings->SetPostProcessingQuality(Value); });
+	ApplyQuality(Settings->GetTextureQuality(), TextureQuality, [Settings](int32 Value) { Settings->SetTextureQuality(Value); });
+	ApplyQuality(Settings->GetVisualEffectQuality(), EffectsQuality, [Settings](int32 Value) { Settings->SetVisualEffectQuality(Value); });
+	ApplyQuality(Settings->GetFoliageQuality(), FoliageQuality, [Settings](int32 Value) { Settings->SetFoliageQuality(Value); });
+	ApplyQuality(Settings->GetShadingQuality(), ShadingQuality, [Settings](int32 Value) { Settings->SetShadingQuality(Value); });
+
+	if (bChanged)
+	{
+		// Scalability, VSync and frame rate only; leaves the swapchain alone
+		Settings->ApplyNonResolutionSettings();
+	}
+
+	// Resolution and window mode
+	const bool bDisplayDiffers = Settings->GetScreenResolution() != Resolution || Settings->GetFullscreenMode() != WindowMode;
+	if (bDisplayDiffers && bDeferDisplayChanges)
+	{
+		if (!DeferredDisplayHandle.IsValid())
+		{
+			DeferredDisplayHandle = FCoreDelegates::OnEndFrame.AddUObject(this, &UGlobalSaveGame::HandleDeferredDisplaySettings);
+		}
+		UE_LOG(LogTemp, Log, TEXT("GlobalSaveGame::ApplyGraphicsSettings - Display change to %dx%d deferred to end of frame"),
+			Resolution.X, Resolution.Y);
+	}
+	else if (bDisplayDiffers)
+	{
+		bChanged |= ApplyDisplaySettings();
+	}
 
-	// Apply frame rate limit
-	if (FrameRateLimit > 0)
+	if (bChanged)
 	{
-		Settings->SetFrameRateLimit(static_cast<float>(FrameRateLimit));
+		Settings->SaveSettings();
+		UE_LOG(LogTemp, Log, TEXT("GlobalSaveGame::ApplyGraphicsSettings - Graphics settings applied"));
 	}
 	else
 	{
-		Settings->SetFrameRateLimit(0.0f); // Unlimited
+		UE_LOG(LogTemp, Verbose, TEXT("GlobalSaveGame::ApplyGraphicsSettings - Graphics settings unchanged"));
+	}
+}
+
+bool UGlobalSaveGame::ApplyDisplaySettings()
+{
+	UGameUserSettings* Settings = UGameUserSettings::GetGameUserSettings();
+	if (!Settings)
+	{
+		return false;
+	}
+
+	if (Settings->GetScreenResolution() == Resolution && Settings->GetFullscreenMode() == WindowMode)
+	{
+		return false;
 	}
 
-	// Apply individual quality settings
-	Settings->SetViewDistanceQuality(ViewDistanceQuality);
-	Settings->SetAntiAliasingQuality(AntiAliasingQuality);
-	Settings->SetShadowQuality(ShadowQuality);
-	Settings->SetPostProcessingQuality(PostProcessQuality);
-	Settings->SetTextureQuality(TextureQuality);
-	Settings->SetVisualEffectQuality(EffectsQuality);
-	Settings->SetFoliageQuality(FoliageQuality);
-	Settings->SetShadingQuality(ShadingQuality);
+	Settings->SetScreenResolution(Resolution);
+	Settings->SetFullscreenMode(WindowMode);
+	Settings->ApplyResolutionSettings(false);
 
-	// Apply settings (validate and save)
-	Settings->ApplySettings(false);
+	UE_LOG(LogTemp, Log, TEXT("GlobalSaveGame::ApplyDisplaySettings - Display set to %dx%d (mode %d)"),
+		Resolution.X, Resolution.Y, static_cast<int32>(WindowMode.GetValue()));
+	return true;
+}
 
-	UE_LOG(LogTemp, Log, TEXT("GlobalSaveGame::ApplyGraphicsSettings - Graphics settings applied"));
+void UGlobalSaveGame::HandleDeferredDisplaySettings()
+{
+	FCoreDelegates::OnEndFrame.Remove(DeferredDisplayHandle);
+	DeferredDisplayHandle.Reset();
+
+	if (ApplyDisplaySettings())
+	{
+		if (UGameUserSettings* Settings = UGameUserSettings::GetGameUserSettings())
+		{
+			Settings->SaveSettings();
+		}
+	}
 }
 
 void UGlobalSaveGame::ApplyAudioSettings()
@@ -5,29 +5,68 @@
 #include "GlobalSaveGame.h"
 #include "MenuSubsystem.h"
 #include "ModuleLoaderSubsystem.h"
+#include "Subsystems/CoreDataWarmupSubsystem.h"
+#include "TPFTimingRecorder.h"
 #include "Kismet/GameplayStatics.h"
 
+namespace
+{
+	const TCHAR* StartupTimingSession = TEXT("Startup");
+}
+
 ULauncherGameInstance::ULauncherGameInstance()
 {
 }
 
 void ULauncherGameInstance::Init()
 {
-	Super::Init();
+	// Boot timings from here until the core data is ready (Saved/Profiling/TPFTiming)
+	FTPFTimingRecorder::Get().BeginSession(StartupTimingSession);
+
+	UCoreDataWarmupSubsystem* Warmup = nullptr;
+	{
+		TPF_TIMING_SCOPE(TEXT("LauncherGameInstance::Init"));
+
+		Super::Init();
 
-	UE_LOG(LogTemp, Log, TEXT("LauncherGameInstance::Init - Initializing launcher"));
+		UE_LOG(LogTemp, Log, TEXT("LauncherGameInstance::Init - Initializing launcher"));
 
-	// Load global settings
-	LoadGlobalSettings();
+		// Initialize subsystems (they will auto-register)
+		// MenuSubsystem and ModuleLoaderSubsystem are created automatically
 
-	// Initialize subsystems (they will auto-register)
-	// MenuSubsystem and ModuleLoaderSubsystem are created automatically
+		// Settings, star catalog, solar system and module data load in parallel
+		Warmup = GetSubsystem<UCoreDataWarmupSubsystem>();
+		if (Warmup)
+		{
+			Warmup->AddWarmupTask(TEXT("GlobalSettings"), {}, [this](FSimpleDelegate OnDone)
+			{
+				LoadGlobalSettingsAsync(MoveTemp(OnDone));
+			});
+			Warmup->BeginWarmup();
+		}
+		else
+		{
+			LoadGlobalSettings();
+		}
+	}
+
+	if (Warmup)
+	{
+		Warmup->CallWhenCoreDataReady(FSimpleDelegate::CreateLambda([]()
+		{
+			FTPFTimingRecorder::Get().EndSession(StartupTimingSession);
+		}));
+	}
+	else
+	{
+		FTPFTimingRecorder::Get().EndSession(StartupTimingSession);
+	}
 }
 
 void ULauncherGameInstance::Shutdown()
 {
-	// Save global settings on shutdown
-	SaveGlobalSettings();
+	// Save global settings on shutdown; blocking, since the process may exit before a worker write lands
+	SaveGlobalSettings(true);
 
 	Super::Shutdown();
 
@@ -41,18 +80,48 @@ void ULauncherGameInstance::Shutdown()
 void ULauncherGameInstance::LoadGlobalSettings()
 {
 	// Try to load existing save game
+	USaveGame* Loaded = nullptr;
 	if (UGameplayStatics::DoesSaveGameExist(GlobalSettingsSlotName, GlobalSettingsUserIndex))
 	{
-		GlobalSaveGame = Cast<UGlobalSaveGame>(
-			UGameplayStatics::LoadGameFromSlot(GlobalSettingsSlotName, GlobalSettingsUserIndex)
-		);
+		Loaded = UGameplayStatics::LoadGameFromSlot(GlobalSettingsSlotName, GlobalSettingsUserIndex);
+	}
+
+	ApplyLoadedGlobalSettings(Loaded);
+}
+
+void ULauncherGameInstance::LoadGlobalSettingsAsync(FSimpleDelegate OnLoaded)
+{
+	if (!UGameplayStatics::DoesSaveGameExist(GlobalSettingsSlotName, GlobalSettingsUserIndex))
+	{
+		ApplyLoadedGlobalSettings(nullptr);
+		OnLoaded.ExecuteIfBound();
+		return;
+	}
+
+	// Read and deserialized on a worker, completed on the game thread
+	UGameplayStatics::AsyncLoadGameFromSlot(
+		GlobalSettingsSlotName,
+		GlobalSettingsUserIndex,
+		FAsyncLoadGameFromSlotDelegate::CreateWeakLambda(this, [this, OnLoaded](const FString& /*SlotName*/, const int32 /*UserIndex*/, USaveGame* Loaded)
+		{
+			ApplyLoadedGlobalSettings(Loaded);
+			OnLoaded.ExecuteIfBound();
+		})
+	);
+}
+
+void ULauncherGameInstance::ApplyLoadedGlobalSettings(USaveGame* Loaded)
+{
+	if (Loaded)
+	{
+		GlobalSaveGame = Cast<UGlobalSaveGame>(Loaded);
 
 		if (GlobalSaveGame)
 		{
 			UE_LOG(LogTemp, Log, TEXT("LauncherGameInstance::LoadGlobalSettings - Loaded existing settings"));
 			
-			// Apply settings to engine
-			GlobalSaveGame->ApplySettings();
+			// Apply what differs from the engine's state; display mode waits for the first frame
+			GlobalSaveGame->ApplySettings(true);
 		}
 		else
 		{
@@ -80,7 +149,7 @@ void ULauncherGameInstance::LoadGlobalSettings()
 	}
 }
 
-void ULauncherGameInstance::SaveGlobalSettings()
+void ULauncherGameInstance::SaveGlobalSettings(bool bBlocking)
 {
 	if (!GlobalSaveGame)
 	{
@@ -91,20 +160,31 @@ void ULauncherGameInstance::SaveGlobalSettings()
 	// Capture current settings
 	GlobalSaveGame->CaptureCurrentSettings();
 
-	// Save to disk (async, non-blocking)
-	const bool bSuccess = UGameplayStatics::SaveGameToSlot(
+	if (bBlocking)
+	{
+		const bool bSaved = UGameplayStatics::SaveGameToSlot(GlobalSaveGame, GlobalSettingsSlotName, GlobalSettingsUserIndex);
+		HandleGlobalSettingsSaved(GlobalSettingsSlotName, GlobalSettingsUserIndex, bSaved);
+		return;
+	}
+
+	// Save to disk (async, non-blocking): serialized now, written on a worker
+	UGameplayStatics::AsyncSaveGameToSlot(
 		GlobalSaveGame,
 		GlobalSettingsSlotName,
-		GlobalSettingsUserIndex
+		GlobalSettingsUserIndex,
+		FAsyncSaveGameToSlotDelegate::CreateStatic(&ULauncherGameInstance::HandleGlobalSettingsSaved)
 	);
+}
 
+void ULauncherGameInstance::HandleGlobalSettingsSaved(const FString& SlotName, const int32 UserIndex, bool bSuccess)
+{
 	if (bSuccess)
 	{
 		UE_LOG(LogTemp, Log, TEXT("LauncherGameInstance::SaveGlobalSettings - Settings saved successfully"));
 	}
 	else
 	{
-		UE_LOG(LogTemp, Error, TEXT("LauncherGameInstance::SaveGlobalSettings - Failed to save settings"));
+		UE_LOG(LogTemp, Error, TEXT("LauncherGameInstance::SaveGlobalSettings - Failed to save settings to %s"), *SlotName);
 	}
 }
 
@@ -138,3 +218,9 @@ UModuleLoaderSubsystem* ULauncherGameInstance::GetModuleLoaderSubsystem() const
 {
 	return GetSubsystem<UModuleLoaderSubsystem>();
 }
+
+bool ULauncherGameInstance::IsCoreDataReady() const
+{
+	const UCoreDataWarmupSubsystem* Warmup = GetSubsystem<UCoreDataWarmupSubsystem>();
+	return !Warmup || Warmup->IsCoreDataReady();
+}
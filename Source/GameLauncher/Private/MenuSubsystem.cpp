@@ -5,9 +5,12 @@
 #include "LauncherGameInstance.h"
 #include "ModuleLoaderSubsystem.h"
 #include "Kismet/KismetSystemLibrary.h"
+#include "TPFTimingRecorder.h"
 
 void UMenuSubsystem::Initialize(FSubsystemCollectionBase& Collection)
 {
+	TPF_TIMING_SCOPE(TEXT("MenuSubsystem::Initialize"));
+
 	Super::Initialize(Collection);
 
 	UE_LOG(LogTemp, Log, TEXT("MenuSubsystem::Initialize - Menu subsystem initialized"));
@@ -3,9 +3,21 @@
 
 #include "ModuleLoaderSubsystem.h"
 #include "Kismet/GameplayStatics.h"
+#include "Engine/AssetManager.h"
+#include "Engine/StreamableManager.h"
+#include "Engine/GameInstance.h"
+#include "Engine/World.h"
+#include "UObject/Package.h"
+#include "UObject/UObjectGlobals.h"
+#include "Space/Subsystems/StarCatalogSubsystem.h"
+#include "DeltaTypes.h"
+#include "HAL/PlatformTime.h"
+#include "TPFTimingRecorder.h"
 
 void UModuleLoaderSubsystem::Initialize(FSubsystemCollectionBase& Collection)
 {
+	TPF_TIMING_SCOPE(TEXT("ModuleLoaderSubsystem::Initialize"));
+
 	Super::Initialize(Collection);
 
 	UE_LOG(LogTemp, Log, TEXT("ModuleLoaderSubsystem::Initialize - Module loader initialized"));
@@ -14,10 +26,22 @@ void UModuleLoaderSubsystem::Initialize(FSubsystemCollectionBase& Collection)
 	// These can be configured in DefaultGame.ini or via Data Assets
 	ModuleMapPaths.Add(TEXT("SinglePlayerStoryTemplate"), TEXT("/Game/YourGame/Maps/StoryEntry"));
 	// eg. ModuleMapPaths.Add(TEXT("Multiplayer"), TEXT("/Game/_Multiplayer/Maps/MultiplayerEntry"));
+
+	PostLoadMapHandle = FCoreUObjectDelegates::PostLoadMapWithWorld.AddUObject(this, &UModuleLoaderSubsystem::HandlePostLoadMap);
 }
 
 void UModuleLoaderSubsystem::Deinitialize()
 {
+	FCoreUObjectDelegates::PostLoadMapWithWorld.Remove(PostLoadMapHandle);
+	ResetLoadState(true);
+	PreloadedMapWorld = nullptr;
+
+	if (CurrentAssetsHandle.IsValid())
+	{
+		CurrentAssetsHandle->ReleaseHandle();
+		CurrentAssetsHandle.Reset();
+	}
+
 	Super::Deinitialize();
 
 	UE_LOG(LogTemp, Log, TEXT("ModuleLoaderSubsystem::Deinitialize - Module loader shutdown"));
@@ -29,6 +53,13 @@ void UModuleLoaderSubsystem::Deinitialize()
 
 bool UModuleLoaderSubsystem::LoadModule(const FString& ModuleName)
 {
+	if (IsModuleLoading())
+	{
+		UE_LOG(LogTemp, Warning, TEXT("ModuleLoaderSubsystem::LoadModule - Already loading module %s, ignoring %s"),
+			*LoadingModuleName, *ModuleName);
+		return false;
+	}
+
 	if (!ValidateModule(ModuleName))
 	{
 		UE_LOG(LogTemp, Error, TEXT("ModuleLoaderSubsystem::LoadModule - Invalid module: %s"), *ModuleName);
@@ -46,15 +77,194 @@ bool UModuleLoaderSubsystem::LoadModule(const FString& ModuleName)
 	UE_LOG(LogTemp, Log, TEXT("ModuleLoaderSubsystem::LoadModule - Loading module %s at path %s"), 
 		*ModuleName, *MapPath);
 
-	// Open level (non-blocking, shows loading screen)
-	UGameplayStatics::OpenLevel(GetWorld(), FName(*MapPath), true);
+	// Preload and map open are one timing session, closed when the map has loaded
+	FTPFTimingRecorder::Get().BeginSession(GetTimingSessionName(ModuleName), FName(*MapPath));
+	TPF_TIMING_SCOPE(TEXT("ModuleLoaderSubsystem::LoadModule"));
+	LoadStartSeconds = FPlatformTime::Seconds();
 
-	// Update current module
-	CurrentModuleName = ModuleName;
+	LoadingModuleName = ModuleName;
+	LoadingMapPath = MapPath;
+	bLoadFailed = false;
+	const uint32 Serial = ++LoadSerial;
+
+	const FModulePreloadSet* PreloadSet = ModulePreloads.Find(ModuleName);
+
+	// 1. Module assets through the Asset Manager's streamable manager
+	if (PreloadSet && (PreloadSet->PrimaryAssets.Num() > 0 || PreloadSet->Assets.Num() > 0))
+	{
+		if (UAssetManager* AssetManager = UAssetManager::GetIfInitialized())
+		{
+			TArray<FSoftObjectPath> AssetPaths = PreloadSet->Assets;
+			for (const FPrimaryAssetId& PrimaryAssetId : PreloadSet->PrimaryAssets)
+			{
+				const FSoftObjectPath AssetPath = AssetManager->GetPrimaryAssetPath(PrimaryAssetId);
+				if (AssetPath.IsValid())
+				{
+					AssetPaths.Add(AssetPath);
+				}
+				else
+				{
+					UE_LOG(LogTemp, Warning, TEXT("ModuleLoaderSubsystem::LoadModule - Unknown primary asset %s for module %s"),
+						*PrimaryAssetId.ToString(), *ModuleName);
+				}
+			}
+
+			if (AssetPaths.Num() > 0)
+			{
+				LoadingAssetsHandle = AssetManager->GetStreamableManager().RequestAsyncLoad(
+					AssetPaths, FStreamableDelegate(), FStreamableManager::DefaultAsyncLoadPriority,
+					false, false, FString::Printf(TEXT("Module_%s"), *ModuleName));
+			}
+		}
+		else
+		{
+			UE_LOG(LogTemp, Warning, TEXT("ModuleLoaderSubsystem::LoadModule - Asset Manager not initialized, skipping asset preload for %s"),
+				*ModuleName);
+		}
+	}
+
+	// 2. Map package; OpenLevel later finds it in memory instead of loading it blocking
+	bMapPending = true;
+	LoadPackageAsync(MapPath, FLoadPackageAsyncDelegate::CreateWeakLambda(this,
+		[this, Serial](const FName& LoadedPackageName, UPackage* LoadedPackage, EAsyncLoadingResult::Type Result)
+		{
+			if (Serial != LoadSerial)
+			{
+				return;
+			}
+
+			bMapPending = false;
+			if (Result != EAsyncLoadingResult::Succeeded || !LoadedPackage)
+			{
+				UE_LOG(LogTemp, Error, TEXT("ModuleLoaderSubsystem::LoadModule - Failed to load map package %s"),
+					*LoadedPackageName.ToString());
+				bLoadFailed = true;
+				return;
+			}
+
+			// The package alone does not keep its world rooted; hold the UWorld itself
+			PreloadedMapWorld = UWorld::FindWorldInPackage(LoadedPackage);
+			if (!PreloadedMapWorld)
+			{
+				UE_LOG(LogTemp, Error, TEXT("ModuleLoaderSubsystem::LoadModule - Map package %s contains no world"),
+					*LoadedPackageName.ToString());
+				bLoadFailed = true;
+			}
+		}));
+
+	// 3. Star catalog on a worker
+	bStarCatalogPending = false;
+	if (!PreloadSet || PreloadSet->bPreloadStarCatalog)
+	{
+		UStarCatalogSubsystem* StarCatalog = GetGameInstance()->GetSubsystem<UStarCatalogSubsystem>();
+		if (StarCatalog && !StarCatalog->IsLoaded())
+		{
+			bStarCatalogPending = true;
+			StarCatalog->EnsureLoadedAsync(FOnStarCatalogReady::CreateWeakLambda(this, [this, Serial](bool bLoaded)
+			{
+				if (Serial != LoadSerial)
+				{
+					return;
+				}
+
+				bStarCatalogPending = false;
+				if (!bLoaded)
+				{
+					// Not fatal: the sky falls back to its procedural starfield
+					UE_LOG(LogTemp, Warning, TEXT("ModuleLoaderSubsystem::LoadModule - Star catalog failed to load"));
+				}
+			}));
+		}
+	}
+
+	// 4. Gameplay module work (SpecPacks, save data)
+	OnGatherModulePreloads().Broadcast(ModuleName, *this);
+
+	// 5. Poll until everything is resident
+	LoadTickerHandle = FTSTicker::GetCoreTicker().AddTicker(
+		FTickerDelegate::CreateUObject(this, &UModuleLoaderSubsystem::TickModuleLoad));
 
 	return true;
 }
 
+void UModuleLoaderSubsystem::CancelModuleLoad()
+{
+	if (!IsModuleLoading())
+	{
+		return;
+	}
+
+	const FString CancelledModule = LoadingModuleName;
+	UE_LOG(LogTemp, Log, TEXT("ModuleLoaderSubsystem::CancelModuleLoad - Cancelled loading module %s"), *CancelledModule);
+
+	ResetLoadState(true);
+	PreloadedMapWorld = nullptr;
+	FTPFTimingRecorder::Get().EndSession(GetTimingSessionName(CancelledModule), false);
+	OnModuleLoadFinished.Broadcast(CancelledModule, false);
+}
+
+float UModuleLoaderSubsystem::GetModuleLoadProgress() const
+{
+	if (!IsModuleLoading())
+	{
+		return IsModuleLoaded() ? 1.0f : 0.0f;
+	}
+
+	// Average of the parts of this load, each 0..1
+	float Sum = 0.0f;
+	int32 Parts = 0;
+
+	if (LoadingAssetsHandle.IsValid())
+	{
+		Sum += LoadingAssetsHandle->GetProgress();
+		++Parts;
+	}
+
+	{
+		float MapProgress = 1.0f;
+		if (bMapPending)
+		{
+			const float Percent = GetAsyncLoadPercentage(FName(*LoadingMapPath));
+			MapProgress = Percent >= 0.0f ? FMath::Clamp(Percent / 100.0f, 0.0f, 0.99f) : 0.0f;
+		}
+		Sum += MapProgress;
+		++Parts;
+	}
+
+	if (bStarCatalogPending)
+	{
+		++Parts;
+	}
+
+	if (TotalTasks > 0)
+	{
+		Sum += 1.0f - static_cast<float>(PendingTasks.Num()) / TotalTasks;
+		++Parts;
+	}
+
+	return Sum / Parts;
+}
+
+int32 UModuleLoaderSubsystem::BeginPreloadTask()
+{
+	if (!IsModuleLoading())
+	{
+		UE_LOG(LogTemp, Warning, TEXT("ModuleLoaderSubsystem::BeginPreloadTask - No module load in flight"));
+		return INDEX_NONE;
+	}
+
+	const int32 TaskToken = NextTaskToken++;
+	PendingTasks.Add(TaskToken);
+	++TotalTasks;
+	return TaskToken;
+}
+
+void UModuleLoaderSubsystem::CompletePreloadTask(int32 TaskToken)
+{
+	check(IsInGameThread());
+	PendingTasks.Remove(TaskToken);
+}
+
 void UModuleLoaderSubsystem::UnloadCurrentModule()
 {
 	if (!IsModuleLoaded())
@@ -69,6 +279,15 @@ void UModuleLoaderSubsystem::UnloadCurrentModule()
 	// Clear current module
 	CurrentModuleName.Empty();
 
+	// Preloaded assets become collectable once the module's world is gone
+	if (CurrentAssetsHandle.IsValid())
+	{
+		CurrentAssetsHandle->ReleaseHandle();
+		CurrentAssetsHandle.Reset();
+	}
+
+	IDeltaStore::OnPreLevelTransition().Broadcast();
+
 	// Return to main menu
 	UGameplayStatics::OpenLevel(GetWorld(), FName(*MenuMapPath), true);
 }
@@ -103,3 +322,104 @@ FString UModuleLoaderSubsystem::GetModuleMapPath(const FString& ModuleName) cons
 	}
 	return FString();
 }
+
+bool UModuleLoaderSubsystem::TickModuleLoad(float DeltaTime)
+{
+	if (!IsModuleLoading())
+	{
+		LoadTickerHandle.Reset();
+		return false;
+	}
+
+	if (bLoadFailed)
+	{
+		const FString FailedModule = LoadingModuleName;
+		ResetLoadState(true);
+		PreloadedMapWorld = nullptr;
+		FTPFTimingRecorder::Get().EndSession(GetTimingSessionName(FailedModule), false);
+		OnModuleLoadFinished.Broadcast(FailedModule, false);
+		return false;
+	}
+
+	const bool bAssetsPending = LoadingAssetsHandle.IsValid() && LoadingAssetsHandle->IsLoadingInProgress();
+	if (bAssetsPending || bMapPending || bStarCatalogPending || PendingTasks.Num() > 0)
+	{
+		OnModuleLoadProgress.Broadcast(LoadingModuleName, GetModuleLoadProgress());
+		return true;
+	}
+
+	OnModuleLoadProgress.Broadcast(LoadingModuleName, 1.0f);
+	FinishModuleLoad();
+	return false;
+}
+
+void UModuleLoaderSubsystem::FinishModuleLoad()
+{
+	const FString ModuleName = LoadingModuleName;
+	const FString MapPath = LoadingMapPath;
+
+	// Previous module's assets go with its world; the new set is already resident
+	if (CurrentAssetsHandle.IsValid())
+	{
+		CurrentAssetsHandle->ReleaseHandle();
+	}
+	CurrentAssetsHandle = LoadingAssetsHandle;
+	LoadingAssetsHandle.Reset();
+
+	ResetLoadState(false);
+
+	FTPFTimingRecorder::Get().RecordPhase(TEXT("ModuleLoader.Preload"), LoadStartSeconds, FPlatformTime::Seconds());
+	UE_LOG(LogTemp, Log, TEXT("ModuleLoaderSubsystem::FinishModuleLoad - Module %s resident, opening %s"),
+		*ModuleName, *MapPath);
+
+	// Let delta stores persist the outgoing map before it unloads
+	IDeltaStore::OnPreLevelTransition().Broadcast();
+
+	// Map is already in memory (held by PreloadedMapWorld), so the switch is short
+	UGameplayStatics::OpenLevel(GetWorld(), FName(*MapPath), true);
+
+	// Update current module
+	CurrentModuleName = ModuleName;
+
+	OnModuleLoadFinished.Broadcast(ModuleName, true);
+}
+
+FString UModuleLoaderSubsystem::GetTimingSessionName(const FString& ModuleName)
+{
+	return TEXT("ModuleLoad_") + ModuleName;
+}
+
+void UModuleLoaderSubsystem::ResetLoadState(bool bCancelAssets)
+{
+	if (LoadTickerHandle.IsValid())
+	{
+		FTSTicker::GetCoreTicker().RemoveTicker(LoadTickerHandle);
+		LoadTickerHandle.Reset();
+	}
+
+	if (LoadingAssetsHandle.IsValid())
+	{
+		if (bCancelAssets)
+		{
+			LoadingAssetsHandle->CancelHandle();
+		}
+		LoadingAssetsHandle.Reset();
+	}
+
+	// Outstanding callbacks compare against this and drop themselves
+	++LoadSerial;
+
+	LoadingModuleName.Empty();
+	LoadingMapPath.Empty();
+	bMapPending = false;
+	bStarCatalogPending = false;
+	bLoadFailed = false;
+	PendingTasks.Reset();
+	TotalTasks = 0;
+}
+
+void UModuleLoaderSubsystem::HandlePostLoadMap(UWorld* LoadedWorld)
+{
+	// The world now references everything it needs from its package
+	PreloadedMapWorld = nullptr;
+}
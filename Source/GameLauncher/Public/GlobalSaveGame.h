@@ -34,6 +34,10 @@ enum class EGraphicsQuality : uint8
  * 
  * Saved asynchronously to avoid blocking gameplay.
  * Hot-reload safe with version serialization.
+ * 
+ * Applying is diffed against the live UGameUserSettings: only values that differ
+ * are set, and nothing is applied when nothing changed. Resolution and window mode
+ * (which can recreate the swapchain) can be deferred until the end of the first frame.
  */
 UCLASS()
 class GAMELAUNCHER_API UGlobalSaveGame : public USaveGame
@@ -167,9 +171,12 @@ public:
 
 	/**
 	 * Apply all settings to engine/game
+	 * 
+	 * @param bDeferDisplayChanges - Apply resolution/window mode changes at the end of the
+	 *                               current frame instead of now (startup path)
 	 */
 	UFUNCTION(BlueprintCallable, Category = "Save Game")
-	void ApplySettings();
+	void ApplySettings(bool bDeferDisplayChanges = false);
 
 	/**
 	 * Capture current settings from engine/game
@@ -185,9 +192,18 @@ public:
 
 protected:
 	/**
-	 * Apply graphics settings to engine
+	 * Apply graphics settings to engine (changed values only)
+	 */
+	void ApplyGraphicsSettings(bool bDeferDisplayChanges);
+
+	/**
+	 * Apply resolution and window mode if they differ from the engine's
+	 * @return true if the display mode was changed
 	 */
-	void ApplyGraphicsSettings();
+	bool ApplyDisplaySettings();
+
+	/** End-of-frame callback for deferred display changes */
+	void HandleDeferredDisplaySettings();
 
 	/**
 	 * Apply audio settings to engine
@@ -198,4 +214,7 @@ protected:
 	 * Apply input settings to engine
 	 */
 	void ApplyInputSettings();
+
+	/** Set while display changes wait for the end of the frame */
+	FDelegateHandle DeferredDisplayHandle;
 };
@@ -8,6 +8,7 @@
 #include "LauncherGameInstance.generated.h"
 
 class UGlobalSaveGame;
+class USaveGame;
 class UMenuSubsystem;
 class UModuleLoaderSubsystem;
 
@@ -16,6 +17,7 @@ class UModuleLoaderSubsystem;
  * 
  * Main game instance for the launcher.
  * Manages:
+ * - Startup warm-up: settings and core data load in parallel (UCoreDataWarmupSubsystem)
  * - Global settings (graphics, audio, controls)
  * - Module loading/unloading
  * - Persistent state across level transitions
@@ -39,16 +41,23 @@ public:
 	// ========================================
 
 	/**
-	 * Load global settings from save game
+	 * Load global settings from save game (blocking)
 	 */
 	UFUNCTION(BlueprintCallable, Category = "Launcher|Settings")
 	void LoadGlobalSettings();
 
 	/**
-	 * Save global settings to save game
+	 * Load global settings on a worker; OnLoaded runs on the game thread once applied
+	 */
+	void LoadGlobalSettingsAsync(FSimpleDelegate OnLoaded);
+
+	/**
+	 * Save global settings to save game (asynchronous write)
+	 * 
+	 * @param bBlocking - Write on the calling thread instead (Shutdown, where a worker write could be cut off)
 	 */
 	UFUNCTION(BlueprintCallable, Category = "Launcher|Settings")
-	void SaveGlobalSettings();
+	void SaveGlobalSettings(bool bBlocking = false);
 
 	/**
 	 * Get global save game object
@@ -56,6 +65,12 @@ public:
 	UFUNCTION(BlueprintPure, Category = "Launcher|Settings")
 	UGlobalSaveGame* GetGlobalSaveGame() const { return GlobalSaveGame; }
 
+	/**
+	 * True once settings, star catalog, solar system and module warm-up tasks are done
+	 */
+	UFUNCTION(BlueprintPure, Category = "Launcher|Startup")
+	bool IsCoreDataReady() const;
+
 	// ========================================
 	// Module Management
 	// ========================================
@@ -114,4 +129,14 @@ protected:
 	 */
 	UPROPERTY(EditDefaultsOnly, Category = "Settings")
 	int32 GlobalSettingsUserIndex = 0;
+
+	/**
+	 * Use a loaded save game, or create and save defaults when there is none
+	 */
+	void ApplyLoadedGlobalSettings(USaveGame* Loaded);
+
+	/**
+	 * Completion of the async settings write (game thread)
+	 */
+	static void HandleGlobalSettingsSaved(const FString& SlotName, const int32 UserIndex, bool bSuccess);
 };
@@ -5,8 +5,50 @@
 
 #include "CoreMinimal.h"
 #include "Subsystems/GameInstanceSubsystem.h"
+#include "UObject/PrimaryAssetId.h"
+#include "UObject/SoftObjectPath.h"
+#include "Containers/Ticker.h"
 #include "ModuleLoaderSubsystem.generated.h"
 
+class UModuleLoaderSubsystem;
+class UWorld;
+struct FStreamableHandle;
+
+/**
+ * Everything a module needs resident before its world opens.
+ */
+USTRUCT(BlueprintType)
+struct GAMELAUNCHER_API FModulePreloadSet
+{
+	GENERATED_BODY()
+
+	/** Primary assets resolved through the Asset Manager */
+	UPROPERTY(EditDefaultsOnly, Category = "Module Loader")
+	TArray<FPrimaryAssetId> PrimaryAssets;
+
+	/** Additional assets loaded by path */
+	UPROPERTY(EditDefaultsOnly, Category = "Module Loader")
+	TArray<FSoftObjectPath> Assets;
+
+	/** Load the star catalog (binary cache or CSV) on a worker before opening the map */
+	UPROPERTY(EditDefaultsOnly, Category = "Module Loader")
+	bool bPreloadStarCatalog = true;
+};
+
+/** Fired while a module loads (0..1) */
+DECLARE_MULTICAST_DELEGATE_TwoParams(FOnModuleLoadProgress, const FString& /*ModuleName*/, float /*Progress01*/);
+
+/** Fired once the module's world has been opened, or the load failed */
+DECLARE_MULTICAST_DELEGATE_TwoParams(FOnModuleLoadFinished, const FString& /*ModuleName*/, bool /*bSuccess*/);
+
+/**
+ * Fired when a module load starts, so gameplay modules can add their own preload
+ * work (e.g. SpecPacks) with BeginPreloadTask / CompletePreloadTask.
+ * The launcher does not depend on gameplay modules, so this is the only way in;
+ * it is static so modules can bind from StartupModule, before any game instance exists.
+ */
+DECLARE_MULTICAST_DELEGATE_TwoParams(FOnGatherModulePreloads, const FString& /*ModuleName*/, UModuleLoaderSubsystem& /*Loader*/);
+
 /**
  * UModuleLoaderSubsystem
  * 
@@ -17,6 +59,19 @@
  * - Module state persistence
  * - Loading screen coordination
  * 
+ * Async Load Pipeline (LoadModule):
+ * 1. The module's FModulePreloadSet is requested through the Asset Manager's
+ *    FStreamableManager (primary assets + asset paths)
+ * 2. The module map package is loaded with LoadPackageAsync
+ * 3. The star catalog loads on a worker (UStarCatalogSubsystem::EnsureLoadedAsync);
+ *    ephemeris tables are built when UETPFCore's solar system subsystem initializes
+ * 4. OnGatherModulePreloads() lets gameplay modules add tasks (SpecPacks, save data)
+ * 5. OnModuleLoadProgress reports the combined progress every frame
+ * 6. Only when everything is resident does the world switch (OpenLevel finds the
+ *    map's world already loaded); preloaded assets stay referenced until unload
+ * 
+ * The current world keeps ticking and rendering throughout, so menus stay live.
+ * 
  * Supports modular architecture where gameplay modules (SinglePlayerStoryTemplate, Multiplayer)
  * can be loaded on demand.
  */
@@ -35,13 +90,48 @@ public:
 
 	/**
 	 * Load a gameplay module by name
+	 * Preloads the module's assets and map in the background, then opens its map.
 	 * 
 	 * @param ModuleName - Name of module (e.g., "SinglePlayerStoryTemplate", "Multiplayer")
-	 * @return true if loading initiated successfully
+	 * @return true if loading initiated successfully (false if invalid or another load is in flight)
 	 */
 	UFUNCTION(BlueprintCallable, Category = "Module Loader")
 	bool LoadModule(const FString& ModuleName);
 
+	/**
+	 * Abandon an in-flight module load; the current world stays.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Module Loader")
+	void CancelModuleLoad();
+
+	/**
+	 * Check if a module load is in flight
+	 */
+	UFUNCTION(BlueprintPure, Category = "Module Loader")
+	bool IsModuleLoading() const { return !LoadingModuleName.IsEmpty(); }
+
+	/**
+	 * Progress of the in-flight module load (0..1)
+	 */
+	UFUNCTION(BlueprintPure, Category = "Module Loader")
+	float GetModuleLoadProgress() const;
+
+	/**
+	 * Add a preload task to the in-flight load (from OnGatherModulePreloads()).
+	 * The world does not switch until every task is completed.
+	 * 
+	 * @return Token to pass to CompletePreloadTask
+	 */
+	int32 BeginPreloadTask();
+
+	/** Finish a task started with BeginPreloadTask (game thread) */
+	void CompletePreloadTask(int32 TaskToken);
+
+	static FOnGatherModulePreloads& OnGatherModulePreloads() { static FOnGatherModulePreloads Delegate; return Delegate; }
+
+	FOnModuleLoadProgress OnModuleLoadProgress;
+	FOnModuleLoadFinished OnModuleLoadFinished;
+
 	/**
 	 * Unload the currently loaded module and return to menu
 	 */
@@ -79,12 +169,50 @@ protected:
 	UPROPERTY(EditDefaultsOnly, Category = "Module Loader")
 	TMap<FString, FString> ModuleMapPaths;
 
+	/**
+	 * Assets to have resident before each module's map opens
+	 */
+	UPROPERTY(EditDefaultsOnly, Category = "Module Loader")
+	TMap<FString, FModulePreloadSet> ModulePreloads;
+
 	/**
 	 * Default menu map to return to on unload
 	 */
 	UPROPERTY(EditDefaultsOnly, Category = "Module Loader")
 	FString MenuMapPath = TEXT("/Game/_Launcher/Maps/MainMenu");
 
+	/** Module being loaded (empty when idle) */
+	FString LoadingModuleName;
+
+	/** Map package of the module being loaded */
+	FString LoadingMapPath;
+
+	/** Assets requested for the module being loaded */
+	TSharedPtr<FStreamableHandle> LoadingAssetsHandle;
+
+	/** Assets of the current module; held until it unloads or another module replaces it */
+	TSharedPtr<FStreamableHandle> CurrentAssetsHandle;
+
+	/** Keeps the preloaded map's world (and with it the package) alive until the world switches */
+	UPROPERTY()
+	TObjectPtr<UWorld> PreloadedMapWorld;
+
+	/** Parts of the load still outstanding */
+	bool bMapPending = false;
+	bool bStarCatalogPending = false;
+	bool bLoadFailed = false;
+	TSet<int32> PendingTasks;
+	int32 NextTaskToken = 1;
+	int32 TotalTasks = 0;
+
+	/** Bumped per LoadModule so callbacks from a cancelled load are ignored */
+	uint32 LoadSerial = 0;
+
+	/** When the current load began (FPlatformTime::Seconds), for the timing session */
+	double LoadStartSeconds = 0.0;
+
+	FTSTicker::FDelegateHandle LoadTickerHandle;
+
 	// ========================================
 	// Internal Methods
 	// ========================================
@@ -98,4 +226,21 @@ protected:
 	 * Get map path for module
 	 */
 	FString GetModuleMapPath(const FString& ModuleName) const;
+
+	/** Polls progress; switches worlds once nothing is pending */
+	bool TickModuleLoad(float DeltaTime);
+
+	/** Open the module's map (everything resident) */
+	void FinishModuleLoad();
+
+	/** Drop in-flight state; bCancelAssets also cancels the asset request */
+	void ResetLoadState(bool bCancelAssets);
+
+	/** TPF timing session covering a module's load and map open */
+	static FString GetTimingSessionName(const FString& ModuleName);
+
+	/** Releases the map package once the new world is up */
+	void HandlePostLoadMap(UWorld* LoadedWorld);
+
+	FDelegateHandle PostLoadMapHandle;
 };
@@ -0,0 +1,649 @@
+// Copyright 2026 Threaded Pixel Factory
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "DeltaCellFormat.h"
+#include "Serialization/MemoryWriter.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/ArchiveProxy.h"
+#include "Misc/Compression.h"
+#include "JsonObjectConverter.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonWriter.h"
+
+namespace
+{
+	template<typename EnumType>
+	void SerializeEnum(FArchive& Ar, EnumType& Value)
+	{
+		uint8 Raw = static_cast<uint8>(Value);
+		Ar << Raw;
+		Value = static_cast<EnumType>(Raw);
+	}
+
+	/** Float location/scale, 16-bit quaternion components */
+	void SerializeQuantizedTransform(FArchive& Ar, FTransform& Transform)
+	{
+		FVector3f Location(Transform.GetLocation());
+		FVector3f Scale(Transform.GetScale3D());
+		const FQuat Rotation = Transform.GetRotation().GetNormalized();
+		int16 Packed[4] = {
+			static_cast<int16>(FMath::RoundToInt(Rotation.X * MAX_int16)),
+			static_cast<int16>(FMath::RoundToInt(Rotation.Y * MAX_int16)),
+			static_cast<int16>(FMath::RoundToInt(Rotation.Z * MAX_int16)),
+			static_cast<int16>(FMath::RoundToInt(Rotation.W * MAX_int16))
+		};
+
+		Ar << Location;
+		Ar << Packed[0] << Packed[1] << Packed[2] << Packed[3];
+		Ar << Scale;
+
+		if (Ar.IsLoading())
+		{
+			FQuat Unpacked(Packed[0], Packed[1], Packed[2], Packed[3]);
+			Unpacked.Normalize();
+			Transform = FTransform(Unpacked, FVector(Location), FVector(Scale));
+		}
+	}
+}
+
+//=============================================================================
+// RECORD SERIALIZERS
+//=============================================================================
+// CellKey is intentionally omitted from every record - it lives in the header.
+// Enums are stored as uint8, soft class paths as strings.
+
+void DeltaCellFormat::SerializeRecord(FArchive& Ar, FSurfaceTileDelta& Delta, uint16 Flags)
+{
+	Ar << Delta.TileIndex;
+	Ar << Delta.WorldLocation;
+	Ar << Delta.Radius;
+	SerializeEnum(Ar, Delta.Channel);
+	SerializeEnum(Ar, Delta.Operation);
+	Ar << Delta.Value;
+	Ar << Delta.Timestamp;
+	Ar << Delta.AuthorPlayerId;
+}
+
+void DeltaCellFormat::SerializeRecord(FArchive& Ar, FFractureDelta& Delta, uint16 Flags)
+{
+	Ar << Delta.ActorGuid;
+	Ar << Delta.DamageSpecId.Id;
+	Ar << Delta.BrokenChunks;
+	Ar << Delta.bIsSleeping;
+	Ar << Delta.Timestamp;
+}
+
+void DeltaCellFormat::SerializeRecord(FArchive& Ar, FTransformDelta& Delta, uint16 Flags)
+{
+	Ar << Delta.ActorGuid;
+
+	// Settled debris tolerates sub-millimetre error; moving objects keep full precision
+	bool bQuantized = false;
+	if (Flags & FlagQuantizedTransforms)
+	{
+		bQuantized = Ar.IsSaving() && Delta.bIsSleeping;
+		Ar << bQuantized;
+	}
+
+	if (bQuantized)
+	{
+		SerializeQuantizedTransform(Ar, Delta.Transform);
+	}
+	else
+	{
+		Ar << Delta.Transform;
+	}
+	Ar << Delta.bPhysicsEnabled;
+	Ar << Delta.bIsSleeping;
+	Ar << Delta.Timestamp;
+}
+
+void DeltaCellFormat::SerializeRecord(FArchive& Ar, FSpawnDelta& Delta, uint16 Flags)
+{
+	Ar << Delta.ActorGuid;
+	Ar << Delta.PCGInstanceId;
+
+	FString ClassPath = Ar.IsSaving() ? Delta.ActorClass.ToSoftObjectPath().ToString() : FString();
+	Ar << ClassPath;
+	if (Ar.IsLoading())
+	{
+		Delta.ActorClass = TSoftClassPtr<AActor>(FSoftObjectPath(ClassPath));
+	}
+
+	Ar << Delta.SpawnTransform;
+	Ar << Delta.Timestamp;
+}
+
+void DeltaCellFormat::SerializeRecord(FArchive& Ar, FRemoveDelta& Delta, uint16 Flags)
+{
+	Ar << Delta.ActorGuid;
+	Ar << Delta.RemovalReason;
+	Ar << Delta.Timestamp;
+}
+
+void DeltaCellFormat::SerializeRecord(FArchive& Ar, FAssemblyDelta& Delta, uint16 Flags)
+{
+	Ar << Delta.AssemblyGuid;
+	Ar << Delta.AssemblySpecId;
+	Ar << Delta.Transform;
+	Ar << Delta.bIsSleeping;
+	Ar << Delta.DamagedParts;
+	Ar << Delta.StateVariables;
+	Ar << Delta.Timestamp;
+}
+
+namespace
+{
+	using DeltaCellFormat::SerializeRecord;
+
+	/** Bodies smaller than this are stored raw even when compression is requested */
+	constexpr int32 MinCompressBytes = 256;
+
+	/** Writes each FName as an index into a table collected along the way */
+	class FNameTableWriter : public FArchiveProxy
+	{
+	public:
+		explicit FNameTableWriter(FArchive& InInner) : FArchiveProxy(InInner) {}
+
+		virtual FArchive& operator<<(FName& Name) override
+		{
+			int32 Index;
+			if (const int32* Found = NameToIndex.Find(Name))
+			{
+				Index = *Found;
+			}
+			else
+			{
+				Index = Names.Add(Name);
+				NameToIndex.Add(Name, Index);
+			}
+			InnerArchive << Index;
+			return *this;
+		}
+
+		TArray<FName> Names;
+
+	private:
+		TMap<FName, int32> NameToIndex;
+	};
+
+	/** Resolves FName indices written by FNameTableWriter */
+	class FNameTableReader : public FArchiveProxy
+	{
+	public:
+		FNameTableReader(FArchive& InInner, const TArray<FName>& InNames) : FArchiveProxy(InInner), Names(InNames) {}
+
+		virtual FArchive& operator<<(FName& Name) override
+		{
+			int32 Index = INDEX_NONE;
+			InnerArchive << Index;
+			if (Names.IsValidIndex(Index))
+			{
+				Name = Names[Index];
+			}
+			else
+			{
+				Name = NAME_None;
+				InnerArchive.SetError();
+			}
+			return *this;
+		}
+
+	private:
+		const TArray<FName>& Names;
+	};
+
+	bool CodecFromFormat(FName Format, DeltaCellFormat::ECellCodec& OutCodec)
+	{
+		if (Format == NAME_LZ4) { OutCodec = DeltaCellFormat::ECellCodec::LZ4; return true; }
+		if (Format == NAME_Oodle) { OutCodec = DeltaCellFormat::ECellCodec::Oodle; return true; }
+		if (Format == NAME_Zlib) { OutCodec = DeltaCellFormat::ECellCodec::Zlib; return true; }
+		return false;
+	}
+
+	FName FormatFromCodec(uint8 Codec)
+	{
+		switch (static_cast<DeltaCellFormat::ECellCodec>(Codec))
+		{
+		case DeltaCellFormat::ECellCodec::LZ4:   return NAME_LZ4;
+		case DeltaCellFormat::ECellCodec::Oodle: return NAME_Oodle;
+		case DeltaCellFormat::ECellCodec::Zlib:  return NAME_Zlib;
+		default:                                 return NAME_None;
+		}
+	}
+
+	template<typename DeltaType>
+	void WriteSection(FArchive& Ar, EDeltaType Type, const TArray<DeltaType>& Deltas, uint16 Flags)
+	{
+		uint8 TypeByte = static_cast<uint8>(Type);
+		int32 Count = Deltas.Num();
+		Ar << TypeByte;
+		Ar << Count;
+
+		// Patch payload size after writing the records
+		const int64 SizeOffset = Ar.Tell();
+		int32 PayloadBytes = 0;
+		Ar << PayloadBytes;
+
+		const int64 PayloadStart = Ar.Tell();
+		for (const DeltaType& Delta : Deltas)
+		{
+			SerializeRecord(Ar, const_cast<DeltaType&>(Delta), Flags);
+		}
+		const int64 PayloadEnd = Ar.Tell();
+
+		PayloadBytes = static_cast<int32>(PayloadEnd - PayloadStart);
+		Ar.Seek(SizeOffset);
+		Ar << PayloadBytes;
+		Ar.Seek(PayloadEnd);
+	}
+
+	template<typename DeltaType>
+	bool ReadSection(FArchive& Ar, int32 Count, const FWorldCellKey& CellKey, uint16 Flags, TArray<DeltaType>& Out)
+	{
+		Out.Reserve(Out.Num() + Count);
+		for (int32 i = 0; i < Count && !Ar.IsError(); i++)
+		{
+			DeltaType& Delta = Out.AddDefaulted_GetRef();
+			SerializeRecord(Ar, Delta, Flags);
+			Delta.CellKey = CellKey;
+		}
+		return !Ar.IsError();
+	}
+
+	/** Surface section of a FlagPackedSurface cell: one FPackedSurfaceDeltaList instead of per-record fields */
+	void WritePackedSurfaceSection(FArchive& Ar, FPackedSurfaceDeltaList& Packed)
+	{
+		uint8 TypeByte = static_cast<uint8>(EDeltaType::SurfaceTile);
+		int32 Count = Packed.Num();
+		Ar << TypeByte;
+		Ar << Count;
+
+		const int64 SizeOffset = Ar.Tell();
+		int32 PayloadBytes = 0;
+		Ar << PayloadBytes;
+
+		const int64 PayloadStart = Ar.Tell();
+		Ar << Packed;
+		const int64 PayloadEnd = Ar.Tell();
+
+		PayloadBytes = static_cast<int32>(PayloadEnd - PayloadStart);
+		Ar.Seek(SizeOffset);
+		Ar << PayloadBytes;
+		Ar.Seek(PayloadEnd);
+	}
+
+	bool ReadPackedSurfaceSection(FArchive& Ar, int32 Count, const FWorldCellKey& CellKey, TArray<FSurfaceTileDelta>& Out)
+	{
+		FPackedSurfaceDeltaList Packed;
+		Packed.CellKey = CellKey;
+		Ar << Packed;
+		if (Ar.IsError() || Packed.Num() != Count)
+		{
+			return false;
+		}
+
+		Packed.UnpackAll(Out);
+		return true;
+	}
+
+	int32 CountSections(const FDeltaCellData& Data)
+	{
+		return (Data.SurfaceDeltas.Num() > 0) + (Data.FractureDeltas.Num() > 0) + (Data.TransformDeltas.Num() > 0)
+			+ (Data.SpawnDeltas.Num() > 0) + (Data.RemoveDeltas.Num() > 0) + (Data.AssemblyDeltas.Num() > 0);
+	}
+
+	template<typename DeltaType>
+	void WriteJsonArray(const TSharedRef<FJsonObject>& CellData, const TCHAR* FieldName, const TArray<DeltaType>& Deltas)
+	{
+		if (Deltas.Num() == 0)
+		{
+			return;
+		}
+
+		TArray<TSharedPtr<FJsonValue>> Array;
+		Array.Reserve(Deltas.Num());
+		for (const DeltaType& Delta : Deltas)
+		{
+			TSharedPtr<FJsonObject> DeltaObj = FJsonObjectConverter::UStructToJsonObject(Delta);
+			if (DeltaObj.IsValid())
+			{
+				Array.Add(MakeShared<FJsonValueObject>(DeltaObj));
+			}
+		}
+		CellData->SetArrayField(FieldName, Array);
+	}
+
+	template<typename DeltaType>
+	void ReadJsonArray(const TSharedPtr<FJsonObject>& CellData, const TCHAR* FieldName, TArray<DeltaType>& Out)
+	{
+		const TArray<TSharedPtr<FJsonValue>>* Array;
+		if (!CellData->TryGetArrayField(FieldName, Array))
+		{
+			return;
+		}
+
+		Out.Reserve(Array->Num());
+		for (const TSharedPtr<FJsonValue>& Value : *Array)
+		{
+			const TSharedPtr<FJsonObject>* DeltaObj;
+			if (!Value->TryGetObject(DeltaObj))
+			{
+				continue;
+			}
+
+			DeltaType Delta;
+			if (FJsonObjectConverter::JsonObjectToUStruct((*DeltaObj).ToSharedRef(), &Delta))
+			{
+				Out.Add(MoveTemp(Delta));
+			}
+		}
+	}
+}
+
+//=============================================================================
+// BINARY
+//=============================================================================
+
+namespace
+{
+	void WriteSections(FArchive& Ar, const FDeltaCellData& Data, uint16 Flags, FPackedSurfaceDeltaList* PackedSurface)
+	{
+		uint8 SectionCount = static_cast<uint8>(CountSections(Data));
+		Ar << SectionCount;
+
+		if (PackedSurface) { WritePackedSurfaceSection(Ar, *PackedSurface); }
+		else if (Data.SurfaceDeltas.Num() > 0) { WriteSection(Ar, EDeltaType::SurfaceTile, Data.SurfaceDeltas, Flags); }
+		if (Data.FractureDeltas.Num() > 0) { WriteSection(Ar, EDeltaType::Fracture, Data.FractureDeltas, Flags); }
+		if (Data.TransformDeltas.Num() > 0) { WriteSection(Ar, EDeltaType::Transform, Data.TransformDeltas, Flags); }
+		if (Data.SpawnDeltas.Num() > 0) { WriteSection(Ar, EDeltaType::Spawn, Data.SpawnDeltas, Flags); }
+		if (Data.RemoveDeltas.Num() > 0) { WriteSection(Ar, EDeltaType::Remove, Data.RemoveDeltas, Flags); }
+		if (Data.AssemblyDeltas.Num() > 0) { WriteSection(Ar, EDeltaType::Assembly, Data.AssemblyDeltas, Flags); }
+	}
+
+	/** Encode the body (name table + sections); PackedSurface is set iff FlagPackedSurface */
+	void WriteBody(const FDeltaCellData& Data, uint16 Flags, FPackedSurfaceDeltaList* PackedSurface, TArray<uint8>& OutBody)
+	{
+		if (!(Flags & DeltaCellFormat::FlagNameTable))
+		{
+			FMemoryWriter Ar(OutBody);
+			WriteSections(Ar, Data, Flags, PackedSurface);
+			return;
+		}
+
+		// Sections first so the table is complete, then table in front
+		TArray<uint8> SectionBytes;
+		FMemoryWriter SectionAr(SectionBytes);
+		FNameTableWriter NameAr(SectionAr);
+		WriteSections(NameAr, Data, Flags, PackedSurface);
+
+		FMemoryWriter Ar(OutBody);
+		int32 NameCount = NameAr.Names.Num();
+		Ar << NameCount;
+		for (const FName& Name : NameAr.Names)
+		{
+			FString NameString = Name.ToString();
+			Ar << NameString;
+		}
+		Ar.Serialize(SectionBytes.GetData(), SectionBytes.Num());
+	}
+
+	bool ReadSections(FArchive& Ar, FArchive& ErrorAr, const FWorldCellKey& CellKey, uint16 Flags, FDeltaCellData& OutData)
+	{
+		uint8 SectionCount = 0;
+		Ar << SectionCount;
+
+		for (int32 Section = 0; Section < SectionCount && !ErrorAr.IsError(); Section++)
+		{
+			uint8 TypeByte = 0;
+			int32 Count = 0;
+			int32 PayloadBytes = 0;
+			Ar << TypeByte << Count << PayloadBytes;
+
+			// Reject counts the remaining bytes cannot possibly hold
+			if (Count < 0 || PayloadBytes < 0 || Ar.Tell() + PayloadBytes > Ar.TotalSize() || Count > PayloadBytes)
+			{
+				UE_LOG(LogTemp, Warning, TEXT("DeltaCellFormat: Truncated section in cell %s"), *CellKey.ToString());
+				return false;
+			}
+
+			const int64 SectionEnd = Ar.Tell() + PayloadBytes;
+			bool bOk = true;
+			switch (static_cast<EDeltaType>(TypeByte))
+			{
+			case EDeltaType::SurfaceTile:
+				bOk = (Flags & DeltaCellFormat::FlagPackedSurface)
+					? ReadPackedSurfaceSection(Ar, Count, CellKey, OutData.SurfaceDeltas)
+					: ReadSection(Ar, Count, CellKey, Flags, OutData.SurfaceDeltas);
+				break;
+			case EDeltaType::Fracture:    bOk = ReadSection(Ar, Count, CellKey, Flags, OutData.FractureDeltas); break;
+			case EDeltaType::Transform:   bOk = ReadSection(Ar, Count, CellKey, Flags, OutData.TransformDeltas); break;
+			case EDeltaType::Spawn:       bOk = ReadSection(Ar, Count, CellKey, Flags, OutData.SpawnDeltas); break;
+			case EDeltaType::Remove:      bOk = ReadSection(Ar, Count, CellKey, Flags, OutData.RemoveDeltas); break;
+			case EDeltaType::Assembly:    bOk = ReadSection(Ar, Count, CellKey, Flags, OutData.AssemblyDeltas); break;
+			default:
+				// Written by a newer build - skip
+				break;
+			}
+
+			if (!bOk || ErrorAr.IsError())
+			{
+				UE_LOG(LogTemp, Warning, TEXT("DeltaCellFormat: Corrupt section %d in cell %s"), TypeByte, *CellKey.ToString());
+				return false;
+			}
+			Ar.Seek(SectionEnd);
+		}
+
+		return !ErrorAr.IsError();
+	}
+
+	bool ReadBody(const TArray<uint8>& Body, const FWorldCellKey& CellKey, uint16 Flags, FDeltaCellData& OutData)
+	{
+		FMemoryReader Ar(Body);
+		if (!(Flags & DeltaCellFormat::FlagNameTable))
+		{
+			return ReadSections(Ar, Ar, CellKey, Flags, OutData);
+		}
+
+		int32 NameCount = 0;
+		Ar << NameCount;
+
+		// Every entry is at least a 4-byte length
+		if (NameCount < 0 || NameCount > (Ar.TotalSize() - Ar.Tell()) / 4)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("DeltaCellFormat: Bad name table in cell %s"), *CellKey.ToString());
+			return false;
+		}
+
+		TArray<FName> Names;
+		Names.Reserve(NameCount);
+		for (int32 i = 0; i < NameCount && !Ar.IsError(); i++)
+		{
+			FString NameString;
+			Ar << NameString;
+			Names.Add(FName(*NameString));
+		}
+
+		FNameTableReader NameAr(Ar, Names);
+		return !Ar.IsError() && ReadSections(NameAr, Ar, CellKey, Flags, OutData);
+	}
+}
+
+void DeltaCellFormat::WriteBinary(const FWorldCellKey& CellKey, const FDeltaCellData& Data, TArray<uint8>& OutBytes,
+	const FWriteOptions& Options)
+{
+	uint16 Flags = 0;
+	if (Options.bNameTable) { Flags |= FlagNameTable; }
+	if (Options.bQuantizeSettledTransforms) { Flags |= FlagQuantizedTransforms; }
+
+	// Cells with a delta outside the packed ranges keep full records
+	FPackedSurfaceDeltaList PackedSurface;
+	const bool bPackSurface = Options.bPackSurfaceDeltas && Data.SurfaceDeltas.Num() > 0
+		&& FPackedSurfaceDeltaList::PackAll(Data.SurfaceDeltas, CellKey, PackedSurface);
+	if (bPackSurface) { Flags |= FlagPackedSurface; }
+
+	TArray<uint8> Body;
+	WriteBody(Data, Flags, bPackSurface ? &PackedSurface : nullptr, Body);
+
+	// Only keep compression when it actually wins
+	TArray<uint8> Packed;
+	ECellCodec Codec = ECellCodec::LZ4;
+	if (Options.bCompress && Body.Num() >= MinCompressBytes && CodecFromFormat(Options.CompressionFormat, Codec))
+	{
+		int32 PackedSize = FCompression::CompressMemoryBound(Options.CompressionFormat, Body.Num());
+		Packed.SetNumUninitialized(PackedSize);
+		if (FCompression::CompressMemory(Options.CompressionFormat, Packed.GetData(), PackedSize, Body.GetData(), Body.Num())
+			&& PackedSize < Body.Num())
+		{
+			Packed.SetNum(PackedSize);
+			Flags |= FlagCompressed;
+		}
+	}
+
+	OutBytes.Reset();
+	FMemoryWriter Ar(OutBytes);
+
+	uint32 FileMagic = Magic;
+	uint16 Version = CurrentVersion;
+	int32 X = CellKey.X;
+	int32 Y = CellKey.Y;
+	int32 LOD = CellKey.LOD;
+	Ar << FileMagic << Version << Flags << X << Y << LOD;
+
+	if (Flags & FlagCompressed)
+	{
+		uint8 CodecByte = static_cast<uint8>(Codec);
+		int32 RawBytes = Body.Num();
+		int32 PackedBytes = Packed.Num();
+		Ar << CodecByte << RawBytes << PackedBytes;
+		Ar.Serialize(Packed.GetData(), Packed.Num());
+	}
+	else
+	{
+		Ar.Serialize(Body.GetData(), Body.Num());
+	}
+}
+
+bool DeltaCellFormat::ReadBinary(const TArray<uint8>& Bytes, FWorldCellKey& OutCellKey, FDeltaCellData& OutData)
+{
+	FMemoryReader Ar(Bytes);
+
+	uint32 FileMagic = 0;
+	uint16 Version = 0;
+	uint16 Flags = 0;
+	Ar << FileMagic << Version << Flags;
+
+	if (Ar.IsError() || FileMagic != Magic)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("DeltaCellFormat: Bad magic"));
+		return false;
+	}
+
+	if (Version > CurrentVersion)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("DeltaCellFormat: Unsupported version %d (max %d)"), Version, CurrentVersion);
+		return false;
+	}
+
+	// Version 1 reserved the flags field
+	if (Version < 2)
+	{
+		Flags = 0;
+	}
+
+	Ar << OutCellKey.X << OutCellKey.Y << OutCellKey.LOD;
+	if (Ar.IsError())
+	{
+		return false;
+	}
+
+	TArray<uint8> Body;
+	if (Flags & FlagCompressed)
+	{
+		uint8 CodecByte = 0;
+		int32 RawBytes = 0;
+		int32 PackedBytes = 0;
+		Ar << CodecByte << RawBytes << PackedBytes;
+
+		const FName Format = FormatFromCodec(CodecByte);
+		if (Ar.IsError() || Format.IsNone() || RawBytes < 0 || PackedBytes < 0 || Ar.Tell() + PackedBytes > Ar.TotalSize())
+		{
+			UE_LOG(LogTemp, Warning, TEXT("DeltaCellFormat: Bad compressed body in cell %s"), *OutCellKey.ToString());
+			return false;
+		}
+
+		// RawBytes comes straight from disk; bound it before allocating
+		if (RawBytes > MaxBodyBytes || RawBytes > FMath::Max<int64>(PackedBytes, 1) * MaxCompressionRatio)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("DeltaCellFormat: Implausible body size %d (packed %d) in cell %s"),
+				RawBytes, PackedBytes, *OutCellKey.ToString());
+			return false;
+		}
+
+		Body.SetNumUninitialized(RawBytes);
+		if (!FCompression::UncompressMemory(Format, Body.GetData(), RawBytes, Bytes.GetData() + Ar.Tell(), PackedBytes))
+		{
+			UE_LOG(LogTemp, Warning, TEXT("DeltaCellFormat: Decompression failed for cell %s"), *OutCellKey.ToString());
+			return false;
+		}
+	}
+	else
+	{
+		const int64 Offset = Ar.Tell();
+		Body.Append(Bytes.GetData() + Offset, Bytes.Num() - Offset);
+	}
+
+	return ReadBody(Body, OutCellKey, Flags, OutData);
+}
+
+//=============================================================================
+// JSON (debug export / legacy)
+//=============================================================================
+
+FString DeltaCellFormat::WriteJson(const FWorldCellKey& CellKey, const FDeltaCellData& Data)
+{
+	TSharedRef<FJsonObject> CellData = MakeShared<FJsonObject>();
+	CellData->SetStringField(TEXT("cell"), CellKey.ToString());
+	CellData->SetNumberField(TEXT("timestamp"), FDateTime::UtcNow().ToUnixTimestamp());
+
+	WriteJsonArray(CellData, TEXT("surface_deltas"), Data.SurfaceDeltas);
+	WriteJsonArray(CellData, TEXT("fracture_deltas"), Data.FractureDeltas);
+	WriteJsonArray(CellData, TEXT("transform_deltas"), Data.TransformDeltas);
+	WriteJsonArray(CellData, TEXT("spawn_deltas"), Data.SpawnDeltas);
+	WriteJsonArray(CellData, TEXT("remove_deltas"), Data.RemoveDeltas);
+	WriteJsonArray(CellData, TEXT("assembly_deltas"), Data.AssemblyDeltas);
+
+	FString JsonString;
+	TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&JsonString);
+	FJsonSerializer::Serialize(CellData, Writer);
+	return JsonString;
+}
+
+bool DeltaCellFormat::ReadJson(const FString& JsonString, FDeltaCellData& OutData)
+{
+	TSharedPtr<FJsonObject> CellData;
+	TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(JsonString);
+	if (!FJsonSerializer::Deserialize(Reader, CellData) || !CellData.IsValid())
+	{
+		return false;
+	}
+
+	ReadJsonArray(CellData, TEXT("surface_deltas"), OutData.SurfaceDeltas);
+	ReadJsonArray(CellData, TEXT("fracture_deltas"), OutData.FractureDeltas);
+	ReadJsonArray(CellData, TEXT("transform_deltas"), OutData.TransformDeltas);
+	ReadJsonArray(CellData, TEXT("spawn_deltas"), OutData.SpawnDeltas);
+	ReadJsonArray(CellData, TEXT("remove_deltas"), OutData.RemoveDeltas);
+	ReadJsonArray(CellData, TEXT("assembly_deltas"), OutData.AssemblyDeltas);
+	return true;
+}
@@ -0,0 +1,69 @@
+// Copyright 2026 Threaded Pixel Factory
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "DeltaReplicationComponent.h"
+#include "DeltaStoreSubsystem.h"
+#include "ReplicatedDeltaStore.h"
+#include "Engine/World.h"
+
+UDeltaReplicationComponent::UDeltaReplicationComponent()
+{
+	PrimaryComponentTick.bCanEverTick = false;
+	SetIsReplicatedByDefault(true);
+}
+
+void UDeltaReplicationComponent::ClientReceiveBunches_Implementation(const TArray<FDeltaCellBunch>& Bunches)
+{
+	UDeltaStoreSubsystem* Deltas = GetWorld() ? GetWorld()->GetSubsystem<UDeltaStoreSubsystem>() : nullptr;
+	UReplicatedDeltaStore* Store = Deltas ? Cast<UReplicatedDeltaStore>(Deltas->GetDeltaStore()) : nullptr;
+	if (!Store)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("DeltaReplicationComponent: No replicated delta store - dropping %d bunches"), Bunches.Num());
+		return;
+	}
+
+	for (const FDeltaCellBunch& Bunch : Bunches)
+	{
+		if (!Bunch.bLastChunk)
+		{
+			PartialPayloads.FindOrAdd(Bunch.CellKey).Append(Bunch.Data);
+			continue;
+		}
+
+		TArray<uint8> Partial;
+		if (PartialPayloads.RemoveAndCopyValue(Bunch.CellKey, Partial))
+		{
+			Partial.Append(Bunch.Data);
+			Store->ApplyReplicatedCell(Bunch.CellKey, Bunch.bSnapshot, Partial);
+		}
+		else
+		{
+			Store->ApplyReplicatedCell(Bunch.CellKey, Bunch.bSnapshot, Bunch.Data);
+		}
+	}
+}
+
+void UDeltaReplicationComponent::ClientDropCells_Implementation(const TArray<FWorldCellKey>& CellKeys)
+{
+	UDeltaStoreSubsystem* Deltas = GetWorld() ? GetWorld()->GetSubsystem<UDeltaStoreSubsystem>() : nullptr;
+	UReplicatedDeltaStore* Store = Deltas ? Cast<UReplicatedDeltaStore>(Deltas->GetDeltaStore()) : nullptr;
+
+	for (const FWorldCellKey& CellKey : CellKeys)
+	{
+		PartialPayloads.Remove(CellKey);
+		if (Store)
+		{
+			Store->DropReplicatedCell(CellKey);
+		}
+	}
+}
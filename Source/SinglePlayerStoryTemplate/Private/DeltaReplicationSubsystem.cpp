@@ -0,0 +1,352 @@
+// Copyright 2026 Threaded Pixel Factory
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "DeltaReplicationSubsystem.h"
+#include "DeltaReplicationComponent.h"
+#include "DeltaStoreSubsystem.h"
+#include "ServerDeltaStore.h"
+#include "DeltaCellFormat.h"
+#include "TPFCoreStats.h"
+#include "TPFTimingRecorder.h"
+#include "Engine/World.h"
+#include "GameFramework/GameModeBase.h"
+#include "GameFramework/PlayerController.h"
+#include "Engine/ActorChannel.h"
+#include "Engine/NetConnection.h"
+
+bool UDeltaReplicationSubsystem::ShouldCreateSubsystem(UObject* Outer) const
+{
+	const UWorld* World = Cast<UWorld>(Outer);
+	return World && World->IsGameWorld() && Super::ShouldCreateSubsystem(Outer);
+}
+
+void UDeltaReplicationSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	TPF_TIMING_SCOPE(TEXT("DeltaReplicationSubsystem::Initialize"));
+
+	Super::Initialize(Collection);
+
+	// The store must exist before the first send
+	Collection.InitializeDependency<UDeltaStoreSubsystem>();
+
+	PostLoginHandle = FGameModeEvents::OnGameModePostLoginEvent().AddUObject(this, &UDeltaReplicationSubsystem::HandlePostLogin);
+	LogoutHandle = FGameModeEvents::OnGameModeLogoutEvent().AddUObject(this, &UDeltaReplicationSubsystem::HandleLogout);
+	SecondsSinceSend = 0.0;
+}
+
+void UDeltaReplicationSubsystem::Deinitialize()
+{
+	FGameModeEvents::OnGameModePostLoginEvent().Remove(PostLoginHandle);
+	FGameModeEvents::OnGameModeLogoutEvent().Remove(LogoutHandle);
+	Clients.Reset();
+	EncodedBatches.Reset();
+	EncodedSnapshots.Reset();
+
+	Super::Deinitialize();
+}
+
+void UDeltaReplicationSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	// Seamless travel keeps controllers without a new login
+	if (IsReplicating())
+	{
+		for (FConstPlayerControllerIterator It = InWorld.GetPlayerControllerIterator(); It; ++It)
+		{
+			AddClient(It->Get());
+		}
+	}
+}
+
+bool UDeltaReplicationSubsystem::IsReplicating() const
+{
+	const ENetMode NetMode = GetWorld()->GetNetMode();
+	return (NetMode == NM_ListenServer || NetMode == NM_DedicatedServer) && GetStore() != nullptr;
+}
+
+UServerDeltaStore* UDeltaReplicationSubsystem::GetStore() const
+{
+	const UDeltaStoreSubsystem* Deltas = GetWorld()->GetSubsystem<UDeltaStoreSubsystem>();
+	return Deltas ? Cast<UServerDeltaStore>(Deltas->GetDeltaStore()) : nullptr;
+}
+
+void UDeltaReplicationSubsystem::HandlePostLogin(AGameModeBase* GameMode, APlayerController* NewPlayer)
+{
+	if (GameMode && GameMode->GetWorld() == GetWorld() && IsReplicating())
+	{
+		AddClient(NewPlayer);
+	}
+}
+
+void UDeltaReplicationSubsystem::HandleLogout(AGameModeBase* GameMode, AController* Exiting)
+{
+	Clients.RemoveAll([Exiting](const TWeakObjectPtr<UDeltaReplicationComponent>& Client)
+	{
+		return !Client.IsValid() || Client->GetOwner() == Exiting;
+	});
+}
+
+void UDeltaReplicationSubsystem::AddClient(APlayerController* PlayerController)
+{
+	// The listen server's own player reads the server store directly
+	if (!PlayerController || PlayerController->IsLocalController()
+		|| PlayerController->FindComponentByClass<UDeltaReplicationComponent>())
+	{
+		return;
+	}
+
+	UDeltaReplicationComponent* Client = NewObject<UDeltaReplicationComponent>(PlayerController, TEXT("DeltaReplication"));
+	Client->RegisterComponent();
+	Clients.Add(Client);
+
+	UE_LOG(LogTemp, Log, TEXT("DeltaReplicationSubsystem: Replicating deltas to %s"), *PlayerController->GetName());
+}
+
+void UDeltaReplicationSubsystem::Tick(float DeltaTime)
+{
+	SecondsSinceSend += DeltaTime;
+	if (SecondsSinceSend < SendIntervalSeconds)
+	{
+		return;
+	}
+	const double ElapsedSeconds = SecondsSinceSend;
+	SecondsSinceSend = 0.0;
+
+	UServerDeltaStore* Store = GetStore();
+	if (!Store || !Store->IsInitialized() || !IsReplicating())
+	{
+		return;
+	}
+
+	SCOPE_CYCLE_COUNTER(STAT_TPF_DeltaReplication);
+
+	TMap<FWorldCellKey, FDeltaCellData> Batches;
+	TSet<FWorldCellKey> ResetCells;
+	Store->TakeReplicationBatches(Batches, ResetCells);
+
+	EncodedBatches.Reset();
+	EncodedSnapshots.Reset();
+
+	const DeltaCellFormat::FWriteOptions Options = GetPayloadOptions();
+	Clients.RemoveAll([](const TWeakObjectPtr<UDeltaReplicationComponent>& Client) { return !Client.IsValid(); });
+
+	for (const TWeakObjectPtr<UDeltaReplicationComponent>& WeakClient : Clients)
+	{
+		UDeltaReplicationComponent& Client = *WeakClient.Get();
+		UpdateInterest(Client, *Store);
+
+		// Cleared cells need their state again, ahead of cells the client never had
+		for (const FWorldCellKey& CellKey : ResetCells)
+		{
+			if (Client.SyncedCells.Remove(CellKey) > 0)
+			{
+				Client.PendingSnapshots.Insert(CellKey, 0);
+			}
+		}
+
+		// Refill the allowance; a send may overdraw it and later sends repay the debt
+		Client.SendAllowanceBytes = FMath::Min(Client.SendAllowanceBytes + MaxBytesPerSecondPerClient * ElapsedSeconds, double(MaxBytesPerSecondPerClient));
+
+		// Held back: the batches are gone from the store, so their cells resync by snapshot
+		if (Client.SendAllowanceBytes <= 0.0 || IsClientSaturated(Client))
+		{
+			for (const TPair<FWorldCellKey, FDeltaCellData>& Batch : Batches)
+			{
+				if (Client.SyncedCells.Remove(Batch.Key) > 0)
+				{
+					Client.PendingSnapshots.Insert(Batch.Key, 0);
+				}
+			}
+			continue;
+		}
+
+		TArray<FDeltaCellBunch> Outgoing;
+		int32 OutgoingBytes = 0;
+		int32 SentBytes = 0;
+
+		for (const TPair<FWorldCellKey, FDeltaCellData>& Batch : Batches)
+		{
+			if (!Client.SyncedCells.Contains(Batch.Key))
+			{
+				continue;
+			}
+
+			TArray<uint8>* Encoded = EncodedBatches.Find(Batch.Key);
+			if (!Encoded)
+			{
+				Encoded = &EncodedBatches.Add(Batch.Key);
+				DeltaCellFormat::WriteBinary(Batch.Key, Batch.Value, *Encoded, Options);
+			}
+			QueuePayload(Client, Outgoing, OutgoingBytes, Batch.Key, false, *Encoded);
+			SentBytes += Encoded->Num();
+		}
+
+		const int32 SnapshotBudget = FMath::Min(MaxSnapshotBytesPerSend, int32(Client.SendAllowanceBytes) - SentBytes);
+		int32 SnapshotBytes = 0;
+		for (int32 Index = 0; Index < Client.PendingSnapshots.Num() && SnapshotBytes < SnapshotBudget && !IsClientSaturated(Client);)
+		{
+			const FWorldCellKey CellKey = Client.PendingSnapshots[Index];
+
+			// Never encode a cell that would block on its prefetch
+			if (!Store->IsCellLoadComplete(CellKey))
+			{
+				Index++;
+				continue;
+			}
+
+			const TArray<uint8>& Payload = GetSnapshotPayload(CellKey, *Store);
+			QueuePayload(Client, Outgoing, OutgoingBytes, CellKey, true, Payload);
+			SnapshotBytes += Payload.Num();
+			Client.SyncedCells.Add(CellKey);
+			Client.PendingSnapshots.RemoveAt(Index);
+		}
+
+		if (Outgoing.Num() > 0)
+		{
+			Client.ClientReceiveBunches(Outgoing);
+		}
+		Client.SendAllowanceBytes -= SentBytes + SnapshotBytes;
+	}
+}
+
+bool UDeltaReplicationSubsystem::IsClientSaturated(const UDeltaReplicationComponent& Client)
+{
+	APlayerController* PlayerController = Cast<APlayerController>(Client.GetOwner());
+	UNetConnection* Connection = PlayerController ? PlayerController->GetNetConnection() : nullptr;
+	if (!Connection)
+	{
+		return true;
+	}
+
+	// Half the reliable buffer leaves room for gameplay RPCs on the same channel
+	const UActorChannel* Channel = Connection->FindActorChannelRef(PlayerController);
+	return !Connection->IsNetReady() || (Channel && Channel->NumOutRec >= RELIABLE_BUFFER / 2);
+}
+
+void UDeltaReplicationSubsystem::UpdateInterest(UDeltaReplicationComponent& Client, UServerDeltaStore& Store)
+{
+	const APlayerController* PlayerController = Cast<APlayerController>(Client.GetOwner());
+	if (!PlayerController)
+	{
+		return;
+	}
+
+	FVector ViewLocation;
+	FRotator ViewRotation;
+	PlayerController->GetPlayerViewPoint(ViewLocation, ViewRotation);
+	const FWorldCellKey Center = FWorldCellKey::FromWorldLocation(ViewLocation, DeltaCellSize);
+
+	auto DistanceFromCenter = [&Center](const FWorldCellKey& CellKey)
+	{
+		return FMath::Max(FMath::Abs(CellKey.X - Center.X), FMath::Abs(CellKey.Y - Center.Y));
+	};
+
+	// Hysteresis: keep cells one ring past the interest radius
+	const int32 DropDistance = InterestRadiusCells + 1;
+	TArray<FWorldCellKey> Dropped;
+	for (auto It = Client.SyncedCells.CreateIterator(); It; ++It)
+	{
+		if (DistanceFromCenter(*It) > DropDistance)
+		{
+			Dropped.Add(*It);
+			It.RemoveCurrent();
+		}
+	}
+	Client.PendingSnapshots.RemoveAll([&](const FWorldCellKey& CellKey) { return DistanceFromCenter(CellKey) > DropDistance; });
+
+	if (Dropped.Num() > 0)
+	{
+		Client.ClientDropCells(Dropped);
+	}
+
+	TArray<FWorldCellKey> Added;
+	for (int32 Y = Center.Y - InterestRadiusCells; Y <= Center.Y + InterestRadiusCells; Y++)
+	{
+		for (int32 X = Center.X - InterestRadiusCells; X <= Center.X + InterestRadiusCells; X++)
+		{
+			const FWorldCellKey CellKey(X, Y, Center.LOD);
+			if (!Client.SyncedCells.Contains(CellKey) && !Client.PendingSnapshots.Contains(CellKey))
+			{
+				Added.Add(CellKey);
+			}
+		}
+	}
+
+	if (Added.Num() > 0)
+	{
+		Store.PrefetchCells(Added);
+		Client.PendingSnapshots.Append(Added);
+		Client.PendingSnapshots.StableSort([&](const FWorldCellKey& A, const FWorldCellKey& B)
+		{
+			return DistanceFromCenter(A) < DistanceFromCenter(B);
+		});
+	}
+}
+
+const TArray<uint8>& UDeltaReplicationSubsystem::GetSnapshotPayload(const FWorldCellKey& CellKey, UServerDeltaStore& Store)
+{
+	if (const TArray<uint8>* Cached = EncodedSnapshots.Find(CellKey))
+	{
+		return *Cached;
+	}
+
+	FDeltaCellData Data;
+	Data.SurfaceDeltas = Store.GetSurfaceDeltas(CellKey);
+	Data.FractureDeltas = Store.GetFractureDeltas(CellKey);
+	Data.TransformDeltas = Store.GetTransformDeltas(CellKey);
+	Data.SpawnDeltas = Store.GetSpawnDeltas(CellKey);
+	Data.RemoveDeltas = Store.GetRemoveDeltas(CellKey);
+	Data.AssemblyDeltas = Store.GetAssemblyDeltas(CellKey);
+
+	TArray<uint8>& Payload = EncodedSnapshots.Add(CellKey);
+	DeltaCellFormat::WriteBinary(CellKey, Data, Payload, GetPayloadOptions());
+	return Payload;
+}
+
+DeltaCellFormat::FWriteOptions UDeltaReplicationSubsystem::GetPayloadOptions() const
+{
+	DeltaCellFormat::FWriteOptions Options;
+	Options.bCompress = true;
+	Options.CompressionFormat = CompressionFormat;
+	Options.bPackSurfaceDeltas = bPackSurfaceDeltas;
+	return Options;
+}
+
+void UDeltaReplicationSubsystem::QueuePayload(UDeltaReplicationComponent& Client, TArray<FDeltaCellBunch>& Outgoing, int32& OutgoingBytes,
+	const FWorldCellKey& CellKey, bool bSnapshot, const TArray<uint8>& Payload)
+{
+	INC_DWORD_STAT_BY(STAT_TPF_DeltaReplicationBytes, Payload.Num());
+
+	int32 Offset = 0;
+	do
+	{
+		const int32 ChunkBytes = FMath::Min(MaxChunkBytes, Payload.Num() - Offset);
+
+		FDeltaCellBunch& Bunch = Outgoing.AddDefaulted_GetRef();
+		Bunch.CellKey = CellKey;
+		Bunch.bSnapshot = bSnapshot;
+		Bunch.Data.Append(Payload.GetData() + Offset, ChunkBytes);
+		Offset += ChunkBytes;
+		Bunch.bLastChunk = Offset >= Payload.Num();
+
+		OutgoingBytes += ChunkBytes;
+		if (OutgoingBytes >= MaxBytesPerRPC)
+		{
+			Client.ClientReceiveBunches(Outgoing);
+			Outgoing.Reset();
+			OutgoingBytes = 0;
+		}
+	}
+	while (Offset < Payload.Num());
+}
@@ -0,0 +1,264 @@
+// Copyright 2026 Threaded Pixel Factory
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * Delta Store Benchmark - Development console command
+ *
+ * Usage (console, non-shipping builds):
+ *   TPF.DeltaStore.Benchmark [SurfaceCount] [journal] [compress] [coalesce] [pack]
+ *
+ * Drives a throwaway UFileDeltaStore (or UJournalDeltaStore) through synthetic
+ * workloads and logs, per workload:
+ * - Append ns/op
+ * - Query latency per cell (View*Deltas)
+ * - Game-thread flush cost and background flush time
+ * - Bytes on disk
+ * - Reload time (fresh store, prefetch + query every cell)
+ *
+ * Workloads:
+ * - Surface:  SurfaceCount deltas (default 1M) across 256 cells
+ * - Fracture: 10k deltas with 64 broken chunks each
+ * - Assembly: 10k assemblies with damaged parts and state variables,
+ *   interleaved with transform and remove deltas
+ *
+ * Data is written under Saved/GameSaveData/_DeltaStoreBenchmark and deleted afterwards.
+ */
+
+#include "CoreMinimal.h"
+
+#if !UE_BUILD_SHIPPING
+
+#include "FileDeltaStore.h"
+#include "JournalDeltaStore.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformFileManager.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/Paths.h"
+#include "UObject/Package.h"
+
+namespace
+{
+	constexpr int32 BenchmarkGridSize = 16;
+	const TCHAR* BenchmarkWorldName = TEXT("_DeltaStoreBenchmark");
+
+	struct FBenchmarkConfig
+	{
+		int32 SurfaceCount = 1000000;
+		bool bJournal = false;
+		bool bCompress = false;
+		bool bCoalesce = false;
+		bool bPackSurface = false;
+	};
+
+	FWorldCellKey BenchmarkCell(int32 Index)
+	{
+		return FWorldCellKey(Index % BenchmarkGridSize, (Index / BenchmarkGridSize) % BenchmarkGridSize, 0);
+	}
+
+	TArray<FWorldCellKey> AllBenchmarkCells()
+	{
+		TArray<FWorldCellKey> Cells;
+		for (int32 i = 0; i < BenchmarkGridSize * BenchmarkGridSize; i++)
+		{
+			Cells.Add(BenchmarkCell(i));
+		}
+		return Cells;
+	}
+
+	UFileDeltaStore* MakeBenchmarkStore(const FBenchmarkConfig& Config)
+	{
+		UClass* StoreClass = Config.bJournal ? UJournalDeltaStore::StaticClass() : UFileDeltaStore::StaticClass();
+		UFileDeltaStore* Store = NewObject<UFileDeltaStore>(GetTransientPackage(), StoreClass);
+		Store->bCompressCellFiles = Config.bCompress;
+		Store->bCoalesceSurfaceDeltas = Config.bCoalesce;
+		Store->bPackSurfaceDeltas = Config.bPackSurface;
+		Store->Initialize(BenchmarkWorldName);
+		return Store;
+	}
+
+	int64 DirectoryBytes(const FString& Directory)
+	{
+		int64 Total = 0;
+		FPlatformFileManager::Get().GetPlatformFile().IterateDirectoryStatRecursively(*Directory,
+			[&Total](const TCHAR*, const FFileStatData& Stat)
+			{
+				if (!Stat.bIsDirectory)
+				{
+					Total += Stat.FileSize;
+				}
+				return true;
+			});
+		return Total;
+	}
+
+	/** Run one workload end to end and log its numbers */
+	void RunWorkload(const TCHAR* Name, const FBenchmarkConfig& Config, int32 DeltaCount,
+		TFunctionRef<void(UFileDeltaStore&, int32)> AppendOne)
+	{
+		const FString WorldDir = FPaths::ProjectSavedDir() / TEXT("GameSaveData") / BenchmarkWorldName;
+		IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+		PlatformFile.DeleteDirectoryRecursively(*WorldDir);
+
+		const TArray<FWorldCellKey> Cells = AllBenchmarkCells();
+		UFileDeltaStore* Store = MakeBenchmarkStore(Config);
+
+		double Start = FPlatformTime::Seconds();
+		for (int32 i = 0; i < DeltaCount; i++)
+		{
+			AppendOne(*Store, i);
+		}
+		const double AppendSeconds = FPlatformTime::Seconds() - Start;
+
+		// Touch every array type so the number covers whatever the workload wrote
+		int64 Records = 0;
+		Start = FPlatformTime::Seconds();
+		for (const FWorldCellKey& Cell : Cells)
+		{
+			Records += Store->ViewSurfaceDeltas(Cell).Num() + Store->ViewFractureDeltas(Cell).Num()
+				+ Store->ViewTransformDeltas(Cell).Num() + Store->ViewRemoveDeltas(Cell).Num()
+				+ Store->ViewAssemblyDeltas(Cell).Num();
+		}
+		const double QuerySeconds = FPlatformTime::Seconds() - Start;
+
+		Start = FPlatformTime::Seconds();
+		Store->Flush();
+		const double FlushGameThreadSeconds = FPlatformTime::Seconds() - Start;
+
+		Start = FPlatformTime::Seconds();
+		Store->WaitForFlush();
+		if (UJournalDeltaStore* Journal = Cast<UJournalDeltaStore>(Store))
+		{
+			// Fold the journal so reload measures snapshot reads, as on next launch
+			Journal->Compact();
+			Journal->WaitForJournal();
+		}
+		const double FlushBackgroundSeconds = FPlatformTime::Seconds() - Start;
+
+		const int64 DiskBytes = DirectoryBytes(WorldDir);
+		Store->MarkAsGarbage();
+
+		UFileDeltaStore* Reloaded = MakeBenchmarkStore(Config);
+		Start = FPlatformTime::Seconds();
+		Reloaded->PrefetchCells(Cells);
+		int64 ReloadedRecords = 0;
+		for (const FWorldCellKey& Cell : Cells)
+		{
+			ReloadedRecords += Reloaded->ViewSurfaceDeltas(Cell).Num() + Reloaded->ViewFractureDeltas(Cell).Num()
+				+ Reloaded->ViewTransformDeltas(Cell).Num() + Reloaded->ViewRemoveDeltas(Cell).Num()
+				+ Reloaded->ViewAssemblyDeltas(Cell).Num();
+		}
+		const double ReloadSeconds = FPlatformTime::Seconds() - Start;
+		Reloaded->WaitForFlush();
+		Reloaded->MarkAsGarbage();
+
+		UE_LOG(LogTemp, Display, TEXT("DeltaStoreBenchmark [%s] %d deltas, %lld records (%lld after reload)"),
+			Name, DeltaCount, Records, ReloadedRecords);
+		UE_LOG(LogTemp, Display, TEXT("  Append:            %.1f ns/op"), AppendSeconds * 1e9 / FMath::Max(1, DeltaCount));
+		UE_LOG(LogTemp, Display, TEXT("  Query:             %.2f us/cell"), QuerySeconds * 1e6 / Cells.Num());
+		UE_LOG(LogTemp, Display, TEXT("  Flush game thread: %.3f ms"), FlushGameThreadSeconds * 1e3);
+		UE_LOG(LogTemp, Display, TEXT("  Flush background:  %.3f ms"), FlushBackgroundSeconds * 1e3);
+		UE_LOG(LogTemp, Display, TEXT("  On disk:           %lld bytes"), DiskBytes);
+		UE_LOG(LogTemp, Display, TEXT("  Reload:            %.3f ms"), ReloadSeconds * 1e3);
+
+		PlatformFile.DeleteDirectoryRecursively(*WorldDir);
+	}
+
+	void RunDeltaStoreBenchmark(const TArray<FString>& Args)
+	{
+		FBenchmarkConfig Config;
+		for (const FString& Arg : Args)
+		{
+			if (Arg.IsNumeric()) { Config.SurfaceCount = FMath::Max(1, FCString::Atoi(*Arg)); }
+			else if (Arg == TEXT("journal")) { Config.bJournal = true; }
+			else if (Arg == TEXT("compress")) { Config.bCompress = true; }
+			else if (Arg == TEXT("coalesce")) { Config.bCoalesce = true; }
+			else if (Arg == TEXT("pack")) { Config.bPackSurface = true; }
+		}
+
+		UE_LOG(LogTemp, Display, TEXT("DeltaStoreBenchmark: %s store, compression %s, coalescing %s, packed surface %s"),
+			Config.bJournal ? TEXT("journal") : TEXT("file"), Config.bCompress ? TEXT("on") : TEXT("off"),
+			Config.bCoalesce ? TEXT("on") : TEXT("off"), Config.bPackSurface ? TEXT("on") : TEXT("off"));
+
+		FRandomStream Random(1234);
+
+		RunWorkload(TEXT("Surface"), Config, Config.SurfaceCount, [&Random](UFileDeltaStore& Store, int32 i)
+		{
+			FSurfaceTileDelta Delta;
+			Delta.CellKey = BenchmarkCell(i);
+			Delta.TileIndex = Random.RandHelper(4096);
+			Delta.WorldLocation = Delta.CellKey.GetWorldBounds().GetCenter();
+			Delta.Channel = static_cast<ESurfaceDeltaChannel>(Random.RandHelper(4));
+			Delta.Operation = ESurfaceDeltaOperation::Add;
+			Delta.Value = Random.FRandRange(0.0f, 1.0f);
+			Delta.Timestamp = i;
+			Delta.AuthorPlayerId = TEXT("Player0");
+			Store.AppendSurfaceDelta(Delta);
+		});
+
+		RunWorkload(TEXT("Fracture"), Config, 10000, [](UFileDeltaStore& Store, int32 i)
+		{
+			FFractureDelta Delta;
+			Delta.CellKey = BenchmarkCell(i);
+			Delta.ActorGuid = FGuid::NewGuid();
+			for (int32 Chunk = 0; Chunk < 64; Chunk++)
+			{
+				Delta.BrokenChunks.Add(Chunk * 3 + (i % 3));
+			}
+			Delta.Timestamp = i;
+			Store.AppendFractureDelta(Delta);
+		});
+
+		RunWorkload(TEXT("Assembly"), Config, 10000, [&Random](UFileDeltaStore& Store, int32 i)
+		{
+			const FWorldCellKey Cell = BenchmarkCell(i);
+			const FTransform Transform(FRotator(0.0f, Random.FRandRange(0.0f, 360.0f), 0.0f),
+				FVector(Random.FRandRange(0.0f, 10000.0f), Random.FRandRange(0.0f, 10000.0f), 0.0f));
+
+			FAssemblyDelta Assembly;
+			Assembly.CellKey = Cell;
+			Assembly.AssemblyGuid = FGuid::NewGuid();
+			Assembly.AssemblySpecId = (i % 2) ? FName(TEXT("Vehicle_Rover")) : FName(TEXT("Machine_Drill"));
+			Assembly.Transform = Transform;
+			Assembly.DamagedParts = { 1, 4, 7 };
+			Assembly.StateVariables.Add(TEXT("Fuel"), Random.FRand());
+			Assembly.StateVariables.Add(TEXT("Health"), Random.FRand());
+			Assembly.Timestamp = i;
+			Store.AppendAssemblyDelta(Assembly);
+
+			FTransformDelta Debris;
+			Debris.CellKey = Cell;
+			Debris.ActorGuid = FGuid::NewGuid();
+			Debris.Transform = Transform;
+			Debris.bIsSleeping = true;
+			Debris.Timestamp = i;
+			Store.AppendTransformDelta(Debris);
+
+			if (i % 4 == 0)
+			{
+				FRemoveDelta Remove;
+				Remove.CellKey = Cell;
+				Remove.ActorGuid = FGuid::NewGuid();
+				Remove.RemovalReason = TEXT("Destroyed");
+				Remove.Timestamp = i;
+				Store.AppendRemoveDelta(Remove);
+			}
+		});
+	}
+
+	FAutoConsoleCommand DeltaStoreBenchmarkCommand(
+		TEXT("TPF.DeltaStore.Benchmark"),
+		TEXT("Benchmark delta store append/query/flush/reload. Args: [SurfaceCount] [journal] [compress] [coalesce] [pack]"),
+		FConsoleCommandWithArgsDelegate::CreateStatic(&RunDeltaStoreBenchmark));
+}
+
+#endif // !UE_BUILD_SHIPPING
@@ -0,0 +1,168 @@
+// Copyright 2026 Threaded Pixel Factory
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "DeltaStoreSubsystem.h"
+#include "FileDeltaStore.h"
+#include "JournalDeltaStore.h"
+#include "ServerDeltaStore.h"
+#include "ReplicatedDeltaStore.h"
+#include "Subsystems/SurfaceQuerySubsystem.h"
+#include "TPFCoreStats.h"
+#include "TPFTimingRecorder.h"
+#include "Engine/World.h"
+
+//=============================================================================
+// FDeltaFlushPolicy
+//=============================================================================
+
+bool FDeltaFlushPolicy::ShouldFlush(double SecondsSinceFlush, int32 DirtyCells, int64 PendingBytes) const
+{
+	if (!bEnabled || (DirtyCells == 0 && PendingBytes == 0))
+	{
+		return false;
+	}
+
+	return (IntervalSeconds > 0.0f && SecondsSinceFlush >= IntervalSeconds)
+		|| (MaxDirtyCells > 0 && DirtyCells >= MaxDirtyCells)
+		|| (PendingByteBudget > 0 && PendingBytes >= PendingByteBudget);
+}
+
+//=============================================================================
+// UDeltaStoreSubsystem
+//=============================================================================
+
+bool UDeltaStoreSubsystem::ShouldCreateSubsystem(UObject* Outer) const
+{
+	// Only game worlds persist deltas
+	const UWorld* World = Cast<UWorld>(Outer);
+	return World && World->IsGameWorld() && Super::ShouldCreateSubsystem(Outer);
+}
+
+void UDeltaStoreSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	TPF_TIMING_SCOPE(TEXT("DeltaStoreSubsystem::Initialize"));
+
+	Super::Initialize(Collection);
+
+	UClass* StoreClass = bUseJournalStore ? UJournalDeltaStore::StaticClass() : UFileDeltaStore::StaticClass();
+	if (bReplicateDeltas)
+	{
+		// Derived from the URL this early (?listen, or a server address for clients)
+		const ENetMode NetMode = GetWorld()->GetNetMode();
+		if (NetMode == NM_Client)
+		{
+			StoreClass = UReplicatedDeltaStore::StaticClass();
+		}
+		else if (NetMode == NM_ListenServer || NetMode == NM_DedicatedServer)
+		{
+			StoreClass = UServerDeltaStore::StaticClass();
+		}
+	}
+	Store = NewObject<UFileDeltaStore>(this, StoreClass);
+	Store->CacheBudgetBytes = CacheBudgetBytes;
+
+	const FString WorldName = UWorld::RemovePIEPrefix(GetWorld()->GetMapName());
+	if (!Store->Initialize(WorldName))
+	{
+		UE_LOG(LogTemp, Error, TEXT("DeltaStoreSubsystem: Failed to initialize delta store for world %s"), *WorldName);
+	}
+
+	// Surface queries sample wetness/snow/compaction from this store
+	if (USurfaceQuerySubsystem* SurfaceQuery = Collection.InitializeDependency<USurfaceQuerySubsystem>())
+	{
+		SurfaceQuery->SetDeltaStore(Store.Get());
+	}
+
+	LevelTransitionHandle = IDeltaStore::OnPreLevelTransition().AddUObject(this, &UDeltaStoreSubsystem::HandlePreLevelTransition);
+	SecondsSinceFlush = 0.0;
+	bDraining = false;
+}
+
+void UDeltaStoreSubsystem::Deinitialize()
+{
+	IDeltaStore::OnPreLevelTransition().Remove(LevelTransitionHandle);
+
+	if (USurfaceQuerySubsystem* SurfaceQuery = GetWorld()->GetSubsystem<USurfaceQuerySubsystem>())
+	{
+		SurfaceQuery->SetDeltaStore(nullptr);
+	}
+
+	// World is going away - everything must be on disk before the store is released
+	if (Store)
+	{
+		Store->Flush();
+		Store->WaitForFlush();
+		Store = nullptr;
+	}
+
+	Super::Deinitialize();
+}
+
+void UDeltaStoreSubsystem::Tick(float DeltaTime)
+{
+	if (!Store || !Store->IsInitialized())
+	{
+		return;
+	}
+
+	SecondsSinceFlush += DeltaTime;
+
+	// Cheap when under budget: the cache size is accounted, not walked
+	Store->TrimCache();
+
+	SET_MEMORY_STAT(STAT_TPF_DeltaCacheMemory, Store->GetCacheAllocatedBytes());
+	SET_MEMORY_STAT(STAT_TPF_DeltaPendingMemory, Store->GetPendingBytes());
+	SET_MEMORY_STAT(STAT_TPF_DeltaCacheBudget, Store->CacheBudgetBytes);
+	SET_DWORD_STAT(STAT_TPF_DeltaResidentCells, Store->GetResidentCellCount());
+	SET_DWORD_STAT(STAT_TPF_DeltaCellEvictions, Store->GetEvictionCount());
+	SET_DWORD_STAT(STAT_TPF_DeltaCellReloads, Store->GetReloadCount());
+	CSV_CUSTOM_STAT(TPFCore, DeltaDirtyCells, Store->GetDirtyCellCount(), ECsvCustomStatOp::Set);
+
+	if (!bDraining && FlushPolicy.ShouldFlush(SecondsSinceFlush, Store->GetDirtyCellCount(), Store->GetPendingBytes()))
+	{
+		bDraining = true;
+	}
+
+	if (!bDraining)
+	{
+		return;
+	}
+
+	// One slice per tick keeps serialization and snapshot cost off a single frame
+	Store->FlushAsync(FlushPolicy.MaxCellsPerFrame);
+
+	if (Store->GetDirtyCellCount() == 0)
+	{
+		bDraining = false;
+		SecondsSinceFlush = 0.0;
+	}
+}
+
+void UDeltaStoreSubsystem::FlushNow()
+{
+	if (Store)
+	{
+		Store->Flush();
+	}
+	bDraining = false;
+	SecondsSinceFlush = 0.0;
+}
+
+void UDeltaStoreSubsystem::HandlePreLevelTransition()
+{
+	if (FlushPolicy.bFlushOnLevelTransition)
+	{
+		UE_LOG(LogTemp, Log, TEXT("DeltaStoreSubsystem: Flushing deltas before level transition"));
+		FlushNow();
+	}
+}
@@ -0,0 +1,575 @@
+// Copyright 2026 Threaded Pixel Factory
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "DeltaStreamingSubsystem.h"
+#include "DeltaStoreSubsystem.h"
+#include "FileDeltaStore.h"
+#include "TPFCoreStats.h"
+#include "TPFTimingRecorder.h"
+#include "Engine/World.h"
+#include "Engine/Level.h"
+#include "Engine/AssetManager.h"
+#include "Engine/StreamableManager.h"
+#include "GameFramework/WorldSettings.h"
+#include "Components/PrimitiveComponent.h"
+
+namespace
+{
+	/** Name prefix of actors spawned from an FSpawnDelta; the delta's guid follows */
+	const TCHAR* SpawnedActorPrefix = TEXT("DeltaSpawn_");
+}
+
+//=============================================================================
+// UWorldSubsystem Interface
+//=============================================================================
+
+bool UDeltaStreamingSubsystem::ShouldCreateSubsystem(UObject* Outer) const
+{
+	// Same worlds as the delta store
+	const UWorld* World = Cast<UWorld>(Outer);
+	return World && World->IsGameWorld() && Super::ShouldCreateSubsystem(Outer);
+}
+
+void UDeltaStreamingSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	TPF_TIMING_SCOPE(TEXT("DeltaStreamingSubsystem::Initialize"));
+
+	Super::Initialize(Collection);
+
+	// Store must exist before the first level streams in
+	Collection.InitializeDependency<UDeltaStoreSubsystem>();
+
+	LevelAddedHandle = FWorldDelegates::LevelAddedToWorld.AddUObject(this, &UDeltaStreamingSubsystem::HandleLevelAdded);
+	LevelRemovedHandle = FWorldDelegates::LevelRemovedFromWorld.AddUObject(this, &UDeltaStreamingSubsystem::HandleLevelRemoved);
+}
+
+void UDeltaStreamingSubsystem::Deinitialize()
+{
+	FWorldDelegates::LevelAddedToWorld.Remove(LevelAddedHandle);
+	FWorldDelegates::LevelRemovedFromWorld.Remove(LevelRemovedHandle);
+
+	for (FLevelApplyJob& Job : Jobs)
+	{
+		if (Job.ClassLoadHandle.IsValid())
+		{
+			Job.ClassLoadHandle->CancelHandle();
+		}
+	}
+	Jobs.Reset();
+	ActiveLevels.Reset();
+
+	// Spawned actors go with the world
+	SpawnedActors.Reset();
+	LevelSpawnRefs.Reset();
+
+	if (UFileDeltaStore* Store = GetStore())
+	{
+		for (const TPair<FWorldCellKey, int32>& Pair : ActiveCellRefs)
+		{
+			Store->UnpinCell(Pair.Key);
+		}
+	}
+	ActiveCellRefs.Reset();
+
+	Super::Deinitialize();
+}
+
+void UDeltaStreamingSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	// The persistent level never streams, but its actors can carry deltas too
+	HandleLevelAdded(InWorld.PersistentLevel, &InWorld);
+}
+
+//=============================================================================
+// Streaming Events
+//=============================================================================
+
+void UDeltaStreamingSubsystem::HandleLevelAdded(ULevel* InLevel, UWorld* InWorld)
+{
+	if (!InLevel || InWorld != GetWorld() || ActiveLevels.Contains(InLevel))
+	{
+		return;
+	}
+
+	UFileDeltaStore* Store = GetStore();
+	if (!Store)
+	{
+		return;
+	}
+
+	TArray<FWorldCellKey> Cells = ComputeLevelCells(*InLevel);
+	for (const FWorldCellKey& CellKey : Cells)
+	{
+		int32& Refs = ActiveCellRefs.FindOrAdd(CellKey);
+		if (Refs++ == 0)
+		{
+			// Streamed-in cells stay resident whatever the cache budget
+			Store->PinCell(CellKey);
+		}
+	}
+
+	// File reads and decoding run on workers; the job waits for them
+	Store->PrefetchCells(Cells);
+
+	UE_LOG(LogTemp, Verbose, TEXT("DeltaStreamingSubsystem: Level %s activated %d delta cells"),
+		*InLevel->GetOuter()->GetName(), Cells.Num());
+
+	FLevelApplyJob& Job = Jobs.AddDefaulted_GetRef();
+	Job.Level = InLevel;
+	Job.Cells = Cells;
+	ActiveLevels.Add(InLevel, MoveTemp(Cells));
+}
+
+void UDeltaStreamingSubsystem::HandleLevelRemoved(ULevel* InLevel, UWorld* InWorld)
+{
+	// A null level means the whole world is going away - Deinitialize handles it
+	if (!InLevel || InWorld != GetWorld())
+	{
+		return;
+	}
+
+	TArray<FWorldCellKey> Cells;
+	if (!ActiveLevels.RemoveAndCopyValue(InLevel, Cells))
+	{
+		return;
+	}
+
+	Jobs.RemoveAll([InLevel](const FLevelApplyJob& Job)
+	{
+		if (Job.Level.Get() == InLevel)
+		{
+			if (Job.ClassLoadHandle.IsValid())
+			{
+				Job.ClassLoadHandle->CancelHandle();
+			}
+			return true;
+		}
+		return false;
+	});
+
+	// Spawned actors live in the persistent level; the last covering level takes them down
+	TSet<FGuid> SpawnRefs;
+	if (LevelSpawnRefs.RemoveAndCopyValue(InLevel, SpawnRefs))
+	{
+		for (const FGuid& Guid : SpawnRefs)
+		{
+			FSpawnedDeltaActor* Spawned = SpawnedActors.Find(Guid);
+			if (Spawned && --Spawned->Refs <= 0)
+			{
+				if (AActor* Actor = Spawned->Actor.Get())
+				{
+					Actor->Destroy();
+				}
+				SpawnedActors.Remove(Guid);
+			}
+		}
+	}
+
+	UFileDeltaStore* Store = GetStore();
+	for (const FWorldCellKey& CellKey : Cells)
+	{
+		int32* Refs = ActiveCellRefs.Find(CellKey);
+		if (Refs && --(*Refs) <= 0)
+		{
+			ActiveCellRefs.Remove(CellKey);
+			if (Store)
+			{
+				// Now subject to the store's LRU budget
+				Store->UnpinCell(CellKey);
+			}
+		}
+	}
+}
+
+TArray<FWorldCellKey> UDeltaStreamingSubsystem::ComputeLevelCells(const ULevel& Level) const
+{
+	// Deltas are keyed by absolute position (world + origin), like USurfaceQuerySubsystem
+	const UWorld* World = GetWorld();
+	const FVector Origin = World ? FVector(World->OriginLocation) : FVector::ZeroVector;
+
+	FBox LocationBounds(ForceInit);
+	for (const AActor* Actor : Level.Actors)
+	{
+		if (IsValid(Actor) && Actor->GetRootComponent() && !Actor->IsA<AWorldSettings>())
+		{
+			LocationBounds += Actor->GetActorLocation() + Origin;
+		}
+	}
+
+	TArray<FWorldCellKey> Cells;
+	if (!LocationBounds.IsValid)
+	{
+		return Cells;
+	}
+
+	const FWorldCellKey MinCell = FWorldCellKey::FromWorldLocation(LocationBounds.Min, DeltaCellSize);
+	const FWorldCellKey MaxCell = FWorldCellKey::FromWorldLocation(LocationBounds.Max, DeltaCellSize);
+	const int64 BoundsCellCount = int64(MaxCell.X - MinCell.X + 1) * int64(MaxCell.Y - MinCell.Y + 1);
+
+	if (BoundsCellCount <= MaxCellsPerLevel)
+	{
+		// Whole rectangle, so spawn deltas in cells without authored actors are found too
+		Cells.Reserve(static_cast<int32>(BoundsCellCount));
+		for (int32 Y = MinCell.Y; Y <= MaxCell.Y; ++Y)
+		{
+			for (int32 X = MinCell.X; X <= MaxCell.X; ++X)
+			{
+				Cells.Emplace(X, Y);
+			}
+		}
+		return Cells;
+	}
+
+	// Sparse level (persistent level, large always-loaded sets): only occupied cells
+	TSet<FWorldCellKey> Occupied;
+	for (const AActor* Actor : Level.Actors)
+	{
+		if (IsValid(Actor) && Actor->GetRootComponent() && !Actor->IsA<AWorldSettings>())
+		{
+			Occupied.Add(FWorldCellKey::FromWorldLocation(Actor->GetActorLocation() + Origin, DeltaCellSize));
+		}
+	}
+	return Occupied.Array();
+}
+
+//=============================================================================
+// Apply
+//=============================================================================
+
+void UDeltaStreamingSubsystem::Tick(float DeltaTime)
+{
+	UFileDeltaStore* Store = GetStore();
+	if (!Store || !Store->IsInitialized())
+	{
+		return;
+	}
+
+	if (Jobs.Num() > 0)
+	{
+		SCOPE_CYCLE_COUNTER(STAT_TPF_DeltaStreamingApply);
+
+		const double Deadline = FPlatformTime::Seconds() + MaxApplyMillisecondsPerFrame / 1000.0;
+		for (int32 JobIndex = 0; JobIndex < Jobs.Num() && FPlatformTime::Seconds() < Deadline;)
+		{
+			FLevelApplyJob& Job = Jobs[JobIndex];
+			ULevel* Level = Job.Level.Get();
+			if (!Level || AdvanceJob(Job, *Level, *Store, Deadline))
+			{
+				Jobs.RemoveAt(JobIndex);
+				continue;
+			}
+			++JobIndex;
+		}
+	}
+}
+
+bool UDeltaStreamingSubsystem::AdvanceJob(FLevelApplyJob& Job, ULevel& Level, UFileDeltaStore& Store, double Deadline)
+{
+	if (!Job.bCellsLoaded)
+	{
+		for (const FWorldCellKey& CellKey : Job.Cells)
+		{
+			if (!Store.IsCellLoadComplete(CellKey))
+			{
+				return false;
+			}
+		}
+		Job.bCellsLoaded = true;
+	}
+
+	if (!Job.bActorsIndexed)
+	{
+		for (AActor* Actor : Level.Actors)
+		{
+			if (IsValid(Actor))
+			{
+				Job.ActorsByGuid.Add(GetActorDeltaGuid(Actor), Actor);
+			}
+		}
+		Job.bActorsIndexed = true;
+		BeginPhase(Job, Store);
+	}
+
+	while (Job.Phase != EApplyPhase::Done)
+	{
+		if (Job.CellIndex >= Job.Cells.Num())
+		{
+			Job.Phase = static_cast<EApplyPhase>(static_cast<uint8>(Job.Phase) + 1);
+			Job.CellIndex = 0;
+			Job.DeltaIndex = 0;
+			BeginPhase(Job, Store);
+			continue;
+		}
+
+		if (Job.ClassLoadHandle.IsValid() && Job.ClassLoadHandle->IsLoadingInProgress())
+		{
+			return false;
+		}
+
+		// Views are re-taken every slice: they do not survive across frames
+		const FWorldCellKey& CellKey = Job.Cells[Job.CellIndex];
+		int32 NumDeltas = 0;
+		switch (Job.Phase)
+		{
+		case EApplyPhase::Removes:
+		{
+			const TConstArrayView<FRemoveDelta> Deltas = Store.ViewRemoveDeltas(CellKey);
+			NumDeltas = Deltas.Num();
+			for (; Job.DeltaIndex < NumDeltas && FPlatformTime::Seconds() < Deadline; ++Job.DeltaIndex)
+			{
+				ApplyRemove(Job, Deltas[Job.DeltaIndex]);
+			}
+			break;
+		}
+		case EApplyPhase::Transforms:
+		{
+			const TConstArrayView<FTransformDelta> Deltas = Store.ViewTransformDeltas(CellKey);
+			NumDeltas = Deltas.Num();
+			for (; Job.DeltaIndex < NumDeltas && FPlatformTime::Seconds() < Deadline; ++Job.DeltaIndex)
+			{
+				const FTransformDelta& Delta = Deltas[Job.DeltaIndex];
+				const TPair<int32, int32>* Last = Job.LastTransform.Find(Delta.ActorGuid);
+				if (Last && Last->Key == Job.CellIndex && Last->Value == Job.DeltaIndex)
+				{
+					ApplyTransform(Job, Delta);
+				}
+			}
+			break;
+		}
+		case EApplyPhase::Spawns:
+		{
+			const TConstArrayView<FSpawnDelta> Deltas = Store.ViewSpawnDeltas(CellKey);
+			NumDeltas = Deltas.Num();
+			for (; Job.DeltaIndex < NumDeltas && FPlatformTime::Seconds() < Deadline; ++Job.DeltaIndex)
+			{
+				ApplySpawn(Job, Level, Deltas[Job.DeltaIndex]);
+			}
+			break;
+		}
+		default:
+			break;
+		}
+
+		if (Job.DeltaIndex < NumDeltas)
+		{
+			// Out of time this frame
+			return false;
+		}
+
+		++Job.CellIndex;
+		Job.DeltaIndex = 0;
+	}
+
+	UE_LOG(LogTemp, Verbose, TEXT("DeltaStreamingSubsystem: Applied deltas for level %s (%d cells)"),
+		*Level.GetOuter()->GetName(), Job.Cells.Num());
+	return true;
+}
+
+void UDeltaStreamingSubsystem::BeginPhase(FLevelApplyJob& Job, UFileDeltaStore& Store)
+{
+	if (Job.Phase == EApplyPhase::Transforms)
+	{
+		// Only the newest transform per actor matters. A moved actor can have deltas in
+		// several cells, so compare timestamps; within a cell, append order breaks ties.
+		for (int32 CellIndex = 0; CellIndex < Job.Cells.Num(); ++CellIndex)
+		{
+			const TConstArrayView<FTransformDelta> Deltas = Store.ViewTransformDeltas(Job.Cells[CellIndex]);
+			for (int32 DeltaIndex = 0; DeltaIndex < Deltas.Num(); ++DeltaIndex)
+			{
+				const FTransformDelta& Delta = Deltas[DeltaIndex];
+				TPair<int32, int32>* Existing = Job.LastTransform.Find(Delta.ActorGuid);
+				if (!Existing)
+				{
+					Job.LastTransform.Add(Delta.ActorGuid, TPair<int32, int32>(CellIndex, DeltaIndex));
+				}
+				else if (Delta.Timestamp >= Store.ViewTransformDeltas(Job.Cells[Existing->Key])[Existing->Value].Timestamp)
+				{
+					*Existing = TPair<int32, int32>(CellIndex, DeltaIndex);
+				}
+			}
+		}
+	}
+	else if (Job.Phase == EApplyPhase::Spawns)
+	{
+		// Load spawn classes in one async request before spawning anything
+		TArray<FSoftObjectPath> ClassPaths;
+		for (const FWorldCellKey& CellKey : Job.Cells)
+		{
+			for (const FSpawnDelta& Delta : Store.ViewSpawnDeltas(CellKey))
+			{
+				if (!Job.RemovedGuids.Contains(Delta.ActorGuid) && !Delta.ActorClass.IsNull() && !Delta.ActorClass.Get())
+				{
+					ClassPaths.AddUnique(Delta.ActorClass.ToSoftObjectPath());
+				}
+			}
+		}
+
+		if (ClassPaths.Num() > 0)
+		{
+			if (UAssetManager* AssetManager = UAssetManager::GetIfInitialized())
+			{
+				Job.ClassLoadHandle = AssetManager->GetStreamableManager().RequestAsyncLoad(ClassPaths);
+			}
+		}
+	}
+}
+
+void UDeltaStreamingSubsystem::ApplyRemove(FLevelApplyJob& Job, const FRemoveDelta& Delta)
+{
+	Job.RemovedGuids.Add(Delta.ActorGuid);
+
+	TWeakObjectPtr<AActor> ActorPtr;
+	if (Job.ActorsByGuid.RemoveAndCopyValue(Delta.ActorGuid, ActorPtr))
+	{
+		if (AActor* Actor = ActorPtr.Get())
+		{
+			Actor->Destroy();
+			INC_DWORD_STAT(STAT_TPF_StreamedDeltasApplied);
+		}
+	}
+
+	// Spawned by another level's job; other covering levels must not bring it back
+	if (FSpawnedDeltaActor* Spawned = SpawnedActors.Find(Delta.ActorGuid))
+	{
+		if (AActor* Actor = Spawned->Actor.Get())
+		{
+			Actor->Destroy();
+			INC_DWORD_STAT(STAT_TPF_StreamedDeltasApplied);
+		}
+		Spawned->Actor = nullptr;
+		Spawned->bRemoved = true;
+	}
+}
+
+void UDeltaStreamingSubsystem::ApplyTransform(FLevelApplyJob& Job, const FTransformDelta& Delta)
+{
+	if (Job.RemovedGuids.Contains(Delta.ActorGuid))
+	{
+		return;
+	}
+
+	const TWeakObjectPtr<AActor>* ActorPtr = Job.ActorsByGuid.Find(Delta.ActorGuid);
+	AActor* Actor = ActorPtr ? ActorPtr->Get() : nullptr;
+	if (!Actor)
+	{
+		return;
+	}
+
+	USceneComponent* Root = Actor->GetRootComponent();
+	if (!Root || Root->Mobility == EComponentMobility::Static)
+	{
+		UE_LOG(LogTemp, Verbose, TEXT("DeltaStreamingSubsystem: Skipping transform delta for static actor %s"), *Actor->GetName());
+		return;
+	}
+
+	Actor->SetActorTransform(Delta.Transform, false, nullptr, ETeleportType::ResetPhysics);
+
+	if (UPrimitiveComponent* Primitive = Cast<UPrimitiveComponent>(Root))
+	{
+		if (Primitive->IsSimulatingPhysics() != Delta.bPhysicsEnabled)
+		{
+			Primitive->SetSimulatePhysics(Delta.bPhysicsEnabled);
+		}
+		if (Delta.bPhysicsEnabled && Delta.bIsSleeping)
+		{
+			// Settled debris stays settled instead of re-simulating on stream-in
+			Primitive->PutAllRigidBodiesToSleep();
+		}
+	}
+	INC_DWORD_STAT(STAT_TPF_StreamedDeltasApplied);
+}
+
+void UDeltaStreamingSubsystem::ApplySpawn(FLevelApplyJob& Job, ULevel& Level, const FSpawnDelta& Delta)
+{
+	if (Job.RemovedGuids.Contains(Delta.ActorGuid))
+	{
+		return;
+	}
+
+	// An authored actor of this level already has the guid
+	FSpawnedDeltaActor* Existing = SpawnedActors.Find(Delta.ActorGuid);
+	if (!Existing && Job.ActorsByGuid.Contains(Delta.ActorGuid))
+	{
+		return;
+	}
+
+	// One reference per covering level, however many times its cells repeat the delta
+	FSpawnedDeltaActor& Spawned = Existing ? *Existing : SpawnedActors.Add(Delta.ActorGuid);
+	bool bAlreadyReferenced = false;
+	LevelSpawnRefs.FindOrAdd(&Level).Add(Delta.ActorGuid, &bAlreadyReferenced);
+	if (!bAlreadyReferenced)
+	{
+		++Spawned.Refs;
+	}
+
+	// An overlapping level got here first
+	if (Spawned.bRemoved || Spawned.Actor.IsValid())
+	{
+		return;
+	}
+
+	UClass* ActorClass = Delta.ActorClass.Get();
+	if (!ActorClass)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("DeltaStreamingSubsystem: Spawn delta %s has no loadable class (%s)"),
+			*Delta.ActorGuid.ToString(), *Delta.ActorClass.ToString());
+		return;
+	}
+
+	FActorSpawnParameters SpawnParams;
+	SpawnParams.Name = FName(*(FString(SpawnedActorPrefix) + Delta.ActorGuid.ToString(EGuidFormats::Digits)));
+	SpawnParams.NameMode = FActorSpawnParameters::ESpawnActorNameMode::Requested;
+	SpawnParams.OverrideLevel = GetWorld()->PersistentLevel;
+	SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+
+	// Not owned by any one streamed level: HandleLevelRemoved destroys it once no covering level is left
+	if (AActor* SpawnedActor = GetWorld()->SpawnActor(ActorClass, &Delta.SpawnTransform, SpawnParams))
+	{
+		Spawned.Actor = SpawnedActor;
+		Job.ActorsByGuid.Add(Delta.ActorGuid, SpawnedActor);
+		INC_DWORD_STAT(STAT_TPF_StreamedDeltasApplied);
+	}
+}
+
+//=============================================================================
+// Helpers
+//=============================================================================
+
+FGuid UDeltaStreamingSubsystem::GetActorDeltaGuid(const AActor* Actor)
+{
+	if (!Actor)
+	{
+		return FGuid();
+	}
+
+	const FString ActorName = Actor->GetFName().ToString();
+	const int32 PrefixLength = FCString::Strlen(SpawnedActorPrefix);
+	if (ActorName.StartsWith(SpawnedActorPrefix))
+	{
+		FGuid SpawnGuid;
+		if (FGuid::ParseExact(ActorName.Mid(PrefixLength, 32), EGuidFormats::Digits, SpawnGuid))
+		{
+			return SpawnGuid;
+		}
+	}
+
+	return FGuid::NewDeterministicGuid(ActorName);
+}
+
+UFileDeltaStore* UDeltaStreamingSubsystem::GetStore() const
+{
+	const UDeltaStoreSubsystem* DeltaStore = GetWorld()->GetSubsystem<UDeltaStoreSubsystem>();
+	return DeltaStore ? DeltaStore->GetDeltaStore() : nullptr;
+}
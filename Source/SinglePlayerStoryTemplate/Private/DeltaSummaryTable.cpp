@@ -0,0 +1,231 @@
+// Copyright 2026 Threaded Pixel Factory
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "DeltaSummaryTable.h"
+#include "Serialization/MemoryWriter.h"
+#include "Serialization/MemoryReader.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "HAL/FileManager.h"
+#include "Misc/ScopeLock.h"
+
+namespace
+{
+	/** Distinct actor guids in a delta array, folding in the newest timestamp */
+	template<typename DeltaType>
+	int32 CountDistinct(const TArray<DeltaType>& Deltas, FGuid DeltaType::*GuidMember, double& InOutLatest)
+	{
+		TSet<FGuid> Seen;
+		Seen.Reserve(Deltas.Num());
+		for (const DeltaType& Delta : Deltas)
+		{
+			Seen.Add(Delta.*GuidMember);
+			InOutLatest = FMath::Max(InOutLatest, Delta.Timestamp);
+		}
+		return Seen.Num();
+	}
+}
+
+FDeltaCellSummary FDeltaSummaryTable::Summarize(const FWorldCellKey& CellKey, const FDeltaCellData& Data)
+{
+	FDeltaCellSummary Summary;
+	Summary.CellKey = CellKey;
+	if (Data.IsEmpty())
+	{
+		return Summary;
+	}
+
+	Summary.CellsWithDeltas = 1;
+	Summary.SetSurfaceFromDeltas(Data.SurfaceDeltas);
+	Summary.RemovedActors = CountDistinct(Data.RemoveDeltas, &FRemoveDelta::ActorGuid, Summary.LatestTimestamp);
+	Summary.MovedActors = CountDistinct(Data.TransformDeltas, &FTransformDelta::ActorGuid, Summary.LatestTimestamp);
+	Summary.SpawnedActors = CountDistinct(Data.SpawnDeltas, &FSpawnDelta::ActorGuid, Summary.LatestTimestamp);
+	Summary.FracturedActors = CountDistinct(Data.FractureDeltas, &FFractureDelta::ActorGuid, Summary.LatestTimestamp);
+	Summary.Assemblies = CountDistinct(Data.AssemblyDeltas, &FAssemblyDelta::AssemblyGuid, Summary.LatestTimestamp);
+	return Summary;
+}
+
+void FDeltaSummaryTable::Reset(int32 InMaxLOD)
+{
+	FScopeLock ScopeLock(&Lock);
+	MaxLOD = FMath::Clamp(InMaxLOD, 0, 15);
+	Levels.Reset();
+	Levels.SetNum(MaxLOD + 1);
+}
+
+void FDeltaSummaryTable::SetCell(const FDeltaCellSummary& Summary)
+{
+	if (Summary.CellKey.LOD != 0)
+	{
+		return;
+	}
+
+	FScopeLock ScopeLock(&Lock);
+	if (Levels.Num() == 0)
+	{
+		Levels.SetNum(MaxLOD + 1);
+	}
+
+	FDeltaCellSummary Previous;
+	if (Levels[0].RemoveAndCopyValue(Summary.CellKey, Previous))
+	{
+		AccumulateAncestors(Previous, -1);
+	}
+
+	if (!Summary.IsEmpty())
+	{
+		Levels[0].Add(Summary.CellKey, Summary);
+		AccumulateAncestors(Summary, 1);
+	}
+}
+
+void FDeltaSummaryTable::AccumulateAncestors(const FDeltaCellSummary& Base, int32 Sign)
+{
+	for (int32 LOD = 1; LOD <= MaxLOD; LOD++)
+	{
+		const FWorldCellKey ParentKey = Base.CellKey.GetParent(LOD);
+		const int32 CellsPerAxis = FWorldCellKey::GetCellsPerAxis(0, LOD);
+
+		FDeltaCellSummary& Parent = Levels[LOD].FindOrAdd(ParentKey);
+		Parent.CellKey = ParentKey;
+		Parent.Accumulate(Base, CellsPerAxis * CellsPerAxis, Sign);
+
+		if (Parent.IsEmpty())
+		{
+			// Float residue from add/subtract pairs must not outlive the last contributor
+			Levels[LOD].Remove(ParentKey);
+		}
+	}
+}
+
+bool FDeltaSummaryTable::Find(const FWorldCellKey& CellKey, FDeltaCellSummary& OutSummary) const
+{
+	FScopeLock ScopeLock(&Lock);
+	if (!Levels.IsValidIndex(CellKey.LOD))
+	{
+		return false;
+	}
+
+	if (const FDeltaCellSummary* Found = Levels[CellKey.LOD].Find(CellKey))
+	{
+		OutSummary = *Found;
+		return true;
+	}
+	return false;
+}
+
+int32 FDeltaSummaryTable::GetMaxLOD() const
+{
+	FScopeLock ScopeLock(&Lock);
+	return MaxLOD;
+}
+
+int32 FDeltaSummaryTable::Num() const
+{
+	FScopeLock ScopeLock(&Lock);
+	return Levels.Num() > 0 ? Levels[0].Num() : 0;
+}
+
+bool FDeltaSummaryTable::Save(const FString& FilePath) const
+{
+	TArray<uint8> Bytes;
+	{
+		FScopeLock ScopeLock(&Lock);
+		FMemoryWriter Ar(Bytes);
+
+		uint32 FileMagic = DeltaSummaryFormat::Magic;
+		uint16 Version = DeltaSummaryFormat::CurrentVersion;
+		uint16 Flags = 0;
+		int32 Count = Levels.Num() > 0 ? Levels[0].Num() : 0;
+		Ar << FileMagic << Version << Flags << Count;
+
+		if (Count > 0)
+		{
+			for (const TPair<FWorldCellKey, FDeltaCellSummary>& Cell : Levels[0])
+			{
+				FDeltaCellSummary Summary = Cell.Value;
+				Ar << Summary;
+			}
+		}
+	}
+
+	// Write outside the lock; workers updating other cells need not wait on disk.
+	// Write-then-move so a crash mid-write leaves the previous file, not a torn one
+	const FString TempPath = FPaths::CreateTempFilename(*FPaths::GetPath(FilePath), *FPaths::GetBaseFilename(FilePath), TEXT(".tmp"));
+	if (!FFileHelper::SaveArrayToFile(Bytes, *TempPath) || !IFileManager::Get().Move(*FilePath, *TempPath, true, true))
+	{
+		IFileManager::Get().Delete(*TempPath, false, false, true);
+		UE_LOG(LogTemp, Warning, TEXT("DeltaSummaryTable: Could not write summary file %s"), *FilePath);
+		return false;
+	}
+	return true;
+}
+
+bool FDeltaSummaryTable::Load(const FString& FilePath)
+{
+	TArray<uint8> Bytes;
+	const bool bRead = FFileHelper::LoadFileToArray(Bytes, *FilePath, FILEREAD_Silent);
+
+	FScopeLock ScopeLock(&Lock);
+	Levels.Reset();
+	Levels.SetNum(MaxLOD + 1);
+	if (!bRead)
+	{
+		return false;
+	}
+
+	FMemoryReader Ar(Bytes);
+	uint32 FileMagic = 0;
+	uint16 Version = 0;
+	uint16 Flags = 0;
+	int32 Count = 0;
+	Ar << FileMagic << Version << Flags << Count;
+
+	if (Ar.IsError() || FileMagic != DeltaSummaryFormat::Magic || Version != DeltaSummaryFormat::CurrentVersion)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("DeltaSummaryTable: Ignoring stale or invalid summary file %s"), *FilePath);
+		return false;
+	}
+
+	// The count sizes a reservation; it can't promise more records than the file holds
+	if (Count < 0 || Count > (Ar.TotalSize() - Ar.Tell()) / DeltaSummaryFormat::RecordBytes)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("DeltaSummaryTable: Summary file %s claims %d records, more than it holds"), *FilePath, Count);
+		return false;
+	}
+
+	Levels[0].Reserve(Count);
+	for (int32 i = 0; i < Count && !Ar.IsError(); i++)
+	{
+		FDeltaCellSummary Summary;
+		Ar << Summary;
+		if (!Ar.IsError() && Summary.CellKey.LOD == 0 && !Summary.IsEmpty())
+		{
+			Levels[0].Add(Summary.CellKey, Summary);
+		}
+	}
+
+	if (Ar.IsError())
+	{
+		UE_LOG(LogTemp, Warning, TEXT("DeltaSummaryTable: Truncated summary file %s"), *FilePath);
+		Levels.Reset();
+		Levels.SetNum(MaxLOD + 1);
+		return false;
+	}
+
+	for (const TPair<FWorldCellKey, FDeltaCellSummary>& Cell : Levels[0])
+	{
+		AccumulateAncestors(Cell.Value, 1);
+	}
+	return true;
+}
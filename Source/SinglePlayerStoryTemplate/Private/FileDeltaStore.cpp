@@ -12,22 +12,70 @@
 // limitations under the License.
 
 #include "FileDeltaStore.h"
+#include "DeltaCellFormat.h"
+#include "TPFCoreStats.h"
 #include "Misc/FileHelper.h"
 #include "Misc/Paths.h"
 #include "HAL/PlatformFileManager.h"
-#include "JsonObjectConverter.h"
-#include "Serialization/JsonSerializer.h"
-#include "Serialization/JsonWriter.h"
 #include "Tasks/Task.h"
-#include "Tasks/Pipe.h"
+#include "Misc/ScopeLock.h"
+
+namespace
+{
+	/** Prepend Loaded in front of Existing, preserving append order */
+	template<typename DeltaType>
+	void MergeLoadedArray(TArray<DeltaType>& Existing, TArray<DeltaType>& Loaded)
+	{
+		if (Loaded.Num() == 0)
+		{
+			return;
+		}
+
+		Loaded.Append(MoveTemp(Existing));
+		Existing = MoveTemp(Loaded);
+	}
+
+	/** Parse a cell directory name written by FWorldCellKey::ToString, "(X,Y,LODn)" */
+	bool ParseCellDirectoryName(const FString& Name, FWorldCellKey& OutCellKey)
+	{
+		if (!Name.StartsWith(TEXT("(")) || !Name.EndsWith(TEXT(")")))
+		{
+			return false;
+		}
+
+		TArray<FString> Parts;
+		Name.Mid(1, Name.Len() - 2).ParseIntoArray(Parts, TEXT(","));
+		if (Parts.Num() != 3 || !Parts[2].StartsWith(TEXT("LOD")))
+		{
+			return false;
+		}
+
+		Parts[2].RightChopInline(3);
+		return LexTryParseString(OutCellKey.X, *Parts[0])
+			&& LexTryParseString(OutCellKey.Y, *Parts[1])
+			&& LexTryParseString(OutCellKey.LOD, *Parts[2]);
+	}
+}
 
 UFileDeltaStore::UFileDeltaStore()
+	: SummaryTable(MakeShared<FDeltaSummaryTable, ESPMode::ThreadSafe>())
+	, FlushQueue(MakeShared<FFlushQueueState, ESPMode::ThreadSafe>())
 {
 	BaseSaveDirectory = FPaths::ProjectSavedDir() / TEXT("GameSaveData");
 }
 
+void UFileDeltaStore::BeginDestroy()
+{
+	// Queued batches own their data, but the pipe itself must drain before destruction
+	WaitForFlush();
+	Super::BeginDestroy();
+}
+
 bool UFileDeltaStore::Initialize(const FString& WorldName)
 {
+	// Writes for the previous world must land before its caches are dropped
+	WaitForFlush();
+
 	CurrentWorldName = WorldName;
 	FString WorldDir = BaseSaveDirectory / WorldName;
 	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
@@ -41,255 +89,782 @@ bool UFileDeltaStore::Initialize(const FString& WorldName)
 		}
 	}
 
+	// Reset caches - residency is per world
+	Cells.Empty();
+	DirtyCells.Empty();
+	PendingAppendBytes = 0;
+	ResidentCells.Empty();
+	PendingLoads.Empty();
+	SurfaceFoldIndex.Empty();
+	CellLastUse.Empty();
+	CellBytes.Empty();
+	StaleByteCells.Empty();
+	CachedBytes = 0;
+	PinnedCells.Empty();
+	EvictedCells.Empty();
+	EvictionCount = 0;
+	ReloadCount = 0;
+
+	// Missing, stale or corrupt summaries are rebuilt from the cell files; queries fill in as it runs
+	SummaryTable->Reset(MaxSummaryLOD);
+	if (!SummaryTable->Load(WorldDir / DeltaSummaryFormat::FileName))
+	{
+		// On the flush pipe, so every later flush lands after the rebuild
+		LastFlushTask = FlushPipe.Launch(
+			UE_SOURCE_LOCATION,
+			[Summaries = SummaryTable, WorldDir]()
+			{
+				RebuildSummaries(WorldDir, *Summaries);
+			}
+		);
+	}
+
 	bIsInitialized = true;
 	UE_LOG(LogTemp, Log, TEXT("FileDeltaStore initialized for world: %s"), *WorldName);
 	return true;
 }
 
+//=============================================================================
+// CELL LOADING
+//=============================================================================
+
+FString UFileDeltaStore::GetCellDirectory(const FWorldCellKey& CellKey) const
+{
+	return BaseSaveDirectory / CurrentWorldName / CellKey.ToString();
+}
+
+TSharedPtr<FDeltaCellData> UFileDeltaStore::ReadCellFile(const FString& CellDir)
+{
+	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+
+	// Binary is authoritative; JSON is only read for saves written before the binary format
+	const FString BinaryPath = CellDir / DeltaCellFormat::BinaryFileName;
+	if (PlatformFile.FileExists(*BinaryPath))
+	{
+		TArray<uint8> Bytes;
+		if (!FFileHelper::LoadFileToArray(Bytes, *BinaryPath))
+		{
+			UE_LOG(LogTemp, Warning, TEXT("FileDeltaStore: Failed to read cell file: %s"), *BinaryPath);
+			return nullptr;
+		}
+
+		TSharedPtr<FDeltaCellData> Loaded = MakeShared<FDeltaCellData>();
+		FWorldCellKey FileCellKey;
+		if (!DeltaCellFormat::ReadBinary(Bytes, FileCellKey, *Loaded))
+		{
+			UE_LOG(LogTemp, Warning, TEXT("FileDeltaStore: Failed to decode cell file: %s"), *BinaryPath);
+			return nullptr;
+		}
+		return Loaded;
+	}
+
+	const FString JsonPath = CellDir / DeltaCellFormat::JsonFileName;
+	if (PlatformFile.FileExists(*JsonPath))
+	{
+		FString JsonString;
+		TSharedPtr<FDeltaCellData> Loaded = MakeShared<FDeltaCellData>();
+		if (!FFileHelper::LoadFileToString(JsonString, *JsonPath) || !DeltaCellFormat::ReadJson(JsonString, *Loaded))
+		{
+			UE_LOG(LogTemp, Warning, TEXT("FileDeltaStore: Failed to parse legacy cell file: %s"), *JsonPath);
+			return nullptr;
+		}
+		return Loaded;
+	}
+
+	return nullptr;
+}
+
+int32 UFileDeltaStore::PrefetchCells(const TArray<FWorldCellKey>& CellKeys)
+{
+	if (!bIsInitialized)
+	{
+		return 0;
+	}
+
+	ProcessCompletedLoads();
+
+	int32 Launched = 0;
+	for (const FWorldCellKey& CellKey : CellKeys)
+	{
+		if (ResidentCells.Contains(CellKey) || PendingLoads.Contains(CellKey))
+		{
+			continue;
+		}
+
+		// Worker only touches the path it was given - no UObject access off the game thread
+		PendingLoads.Add(CellKey, UE::Tasks::Launch(
+			UE_SOURCE_LOCATION,
+			[CellDir = GetCellDirectory(CellKey)]()
+			{
+				return ReadCellFile(CellDir);
+			}
+		));
+		Launched++;
+	}
+
+	UE_LOG(LogTemp, Verbose, TEXT("FileDeltaStore: Prefetching %d cells (%d pending)"), Launched, PendingLoads.Num());
+	return Launched;
+}
+
+bool UFileDeltaStore::IsCellLoadComplete(const FWorldCellKey& CellKey) const
+{
+	if (ResidentCells.Contains(CellKey))
+	{
+		return true;
+	}
+
+	// Not prefetched: a query falls back to the synchronous read
+	const UE::Tasks::TTask<TSharedPtr<FDeltaCellData>>* Pending = PendingLoads.Find(CellKey);
+	return !Pending || Pending->IsCompleted();
+}
+
+bool UFileDeltaStore::CanEvictCell(const FWorldCellKey& CellKey) const
+{
+	if (DirtyCells.Contains(CellKey) || PinnedCells.Contains(CellKey))
+	{
+		return false;
+	}
+
+	// A flush snapshot still shares the data: the file on disk is not current yet
+	const TSharedPtr<FDeltaCellData>* Slot = Cells.Find(CellKey);
+	return !Slot || !Slot->IsValid() || Slot->IsUnique();
+}
+
+bool UFileDeltaStore::EvictCell(const FWorldCellKey& CellKey)
+{
+	if (!ResidentCells.Contains(CellKey) || !CanEvictCell(CellKey))
+	{
+		return false;
+	}
+
+	// Cells with no persisted or appended deltas are resident without a cache entry
+	TSharedPtr<FDeltaCellData> Evicted;
+	Cells.RemoveAndCopyValue(CellKey, Evicted);
+	ResidentCells.Remove(CellKey);
+	SurfaceFoldIndex.Remove(CellKey);
+	CellLastUse.Remove(CellKey);
+	ForgetCellBytes(CellKey);
+	EvictedCells.Add(CellKey);
+	EvictionCount++;
+
+	// Surface grids derived from this cell must not outlive it
+	if (Evicted.IsValid() && Evicted->SurfaceDeltas.Num() > 0)
+	{
+		IDeltaStore::OnSurfaceDeltasChanged().Broadcast(this, CellKey, INDEX_NONE, nullptr);
+	}
+	return true;
+}
+
+int32 UFileDeltaStore::TrimCache()
+{
+	if (CacheBudgetBytes <= 0)
+	{
+		return 0;
+	}
+
+	RefreshCellBytes();
+	if (CachedBytes <= CacheBudgetBytes)
+	{
+		return 0;
+	}
+
+	// Oldest first; eviction is rare enough that a sort beats maintaining a list.
+	// Only evictable cells are sorted, so a cache of dirty or pinned cells costs one pass.
+	TArray<TPair<uint64, FWorldCellKey>> Candidates;
+	for (const FWorldCellKey& CellKey : ResidentCells)
+	{
+		if (CanEvictCell(CellKey))
+		{
+			const uint64* LastUse = CellLastUse.Find(CellKey);
+			Candidates.Emplace(LastUse ? *LastUse : 0, CellKey);
+		}
+	}
+	if (Candidates.Num() == 0)
+	{
+		return 0;
+	}
+	Candidates.Sort([](const TPair<uint64, FWorldCellKey>& A, const TPair<uint64, FWorldCellKey>& B) { return A.Key < B.Key; });
+
+	int32 Evicted = 0;
+	for (const TPair<uint64, FWorldCellKey>& Candidate : Candidates)
+	{
+		if (CachedBytes <= CacheBudgetBytes)
+		{
+			break;
+		}
+		if (EvictCell(Candidate.Value))
+		{
+			Evicted++;
+		}
+	}
+
+	if (Evicted > 0)
+	{
+		UE_LOG(LogTemp, Verbose, TEXT("FileDeltaStore: Evicted %d cells (cache %lld / %lld bytes)"), Evicted, CachedBytes, CacheBudgetBytes);
+	}
+	return Evicted;
+}
+
+void UFileDeltaStore::PinCell(const FWorldCellKey& CellKey)
+{
+	PinnedCells.FindOrAdd(CellKey)++;
+}
+
+void UFileDeltaStore::UnpinCell(const FWorldCellKey& CellKey)
+{
+	int32* Pins = PinnedCells.Find(CellKey);
+	if (Pins && --(*Pins) <= 0)
+	{
+		PinnedCells.Remove(CellKey);
+	}
+}
+
+void UFileDeltaStore::RefreshCellBytes() const
+{
+	for (const FWorldCellKey& CellKey : StaleByteCells)
+	{
+		const int64 NewBytes = GetCellAllocatedBytes(CellKey);
+		int64& Accounted = CellBytes.FindOrAdd(CellKey);
+		CachedBytes += NewBytes - Accounted;
+		Accounted = NewBytes;
+	}
+	StaleByteCells.Reset();
+}
+
+void UFileDeltaStore::ForgetCellBytes(const FWorldCellKey& CellKey)
+{
+	int64 Accounted = 0;
+	if (CellBytes.RemoveAndCopyValue(CellKey, Accounted))
+	{
+		CachedBytes -= Accounted;
+	}
+	StaleByteCells.Remove(CellKey);
+}
+
+void UFileDeltaStore::EnsureCellResident(const FWorldCellKey& CellKey) const
+{
+	if (!bIsInitialized)
+	{
+		return;
+	}
+
+	TouchCell(CellKey);
+	if (ResidentCells.Contains(CellKey))
+	{
+		return;
+	}
+
+	// Residency is a cache concern; queries stay logically const
+	UFileDeltaStore* MutableThis = const_cast<UFileDeltaStore*>(this);
+
+	TSharedPtr<FDeltaCellData> Loaded;
+	if (UE::Tasks::TTask<TSharedPtr<FDeltaCellData>>* Pending = MutableThis->PendingLoads.Find(CellKey))
+	{
+		// Usually already complete when prefetched ahead of streaming
+		Loaded = Pending->GetResult();
+		MutableThis->PendingLoads.Remove(CellKey);
+	}
+	else
+	{
+		UE_LOG(LogTemp, Verbose, TEXT("FileDeltaStore: Synchronous load for cell %s (not prefetched)"), *CellKey.ToString());
+		Loaded = ReadCellFile(GetCellDirectory(CellKey));
+	}
+
+	MutableThis->MergeLoadedCell(CellKey, Loaded);
+}
+
+void UFileDeltaStore::MergeLoadedCell(const FWorldCellKey& CellKey, const TSharedPtr<FDeltaCellData>& Loaded)
+{
+	ResidentCells.Add(CellKey);
+	if (EvictedCells.Remove(CellKey) > 0)
+	{
+		ReloadCount++;
+	}
+
+	if (!Loaded.IsValid() || Loaded->IsEmpty())
+	{
+		return;
+	}
+
+	MarkCellBytesStale(CellKey);
+
+	SurfaceFoldIndex.Remove(CellKey);
+
+	// Nothing appended while cold - adopt the loaded data as-is
+	TSharedPtr<FDeltaCellData>& Slot = Cells.FindOrAdd(CellKey);
+	if (!Slot.IsValid())
+	{
+		Slot = Loaded;
+	}
+	else
+	{
+		FDeltaCellData& Cell = GetMutableCell(CellKey);
+		MergeLoadedArray(Cell.SurfaceDeltas, Loaded->SurfaceDeltas);
+		MergeLoadedArray(Cell.FractureDeltas, Loaded->FractureDeltas);
+		MergeLoadedArray(Cell.TransformDeltas, Loaded->TransformDeltas);
+		MergeLoadedArray(Cell.SpawnDeltas, Loaded->SpawnDeltas);
+		MergeLoadedArray(Cell.RemoveDeltas, Loaded->RemoveDeltas);
+		MergeLoadedArray(Cell.AssemblyDeltas, Loaded->AssemblyDeltas);
+	}
+
+	if (bCoalesceSurfaceDeltas)
+	{
+		FSurfaceTileDelta::CoalesceInPlace(GetMutableCell(CellKey).SurfaceDeltas);
+	}
+
+	if (Loaded->SurfaceDeltas.Num() > 0)
+	{
+		IDeltaStore::OnSurfaceDeltasChanged().Broadcast(this, CellKey, INDEX_NONE, nullptr);
+	}
+}
+
+void UFileDeltaStore::ProcessCompletedLoads()
+{
+	for (auto It = PendingLoads.CreateIterator(); It; ++It)
+	{
+		if (It->Value.IsCompleted())
+		{
+			// Release the task's reference first so the adopted cell is uniquely owned
+			const FWorldCellKey CellKey = It->Key;
+			TSharedPtr<FDeltaCellData> Loaded = It->Value.GetResult();
+			It.RemoveCurrent();
+			MergeLoadedCell(CellKey, Loaded);
+		}
+	}
+}
+
+//=============================================================================
+// CELL STORAGE
+//=============================================================================
+
+FDeltaCellData& UFileDeltaStore::GetMutableCell(const FWorldCellKey& CellKey)
+{
+	// Every caller mutates the cell's arrays
+	TouchCell(CellKey);
+	MarkCellBytesStale(CellKey);
+
+	TSharedPtr<FDeltaCellData>& Slot = Cells.FindOrAdd(CellKey);
+	if (!Slot.IsValid())
+	{
+		Slot = MakeShared<FDeltaCellData>();
+	}
+	else if (!Slot.IsUnique())
+	{
+		// A flush snapshot still references this generation - copy on write
+		Slot = MakeShared<FDeltaCellData>(*Slot);
+		CopyOnWriteCount++;
+	}
+	return *Slot;
+}
+
+const FDeltaCellData* UFileDeltaStore::FindCell(const FWorldCellKey& CellKey) const
+{
+	const TSharedPtr<FDeltaCellData>* Slot = Cells.Find(CellKey);
+	return (Slot && Slot->IsValid()) ? Slot->Get() : nullptr;
+}
+
+TMap<uint64, int32>& UFileDeltaStore::GetSurfaceFoldIndex(const FWorldCellKey& CellKey, const TArray<FSurfaceTileDelta>& CellDeltas)
+{
+	if (TMap<uint64, int32>* Found = SurfaceFoldIndex.Find(CellKey))
+	{
+		return *Found;
+	}
+
+	TMap<uint64, int32>& Index = SurfaceFoldIndex.Add(CellKey);
+	for (int32 i = 0; i < CellDeltas.Num(); i++)
+	{
+		Index.Add(FSurfaceTileDelta::MakeTileChannelKey(CellDeltas[i].TileIndex, CellDeltas[i].Channel), i);
+	}
+	return Index;
+}
+
 // IDeltaStore: Append methods
 void UFileDeltaStore::AppendSurfaceDelta(const FSurfaceTileDelta& Delta)
 {
-	SurfaceDeltas.FindOrAdd(Delta.CellKey).Add(Delta);
+	TArray<FSurfaceTileDelta>& CellDeltas = GetMutableCell(Delta.CellKey).SurfaceDeltas;
 	DirtyCells.Add(Delta.CellKey);
+	PendingAppendBytes += sizeof(FSurfaceTileDelta);
+
+	if (!bCoalesceSurfaceDeltas)
+	{
+		CellDeltas.Add(Delta);
+	}
+	else
+	{
+		TMap<uint64, int32>& Index = GetSurfaceFoldIndex(Delta.CellKey, CellDeltas);
+		const uint64 Key = FSurfaceTileDelta::MakeTileChannelKey(Delta.TileIndex, Delta.Channel);
+		const int32* Last = Index.Find(Key);
+		if (!Last || !CellDeltas[*Last].TryCoalesce(Delta))
+		{
+			Index.Add(Key, CellDeltas.Add(Delta));
+		}
+	}
+
+	IDeltaStore::OnSurfaceDeltasChanged().Broadcast(this, Delta.CellKey, Delta.TileIndex, &Delta);
 }
 
 void UFileDeltaStore::AppendFractureDelta(const FFractureDelta& Delta)
 {
-	FractureDeltas.FindOrAdd(Delta.CellKey).Add(Delta);
+	GetMutableCell(Delta.CellKey).FractureDeltas.Add(Delta);
 	DirtyCells.Add(Delta.CellKey);
+	PendingAppendBytes += sizeof(FFractureDelta);
 }
 
 void UFileDeltaStore::AppendTransformDelta(const FTransformDelta& Delta)
 {
-	TransformDeltas.FindOrAdd(Delta.CellKey).Add(Delta);
+	GetMutableCell(Delta.CellKey).TransformDeltas.Add(Delta);
 	DirtyCells.Add(Delta.CellKey);
+	PendingAppendBytes += sizeof(FTransformDelta);
 }
 
 void UFileDeltaStore::AppendSpawnDelta(const FSpawnDelta& Delta)
 {
-	SpawnDeltas.FindOrAdd(Delta.CellKey).Add(Delta);
+	GetMutableCell(Delta.CellKey).SpawnDeltas.Add(Delta);
 	DirtyCells.Add(Delta.CellKey);
+	PendingAppendBytes += sizeof(FSpawnDelta);
 }
 
 void UFileDeltaStore::AppendRemoveDelta(const FRemoveDelta& Delta)
 {
-	RemoveDeltas.FindOrAdd(Delta.CellKey).Add(Delta);
+	GetMutableCell(Delta.CellKey).RemoveDeltas.Add(Delta);
 	DirtyCells.Add(Delta.CellKey);
+	PendingAppendBytes += sizeof(FRemoveDelta);
 }
 
 void UFileDeltaStore::AppendAssemblyDelta(const FAssemblyDelta& Delta)
 {
-	AssemblyDeltas.FindOrAdd(Delta.CellKey).Add(Delta);
+	GetMutableCell(Delta.CellKey).AssemblyDeltas.Add(Delta);
 	DirtyCells.Add(Delta.CellKey);
+	PendingAppendBytes += sizeof(FAssemblyDelta);
 }
 
-// IDeltaStore: Get methods
+// IDeltaStore: Get methods (copying)
 TArray<FSurfaceTileDelta> UFileDeltaStore::GetSurfaceDeltas(const FWorldCellKey& CellKey) const
 {
-	if (const TArray<FSurfaceTileDelta>* Found = SurfaceDeltas.Find(CellKey))
-	{
-		return *Found;
-	}
-	return TArray<FSurfaceTileDelta>();
+	return TArray<FSurfaceTileDelta>(ViewSurfaceDeltas(CellKey));
 }
 
 TArray<FFractureDelta> UFileDeltaStore::GetFractureDeltas(const FWorldCellKey& CellKey) const
 {
-	if (const TArray<FFractureDelta>* Found = FractureDeltas.Find(CellKey))
-	{
-		return *Found;
-	}
-	return TArray<FFractureDelta>();
+	return TArray<FFractureDelta>(ViewFractureDeltas(CellKey));
 }
 
 TArray<FTransformDelta> UFileDeltaStore::GetTransformDeltas(const FWorldCellKey& CellKey) const
 {
-	if (const TArray<FTransformDelta>* Found = TransformDeltas.Find(CellKey))
-	{
-		return *Found;
-	}
-	return TArray<FTransformDelta>();
+	return TArray<FTransformDelta>(ViewTransformDeltas(CellKey));
 }
 
 TArray<FSpawnDelta> UFileDeltaStore::GetSpawnDeltas(const FWorldCellKey& CellKey) const
 {
-	if (const TArray<FSpawnDelta>* Found = SpawnDeltas.Find(CellKey))
-	{
-		return *Found;
-	}
-	return TArray<FSpawnDelta>();
+	return TArray<FSpawnDelta>(ViewSpawnDeltas(CellKey));
 }
 
 TArray<FRemoveDelta> UFileDeltaStore::GetRemoveDeltas(const FWorldCellKey& CellKey) const
 {
-	if (const TArray<FRemoveDelta>* Found = RemoveDeltas.Find(CellKey))
-	{
-		return *Found;
-	}
-	return TArray<FRemoveDelta>();
+	return TArray<FRemoveDelta>(ViewRemoveDeltas(CellKey));
 }
 
 TArray<FAssemblyDelta> UFileDeltaStore::GetAssemblyDeltas(const FWorldCellKey& CellKey) const
 {
-	if (const TArray<FAssemblyDelta>* Found = AssemblyDeltas.Find(CellKey))
-	{
-		return *Found;
-	}
-	return TArray<FAssemblyDelta>();
+	return TArray<FAssemblyDelta>(ViewAssemblyDeltas(CellKey));
+}
+
+// IDeltaStore: View methods (zero-copy)
+TConstArrayView<FSurfaceTileDelta> UFileDeltaStore::ViewSurfaceDeltas(const FWorldCellKey& CellKey) const
+{
+	EnsureCellResident(CellKey);
+	const FDeltaCellData* Cell = FindCell(CellKey);
+	return Cell ? MakeArrayView(Cell->SurfaceDeltas) : TConstArrayView<FSurfaceTileDelta>();
+}
+
+TConstArrayView<FFractureDelta> UFileDeltaStore::ViewFractureDeltas(const FWorldCellKey& CellKey) const
+{
+	EnsureCellResident(CellKey);
+	const FDeltaCellData* Cell = FindCell(CellKey);
+	return Cell ? MakeArrayView(Cell->FractureDeltas) : TConstArrayView<FFractureDelta>();
+}
+
+TConstArrayView<FTransformDelta> UFileDeltaStore::ViewTransformDeltas(const FWorldCellKey& CellKey) const
+{
+	EnsureCellResident(CellKey);
+	const FDeltaCellData* Cell = FindCell(CellKey);
+	return Cell ? MakeArrayView(Cell->TransformDeltas) : TConstArrayView<FTransformDelta>();
+}
+
+TConstArrayView<FSpawnDelta> UFileDeltaStore::ViewSpawnDeltas(const FWorldCellKey& CellKey) const
+{
+	EnsureCellResident(CellKey);
+	const FDeltaCellData* Cell = FindCell(CellKey);
+	return Cell ? MakeArrayView(Cell->SpawnDeltas) : TConstArrayView<FSpawnDelta>();
+}
+
+TConstArrayView<FRemoveDelta> UFileDeltaStore::ViewRemoveDeltas(const FWorldCellKey& CellKey) const
+{
+	EnsureCellResident(CellKey);
+	const FDeltaCellData* Cell = FindCell(CellKey);
+	return Cell ? MakeArrayView(Cell->RemoveDeltas) : TConstArrayView<FRemoveDelta>();
+}
+
+TConstArrayView<FAssemblyDelta> UFileDeltaStore::ViewAssemblyDeltas(const FWorldCellKey& CellKey) const
+{
+	EnsureCellResident(CellKey);
+	const FDeltaCellData* Cell = FindCell(CellKey);
+	return Cell ? MakeArrayView(Cell->AssemblyDeltas) : TConstArrayView<FAssemblyDelta>();
 }
 
 void UFileDeltaStore::ClearCellDeltas(const FWorldCellKey& CellKey)
 {
-	SurfaceDeltas.Remove(CellKey);
-	FractureDeltas.Remove(CellKey);
-	TransformDeltas.Remove(CellKey);
-	SpawnDeltas.Remove(CellKey);
-	RemoveDeltas.Remove(CellKey);
-	AssemblyDeltas.Remove(CellKey);
-	DirtyCells.Remove(CellKey);
+	// Fresh generation - a flush still writing the old one keeps its reference
+	Cells.Add(CellKey, MakeShared<FDeltaCellData>());
+	SurfaceFoldIndex.Remove(CellKey);
+	MarkCellBytesStale(CellKey);
+	TouchCell(CellKey);
+
+	// Drop any in-flight load and persist the empty cell on next flush
+	PendingLoads.Remove(CellKey);
+	ResidentCells.Add(CellKey);
+	DirtyCells.Add(CellKey);
+
+	IDeltaStore::OnSurfaceDeltasChanged().Broadcast(this, CellKey, INDEX_NONE, nullptr);
+}
+
+void UFileDeltaStore::DiscardDirtyCells()
+{
+	DirtyCells.Reset();
+	PendingAppendBytes = 0;
 }
 
 void UFileDeltaStore::Flush()
+{
+	FlushAsync();
+}
+
+UE::Tasks::FTask UFileDeltaStore::FlushAsync(int32 MaxCells)
 {
 	if (!bIsInitialized || DirtyCells.Num() == 0)
 	{
-		return;
+		return LastFlushTask;
 	}
 
-	// Capture data for async task (copies to avoid race conditions)
-	TArray<FWorldCellKey> CellsToFlush = DirtyCells.Array();
-	FString SaveDir = BaseSaveDirectory / CurrentWorldName;
-	
-	// Capture delta arrays for each dirty cell
-	TMap<FWorldCellKey, TArray<FSurfaceTileDelta>> SurfaceCopy;
-	TMap<FWorldCellKey, TArray<FFractureDelta>> FractureCopy;
-	TMap<FWorldCellKey, TArray<FTransformDelta>> TransformCopy;
-	TMap<FWorldCellKey, TArray<FSpawnDelta>> SpawnCopy;
-	TMap<FWorldCellKey, TArray<FRemoveDelta>> RemoveCopy;
-	TMap<FWorldCellKey, TArray<FAssemblyDelta>> AssemblyCopy;
+	SCOPE_CYCLE_COUNTER(STAT_TPF_DeltaFlush);
+	CSV_SCOPED_TIMING_STAT(TPFCore, DeltaFlush);
+
+	ProcessCompletedLoads();
 
+	// Cells written by earlier flushes are clean now and can make room
+	TrimCache();
+
+	// Take a slice of the dirty set when the caller is spreading work over frames
+	TArray<FWorldCellKey> CellsToFlush;
+	if (MaxCells > 0 && DirtyCells.Num() > MaxCells)
+	{
+		CellsToFlush.Reserve(MaxCells);
+		for (auto It = DirtyCells.CreateIterator(); It && CellsToFlush.Num() < MaxCells; ++It)
+		{
+			CellsToFlush.Add(*It);
+			It.RemoveCurrent();
+		}
+		PendingAppendBytes -= PendingAppendBytes * CellsToFlush.Num() / (CellsToFlush.Num() + DirtyCells.Num());
+	}
+	else
+	{
+		CellsToFlush = DirtyCells.Array();
+		DirtyCells.Empty();
+		PendingAppendBytes = 0;
+	}
+
+	// Dirty cells must carry their full on-disk history before being rewritten
 	for (const FWorldCellKey& CellKey : CellsToFlush)
 	{
-		if (const TArray<FSurfaceTileDelta>* Found = SurfaceDeltas.Find(CellKey)) { SurfaceCopy.Add(CellKey, *Found); }
-		if (const TArray<FFractureDelta>* Found = FractureDeltas.Find(CellKey)) { FractureCopy.Add(CellKey, *Found); }
-		if (const TArray<FTransformDelta>* Found = TransformDeltas.Find(CellKey)) { TransformCopy.Add(CellKey, *Found); }
-		if (const TArray<FSpawnDelta>* Found = SpawnDeltas.Find(CellKey)) { SpawnCopy.Add(CellKey, *Found); }
-		if (const TArray<FRemoveDelta>* Found = RemoveDeltas.Find(CellKey)) { RemoveCopy.Add(CellKey, *Found); }
-		if (const TArray<FAssemblyDelta>* Found = AssemblyDeltas.Find(CellKey)) { AssemblyCopy.Add(CellKey, *Found); }
+		EnsureCellResident(CellKey);
 	}
 
-	DirtyCells.Empty();
+	// Snapshot by reference: the worker shares each cell's current generation and
+	// the next append to that cell copies it (see GetMutableCell)
+	TMap<FWorldCellKey, TSharedPtr<const FDeltaCellData>> Snapshot;
+	Snapshot.Reserve(CellsToFlush.Num());
 
-	// Launch async task for file I/O - takes work OFF game thread
-	UE::Tasks::Launch(
-		UE_SOURCE_LOCATION,
-		[SaveDir, CellsToFlush, 
-		 SurfaceCopy = MoveTemp(SurfaceCopy),
-		 FractureCopy = MoveTemp(FractureCopy),
-		 TransformCopy = MoveTemp(TransformCopy),
-		 SpawnCopy = MoveTemp(SpawnCopy),
-		 RemoveCopy = MoveTemp(RemoveCopy),
-		 AssemblyCopy = MoveTemp(AssemblyCopy)]()
+	for (const FWorldCellKey& CellKey : CellsToFlush)
+	{
+		TSharedPtr<FDeltaCellData>& Slot = Cells.FindOrAdd(CellKey);
+		if (!Slot.IsValid())
 		{
-			IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+			Slot = MakeShared<FDeltaCellData>();
+		}
+		Snapshot.Add(CellKey, Slot);
+	}
 
-			for (const FWorldCellKey& CellKey : CellsToFlush)
-			{
-				FString CellDir = SaveDir / CellKey.ToString();
-				PlatformFile.CreateDirectoryTree(*CellDir);
+	const int32 CowClones = CopyOnWriteCount;
+	CopyOnWriteCount = 0;
 
-				// Build JSON for this cell's deltas
-				TSharedRef<FJsonObject> CellData = MakeShared<FJsonObject>();
-				CellData->SetStringField(TEXT("cell"), CellKey.ToString());
-				CellData->SetNumberField(TEXT("timestamp"), FDateTime::UtcNow().ToUnixTimestamp());
+	// Back-pressure: fold into the newest batch that has not started writing yet
+	{
+		FScopeLock Lock(&FlushQueue->Lock);
+		if (MaxQueuedFlushes > 0 && FlushQueue->QueuedFlushes >= MaxQueuedFlushes && FlushQueue->OpenBatch.IsValid())
+		{
+			// Newer generations replace older ones for cells already in the batch
+			FlushQueue->OpenBatch->Append(MoveTemp(Snapshot));
+			FlushQueue->CoalescedFlushes++;
 
-				// Surface deltas
-				if (const TArray<FSurfaceTileDelta>* Found = SurfaceCopy.Find(CellKey))
-				{
-					TArray<TSharedPtr<FJsonValue>> SurfaceArray;
-					for (const FSurfaceTileDelta& Delta : *Found)
-					{
-						TSharedPtr<FJsonObject> DeltaObj = FJsonObjectConverter::UStructToJsonObject(Delta);
-						if (DeltaObj.IsValid())
-						{
-							SurfaceArray.Add(MakeShared<FJsonValueObject>(DeltaObj));
-						}
-					}
-					CellData->SetArrayField(TEXT("surface_deltas"), SurfaceArray);
-				}
+			UE_LOG(LogTemp, Verbose, TEXT("FileDeltaStore: Coalesced flush of %d cells into queued batch (%d queued)"),
+				CellsToFlush.Num(), FlushQueue->QueuedFlushes);
+			return LastFlushTask;
+		}
+	}
 
-				// Fracture deltas  
-				if (const TArray<FFractureDelta>* Found = FractureCopy.Find(CellKey))
-				{
-					TArray<TSharedPtr<FJsonValue>> Array;
-					for (const FFractureDelta& Delta : *Found)
-					{
-						TSharedPtr<FJsonObject> DeltaObj = FJsonObjectConverter::UStructToJsonObject(Delta);
-						if (DeltaObj.IsValid()) { Array.Add(MakeShared<FJsonValueObject>(DeltaObj)); }
-					}
-					CellData->SetArrayField(TEXT("fracture_deltas"), Array);
-				}
+	TSharedPtr<FFlushBatch, ESPMode::ThreadSafe> Batch = MakeShared<FFlushBatch, ESPMode::ThreadSafe>(MoveTemp(Snapshot));
+	{
+		FScopeLock Lock(&FlushQueue->Lock);
+		FlushQueue->OpenBatch = Batch;
+		FlushQueue->QueuedFlushes++;
+	}
 
-				// Transform deltas
-				if (const TArray<FTransformDelta>* Found = TransformCopy.Find(CellKey))
+	// Pipe keeps flushes in submission order - an older snapshot can never land last
+	LastFlushTask = FlushPipe.Launch(
+		UE_SOURCE_LOCATION,
+		[Queue = FlushQueue, Summaries = SummaryTable, Batch, SaveDir = BaseSaveDirectory / CurrentWorldName, Options = GetWriteOptions(), bJsonExport = bWriteDebugJson]()
+		{
+			FFlushBatch CellsToWrite;
+			{
+				// Close the batch to coalescing before reading it
+				FScopeLock Lock(&Queue->Lock);
+				if (Queue->OpenBatch == Batch)
 				{
-					TArray<TSharedPtr<FJsonValue>> Array;
-					for (const FTransformDelta& Delta : *Found)
-					{
-						TSharedPtr<FJsonObject> DeltaObj = FJsonObjectConverter::UStructToJsonObject(Delta);
-						if (DeltaObj.IsValid()) { Array.Add(MakeShared<FJsonValueObject>(DeltaObj)); }
-					}
-					CellData->SetArrayField(TEXT("transform_deltas"), Array);
+					Queue->OpenBatch.Reset();
 				}
+				CellsToWrite = MoveTemp(*Batch);
+			}
 
-				// Spawn deltas
-				if (const TArray<FSpawnDelta>* Found = SpawnCopy.Find(CellKey))
-				{
-					TArray<TSharedPtr<FJsonValue>> Array;
-					for (const FSpawnDelta& Delta : *Found)
-					{
-						TSharedPtr<FJsonObject> DeltaObj = FJsonObjectConverter::UStructToJsonObject(Delta);
-						if (DeltaObj.IsValid()) { Array.Add(MakeShared<FJsonValueObject>(DeltaObj)); }
-					}
-					CellData->SetArrayField(TEXT("spawn_deltas"), Array);
-				}
+			const int64 TotalBytes = WriteCells(SaveDir, CellsToWrite, Options, bJsonExport, *Summaries);
+			Summaries->Save(SaveDir / DeltaSummaryFormat::FileName);
 
-				// Remove deltas
-				if (const TArray<FRemoveDelta>* Found = RemoveCopy.Find(CellKey))
-				{
-					TArray<TSharedPtr<FJsonValue>> Array;
-					for (const FRemoveDelta& Delta : *Found)
-					{
-						TSharedPtr<FJsonObject> DeltaObj = FJsonObjectConverter::UStructToJsonObject(Delta);
-						if (DeltaObj.IsValid()) { Array.Add(MakeShared<FJsonValueObject>(DeltaObj)); }
-					}
-					CellData->SetArrayField(TEXT("remove_deltas"), Array);
-				}
+			{
+				FScopeLock Lock(&Queue->Lock);
+				Queue->QueuedFlushes--;
+				Queue->BytesWritten += TotalBytes;
+			}
 
-				// Assembly deltas
-				if (const TArray<FAssemblyDelta>* Found = AssemblyCopy.Find(CellKey))
-				{
-					TArray<TSharedPtr<FJsonValue>> Array;
-					for (const FAssemblyDelta& Delta : *Found)
-					{
-						TSharedPtr<FJsonObject> DeltaObj = FJsonObjectConverter::UStructToJsonObject(Delta);
-						if (DeltaObj.IsValid()) { Array.Add(MakeShared<FJsonValueObject>(DeltaObj)); }
-					}
-					CellData->SetArrayField(TEXT("assembly_deltas"), Array);
-				}
+			UE_LOG(LogTemp, Verbose, TEXT("FileDeltaStore: Async flush complete for %d cells (%lld bytes)"), CellsToWrite.Num(), TotalBytes);
+		}
+	);
 
-				// Write JSON to file
-				FString JsonString;
-				TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&JsonString);
-				FJsonSerializer::Serialize(CellData, Writer);
+	UE_LOG(LogTemp, Verbose, TEXT("FileDeltaStore: Queued async flush for %d cells (%d copy-on-write clones since last flush)"),
+		CellsToFlush.Num(), CowClones);
+	return LastFlushTask;
+}
 
-				FString FilePath = CellDir / TEXT("deltas.json");
-				FFileHelper::SaveStringToFile(JsonString, *FilePath, FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM);
-			}
+int64 UFileDeltaStore::WriteCells(const FString& SaveDir, const FFlushBatch& CellsToWrite,
+	const DeltaCellFormat::FWriteOptions& Options, bool bJsonExport, FDeltaSummaryTable& Summaries)
+{
+	SCOPE_CYCLE_COUNTER(STAT_TPF_DeltaFlushWrite);
+
+	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+	TArray<uint8> Bytes;
+	int64 TotalBytes = 0;
+
+	for (const TPair<FWorldCellKey, TSharedPtr<const FDeltaCellData>>& Cell : CellsToWrite)
+	{
+		FString CellDir = SaveDir / Cell.Key.ToString();
+		PlatformFile.CreateDirectoryTree(*CellDir);
+
+		DeltaCellFormat::WriteBinary(Cell.Key, *Cell.Value, Bytes, Options);
+		FFileHelper::SaveArrayToFile(Bytes, *(CellDir / DeltaCellFormat::BinaryFileName));
+		TotalBytes += Bytes.Num();
+		Summaries.UpdateCell(Cell.Key, *Cell.Value);
 
-			UE_LOG(LogTemp, Verbose, TEXT("FileDeltaStore: Async flush complete for %d cells"), CellsToFlush.Num());
+		// Debug export only - never read back while a binary file exists
+		if (bJsonExport)
+		{
+			FFileHelper::SaveStringToFile(DeltaCellFormat::WriteJson(Cell.Key, *Cell.Value),
+				*(CellDir / DeltaCellFormat::JsonFileName), FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM);
 		}
-	);
+	}
+
+	return TotalBytes;
+}
+
+void UFileDeltaStore::RebuildSummaries(const FString& SaveDir, FDeltaSummaryTable& Summaries)
+{
+	TArray<FWorldCellKey> CellKeys;
+	FPlatformFileManager::Get().GetPlatformFile().IterateDirectory(*SaveDir, [&CellKeys](const TCHAR* Path, bool bIsDirectory)
+	{
+		// Only LOD 0 cells are summarized
+		FWorldCellKey CellKey;
+		if (bIsDirectory && ParseCellDirectoryName(FPaths::GetCleanFilename(Path), CellKey) && CellKey.LOD == 0)
+		{
+			CellKeys.Add(CellKey);
+		}
+		return true;
+	});
+
+	for (const FWorldCellKey& CellKey : CellKeys)
+	{
+		if (const TSharedPtr<FDeltaCellData> Data = ReadCellFile(SaveDir / CellKey.ToString()))
+		{
+			Summaries.UpdateCell(CellKey, *Data);
+		}
+	}
+
+	Summaries.Save(SaveDir / DeltaSummaryFormat::FileName);
+	UE_LOG(LogTemp, Log, TEXT("FileDeltaStore: Rebuilt %d cell summaries from %d cells in %s"), Summaries.Num(), CellKeys.Num(), *SaveDir);
+}
+
+bool UFileDeltaStore::GetCellSummary(const FWorldCellKey& CellKey, FDeltaCellSummary& OutSummary) const
+{
+	return bIsInitialized && SummaryTable->Find(CellKey, OutSummary);
+}
+
+DeltaCellFormat::FWriteOptions UFileDeltaStore::GetWriteOptions() const
+{
+	DeltaCellFormat::FWriteOptions Options;
+	Options.bCompress = bCompressCellFiles;
+	Options.CompressionFormat = CompressionFormat;
+	Options.bNameTable = bUseNameTable;
+	Options.bQuantizeSettledTransforms = bQuantizeSettledTransforms;
+	Options.bPackSurfaceDeltas = bPackSurfaceDeltas;
+	return Options;
+}
+
+void UFileDeltaStore::WaitForFlush()
+{
+	FlushPipe.WaitUntilEmpty();
+}
+
+int32 UFileDeltaStore::GetQueuedFlushCount() const
+{
+	FScopeLock Lock(&FlushQueue->Lock);
+	return FlushQueue->QueuedFlushes;
+}
+
+int32 UFileDeltaStore::GetCoalescedFlushCount() const
+{
+	FScopeLock Lock(&FlushQueue->Lock);
+	return FlushQueue->CoalescedFlushes;
+}
 
-	UE_LOG(LogTemp, Verbose, TEXT("FileDeltaStore: Queued async flush for %d cells"), CellsToFlush.Num());
+int64 UFileDeltaStore::GetCacheAllocatedBytes() const
+{
+	RefreshCellBytes();
+	return CachedBytes + Cells.GetAllocatedSize() + ResidentCells.GetAllocatedSize() + SurfaceFoldIndex.GetAllocatedSize()
+		+ CellLastUse.GetAllocatedSize() + CellBytes.GetAllocatedSize();
+}
+
+int64 UFileDeltaStore::GetCellAllocatedBytes(const FWorldCellKey& CellKey) const
+{
+	const TSharedPtr<FDeltaCellData>* Slot = Cells.Find(CellKey);
+	const FDeltaCellData* Cell = Slot ? Slot->Get() : nullptr;
+	if (!Cell)
+	{
+		return 0;
+	}
+
+	return sizeof(FDeltaCellData) + Cell->SurfaceDeltas.GetAllocatedSize() + Cell->FractureDeltas.GetAllocatedSize()
+		+ Cell->TransformDeltas.GetAllocatedSize() + Cell->SpawnDeltas.GetAllocatedSize()
+		+ Cell->RemoveDeltas.GetAllocatedSize() + Cell->AssemblyDeltas.GetAllocatedSize();
+}
+
+int64 UFileDeltaStore::GetFlushedBytes() const
+{
+	FScopeLock Lock(&FlushQueue->Lock);
+	return FlushQueue->BytesWritten;
 }
@@ -0,0 +1,515 @@
+// Copyright 2026 Threaded Pixel Factory
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "JournalDeltaStore.h"
+#include "DeltaCellFormat.h"
+#include "TPFCoreStats.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "HAL/PlatformFileManager.h"
+#include "HAL/FileManager.h"
+#include "Serialization/MemoryWriter.h"
+#include "Serialization/MemoryReader.h"
+
+namespace
+{
+	/** 'TPFJ' */
+	constexpr uint32 JournalMagic = 0x4A465054;
+	constexpr uint16 JournalVersion = 1;
+
+	/** Record type for ClearCellDeltas - outside the EDeltaType range */
+	constexpr uint8 ClearCellRecord = 0xFF;
+
+	FString GetSegmentPath(const FString& JournalDir, int32 Index)
+	{
+		return JournalDir / FString::Printf(TEXT("segment_%08d.log"), Index);
+	}
+
+	/** Present while a compaction's snapshots are staged but not yet moved into place */
+	FString GetCommitMarkerPath(const FString& JournalDir)
+	{
+		return JournalDir / TEXT("compact.commit");
+	}
+
+	/**
+	 * Second phase of compaction: move staged snapshots into place, then retire segments.
+	 * Idempotent, so an interrupted compaction can be finished on the next Initialize().
+	 */
+	void FinalizeCompaction(const FString& JournalDir, const TArray<FString>& StagedPaths, int32 FirstSegment, int32 EndSegment)
+	{
+		IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+		for (const FString& TempPath : StagedPaths)
+		{
+			const FString FinalPath = TempPath.LeftChop(4); // strip ".tmp"
+			PlatformFile.DeleteFile(*FinalPath);
+			PlatformFile.MoveFile(*FinalPath, *TempPath);
+		}
+
+		for (int32 Index = FirstSegment; Index < EndSegment; Index++)
+		{
+			PlatformFile.DeleteFile(*GetSegmentPath(JournalDir, Index));
+		}
+		PlatformFile.DeleteFile(*GetCommitMarkerPath(JournalDir));
+	}
+
+	/**
+	 * Finish a compaction interrupted after its commit marker was written.
+	 * @return Segment index the marker covered up to, or INDEX_NONE if there was nothing to recover
+	 */
+	int32 RecoverInterruptedCompaction(const FString& JournalDir, const FString& SaveDir, int32 FirstSegment)
+	{
+		FString MarkerContents;
+		if (!FFileHelper::LoadFileToString(MarkerContents, *GetCommitMarkerPath(JournalDir)))
+		{
+			return INDEX_NONE;
+		}
+
+		TArray<FString> StagedPaths;
+		IFileManager::Get().FindFilesRecursive(StagedPaths, *SaveDir, TEXT("*.bin.tmp"), true, false);
+
+		const int32 EndSegment = FCString::Atoi(*MarkerContents);
+		FinalizeCompaction(JournalDir, StagedPaths, FirstSegment, EndSegment);
+		UE_LOG(LogTemp, Warning, TEXT("JournalDeltaStore: Finished interrupted compaction (%d snapshots)"), StagedPaths.Num());
+		return EndSegment;
+	}
+
+	/** Cell accumulated during compaction */
+	struct FCompactionCell
+	{
+		FDeltaCellData Data;
+
+		/** A clear record was seen - the existing snapshot is discarded */
+		bool bReplaceSnapshot = false;
+	};
+
+	template<typename DeltaType>
+	bool ReadRecord(FArchive& Ar, const FWorldCellKey& CellKey, TArray<DeltaType>& Out)
+	{
+		DeltaType Delta;
+		DeltaCellFormat::SerializeRecord(Ar, Delta);
+		if (Ar.IsError())
+		{
+			return false;
+		}
+		Delta.CellKey = CellKey;
+		Out.Add(MoveTemp(Delta));
+		return true;
+	}
+
+	/** Decode one segment into Cells. Stops quietly at a torn tail. */
+	void ReadSegment(const FString& SegmentPath, TMap<FWorldCellKey, FCompactionCell>& Cells)
+	{
+		TArray<uint8> Bytes;
+		if (!FFileHelper::LoadFileToArray(Bytes, *SegmentPath))
+		{
+			return;
+		}
+
+		FMemoryReader Ar(Bytes);
+		uint32 Magic = 0;
+		uint16 Version = 0;
+		Ar << Magic << Version;
+		if (Ar.IsError() || Magic != JournalMagic || Version > JournalVersion)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("JournalDeltaStore: Skipping unreadable segment %s"), *SegmentPath);
+			return;
+		}
+
+		int32 RecordCount = 0;
+		while (!Ar.AtEnd())
+		{
+			uint8 RecordType = 0;
+			FWorldCellKey CellKey;
+			Ar << RecordType << CellKey.X << CellKey.Y << CellKey.LOD;
+			if (Ar.IsError())
+			{
+				break;
+			}
+
+			FCompactionCell& Cell = Cells.FindOrAdd(CellKey);
+			bool bOk = true;
+			switch (RecordType)
+			{
+			case ClearCellRecord:
+				Cell.Data = FDeltaCellData();
+				Cell.bReplaceSnapshot = true;
+				break;
+			case static_cast<uint8>(EDeltaType::SurfaceTile): bOk = ReadRecord(Ar, CellKey, Cell.Data.SurfaceDeltas); break;
+			case static_cast<uint8>(EDeltaType::Fracture):    bOk = ReadRecord(Ar, CellKey, Cell.Data.FractureDeltas); break;
+			case static_cast<uint8>(EDeltaType::Transform):   bOk = ReadRecord(Ar, CellKey, Cell.Data.TransformDeltas); break;
+			case static_cast<uint8>(EDeltaType::Spawn):       bOk = ReadRecord(Ar, CellKey, Cell.Data.SpawnDeltas); break;
+			case static_cast<uint8>(EDeltaType::Remove):      bOk = ReadRecord(Ar, CellKey, Cell.Data.RemoveDeltas); break;
+			case static_cast<uint8>(EDeltaType::Assembly):    bOk = ReadRecord(Ar, CellKey, Cell.Data.AssemblyDeltas); break;
+			default:
+				// Records are not length-prefixed; an unknown type means the rest is unreadable
+				bOk = false;
+				break;
+			}
+
+			if (!bOk)
+			{
+				UE_LOG(LogTemp, Warning, TEXT("JournalDeltaStore: Discarding torn tail of %s after %d records"), *SegmentPath, RecordCount);
+				break;
+			}
+			RecordCount++;
+		}
+	}
+}
+
+UJournalDeltaStore::UJournalDeltaStore()
+{
+}
+
+bool UJournalDeltaStore::Initialize(const FString& WorldName)
+{
+	// Finish anything queued for the previous world before touching its files
+	WaitForJournal();
+	PendingJournal.Reset();
+	JournaledCells.Reset();
+	FlushBatch = 0;
+
+	if (!Super::Initialize(WorldName))
+	{
+		return false;
+	}
+
+	TSharedPtr<FJournalWriterState, ESPMode::ThreadSafe> State = MakeShared<FJournalWriterState, ESPMode::ThreadSafe>();
+	State->SaveDir = BaseSaveDirectory / CurrentWorldName;
+	State->JournalDir = State->SaveDir / TEXT("journal");
+	State->SnapshotOptions = GetWriteOptions();
+	State->Summaries = SummaryTable;
+
+	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+	PlatformFile.CreateDirectoryTree(*State->JournalDir);
+
+	// Discover segments left by a previous session
+	int32 MinIndex = MAX_int32;
+	int32 MaxIndex = -1;
+	PlatformFile.IterateDirectory(*State->JournalDir, [&MinIndex, &MaxIndex](const TCHAR* Path, bool bIsDirectory)
+	{
+		const FString FileName = FPaths::GetBaseFilename(Path);
+		if (!bIsDirectory && FileName.StartsWith(TEXT("segment_")))
+		{
+			const int32 Index = FCString::Atoi(*FileName.RightChop(8));
+			MinIndex = FMath::Min(MinIndex, Index);
+			MaxIndex = FMath::Max(MaxIndex, Index);
+		}
+		return true;
+	});
+
+	// Never append to a recovered segment - its tail may be torn
+	State->OldestSegmentIndex = (MaxIndex >= 0) ? MinIndex : 0;
+	State->OpenSegmentIndex = MaxIndex + 1;
+	WriterState = State;
+
+	// A compaction that committed but did not finish must complete before any re-fold
+	const int32 RecoveredEnd = RecoverInterruptedCompaction(State->JournalDir, State->SaveDir, State->OldestSegmentIndex);
+	if (RecoveredEnd != INDEX_NONE)
+	{
+		State->OldestSegmentIndex = FMath::Max(State->OldestSegmentIndex, RecoveredEnd);
+		State->OpenSegmentIndex = FMath::Max(State->OpenSegmentIndex, State->OldestSegmentIndex);
+	}
+
+	if (State->GetClosedSegmentCount() > 0)
+	{
+		UE_LOG(LogTemp, Log, TEXT("JournalDeltaStore: Recovering %d journal segments for %s"), State->GetClosedSegmentCount(), *WorldName);
+		JournalPipe.Launch(UE_SOURCE_LOCATION, [State, bCoalesce = bCoalesceSurfaceDeltas]()
+		{
+			CompactSegments(*State, false, bCoalesce);
+		});
+		WaitForJournal();
+	}
+
+	return true;
+}
+
+void UJournalDeltaStore::BeginDestroy()
+{
+	// Pipe tasks own their data, but the pipe itself must drain before destruction
+	WaitForJournal();
+	Super::BeginDestroy();
+}
+
+//=============================================================================
+// APPEND
+//=============================================================================
+
+template<typename DeltaType>
+void UJournalDeltaStore::AppendJournalRecord(uint8 RecordType, const DeltaType& Delta)
+{
+	FMemoryWriter Ar(PendingJournal);
+	Ar.Seek(PendingJournal.Num());
+
+	FWorldCellKey CellKey = Delta.CellKey;
+	Ar << RecordType << CellKey.X << CellKey.Y << CellKey.LOD;
+	DeltaCellFormat::SerializeRecord(Ar, const_cast<DeltaType&>(Delta));
+	JournaledCells.Add(CellKey, FlushBatch + 1);
+}
+
+void UJournalDeltaStore::AppendSurfaceDelta(const FSurfaceTileDelta& Delta)
+{
+	EnsureCellResident(Delta.CellKey);
+	Super::AppendSurfaceDelta(Delta);
+	AppendJournalRecord(static_cast<uint8>(EDeltaType::SurfaceTile), Delta);
+}
+
+void UJournalDeltaStore::AppendFractureDelta(const FFractureDelta& Delta)
+{
+	EnsureCellResident(Delta.CellKey);
+	Super::AppendFractureDelta(Delta);
+	AppendJournalRecord(static_cast<uint8>(EDeltaType::Fracture), Delta);
+}
+
+void UJournalDeltaStore::AppendTransformDelta(const FTransformDelta& Delta)
+{
+	EnsureCellResident(Delta.CellKey);
+	Super::AppendTransformDelta(Delta);
+	AppendJournalRecord(static_cast<uint8>(EDeltaType::Transform), Delta);
+}
+
+void UJournalDeltaStore::AppendSpawnDelta(const FSpawnDelta& Delta)
+{
+	EnsureCellResident(Delta.CellKey);
+	Super::AppendSpawnDelta(Delta);
+	AppendJournalRecord(static_cast<uint8>(EDeltaType::Spawn), Delta);
+}
+
+void UJournalDeltaStore::AppendRemoveDelta(const FRemoveDelta& Delta)
+{
+	EnsureCellResident(Delta.CellKey);
+	Super::AppendRemoveDelta(Delta);
+	AppendJournalRecord(static_cast<uint8>(EDeltaType::Remove), Delta);
+}
+
+void UJournalDeltaStore::AppendAssemblyDelta(const FAssemblyDelta& Delta)
+{
+	EnsureCellResident(Delta.CellKey);
+	Super::AppendAssemblyDelta(Delta);
+	AppendJournalRecord(static_cast<uint8>(EDeltaType::Assembly), Delta);
+}
+
+void UJournalDeltaStore::ClearCellDeltas(const FWorldCellKey& CellKey)
+{
+	Super::ClearCellDeltas(CellKey);
+
+	FMemoryWriter Ar(PendingJournal);
+	Ar.Seek(PendingJournal.Num());
+	uint8 RecordType = ClearCellRecord;
+	FWorldCellKey Key = CellKey;
+	Ar << RecordType << Key.X << Key.Y << Key.LOD;
+	JournaledCells.Add(CellKey, FlushBatch + 1);
+}
+
+bool UJournalDeltaStore::CanEvictCell(const FWorldCellKey& CellKey) const
+{
+	// A lazy load reads only the snapshot, not segments awaiting compaction
+	const uint64* LastBatch = JournaledCells.Find(CellKey);
+	if (LastBatch && (!WriterState.IsValid() || *LastBatch > WriterState->CompactedBatch.load()))
+	{
+		return false;
+	}
+	return Super::CanEvictCell(CellKey);
+}
+
+//=============================================================================
+// FLUSH / COMPACTION
+//=============================================================================
+
+UE::Tasks::FTask UJournalDeltaStore::FlushAsync(int32 MaxCells)
+{
+	// Journal replaces per-cell rewrites - dirty tracking is not needed here
+	DirtyCells.Empty();
+	PendingAppendBytes = 0;
+
+	if (!bIsInitialized || !WriterState.IsValid() || PendingJournal.Num() == 0)
+	{
+		return LastFlushTask;
+	}
+
+	SCOPE_CYCLE_COUNTER(STAT_TPF_DeltaFlush);
+	CSV_SCOPED_TIMING_STAT(TPFCore, DeltaFlush);
+
+	const int32 FlushBytes = PendingJournal.Num();
+	LastFlushTask = JournalPipe.Launch(UE_SOURCE_LOCATION,
+		[State = WriterState, Bytes = MoveTemp(PendingJournal), SegmentLimit = SegmentSizeLimitBytes,
+		 Threshold = CompactionSegmentThreshold, bCoalesce = bCoalesceSurfaceDeltas, Batch = ++FlushBatch]()
+		{
+			WriteToSegment(*State, Bytes, SegmentLimit, Batch);
+			if (State->GetClosedSegmentCount() >= FMath::Max(1, Threshold))
+			{
+				CompactSegments(*State, false, bCoalesce);
+			}
+		});
+	PendingJournal.Reset();
+
+	UE_LOG(LogTemp, Verbose, TEXT("JournalDeltaStore: Queued %d journal bytes"), FlushBytes);
+	return LastFlushTask;
+}
+
+void UJournalDeltaStore::Compact()
+{
+	if (!bIsInitialized || !WriterState.IsValid())
+	{
+		return;
+	}
+
+	// Make sure the tail is on disk before it is folded
+	Flush();
+	JournalPipe.Launch(UE_SOURCE_LOCATION, [State = WriterState, bCoalesce = bCoalesceSurfaceDeltas]()
+	{
+		CompactSegments(*State, true, bCoalesce);
+	});
+}
+
+void UJournalDeltaStore::WaitForJournal()
+{
+	JournalPipe.WaitUntilEmpty();
+}
+
+void UJournalDeltaStore::WaitForFlush()
+{
+	WaitForJournal();
+	Super::WaitForFlush();
+}
+
+void UJournalDeltaStore::WriteToSegment(FJournalWriterState& State, const TArray<uint8>& Bytes, int32 SegmentLimit, uint64 Batch)
+{
+	SCOPE_CYCLE_COUNTER(STAT_TPF_DeltaFlushWrite);
+
+	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+	const FString SegmentPath = GetSegmentPath(State.JournalDir, State.OpenSegmentIndex);
+
+	TUniquePtr<IFileHandle> Handle(PlatformFile.OpenWrite(*SegmentPath, true));
+	if (!Handle)
+	{
+		UE_LOG(LogTemp, Error, TEXT("JournalDeltaStore: Failed to open segment %s"), *SegmentPath);
+		return;
+	}
+
+	if (State.OpenSegmentBytes == 0)
+	{
+		TArray<uint8> Header;
+		FMemoryWriter Ar(Header);
+		uint32 Magic = JournalMagic;
+		uint16 Version = JournalVersion;
+		Ar << Magic << Version;
+		Handle->Write(Header.GetData(), Header.Num());
+		State.OpenSegmentBytes += Header.Num();
+	}
+
+	Handle->Write(Bytes.GetData(), Bytes.Num());
+	Handle->Flush();
+	State.OpenSegmentBytes += Bytes.Num();
+	State.WrittenBatch = Batch;
+
+	if (State.OpenSegmentBytes >= SegmentLimit)
+	{
+		State.OpenSegmentIndex++;
+		State.OpenSegmentBytes = 0;
+		State.ClosedBatch = Batch;
+	}
+}
+
+void UJournalDeltaStore::CompactSegments(FJournalWriterState& State, bool bIncludeOpen, bool bCoalesceSurface)
+{
+	SCOPE_CYCLE_COUNTER(STAT_TPF_DeltaCompaction);
+
+	if (bIncludeOpen && State.OpenSegmentBytes > 0)
+	{
+		State.OpenSegmentIndex++;
+		State.OpenSegmentBytes = 0;
+		State.ClosedBatch = State.WrittenBatch;
+	}
+
+	const int32 FirstSegment = State.OldestSegmentIndex;
+	const int32 EndSegment = State.OpenSegmentIndex;
+	const uint64 EndBatch = State.ClosedBatch;
+	if (FirstSegment >= EndSegment)
+	{
+		return;
+	}
+
+	// Fold segments in order so later records stay later
+	TMap<FWorldCellKey, FCompactionCell> Cells;
+	for (int32 Index = FirstSegment; Index < EndSegment; Index++)
+	{
+		ReadSegment(GetSegmentPath(State.JournalDir, Index), Cells);
+	}
+
+	// Phase 1: stage every snapshot next to its live file
+	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+	TArray<uint8> Bytes;
+	TArray<FString> StagedPaths;
+	TArray<FDeltaCellSummary> StagedSummaries;
+	StagedSummaries.Reserve(Cells.Num());
+	for (TPair<FWorldCellKey, FCompactionCell>& Cell : Cells)
+	{
+		const FString CellDir = State.SaveDir / Cell.Key.ToString();
+
+		FDeltaCellData Snapshot;
+		if (!Cell.Value.bReplaceSnapshot)
+		{
+			if (TSharedPtr<FDeltaCellData> Existing = ReadCellFile(CellDir))
+			{
+				Snapshot = MoveTemp(*Existing);
+			}
+		}
+
+		Snapshot.SurfaceDeltas.Append(MoveTemp(Cell.Value.Data.SurfaceDeltas));
+		Snapshot.FractureDeltas.Append(MoveTemp(Cell.Value.Data.FractureDeltas));
+		Snapshot.TransformDeltas.Append(MoveTemp(Cell.Value.Data.TransformDeltas));
+		Snapshot.SpawnDeltas.Append(MoveTemp(Cell.Value.Data.SpawnDeltas));
+		Snapshot.RemoveDeltas.Append(MoveTemp(Cell.Value.Data.RemoveDeltas));
+		Snapshot.AssemblyDeltas.Append(MoveTemp(Cell.Value.Data.AssemblyDeltas));
+		if (bCoalesceSurface)
+		{
+			FSurfaceTileDelta::CoalesceInPlace(Snapshot.SurfaceDeltas);
+		}
+
+		PlatformFile.CreateDirectoryTree(*CellDir);
+		DeltaCellFormat::WriteBinary(Cell.Key, Snapshot, Bytes, State.SnapshotOptions);
+
+		const FString TempPath = CellDir / DeltaCellFormat::BinaryFileName + TEXT(".tmp");
+		if (!FFileHelper::SaveArrayToFile(Bytes, *TempPath))
+		{
+			// Leave segments in place; the next compaction retries from scratch
+			UE_LOG(LogTemp, Error, TEXT("JournalDeltaStore: Failed to stage snapshot %s"), *TempPath);
+			for (const FString& Staged : StagedPaths)
+			{
+				PlatformFile.DeleteFile(*Staged);
+			}
+			PlatformFile.DeleteFile(*TempPath);
+			return;
+		}
+		StagedPaths.Add(TempPath);
+		StagedSummaries.Add(FDeltaSummaryTable::Summarize(Cell.Key, Snapshot));
+	}
+
+	// Phase 2: commit. Past this point a crash is finished by recovery instead of re-folding
+	// the segments, which would duplicate their records in the snapshots.
+	FFileHelper::SaveStringToFile(FString::FromInt(EndSegment), *GetCommitMarkerPath(State.JournalDir));
+	FinalizeCompaction(State.JournalDir, StagedPaths, FirstSegment, EndSegment);
+	State.OldestSegmentIndex = EndSegment;
+	State.CompactedBatch = EndBatch;
+
+	if (State.Summaries.IsValid())
+	{
+		for (const FDeltaCellSummary& Summary : StagedSummaries)
+		{
+			State.Summaries->SetCell(Summary);
+		}
+		State.Summaries->Save(State.SaveDir / DeltaSummaryFormat::FileName);
+	}
+
+	UE_LOG(LogTemp, Log, TEXT("JournalDeltaStore: Compacted %d segments into %d cell snapshots"), EndSegment - FirstSegment, Cells.Num());
+}
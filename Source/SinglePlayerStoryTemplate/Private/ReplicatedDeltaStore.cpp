@@ -0,0 +1,86 @@
+// Copyright 2026 Threaded Pixel Factory
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "ReplicatedDeltaStore.h"
+#include "DeltaCellFormat.h"
+#include "Misc/Paths.h"
+
+UReplicatedDeltaStore::UReplicatedDeltaStore()
+{
+	BaseSaveDirectory = FPaths::ProjectSavedDir() / TEXT("GameSaveData") / TEXT("_Replicated");
+}
+
+bool UReplicatedDeltaStore::Initialize(const FString& WorldName)
+{
+	ReplicatedCells.Reset();
+	return Super::Initialize(WorldName);
+}
+
+UE::Tasks::FTask UReplicatedDeltaStore::FlushAsync(int32 MaxCells)
+{
+	DiscardDirtyCells();
+	return LastFlushTask;
+}
+
+bool UReplicatedDeltaStore::CanEvictCell(const FWorldCellKey& CellKey) const
+{
+	// Evicting would "reload" an empty cell from disk
+	return !ReplicatedCells.Contains(CellKey) && Super::CanEvictCell(CellKey);
+}
+
+bool UReplicatedDeltaStore::ApplyReplicatedCell(const FWorldCellKey& CellKey, bool bSnapshot, const TArray<uint8>& Payload)
+{
+	FWorldCellKey PayloadKey;
+	FDeltaCellData Data;
+	if (!DeltaCellFormat::ReadBinary(Payload, PayloadKey, Data) || PayloadKey != CellKey)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("ReplicatedDeltaStore: Dropping undecodable payload for cell %s"), *CellKey.ToString());
+		return false;
+	}
+
+	ReplicatedCells.Add(CellKey);
+
+	if (bSnapshot)
+	{
+		// Clear resets residency, fold index and surface caches; then adopt the arrays whole
+		ClearCellDeltas(CellKey);
+		GetMutableCell(CellKey) = MoveTemp(Data);
+		if (bCoalesceSurfaceDeltas)
+		{
+			FSurfaceTileDelta::CoalesceInPlace(GetMutableCell(CellKey).SurfaceDeltas);
+		}
+		IDeltaStore::OnSurfaceDeltasChanged().Broadcast(this, CellKey, INDEX_NONE, nullptr);
+	}
+	else
+	{
+		// Same path as a local append, so coalescing and surface invalidation match the server
+		for (const FSurfaceTileDelta& Delta : Data.SurfaceDeltas) { Super::AppendSurfaceDelta(Delta); }
+		for (const FFractureDelta& Delta : Data.FractureDeltas) { Super::AppendFractureDelta(Delta); }
+		for (const FTransformDelta& Delta : Data.TransformDeltas) { Super::AppendTransformDelta(Delta); }
+		for (const FSpawnDelta& Delta : Data.SpawnDeltas) { Super::AppendSpawnDelta(Delta); }
+		for (const FRemoveDelta& Delta : Data.RemoveDeltas) { Super::AppendRemoveDelta(Delta); }
+		for (const FAssemblyDelta& Delta : Data.AssemblyDeltas) { Super::AppendAssemblyDelta(Delta); }
+	}
+
+	// Server state, not local changes
+	DiscardDirtyCells();
+	return true;
+}
+
+void UReplicatedDeltaStore::DropReplicatedCell(const FWorldCellKey& CellKey)
+{
+	if (ReplicatedCells.Remove(CellKey) > 0)
+	{
+		EvictCell(CellKey);
+	}
+}
@@ -0,0 +1,74 @@
+// Copyright 2026 Threaded Pixel Factory
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "ServerDeltaStore.h"
+
+bool UServerDeltaStore::Initialize(const FString& WorldName)
+{
+	PendingBatches.Reset();
+	ResetCells.Reset();
+	return Super::Initialize(WorldName);
+}
+
+void UServerDeltaStore::AppendSurfaceDelta(const FSurfaceTileDelta& Delta)
+{
+	Super::AppendSurfaceDelta(Delta);
+	PendingBatches.FindOrAdd(Delta.CellKey).SurfaceDeltas.Add(Delta);
+}
+
+void UServerDeltaStore::AppendFractureDelta(const FFractureDelta& Delta)
+{
+	Super::AppendFractureDelta(Delta);
+	PendingBatches.FindOrAdd(Delta.CellKey).FractureDeltas.Add(Delta);
+}
+
+void UServerDeltaStore::AppendTransformDelta(const FTransformDelta& Delta)
+{
+	Super::AppendTransformDelta(Delta);
+	PendingBatches.FindOrAdd(Delta.CellKey).TransformDeltas.Add(Delta);
+}
+
+void UServerDeltaStore::AppendSpawnDelta(const FSpawnDelta& Delta)
+{
+	Super::AppendSpawnDelta(Delta);
+	PendingBatches.FindOrAdd(Delta.CellKey).SpawnDeltas.Add(Delta);
+}
+
+void UServerDeltaStore::AppendRemoveDelta(const FRemoveDelta& Delta)
+{
+	Super::AppendRemoveDelta(Delta);
+	PendingBatches.FindOrAdd(Delta.CellKey).RemoveDeltas.Add(Delta);
+}
+
+void UServerDeltaStore::AppendAssemblyDelta(const FAssemblyDelta& Delta)
+{
+	Super::AppendAssemblyDelta(Delta);
+	PendingBatches.FindOrAdd(Delta.CellKey).AssemblyDeltas.Add(Delta);
+}
+
+void UServerDeltaStore::ClearCellDeltas(const FWorldCellKey& CellKey)
+{
+	Super::ClearCellDeltas(CellKey);
+
+	// Deltas batched before the clear are gone from the cell too
+	PendingBatches.Remove(CellKey);
+	ResetCells.Add(CellKey);
+}
+
+void UServerDeltaStore::TakeReplicationBatches(TMap<FWorldCellKey, FDeltaCellData>& OutBatches, TSet<FWorldCellKey>& OutResetCells)
+{
+	OutBatches = MoveTemp(PendingBatches);
+	OutResetCells = MoveTemp(ResetCells);
+	PendingBatches.Reset();
+	ResetCells.Reset();
+}
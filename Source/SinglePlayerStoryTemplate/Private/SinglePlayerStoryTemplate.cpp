@@ -3,15 +3,78 @@
 
 #include "SinglePlayerStoryTemplate.h"
 #include "Modules/ModuleManager.h"
+#include "SpecPackLoader.h"
+#include "Subsystems/CoreDataWarmupSubsystem.h"
+#include "Space/Subsystems/InterplanetaryTravelSubsystem.h"
+#include "ModuleLoaderSubsystem.h"
 
 IMPLEMENT_MODULE(FSinglePlayerStoryTemplate, SinglePlayerStoryTemplate)
 
 void FSinglePlayerStoryTemplate::StartupModule()
 {
 	UE_LOG(LogTemp, Log, TEXT("SinglePlayerStoryTemplate module starting up"));
+
+	// Spec packs are parsed into the binary cache alongside the other startup loads
+	GatherWarmupTasksHandle = UCoreDataWarmupSubsystem::OnGatherWarmupTasks().AddStatic(&FSinglePlayerStoryTemplate::AddWarmupTasks);
+	TravelPreloadHandle = UInterplanetaryTravelSubsystem::OnTravelPreload().AddStatic(&FSinglePlayerStoryTemplate::HandleTravelPreload);
+	GatherModulePreloadsHandle = UModuleLoaderSubsystem::OnGatherModulePreloads().AddStatic(&FSinglePlayerStoryTemplate::HandleGatherModulePreloads);
+
+	// ...and registered once per game world, after its subsystems exist
+	PostWorldInitializationHandle = FWorldDelegates::OnPostWorldInitialization.AddStatic(&FSinglePlayerStoryTemplate::HandlePostWorldInitialization);
 }
 
 void FSinglePlayerStoryTemplate::ShutdownModule()
 {
+	UCoreDataWarmupSubsystem::OnGatherWarmupTasks().Remove(GatherWarmupTasksHandle);
+	UInterplanetaryTravelSubsystem::OnTravelPreload().Remove(TravelPreloadHandle);
+	UModuleLoaderSubsystem::OnGatherModulePreloads().Remove(GatherModulePreloadsHandle);
+	FWorldDelegates::OnPostWorldInitialization.Remove(PostWorldInitializationHandle);
+
 	UE_LOG(LogTemp, Log, TEXT("SinglePlayerStoryTemplate module shutting down"));
 }
+
+void FSinglePlayerStoryTemplate::HandlePostWorldInitialization(UWorld* World, const UWorld::InitializationValues IVS)
+{
+	if (!World || !World->IsGameWorld())
+	{
+		return;
+	}
+
+	// Outered to the world so RegisterBiomeSpec finds that world's BiomeSubsystem
+	USpecPackLoader* Loader = NewObject<USpecPackLoader>(World);
+	const TArray<FSpecPackLoadResult> Results = Loader->LoadSpecPacksFromDirectory(USpecPackLoader::GetDefaultSpecPackDirectory());
+	UE_LOG(LogTemp, Log, TEXT("SinglePlayerStoryTemplate: Loaded %d SpecPack(s) into %s"), Results.Num(), *World->GetName());
+}
+
+void FSinglePlayerStoryTemplate::AddWarmupTasks(UCoreDataWarmupSubsystem& Warmup)
+{
+	Warmup.AddWarmupTask(TEXT("SpecPackCache"), {}, [](FSimpleDelegate OnDone)
+	{
+		USpecPackLoader::WarmSpecPackCacheAsync(USpecPackLoader::GetDefaultSpecPackDirectory(), MoveTemp(OnDone));
+	});
+}
+
+void FSinglePlayerStoryTemplate::HandleTravelPreload(FName Map)
+{
+	// Packs are shared by every map; this picks up packs added or edited since startup
+	USpecPackLoader::WarmSpecPackCacheAsync(USpecPackLoader::GetDefaultSpecPackDirectory(), FSimpleDelegate());
+}
+
+void FSinglePlayerStoryTemplate::HandleGatherModulePreloads(const FString& ModuleName, UModuleLoaderSubsystem& Loader)
+{
+	// The world switch waits on this task; a cancelled load just ignores the stale token
+	const int32 TaskToken = Loader.BeginPreloadTask();
+	if (TaskToken == INDEX_NONE)
+	{
+		return;
+	}
+
+	TWeakObjectPtr<UModuleLoaderSubsystem> WeakLoader(&Loader);
+	USpecPackLoader::WarmSpecPackCacheAsync(USpecPackLoader::GetDefaultSpecPackDirectory(), FSimpleDelegate::CreateLambda([WeakLoader, TaskToken]()
+	{
+		if (UModuleLoaderSubsystem* PinnedLoader = WeakLoader.Get())
+		{
+			PinnedLoader->CompletePreloadTask(TaskToken);
+		}
+	}));
+}
@@ -0,0 +1,92 @@
+// Copyright 2026 Threaded Pixel Factory
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "SpecPackCookCommandlet.h"
+#include "SpecPackFormat.h"
+#include "SpecPackLoader.h"
+#include "Dom/JsonObject.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+USpecPackCookCommandlet::USpecPackCookCommandlet()
+{
+	IsClient = false;
+	IsEditor = false;
+	IsServer = false;
+	LogToConsole = true;
+}
+
+int32 USpecPackCookCommandlet::Main(const FString& Params)
+{
+	FString SourceDir = USpecPackLoader::GetDefaultSpecPackDirectory();
+	FParse::Value(*Params, TEXT("Source="), SourceDir);
+
+	FString OutputPath = USpecPackLoader::GetCookedBundlePath();
+	FParse::Value(*Params, TEXT("Output="), OutputPath);
+
+	// Nothing to cook is not a failed cook: builds then load JSON (or nothing)
+	const TArray<FString> FilePaths = USpecPackLoader::FindSpecPackFiles(SourceDir);
+	if (FilePaths.Num() == 0)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("SpecPackCook: No SpecPacks found in %s, %s not written"), *SourceDir, *OutputPath);
+		return 0;
+	}
+
+	TArray<FParsedSpecPack> Packs;
+	Packs.Reserve(FilePaths.Num());
+	int32 NumErrors = 0;
+	int32 NumSpecs = 0;
+
+	for (const FString& FilePath : FilePaths)
+	{
+		TArray<uint8> Bytes;
+		if (!FFileHelper::LoadFileToArray(Bytes, *FilePath))
+		{
+			UE_LOG(LogTemp, Error, TEXT("SpecPackCook: Cannot read %s"), *FilePath);
+			NumErrors++;
+			continue;
+		}
+
+		TSharedPtr<FJsonObject> RootObject = SpecPackFormat::ParseJsonBytes(Bytes);
+		FString ErrorMessage = TEXT("Invalid JSON syntax");
+		if (!RootObject.IsValid() || !SpecPackFormat::Validate(*RootObject, ErrorMessage))
+		{
+			UE_LOG(LogTemp, Error, TEXT("SpecPackCook: %s - %s"), *FilePath, *ErrorMessage);
+			NumErrors++;
+			continue;
+		}
+
+		FParsedSpecPack& Pack = Packs.AddDefaulted_GetRef();
+		SpecPackFormat::ReadJson(*RootObject, Pack);
+		Pack.Manifest.ContentHash = SpecPackFormat::HashBytes(Bytes);
+		NumSpecs += Pack.SurfaceSpecs.Num() + Pack.MediumSpecs.Num() + Pack.BiomeSpecs.Num();
+	}
+
+	if (NumErrors > 0)
+	{
+		UE_LOG(LogTemp, Error, TEXT("SpecPackCook: %d of %d packs failed; %s not written"), NumErrors, FilePaths.Num(), *OutputPath);
+		return 1;
+	}
+
+	TArray<uint8> Encoded;
+	SpecPackFormat::WriteBinary(Packs, Encoded);
+	if (!FFileHelper::SaveArrayToFile(Encoded, *OutputPath))
+	{
+		UE_LOG(LogTemp, Error, TEXT("SpecPackCook: Cannot write %s"), *OutputPath);
+		return 1;
+	}
+
+	UE_LOG(LogTemp, Display, TEXT("SpecPackCook: Wrote %d packs (%d specs, %d bytes) to %s"),
+		Packs.Num(), NumSpecs, Encoded.Num(), *OutputPath);
+	return 0;
+}
@@ -0,0 +1,535 @@
+// Copyright 2026 Threaded Pixel Factory
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "SpecPackFormat.h"
+#include "Misc/FileHelper.h"
+#include "Misc/SecureHash.h"
+#include "Serialization/MemoryWriter.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/ArchiveProxy.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonReader.h"
+
+namespace
+{
+	void ReadManifest(const FJsonObject& RootObject, FSpecPackManifest& OutManifest)
+	{
+		RootObject.TryGetStringField(TEXT("pack_id"), OutManifest.PackId);
+		RootObject.TryGetNumberField(TEXT("version"), OutManifest.Version);
+		RootObject.TryGetStringField(TEXT("engine_compat"), OutManifest.EngineCompat);
+
+		// Parse contained spec types
+		const TArray<TSharedPtr<FJsonValue>>* TypesArray;
+		if (RootObject.TryGetArrayField(TEXT("spec_types"), TypesArray))
+		{
+			for (const TSharedPtr<FJsonValue>& Value : *TypesArray)
+			{
+				FString TypeName;
+				if (Value->TryGetString(TypeName))
+				{
+					OutManifest.ContainedSpecTypes.Add(TypeName);
+				}
+			}
+		}
+
+		OutManifest.Timestamp = FDateTime::UtcNow();
+	}
+
+	void ReadSurfaceSpecs(const FJsonObject& RootObject, TArray<FRuntimeSurfaceSpec>& OutSpecs)
+	{
+		const TArray<TSharedPtr<FJsonValue>>* SpecArray;
+		if (!RootObject.TryGetArrayField(TEXT("surface_specs"), SpecArray))
+		{
+			return;
+		}
+
+		OutSpecs.Reserve(OutSpecs.Num() + SpecArray->Num());
+		for (const TSharedPtr<FJsonValue>& Value : *SpecArray)
+		{
+			const TSharedPtr<FJsonObject>* SpecObj;
+			if (!Value->TryGetObject(SpecObj))
+			{
+				continue;
+			}
+
+			// Parse spec ID
+			FString IdString;
+			if (!(*SpecObj)->TryGetStringField(TEXT("id"), IdString))
+			{
+				UE_LOG(LogTemp, Warning, TEXT("SpecPackLoader: SurfaceSpec missing 'id' field"));
+				continue;
+			}
+
+			FRuntimeSurfaceSpec& Spec = OutSpecs.AddDefaulted_GetRef();
+			Spec.SpecId = FName(*IdString);
+
+			// Display name
+			(*SpecObj)->TryGetStringField(TEXT("display_name"), Spec.DisplayName);
+
+			// Friction
+			(*SpecObj)->TryGetNumberField(TEXT("static_friction"), Spec.StaticFriction);
+			(*SpecObj)->TryGetNumberField(TEXT("dynamic_friction"), Spec.DynamicFriction);
+			(*SpecObj)->TryGetNumberField(TEXT("restitution"), Spec.Restitution);
+
+			// Deformation
+			(*SpecObj)->TryGetNumberField(TEXT("deformation_rate"), Spec.DeformationRatePerS);
+			(*SpecObj)->TryGetNumberField(TEXT("max_deformation_depth"), Spec.MaxDeformationDepthCm);
+			(*SpecObj)->TryGetNumberField(TEXT("recovery_rate"), Spec.RecoveryRatePerS);
+
+			// Flags
+			(*SpecObj)->TryGetBoolField(TEXT("is_deformable"), Spec.bIsDeformable);
+			(*SpecObj)->TryGetBoolField(TEXT("is_slippery"), Spec.bIsSlippery);
+		}
+	}
+
+	void ReadMediumSpecs(const FJsonObject& RootObject, TArray<FRuntimeMediumSpec>& OutSpecs)
+	{
+		const TArray<TSharedPtr<FJsonValue>>* SpecArray;
+		if (!RootObject.TryGetArrayField(TEXT("medium_specs"), SpecArray))
+		{
+			return;
+		}
+
+		OutSpecs.Reserve(OutSpecs.Num() + SpecArray->Num());
+		for (const TSharedPtr<FJsonValue>& Value : *SpecArray)
+		{
+			const TSharedPtr<FJsonObject>* SpecObj;
+			if (!Value->TryGetObject(SpecObj))
+			{
+				continue;
+			}
+
+			// Parse spec ID
+			FString IdString;
+			if (!(*SpecObj)->TryGetStringField(TEXT("id"), IdString))
+			{
+				UE_LOG(LogTemp, Warning, TEXT("SpecPackLoader: MediumSpec missing 'id' field"));
+				continue;
+			}
+
+			FRuntimeMediumSpec& Spec = OutSpecs.AddDefaulted_GetRef();
+			Spec.SpecId = FName(*IdString);
+
+			// Display name
+			(*SpecObj)->TryGetStringField(TEXT("display_name"), Spec.DisplayName);
+
+			// Physical properties
+			(*SpecObj)->TryGetNumberField(TEXT("density"), Spec.Density);
+			(*SpecObj)->TryGetNumberField(TEXT("drag_coefficient"), Spec.QuadraticDragCoeff);
+			(*SpecObj)->TryGetNumberField(TEXT("viscosity"), Spec.Viscosity);
+
+			// Audio properties
+			(*SpecObj)->TryGetNumberField(TEXT("speed_of_sound"), Spec.SpeedOfSound);
+			(*SpecObj)->TryGetNumberField(TEXT("absorption_coefficient"), Spec.AbsorptionCoefficient);
+		}
+	}
+
+	bool ReadRange(const FJsonObject& Object, const TCHAR* Field, FVector2D& OutRange)
+	{
+		const TArray<TSharedPtr<FJsonValue>>* RangeArray;
+		if (!Object.TryGetArrayField(Field, RangeArray) || RangeArray->Num() != 2)
+		{
+			return false;
+		}
+		OutRange = FVector2D((*RangeArray)[0]->AsNumber(), (*RangeArray)[1]->AsNumber());
+		return true;
+	}
+
+	void ReadBiomeSpecs(const FJsonObject& RootObject, TArray<FBiomeSpec>& OutSpecs)
+	{
+		const TArray<TSharedPtr<FJsonValue>>* SpecArray;
+		if (!RootObject.TryGetArrayField(TEXT("biome_specs"), SpecArray))
+		{
+			return;
+		}
+
+		OutSpecs.Reserve(OutSpecs.Num() + SpecArray->Num());
+		for (const TSharedPtr<FJsonValue>& Value : *SpecArray)
+		{
+			const TSharedPtr<FJsonObject>* SpecObj;
+			if (!Value->TryGetObject(SpecObj))
+			{
+				continue;
+			}
+
+			FString IdString;
+			if (!(*SpecObj)->TryGetStringField(TEXT("id"), IdString))
+			{
+				UE_LOG(LogTemp, Warning, TEXT("SpecPackLoader: BiomeSpec missing 'id' field"));
+				continue;
+			}
+
+			FBiomeSpec& Spec = OutSpecs.AddDefaulted_GetRef();
+			Spec.BiomeId = FBiomeId(FName(*IdString));
+
+			FString String;
+			if ((*SpecObj)->TryGetStringField(TEXT("display_name"), String))
+			{
+				Spec.DisplayName = FText::FromString(String);
+			}
+			if ((*SpecObj)->TryGetStringField(TEXT("default_surface"), String))
+			{
+				Spec.DefaultSurfaceSpecId.Id = FName(*String);
+			}
+			if ((*SpecObj)->TryGetStringField(TEXT("default_medium"), String))
+			{
+				Spec.DefaultMediumSpecId.Id = FName(*String);
+			}
+
+			(*SpecObj)->TryGetNumberField(TEXT("rvt_channel"), Spec.RVTChannel);
+			(*SpecObj)->TryGetNumberField(TEXT("temperature_modifier"), Spec.TemperatureModifier);
+			(*SpecObj)->TryGetNumberField(TEXT("humidity"), Spec.Humidity);
+			(*SpecObj)->TryGetNumberField(TEXT("wind_multiplier"), Spec.WindMultiplier);
+
+			// [min, max]
+			ReadRange(**SpecObj, TEXT("altitude_range"), Spec.AltitudeRange);
+			ReadRange(**SpecObj, TEXT("slope_range"), Spec.SlopeRange);
+		}
+	}
+
+	/** Writes each FName as an index into a table collected along the way */
+	class FNameTableWriter : public FArchiveProxy
+	{
+	public:
+		explicit FNameTableWriter(FArchive& InInner) : FArchiveProxy(InInner) {}
+
+		virtual FArchive& operator<<(FName& Name) override
+		{
+			int32 Index;
+			if (const int32* Found = NameToIndex.Find(Name))
+			{
+				Index = *Found;
+			}
+			else
+			{
+				Index = Names.Add(Name);
+				NameToIndex.Add(Name, Index);
+			}
+			InnerArchive << Index;
+			return *this;
+		}
+
+		TArray<FName> Names;
+
+	private:
+		TMap<FName, int32> NameToIndex;
+	};
+
+	/** Resolves FName indices written by FNameTableWriter */
+	class FNameTableReader : public FArchiveProxy
+	{
+	public:
+		FNameTableReader(FArchive& InInner, const TArray<FName>& InNames) : FArchiveProxy(InInner), Names(InNames) {}
+
+		virtual FArchive& operator<<(FName& Name) override
+		{
+			int32 Index = INDEX_NONE;
+			InnerArchive << Index;
+			if (Names.IsValidIndex(Index))
+			{
+				Name = Names[Index];
+			}
+			else
+			{
+				Name = NAME_None;
+				InnerArchive.SetError();
+			}
+			return *this;
+		}
+
+	private:
+		const TArray<FName>& Names;
+	};
+
+	template<typename SpecType>
+	bool SerializeSection(FArchive& Ar, TArray<SpecType>& Specs)
+	{
+		int32 Count = Specs.Num();
+		Ar << Count;
+
+		if (Ar.IsLoading())
+		{
+			// Every record is well over 4 bytes
+			if (Ar.IsError() || Count < 0 || Count > (Ar.TotalSize() - Ar.Tell()) / 4)
+			{
+				Ar.SetError();
+				return false;
+			}
+			Specs.SetNum(Count);
+		}
+
+		for (SpecType& Spec : Specs)
+		{
+			SpecPackFormat::SerializeRecord(Ar, Spec);
+		}
+		return !Ar.IsError();
+	}
+
+	/** Manifest and sections of one pack */
+	bool SerializePack(FArchive& Ar, FParsedSpecPack& Pack)
+	{
+		Ar << Pack.Manifest.ContentHash;
+		Ar << Pack.Manifest.PackId;
+		Ar << Pack.Manifest.Version;
+		Ar << Pack.Manifest.EngineCompat;
+		Ar << Pack.Manifest.ContainedSpecTypes;
+
+		return !Ar.IsError()
+			&& SerializeSection(Ar, Pack.SurfaceSpecs)
+			&& SerializeSection(Ar, Pack.MediumSpecs)
+			&& SerializeSection(Ar, Pack.BiomeSpecs);
+	}
+}
+
+//=============================================================================
+// RECORD SERIALIZERS
+//=============================================================================
+// Every field, in declaration order. FNames are stored as strings.
+
+void SpecPackFormat::SerializeRecord(FArchive& Ar, FRuntimeSurfaceSpec& Spec)
+{
+	Ar << Spec.SpecId;
+	Ar << Spec.Version;
+	Ar << Spec.DisplayName;
+	Ar << Spec.StaticFriction;
+	Ar << Spec.DynamicFriction;
+	Ar << Spec.Restitution;
+	Ar << Spec.WetFrictionMultiplier;
+	Ar << Spec.DeformationStrength;
+	Ar << Spec.DeformationRatePerS;
+	Ar << Spec.MaxDeformationDepthCm;
+	Ar << Spec.RecoveryRatePerS;
+	Ar << Spec.RollingResistance;
+	Ar << Spec.FootstepImpulseDamping;
+	Ar << Spec.ThermalConductivityWmK;
+	Ar << Spec.HeatCapacityJkgK;
+	Ar << Spec.Emissivity01;
+	Ar << Spec.bHasTemperatureResponse;
+	Ar << Spec.TempFrictionLUT.MinTempK;
+	Ar << Spec.TempFrictionLUT.MaxTempK;
+	Ar << Spec.TempFrictionLUT.Samples;
+	Ar << Spec.bIsDeformable;
+	Ar << Spec.bIsSlippery;
+	Ar << Spec.bAffectedByWetness;
+}
+
+void SpecPackFormat::SerializeRecord(FArchive& Ar, FRuntimeMediumSpec& Spec)
+{
+	Ar << Spec.SpecId;
+	Ar << Spec.Version;
+	Ar << Spec.DisplayName;
+	Ar << Spec.Density;
+	Ar << Spec.LinearDragCoeff;
+	Ar << Spec.QuadraticDragCoeff;
+	Ar << Spec.Viscosity;
+	Ar << Spec.PressurePa;
+	Ar << Spec.TemperatureK;
+	Ar << Spec.ThermalConductivityWmK;
+	Ar << Spec.HeatCapacityJkgK;
+	Ar << Spec.SolarIrradiance_Wm2;
+	Ar << Spec.SunDirection;
+	Ar << Spec.Gravity;
+	Ar << Spec.SpeedOfSound;
+	Ar << Spec.AbsorptionCoefficient;
+}
+
+void SpecPackFormat::SerializeRecord(FArchive& Ar, FBiomeSpec& Spec)
+{
+	// Display names are authored strings; no localization data to carry
+	FString DisplayName = Spec.DisplayName.ToString();
+
+	Ar << Spec.BiomeId.Id;
+	Ar << DisplayName;
+	Ar << Spec.DefaultSurfaceSpecId.Id;
+	Ar << Spec.DefaultMediumSpecId.Id;
+	Ar << Spec.RVTChannel;
+	Ar << Spec.TemperatureModifier;
+	Ar << Spec.Humidity;
+	Ar << Spec.WindMultiplier;
+	Ar << Spec.AltitudeRange;
+	Ar << Spec.SlopeRange;
+
+	if (Ar.IsLoading())
+	{
+		Spec.DisplayName = FText::FromString(DisplayName);
+	}
+}
+
+//=============================================================================
+// JSON
+//=============================================================================
+
+FString SpecPackFormat::HashBytes(TConstArrayView<uint8> Bytes)
+{
+	FSHAHash Hash;
+	FSHA1::HashBuffer(Bytes.GetData(), Bytes.Num(), Hash.Hash);
+	return Hash.ToString();
+}
+
+TSharedPtr<FJsonObject> SpecPackFormat::ParseJsonBytes(TConstArrayView<uint8> Bytes)
+{
+	// Handles BOMs the same way LoadFileToString does
+	FString JsonString;
+	FFileHelper::BufferToString(JsonString, Bytes.GetData(), Bytes.Num());
+
+	TSharedPtr<FJsonObject> RootObject;
+	TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(JsonString);
+	if (!FJsonSerializer::Deserialize(Reader, RootObject) || !RootObject.IsValid())
+	{
+		return nullptr;
+	}
+	return RootObject;
+}
+
+bool SpecPackFormat::Validate(const FJsonObject& RootObject, FString& OutErrorMessage)
+{
+	// Check required fields
+	if (!RootObject.HasField(TEXT("pack_id")))
+	{
+		OutErrorMessage = TEXT("Missing required field: pack_id");
+		return false;
+	}
+
+	if (!RootObject.HasField(TEXT("version")))
+	{
+		OutErrorMessage = TEXT("Missing required field: version");
+		return false;
+	}
+
+	// Validate spec arrays if present
+	const TArray<TSharedPtr<FJsonValue>>* SpecArray;
+	if (RootObject.HasField(TEXT("surface_specs")) && !RootObject.TryGetArrayField(TEXT("surface_specs"), SpecArray))
+	{
+		OutErrorMessage = TEXT("surface_specs must be an array");
+		return false;
+	}
+
+	if (RootObject.HasField(TEXT("medium_specs")) && !RootObject.TryGetArrayField(TEXT("medium_specs"), SpecArray))
+	{
+		OutErrorMessage = TEXT("medium_specs must be an array");
+		return false;
+	}
+
+	return true;
+}
+
+void SpecPackFormat::ReadJson(const FJsonObject& RootObject, FParsedSpecPack& OutPack)
+{
+	ReadManifest(RootObject, OutPack.Manifest);
+	ReadSurfaceSpecs(RootObject, OutPack.SurfaceSpecs);
+	ReadMediumSpecs(RootObject, OutPack.MediumSpecs);
+	ReadBiomeSpecs(RootObject, OutPack.BiomeSpecs);
+}
+
+//=============================================================================
+// BINARY
+//=============================================================================
+
+void SpecPackFormat::WriteBinary(TConstArrayView<FParsedSpecPack> Packs, TArray<uint8>& OutBytes, bool bNameTable)
+{
+	// The archive only reads from the packs when saving
+	auto WritePacks = [&Packs](FArchive& Ar)
+	{
+		for (const FParsedSpecPack& Pack : Packs)
+		{
+			SerializePack(Ar, const_cast<FParsedSpecPack&>(Pack));
+		}
+	};
+
+	OutBytes.Reset();
+	FMemoryWriter Ar(OutBytes);
+
+	uint32 FileMagic = Magic;
+	uint16 Version = CurrentVersion;
+	uint16 Flags = bNameTable ? FlagNameTable : 0;
+	int32 PackCount = Packs.Num();
+	Ar << FileMagic << Version << Flags << PackCount;
+
+	if (!bNameTable)
+	{
+		WritePacks(Ar);
+		return;
+	}
+
+	// Packs first so the table is complete, then table in front
+	TArray<uint8> PackBytes;
+	FMemoryWriter PackAr(PackBytes);
+	FNameTableWriter NameAr(PackAr);
+	WritePacks(NameAr);
+
+	int32 NameCount = NameAr.Names.Num();
+	Ar << NameCount;
+	for (const FName& Name : NameAr.Names)
+	{
+		FString NameString = Name.ToString();
+		Ar << NameString;
+	}
+	Ar.Serialize(PackBytes.GetData(), PackBytes.Num());
+}
+
+bool SpecPackFormat::ReadBinary(TConstArrayView<uint8> Bytes, TArray<FParsedSpecPack>& OutPacks)
+{
+	FMemoryReaderView Ar(Bytes);
+
+	uint32 FileMagic = 0;
+	uint16 Version = 0;
+	uint16 Flags = 0;
+	int32 PackCount = 0;
+	Ar << FileMagic << Version << Flags << PackCount;
+
+	// Every pack is at least a dozen bytes
+	if (Ar.IsError() || FileMagic != Magic || Version != CurrentVersion
+		|| PackCount < 0 || PackCount > (Ar.TotalSize() - Ar.Tell()) / 4)
+	{
+		return false;
+	}
+
+	TArray<FName> Names;
+	if (Flags & FlagNameTable)
+	{
+		int32 NameCount = 0;
+		Ar << NameCount;
+
+		// Every entry is at least a 4-byte length
+		if (Ar.IsError() || NameCount < 0 || NameCount > (Ar.TotalSize() - Ar.Tell()) / 4)
+		{
+			return false;
+		}
+
+		Names.Reserve(NameCount);
+		for (int32 i = 0; i < NameCount && !Ar.IsError(); i++)
+		{
+			FString NameString;
+			Ar << NameString;
+			Names.Add(FName(*NameString));
+		}
+	}
+
+	FNameTableReader NameAr(Ar, Names);
+	FArchive& PackAr = (Flags & FlagNameTable) ? static_cast<FArchive&>(NameAr) : static_cast<FArchive&>(Ar);
+
+	OutPacks.Reset(PackCount);
+	const FDateTime Now = FDateTime::UtcNow();
+	for (int32 i = 0; i < PackCount; i++)
+	{
+		FParsedSpecPack& Pack = OutPacks.AddDefaulted_GetRef();
+		if (!SerializePack(PackAr, Pack) || Ar.IsError())
+		{
+			OutPacks.Reset();
+			return false;
+		}
+		Pack.Manifest.Timestamp = Now;
+	}
+
+	return true;
+}
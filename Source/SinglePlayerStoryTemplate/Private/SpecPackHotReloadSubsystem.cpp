@@ -0,0 +1,238 @@
+// Copyright 2026 Threaded Pixel Factory
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "SpecPackHotReloadSubsystem.h"
+#include "SpecPackLoader.h"
+#include "Subsystems/SurfaceQuerySubsystem.h"
+#include "Subsystems/EnvironmentSubsystem.h"
+#include "Subsystems/BiomeSubsystem.h"
+#include "Engine/World.h"
+#include "TimerManager.h"
+#include "Misc/Paths.h"
+#include "TPFTimingRecorder.h"
+#if WITH_EDITOR
+#include "DirectoryWatcherModule.h"
+#include "IDirectoryWatcher.h"
+#endif
+
+namespace
+{
+	/** Later entries override earlier ones with the same ID; first-seen order is kept */
+	template<typename SpecType, typename IdFuncType>
+	void MergeById(TArray<SpecType>& Merged, TMap<FName, int32>& IndexById, const TArray<SpecType>& Specs, IdFuncType GetId)
+	{
+		for (const SpecType& Spec : Specs)
+		{
+			const FName Id = GetId(Spec);
+			if (const int32* Existing = IndexById.Find(Id))
+			{
+				Merged[*Existing] = Spec;
+			}
+			else
+			{
+				IndexById.Add(Id, Merged.Add(Spec));
+			}
+		}
+	}
+}
+
+bool USpecPackHotReloadSubsystem::ShouldCreateSubsystem(UObject* Outer) const
+{
+#if WITH_EDITOR
+	// Only game (PIE) worlds hold the registries being tuned
+	const UWorld* World = Cast<UWorld>(Outer);
+	return World && World->IsGameWorld() && Super::ShouldCreateSubsystem(Outer);
+#else
+	return false;
+#endif
+}
+
+void USpecPackHotReloadSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	TPF_TIMING_SCOPE(TEXT("SpecPackHotReloadSubsystem::Initialize"));
+
+	Super::Initialize(Collection);
+
+	Collection.InitializeDependency<USurfaceQuerySubsystem>();
+	Collection.InitializeDependency<UEnvironmentSubsystem>();
+	Collection.InitializeDependency<UBiomeSubsystem>();
+
+	if (WatchDirectory.IsEmpty())
+	{
+		WatchDirectory = USpecPackLoader::GetDefaultSpecPackDirectory();
+	}
+	WatchDirectory = FPaths::ConvertRelativePathToFull(WatchDirectory);
+
+	// Baseline only - whatever loaded the packs has registered them already
+	for (const FString& FilePath : USpecPackLoader::FindSpecPackFiles(WatchDirectory))
+	{
+		RereadPack(FPaths::ConvertRelativePathToFull(FilePath));
+	}
+
+#if WITH_EDITOR
+	FDirectoryWatcherModule& WatcherModule = FModuleManager::LoadModuleChecked<FDirectoryWatcherModule>(TEXT("DirectoryWatcher"));
+	if (IDirectoryWatcher* Watcher = WatcherModule.Get())
+	{
+		Watcher->RegisterDirectoryChangedCallback_Handle(WatchDirectory,
+			IDirectoryWatcher::FDirectoryChanged::CreateUObject(this, &USpecPackHotReloadSubsystem::HandleDirectoryChanged),
+			WatcherHandle);
+	}
+#endif
+
+	UE_LOG(LogTemp, Log, TEXT("SpecPackHotReload: Watching %s (%d packs)"), *WatchDirectory, Packs.Num());
+}
+
+void USpecPackHotReloadSubsystem::Deinitialize()
+{
+#if WITH_EDITOR
+	if (WatcherHandle.IsValid())
+	{
+		if (FDirectoryWatcherModule* WatcherModule = FModuleManager::GetModulePtr<FDirectoryWatcherModule>(TEXT("DirectoryWatcher")))
+		{
+			if (IDirectoryWatcher* Watcher = WatcherModule->Get())
+			{
+				Watcher->UnregisterDirectoryChangedCallback_Handle(WatchDirectory, WatcherHandle);
+			}
+		}
+		WatcherHandle.Reset();
+	}
+#endif
+
+	if (UWorld* World = GetWorld())
+	{
+		World->GetTimerManager().ClearTimer(DebounceTimer);
+	}
+	Packs.Empty();
+	PendingFiles.Empty();
+
+	Super::Deinitialize();
+}
+
+bool USpecPackHotReloadSubsystem::IsSpecPackFile(const FString& FilePath)
+{
+	// Same filter as USpecPackLoader::FindSpecPackFiles
+	return FPaths::GetExtension(FilePath) == TEXT("json") && !FilePath.Contains(TEXT("manifest"));
+}
+
+void USpecPackHotReloadSubsystem::HandleDirectoryChanged(const TArray<FFileChangeData>& Changes)
+{
+#if WITH_EDITOR
+	for (const FFileChangeData& Change : Changes)
+	{
+		const FString FilePath = FPaths::ConvertRelativePathToFull(Change.Filename);
+		if (IsSpecPackFile(FilePath))
+		{
+			PendingFiles.Add(FilePath);
+		}
+	}
+
+	UWorld* World = GetWorld();
+	if (PendingFiles.Num() > 0 && World)
+	{
+		// Restarted by every change, so a burst of saves reloads once
+		World->GetTimerManager().SetTimer(DebounceTimer, this, &USpecPackHotReloadSubsystem::ApplyPendingChanges,
+			FMath::Max(DebounceSeconds, KINDA_SMALL_NUMBER), false);
+	}
+#endif
+}
+
+bool USpecPackHotReloadSubsystem::RereadPack(const FString& FilePath)
+{
+	if (!FPaths::FileExists(FilePath))
+	{
+		return Packs.Remove(FilePath) > 0;
+	}
+
+	// A half-written or invalid file keeps the last good contents
+	FParsedSpecPack Pack;
+	FSpecPackLoadResult Result;
+	if (!USpecPackLoader::ReadSpecPackFile(FilePath, true, true, Pack, Result))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("SpecPackHotReload: %s - %s"), *FilePath, *Result.ErrorMessage);
+		return false;
+	}
+
+	Packs.Add(FilePath, MoveTemp(Pack));
+	return true;
+}
+
+void USpecPackHotReloadSubsystem::ReloadAll()
+{
+	for (const FString& FilePath : USpecPackLoader::FindSpecPackFiles(WatchDirectory))
+	{
+		PendingFiles.Add(FPaths::ConvertRelativePathToFull(FilePath));
+	}
+	for (const TPair<FString, FParsedSpecPack>& Pair : Packs)
+	{
+		PendingFiles.Add(Pair.Key);
+	}
+	ApplyPendingChanges();
+}
+
+void USpecPackHotReloadSubsystem::ApplyPendingChanges()
+{
+	int32 NumReread = 0;
+	for (const FString& FilePath : PendingFiles)
+	{
+		NumReread += RereadPack(FilePath) ? 1 : 0;
+	}
+	PendingFiles.Reset();
+
+	if (NumReread == 0)
+	{
+		return;
+	}
+
+	// Same override order as a directory load
+	TArray<FString> FilePaths;
+	Packs.GetKeys(FilePaths);
+	FilePaths.Sort();
+
+	TArray<FRuntimeSurfaceSpec> SurfaceSpecs;
+	TArray<FRuntimeMediumSpec> MediumSpecs;
+	TArray<FBiomeSpec> BiomeSpecs;
+	TMap<FName, int32> SurfaceIndex, MediumIndex, BiomeIndex;
+
+	for (const FString& FilePath : FilePaths)
+	{
+		const FParsedSpecPack& Pack = Packs[FilePath];
+		MergeById(SurfaceSpecs, SurfaceIndex, Pack.SurfaceSpecs, [](const FRuntimeSurfaceSpec& Spec) { return Spec.SpecId; });
+		MergeById(MediumSpecs, MediumIndex, Pack.MediumSpecs, [](const FRuntimeMediumSpec& Spec) { return Spec.SpecId; });
+		MergeById(BiomeSpecs, BiomeIndex, Pack.BiomeSpecs, [](const FBiomeSpec& Spec) { return Spec.BiomeId.Id; });
+	}
+
+	UWorld* World = GetWorld();
+	if (!World)
+	{
+		return;
+	}
+
+	int32 NumSurface = 0;
+	int32 NumMedium = 0;
+	int32 NumBiome = 0;
+	if (USurfaceQuerySubsystem* SurfaceQuery = World->GetSubsystem<USurfaceQuerySubsystem>())
+	{
+		NumSurface = SurfaceQuery->UpdateRuntimeSurfaceSpecs(SurfaceSpecs);
+	}
+	if (UEnvironmentSubsystem* Environment = World->GetSubsystem<UEnvironmentSubsystem>())
+	{
+		NumMedium = Environment->UpdateRuntimeMediumSpecs(MediumSpecs);
+	}
+	if (UBiomeSubsystem* Biome = World->GetSubsystem<UBiomeSubsystem>())
+	{
+		NumBiome = Biome->UpdateBiomeSpecs(BiomeSpecs);
+	}
+
+	UE_LOG(LogTemp, Log, TEXT("SpecPackHotReload: Re-read %d packs - updated %d surface, %d medium, %d biome specs"),
+		NumReread, NumSurface, NumMedium, NumBiome);
+}
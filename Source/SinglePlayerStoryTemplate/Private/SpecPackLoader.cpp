@@ -12,324 +12,412 @@
 // limitations under the License.
 
 #include "SpecPackLoader.h"
+#include "SpecPackFormat.h"
+#include "Async/Async.h"
+#include "Async/ParallelFor.h"
+#include "Tasks/Task.h"
+#include "HAL/PlatformTime.h"
+#include "Dom/JsonObject.h"
 #include "Misc/FileHelper.h"
 #include "Misc/Paths.h"
-#include "Misc/SecureHash.h"
+#include "HAL/FileManager.h"
 #include "HAL/PlatformFileManager.h"
-#include "JsonObjectConverter.h"
-#include "Serialization/JsonSerializer.h"
-#include "Serialization/JsonReader.h"
+#include "TPFCoreStats.h"
+#include "TPFTimingRecorder.h"
 #include "SpecTypes.h"
+#include "Engine/World.h"
+#include "Subsystems/BiomeSubsystem.h"
+#include "Subsystems/EnvironmentSubsystem.h"
+#include "Subsystems/SurfaceQuerySubsystem.h"
 
 USpecPackLoader::USpecPackLoader()
 {
 	DefaultSpecPackPath = FPaths::ProjectContentDir() / TEXT("SpecPacks/Core.json");
+	bPreferCookedBundle = !!UE_BUILD_SHIPPING;
 }
 
-FSpecPackLoadResult USpecPackLoader::LoadSpecPack(const FString& FilePath)
+FString USpecPackLoader::GetCacheDirectory()
 {
-	FSpecPackLoadResult Result;
+	return FPaths::ProjectSavedDir() / TEXT("SpecPackCache");
+}
 
-	// Read file
-	FString JsonString;
-	if (!FFileHelper::LoadFileToString(JsonString, *FilePath))
-	{
-		Result.ErrorMessage = FString::Printf(TEXT("Failed to read file: %s"), *FilePath);
-		UE_LOG(LogTemp, Warning, TEXT("SpecPackLoader: %s"), *Result.ErrorMessage);
-		return Result;
-	}
+bool USpecPackLoader::ReadSpecPackFile(const FString& FilePath, bool bUseCache, bool bValidate, FParsedSpecPack& OutPack, FSpecPackLoadResult& OutResult)
+{
+	TPF_TIMING_SCOPE(TEXT("SpecPack.Read ") + FPaths::GetCleanFilename(FilePath));
 
-	// Parse JSON
-	TSharedPtr<FJsonObject> RootObject;
-	TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(JsonString);
-	if (!FJsonSerializer::Deserialize(Reader, RootObject) || !RootObject.IsValid())
+	TArray<uint8> Bytes;
+	if (!FFileHelper::LoadFileToArray(Bytes, *FilePath))
 	{
-		Result.ErrorMessage = TEXT("Failed to parse JSON");
-		UE_LOG(LogTemp, Warning, TEXT("SpecPackLoader: %s"), *Result.ErrorMessage);
-		return Result;
+		OutResult.ErrorMessage = FString::Printf(TEXT("Failed to read file: %s"), *FilePath);
+		return false;
 	}
+	FTPFTimingRecorder::AddBytesRead(Bytes.Num());
 
-	// Parse manifest
-	ParseManifest(RootObject, Result.Manifest);
-	Result.Manifest.ContentHash = GetSpecPackHash(FilePath);
-
-	// Parse specs
-	Result.SurfaceSpecsLoaded = ParseSurfaceSpecs(RootObject);
-	Result.MediumSpecsLoaded = ParseMediumSpecs(RootObject);
-	Result.BiomeSpecsLoaded = ParseBiomeSpecs(RootObject);
+	const FString Hash = SpecPackFormat::HashBytes(Bytes);
+	const FString CachePath = GetCacheDirectory() / FString::Printf(TEXT("%s.%s"), *Hash, SpecPackFormat::CacheExtension);
 
-	// Cache manifest
-	CachedManifests.Add(FilePath, Result.Manifest);
-
-	Result.bSuccess = true;
-	UE_LOG(LogTemp, Log, TEXT("SpecPackLoader: Loaded %s - %d surface, %d medium, %d biome specs"),
-		*FilePath, Result.SurfaceSpecsLoaded, Result.MediumSpecsLoaded, Result.BiomeSpecsLoaded);
+	TArray<uint8> CacheBytes;
+	TArray<FParsedSpecPack> CachedPacks;
+	if (bUseCache && FFileHelper::LoadFileToArray(CacheBytes, *CachePath, FILEREAD_Silent))
+	{
+		FTPFTimingRecorder::AddBytesRead(CacheBytes.Num());
+	}
+	if (CacheBytes.Num() > 0
+		&& SpecPackFormat::ReadBinary(CacheBytes, CachedPacks)
+		&& CachedPacks.Num() == 1 && CachedPacks[0].Manifest.ContentHash == Hash)
+	{
+		OutPack = MoveTemp(CachedPacks[0]);
+		OutResult.bFromCache = true;
+		OutResult.bSuccess = true;
+		return true;
+	}
 
-	return Result;
-}
+	TSharedPtr<FJsonObject> RootObject = SpecPackFormat::ParseJsonBytes(Bytes);
+	if (!RootObject.IsValid())
+	{
+		OutResult.ErrorMessage = TEXT("Failed to parse JSON");
+		return false;
+	}
 
-TArray<FSpecPackLoadResult> USpecPackLoader::LoadSpecPacksFromDirectory(const FString& DirectoryPath)
-{
-	TArray<FSpecPackLoadResult> Results;
+	FString ValidationError;
+	const bool bValid = SpecPackFormat::Validate(*RootObject, ValidationError);
+	if (bValidate && !bValid)
+	{
+		OutResult.ErrorMessage = ValidationError;
+		return false;
+	}
 
-	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
-	
-	TArray<FString> FoundFiles;
-	PlatformFile.FindFilesRecursively(FoundFiles, *DirectoryPath, TEXT(".json"));
+	OutPack = FParsedSpecPack();
+	SpecPackFormat::ReadJson(*RootObject, OutPack);
+	OutPack.Manifest.ContentHash = Hash;
+	OutResult.bSuccess = true;
 
-	for (const FString& FilePath : FoundFiles)
+	if (bUseCache && bValid)
 	{
-		// Skip manifest files
-		if (FilePath.Contains(TEXT("manifest")))
+		TArray<uint8> Encoded;
+		SpecPackFormat::WriteBinary(MakeArrayView(&OutPack, 1), Encoded);
+
+		// Write-then-move so identical packs loading concurrently never see a partial file
+		const FString TempPath = FPaths::CreateTempFilename(*GetCacheDirectory(), *Hash, TEXT(".tmp"));
+		if (!FFileHelper::SaveArrayToFile(Encoded, *TempPath) || !IFileManager::Get().Move(*CachePath, *TempPath, true, true))
 		{
-			continue;
+			IFileManager::Get().Delete(*TempPath, false, false, true);
+			UE_LOG(LogTemp, Verbose, TEXT("SpecPackLoader: Could not write pack cache %s"), *CachePath);
 		}
-
-		Results.Add(LoadSpecPack(FilePath));
 	}
 
-	return Results;
+	return true;
 }
 
-FSpecPackLoadResult USpecPackLoader::LoadDefaultSpecPack()
+FSpecPackLoadResult USpecPackLoader::LoadSpecPack(const FString& FilePath)
 {
-	return LoadSpecPack(DefaultSpecPackPath);
+	return LoadSpecPacks({ FilePath })[0];
 }
 
-bool USpecPackLoader::ValidateSpecPack(const FString& FilePath, FString& OutErrorMessage)
+TArray<FSpecPackLoadResult> USpecPackLoader::LoadSpecPacks(const TArray<FString>& FilePaths)
 {
-	FString JsonString;
-	if (!FFileHelper::LoadFileToString(JsonString, *FilePath))
-	{
-		OutErrorMessage = FString::Printf(TEXT("Cannot read file: %s"), *FilePath);
-		return false;
-	}
+	SCOPE_CYCLE_COUNTER(STAT_TPF_SpecPackLoad);
+	TPF_TIMING_SCOPE(TEXT("SpecPackLoader::LoadSpecPacks"));
 
-	TSharedPtr<FJsonObject> RootObject;
-	TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(JsonString);
-	if (!FJsonSerializer::Deserialize(Reader, RootObject) || !RootObject.IsValid())
-	{
-		OutErrorMessage = TEXT("Invalid JSON syntax");
-		return false;
-	}
+	TArray<FSpecPackLoadResult> Results;
+	TArray<FParsedSpecPack> Packs;
+	Results.SetNum(FilePaths.Num());
+	Packs.SetNum(FilePaths.Num());
 
-	// Check required fields
-	if (!RootObject->HasField(TEXT("pack_id")))
+	if (bUseBinaryCache)
 	{
-		OutErrorMessage = TEXT("Missing required field: pack_id");
-		return false;
+		IFileManager::Get().MakeDirectory(*GetCacheDirectory(), true);
 	}
 
-	if (!RootObject->HasField(TEXT("version")))
+	// Pack sizes vary widely (mods), so let workers steal
+	const bool bUseCache = bUseBinaryCache;
+	const bool bValidate = bValidateOnLoad;
+	ParallelFor(FilePaths.Num(), [&](int32 Index)
 	{
-		OutErrorMessage = TEXT("Missing required field: version");
-		return false;
-	}
+		ReadSpecPackFile(FilePaths[Index], bUseCache, bValidate, Packs[Index], Results[Index]);
+	}, EParallelForFlags::Unbalanced);
 
-	// Validate spec arrays if present
-	if (RootObject->HasField(TEXT("surface_specs")))
+	// Registration stays serial and in path order: later packs override earlier ones
+	int32 NumFromCache = 0;
+	for (int32 Index = 0; Index < FilePaths.Num(); Index++)
 	{
-		const TArray<TSharedPtr<FJsonValue>>* SpecArray;
-		if (!RootObject->TryGetArrayField(TEXT("surface_specs"), SpecArray))
+		FSpecPackLoadResult& Result = Results[Index];
+		if (!Result.bSuccess)
 		{
-			OutErrorMessage = TEXT("surface_specs must be an array");
-			return false;
+			UE_LOG(LogTemp, Warning, TEXT("SpecPackLoader: %s (%s)"), *Result.ErrorMessage, *FilePaths[Index]);
+			continue;
 		}
+
+		RegisterParsedPack(Packs[Index], Result);
+		CachedManifests.Add(FilePaths[Index], Result.Manifest);
+		NumFromCache += Result.bFromCache ? 1 : 0;
+
+		UE_LOG(LogTemp, Log, TEXT("SpecPackLoader: Loaded %s%s - %d surface, %d medium, %d biome specs"),
+			*FilePaths[Index], Result.bFromCache ? TEXT(" (cached)") : TEXT(""),
+			Result.SurfaceSpecsLoaded, Result.MediumSpecsLoaded, Result.BiomeSpecsLoaded);
 	}
 
-	if (RootObject->HasField(TEXT("medium_specs")))
+	if (FilePaths.Num() > 1)
 	{
-		const TArray<TSharedPtr<FJsonValue>>* SpecArray;
-		if (!RootObject->TryGetArrayField(TEXT("medium_specs"), SpecArray))
-		{
-			OutErrorMessage = TEXT("medium_specs must be an array");
-			return false;
-		}
+		UE_LOG(LogTemp, Log, TEXT("SpecPackLoader: Loaded %d packs (%d from cache)"), FilePaths.Num(), NumFromCache);
 	}
 
-	return true;
+	return Results;
 }
 
-FString USpecPackLoader::GetSpecPackHash(const FString& FilePath) const
+TArray<FSpecPackLoadResult> USpecPackLoader::LoadSpecPacksFromDirectory(const FString& DirectoryPath)
 {
-	FString JsonString;
-	if (!FFileHelper::LoadFileToString(JsonString, *FilePath))
+	bool bUseBundle = false;
+	const TArray<FString> FilePaths = FindPacksToParse(DirectoryPath, bPreferCookedBundle, bUseBundle);
+	if (!bUseBundle)
 	{
-		return FString();
+		return LoadSpecPacks(FilePaths);
+	}
+
+	// Newer JSON registers after the bundle, so it overrides the cooked specs
+	TArray<FSpecPackLoadResult> Results = LoadCookedSpecPacks(GetCookedBundlePath());
+	if (FilePaths.Num() > 0)
+	{
+		UE_LOG(LogTemp, Log, TEXT("SpecPackLoader: %d packs are newer than the cooked bundle, loading them over it"), FilePaths.Num());
+		Results.Append(LoadSpecPacks(FilePaths));
 	}
+	return Results;
+}
+
+TArray<FString> USpecPackLoader::FindPacksToParse(const FString& DirectoryPath, bool bPreferBundle, bool& bOutUseBundle)
+{
+	TArray<FString> FilePaths = FindSpecPackFiles(DirectoryPath);
 
-	// SHA256 hash of file content
-	FSHAHash Hash;
-	FSHA1::HashBuffer(TCHAR_TO_UTF8(*JsonString), JsonString.Len(), Hash.Hash);
-	return Hash.ToString();
+	const FString BundlePath = GetCookedBundlePath();
+	bOutUseBundle = bPreferBundle && FPaths::FileExists(BundlePath);
+	if (bOutUseBundle)
+	{
+		// Every pack at or before the cook went into the bundle
+		IFileManager& FileManager = IFileManager::Get();
+		const FDateTime BundleTime = FileManager.GetTimeStamp(*BundlePath);
+		FilePaths.RemoveAll([&FileManager, &BundleTime](const FString& FilePath)
+		{
+			return FileManager.GetTimeStamp(*FilePath) <= BundleTime;
+		});
+	}
+	return FilePaths;
 }
 
-bool USpecPackLoader::GetManifest(const FString& FilePath, FSpecPackManifest& OutManifest) const
+FString USpecPackLoader::GetDefaultSpecPackDirectory()
 {
-	if (const FSpecPackManifest* Found = CachedManifests.Find(FilePath))
+	const FString ContentDir = FPaths::ProjectContentDir() / TEXT("SpecPacks");
+	const FString SourceDir = FPaths::ProjectDir() / TEXT("Source/UETPFCore/Resources/SpecPacks");
+	if (FPaths::DirectoryExists(SourceDir) && FindSpecPackFiles(ContentDir).Num() == 0)
 	{
-		OutManifest = *Found;
-		return true;
+		return SourceDir;
 	}
-	return false;
+	return ContentDir;
 }
 
-int32 USpecPackLoader::ParseSurfaceSpecs(const TSharedPtr<FJsonObject>& RootObject)
+FString USpecPackLoader::GetCookedBundlePath()
 {
-	int32 Count = 0;
+	return FPaths::ProjectContentDir() / TEXT("SpecPacks") / SpecPackFormat::CookedFileName;
+}
 
-	const TArray<TSharedPtr<FJsonValue>>* SpecArray;
-	if (!RootObject->TryGetArrayField(TEXT("surface_specs"), SpecArray))
+void USpecPackLoader::WarmSpecPackCacheAsync(const FString& DirectoryPath, FSimpleDelegate OnDone)
+{
+	const USpecPackLoader* Defaults = GetDefault<USpecPackLoader>();
+	if (!Defaults->bUseBinaryCache)
 	{
-		return 0;
+		OnDone.ExecuteIfBound();
+		return;
 	}
 
-	for (const TSharedPtr<FJsonValue>& Value : *SpecArray)
+	const bool bValidate = Defaults->bValidateOnLoad;
+	const bool bPreferBundle = Defaults->bPreferCookedBundle;
+	UE::Tasks::Launch(UE_SOURCE_LOCATION, [DirectoryPath, bValidate, bPreferBundle, OnDone = MoveTemp(OnDone)]() mutable
 	{
-		const TSharedPtr<FJsonObject>* SpecObj;
-		if (!Value->TryGetObject(SpecObj))
+		const double StartTime = FPlatformTime::Seconds();
+		IFileManager::Get().MakeDirectory(*GetCacheDirectory(), true);
+
+		// The cooked bundle is one read with no parsing; only packs newer than it need warming
+		bool bUseBundle = false;
+		const TArray<FString> FilePaths = FindPacksToParse(DirectoryPath, bPreferBundle, bUseBundle);
+		std::atomic<int32> NumFromCache = 0;
+		ParallelFor(FilePaths.Num(), [&](int32 Index)
 		{
-			continue;
-		}
+			FParsedSpecPack Pack;
+			FSpecPackLoadResult Result;
+			ReadSpecPackFile(FilePaths[Index], true, bValidate, Pack, Result);
+			NumFromCache += Result.bFromCache ? 1 : 0;
+		}, EParallelForFlags::Unbalanced);
 
-		// Parse spec ID
-		FString IdString;
-		if (!(*SpecObj)->TryGetStringField(TEXT("id"), IdString))
-		{
-			UE_LOG(LogTemp, Warning, TEXT("SpecPackLoader: SurfaceSpec missing 'id' field"));
-			continue;
-		}
+		UE_LOG(LogTemp, Log, TEXT("SpecPackLoader: Warmed cache for %d packs (%d already cached, %.2f ms)"),
+			FilePaths.Num(), NumFromCache.load(), (FPlatformTime::Seconds() - StartTime) * 1000.0);
 
-		FSurfaceSpecId SpecId;
-		SpecId.Id = FName(*IdString);
-
-		// Parse spec data
-		FRuntimeSurfaceSpec Spec;
-		
-		// Display name
-		FString DisplayName;
-		if ((*SpecObj)->TryGetStringField(TEXT("display_name"), DisplayName))
+		AsyncTask(ENamedThreads::GameThread, [OnDone = MoveTemp(OnDone)]()
 		{
-			Spec.DisplayName = DisplayName;
-		}
+			OnDone.ExecuteIfBound();
+		});
+	});
+}
 
-		// Friction
-		(*SpecObj)->TryGetNumberField(TEXT("static_friction"), Spec.StaticFriction);
-		(*SpecObj)->TryGetNumberField(TEXT("dynamic_friction"), Spec.DynamicFriction);
-		(*SpecObj)->TryGetNumberField(TEXT("restitution"), Spec.Restitution);
+TArray<FSpecPackLoadResult> USpecPackLoader::LoadCookedSpecPacks(const FString& BundlePath)
+{
+	SCOPE_CYCLE_COUNTER(STAT_TPF_SpecPackLoad);
+	TPF_TIMING_SCOPE(TEXT("SpecPackLoader::LoadCookedSpecPacks"));
 
-		// Deformation
-		(*SpecObj)->TryGetNumberField(TEXT("deformation_rate"), Spec.DeformationRatePerS);
-		(*SpecObj)->TryGetNumberField(TEXT("max_deformation_depth"), Spec.MaxDeformationDepthCm);
-		(*SpecObj)->TryGetNumberField(TEXT("recovery_rate"), Spec.RecoveryRatePerS);
+	TArray<FSpecPackLoadResult> Results;
 
-		// Flags
-		(*SpecObj)->TryGetBoolField(TEXT("is_deformable"), Spec.bIsDeformable);
-		(*SpecObj)->TryGetBoolField(TEXT("is_slippery"), Spec.bIsSlippery);
+	TArray<uint8> Bytes;
+	TArray<FParsedSpecPack> Packs;
+	const bool bRead = FFileHelper::LoadFileToArray(Bytes, *BundlePath);
+	FTPFTimingRecorder::AddBytesRead(Bytes.Num());
+	if (!bRead || !SpecPackFormat::ReadBinary(Bytes, Packs))
+	{
+		FSpecPackLoadResult& Result = Results.AddDefaulted_GetRef();
+		Result.ErrorMessage = FString::Printf(TEXT("Failed to read cooked SpecPacks: %s"), *BundlePath);
+		UE_LOG(LogTemp, Warning, TEXT("SpecPackLoader: %s"), *Result.ErrorMessage);
+		return Results;
+	}
 
-		RegisterSurfaceSpec(SpecId, Spec);
-		Count++;
+	// Validated at cook time and already in override order
+	Results.Reserve(Packs.Num());
+	for (const FParsedSpecPack& Pack : Packs)
+	{
+		FSpecPackLoadResult& Result = Results.AddDefaulted_GetRef();
+		RegisterParsedPack(Pack, Result);
+		Result.bFromCache = true;
+		Result.bSuccess = true;
+		CachedManifests.Add(Pack.Manifest.PackId, Result.Manifest);
 	}
 
-	return Count;
+	UE_LOG(LogTemp, Log, TEXT("SpecPackLoader: Loaded %d cooked packs from %s"), Packs.Num(), *BundlePath);
+	return Results;
 }
 
-int32 USpecPackLoader::ParseMediumSpecs(const TSharedPtr<FJsonObject>& RootObject)
+TArray<FString> USpecPackLoader::FindSpecPackFiles(const FString& DirectoryPath)
 {
-	int32 Count = 0;
+	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+	
+	TArray<FString> FoundFiles;
+	PlatformFile.FindFilesRecursively(FoundFiles, *DirectoryPath, TEXT(".json"));
 
-	const TArray<TSharedPtr<FJsonValue>>* SpecArray;
-	if (!RootObject->TryGetArrayField(TEXT("medium_specs"), SpecArray))
-	{
-		return 0;
-	}
+	// Skip manifest files
+	FoundFiles.RemoveAll([](const FString& FilePath) { return FilePath.Contains(TEXT("manifest")); });
 
-	for (const TSharedPtr<FJsonValue>& Value : *SpecArray)
-	{
-		const TSharedPtr<FJsonObject>* SpecObj;
-		if (!Value->TryGetObject(SpecObj))
-		{
-			continue;
-		}
+	// Directory iteration order is platform-dependent; override order must not be
+	FoundFiles.Sort();
+	return FoundFiles;
+}
 
-		// Parse spec ID
-		FString IdString;
-		if (!(*SpecObj)->TryGetStringField(TEXT("id"), IdString))
-		{
-			UE_LOG(LogTemp, Warning, TEXT("SpecPackLoader: MediumSpec missing 'id' field"));
-			continue;
-		}
+FSpecPackLoadResult USpecPackLoader::LoadDefaultSpecPack()
+{
+	return LoadSpecPack(DefaultSpecPackPath);
+}
 
-		FMediumSpecId SpecId;
-		SpecId.Id = FName(*IdString);
-
-		// Parse spec data
-		FRuntimeMediumSpec  Spec;
-		
-		// Display name
-		FString DisplayName;
-		if ((*SpecObj)->TryGetStringField(TEXT("display_name"), DisplayName))
-		{
-			Spec.DisplayName = DisplayName;
-		}
+bool USpecPackLoader::ValidateSpecPack(const FString& FilePath, FString& OutErrorMessage)
+{
+	TArray<uint8> Bytes;
+	if (!FFileHelper::LoadFileToArray(Bytes, *FilePath))
+	{
+		OutErrorMessage = FString::Printf(TEXT("Cannot read file: %s"), *FilePath);
+		return false;
+	}
 
-		// Physical properties
-		(*SpecObj)->TryGetNumberField(TEXT("density"), Spec.Density);
-		(*SpecObj)->TryGetNumberField(TEXT("drag_coefficient"), Spec.QuadraticDragCoeff);
-		(*SpecObj)->TryGetNumberField(TEXT("viscosity"), Spec.Viscosity);
+	TSharedPtr<FJsonObject> RootObject = SpecPackFormat::ParseJsonBytes(Bytes);
+	if (!RootObject.IsValid())
+	{
+		OutErrorMessage = TEXT("Invalid JSON syntax");
+		return false;
+	}
 
-		// Audio properties
-		(*SpecObj)->TryGetNumberField(TEXT("speed_of_sound"), Spec.SpeedOfSound);
-		(*SpecObj)->TryGetNumberField(TEXT("absorption_coefficient"), Spec.AbsorptionCoefficient);
+	return SpecPackFormat::Validate(*RootObject, OutErrorMessage);
+}
 
-		RegisterMediumSpec(SpecId, Spec);
-		Count++;
+FString USpecPackLoader::GetSpecPackHash(const FString& FilePath) const
+{
+	TArray<uint8> Bytes;
+	if (!FFileHelper::LoadFileToArray(Bytes, *FilePath))
+	{
+		return FString();
 	}
 
-	return Count;
+	// SHA1 of the file bytes - the same ContentHash a load reports
+	return SpecPackFormat::HashBytes(Bytes);
 }
 
-int32 USpecPackLoader::ParseBiomeSpecs(const TSharedPtr<FJsonObject>& RootObject)
+bool USpecPackLoader::GetManifest(const FString& FilePath, FSpecPackManifest& OutManifest) const
 {
-	// TODO: Implement biome spec parsing
-	// This would register with BiomeSubsystem
-	return 0;
+	if (const FSpecPackManifest* Found = CachedManifests.Find(FilePath))
+	{
+		OutManifest = *Found;
+		return true;
+	}
+	return false;
 }
 
-bool USpecPackLoader::ParseManifest(const TSharedPtr<FJsonObject>& RootObject, FSpecPackManifest& OutManifest)
+void USpecPackLoader::RegisterParsedPack(const FParsedSpecPack& Pack, FSpecPackLoadResult& OutResult)
 {
-	RootObject->TryGetStringField(TEXT("pack_id"), OutManifest.PackId);
-	RootObject->TryGetNumberField(TEXT("version"), OutManifest.Version);
-	RootObject->TryGetStringField(TEXT("engine_compat"), OutManifest.EngineCompat);
+	OutResult.Manifest = Pack.Manifest;
 
-	// Parse contained spec types
-	const TArray<TSharedPtr<FJsonValue>>* TypesArray;
-	if (RootObject->TryGetArrayField(TEXT("spec_types"), TypesArray))
+	for (const FRuntimeSurfaceSpec& Spec : Pack.SurfaceSpecs)
 	{
-		for (const TSharedPtr<FJsonValue>& Value : *TypesArray)
-		{
-			FString TypeName;
-			if (Value->TryGetString(TypeName))
-			{
-				OutManifest.ContainedSpecTypes.Add(TypeName);
-			}
-		}
+		FSurfaceSpecId SpecId;
+		SpecId.Id = Spec.SpecId;
+		RegisterSurfaceSpec(SpecId, Spec);
 	}
 
-	OutManifest.Timestamp = FDateTime::UtcNow();
-	return true;
+	for (const FRuntimeMediumSpec& Spec : Pack.MediumSpecs)
+	{
+		FMediumSpecId SpecId;
+		SpecId.Id = Spec.SpecId;
+		RegisterMediumSpec(SpecId, Spec);
+	}
+
+	for (const FBiomeSpec& Spec : Pack.BiomeSpecs)
+	{
+		RegisterBiomeSpec(Spec);
+	}
+
+	OutResult.SurfaceSpecsLoaded = Pack.SurfaceSpecs.Num();
+	OutResult.MediumSpecsLoaded = Pack.MediumSpecs.Num();
+	OutResult.BiomeSpecsLoaded = Pack.BiomeSpecs.Num();
 }
 
 void USpecPackLoader::RegisterSurfaceSpec(const FSurfaceSpecId& Id, const FRuntimeSurfaceSpec& Spec)
 {
-	// TODO: Register with SurfaceQuerySubsystem or a global spec registry
-	// For now, just log that we parsed it
+	const UWorld* World = GetWorld();
+	USurfaceQuerySubsystem* SurfaceQuery = World ? World->GetSubsystem<USurfaceQuerySubsystem>() : nullptr;
+	if (!SurfaceQuery)
+	{
+		UE_LOG(LogTemp, Verbose, TEXT("SpecPackLoader: No world SurfaceQuerySubsystem, SurfaceSpec '%s' not registered"), *Id.Id.ToString());
+		return;
+	}
+
+	SurfaceQuery->RegisterRuntimeSurfaceSpec(Id, Spec);
 	UE_LOG(LogTemp, Verbose, TEXT("SpecPackLoader: Registered SurfaceSpec '%s'"), *Id.Id.ToString());
 }
 
 void USpecPackLoader::RegisterMediumSpec(const FMediumSpecId& Id, const FRuntimeMediumSpec & Spec)
 {
-	// TODO: Register with EnvironmentSubsystem or a global spec registry
-	// For now, just log that we parsed it
+	const UWorld* World = GetWorld();
+	UEnvironmentSubsystem* Environment = World ? World->GetSubsystem<UEnvironmentSubsystem>() : nullptr;
+	if (!Environment)
+	{
+		UE_LOG(LogTemp, Verbose, TEXT("SpecPackLoader: No world EnvironmentSubsystem, MediumSpec '%s' not registered"), *Id.Id.ToString());
+		return;
+	}
+
+	Environment->RegisterRuntimeMediumSpec(Id, Spec);
 	UE_LOG(LogTemp, Verbose, TEXT("SpecPackLoader: Registered MediumSpec '%s'"), *Id.Id.ToString());
 }
+
+void USpecPackLoader::RegisterBiomeSpec(const FBiomeSpec& Spec)
+{
+	const UWorld* World = GetWorld();
+	UBiomeSubsystem* Biome = World ? World->GetSubsystem<UBiomeSubsystem>() : nullptr;
+	if (!Biome)
+	{
+		UE_LOG(LogTemp, Verbose, TEXT("SpecPackLoader: No world BiomeSubsystem, BiomeSpec '%s' not registered"), *Spec.BiomeId.Id.ToString());
+		return;
+	}
+
+	Biome->RegisterBiomeSpec(Spec);
+	UE_LOG(LogTemp, Verbose, TEXT("SpecPackLoader: Registered BiomeSpec '%s'"), *Spec.BiomeId.Id.ToString());
+}
@@ -0,0 +1,176 @@
+// Copyright 2026 Threaded Pixel Factory
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * Delta Cell Format - On-disk encoding for per-cell delta data
+ *
+ * Purpose:
+ * Compact, versioned binary encoding of the six delta arrays for one world cell.
+ * Replaces per-delta FJsonObject conversion on the save path; JSON remains
+ * available as a human-readable debug export and as a legacy load path.
+ *
+ * Binary Layout (little endian, via FMemoryWriter/FMemoryReader):
+ *   Header:
+ *     uint32  Magic        'TPFD'
+ *     uint16  Version      DeltaCellFormat::CurrentVersion
+ *     uint16  Flags        DeltaCellFormat::Flag* bits (always 0 in version 1)
+ *     int32   X, Y, LOD    Cell key - stored once, not per delta
+ *   Compressed wrapper (FlagCompressed only):
+ *     uint8   Codec        ECellCodec
+ *     int32   RawBytes     Size of the body once decompressed
+ *     int32   PackedBytes
+ *     ...     PackedBytes of compressed body
+ *   Body:
+ *     Name table (FlagNameTable only):
+ *       int32   NameCount
+ *       FString Names[NameCount]  Every FName in the body is an int32 index
+ *     uint8   SectionCount
+ *     Sections (one per non-empty delta type):
+ *       uint8   EDeltaType
+ *       int32   Count
+ *       int32   PayloadBytes Allows readers to skip unknown section types
+ *       ...     Count records
+ *
+ * With no flags set, versions 2 and 3 are byte-identical to version 1.
+ *
+ * Size:
+ * - FNames (AuthorPlayerId, RemovalReason, AssemblySpecId, StateVariables keys)
+ *   repeat heavily within a cell; the name table stores each string once
+ * - Compression then collapses repeated GUIDs and near-identical transforms
+ * - FlagQuantizedTransforms stores sleeping (settled) transform deltas as float
+ *   location/scale plus a 16-bit-per-component quaternion - 32 bytes instead of 80
+ * - FlagPackedSurface (version 3+) stores the surface section as one
+ *   FPackedSurfaceDeltaList: 24-byte POD records written as a single block, with
+ *   cell-relative quantized X/Y and millisecond offsets from a per-cell epoch.
+ *   Cells whose deltas fall outside the packed ranges are written unpacked
+ *
+ * Compatibility:
+ * - Readers reject files with a newer Version than they understand
+ * - Unknown section types are skipped using PayloadBytes
+ * - Per-record fields added in later versions must be gated on the file version
+ * - Journal segments use SerializeRecord() with no flags and are unaffected
+ *
+ * @see UFileDeltaStore for the store using this format
+ */
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "DeltaTypes.h"
+
+/**
+ * All deltas for one cell.
+ * Used as the unit of (de)serialization and for handing cell data between threads.
+ */
+struct FDeltaCellData
+{
+	TArray<FSurfaceTileDelta> SurfaceDeltas;
+	TArray<FFractureDelta> FractureDeltas;
+	TArray<FTransformDelta> TransformDeltas;
+	TArray<FSpawnDelta> SpawnDeltas;
+	TArray<FRemoveDelta> RemoveDeltas;
+	TArray<FAssemblyDelta> AssemblyDeltas;
+
+	bool IsEmpty() const
+	{
+		return SurfaceDeltas.Num() == 0 && FractureDeltas.Num() == 0 && TransformDeltas.Num() == 0
+			&& SpawnDeltas.Num() == 0 && RemoveDeltas.Num() == 0 && AssemblyDeltas.Num() == 0;
+	}
+};
+
+namespace DeltaCellFormat
+{
+	/** 'TPFD' */
+	constexpr uint32 Magic = 0x44465054;
+
+	/** Bump when the record layout changes */
+	constexpr uint16 CurrentVersion = 3;
+
+	/** Header flags (version 2+) */
+	constexpr uint16 FlagCompressed = 1 << 0;
+	constexpr uint16 FlagNameTable = 1 << 1;
+	constexpr uint16 FlagQuantizedTransforms = 1 << 2;
+	constexpr uint16 FlagPackedSurface = 1 << 3;
+
+	/** Largest decompressed body ReadBinary allocates; corrupt headers past it are rejected */
+	constexpr int32 MaxBodyBytes = 64 * 1024 * 1024;
+
+	/** Largest RawBytes / PackedBytes ReadBinary believes (well above what LZ4, Oodle or Zlib reach on cell data) */
+	constexpr int64 MaxCompressionRatio = 4096;
+
+	/** Codec ids stored in the compressed wrapper */
+	enum class ECellCodec : uint8
+	{
+		LZ4 = 1,
+		Oodle = 2,
+		Zlib = 3
+	};
+
+	/** Encoder choices; decoding is driven entirely by the header flags */
+	struct FWriteOptions
+	{
+		/** Compress the body (skipped for bodies too small to benefit) */
+		bool bCompress = false;
+
+		/** NAME_LZ4, NAME_Oodle or NAME_Zlib */
+		FName CompressionFormat = NAME_LZ4;
+
+		/** Store each FName once per cell */
+		bool bNameTable = true;
+
+		/** Lossy: quantize transforms of sleeping transform deltas */
+		bool bQuantizeSettledTransforms = false;
+
+		/** Lossy: store surface deltas as FPackedSurfaceTileDelta records */
+		bool bPackSurfaceDeltas = false;
+	};
+
+	/** File names inside a cell directory */
+	inline const TCHAR* BinaryFileName = TEXT("deltas.bin");
+	inline const TCHAR* JsonFileName = TEXT("deltas.json");
+
+	/**
+	 * Encode a cell to the binary format.
+	 * @param CellKey - Cell the data belongs to (written once in the header)
+	 * @param Data - Deltas to encode
+	 * @param OutBytes - Receives the encoded file contents
+	 * @param Options - Compression / name table / quantization choices
+	 */
+	SINGLEPLAYERSTORYTEMPLATE_API void WriteBinary(const FWorldCellKey& CellKey, const FDeltaCellData& Data, TArray<uint8>& OutBytes,
+		const FWriteOptions& Options = FWriteOptions());
+
+	/**
+	 * Decode a cell from the binary format.
+	 * Each record's CellKey is restored from the header.
+	 * @return false on bad magic, unsupported version, unknown codec, or truncated data
+	 */
+	SINGLEPLAYERSTORYTEMPLATE_API bool ReadBinary(const TArray<uint8>& Bytes, FWorldCellKey& OutCellKey, FDeltaCellData& OutData);
+
+	/** Encode a cell as JSON (debug export; same schema as the legacy deltas.json) */
+	SINGLEPLAYERSTORYTEMPLATE_API FString WriteJson(const FWorldCellKey& CellKey, const FDeltaCellData& Data);
+
+	/** Decode a legacy/debug JSON cell */
+	SINGLEPLAYERSTORYTEMPLATE_API bool ReadJson(const FString& JsonString, FDeltaCellData& OutData);
+
+	/**
+	 * Per-record (de)serializers, shared with journal segments.
+	 * CellKey is NOT serialized - callers store it alongside the record.
+	 * Flags are the cell header flags; only FlagQuantizedTransforms changes a record.
+	 */
+	SINGLEPLAYERSTORYTEMPLATE_API void SerializeRecord(FArchive& Ar, FSurfaceTileDelta& Delta, uint16 Flags = 0);
+	SINGLEPLAYERSTORYTEMPLATE_API void SerializeRecord(FArchive& Ar, FFractureDelta& Delta, uint16 Flags = 0);
+	SINGLEPLAYERSTORYTEMPLATE_API void SerializeRecord(FArchive& Ar, FTransformDelta& Delta, uint16 Flags = 0);
+	SINGLEPLAYERSTORYTEMPLATE_API void SerializeRecord(FArchive& Ar, FSpawnDelta& Delta, uint16 Flags = 0);
+	SINGLEPLAYERSTORYTEMPLATE_API void SerializeRecord(FArchive& Ar, FRemoveDelta& Delta, uint16 Flags = 0);
+	SINGLEPLAYERSTORYTEMPLATE_API void SerializeRecord(FArchive& Ar, FAssemblyDelta& Delta, uint16 Flags = 0);
+}
@@ -0,0 +1,93 @@
+// Copyright 2026 Threaded Pixel Factory
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * Delta Replication Component - Per-client delta channel on the PlayerController
+ *
+ * Purpose:
+ * UDeltaReplicationSubsystem adds one to every remote PlayerController on the
+ * server. It carries compressed cell payloads to that client over reliable
+ * client RPCs and holds the server's view of what the client has.
+ *
+ * Bunches:
+ * A cell payload (DeltaCellFormat binary, compressed) is split into chunks of at
+ * most the subsystem's MaxChunkBytes so RPC arrays stay within the net driver's
+ * replicated array limits. Chunks of one payload are sent in order; the client
+ * decodes once the bLastChunk chunk arrives. Reliable RPCs keep payloads in
+ * order, so batches always land on top of the snapshot they follow.
+ *
+ * @see UDeltaReplicationSubsystem for interest and scheduling
+ */
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/ActorComponent.h"
+#include "DeltaTypes.h"
+#include "DeltaReplicationComponent.generated.h"
+
+/**
+ * One chunk of a cell payload.
+ */
+USTRUCT()
+struct SINGLEPLAYERSTORYTEMPLATE_API FDeltaCellBunch
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	FWorldCellKey CellKey;
+
+	/** Payload replaces the cell (otherwise it appends a batch) */
+	UPROPERTY()
+	bool bSnapshot = false;
+
+	/** Final chunk of the payload */
+	UPROPERTY()
+	bool bLastChunk = true;
+
+	UPROPERTY()
+	TArray<uint8> Data;
+};
+
+/**
+ * Server-to-client delta channel, owned by a PlayerController.
+ */
+UCLASS(ClassGroup = (TPF), meta = (BlueprintSpawnableComponent))
+class SINGLEPLAYERSTORYTEMPLATE_API UDeltaReplicationComponent : public UActorComponent
+{
+	GENERATED_BODY()
+
+public:
+	UDeltaReplicationComponent();
+
+	/** Server -> owning client: chunks of cell payloads, in send order */
+	UFUNCTION(Client, Reliable)
+	void ClientReceiveBunches(const TArray<FDeltaCellBunch>& Bunches);
+
+	/** Server -> owning client: cells that left the client's interest */
+	UFUNCTION(Client, Reliable)
+	void ClientDropCells(const TArray<FWorldCellKey>& CellKeys);
+
+	/** Cells this client is up to date on (server side) */
+	TSet<FWorldCellKey> SyncedCells;
+
+	/** Cells in interest still waiting for a snapshot, nearest first (server side) */
+	TArray<FWorldCellKey> PendingSnapshots;
+
+	/** Bytes this client may still be sent; refilled at MaxBytesPerSecondPerClient, negative after a burst (server side) */
+	double SendAllowanceBytes = 0.0;
+
+private:
+	/** Partially received payloads (client side) */
+	TMap<FWorldCellKey, TArray<uint8>> PartialPayloads;
+};
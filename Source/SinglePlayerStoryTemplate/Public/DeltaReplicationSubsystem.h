@@ -0,0 +1,169 @@
+// Copyright 2026 Threaded Pixel Factory
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * Delta Replication Subsystem - Interest-managed delta replication (server)
+ *
+ * Purpose:
+ * Keeps every connected client's UReplicatedDeltaStore current with the
+ * server's UServerDeltaStore without per-delta RPCs. Runs on listen and
+ * dedicated servers; inactive otherwise.
+ *
+ * Interest:
+ * Each remote PlayerController gets a UDeltaReplicationComponent. A client is
+ * interested in the FWorldCellKey cells within InterestRadiusCells of its view
+ * point (DeltaCellSize grid). Cells further than InterestRadiusCells + 1 are
+ * dropped, so walking along a cell border does not resend cells.
+ *
+ * Send Loop (every SendIntervalSeconds):
+ * 1. UServerDeltaStore::TakeReplicationBatches() - new deltas per cell
+ * 2. Per client, update interest: new cells are prefetched and queued for a
+ *    snapshot (nearest first), departed cells are sent in ClientDropCells
+ * 3. Cells cleared on the server go back to the snapshot queue
+ * 4. Batches for cells the client is synced on are sent
+ * 5. Queued snapshots whose cells are loaded are sent, up to
+ *    MaxSnapshotBytesPerSend per client; cells waiting for their snapshot skip
+ *    batches (the snapshot is encoded later and already contains them)
+ *
+ * Flow Control:
+ * Payloads go over reliable RPCs, and overflowing a connection's reliable buffer
+ * disconnects it. Each client has a byte allowance refilled at
+ * MaxBytesPerSecondPerClient. While it is used up, or the connection or its
+ * actor channel is saturated, the client is sent nothing. Its batch cells go
+ * back to the snapshot queue, so nothing is lost; they resync once it drains.
+ *
+ * Each batch and snapshot is encoded once per send (DeltaCellFormat, compressed)
+ * and shared by every client that needs it.
+ *
+ * @see UServerDeltaStore for the replication log
+ * @see UDeltaReplicationComponent for the per-client channel
+ */
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "DeltaTypes.h"
+#include "DeltaCellFormat.h"
+#include "DeltaReplicationSubsystem.generated.h"
+
+class AController;
+class AGameModeBase;
+class APlayerController;
+class UDeltaReplicationComponent;
+class UServerDeltaStore;
+struct FDeltaCellBunch;
+
+/**
+ * World subsystem replicating delta cells from the server to clients.
+ */
+UCLASS(Config = Game)
+class SINGLEPLAYERSTORYTEMPLATE_API UDeltaReplicationSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	//--- UWorldSubsystem Interface ---
+	virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+
+	//--- UTickableWorldSubsystem Interface ---
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override { RETURN_QUICK_DECLARE_CYCLE_STAT(UDeltaReplicationSubsystem, STATGROUP_Tickables); }
+
+	/** True on listen and dedicated servers with a UServerDeltaStore */
+	UFUNCTION(BlueprintPure, Category = "DeltaReplication")
+	bool IsReplicating() const;
+
+	/** Clients currently receiving deltas */
+	UFUNCTION(BlueprintPure, Category = "DeltaReplication")
+	int32 GetClientCount() const { return Clients.Num(); }
+
+	//==========================================================================
+	// CONFIGURATION
+	//==========================================================================
+
+	/** Delta grid cell size (cm); must match the size deltas are keyed with */
+	UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "DeltaReplication|Config", meta = (ClampMin = "100"))
+	float DeltaCellSize = 6400.0f;
+
+	/** Cells around a client's view point it receives (square radius) */
+	UPROPERTY(Config, EditAnywhere, BlueprintReadWrite, Category = "DeltaReplication|Config", meta = (ClampMin = "0"))
+	int32 InterestRadiusCells = 3;
+
+	/** Time between sends; deltas appended in between travel as one batch per cell */
+	UPROPERTY(Config, EditAnywhere, BlueprintReadWrite, Category = "DeltaReplication|Config", meta = (ClampMin = "0"))
+	float SendIntervalSeconds = 0.1f;
+
+	/** Snapshot bytes per client per send, within the client's byte allowance */
+	UPROPERTY(Config, EditAnywhere, BlueprintReadWrite, Category = "DeltaReplication|Config", meta = (ClampMin = "1024"))
+	int32 MaxSnapshotBytesPerSend = 4 * 1024;
+
+	/** Sustained delta bytes per client per second (also the burst cap); keep well under the net driver's client rate */
+	UPROPERTY(Config, EditAnywhere, BlueprintReadWrite, Category = "DeltaReplication|Config", meta = (ClampMin = "1024"))
+	int32 MaxBytesPerSecondPerClient = 24 * 1024;
+
+	/** Payload chunk size; keep under net.MaxRepArraySize */
+	UPROPERTY(Config, EditAnywhere, BlueprintReadWrite, Category = "DeltaReplication|Config", meta = (ClampMin = "64", ClampMax = "2048"))
+	int32 MaxChunkBytes = 1024;
+
+	/** Chunk bytes per ClientReceiveBunches call; keep under net.MaxRepArrayMemory */
+	UPROPERTY(Config, EditAnywhere, BlueprintReadWrite, Category = "DeltaReplication|Config", meta = (ClampMin = "1024"))
+	int32 MaxBytesPerRPC = 4 * 1024;
+
+	/** Codec for payloads (LZ4, Oodle or Zlib) */
+	UPROPERTY(Config, EditAnywhere, BlueprintReadWrite, Category = "DeltaReplication|Config")
+	FName CompressionFormat = NAME_LZ4;
+
+	/** Send surface deltas as packed records (see FPackedSurfaceTileDelta) */
+	UPROPERTY(Config, EditAnywhere, BlueprintReadWrite, Category = "DeltaReplication|Config")
+	bool bPackSurfaceDeltas = true;
+
+private:
+	void HandlePostLogin(AGameModeBase* GameMode, APlayerController* NewPlayer);
+	void HandleLogout(AGameModeBase* GameMode, AController* Exiting);
+
+	/** Attach a replication component to a remote player */
+	void AddClient(APlayerController* PlayerController);
+
+	/** Refresh a client's interest; queues snapshots and sends drops */
+	void UpdateInterest(UDeltaReplicationComponent& Client, UServerDeltaStore& Store);
+
+	/** Encode a cell's current state (cached for this send) */
+	const TArray<uint8>& GetSnapshotPayload(const FWorldCellKey& CellKey, UServerDeltaStore& Store);
+
+	/** Split a payload into chunks appended to Outgoing, sending full RPCs as they fill */
+	void QueuePayload(UDeltaReplicationComponent& Client, TArray<FDeltaCellBunch>& Outgoing, int32& OutgoingBytes,
+		const FWorldCellKey& CellKey, bool bSnapshot, const TArray<uint8>& Payload);
+
+	/** True while the client's connection or actor channel can't take more reliable data */
+	static bool IsClientSaturated(const UDeltaReplicationComponent& Client);
+
+	/** Encoder settings shared by batches and snapshots */
+	DeltaCellFormat::FWriteOptions GetPayloadOptions() const;
+
+	UServerDeltaStore* GetStore() const;
+
+	TArray<TWeakObjectPtr<UDeltaReplicationComponent>> Clients;
+
+	/** Per-send encode caches */
+	TMap<FWorldCellKey, TArray<uint8>> EncodedBatches;
+	TMap<FWorldCellKey, TArray<uint8>> EncodedSnapshots;
+
+	double SecondsSinceSend = 0.0;
+
+	FDelegateHandle PostLoginHandle;
+	FDelegateHandle LogoutHandle;
+};
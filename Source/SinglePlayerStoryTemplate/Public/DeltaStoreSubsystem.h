@@ -0,0 +1,157 @@
+// Copyright 2026 Threaded Pixel Factory
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * Delta Store Subsystem - Per-world delta store ownership and auto-flush
+ *
+ * Purpose:
+ * Owns the UFileDeltaStore (or UJournalDeltaStore) for the current game world and
+ * flushes it automatically so gameplay code only ever appends and queries.
+ *
+ * Auto-Flush Policy (FDeltaFlushPolicy):
+ * - Elapsed time since the last completed flush
+ * - Dirty-cell count
+ * - Pending-byte budget (store's estimate of unflushed delta data)
+ * - Level transition (IDeltaStore::OnPreLevelTransition, broadcast by
+ *   UModuleLoaderSubsystem and UInterplanetaryTravelSubsystem)
+ *
+ * Frame Spreading:
+ * Once a trigger fires the subsystem drains the store over several ticks, handing
+ * at most MaxCellsPerFrame cells to each FlushAsync() call. Level transitions and
+ * Deinitialize flush everything at once - the world is about to go away.
+ *
+ * Networked Worlds (bReplicateDeltas):
+ * - Listen/dedicated servers own a UServerDeltaStore (journal persistence plus a
+ *   replication log read by UDeltaReplicationSubsystem)
+ * - Clients own a UReplicatedDeltaStore filled from the server; it never persists
+ *
+ * Cache Budget:
+ * CacheBudgetBytes is handed to the store; each tick TrimCache() evicts least
+ * recently used clean cells down to it (dirty cells stay until flushed).
+ * 
+ * The store is also bound to the world's USurfaceQuerySubsystem, so surface
+ * queries sample the deltas gameplay appends here.
+ *
+ * Usage:
+ * \code{.cpp}
+ *   UDeltaStoreSubsystem* Deltas = GetWorld()->GetSubsystem<UDeltaStoreSubsystem>();
+ *   Deltas->GetDeltaStore()->AppendSurfaceDelta(Delta);
+ * \endcode
+ *
+ * @see UFileDeltaStore for storage and flush mechanics
+ */
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "DeltaStoreSubsystem.generated.h"
+
+class UFileDeltaStore;
+
+/**
+ * When the owning subsystem should flush its delta store.
+ * A value of 0 disables that trigger.
+ */
+USTRUCT(BlueprintType)
+struct SINGLEPLAYERSTORYTEMPLATE_API FDeltaFlushPolicy
+{
+	GENERATED_BODY()
+
+	/** Master switch - with this off only level transitions and shutdown flush */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Flush")
+	bool bEnabled = true;
+
+	/** Flush when this many seconds have passed since the last flush and something is dirty */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Flush", meta = (ClampMin = "0"))
+	float IntervalSeconds = 30.0f;
+
+	/** Flush once this many cells are dirty */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Flush", meta = (ClampMin = "0"))
+	int32 MaxDirtyCells = 64;
+
+	/** Flush once the store estimates this many unflushed bytes */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Flush", meta = (ClampMin = "0"))
+	int64 PendingByteBudget = 1024 * 1024;
+
+	/** Flush everything when IDeltaStore::OnPreLevelTransition fires */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Flush")
+	bool bFlushOnLevelTransition = true;
+
+	/** Cells handed to the store per tick while draining (0 = all at once) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Flush", meta = (ClampMin = "0"))
+	int32 MaxCellsPerFrame = 16;
+
+	/** True if any trigger is satisfied */
+	bool ShouldFlush(double SecondsSinceFlush, int32 DirtyCells, int64 PendingBytes) const;
+};
+
+/**
+ * World subsystem owning the delta store for game worlds.
+ */
+UCLASS(Config = Game)
+class SINGLEPLAYERSTORYTEMPLATE_API UDeltaStoreSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	//--- UWorldSubsystem Interface ---
+	virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+
+	//--- UTickableWorldSubsystem Interface ---
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override { RETURN_QUICK_DECLARE_CYCLE_STAT(UDeltaStoreSubsystem, STATGROUP_Tickables); }
+
+	/** The store for this world (valid between Initialize and Deinitialize) */
+	UFUNCTION(BlueprintPure, Category = "DeltaStore")
+	UFileDeltaStore* GetDeltaStore() const { return Store; }
+
+	/** Flush everything now, bypassing frame spreading */
+	UFUNCTION(BlueprintCallable, Category = "DeltaStore")
+	void FlushNow();
+
+	/** True while a triggered flush is being spread over frames */
+	UFUNCTION(BlueprintPure, Category = "DeltaStore")
+	bool IsDraining() const { return bDraining; }
+
+	//==========================================================================
+	// CONFIGURATION
+	//==========================================================================
+
+	UPROPERTY(Config, EditAnywhere, BlueprintReadWrite, Category = "DeltaStore|Config")
+	FDeltaFlushPolicy FlushPolicy;
+
+	/** Resident delta cache size before clean cells are evicted (0 = unbounded) */
+	UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "DeltaStore|Config", meta = (ClampMin = "0"))
+	int64 CacheBudgetBytes = 256 * 1024 * 1024;
+
+	/** Use the journal-backed store (cheaper flushes for high-frequency deltas) */
+	UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "DeltaStore|Config")
+	bool bUseJournalStore = false;
+
+	/** In networked worlds use the server/client stores instead (see UDeltaReplicationSubsystem) */
+	UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "DeltaStore|Config")
+	bool bReplicateDeltas = true;
+
+private:
+	void HandlePreLevelTransition();
+
+	UPROPERTY(Transient)
+	TObjectPtr<UFileDeltaStore> Store;
+
+	FDelegateHandle LevelTransitionHandle;
+	double SecondsSinceFlush = 0.0;
+	bool bDraining = false;
+};
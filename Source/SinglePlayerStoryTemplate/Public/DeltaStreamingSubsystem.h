@@ -0,0 +1,200 @@
+// Copyright 2026 Threaded Pixel Factory
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * Delta Streaming Subsystem - Applies persisted deltas as world cells stream in
+ *
+ * Purpose:
+ * Bridges the world's delta store and level streaming. Streamed levels (World
+ * Partition runtime cells, or classic streaming sublevels) come back in their
+ * authored state; this subsystem re-applies what the player changed there.
+ *
+ * Cell Mapping:
+ * World Partition cells and the FWorldCellKey grid are independent. A streamed
+ * level covers the delta cells under the bounds of its actor locations
+ * (DeltaCellSize grid); levels whose bounds span more than MaxCellsPerLevel
+ * cells (e.g. the persistent level) use the cells their actors sit in instead.
+ * Overlapping levels share cells by reference count.
+ *
+ * Pipeline (per activated level):
+ * 1. FWorldDelegates::LevelAddedToWorld - compute the level's cells and
+ *    UFileDeltaStore::PrefetchCells() them (file read + decode on workers)
+ * 2. Wait until every cell's load has completed - never a synchronous read
+ * 3. Index the level's actors by GetActorDeltaGuid()
+ * 4. Apply, time-sliced to MaxApplyMillisecondsPerFrame across all levels:
+ *    - FRemoveDelta: destroy the actor
+ *    - FTransformDelta: last transform per actor, with its physics/sleep state
+ *    - FSpawnDelta: spawn the actor (classes loaded async first), once per world
+ * 5. FWorldDelegates::LevelRemovedFromWorld - drop the level's job and unpin
+ *    the cells no other level uses
+ *
+ * Spawned Actors:
+ * A spawn delta's cell can be covered by several levels (the persistent level's
+ * cells overlap every streamed level), so spawns go through one registry keyed
+ * by guid. The actor is spawned into the persistent level by the first level
+ * that reaches the delta; every covering level holds a reference, and the actor
+ * is destroyed when the last of them unloads.
+ *
+ * Eviction:
+ * Active cells are pinned in the store (UFileDeltaStore::PinCell); once a cell's
+ * last level unloads it is left to the store's LRU cache budget.
+ *
+ * Actor Identity:
+ * Deltas name actors by FGuid. GetActorDeltaGuid() derives it from the actor's
+ * name, which World Partition keeps stable across streaming and runs; actors
+ * spawned from an FSpawnDelta carry their delta's guid in their name. Gameplay
+ * code recording deltas must use GetActorDeltaGuid() for the same reason.
+ *
+ * Fracture and assembly deltas are left to their owning systems.
+ *
+ * @see UDeltaStoreSubsystem for the store this reads
+ */
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "DeltaTypes.h"
+#include "UObject/ObjectKey.h"
+#include "DeltaStreamingSubsystem.generated.h"
+
+class UFileDeltaStore;
+class ULevel;
+struct FStreamableHandle;
+
+/**
+ * World subsystem applying persisted deltas to streamed-in levels.
+ */
+UCLASS(Config = Game)
+class SINGLEPLAYERSTORYTEMPLATE_API UDeltaStreamingSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	//--- UWorldSubsystem Interface ---
+	virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+
+	//--- UTickableWorldSubsystem Interface ---
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override { RETURN_QUICK_DECLARE_CYCLE_STAT(UDeltaStreamingSubsystem, STATGROUP_Tickables); }
+
+	/**
+	 * Stable identity of an actor for delta records.
+	 * Spawned-from-delta actors return their delta's guid; others a guid derived from their name.
+	 */
+	static FGuid GetActorDeltaGuid(const AActor* Actor);
+
+	/** Levels whose deltas are still being applied */
+	UFUNCTION(BlueprintPure, Category = "DeltaStreaming")
+	int32 GetPendingLevelCount() const { return Jobs.Num(); }
+
+	/** True if a streamed-in level currently covers the cell */
+	UFUNCTION(BlueprintPure, Category = "DeltaStreaming")
+	bool IsCellActive(const FWorldCellKey& CellKey) const { return ActiveCellRefs.Contains(CellKey); }
+
+	//==========================================================================
+	// CONFIGURATION
+	//==========================================================================
+
+	/** Delta grid cell size (cm); must match the size deltas are keyed with */
+	UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "DeltaStreaming|Config", meta = (ClampMin = "100"))
+	float DeltaCellSize = 6400.0f;
+
+	/** Game-thread time per frame for applying deltas, across all levels */
+	UPROPERTY(Config, EditAnywhere, BlueprintReadWrite, Category = "DeltaStreaming|Config", meta = (ClampMin = "0.05"))
+	float MaxApplyMillisecondsPerFrame = 1.0f;
+
+	/** Levels whose bounds cover more cells than this map actor cells one by one */
+	UPROPERTY(Config, EditAnywhere, BlueprintReadWrite, Category = "DeltaStreaming|Config", meta = (ClampMin = "1"))
+	int32 MaxCellsPerLevel = 256;
+
+private:
+	enum class EApplyPhase : uint8
+	{
+		Removes,
+		Transforms,
+		Spawns,
+		Done
+	};
+
+	/** Delta application state for one streamed-in level */
+	struct FLevelApplyJob
+	{
+		TWeakObjectPtr<ULevel> Level;
+		TArray<FWorldCellKey> Cells;
+		EApplyPhase Phase = EApplyPhase::Removes;
+		int32 CellIndex = 0;
+		int32 DeltaIndex = 0;
+		bool bCellsLoaded = false;
+		bool bActorsIndexed = false;
+
+		TMap<FGuid, TWeakObjectPtr<AActor>> ActorsByGuid;
+		TSet<FGuid> RemovedGuids;
+
+		/** Latest transform delta per actor, as (cell index, delta index) */
+		TMap<FGuid, TPair<int32, int32>> LastTransform;
+
+		/** Spawn classes not yet in memory */
+		TSharedPtr<FStreamableHandle> ClassLoadHandle;
+	};
+
+	void HandleLevelAdded(ULevel* InLevel, UWorld* InWorld);
+	void HandleLevelRemoved(ULevel* InLevel, UWorld* InWorld);
+
+	/** Delta cells covered by a level's actors */
+	TArray<FWorldCellKey> ComputeLevelCells(const ULevel& Level) const;
+
+	/** Advance a job until it finishes (true) or the deadline passes / data is not ready (false) */
+	bool AdvanceJob(FLevelApplyJob& Job, ULevel& Level, UFileDeltaStore& Store, double Deadline);
+
+	/** Entering a phase: build per-phase lookups and start class loads */
+	void BeginPhase(FLevelApplyJob& Job, UFileDeltaStore& Store);
+
+	/** Actor spawned from a spawn delta, shared by every active level covering the delta's cell */
+	struct FSpawnedDeltaActor
+	{
+		TWeakObjectPtr<AActor> Actor;
+
+		/** Active levels that reached the delta */
+		int32 Refs = 0;
+
+		/** A remove delta destroyed it; not spawned again while referenced */
+		bool bRemoved = false;
+	};
+
+	void ApplyRemove(FLevelApplyJob& Job, const FRemoveDelta& Delta);
+	void ApplyTransform(FLevelApplyJob& Job, const FTransformDelta& Delta);
+	void ApplySpawn(FLevelApplyJob& Job, ULevel& Level, const FSpawnDelta& Delta);
+
+	UFileDeltaStore* GetStore() const;
+
+	TArray<FLevelApplyJob> Jobs;
+
+	/** Cells per active level */
+	TMap<TObjectKey<ULevel>, TArray<FWorldCellKey>> ActiveLevels;
+
+	/** Active levels covering each cell (each active cell holds one store pin) */
+	TMap<FWorldCellKey, int32> ActiveCellRefs;
+
+	/** Spawn-delta actors by guid, across all levels */
+	TMap<FGuid, FSpawnedDeltaActor> SpawnedActors;
+
+	/** Spawned actor references held per active level, released on unload */
+	TMap<TObjectKey<ULevel>, TSet<FGuid>> LevelSpawnRefs;
+
+	FDelegateHandle LevelAddedHandle;
+	FDelegateHandle LevelRemovedHandle;
+};
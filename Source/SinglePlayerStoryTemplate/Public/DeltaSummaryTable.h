@@ -0,0 +1,109 @@
+// Copyright 2026 Threaded Pixel Factory
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * Delta Summary Table - Multi-resolution aggregates of per-cell deltas
+ *
+ * Purpose:
+ * Far-field systems (distant snow cover, world map, population/ecology
+ * heuristics) need "how much changed over there", not every delta. The table
+ * keeps one FDeltaCellSummary per LOD 0 cell with deltas and rolls them up into
+ * every coarser FWorldCellKey LOD up to MaxLOD (LOD n covers 2^n x 2^n cells).
+ *
+ * Updates:
+ * - SetCell() replaces a base cell's summary: the old contribution is subtracted
+ *   from each ancestor and the new one added, O(MaxLOD) per cell
+ * - Ancestors left with no contributing cells are dropped
+ * - Only LOD 0 cells are aggregated (the LOD deltas are recorded at)
+ *
+ * Binary Layout (little endian, via FMemoryWriter/FMemoryReader):
+ *   uint32  Magic        'TPFL'
+ *   uint16  Version      DeltaSummaryFormat::CurrentVersion
+ *   uint16  Flags        Always 0
+ *   int32   Count
+ *   Count FDeltaCellSummary records (LOD 0 cells only; coarse LODs are rebuilt on Load)
+ *
+ * Thread Safety:
+ * - All methods lock; flush and compaction workers update the table directly
+ *
+ * @see UFileDeltaStore::GetCellSummary for the query path
+ */
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "DeltaTypes.h"
+#include "DeltaCellFormat.h"
+
+namespace DeltaSummaryFormat
+{
+	/** 'TPFL' */
+	constexpr uint32 Magic = 0x4C465054;
+
+	/** Bump when FDeltaCellSummary's serialized layout changes; older files are rebuilt from the cell files */
+	constexpr uint16 CurrentVersion = 1;
+
+	/** Serialized size of one FDeltaCellSummary record: key, 5 surface means, 6 counts, timestamp */
+	constexpr int64 RecordBytes = 3 * sizeof(int32) + 5 * sizeof(float) + 6 * sizeof(int32) + sizeof(double);
+
+	/** Summary file name inside a world's save directory */
+	inline const TCHAR* FileName = TEXT("summaries.bin");
+}
+
+/**
+ * Thread-safe LOD pyramid of FDeltaCellSummary.
+ */
+class SINGLEPLAYERSTORYTEMPLATE_API FDeltaSummaryTable
+{
+public:
+	/** Summary of one cell's deltas (CellsWithDeltas is 0 for an empty cell) */
+	static FDeltaCellSummary Summarize(const FWorldCellKey& CellKey, const FDeltaCellData& Data);
+
+	/** Drop every summary and set the coarsest LOD kept */
+	void Reset(int32 InMaxLOD);
+
+	/** Replace a LOD 0 cell's summary and update its ancestors. Other LODs are ignored. */
+	void SetCell(const FDeltaCellSummary& Summary);
+
+	/** Summarize and SetCell() */
+	void UpdateCell(const FWorldCellKey& CellKey, const FDeltaCellData& Data) { SetCell(Summarize(CellKey, Data)); }
+
+	/** @return false if no cell with deltas lies under CellKey (or its LOD is above MaxLOD) */
+	bool Find(const FWorldCellKey& CellKey, FDeltaCellSummary& OutSummary) const;
+
+	/** Coarsest LOD aggregated */
+	int32 GetMaxLOD() const;
+
+	/** LOD 0 cells with deltas */
+	int32 Num() const;
+
+	/** Write the LOD 0 summaries via a temp file, never leaving a partial one. Safe to call from any thread. */
+	bool Save(const FString& FilePath) const;
+
+	/**
+	 * Replace the table with a saved one, rebuilding coarse LODs.
+	 * @return false if the file is missing, stale or corrupt (table is left empty)
+	 */
+	bool Load(const FString& FilePath);
+
+private:
+	/** Add (Sign = 1) or remove (Sign = -1) a base summary from every ancestor; caller holds Lock */
+	void AccumulateAncestors(const FDeltaCellSummary& Base, int32 Sign);
+
+	mutable FCriticalSection Lock;
+
+	int32 MaxLOD = 0;
+
+	/** Index = LOD; Levels[0] holds base cells, Levels[n] their 2^n aggregates */
+	TArray<TMap<FWorldCellKey, FDeltaCellSummary>> Levels;
+};
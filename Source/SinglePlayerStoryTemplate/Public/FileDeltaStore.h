@@ -15,21 +15,33 @@
  * File Delta Store - Single-Player World State Persistence
  * 
  * Purpose:
- * Implements IDeltaStore using local JSON files for single-player world persistence.
+ * Implements IDeltaStore using local binary cell files for single-player world persistence.
  * Stores all world changes (surface modifications, destruction, moved objects) to disk.
  * 
  * Architecture:
- * - In-memory cache of deltas per cell (TMap<FWorldCellKey, TArray<Delta>>)
+ * - In-memory cache of deltas per cell (TMap<FWorldCellKey, TSharedPtr<FDeltaCellData>>)
+ * - Flush snapshots are copy-on-write: the worker shares each dirty cell's data and
+ *   the next append to that cell clones it, so Flush() costs O(dirty cells) on the
+ *   game thread instead of a deep copy of every dirty cell's history
  * - Dirty tracking for modified cells
- * - Flush() writes dirty cells to JSON files
- * - Lazy loading: cells loaded on first query
+ * - Flush() writes dirty cells to versioned binary files (see DeltaCellFormat.h)
+ * - Optional JSON debug export; legacy deltas.json files are still readable
+ * - Flushes run in submission order on one UE::Tasks::FPipe; each returns an
+ *   FTask that completes once its cells are on disk (FlushAsync)
+ * - Back-pressure: past MaxQueuedFlushes, new flushes merge into the newest
+ *   batch that has not started writing instead of queueing another one
+ * - Lazy loading: cells loaded on first query (synchronous fallback)
+ * - PrefetchCells() reads + parses cell files on a UE::Tasks worker so the
+ *   data is already resident when streaming code queries it
  * 
  * File Structure:
- *   SaveGames/
+ *   Saved/GameSaveData/
  *     └── [WorldName]/
- *         ├── cell_0_0_0.json      (Surface/Transform deltas for cell 0,0)
- *         ├── cell_1_0_0.json      (Next cell over)
- *         └── fractures.json       (All fracture deltas, indexed by cell)
+ *         ├── summaries.bin  (LOD 0 cell summaries, see DeltaSummaryTable.h)
+ *         ├── (0,0,LOD0)/
+ *         │     ├── deltas.bin     (All delta types for cell 0,0)
+ *         │     └── deltas.json    (Debug export, only with bWriteDebugJson)
+ *         └── (1,0,LOD0)/          (Next cell over)
  * 
  * Delta Types:
  * - SurfaceTileDelta: Snow, wetness, compaction changes
@@ -61,8 +73,12 @@
  * Performance:
  * - Append operations: O(1) in-memory
  * - Query operations: O(1) hash lookup + O(n) array scan
- * - Flush: O(dirty cells) file writes
+ * - View*Deltas: O(1), no allocation (Get*Deltas copies)
+ * - Flush: O(dirty cells) on the game thread; serialization runs on a worker
+ * - With bCoalesceSurfaceDeltas, n is bounded by distinct tile channels per cell
  * - Lazy loading: Only loads cells as queried
+ * - Prefetch: file read + decode off the game thread; the query that first
+ *   touches a prefetched cell only pays for moving the decoded arrays in
  * 
  * Multiplayer Notes:
  * - This implementation is single-player only
@@ -77,30 +93,67 @@
 
 #include "CoreMinimal.h"
 #include "DeltaTypes.h"
+#include "DeltaCellFormat.h"
+#include "DeltaSummaryTable.h"
+#include "Tasks/Task.h"
+#include "Tasks/Pipe.h"
 #include "FileDeltaStore.generated.h"
 
 /**
  * File-based delta store for single-player persistence.
  * 
- * Implements IDeltaStore using local JSON files for world state persistence.
+ * Implements IDeltaStore using local binary files for world state persistence.
  * Suitable for single-player games where world state is saved locally.
  * 
  * Lifecycle:
  * 1. Initialize(WorldName) - Sets up save directory structure
  * 2. Append*Delta() - Add deltas to in-memory cache (marks cell dirty)
- * 3. Get*Deltas() - Query deltas for a cell (lazy loads from disk)
- * 4. Flush() - Write all dirty cells to disk
- * 5. Repeat 2-4 during gameplay
+ * 3. PrefetchCells() - Optionally warm cells ahead of streaming (async)
+ * 4. View*/Get*Deltas() - Query deltas for a cell (lazy loads from disk)
+ * 5. Flush() - Write all dirty cells to disk
+ * 6. Repeat 2-5 during gameplay
+ * 
+ * Residency:
+ * A cell is "resident" once its file has been merged into the in-memory caches.
+ * Appends to a non-resident cell are kept and ordered after the on-disk history
+ * when the cell is merged. Flush() makes dirty cells resident first so a save
+ * never overwrites history that was not loaded yet.
+ * 
+ * View Lifetime:
+ * Views returned by View*Deltas() alias the per-cell caches and are valid until
+ * the next Append*, ClearCellDeltas, Flush, Initialize or PrefetchCells call.
+ * Residency merges and EvictCell() only ever touch the cell they are given.
+ * 
+ * Cache Budget (LRU):
+ * Resident cells are byte-accounted and stamped on every query and append. With
+ * CacheBudgetBytes set, TrimCache() (run by FlushAsync and each UDeltaStoreSubsystem
+ * tick) evicts the least recently used cells until the cache fits. Dirty cells,
+ * cells a flush is still writing and pinned cells (PinCell) are never evicted; an
+ * evicted cell is read back from disk on its next query.
  * 
  * Thread Safety:
  * - NOT thread-safe - all operations must be on game thread
- * - File I/O is synchronous (consider async for production)
+ * - Cell loads and Flush() file I/O run on UE::Tasks workers
+ * - Flush queue metrics are guarded by a lock and readable from the game thread
+ * 
+ * Auto-Flush:
+ * UDeltaStoreSubsystem owns a store per world and applies FDeltaFlushPolicy
+ * (time, dirty cells, pending bytes, level transitions) using FlushAsync(MaxCells)
  * 
- * Optimization Opportunities:
- * - Async file I/O for Flush()
- * - Delta compression for large cell data
- * - Binary format (CBOR) instead of JSON for smaller files
- * - Periodic auto-flush based on time/delta count
+ * Memory Stats:
+ * GetCacheAllocatedBytes() is the accounted total (no walk); GetEvictionCount() and
+ * GetReloadCount() feed the TPFCore stat group via UDeltaStoreSubsystem.
+ * 
+ * Cell Summaries:
+ * GetCellSummary() answers for any LOD up to MaxSummaryLOD from an FDeltaSummaryTable
+ * that the flush worker updates per written cell and saves as summaries.bin, so
+ * far-field queries never touch cell files. Summaries reflect flushed data only.
+ * A missing, stale or corrupt summaries.bin is rebuilt from the cell files on the
+ * flush pipe during Initialize.
+ * 
+ * Disk Size:
+ * bUseNameTable, bCompressCellFiles, bQuantizeSettledTransforms and bPackSurfaceDeltas map onto the
+ * DeltaCellFormat header flags; files written with any settings stay readable.
  * 
  * @note For multiplayer, replace with server-authoritative delta store
  * @see IDeltaStore for interface contract
@@ -127,9 +180,81 @@ public:
 	virtual TArray<FSpawnDelta> GetSpawnDeltas(const FWorldCellKey& CellKey) const override;
 	virtual TArray<FRemoveDelta> GetRemoveDeltas(const FWorldCellKey& CellKey) const override;
 	virtual TArray<FAssemblyDelta> GetAssemblyDeltas(const FWorldCellKey& CellKey) const override;
+
+	virtual TConstArrayView<FSurfaceTileDelta> ViewSurfaceDeltas(const FWorldCellKey& CellKey) const override;
+	virtual TConstArrayView<FFractureDelta> ViewFractureDeltas(const FWorldCellKey& CellKey) const override;
+	virtual TConstArrayView<FTransformDelta> ViewTransformDeltas(const FWorldCellKey& CellKey) const override;
+	virtual TConstArrayView<FSpawnDelta> ViewSpawnDeltas(const FWorldCellKey& CellKey) const override;
+	virtual TConstArrayView<FRemoveDelta> ViewRemoveDeltas(const FWorldCellKey& CellKey) const override;
+	virtual TConstArrayView<FAssemblyDelta> ViewAssemblyDeltas(const FWorldCellKey& CellKey) const override;
 	
 	virtual void ClearCellDeltas(const FWorldCellKey& CellKey) override;
 	virtual void Flush() override;
+	virtual bool GetCellSummary(const FWorldCellKey& CellKey, FDeltaCellSummary& OutSummary) const override;
+
+	// UObject Interface
+	virtual void BeginDestroy() override;
+
+	/**
+	 * Flush dirty cells and return a handle for the write.
+	 * 
+	 * @param MaxCells - Flush at most this many dirty cells (0 = all). Lets callers
+	 *                   spread a large flush over several frames.
+	 * @return Task that completes once this flush's data is on disk. If nothing
+	 *         was dirty, or the flush was coalesced, this is the most recently
+	 *         queued flush - which covers this call's data either way.
+	 * 
+	 * @note Flush() is FlushAsync() with the handle discarded
+	 */
+	virtual UE::Tasks::FTask FlushAsync(int32 MaxCells = 0);
+
+	/** Block until every queued flush has been written */
+	UFUNCTION(BlueprintCallable, Category = "DeltaStore")
+	virtual void WaitForFlush();
+
+	/** Flushes queued or currently writing */
+	UFUNCTION(BlueprintCallable, Category = "DeltaStore")
+	int32 GetQueuedFlushCount() const;
+
+	/** Flushes merged into an already-queued batch because of MaxQueuedFlushes */
+	UFUNCTION(BlueprintCallable, Category = "DeltaStore")
+	int32 GetCoalescedFlushCount() const;
+
+	/** Total bytes written by completed flushes */
+	int64 GetFlushedBytes() const;
+
+	/** Cells with changes that have not been handed to a flush yet */
+	UFUNCTION(BlueprintCallable, Category = "DeltaStore")
+	int32 GetDirtyCellCount() const { return DirtyCells.Num(); }
+
+	/** Approximate in-memory size of deltas appended since they were last flushed */
+	virtual int64 GetPendingBytes() const { return PendingAppendBytes; }
+
+	/** Bytes allocated by the resident cell caches (delta arrays, not their nested payloads) */
+	int64 GetCacheAllocatedBytes() const;
+
+	/** Resident cells (including cells with no deltas) */
+	int32 GetResidentCellCount() const { return ResidentCells.Num(); }
+
+	/** Cells evicted by TrimCache()/EvictCell() since Initialize */
+	int32 GetEvictionCount() const { return EvictionCount; }
+
+	/** Evicted cells that were later read back from disk */
+	int32 GetReloadCount() const { return ReloadCount; }
+
+	/**
+	 * Evict least recently used cells until the cache fits CacheBudgetBytes.
+	 * Invalidates views of evicted cells only.
+	 * 
+	 * @return Number of cells evicted
+	 */
+	int32 TrimCache();
+
+	/** Keep a cell resident regardless of the budget (reference counted) */
+	void PinCell(const FWorldCellKey& CellKey);
+
+	/** Release a PinCell() reference */
+	void UnpinCell(const FWorldCellKey& CellKey);
 
 	/**
 	 * Initialize the delta store for a specific world.
@@ -159,23 +284,225 @@ public:
 	 * \endcode
 	 */
 	UFUNCTION(BlueprintCallable, Category = "DeltaStore")
-	bool Initialize(const FString& WorldName);
+	virtual bool Initialize(const FString& WorldName);
 
 	UFUNCTION(BlueprintCallable, Category = "DeltaStore")
 	bool IsInitialized() const { return bIsInitialized; }
 
-private:
+	/**
+	 * Begin loading cells in the background so later queries do not hit disk.
+	 * Intended to be driven from World Partition streaming ahead of cell activation.
+	 * 
+	 * @param CellKeys - Cells to warm. Resident and already-pending cells are skipped.
+	 * @return Number of cell loads actually launched
+	 * 
+	 * @note Completed loads are merged on the next query/flush touching the cell,
+	 *       or on the next PrefetchCells() call
+	 */
+	UFUNCTION(BlueprintCallable, Category = "DeltaStore")
+	int32 PrefetchCells(const TArray<FWorldCellKey>& CellKeys);
+
+	/** True if the cell's persisted deltas are merged into memory */
+	UFUNCTION(BlueprintCallable, Category = "DeltaStore")
+	bool IsCellResident(const FWorldCellKey& CellKey) const { return ResidentCells.Contains(CellKey); }
+
+	/** Number of background cell loads not yet merged */
+	UFUNCTION(BlueprintCallable, Category = "DeltaStore")
+	int32 GetPendingLoadCount() const { return PendingLoads.Num(); }
+
+	/** True if querying the cell will not wait on a background load (resident, prefetched, or never prefetched) */
+	bool IsCellLoadComplete(const FWorldCellKey& CellKey) const;
+
+	/**
+	 * True if the cell can be dropped from memory without losing data: not dirty,
+	 * not pinned, and no flush still writing it.
+	 */
+	virtual bool CanEvictCell(const FWorldCellKey& CellKey) const;
+
+	/**
+	 * Drop a cell's in-memory deltas; the next query lazy loads it again.
+	 * Invalidates views of that cell only.
+	 * 
+	 * @return false if the cell is not resident or CanEvictCell() refuses
+	 */
+	bool EvictCell(const FWorldCellKey& CellKey);
+
+	/** Bytes allocated by one resident cell's delta arrays */
+	int64 GetCellAllocatedBytes(const FWorldCellKey& CellKey) const;
+
+	/** Also write a human-readable deltas.json next to each binary cell file on Flush() */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "DeltaStore|Config")
+	bool bWriteDebugJson = false;
+
+	/**
+	 * Fold composable surface deltas on the same tile channel into one record
+	 * (see FSurfaceTileDelta::TryCoalesce). Bounds memory, flush size and query
+	 * cost for long-running effects like rain or standing in snow, at the cost of
+	 * losing per-step history.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "DeltaStore|Config")
+	bool bCoalesceSurfaceDeltas = false;
+
+	/**
+	 * Queued-or-writing flushes before new flushes are merged into the newest
+	 * unstarted batch. 0 disables coalescing.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "DeltaStore|Config")
+	int32 MaxQueuedFlushes = 2;
+
+	/** Compress cell files (DeltaCellFormat::FlagCompressed). Trades flush/load CPU for disk and I/O. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "DeltaStore|Config")
+	bool bCompressCellFiles = false;
+
+	/** Codec for bCompressCellFiles: LZ4, Oodle or Zlib */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "DeltaStore|Config", meta = (GetOptions = "GetCompressionFormatOptions"))
+	FName CompressionFormat = NAME_LZ4;
+
+	/** Store each FName once per cell file instead of once per delta */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "DeltaStore|Config")
+	bool bUseNameTable = true;
+
+	/** Resident cell cache size TrimCache() evicts down to (0 = unbounded) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "DeltaStore|Config", meta = (ClampMin = "0"))
+	int64 CacheBudgetBytes = 0;
+
+	/** Coarsest FWorldCellKey LOD GetCellSummary() aggregates to (applied on Initialize) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "DeltaStore|Config", meta = (ClampMin = "0", ClampMax = "15"))
+	int32 MaxSummaryLOD = 4;
+
+	/** Lossy: store sleeping transform deltas as float location/scale and a 16-bit quaternion */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "DeltaStore|Config")
+	bool bQuantizeSettledTransforms = false;
+
+	/** Lossy: store surface deltas as 24-byte packed records (~0.1cm X/Y, 1ms timestamps) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "DeltaStore|Config")
+	bool bPackSurfaceDeltas = false;
+
+	UFUNCTION()
+	static TArray<FName> GetCompressionFormatOptions() { return { NAME_LZ4, NAME_Oodle, NAME_Zlib }; }
+
+protected:
+	/** Encoder settings for WriteBinary, captured per flush */
+	DeltaCellFormat::FWriteOptions GetWriteOptions() const;
+
+	/** Directory holding a cell's files for the current world */
+	FString GetCellDirectory(const FWorldCellKey& CellKey) const;
+
+	/**
+	 * Read and decode a cell (binary, falling back to legacy JSON). Safe to call from any thread.
+	 * @return Decoded data, or nullptr if no cell file exists or it fails to decode
+	 */
+	static TSharedPtr<FDeltaCellData> ReadCellFile(const FString& CellDir);
+
+	/** Make a cell resident, waiting on a pending load or reading synchronously */
+	void EnsureCellResident(const FWorldCellKey& CellKey) const;
+
+	/** Merge loaded data in front of any deltas appended while the cell was not resident */
+	void MergeLoadedCell(const FWorldCellKey& CellKey, const TSharedPtr<FDeltaCellData>& Loaded);
+
+	/** Merge all background loads that have finished */
+	void ProcessCompletedLoads();
+
+	/** Writable data for a cell, created on demand and cloned if a flush still shares it */
+	FDeltaCellData& GetMutableCell(const FWorldCellKey& CellKey);
+
+	/** Read-only data for a cell, or nullptr */
+	const FDeltaCellData* FindCell(const FWorldCellKey& CellKey) const;
+
+	/** Stamp a cell as most recently used */
+	void TouchCell(const FWorldCellKey& CellKey) const { CellLastUse.Add(CellKey, ++UseClock); }
+
+	/** Queue a cell's byte count for re-accounting (its arrays changed) */
+	void MarkCellBytesStale(const FWorldCellKey& CellKey) const { StaleByteCells.Add(CellKey); }
+
+	/** Bring CachedBytes up to date for cells whose arrays changed */
+	void RefreshCellBytes() const;
+
+	/** Drop a cell's accounting (evicted or reset) */
+	void ForgetCellBytes(const FWorldCellKey& CellKey);
+
+	/** Forget unflushed changes without writing them (stores that never persist) */
+	void DiscardDirtyCells();
+
+	/** Last record index per tile channel for a cell, rebuilt on demand */
+	TMap<uint64, int32>& GetSurfaceFoldIndex(const FWorldCellKey& CellKey, const TArray<FSurfaceTileDelta>& CellDeltas);
+
 	FString CurrentWorldName;
 	FString BaseSaveDirectory;
 	bool bIsInitialized = false;
 
-	// In-memory caches keyed by cell
-	TMap<FWorldCellKey, TArray<FSurfaceTileDelta>> SurfaceDeltas;
-	TMap<FWorldCellKey, TArray<FFractureDelta>> FractureDeltas;
-	TMap<FWorldCellKey, TArray<FTransformDelta>> TransformDeltas;
-	TMap<FWorldCellKey, TArray<FSpawnDelta>> SpawnDeltas;
-	TMap<FWorldCellKey, TArray<FRemoveDelta>> RemoveDeltas;
-	TMap<FWorldCellKey, TArray<FAssemblyDelta>> AssemblyDeltas;
+	/** Cells whose on-disk deltas are merged into the caches below */
+	TSet<FWorldCellKey> ResidentCells;
+
+	/** Background loads launched by PrefetchCells() */
+	TMap<FWorldCellKey, UE::Tasks::TTask<TSharedPtr<FDeltaCellData>>> PendingLoads;
+
+	/**
+	 * In-memory caches keyed by cell. Shared with in-flight flushes; only mutate
+	 * through GetMutableCell().
+	 */
+	TMap<FWorldCellKey, TSharedPtr<FDeltaCellData>> Cells;
+
+	/** Estimate behind GetPendingBytes() */
+	int64 PendingAppendBytes = 0;
+
+	/** Cells cloned because a flush still held them (diagnostics) */
+	int32 CopyOnWriteCount = 0;
+
+	/** LRU clock and per-cell last use; queries are const, so these are mutable */
+	mutable uint64 UseClock = 0;
+	mutable TMap<FWorldCellKey, uint64> CellLastUse;
+
+	/** Byte accounting: per-cell sizes, their sum, and cells to re-measure */
+	mutable TMap<FWorldCellKey, int64> CellBytes;
+	mutable TSet<FWorldCellKey> StaleByteCells;
+	mutable int64 CachedBytes = 0;
+
+	/** PinCell() reference counts */
+	TMap<FWorldCellKey, int32> PinnedCells;
+
+	/** Cells evicted and not yet read back (reload accounting) */
+	TSet<FWorldCellKey> EvictedCells;
+	int32 EvictionCount = 0;
+	int32 ReloadCount = 0;
+
+	/** Flushed-cell summaries; updated by flush workers */
+	TSharedRef<FDeltaSummaryTable, ESPMode::ThreadSafe> SummaryTable;
+
+	/** Serializes flush writes */
+	UE::Tasks::FPipe FlushPipe{ UE_SOURCE_LOCATION };
+
+	/** Most recently queued flush */
+	UE::Tasks::FTask LastFlushTask;
+
+private:
+	/** Cell snapshots for one queued flush */
+	using FFlushBatch = TMap<FWorldCellKey, TSharedPtr<const FDeltaCellData>>;
+
+	/** Shared between the game thread and flush tasks; guarded by Lock */
+	struct FFlushQueueState
+	{
+		mutable FCriticalSection Lock;
+
+		/** Newest queued batch that has not started writing (coalescing target) */
+		TSharedPtr<FFlushBatch, ESPMode::ThreadSafe> OpenBatch;
+
+		int32 QueuedFlushes = 0;
+		int32 CoalescedFlushes = 0;
+		int64 BytesWritten = 0;
+	};
+
+	/** Worker: encode and write a batch of cells and update their summaries, returning bytes written */
+	static int64 WriteCells(const FString& SaveDir, const FFlushBatch& CellsToWrite,
+		const DeltaCellFormat::FWriteOptions& Options, bool bJsonExport, FDeltaSummaryTable& Summaries);
+
+	/** Worker: summarize every LOD 0 cell file under SaveDir and save the table */
+	static void RebuildSummaries(const FString& SaveDir, FDeltaSummaryTable& Summaries);
+
+	TSharedRef<FFlushQueueState, ESPMode::ThreadSafe> FlushQueue;
 	
 	TSet<FWorldCellKey> DirtyCells;
+
+	/** Coalescing lookup: cell -> (tile channel key -> index into Cells[cell]->SurfaceDeltas) */
+	TMap<FWorldCellKey, TMap<uint64, int32>> SurfaceFoldIndex;
 };
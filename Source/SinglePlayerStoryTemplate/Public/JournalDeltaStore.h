@@ -0,0 +1,205 @@
+// Copyright 2026 Threaded Pixel Factory
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * Journal Delta Store - Append-only write-ahead log with background compaction
+ *
+ * Purpose:
+ * IDeltaStore whose Flush() cost scales with the deltas appended since the last
+ * flush rather than with a cell's accumulated history. Suited to high-frequency
+ * deltas (footsteps, snow, wetness) that would otherwise rewrite whole cell files.
+ *
+ * Architecture:
+ * - Appends are applied to the in-memory caches (inherited from UFileDeltaStore)
+ *   and encoded into a pending journal buffer
+ * - Flush() hands the buffer to a worker which appends it to the open segment
+ * - Segments roll over at SegmentSizeLimitBytes
+ * - Once CompactionSegmentThreshold closed segments exist, the compactor folds
+ *   them into per-cell snapshots (the same deltas.bin files UFileDeltaStore reads)
+ *   and deletes them
+ * - All journal I/O and compaction run in order on one UE::Tasks::FPipe;
+ *   FlushAsync() handles are tasks on that pipe
+ * - With bCoalesceSurfaceDeltas the journal still records every delta; folding
+ *   happens in memory and when segments are compacted into snapshots
+ *
+ * File Structure:
+ *   Saved/GameSaveData/[WorldName]/
+ *     ├── journal/
+ *     │     ├── segment_00000003.log   (closed, awaiting compaction)
+ *     │     └── segment_00000004.log   (open)
+ *     └── (X,Y,LODn)/deltas.bin        (compacted snapshots)
+ *
+ * Crash Safety:
+ * - Segment records are decoded sequentially; a torn tail record
+ *   is discarded on recovery, so a crash loses at most the unflushed tail
+ * - Compaction is two-phase: snapshots are staged as .tmp files, a commit marker
+ *   is written, then snapshots are moved into place and segments deleted.
+ *   Initialize() finishes a committed compaction instead of re-folding it.
+ * - Initialize() compacts every segment left over from a previous session
+ *
+ * Residency:
+ * Appends make the target cell resident first. Journaled records for a cell
+ * therefore always sit on top of a loaded snapshot, which keeps compaction of
+ * this session's records from ever being double-counted by a later lazy load.
+ * A lazy load reads only the snapshot, so a journaled cell stays resident until
+ * its last record has been compacted; then it can be evicted like any other.
+ *
+ * Summaries:
+ * GetCellSummary() follows compaction, not Flush(): a cell's summary is updated
+ * when its snapshot is committed. A compaction finished by crash recovery leaves
+ * its cells' summaries as they were until their next compaction.
+ *
+ * Performance:
+ * - Append: O(1) plus a one-time cell load for cold cells
+ * - Flush: O(bytes appended since last flush), one sequential write
+ * - Compaction: O(touched cells), off the game thread
+ *
+ * @see UFileDeltaStore for the snapshot-per-cell store this builds on
+ * @see DeltaCellFormat for record encoding
+ */
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "FileDeltaStore.h"
+#include "Tasks/Pipe.h"
+#include <atomic>
+#include "JournalDeltaStore.generated.h"
+
+/**
+ * Journal-backed delta store for single-player persistence.
+ *
+ * Drop-in replacement for UFileDeltaStore: same queries, same snapshot files,
+ * cheaper flushes.
+ *
+ * Thread Safety:
+ * - Game-thread API like UFileDeltaStore
+ * - Writer state is only touched from tasks on JournalPipe
+ */
+UCLASS(BlueprintType)
+class SINGLEPLAYERSTORYTEMPLATE_API UJournalDeltaStore : public UFileDeltaStore
+{
+	GENERATED_BODY()
+
+public:
+	UJournalDeltaStore();
+
+	// IDeltaStore Interface
+	virtual void AppendSurfaceDelta(const FSurfaceTileDelta& Delta) override;
+	virtual void AppendFractureDelta(const FFractureDelta& Delta) override;
+	virtual void AppendTransformDelta(const FTransformDelta& Delta) override;
+	virtual void AppendSpawnDelta(const FSpawnDelta& Delta) override;
+	virtual void AppendRemoveDelta(const FRemoveDelta& Delta) override;
+	virtual void AppendAssemblyDelta(const FAssemblyDelta& Delta) override;
+
+	virtual void ClearCellDeltas(const FWorldCellKey& CellKey) override;
+
+	/** Also refuses cells with records not yet compacted into their snapshot */
+	virtual bool CanEvictCell(const FWorldCellKey& CellKey) const override;
+
+	// UFileDeltaStore Interface
+	/**
+	 * Queue the pending journal bytes; the handle completes once they are appended
+	 * to a segment. MaxCells is ignored - a journal flush is one sequential write.
+	 */
+	virtual UE::Tasks::FTask FlushAsync(int32 MaxCells = 0) override;
+	virtual void WaitForFlush() override;
+	virtual int64 GetPendingBytes() const override { return PendingJournal.Num(); }
+
+	/**
+	 * Initialize for a world and recover any segments left by a previous session.
+	 * Blocks until recovery compaction finishes.
+	 */
+	virtual bool Initialize(const FString& WorldName) override;
+
+	// UObject Interface
+	virtual void BeginDestroy() override;
+
+	/**
+	 * Close the open segment and fold all closed segments into cell snapshots.
+	 * Runs on the journal pipe after any pending flushes.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "DeltaStore")
+	void Compact();
+
+	/** Block until all queued journal writes and compactions have finished */
+	UFUNCTION(BlueprintCallable, Category = "DeltaStore")
+	void WaitForJournal();
+
+	/** Bytes appended since the last Flush() */
+	UFUNCTION(BlueprintCallable, Category = "DeltaStore")
+	int32 GetPendingJournalBytes() const { return PendingJournal.Num(); }
+
+	//==========================================================================
+	// CONFIGURATION
+	//==========================================================================
+
+	/** Segment size that triggers a roll to a new segment */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "DeltaStore|Config")
+	int32 SegmentSizeLimitBytes = 4 * 1024 * 1024;
+
+	/** Number of closed segments that triggers background compaction */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "DeltaStore|Config")
+	int32 CompactionSegmentThreshold = 4;
+
+private:
+	/** Writer-side state, owned by tasks on JournalPipe */
+	struct FJournalWriterState
+	{
+		FString JournalDir;
+		FString SaveDir;
+		int32 OldestSegmentIndex = 0;
+		int32 OpenSegmentIndex = 0;
+		int64 OpenSegmentBytes = 0;
+		DeltaCellFormat::FWriteOptions SnapshotOptions;
+
+		/** The store's summary table, updated once a compaction commits */
+		TSharedPtr<FDeltaSummaryTable, ESPMode::ThreadSafe> Summaries;
+
+		/** Last flush batch written to a closed segment */
+		uint64 ClosedBatch = 0;
+
+		/** Last flush batch written at all */
+		uint64 WrittenBatch = 0;
+
+		/** Every batch up to this one is in the snapshots (read on the game thread) */
+		std::atomic<uint64> CompactedBatch = 0;
+
+		int32 GetClosedSegmentCount() const { return OpenSegmentIndex - OldestSegmentIndex; }
+	};
+
+	/** Encode a record into PendingJournal */
+	template<typename DeltaType>
+	void AppendJournalRecord(uint8 RecordType, const DeltaType& Delta);
+
+	/** Worker: append flush batch Batch to the open segment, rolling over at SegmentLimit */
+	static void WriteToSegment(FJournalWriterState& State, const TArray<uint8>& Bytes, int32 SegmentLimit, uint64 Batch);
+
+	/** Worker: fold closed segments into snapshots. bIncludeOpen also closes and folds the open segment. */
+	static void CompactSegments(FJournalWriterState& State, bool bIncludeOpen, bool bCoalesceSurface);
+
+	/** Encoded records awaiting the next Flush() */
+	TArray<uint8> PendingJournal;
+
+	/** Cells journaled since Initialize, with the flush batch of their last record */
+	TMap<FWorldCellKey, uint64> JournaledCells;
+
+	/** Flush batches queued since Initialize; pending records belong to the next one */
+	uint64 FlushBatch = 0;
+
+	/** Shared with pipe tasks; never touched on the game thread after Initialize */
+	TSharedPtr<FJournalWriterState, ESPMode::ThreadSafe> WriterState;
+
+	/** Serializes journal writes and compaction */
+	UE::Tasks::FPipe JournalPipe{ UE_SOURCE_LOCATION };
+};
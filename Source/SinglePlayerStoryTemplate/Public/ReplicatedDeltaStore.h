@@ -0,0 +1,80 @@
+// Copyright 2026 Threaded Pixel Factory
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * Replicated Delta Store - Client-side mirror of the server's delta store
+ *
+ * Purpose:
+ * The store a network client owns for its world. Cells arrive from the server
+ * (UDeltaReplicationComponent) as snapshots or batches of new deltas; queries,
+ * surface sampling and delta streaming read them like any other store.
+ *
+ * Authority:
+ * - Nothing is persisted: the server owns the world's history
+ * - Local appends are allowed (prediction) but are replaced by the next snapshot
+ *   of their cell and never flushed
+ * - Replicated cells are never evicted by the LRU cache; the server drops them
+ *   when they leave the client's interest (DropReplicatedCell)
+ *
+ * Files:
+ * BaseSaveDirectory is Saved/GameSaveData/_Replicated so a client never reads
+ * or writes a single-player save of the same map. Cells the server has not sent
+ * yet therefore read as empty.
+ *
+ * @see UServerDeltaStore for the authority side
+ */
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "FileDeltaStore.h"
+#include "ReplicatedDeltaStore.generated.h"
+
+/**
+ * In-memory store filled by delta replication.
+ */
+UCLASS(BlueprintType)
+class SINGLEPLAYERSTORYTEMPLATE_API UReplicatedDeltaStore : public UFileDeltaStore
+{
+	GENERATED_BODY()
+
+public:
+	UReplicatedDeltaStore();
+
+	// UFileDeltaStore Interface
+	/** Discards local changes - the server persists */
+	virtual UE::Tasks::FTask FlushAsync(int32 MaxCells = 0) override;
+	virtual bool CanEvictCell(const FWorldCellKey& CellKey) const override;
+	virtual bool Initialize(const FString& WorldName) override;
+
+	/**
+	 * Apply deltas received from the server.
+	 *
+	 * @param CellKey - Cell the payload belongs to
+	 * @param bSnapshot - Payload is the cell's full state (replaces it); otherwise
+	 *                    deltas appended on the server since the previous payload
+	 * @param Payload - DeltaCellFormat binary cell
+	 * @return false if the payload does not decode (the cell is left unchanged)
+	 */
+	bool ApplyReplicatedCell(const FWorldCellKey& CellKey, bool bSnapshot, const TArray<uint8>& Payload);
+
+	/** Forget a cell the server stopped replicating */
+	void DropReplicatedCell(const FWorldCellKey& CellKey);
+
+	/** Cells currently mirrored from the server */
+	UFUNCTION(BlueprintCallable, Category = "DeltaStore")
+	int32 GetReplicatedCellCount() const { return ReplicatedCells.Num(); }
+
+private:
+	TSet<FWorldCellKey> ReplicatedCells;
+};
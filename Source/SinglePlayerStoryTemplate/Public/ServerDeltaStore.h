@@ -0,0 +1,86 @@
+// Copyright 2026 Threaded Pixel Factory
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * Server Delta Store - Server-authoritative delta store for multiplayer
+ *
+ * Purpose:
+ * The store a listen or dedicated server owns for its world. Persistence is the
+ * journal store's (appends are cheap, segments are written and compacted on a
+ * worker pipe); on top of that every append is also recorded per cell for
+ * replication, so UDeltaReplicationSubsystem can ship batches of new deltas to
+ * interested clients instead of one RPC per delta.
+ *
+ * Replication Log:
+ * - Append*() adds the delta to its cell's pending batch
+ * - ClearCellDeltas() drops the cell's batch and marks it reset; clients holding
+ *   the cell need a fresh snapshot instead of a batch
+ * - TakeReplicationBatches() hands everything over and starts new batches
+ *
+ * Batches are raw appends: clients fold them exactly as the server's caches did,
+ * so coalescing (bCoalesceSurfaceDeltas) stays consistent on both sides.
+ *
+ * Persistence Backend:
+ * Writes go through UJournalDeltaStore's pipe, off the game thread. A database
+ * backend replaces FlushAsync()/Initialize() in a subclass; the replication log
+ * is independent of where deltas are persisted.
+ *
+ * @see UDeltaReplicationSubsystem for interest management and sending
+ * @see UReplicatedDeltaStore for the client side
+ */
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "JournalDeltaStore.h"
+#include "ServerDeltaStore.generated.h"
+
+/**
+ * Journal store that also records appends for network replication.
+ */
+UCLASS(BlueprintType)
+class SINGLEPLAYERSTORYTEMPLATE_API UServerDeltaStore : public UJournalDeltaStore
+{
+	GENERATED_BODY()
+
+public:
+	// IDeltaStore Interface
+	virtual void AppendSurfaceDelta(const FSurfaceTileDelta& Delta) override;
+	virtual void AppendFractureDelta(const FFractureDelta& Delta) override;
+	virtual void AppendTransformDelta(const FTransformDelta& Delta) override;
+	virtual void AppendSpawnDelta(const FSpawnDelta& Delta) override;
+	virtual void AppendRemoveDelta(const FRemoveDelta& Delta) override;
+	virtual void AppendAssemblyDelta(const FAssemblyDelta& Delta) override;
+
+	virtual void ClearCellDeltas(const FWorldCellKey& CellKey) override;
+
+	/** Also discards the replication log of the previous world */
+	virtual bool Initialize(const FString& WorldName) override;
+
+	/**
+	 * Move out the deltas appended since the last call.
+	 *
+	 * @param OutBatches - New deltas per cell, in append order
+	 * @param OutResetCells - Cells cleared since the last call; their batches only
+	 *                        hold deltas appended after the clear
+	 */
+	void TakeReplicationBatches(TMap<FWorldCellKey, FDeltaCellData>& OutBatches, TSet<FWorldCellKey>& OutResetCells);
+
+	/** Cells with deltas waiting for TakeReplicationBatches() */
+	UFUNCTION(BlueprintCallable, Category = "DeltaStore")
+	int32 GetPendingReplicationCellCount() const { return PendingBatches.Num(); }
+
+private:
+	TMap<FWorldCellKey, FDeltaCellData> PendingBatches;
+	TSet<FWorldCellKey> ResetCells;
+};
@@ -5,6 +5,10 @@
 
 #include "CoreMinimal.h"
 #include "Modules/ModuleInterface.h"
+#include "Engine/World.h"
+
+class UCoreDataWarmupSubsystem;
+class UModuleLoaderSubsystem;
 
 /**
  * SinglePlayerStoryTemplate Module
@@ -14,8 +18,15 @@
  * - FileDeltaStore: Local file-based persistence implementing IDeltaStore
  *   Example of storing world state changes (surface deltas, fractures, transforms) to disk
  * 
+ * - JournalDeltaStore: Append-only journal variant of FileDeltaStore
+ *   Flush cost scales with new deltas; segments are compacted into cell snapshots
+ * 
+ * - DeltaStoreSubsystem: Owns the store per game world and auto-flushes it
+ *   on time, dirty-cell, byte-budget and level-transition triggers
+ * 
  * - SpecPackLoader: JSON-based spec loading for runtime-first architecture
- *   Example of loading SurfaceSpec, MediumSpec, BiomeSpec, etc. from JSON files
+ *   Example of loading SurfaceSpec, MediumSpec, BiomeSpec, etc. from JSON files;
+ *   the module warms the pack cache at startup and loads the packs into every game world
  * 
  * - Game-specific systems and initialization patterns
  * 
@@ -25,7 +36,7 @@
  * 
  * Data Flow:
  *   SpecPacks/*.json → SpecPackLoader → Runtime Registries → Subsystems
- *   World Changes → IDeltaStore → FileDeltaStore → SaveData/*.json
+ *   World Changes → IDeltaStore → FileDeltaStore → GameSaveData/*/deltas.bin
  */
 class FSinglePlayerStoryTemplate : public IModuleInterface
 {
@@ -42,4 +53,25 @@ public:
 
 	virtual void StartupModule() override;
 	virtual void ShutdownModule() override;
+
+private:
+	/** Loads the spec packs into each game world's registries as it initializes (decoded from the warmed cache) */
+	static void HandlePostWorldInitialization(UWorld* World, const UWorld::InitializationValues IVS);
+
+	/** Adds the spec pack cache warm-up to the startup loads */
+	static void AddWarmupTasks(UCoreDataWarmupSubsystem& Warmup);
+
+	/** Re-warms the spec pack cache while an interplanetary destination preloads */
+	static void HandleTravelPreload(FName Map);
+
+	/** Adds the spec pack cache warm-up as a launcher preload task, so the module's world opens with packs parsed */
+	static void HandleGatherModulePreloads(const FString& ModuleName, UModuleLoaderSubsystem& Loader);
+
+	FDelegateHandle GatherWarmupTasksHandle;
+
+	FDelegateHandle TravelPreloadHandle;
+
+	FDelegateHandle GatherModulePreloadsHandle;
+
+	FDelegateHandle PostWorldInitializationHandle;
 };
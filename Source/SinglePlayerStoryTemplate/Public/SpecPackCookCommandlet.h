@@ -0,0 +1,43 @@
+// Copyright 2026 Threaded Pixel Factory
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "SpecPackCookCommandlet.generated.h"
+
+/**
+ * Validates SpecPack JSON and writes the cooked bundle shipping builds load.
+ * 
+ * Usage:
+ *   UnrealEditor-Cmd UETPFCore.uproject -run=SpecPackCook [-Source=<dir>] [-Output=<file>]
+ * 
+ * - Source defaults to USpecPackLoader::GetDefaultSpecPackDirectory; packs are cooked
+ *   in load (sorted path) order
+ * - Output defaults to Content/SpecPacks/SpecPacks.tpfspec, staged by DefaultGame.ini
+ * - Any pack that fails to read, parse or validate fails the cook and nothing is written
+ * - No packs at all is a warning: nothing is written and the cook continues
+ * 
+ * @see SpecPackFormat for the bundle layout
+ */
+UCLASS()
+class SINGLEPLAYERSTORYTEMPLATE_API USpecPackCookCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	USpecPackCookCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+};
@@ -0,0 +1,129 @@
+// Copyright 2026 Threaded Pixel Factory
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * SpecPack Format - Parsed pack data, JSON parsing and the binary pack format
+ *
+ * Purpose:
+ * Splits SpecPack loading into a thread-safe part (read bytes, hash, parse or
+ * decode into plain arrays) and a registration part that runs on the caller.
+ * JSON stays the authoring format; the binary format serves two uses:
+ * - Pack cache: one pack keyed by the SHA1 of its JSON bytes, so unchanged
+ *   packs skip the JSON DOM on later runs
+ * - Cooked bundle: every pack of a directory, validated and written by
+ *   USpecPackCookCommandlet; shipping builds load it with one read
+ *
+ * Binary Layout (little endian, via FMemoryWriter/FMemoryReader):
+ *   Header:
+ *     uint32  Magic        'TPFP'
+ *     uint16  Version      SpecPackFormat::CurrentVersion
+ *     uint16  Flags        SpecPackFormat::Flag* bits
+ *     int32   PackCount
+ *   Name table (FlagNameTable only):
+ *     int32   NameCount
+ *     FString Names[NameCount]  Every FName in the packs is an int32 index
+ *   Packs (PackCount times):
+ *     FString ContentHash  SHA1 of the JSON the pack was built from
+ *     FString PackId
+ *     int32   Version
+ *     FString EngineCompat
+ *     int32   SpecTypeCount, FString SpecTypes[SpecTypeCount]
+ *     int32   SurfaceCount, SurfaceCount surface records
+ *     int32   MediumCount, MediumCount medium records
+ *     int32   BiomeCount, BiomeCount biome records
+ *
+ * Cache Lookup (see USpecPackLoader):
+ * - Saved/SpecPackCache/<ContentHash>.tpfspec holds exactly one pack
+ * - A cache whose version or hash does not match is ignored and rebuilt
+ *
+ * Cooked Bundle:
+ * - <SpecPack directory>/SpecPacks.tpfspec, packs in load (path) order
+ * - Packs were validated at cook time; readers trust them
+ *
+ * Compatibility:
+ * - Readers reject files with a different Version; caches rebuild, bundles re-cook
+ *
+ * @see USpecPackLoader for the loader using this format
+ * @see USpecPackCookCommandlet for the cook step
+ */
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "SpecTypes.h"
+#include "SpecPackLoader.h"
+#include "Subsystems/BiomeSubsystem.h"
+
+class FJsonObject;
+
+/**
+ * One SpecPack as plain arrays; each spec's ID field holds its ID.
+ * Safe to build on a worker and register on the game thread.
+ */
+struct FParsedSpecPack
+{
+	FSpecPackManifest Manifest;
+	TArray<FRuntimeSurfaceSpec> SurfaceSpecs;
+	TArray<FRuntimeMediumSpec> MediumSpecs;
+	TArray<FBiomeSpec> BiomeSpecs;
+};
+
+namespace SpecPackFormat
+{
+	/** 'TPFP' */
+	constexpr uint32 Magic = 0x50465054;
+
+	/** Bump when the record layout changes; older caches are rebuilt */
+	constexpr uint16 CurrentVersion = 2;
+
+	/** Header flags */
+	constexpr uint16 FlagNameTable = 1 << 0;
+
+	/** Binary cache / cooked bundle extension */
+	inline const TCHAR* CacheExtension = TEXT("tpfspec");
+
+	/** Cooked bundle file name inside a SpecPack directory */
+	inline const TCHAR* CookedFileName = TEXT("SpecPacks.tpfspec");
+
+	/** SHA1 of a pack's file bytes, as hex (the pack's ContentHash) */
+	SINGLEPLAYERSTORYTEMPLATE_API FString HashBytes(TConstArrayView<uint8> Bytes);
+
+	/** Parse pack file bytes into a JSON DOM */
+	SINGLEPLAYERSTORYTEMPLATE_API TSharedPtr<FJsonObject> ParseJsonBytes(TConstArrayView<uint8> Bytes);
+
+	/** Check required fields (pack_id, version) and spec array types */
+	SINGLEPLAYERSTORYTEMPLATE_API bool Validate(const FJsonObject& RootObject, FString& OutErrorMessage);
+
+	/**
+	 * Read the manifest and spec arrays from a parsed pack.
+	 * Entries without an 'id' are skipped with a warning.
+	 */
+	SINGLEPLAYERSTORYTEMPLATE_API void ReadJson(const FJsonObject& RootObject, FParsedSpecPack& OutPack);
+
+	/**
+	 * Encode packs (each with Manifest.ContentHash set).
+	 * @param bNameTable - Store each FName once for the whole file
+	 */
+	SINGLEPLAYERSTORYTEMPLATE_API void WriteBinary(TConstArrayView<FParsedSpecPack> Packs, TArray<uint8>& OutBytes, bool bNameTable = true);
+
+	/**
+	 * Decode packs, in the order they were written.
+	 * @return false on bad magic, unsupported version or truncated data
+	 */
+	SINGLEPLAYERSTORYTEMPLATE_API bool ReadBinary(TConstArrayView<uint8> Bytes, TArray<FParsedSpecPack>& OutPacks);
+
+	/** Per-record (de)serializers */
+	SINGLEPLAYERSTORYTEMPLATE_API void SerializeRecord(FArchive& Ar, FRuntimeSurfaceSpec& Spec);
+	SINGLEPLAYERSTORYTEMPLATE_API void SerializeRecord(FArchive& Ar, FRuntimeMediumSpec& Spec);
+	SINGLEPLAYERSTORYTEMPLATE_API void SerializeRecord(FArchive& Ar, FBiomeSpec& Spec);
+}
@@ -0,0 +1,92 @@
+// Copyright 2026 Threaded Pixel Factory
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/**
+ * SpecPack Hot Reload Subsystem - Live SpecPack edits during PIE
+ *
+ * Purpose:
+ * Watches the SpecPack directory and pushes edited specs into the running world
+ * without restarting PIE or clearing the runtime registries.
+ *
+ * Reload Flow:
+ * 1. The directory watcher reports changed .json files; changes are debounced
+ *    (editors often write a file several times)
+ * 2. Only the changed files are re-read (USpecPackLoader::ReadSpecPackFile)
+ * 3. All packs are merged in load (sorted path) order - later packs override earlier
+ *    ones exactly as in LoadSpecPacksFromDirectory
+ * 4. The merged sets go to UpdateRuntimeSurfaceSpecs / UpdateRuntimeMediumSpecs /
+ *    UpdateBiomeSpecs, which register only entries whose Version or fields changed
+ *
+ * Handles stay valid (changed entries are overwritten in place), and only the
+ * dependent caches go: surface states resolved to a changed spec, the environment
+ * query snapshot, and the biome rule table.
+ *
+ * Specs deleted from a pack keep their last value until the registries are
+ * cleared, so outstanding handles never dangle.
+ *
+ * Editor builds only; the subsystem is not created in cooked games.
+ *
+ * @see USpecPackLoader for the regular load path
+ */
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "SpecPackFormat.h"
+#include "SpecPackHotReloadSubsystem.generated.h"
+
+struct FFileChangeData;
+
+UCLASS()
+class SINGLEPLAYERSTORYTEMPLATE_API USpecPackHotReloadSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+
+	/** Re-read every pack and push whatever differs from the registries */
+	UFUNCTION(BlueprintCallable, Category = "SpecPack")
+	void ReloadAll();
+
+	/** Directory to watch (defaults to USpecPackLoader::GetDefaultSpecPackDirectory) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SpecPack")
+	FString WatchDirectory;
+
+	/** Quiet time after the last change before reloading */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SpecPack", meta = (ClampMin = "0"))
+	float DebounceSeconds = 0.25f;
+
+private:
+	void HandleDirectoryChanged(const TArray<FFileChangeData>& Changes);
+
+	/** Re-read the pending files, merge, and update the registries */
+	void ApplyPendingChanges();
+
+	/** Re-read one pack; false keeps its previous contents */
+	bool RereadPack(const FString& FilePath);
+
+	static bool IsSpecPackFile(const FString& FilePath);
+
+	/** Last good parse of every pack under WatchDirectory */
+	TMap<FString, FParsedSpecPack> Packs;
+
+	/** Files changed since the last reload */
+	TSet<FString> PendingFiles;
+
+	FTimerHandle DebounceTimer;
+	FDelegateHandle WatcherHandle;
+};
@@ -71,6 +71,26 @@
  * - Later packs can override earlier specs by ID
  * - Validation ensures no breaking changes
  * 
+ * Batch Loading (LoadSpecPacks / LoadSpecPacksFromDirectory):
+ * - Each pack file is read once; hashing, validation and parsing reuse those bytes
+ * - Packs are read and parsed in parallel on worker threads, then registered on the
+ *   calling thread in path order, so overrides stay deterministic
+ * - Parsed packs are cached in Saved/SpecPackCache keyed by content hash; an
+ *   unchanged pack is decoded from the binary cache instead of parsed as JSON
+ * - At startup the module warms that cache for Content/SpecPacks as a core data
+ *   warm-up task (UCoreDataWarmupSubsystem), in parallel with the other loads
+ * 
+ * Cooked SpecPacks (see USpecPackCookCommandlet):
+ * - The cook validates every pack of the default directory and writes
+ *   Content/SpecPacks/SpecPacks.tpfspec, which packaged builds stage as a loose file
+ * - With bPreferCookedBundle (default in shipping builds), LoadSpecPacksFromDirectory
+ *   loads that bundle with one read and no JSON parsing; JSON stays the authoring format
+ * - JSON packs in the directory newer than the bundle (edits, mods) load after it,
+ *   so they override the cooked specs instead of being shadowed by them
+ * 
+ * Biome specs register with the UBiomeSubsystem of the loader's world (its outer);
+ * surface and medium registration is still log-only.
+ * 
  * @see FRuntimeSurfaceSpec for spec data format
  * @see USurfaceQuerySubsystem for spec registration
  * @see UEnvironmentSubsystem for medium spec registration
@@ -82,6 +102,9 @@
 #include "SpecTypes.h"
 #include "SpecPackLoader.generated.h"
 
+struct FParsedSpecPack;
+struct FBiomeSpec;
+
 /**
  * Manifest entry for a SpecPack.
  * Tracks version, hash, and contents for validation and caching.
@@ -141,6 +164,10 @@ struct SINGLEPLAYERSTORYTEMPLATE_API FSpecPackLoadResult
 
 	UPROPERTY(BlueprintReadOnly, Category = "SpecPack")
 	int32 BiomeSpecsLoaded = 0;
+
+	/** Decoded from the binary pack cache rather than parsed from JSON */
+	UPROPERTY(BlueprintReadOnly, Category = "SpecPack")
+	bool bFromCache = false;
 };
 
 /**
@@ -215,11 +242,49 @@ public:
 	FSpecPackLoadResult LoadSpecPack(const FString& FilePath);
 
 	/**
-	 * Load all SpecPacks from a directory.
+	 * Load several SpecPacks.
+	 * Files are read, hashed and parsed (or decoded from the pack cache) in parallel;
+	 * specs are registered on the calling thread in FilePaths order.
+	 * 
+	 * @return One result per path, in FilePaths order
+	 */
+	UFUNCTION(BlueprintCallable, Category = "SpecPack")
+	TArray<FSpecPackLoadResult> LoadSpecPacks(const TArray<FString>& FilePaths);
+
+	/**
+	 * Load all SpecPacks from a directory (recursive, sorted by path).
 	 */
 	UFUNCTION(BlueprintCallable, Category = "SpecPack")
 	TArray<FSpecPackLoadResult> LoadSpecPacksFromDirectory(const FString& DirectoryPath);
 
+	/**
+	 * Load every pack of a cooked bundle (SpecPacks.tpfspec), in cooked order.
+	 * Manifests are cached by PackId since the source paths are not cooked.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "SpecPack")
+	TArray<FSpecPackLoadResult> LoadCookedSpecPacks(const FString& BundlePath);
+
+	/** SpecPack JSON files under a directory, in load (sorted path) order */
+	static TArray<FString> FindSpecPackFiles(const FString& DirectoryPath);
+
+	/**
+	 * Where the packs live: Content/SpecPacks (staged with packaged builds, mods go
+	 * there) when it has JSON packs or on a packaged build, else the plugin's
+	 * Source/UETPFCore/Resources/SpecPacks in a source tree.
+	 */
+	static FString GetDefaultSpecPackDirectory();
+
+	/** The cooked bundle a LoadSpecPacksFromDirectory prefers: always under Content/SpecPacks */
+	static FString GetCookedBundlePath();
+
+	/**
+	 * Fill Saved/SpecPackCache for every pack under a directory on worker threads,
+	 * registering nothing, so the first LoadSpecPacksFromDirectory decodes instead
+	 * of parsing. OnDone runs on the game thread. With the cooked bundle in use only
+	 * the packs newer than it are warmed; skipped (OnDone right away) with the cache off.
+	 */
+	static void WarmSpecPackCacheAsync(const FString& DirectoryPath, FSimpleDelegate OnDone);
+
 	/**
 	 * Load the default embedded SpecPack.
 	 */
@@ -244,26 +309,50 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "SpecPack")
 	bool GetManifest(const FString& FilePath, FSpecPackManifest& OutManifest) const;
 
-protected:
-	/** Parse SurfaceSpec entries from JSON */
-	int32 ParseSurfaceSpecs(const TSharedPtr<FJsonObject>& RootObject);
+	/** Decode unchanged packs from Saved/SpecPackCache instead of parsing their JSON */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SpecPack")
+	bool bUseBinaryCache = true;
+
+	/** Run ValidateSpecPack's checks on the loaded bytes and reject packs that fail */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SpecPack")
+	bool bValidateOnLoad = false;
+
+	/** LoadSpecPacksFromDirectory uses the cooked bundle when present, plus the JSON packs newer than it */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SpecPack")
+	bool bPreferCookedBundle = false;
 
-	/** Parse MediumSpec entries from JSON */
-	int32 ParseMediumSpecs(const TSharedPtr<FJsonObject>& RootObject);
+	/** Directory holding the binary pack cache */
+	static FString GetCacheDirectory();
 
-	/** Parse BiomeSpec entries from JSON */
-	int32 ParseBiomeSpecs(const TSharedPtr<FJsonObject>& RootObject);
+	/**
+	 * Read one pack without registering it. Thread-safe.
+	 * One file read and one hash, then either a cache decode or a JSON parse.
+	 * Only packs that pass validation are cached, so a cache hit needs no re-validation.
+	 * 
+	 * @return false (with OutResult.ErrorMessage) if the pack could not be read, parsed or validated
+	 */
+	static bool ReadSpecPackFile(const FString& FilePath, bool bUseCache, bool bValidate, FParsedSpecPack& OutPack, FSpecPackLoadResult& OutResult);
 
-	/** Parse manifest from JSON */
-	bool ParseManifest(const TSharedPtr<FJsonObject>& RootObject, FSpecPackManifest& OutManifest);
+protected:
+	/** Register every spec of a parsed pack and fill in the result counts */
+	void RegisterParsedPack(const FParsedSpecPack& Pack, FSpecPackLoadResult& OutResult);
 
-	/** Register a SurfaceSpec with the runtime registry */
+	/** Register a SurfaceSpec with the loader world's USurfaceQuerySubsystem */
 	void RegisterSurfaceSpec(const FSurfaceSpecId& Id, const FRuntimeSurfaceSpec& Spec);
 
-	/** Register a MediumSpec with the runtime registry */
+	/** Register a MediumSpec with the loader world's UEnvironmentSubsystem */
 	void RegisterMediumSpec(const FMediumSpecId& Id, const FRuntimeMediumSpec & Spec);
 
+	/** Register a BiomeSpec with the loader world's UBiomeSubsystem */
+	void RegisterBiomeSpec(const FBiomeSpec& Spec);
+
 private:
+	/**
+	 * The JSON packs a directory load parses: all of them, or when the cooked bundle
+	 * is used (bPreferBundle and it exists; bOutUseBundle) those newer than it.
+	 */
+	static TArray<FString> FindPacksToParse(const FString& DirectoryPath, bool bPreferBundle, bool& bOutUseBundle);
+
 	/** Default SpecPack path (embedded in build) */
 	FString DefaultSpecPackPath;
 
@@ -21,7 +21,14 @@ public class SinglePlayerStoryTemplate : ModuleRules
 		
 		PrivateDependencyModuleNames.AddRange(new string[] { 
 			"InputCore",
-			"EnhancedInput"
+			"EnhancedInput",
+			"GameLauncher"         // OnGatherModulePreloads for the SpecPack preload task
 		});
+
+		// SpecPack hot reload (editor only)
+		if (Target.bBuildEditor)
+		{
+			PrivateDependencyModuleNames.Add("DirectoryWatcher");
+		}
 	}
 }
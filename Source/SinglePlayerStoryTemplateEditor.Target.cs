@@ -10,6 +10,6 @@ public class SinglePlayerStoryTemplateEditorTarget : TargetRules
 		Type = TargetType.Editor;
 		DefaultBuildSettings = BuildSettingsVersion.V6;
 		IncludeOrderVersion = EngineIncludeOrderVersion.Unreal5_7;
-		ExtraModuleNames.AddRange( new string[] { "UETPFCore", "GameLauncher", "SinglePlayerStoryTemplate" } );
+		ExtraModuleNames.AddRange( new string[] { "UETPFCore", "UETPFCoreEditor", "GameLauncher", "SinglePlayerStoryTemplate" } );
 	}
 }
@@ -0,0 +1,449 @@
+// Copyright 2026 Threaded Pixel Factory
+// Licensed under the Apache License, Version 2.0 (the "License");
+// SPDX-License-Identifier: Apache-2.0
+
+/**
+ * Core Stress Benchmark - Development console command
+ *
+ * Usage (console or -ExecCmds, non-shipping builds, in a game world):
+ *   TPF.Core.StressBenchmark [Volumes] [Bodies] [BiomeSpecs] [Frames] [exit]
+ *
+ * Builds a synthetic stress scene in the current world:
+ * - Volumes: water environment volumes on a grid (default 256)
+ * - Bodies: simulated spheres dropped through them and registered with
+ *   UPhysicsIntegrationSubsystem (default 1000)
+ * - BiomeSpecs: rule-based biome specs (default 32)
+ * - Full star catalog reload
+ *
+ * Then runs Frames frames (default 600). For every frame it records:
+ * - Frame time
+ * - UPhysicsIntegrationSubsystem tick cost
+ * - One batched environment query at every body
+ * - 256 biome queries
+ *
+ * At the end it writes mean/p50/p95/max per subsystem, plus memory before,
+ * after setup and at the end, to Saved/Profiling/TPFCoreStress/<timestamp>.json
+ * so runs from different builds can be diffed. With "exit" the engine quits after
+ * writing, for unattended runs:
+ *   -ExecCmds="TPF.Core.StressBenchmark 256 1000 32 600 exit"
+ *
+ * Spawned actors are destroyed and bodies unregistered afterwards. Biome and
+ * medium specs stay registered (there is no unregister API), so run it in a
+ * throwaway session.
+ */
+
+#include "CoreMinimal.h"
+
+#if !UE_BUILD_SHIPPING
+
+#include "Subsystems/EnvironmentSubsystem.h"
+#include "Subsystems/PhysicsIntegrationSubsystem.h"
+#include "Subsystems/BiomeSubsystem.h"
+#include "Space/Subsystems/StarCatalogSubsystem.h"
+#include "SpecTypes.h"
+#include "Components/StaticMeshComponent.h"
+#include "Engine/StaticMesh.h"
+#include "Engine/StaticMeshActor.h"
+#include "Engine/GameInstance.h"
+#include "Engine/World.h"
+#include "Containers/Ticker.h"
+#include "Dom/JsonObject.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformMemory.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/App.h"
+#include "Misc/DateTime.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+#include "UObject/Package.h"
+
+namespace
+{
+	constexpr int32 BiomeQueriesPerFrame = 256;
+	constexpr float VolumeSpacing = 2000.0f;
+	constexpr float VolumeHalfExtent = 800.0f;
+	const TCHAR* StressMediumId = TEXT("_Stress_Water");
+
+	struct FStressConfig
+	{
+		int32 NumVolumes = 256;
+		int32 NumBodies = 1000;
+		int32 NumBiomeSpecs = 32;
+		int32 NumFrames = 600;
+		bool bExitWhenDone = false;
+	};
+
+	/** Per-frame samples for one measured system, in milliseconds */
+	struct FStressSeries
+	{
+		TArray<double> Samples;
+
+		TSharedRef<FJsonObject> Summarize() const
+		{
+			TArray<double> Sorted = Samples;
+			Sorted.Sort();
+
+			double Sum = 0.0;
+			for (double Sample : Sorted)
+			{
+				Sum += Sample;
+			}
+
+			auto Percentile = [&Sorted](double P)
+			{
+				return Sorted.Num() > 0 ? Sorted[FMath::Clamp(int32(P * (Sorted.Num() - 1)), 0, Sorted.Num() - 1)] : 0.0;
+			};
+
+			TSharedRef<FJsonObject> Json = MakeShared<FJsonObject>();
+			Json->SetNumberField(TEXT("mean_ms"), Sorted.Num() > 0 ? Sum / Sorted.Num() : 0.0);
+			Json->SetNumberField(TEXT("p50_ms"), Percentile(0.5));
+			Json->SetNumberField(TEXT("p95_ms"), Percentile(0.95));
+			Json->SetNumberField(TEXT("max_ms"), Sorted.Num() > 0 ? Sorted.Last() : 0.0);
+			return Json;
+		}
+	};
+
+	struct FStressRun
+	{
+		FStressConfig Config;
+		TWeakObjectPtr<UWorld> World;
+		TArray<TWeakObjectPtr<AActor>> SpawnedActors;
+		TArray<TWeakObjectPtr<UPrimitiveComponent>> Bodies;
+		TArray<FVector> BiomeSamplePoints;
+
+		int32 FramesRun = 0;
+		double LastFrameTime = 0.0;
+		double SetupSeconds = 0.0;
+		double StarCatalogLoadSeconds = 0.0;
+		int32 StarCount = 0;
+		uint64 MemoryBeforeSetup = 0;
+		uint64 MemoryAfterSetup = 0;
+
+		FStressSeries FrameSeries;
+		FStressSeries PhysicsSeries;
+		FStressSeries EnvironmentSeries;
+		FStressSeries BiomeSeries;
+		TArray<double> BodiesServiced;
+
+		FTSTicker::FDelegateHandle TickerHandle;
+	};
+
+	TSharedPtr<FStressRun> ActiveStressRun;
+
+	uint64 UsedPhysicalMemory()
+	{
+		return FPlatformMemory::GetStats().UsedPhysical;
+	}
+
+	/** Side length of the smallest square grid holding Count items */
+	int32 GridSide(int32 Count)
+	{
+		return FMath::Max(1, FMath::CeilToInt(FMath::Sqrt(float(Count))));
+	}
+
+	void SetupStressScene(FStressRun& Run, UWorld& World)
+	{
+		const double Start = FPlatformTime::Seconds();
+		Run.MemoryBeforeSetup = UsedPhysicalMemory();
+
+		UEnvironmentSubsystem* Environment = World.GetSubsystem<UEnvironmentSubsystem>();
+		UPhysicsIntegrationSubsystem* Physics = World.GetSubsystem<UPhysicsIntegrationSubsystem>();
+		UBiomeSubsystem* Biomes = World.GetSubsystem<UBiomeSubsystem>();
+
+		// Environment volumes: one host actor, water boxes on a grid
+		if (Environment)
+		{
+			UMediumSpec* Water = NewObject<UMediumSpec>(GetTransientPackage());
+			Water->Density = 1000.0f;
+			Environment->RegisterMediumSpec(FMediumSpecId(StressMediumId), Water);
+
+			AActor* VolumeHost = World.SpawnActor<AActor>();
+			USceneComponent* Root = NewObject<USceneComponent>(VolumeHost);
+			VolumeHost->SetRootComponent(Root);
+			Root->RegisterComponent();
+			Run.SpawnedActors.Add(VolumeHost);
+
+			const int32 Side = GridSide(Run.Config.NumVolumes);
+			for (int32 i = 0; i < Run.Config.NumVolumes; i++)
+			{
+				UEnvironmentVolumeComponent* Volume = NewObject<UEnvironmentVolumeComponent>(VolumeHost);
+				Volume->MediumSpecId = FMediumSpecId(StressMediumId);
+				Volume->Priority = i % 4;
+				Volume->SetBoxExtent(FVector(VolumeHalfExtent));
+				Volume->SetupAttachment(Root);
+				Volume->SetWorldLocation(FVector((i % Side) * VolumeSpacing, (i / Side) * VolumeSpacing, 0.0f));
+				Volume->RegisterComponent();
+			}
+		}
+
+		// Bodies: spheres dropped across the volume grid so they stay awake in water and air
+		UStaticMesh* Sphere = LoadObject<UStaticMesh>(nullptr, TEXT("/Engine/BasicShapes/Sphere.Sphere"));
+		if (Physics && Sphere)
+		{
+			const int32 VolumeSide = GridSide(Run.Config.NumVolumes);
+			FRandomStream Random(1234);
+			for (int32 i = 0; i < Run.Config.NumBodies; i++)
+			{
+				const FVector Location(Random.FRandRange(0.0f, VolumeSide * VolumeSpacing),
+					Random.FRandRange(0.0f, VolumeSide * VolumeSpacing), Random.FRandRange(0.0f, 5000.0f));
+
+				AStaticMeshActor* Actor = World.SpawnActor<AStaticMeshActor>(Location, FRotator::ZeroRotator);
+				if (!Actor)
+				{
+					continue;
+				}
+
+				UStaticMeshComponent* Mesh = Actor->GetStaticMeshComponent();
+				Mesh->SetMobility(EComponentMobility::Movable);
+				Mesh->SetStaticMesh(Sphere);
+				Mesh->SetSimulatePhysics(true);
+				Mesh->SetPhysicsLinearVelocity(Random.VRand() * 500.0f);
+				Physics->RegisterPhysicsBody(Mesh);
+
+				Run.SpawnedActors.Add(Actor);
+				Run.Bodies.Add(Mesh);
+			}
+		}
+
+		// Biome specs: altitude bands so rule resolution has to walk the list
+		if (Biomes)
+		{
+			for (int32 i = 0; i < Run.Config.NumBiomeSpecs; i++)
+			{
+				FBiomeSpec Spec;
+				Spec.BiomeId = FBiomeId(*FString::Printf(TEXT("_Stress_Biome_%d"), i));
+				Spec.AltitudeRange = FVector2D(i * 500.0f, (i + 1) * 500.0f);
+				Biomes->RegisterBiomeSpec(Spec);
+			}
+
+			FRandomStream Random(5678);
+			for (int32 i = 0; i < BiomeQueriesPerFrame; i++)
+			{
+				Run.BiomeSamplePoints.Add(FVector(Random.FRandRange(-50000.0f, 50000.0f),
+					Random.FRandRange(-50000.0f, 50000.0f), Random.FRandRange(0.0f, Run.Config.NumBiomeSpecs * 500.0f)));
+			}
+		}
+
+		// Full star catalog, from disk
+		if (UGameInstance* GameInstance = World.GetGameInstance())
+		{
+			if (UStarCatalogSubsystem* Catalog = GameInstance->GetSubsystem<UStarCatalogSubsystem>())
+			{
+				const double CatalogStart = FPlatformTime::Seconds();
+				Catalog->Reload();
+				Run.StarCatalogLoadSeconds = FPlatformTime::Seconds() - CatalogStart;
+				Run.StarCount = Catalog->GetStarCount();
+			}
+		}
+
+		Run.SetupSeconds = FPlatformTime::Seconds() - Start;
+		Run.MemoryAfterSetup = UsedPhysicalMemory();
+	}
+
+	void SampleStressFrame(FStressRun& Run, UWorld& World)
+	{
+		const double Now = FPlatformTime::Seconds();
+		if (Run.LastFrameTime > 0.0)
+		{
+			Run.FrameSeries.Samples.Add((Now - Run.LastFrameTime) * 1e3);
+		}
+		Run.LastFrameTime = Now;
+
+		// The physics tick has already run this frame; read its cost
+		if (const UPhysicsIntegrationSubsystem* Physics = World.GetSubsystem<UPhysicsIntegrationSubsystem>())
+		{
+			Run.PhysicsSeries.Samples.Add(Physics->GetLastTickSeconds() * 1e3);
+			Run.BodiesServiced.Add(Physics->GetBodiesServicedLastFrame());
+		}
+
+		if (const UEnvironmentSubsystem* Environment = World.GetSubsystem<UEnvironmentSubsystem>())
+		{
+			TArray<FVector> Locations;
+			Locations.Reserve(Run.Bodies.Num());
+			for (const TWeakObjectPtr<UPrimitiveComponent>& Body : Run.Bodies)
+			{
+				if (const UPrimitiveComponent* Component = Body.Get())
+				{
+					Locations.Add(Component->GetComponentLocation());
+				}
+			}
+
+			TArray<FEnvironmentContext> Contexts;
+			Contexts.SetNum(Locations.Num());
+			const double Start = FPlatformTime::Seconds();
+			Environment->GetEnvironmentAtLocations(Locations, Contexts);
+			Run.EnvironmentSeries.Samples.Add((FPlatformTime::Seconds() - Start) * 1e3);
+		}
+
+		if (const UBiomeSubsystem* Biomes = World.GetSubsystem<UBiomeSubsystem>())
+		{
+			const double Start = FPlatformTime::Seconds();
+			for (const FVector& Point : Run.BiomeSamplePoints)
+			{
+				Biomes->GetBiomeAtLocation(Point);
+			}
+			Run.BiomeSeries.Samples.Add((FPlatformTime::Seconds() - Start) * 1e3);
+		}
+	}
+
+	void WriteStressReport(const FStressRun& Run)
+	{
+		TSharedRef<FJsonObject> Root = MakeShared<FJsonObject>();
+
+		TSharedRef<FJsonObject> Config = MakeShared<FJsonObject>();
+		Config->SetNumberField(TEXT("volumes"), Run.Config.NumVolumes);
+		Config->SetNumberField(TEXT("bodies"), Run.Bodies.Num());
+		Config->SetNumberField(TEXT("biome_specs"), Run.Config.NumBiomeSpecs);
+		Config->SetNumberField(TEXT("frames"), Run.FramesRun);
+		Root->SetObjectField(TEXT("config"), Config);
+
+		Root->SetStringField(TEXT("build_version"), FApp::GetBuildVersion());
+		Root->SetStringField(TEXT("build_configuration"), LexToString(FApp::GetBuildConfiguration()));
+		Root->SetStringField(TEXT("timestamp"), FDateTime::UtcNow().ToIso8601());
+
+		TSharedRef<FJsonObject> Setup = MakeShared<FJsonObject>();
+		Setup->SetNumberField(TEXT("setup_ms"), Run.SetupSeconds * 1e3);
+		Setup->SetNumberField(TEXT("star_catalog_load_ms"), Run.StarCatalogLoadSeconds * 1e3);
+		Setup->SetNumberField(TEXT("star_count"), Run.StarCount);
+		Root->SetObjectField(TEXT("setup"), Setup);
+
+		TSharedRef<FJsonObject> Frame = MakeShared<FJsonObject>();
+		Frame->SetObjectField(TEXT("frame"), Run.FrameSeries.Summarize());
+		Frame->SetObjectField(TEXT("physics_integration_tick"), Run.PhysicsSeries.Summarize());
+		Frame->SetObjectField(TEXT("environment_batch_query"), Run.EnvironmentSeries.Summarize());
+		Frame->SetObjectField(TEXT("biome_queries"), Run.BiomeSeries.Summarize());
+		Root->SetObjectField(TEXT("per_frame"), Frame);
+
+		double ServicedSum = 0.0;
+		for (double Serviced : Run.BodiesServiced)
+		{
+			ServicedSum += Serviced;
+		}
+		Root->SetNumberField(TEXT("mean_bodies_serviced"), Run.BodiesServiced.Num() > 0 ? ServicedSum / Run.BodiesServiced.Num() : 0.0);
+
+		TSharedRef<FJsonObject> Memory = MakeShared<FJsonObject>();
+		Memory->SetNumberField(TEXT("used_physical_before_setup"), double(Run.MemoryBeforeSetup));
+		Memory->SetNumberField(TEXT("used_physical_after_setup"), double(Run.MemoryAfterSetup));
+		Memory->SetNumberField(TEXT("used_physical_end"), double(UsedPhysicalMemory()));
+		Root->SetObjectField(TEXT("memory_bytes"), Memory);
+
+		FString Output;
+		const TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&Output);
+		FJsonSerializer::Serialize(Root, Writer);
+
+		const FString Path = FPaths::ProfilingDir() / TEXT("TPFCoreStress")
+			/ FDateTime::Now().ToString(TEXT("%Y%m%d_%H%M%S")) + TEXT(".json");
+		if (FFileHelper::SaveStringToFile(Output, *Path))
+		{
+			UE_LOG(LogTemp, Display, TEXT("CoreStressBenchmark: %d frames, report written to %s"), Run.FramesRun, *Path);
+		}
+		else
+		{
+			UE_LOG(LogTemp, Error, TEXT("CoreStressBenchmark: Failed to write report to %s"), *Path);
+		}
+	}
+
+	void TeardownStressScene(FStressRun& Run)
+	{
+		UWorld* World = Run.World.Get();
+		UPhysicsIntegrationSubsystem* Physics = World ? World->GetSubsystem<UPhysicsIntegrationSubsystem>() : nullptr;
+		for (const TWeakObjectPtr<UPrimitiveComponent>& Body : Run.Bodies)
+		{
+			if (Physics && Body.IsValid())
+			{
+				Physics->UnregisterPhysicsBody(Body.Get());
+			}
+		}
+
+		for (const TWeakObjectPtr<AActor>& Actor : Run.SpawnedActors)
+		{
+			if (Actor.IsValid())
+			{
+				Actor->Destroy();
+			}
+		}
+	}
+
+	bool TickStressRun(float DeltaTime)
+	{
+		FStressRun& Run = *ActiveStressRun;
+		UWorld* World = Run.World.Get();
+		if (!World)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("CoreStressBenchmark: World went away after %d frames"), Run.FramesRun);
+			ActiveStressRun.Reset();
+			return false;
+		}
+
+		SampleStressFrame(Run, *World);
+		if (++Run.FramesRun < Run.Config.NumFrames)
+		{
+			return true;
+		}
+
+		WriteStressReport(Run);
+		TeardownStressScene(Run);
+
+		const bool bExit = Run.Config.bExitWhenDone;
+		ActiveStressRun.Reset();
+		if (bExit)
+		{
+			FPlatformMisc::RequestExit(false, TEXT("CoreStressBenchmark"));
+		}
+		return false;
+	}
+
+	void RunCoreStressBenchmark(const TArray<FString>& Args, UWorld* World)
+	{
+		if (!World || !World->IsGameWorld())
+		{
+			UE_LOG(LogTemp, Warning, TEXT("CoreStressBenchmark: Needs a game world (PIE or -game)"));
+			return;
+		}
+
+		if (ActiveStressRun.IsValid())
+		{
+			UE_LOG(LogTemp, Warning, TEXT("CoreStressBenchmark: A run is already in progress"));
+			return;
+		}
+
+		FStressConfig Config;
+		int32 Positional = 0;
+		for (const FString& Arg : Args)
+		{
+			if (Arg == TEXT("exit")) { Config.bExitWhenDone = true; continue; }
+			if (!Arg.IsNumeric()) { continue; }
+
+			const int32 Value = FMath::Max(0, FCString::Atoi(*Arg));
+			switch (Positional++)
+			{
+			case 0: Config.NumVolumes = Value; break;
+			case 1: Config.NumBodies = Value; break;
+			case 2: Config.NumBiomeSpecs = Value; break;
+			case 3: Config.NumFrames = FMath::Max(1, Value); break;
+			default: break;
+			}
+		}
+
+		UE_LOG(LogTemp, Display, TEXT("CoreStressBenchmark: %d volumes, %d bodies, %d biome specs, %d frames"),
+			Config.NumVolumes, Config.NumBodies, Config.NumBiomeSpecs, Config.NumFrames);
+
+		ActiveStressRun = MakeShared<FStressRun>();
+		ActiveStressRun->Config = Config;
+		ActiveStressRun->World = World;
+		SetupStressScene(*ActiveStressRun, *World);
+
+		// Sampled after each engine frame, so the subsystems have ticked
+		ActiveStressRun->TickerHandle = FTSTicker::GetCoreTicker().AddTicker(
+			FTickerDelegate::CreateStatic(&TickStressRun));
+	}
+
+	FAutoConsoleCommandWithWorldAndArgs CoreStressBenchmarkCommand(
+		TEXT("TPF.Core.StressBenchmark"),
+		TEXT("Stress the core world subsystems and write per-frame cost/memory JSON. Args: [Volumes] [Bodies] [BiomeSpecs] [Frames] [exit]"),
+		FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(&RunCoreStressBenchmark));
+}
+
+#endif // !UE_BUILD_SHIPPING
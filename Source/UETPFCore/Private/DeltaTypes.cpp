@@ -40,3 +40,422 @@ FBox FWorldCellKey::GetWorldBounds(float CellSize) const
 	
 	return FBox(MinPoint, MaxPoint);
 }
+
+//=============================================================================
+// FSurfaceTileDelta
+//=============================================================================
+
+namespace
+{
+	float ApplySurfaceOperation(float Current, ESurfaceDeltaOperation Operation, float Value)
+	{
+		switch (Operation)
+		{
+		case ESurfaceDeltaOperation::Set:      return Value;
+		case ESurfaceDeltaOperation::Add:      return Current + Value;
+		case ESurfaceDeltaOperation::Subtract: return Current - Value;
+		case ESurfaceDeltaOperation::Multiply: return Current * Value;
+		case ESurfaceDeltaOperation::Max:      return FMath::Max(Current, Value);
+		case ESurfaceDeltaOperation::Min:      return FMath::Min(Current, Value);
+		default:                               return Current;
+		}
+	}
+
+	bool IsAdditive(ESurfaceDeltaOperation Operation)
+	{
+		return Operation == ESurfaceDeltaOperation::Add || Operation == ESurfaceDeltaOperation::Subtract;
+	}
+}
+
+float FSurfaceTileDelta::ApplyTo(float Current) const
+{
+	return ApplySurfaceOperation(Current, Operation, Value);
+}
+
+bool FSurfaceTileDelta::TryCoalesce(const FSurfaceTileDelta& Later)
+{
+	if (!TargetsSameTile(Later))
+	{
+		return false;
+	}
+
+	if (Later.Operation == ESurfaceDeltaOperation::Set)
+	{
+		Operation = ESurfaceDeltaOperation::Set;
+		Value = Later.Value;
+	}
+	else if (Operation == ESurfaceDeltaOperation::Set)
+	{
+		Value = ApplySurfaceOperation(Value, Later.Operation, Later.Value);
+	}
+	else if (IsAdditive(Operation) && IsAdditive(Later.Operation))
+	{
+		const float Net = (Operation == ESurfaceDeltaOperation::Add ? Value : -Value)
+			+ (Later.Operation == ESurfaceDeltaOperation::Add ? Later.Value : -Later.Value);
+		Operation = ESurfaceDeltaOperation::Add;
+		Value = Net;
+	}
+	else if (Operation == Later.Operation && Operation == ESurfaceDeltaOperation::Multiply)
+	{
+		Value *= Later.Value;
+	}
+	else if (Operation == Later.Operation && Operation == ESurfaceDeltaOperation::Max)
+	{
+		Value = FMath::Max(Value, Later.Value);
+	}
+	else if (Operation == Later.Operation && Operation == ESurfaceDeltaOperation::Min)
+	{
+		Value = FMath::Min(Value, Later.Value);
+	}
+	else
+	{
+		return false;
+	}
+
+	WorldLocation = Later.WorldLocation;
+	Radius = FMath::Max(Radius, Later.Radius);
+	Timestamp = Later.Timestamp;
+	AuthorPlayerId = Later.AuthorPlayerId;
+	return true;
+}
+
+int32 FSurfaceTileDelta::CoalesceInPlace(TArray<FSurfaceTileDelta>& Deltas)
+{
+	const int32 OriginalNum = Deltas.Num();
+
+	// Index of the last surviving record per tile channel
+	TMap<uint64, int32> LastByKey;
+	LastByKey.Reserve(OriginalNum);
+
+	int32 WriteIndex = 0;
+	for (int32 ReadIndex = 0; ReadIndex < OriginalNum; ReadIndex++)
+	{
+		const uint64 Key = MakeTileChannelKey(Deltas[ReadIndex].TileIndex, Deltas[ReadIndex].Channel);
+		if (const int32* Last = LastByKey.Find(Key))
+		{
+			if (Deltas[*Last].TryCoalesce(Deltas[ReadIndex]))
+			{
+				continue;
+			}
+		}
+
+		if (WriteIndex != ReadIndex)
+		{
+			Deltas[WriteIndex] = MoveTemp(Deltas[ReadIndex]);
+		}
+		LastByKey.Add(Key, WriteIndex);
+		WriteIndex++;
+	}
+
+	Deltas.SetNum(WriteIndex);
+	return OriginalNum - WriteIndex;
+}
+
+int32 FSurfaceTileDelta::TileIndexFromWorldLocation(const FVector& Location, const FWorldCellKey& CellKey, float CellSize)
+{
+	const float EffectiveCellSize = CellSize * FMath::Pow(2.0f, static_cast<float>(CellKey.LOD));
+	const float TileSize = EffectiveCellSize / TilesPerCellAxis;
+
+	const int32 TileX = FMath::Clamp(FMath::FloorToInt((Location.X - CellKey.X * EffectiveCellSize) / TileSize), 0, TilesPerCellAxis - 1);
+	const int32 TileY = FMath::Clamp(FMath::FloorToInt((Location.Y - CellKey.Y * EffectiveCellSize) / TileSize), 0, TilesPerCellAxis - 1);
+	return TileY * TilesPerCellAxis + TileX;
+}
+
+//=============================================================================
+// FSurfaceChannelGrid
+//=============================================================================
+
+void FSurfaceChannelGrid::Rebuild(TConstArrayView<FSurfaceTileDelta> Deltas)
+{
+	for (TArray<float>& Plane : Planes)
+	{
+		Plane.Reset();
+	}
+
+	for (const FSurfaceTileDelta& Delta : Deltas)
+	{
+		ApplyDelta(Delta);
+	}
+}
+
+void FSurfaceChannelGrid::ApplyDelta(const FSurfaceTileDelta& Delta)
+{
+	const int32 ChannelIndex = static_cast<int32>(Delta.Channel);
+	if (ChannelIndex >= NumChannels || Delta.TileIndex < 0 || Delta.TileIndex >= TilesPerPlane)
+	{
+		return;
+	}
+
+	TArray<float>& Plane = Planes[ChannelIndex];
+	if (Plane.Num() == 0)
+	{
+		Plane.SetNumZeroed(TilesPerPlane);
+	}
+
+	Plane[Delta.TileIndex] = Delta.ApplyTo(Plane[Delta.TileIndex]);
+}
+
+float FSurfaceChannelGrid::GetTileValue(ESurfaceDeltaChannel Channel, int32 TileIndex) const
+{
+	const TArray<float>& Plane = Planes[static_cast<int32>(Channel)];
+	return Plane.IsValidIndex(TileIndex) ? Plane[TileIndex] : 0.0f;
+}
+
+float FSurfaceChannelGrid::Sample(ESurfaceDeltaChannel Channel, const FVector& WorldLocation, const FWorldCellKey& CellKey, float CellSize) const
+{
+	const TArray<float>& Plane = Planes[static_cast<int32>(Channel)];
+	if (Plane.Num() == 0)
+	{
+		return 0.0f;
+	}
+
+	const float EffectiveCellSize = CellSize * FMath::Pow(2.0f, static_cast<float>(CellKey.LOD));
+	const float InvTileSize = TilesPerAxis / EffectiveCellSize;
+
+	// Tile-centre space: tile i spans [i, i+1), its value sits at i + 0.5
+	const float U = FMath::Clamp(static_cast<float>(WorldLocation.X - CellKey.X * EffectiveCellSize) * InvTileSize - 0.5f, 0.0f, TilesPerAxis - 1.0f);
+	const float V = FMath::Clamp(static_cast<float>(WorldLocation.Y - CellKey.Y * EffectiveCellSize) * InvTileSize - 0.5f, 0.0f, TilesPerAxis - 1.0f);
+
+	const int32 X0 = FMath::Min(static_cast<int32>(U), TilesPerAxis - 2);
+	const int32 Y0 = FMath::Min(static_cast<int32>(V), TilesPerAxis - 2);
+	const float FX = U - X0;
+	const float FY = V - Y0;
+
+	const float* Row0 = Plane.GetData() + Y0 * TilesPerAxis + X0;
+	const float* Row1 = Row0 + TilesPerAxis;
+	return FMath::Lerp(FMath::Lerp(Row0[0], Row0[1], FX), FMath::Lerp(Row1[0], Row1[1], FX), FY);
+}
+
+float FSurfaceChannelGrid::GetMean(ESurfaceDeltaChannel Channel) const
+{
+	const TArray<float>& Plane = Planes[static_cast<int32>(Channel)];
+	if (Plane.Num() == 0)
+	{
+		return 0.0f;
+	}
+
+	double Sum = 0.0;
+	for (const float Value : Plane)
+	{
+		Sum += Value;
+	}
+	return static_cast<float>(Sum / TilesPerPlane);
+}
+
+//=============================================================================
+// FPackedSurfaceDeltaList
+//=============================================================================
+
+void FPackedSurfaceDeltaList::Reset(const FWorldCellKey& InCellKey, double InEpochSeconds)
+{
+	CellKey = InCellKey;
+	EpochSeconds = InEpochSeconds;
+	Authors.Reset();
+	Records.Reset();
+}
+
+bool FPackedSurfaceDeltaList::CanPack(const FSurfaceTileDelta& Delta) const
+{
+	const double TimeOffset = Delta.Timestamp - EpochSeconds;
+	if (TimeOffset < 0.0 || TimeOffset > MaxTimeSpanSeconds)
+	{
+		return false;
+	}
+
+	if (Delta.TileIndex < 0 || Delta.TileIndex > MAX_uint16 || Delta.Radius < 0.0f || Delta.Radius > MAX_uint16
+		|| Authors.Num() >= MAX_uint16)
+	{
+		return false;
+	}
+
+	const FBox Bounds = CellKey.GetWorldBounds(PackCellSize);
+	return Delta.WorldLocation.X >= Bounds.Min.X && Delta.WorldLocation.X <= Bounds.Max.X
+		&& Delta.WorldLocation.Y >= Bounds.Min.Y && Delta.WorldLocation.Y <= Bounds.Max.Y;
+}
+
+bool FPackedSurfaceDeltaList::Add(const FSurfaceTileDelta& Delta)
+{
+	if (!CanPack(Delta))
+	{
+		return false;
+	}
+
+	const FBox Bounds = CellKey.GetWorldBounds(PackCellSize);
+	const FVector Extent = Bounds.GetSize();
+
+	FPackedSurfaceTileDelta& Packed = Records.AddDefaulted_GetRef();
+	Packed.TileIndex = static_cast<uint16>(Delta.TileIndex);
+	Packed.Channel = static_cast<uint8>(Delta.Channel);
+	Packed.Operation = static_cast<uint8>(Delta.Operation);
+	Packed.Value = Delta.Value;
+	Packed.LocalX = static_cast<uint16>(FMath::RoundToInt((Delta.WorldLocation.X - Bounds.Min.X) / Extent.X * MAX_uint16));
+	Packed.LocalY = static_cast<uint16>(FMath::RoundToInt((Delta.WorldLocation.Y - Bounds.Min.Y) / Extent.Y * MAX_uint16));
+	Packed.Z = static_cast<float>(Delta.WorldLocation.Z);
+	Packed.RadiusCm = static_cast<uint16>(FMath::RoundToInt(Delta.Radius));
+	Packed.TimeOffsetMs = static_cast<uint32>(FMath::Min(FMath::RoundToDouble((Delta.Timestamp - EpochSeconds) * 1000.0), static_cast<double>(MAX_uint32)));
+
+	// Few authors per cell - a linear scan beats a map
+	int32 AuthorIndex = Authors.Find(Delta.AuthorPlayerId);
+	if (AuthorIndex == INDEX_NONE)
+	{
+		AuthorIndex = Authors.Add(Delta.AuthorPlayerId);
+	}
+	Packed.AuthorIndex = static_cast<uint16>(AuthorIndex);
+	return true;
+}
+
+void FPackedSurfaceDeltaList::Unpack(int32 Index, FSurfaceTileDelta& OutDelta) const
+{
+	const FPackedSurfaceTileDelta& Packed = Records[Index];
+	const FBox Bounds = CellKey.GetWorldBounds(PackCellSize);
+	const FVector Extent = Bounds.GetSize();
+
+	OutDelta.CellKey = CellKey;
+	OutDelta.TileIndex = Packed.TileIndex;
+	OutDelta.Channel = static_cast<ESurfaceDeltaChannel>(Packed.Channel);
+	OutDelta.Operation = static_cast<ESurfaceDeltaOperation>(Packed.Operation);
+	OutDelta.Value = Packed.Value;
+	OutDelta.WorldLocation = FVector(
+		Bounds.Min.X + Extent.X * Packed.LocalX / MAX_uint16,
+		Bounds.Min.Y + Extent.Y * Packed.LocalY / MAX_uint16,
+		Packed.Z);
+	OutDelta.Radius = Packed.RadiusCm;
+	OutDelta.Timestamp = EpochSeconds + Packed.TimeOffsetMs / 1000.0;
+	OutDelta.AuthorPlayerId = Authors.IsValidIndex(Packed.AuthorIndex) ? Authors[Packed.AuthorIndex] : NAME_None;
+}
+
+void FPackedSurfaceDeltaList::UnpackAll(TArray<FSurfaceTileDelta>& OutDeltas) const
+{
+	OutDeltas.Reserve(OutDeltas.Num() + Records.Num());
+	for (int32 Index = 0; Index < Records.Num(); Index++)
+	{
+		Unpack(Index, OutDeltas.AddDefaulted_GetRef());
+	}
+}
+
+bool FPackedSurfaceDeltaList::PackAll(TConstArrayView<FSurfaceTileDelta> Deltas, const FWorldCellKey& InCellKey, FPackedSurfaceDeltaList& OutList)
+{
+	double Epoch = Deltas.Num() > 0 ? Deltas[0].Timestamp : 0.0;
+	for (const FSurfaceTileDelta& Delta : Deltas)
+	{
+		Epoch = FMath::Min(Epoch, Delta.Timestamp);
+	}
+
+	OutList.Reset(InCellKey, Epoch);
+	OutList.Records.Reserve(Deltas.Num());
+	for (const FSurfaceTileDelta& Delta : Deltas)
+	{
+		if (!OutList.Add(Delta))
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+FArchive& operator<<(FArchive& Ar, FPackedSurfaceDeltaList& List)
+{
+	Ar << List.EpochSeconds;
+
+	int32 AuthorCount = List.Authors.Num();
+	Ar << AuthorCount;
+	if (Ar.IsLoading())
+	{
+		if (AuthorCount < 0 || AuthorCount > MAX_uint16)
+		{
+			Ar.SetError();
+			return Ar;
+		}
+		List.Authors.SetNum(AuthorCount);
+	}
+	for (FName& Author : List.Authors)
+	{
+		Ar << Author;
+	}
+
+	int32 RecordCount = List.Records.Num();
+	Ar << RecordCount;
+	if (Ar.IsLoading())
+	{
+		if (RecordCount < 0 || (Ar.TotalSize() >= 0 && RecordCount * static_cast<int64>(sizeof(FPackedSurfaceTileDelta)) > Ar.TotalSize() - Ar.Tell()))
+		{
+			Ar.SetError();
+			return Ar;
+		}
+		List.Records.SetNumUninitialized(RecordCount);
+	}
+
+	// POD records go through as one block (little endian, like the rest of the format)
+	Ar.Serialize(List.Records.GetData(), RecordCount * sizeof(FPackedSurfaceTileDelta));
+	return Ar;
+}
+
+//=============================================================================
+// FDeltaCellSummary
+//=============================================================================
+
+void FDeltaCellSummary::SetSurfaceFromDeltas(TConstArrayView<FSurfaceTileDelta> Deltas)
+{
+	FSurfaceChannelGrid Grid;
+	Grid.Rebuild(Deltas);
+
+	MeanSnowDepth = Grid.GetMean(ESurfaceDeltaChannel::SnowDepth);
+	MeanSnowCompaction = Grid.GetMean(ESurfaceDeltaChannel::SnowCompaction);
+	MeanWetness = Grid.GetMean(ESurfaceDeltaChannel::Wetness);
+	MeanTemperatureDelta = Grid.GetMean(ESurfaceDeltaChannel::TemperatureDelta);
+	MeanToxicity = Grid.GetMean(ESurfaceDeltaChannel::Toxicity);
+
+	for (const FSurfaceTileDelta& Delta : Deltas)
+	{
+		LatestTimestamp = FMath::Max(LatestTimestamp, Delta.Timestamp);
+	}
+}
+
+void FDeltaCellSummary::Accumulate(const FDeltaCellSummary& Child, int32 ChildrenPerCell, int32 Sign)
+{
+	const float Weight = static_cast<float>(Sign) / FMath::Max(ChildrenPerCell, 1);
+	MeanSnowDepth += Child.MeanSnowDepth * Weight;
+	MeanSnowCompaction += Child.MeanSnowCompaction * Weight;
+	MeanWetness += Child.MeanWetness * Weight;
+	MeanTemperatureDelta += Child.MeanTemperatureDelta * Weight;
+	MeanToxicity += Child.MeanToxicity * Weight;
+
+	RemovedActors += Child.RemovedActors * Sign;
+	MovedActors += Child.MovedActors * Sign;
+	SpawnedActors += Child.SpawnedActors * Sign;
+	FracturedActors += Child.FracturedActors * Sign;
+	Assemblies += Child.Assemblies * Sign;
+	CellsWithDeltas += Child.CellsWithDeltas * Sign;
+
+	if (Sign > 0)
+	{
+		LatestTimestamp = FMath::Max(LatestTimestamp, Child.LatestTimestamp);
+	}
+}
+
+FArchive& operator<<(FArchive& Ar, FDeltaCellSummary& Summary)
+{
+	Ar << Summary.CellKey.X << Summary.CellKey.Y << Summary.CellKey.LOD;
+	Ar << Summary.MeanSnowDepth << Summary.MeanSnowCompaction << Summary.MeanWetness;
+	Ar << Summary.MeanTemperatureDelta << Summary.MeanToxicity;
+	Ar << Summary.RemovedActors << Summary.MovedActors << Summary.SpawnedActors;
+	Ar << Summary.FracturedActors << Summary.Assemblies << Summary.CellsWithDeltas;
+	Ar << Summary.LatestTimestamp;
+	return Ar;
+}
+
+//=============================================================================
+// IDeltaStore
+//=============================================================================
+
+FSimpleMulticastDelegate& IDeltaStore::OnPreLevelTransition()
+{
+	static FSimpleMulticastDelegate Delegate;
+	return Delegate;
+}
+
+FOnSurfaceDeltasChanged& IDeltaStore::OnSurfaceDeltasChanged()
+{
+	static FOnSurfaceDeltasChanged Delegate;
+	return Delegate;
+}
@@ -0,0 +1,710 @@
+// Copyright 2026 Threaded Pixel Factory
+// Licensed under the Apache License, Version 2.0 (the "License");
+// SPDX-License-Identifier: Apache-2.0
+
+#include "Environment/NiagaraDataInterfaceEnvironment.h"
+#include "Subsystems/EnvironmentSubsystem.h"
+#include "GlobalAtmosphereField.h"
+#include "TPFCoreStats.h"
+#include "NiagaraCompileHashVisitor.h"
+#include "NiagaraRenderer.h"
+#include "NiagaraShaderParametersBuilder.h"
+#include "NiagaraSystemInstance.h"
+#include "NiagaraTypes.h"
+#include "Async/ParallelFor.h"
+#include "Engine/World.h"
+#include "Misc/LargeWorldRenderPosition.h"
+#include "RenderingThread.h"
+
+#define LOCTEXT_NAMESPACE "NiagaraDataInterfaceEnvironment"
+
+namespace NDIEnvironment
+{
+	const FName SampleEnvironmentName(TEXT("SampleEnvironment"));
+	const FName SampleWindName(TEXT("SampleWind"));
+
+	/** Bump when the generated HLSL changes */
+	constexpr int32 ShaderVersion = 1;
+
+	/** Two float4 per grid cell: (density, temperature, pressure, in volume) and (wind, 0) */
+	constexpr int32 GridRowsPerCell = 2;
+
+	/** Everything the shader reads besides the buffers (see FShaderParameters) */
+	struct FConstants
+	{
+		/** x sea level Z (LWC tile relative), y top altitude, z profile rows per cm, w row count (0 = no atmosphere) */
+		FVector4f AtmosphereParams = FVector4f(0.0f, 0.0f, 0.0f, 0.0f);
+		/** xyz base wind, w altitude scale */
+		FVector4f WindParams = FVector4f(0.0f, 0.0f, 0.0f, 0.0f);
+		/** xyz gust lattice point of the LWC tile origin (wrapped), w gust amplitude (cm/s) */
+		FVector4f GustParams = FVector4f(0.0f, 0.0f, 0.0f, 0.0f);
+		/** Default medium: density, temperature, pressure, valid */
+		FVector4f DefaultMedium = FVector4f(0.0f, 0.0f, 0.0f, 0.0f);
+		FVector4f DefaultWind = FVector4f(0.0f, 0.0f, 0.0f, 0.0f);
+		FVector3f GridOrigin = FVector3f::ZeroVector;
+		float GridInvCellSize = 0.0f;
+		FIntVector GridSize = FIntVector::ZeroValue;
+	};
+
+	/** Game thread state per system instance */
+	struct FInstanceData
+	{
+		/** Snapshot the GPU data was built from; CPU emitters sample it directly */
+		TSharedPtr<const FEnvironmentQuerySnapshot, ESPMode::ThreadSafe> Snapshot;
+
+		/** World position of the system's LWC tile (Niagara positions are relative to it) */
+		FVector LWCTileOffset = FVector::ZeroVector;
+
+		/** Gust field time (world seconds) */
+		double TimeSeconds = 0.0;
+
+		FConstants Constants;
+
+		/** Grid placement (world space); re-baked when the system leaves the middle half */
+		FIntVector GridCenterCell = FIntVector::ZeroValue;
+		FVector GridOriginWorld = FVector::ZeroVector;
+		bool bGridBaked = false;
+
+		/** Buffers waiting to be handed to the render thread */
+		TArray<FVector4f> PendingProfile;
+		TArray<FVector4f> PendingGrid;
+		bool bProfileChanged = false;
+		bool bGridChanged = false;
+	};
+
+	/** Game thread -> render thread, once per frame */
+	struct FGameToRenderData
+	{
+		FConstants Constants;
+		TArray<FVector4f> Profile;
+		TArray<FVector4f> Grid;
+		bool bProfileChanged = false;
+		bool bGridChanged = false;
+	};
+
+	/** Render thread state per system instance */
+	struct FRenderData
+	{
+		FConstants Constants;
+		FReadBuffer ProfileBuffer;
+		FReadBuffer GridBuffer;
+	};
+
+	void UploadFloat4Buffer(FReadBuffer& Buffer, const TArray<FVector4f>& Values, const TCHAR* DebugName)
+	{
+		Buffer.Release();
+		if (Values.Num() == 0)
+		{
+			return;
+		}
+
+		FRHICommandListImmediate& RHICmdList = FRHICommandListImmediate::Get();
+		const uint32 NumBytes = Values.Num() * sizeof(FVector4f);
+		Buffer.Initialize(RHICmdList, DebugName, sizeof(FVector4f), Values.Num(), PF_A32B32G32R32F, BUF_Static);
+		void* Dest = RHICmdList.LockBuffer(Buffer.Buffer, 0, NumBytes, RLM_WriteOnly);
+		FMemory::Memcpy(Dest, Values.GetData(), NumBytes);
+		RHICmdList.UnlockBuffer(Buffer.Buffer);
+	}
+
+	struct FProxy : public FNiagaraDataInterfaceProxy
+	{
+		virtual int32 PerInstanceDataPassedToRenderThreadSize() const override { return sizeof(FGameToRenderData); }
+
+		virtual void ConsumePerInstanceDataFromGameThread(void* PerInstanceData, const FNiagaraSystemInstanceID& InstanceID) override
+		{
+			FGameToRenderData* FromGameThread = static_cast<FGameToRenderData*>(PerInstanceData);
+			FRenderData& Data = InstanceData.FindOrAdd(InstanceID);
+			Data.Constants = FromGameThread->Constants;
+
+			if (FromGameThread->bProfileChanged)
+			{
+				UploadFloat4Buffer(Data.ProfileBuffer, FromGameThread->Profile, TEXT("NDIEnvironment_Profile"));
+			}
+			if (FromGameThread->bGridChanged)
+			{
+				UploadFloat4Buffer(Data.GridBuffer, FromGameThread->Grid, TEXT("NDIEnvironment_Grid"));
+			}
+
+			FromGameThread->~FGameToRenderData();
+		}
+
+		TMap<FNiagaraSystemInstanceID, FRenderData> InstanceData;
+	};
+
+	/**
+	 * Environment at a location from a snapshot, plus whether a volume supplied it.
+	 * Same order as FEnvironmentQuerySnapshot::GetEnvironmentAtLocation.
+	 */
+	FEnvironmentContext SampleSnapshot(const FInstanceData& InstanceData, const FVector& WorldLocation, bool& bOutInVolume)
+	{
+		bOutInVolume = false;
+		const FEnvironmentQuerySnapshot* Snapshot = InstanceData.Snapshot.Get();
+		if (!Snapshot)
+		{
+			return FEnvironmentContext();
+		}
+
+		const FEnvironmentQuerySnapshot::FVolume* Volume = Snapshot->FindVolumeAtLocation(WorldLocation);
+		if (Volume && Volume->Context.bIsValid)
+		{
+			bOutInVolume = true;
+			return Volume->Context;
+		}
+
+		if (Snapshot->bHasAtmosphere)
+		{
+			FAtmosphereState AtmoState;
+			Snapshot->Atmosphere.Evaluate(WorldLocation, AtmoState, InstanceData.TimeSeconds);
+			return FAtmosphereModel::MakeEnvironmentContext(AtmoState);
+		}
+
+		return Snapshot->DefaultContext;
+	}
+
+	/** Rows of the atmosphere profile (temperature, pressure, density, speed of sound) */
+	void BakeProfile(const FAtmosphereModel& Model, TArray<FVector4f>& OutRows)
+	{
+		auto ToRow = [](const FAtmosphereSample& Sample)
+		{
+			return FVector4f(Sample.Temperature, Sample.Pressure, Sample.Density, Sample.SpeedOfSound);
+		};
+
+		// Same rows FAtmosphereModel bakes, so GPU lerps match the CPU profile lookup
+		if (Model.AtmosphereTopAltitude <= 0.0f)
+		{
+			const FVector4f SeaLevel = ToRow(Model.EvaluateAltitudeAnalytic(0.0f));
+			OutRows = { SeaLevel, SeaLevel };
+			return;
+		}
+
+		const int32 NumRows = FAtmosphereModel::ProfileSampleCount;
+		const float SpacingCm = Model.AtmosphereTopAltitude / (NumRows - 1);
+		OutRows.SetNumUninitialized(NumRows);
+		for (int32 i = 0; i < NumRows; i++)
+		{
+			OutRows[i] = ToRow(Model.EvaluateAltitudeAnalytic(i * SpacingCm));
+		}
+	}
+
+	/** Resolve volume media at every grid cell center; empty if no volume reaches the grid */
+	void BakeGrid(const FEnvironmentQuerySnapshot& Snapshot, const FVector& OriginWorld, float CellSize,
+		const FIntVector& Resolution, TArray<FVector4f>& OutGrid)
+	{
+		SCOPE_CYCLE_COUNTER(STAT_TPF_EnvironmentGridBake);
+
+		OutGrid.Reset();
+
+		const FBox GridBounds(OriginWorld, OriginWorld + FVector(Resolution) * CellSize);
+		const bool bAnyVolume = Snapshot.Volumes.ContainsByPredicate([&GridBounds](const FEnvironmentQuerySnapshot::FVolume& Volume)
+		{
+			return Volume.Context.bIsValid && Volume.Bounds.Intersect(GridBounds);
+		});
+		if (!bAnyVolume)
+		{
+			return;
+		}
+
+		OutGrid.SetNumZeroed(Resolution.X * Resolution.Y * Resolution.Z * GridRowsPerCell);
+
+		// The snapshot is immutable, so slices bake in parallel
+		ParallelFor(Resolution.Z, [&Snapshot, &OriginWorld, CellSize, &Resolution, &OutGrid](int32 Z)
+		{
+			for (int32 Y = 0; Y < Resolution.Y; Y++)
+			{
+				for (int32 X = 0; X < Resolution.X; X++)
+				{
+					const FVector Center = OriginWorld + (FVector(X, Y, Z) + 0.5) * CellSize;
+					const FEnvironmentQuerySnapshot::FVolume* Volume = Snapshot.FindVolumeAtLocation(Center);
+					if (!Volume || !Volume->Context.bIsValid)
+					{
+						continue;
+					}
+
+					const FEnvironmentContext& Context = Volume->Context;
+					const int32 Index = ((Z * Resolution.Y + Y) * Resolution.X + X) * GridRowsPerCell;
+					OutGrid[Index] = FVector4f(Context.Density, Context.Temperature, Context.Pressure, 1.0f);
+					OutGrid[Index + 1] = FVector4f(FVector3f(Context.WindVelocity), 0.0f);
+				}
+			}
+		});
+	}
+
+	/** Float literal for generated HLSL */
+	FString HLSLFloat(double Value)
+	{
+		return FString::Printf(TEXT("%.9g"), Value);
+	}
+
+	/** Shared definitions, {S} = data interface symbol. The gust noise mirrors FAtmosphereModel::SampleGustLattice. */
+	const TCHAR* ParameterTemplateHLSL = TEXT(R"(
+float4 {S}_AtmosphereParams;
+float4 {S}_WindParams;
+float4 {S}_GustParams;
+float4 {S}_DefaultMedium;
+float4 {S}_DefaultWind;
+float3 {S}_GridOrigin;
+float {S}_GridInvCellSize;
+int3 {S}_GridSize;
+Buffer<float4> {S}_ProfileBuffer;
+Buffer<float4> {S}_GridBuffer;
+
+uint {S}_HashGustCorner(int3 Corner)
+{
+	uint Hash = (uint(Corner.x) & {Mask}u) | ((uint(Corner.y) & {Mask}u) << 8) | ((uint(Corner.z) & {Mask}u) << 16);
+	Hash = Hash * 747796405u + 2891336453u;
+	Hash = ((Hash >> ((Hash >> 28u) + 4u)) ^ Hash) * 277803737u;
+	return (Hash >> 22u) ^ Hash;
+}
+
+float {S}_GustCorner(int3 Cell, float3 Frac, int3 Offset)
+{
+	uint H = {S}_HashGustCorner(Cell + Offset) & 15u;
+	float3 P = Frac - float3(Offset);
+	float U = H < 8u ? P.x : P.y;
+	float V = H < 4u ? P.y : ((H == 12u || H == 14u) ? P.x : P.z);
+	return ((H & 1u) ? -U : U) + ((H & 2u) ? -V : V);
+}
+
+float {S}_SampleGustLattice(float3 P)
+{
+	int3 Cell = int3(floor(P));
+	float3 F = P - float3(Cell);
+	float3 W = F * F * F * (F * (F * 6.0 - 15.0) + 10.0);
+	return lerp(
+		lerp(lerp({S}_GustCorner(Cell, F, int3(0, 0, 0)), {S}_GustCorner(Cell, F, int3(1, 0, 0)), W.x),
+			lerp({S}_GustCorner(Cell, F, int3(0, 1, 0)), {S}_GustCorner(Cell, F, int3(1, 1, 0)), W.x), W.y),
+		lerp(lerp({S}_GustCorner(Cell, F, int3(0, 0, 1)), {S}_GustCorner(Cell, F, int3(1, 0, 1)), W.x),
+			lerp({S}_GustCorner(Cell, F, int3(0, 1, 1)), {S}_GustCorner(Cell, F, int3(1, 1, 1)), W.x), W.y),
+		W.z);
+}
+
+void {S}_Sample(float3 Position, out float3 Wind, out float Density, out float Temperature, out float Pressure, out bool bInVolume)
+{
+	// 1. Volume media, baked at grid cell centers
+	bInVolume = false;
+	int3 Cell = int3(floor((Position - {S}_GridOrigin) * {S}_GridInvCellSize));
+	if (all(Cell >= 0) && all(Cell < {S}_GridSize))
+	{
+		int Index = ((Cell.z * {S}_GridSize.y + Cell.y) * {S}_GridSize.x + Cell.x) * 2;
+		float4 Medium = {S}_GridBuffer[Index];
+		if (Medium.w > 0.0)
+		{
+			Density = Medium.x;
+			Temperature = Medium.y;
+			Pressure = Medium.z;
+			Wind = {S}_GridBuffer[Index + 1].xyz;
+			bInVolume = true;
+			return;
+		}
+	}
+
+	// 2. Atmosphere profile, wind and gusts
+	float NumRows = {S}_AtmosphereParams.w;
+	if (NumRows > 0.0)
+	{
+		float Altitude = Position.z - {S}_AtmosphereParams.x;
+		if (Altitude >= {S}_AtmosphereParams.y)
+		{
+			Wind = float3(0.0, 0.0, 0.0);
+			Density = 0.0;
+			Temperature = 2.7;
+			Pressure = 0.0;
+			return;
+		}
+
+		float Row = clamp(Altitude * {S}_AtmosphereParams.z, 0.0, NumRows - 1.0);
+		int Lo = min(int(floor(Row)), int(NumRows) - 2);
+		float4 Sample = lerp({S}_ProfileBuffer[Lo], {S}_ProfileBuffer[Lo + 1], Row - float(Lo));
+		Temperature = Sample.x;
+		Pressure = Sample.y;
+		Density = Sample.z;
+
+		float AltitudeM = max(Altitude / 100.0, 0.0);
+		Wind = {S}_WindParams.xyz * (1.0 + (AltitudeM / 1000.0) * {S}_WindParams.w);
+		if ({S}_GustParams.w > 0.0)
+		{
+			float3 Lattice = Position * {GustFrequency} + {S}_GustParams.xyz;
+			float3 Gust = float3(
+				{S}_SampleGustLattice(Lattice + {GustOffset0}),
+				{S}_SampleGustLattice(Lattice + {GustOffset1}),
+				{S}_SampleGustLattice(Lattice + {GustOffset2}) * 0.3);
+			Wind += Gust * {S}_GustParams.w;
+		}
+		return;
+	}
+
+	// 3. Default medium
+	Density = {S}_DefaultMedium.x;
+	Temperature = {S}_DefaultMedium.y;
+	Pressure = {S}_DefaultMedium.z;
+	Wind = {S}_DefaultWind.xyz;
+}
+)");
+}
+
+//=============================================================================
+// UNiagaraDataInterfaceEnvironment
+//=============================================================================
+
+UNiagaraDataInterfaceEnvironment::UNiagaraDataInterfaceEnvironment(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer)
+{
+	Proxy.Reset(new NDIEnvironment::FProxy());
+}
+
+void UNiagaraDataInterfaceEnvironment::PostInitProperties()
+{
+	Super::PostInitProperties();
+
+	if (HasAnyFlags(RF_ClassDefaultObject))
+	{
+		const ENiagaraTypeRegistryFlags Flags = ENiagaraTypeRegistryFlags::AllowAnyVariable | ENiagaraTypeRegistryFlags::AllowParameter;
+		FNiagaraTypeRegistry::Register(FNiagaraTypeDefinition(GetClass()), Flags);
+	}
+}
+
+#if WITH_EDITORONLY_DATA
+void UNiagaraDataInterfaceEnvironment::GetFunctionsInternal(TArray<FNiagaraFunctionSignature>& OutFunctions) const
+{
+	FNiagaraFunctionSignature BaseSignature;
+	BaseSignature.bMemberFunction = true;
+	BaseSignature.bRequiresContext = false;
+	BaseSignature.Inputs.Add(FNiagaraVariable(FNiagaraTypeDefinition(GetClass()), TEXT("Environment")));
+	BaseSignature.Inputs.Add(FNiagaraVariable(FNiagaraTypeDefinition::GetPositionDef(), TEXT("Position")));
+
+	{
+		FNiagaraFunctionSignature& Signature = OutFunctions.Add_GetRef(BaseSignature);
+		Signature.Name = NDIEnvironment::SampleEnvironmentName;
+		Signature.Outputs.Add(FNiagaraVariable(FNiagaraTypeDefinition::GetVec3Def(), TEXT("Wind")));
+		Signature.Outputs.Add(FNiagaraVariable(FNiagaraTypeDefinition::GetFloatDef(), TEXT("Density")));
+		Signature.Outputs.Add(FNiagaraVariable(FNiagaraTypeDefinition::GetFloatDef(), TEXT("Temperature")));
+		Signature.Outputs.Add(FNiagaraVariable(FNiagaraTypeDefinition::GetFloatDef(), TEXT("Pressure")));
+		Signature.Outputs.Add(FNiagaraVariable(FNiagaraTypeDefinition::GetBoolDef(), TEXT("InVolume")));
+		Signature.SetDescription(LOCTEXT("SampleEnvironmentDesc",
+			"Environment at a position: wind (cm/s), density (kg/m³), temperature (K), pressure (kPa), and whether a medium volume supplied it."));
+	}
+
+	{
+		FNiagaraFunctionSignature& Signature = OutFunctions.Add_GetRef(BaseSignature);
+		Signature.Name = NDIEnvironment::SampleWindName;
+		Signature.Outputs.Add(FNiagaraVariable(FNiagaraTypeDefinition::GetVec3Def(), TEXT("Wind")));
+		Signature.SetDescription(LOCTEXT("SampleWindDesc", "Wind velocity (cm/s) at a position, including gusts."));
+	}
+}
+#endif
+
+void UNiagaraDataInterfaceEnvironment::GetVMExternalFunction(const FVMExternalFunctionBindingInfo& BindingInfo, void* InstanceData, FVMExternalFunction& OutFunc)
+{
+	if (BindingInfo.Name == NDIEnvironment::SampleEnvironmentName)
+	{
+		OutFunc = FVMExternalFunction::CreateUObject(this, &UNiagaraDataInterfaceEnvironment::VMSampleEnvironment);
+	}
+	else if (BindingInfo.Name == NDIEnvironment::SampleWindName)
+	{
+		OutFunc = FVMExternalFunction::CreateUObject(this, &UNiagaraDataInterfaceEnvironment::VMSampleWind);
+	}
+}
+
+void UNiagaraDataInterfaceEnvironment::VMSampleEnvironment(FVectorVMExternalFunctionContext& Context)
+{
+	VectorVM::FUserPtrHandler<NDIEnvironment::FInstanceData> InstanceData(Context);
+	FNDIInputParam<FNiagaraPosition> InPosition(Context);
+	FNDIOutputParam<FVector3f> OutWind(Context);
+	FNDIOutputParam<float> OutDensity(Context);
+	FNDIOutputParam<float> OutTemperature(Context);
+	FNDIOutputParam<float> OutPressure(Context);
+	FNDIOutputParam<bool> OutInVolume(Context);
+
+	for (int32 i = 0; i < Context.GetNumInstances(); i++)
+	{
+		const FVector WorldLocation = InstanceData->LWCTileOffset + FVector(InPosition.GetAndAdvance());
+
+		bool bInVolume = false;
+		const FEnvironmentContext Environment = NDIEnvironment::SampleSnapshot(*InstanceData, WorldLocation, bInVolume);
+		OutWind.SetAndAdvance(FVector3f(Environment.WindVelocity));
+		OutDensity.SetAndAdvance(Environment.Density);
+		OutTemperature.SetAndAdvance(Environment.Temperature);
+		OutPressure.SetAndAdvance(Environment.Pressure);
+		OutInVolume.SetAndAdvance(bInVolume);
+	}
+}
+
+void UNiagaraDataInterfaceEnvironment::VMSampleWind(FVectorVMExternalFunctionContext& Context)
+{
+	VectorVM::FUserPtrHandler<NDIEnvironment::FInstanceData> InstanceData(Context);
+	FNDIInputParam<FNiagaraPosition> InPosition(Context);
+	FNDIOutputParam<FVector3f> OutWind(Context);
+
+	for (int32 i = 0; i < Context.GetNumInstances(); i++)
+	{
+		const FVector WorldLocation = InstanceData->LWCTileOffset + FVector(InPosition.GetAndAdvance());
+
+		bool bInVolume = false;
+		OutWind.SetAndAdvance(FVector3f(NDIEnvironment::SampleSnapshot(*InstanceData, WorldLocation, bInVolume).WindVelocity));
+	}
+}
+
+bool UNiagaraDataInterfaceEnvironment::Equals(const UNiagaraDataInterface* Other) const
+{
+	if (!Super::Equals(Other))
+	{
+		return false;
+	}
+
+	const UNiagaraDataInterfaceEnvironment* OtherEnvironment = CastChecked<const UNiagaraDataInterfaceEnvironment>(Other);
+	return OtherEnvironment->GridCellSize == GridCellSize
+		&& OtherEnvironment->GridResolution == GridResolution
+		&& OtherEnvironment->bIgnoreVolumes == bIgnoreVolumes;
+}
+
+bool UNiagaraDataInterfaceEnvironment::CopyToInternal(UNiagaraDataInterface* Destination) const
+{
+	if (!Super::CopyToInternal(Destination))
+	{
+		return false;
+	}
+
+	UNiagaraDataInterfaceEnvironment* DestinationEnvironment = CastChecked<UNiagaraDataInterfaceEnvironment>(Destination);
+	DestinationEnvironment->GridCellSize = GridCellSize;
+	DestinationEnvironment->GridResolution = GridResolution;
+	DestinationEnvironment->bIgnoreVolumes = bIgnoreVolumes;
+	return true;
+}
+
+//--- Per-instance data ---
+
+bool UNiagaraDataInterfaceEnvironment::InitPerInstanceData(void* PerInstanceData, FNiagaraSystemInstance* SystemInstance)
+{
+	new (PerInstanceData) NDIEnvironment::FInstanceData();
+	return true;
+}
+
+void UNiagaraDataInterfaceEnvironment::DestroyPerInstanceData(void* PerInstanceData, FNiagaraSystemInstance* SystemInstance)
+{
+	static_cast<NDIEnvironment::FInstanceData*>(PerInstanceData)->~FInstanceData();
+
+	ENQUEUE_RENDER_COMMAND(NDIEnvironment_RemoveInstance)(
+		[RT_Proxy = GetProxyAs<NDIEnvironment::FProxy>(), InstanceID = SystemInstance->GetId()](FRHICommandListImmediate& RHICmdList)
+		{
+			RT_Proxy->InstanceData.Remove(InstanceID);
+		});
+}
+
+int32 UNiagaraDataInterfaceEnvironment::PerInstanceDataSize() const
+{
+	return sizeof(NDIEnvironment::FInstanceData);
+}
+
+bool UNiagaraDataInterfaceEnvironment::PerInstanceTick(void* PerInstanceData, FNiagaraSystemInstance* SystemInstance, float DeltaSeconds)
+{
+	using namespace NDIEnvironment;
+	FInstanceData& InstanceData = *static_cast<FInstanceData*>(PerInstanceData);
+
+	UWorld* World = SystemInstance->GetWorld();
+	const UEnvironmentSubsystem* Environment = World ? World->GetSubsystem<UEnvironmentSubsystem>() : nullptr;
+
+	// Republished only when volumes, specs or the atmosphere change - otherwise the same pointer
+	TSharedPtr<const FEnvironmentQuerySnapshot, ESPMode::ThreadSafe> Snapshot;
+	if (Environment)
+	{
+		Snapshot = Environment->GetQuerySnapshot();
+	}
+	const bool bSnapshotChanged = Snapshot != InstanceData.Snapshot;
+	InstanceData.Snapshot = Snapshot;
+	InstanceData.TimeSeconds = World ? World->GetTimeSeconds() : 0.0;
+	InstanceData.LWCTileOffset = FVector(SystemInstance->GetLWCTile()) * FLargeWorldRenderScalar::GetTileSize();
+
+	// CPU emitters read the snapshot; only GPU emitters need constants and buffers
+	if (!SystemInstance->HasGPUEmitters())
+	{
+		return false;
+	}
+
+	FConstants& Constants = InstanceData.Constants;
+	Constants = FConstants();
+
+	if (Snapshot && Snapshot->bHasAtmosphere)
+	{
+		const FAtmosphereModel& Model = Snapshot->Atmosphere;
+		if (bSnapshotChanged || InstanceData.PendingProfile.Num() == 0)
+		{
+			BakeProfile(Model, InstanceData.PendingProfile);
+			InstanceData.bProfileChanged = true;
+		}
+
+		const int32 NumRows = InstanceData.PendingProfile.Num();
+		const float TopAltitude = Model.bHasConfig ? Model.AtmosphereTopAltitude : MAX_flt;
+		const float RowsPerCm = Model.AtmosphereTopAltitude > 0.0f ? (NumRows - 1) / Model.AtmosphereTopAltitude : 0.0f;
+		Constants.AtmosphereParams = FVector4f(float(Model.SeaLevelAltitude - InstanceData.LWCTileOffset.Z), TopAltitude, RowsPerCm, float(NumRows));
+		Constants.WindParams = FVector4f(FVector3f(Model.BaseWindVelocity), Model.WindAltitudeScale);
+
+		// Wrap the tile's lattice point in double; the shader adds the tile-relative part
+		const FVector Lattice = Model.GetGustLatticePoint(InstanceData.LWCTileOffset, InstanceData.TimeSeconds);
+		const double Period = FAtmosphereModel::GustLatticePeriod;
+		Constants.GustParams = FVector4f(
+			float(FMath::Fmod(Lattice.X, Period)),
+			float(FMath::Fmod(Lattice.Y, Period)),
+			float(FMath::Fmod(Lattice.Z, Period)),
+			Model.GetGustAmplitude());
+	}
+	else if (Snapshot)
+	{
+		const FEnvironmentContext& Default = Snapshot->DefaultContext;
+		Constants.DefaultMedium = FVector4f(Default.Density, Default.Temperature, Default.Pressure, Default.bIsValid ? 1.0f : 0.0f);
+		Constants.DefaultWind = FVector4f(FVector3f(Default.WindVelocity), 0.0f);
+	}
+	else
+	{
+		const FEnvironmentContext Default;
+		Constants.DefaultMedium = FVector4f(Default.Density, Default.Temperature, Default.Pressure, 0.0f);
+	}
+
+	// Volume grid around the system, re-baked on snapshot changes or once the system leaves its middle half
+	const FIntVector Resolution(FMath::Max(GridResolution.X, 1), FMath::Max(GridResolution.Y, 1), FMath::Max(GridResolution.Z, 1));
+	const FVector SystemLocation = SystemInstance->GetWorldTransform().GetLocation();
+	const FIntVector CenterCell(
+		FMath::FloorToInt32(SystemLocation.X / GridCellSize),
+		FMath::FloorToInt32(SystemLocation.Y / GridCellSize),
+		FMath::FloorToInt32(SystemLocation.Z / GridCellSize));
+	const FIntVector Drift = CenterCell - InstanceData.GridCenterCell;
+	const bool bRecenter = FMath::Abs(Drift.X) > Resolution.X / 4 || FMath::Abs(Drift.Y) > Resolution.Y / 4 || FMath::Abs(Drift.Z) > Resolution.Z / 4;
+
+	if (!InstanceData.bGridBaked || bSnapshotChanged || bRecenter)
+	{
+		InstanceData.GridCenterCell = CenterCell;
+		InstanceData.GridOriginWorld = FVector(CenterCell - Resolution / 2) * GridCellSize;
+		InstanceData.PendingGrid.Reset();
+		if (Snapshot && !bIgnoreVolumes)
+		{
+			BakeGrid(*Snapshot, InstanceData.GridOriginWorld, GridCellSize, Resolution, InstanceData.PendingGrid);
+		}
+		InstanceData.bGridBaked = true;
+		InstanceData.bGridChanged = true;
+	}
+
+	if (InstanceData.PendingGrid.Num() > 0)
+	{
+		Constants.GridOrigin = FVector3f(InstanceData.GridOriginWorld - InstanceData.LWCTileOffset);
+		Constants.GridInvCellSize = 1.0f / GridCellSize;
+		Constants.GridSize = Resolution;
+	}
+
+	return false;
+}
+
+void UNiagaraDataInterfaceEnvironment::ProvidePerInstanceDataForRenderThread(void* DataForRenderThread, void* PerInstanceData, const FNiagaraSystemInstanceID& SystemInstance)
+{
+	using namespace NDIEnvironment;
+	FInstanceData& InstanceData = *static_cast<FInstanceData*>(PerInstanceData);
+	FGameToRenderData* RenderData = new (DataForRenderThread) FGameToRenderData();
+	RenderData->Constants = InstanceData.Constants;
+
+	// Buffers travel once per change; the game thread keeps its copy of the profile to detect re-bakes
+	if (InstanceData.bProfileChanged)
+	{
+		RenderData->Profile = InstanceData.PendingProfile;
+		RenderData->bProfileChanged = true;
+		InstanceData.bProfileChanged = false;
+	}
+	if (InstanceData.bGridChanged)
+	{
+		RenderData->Grid = InstanceData.PendingGrid;
+		RenderData->bGridChanged = true;
+		InstanceData.bGridChanged = false;
+	}
+}
+
+//--- GPU ---
+
+#if WITH_EDITORONLY_DATA
+bool UNiagaraDataInterfaceEnvironment::AppendCompileHash(FNiagaraCompileHashVisitor* InVisitor) const
+{
+	bool bSuccess = Super::AppendCompileHash(InVisitor);
+	bSuccess &= InVisitor->UpdatePOD(TEXT("NDIEnvironmentShaderVersion"), NDIEnvironment::ShaderVersion);
+	return bSuccess;
+}
+
+void UNiagaraDataInterfaceEnvironment::GetParameterDefinitionHLSL(const FNiagaraDataInterfaceGPUParamInfo& ParamInfo, FString& OutHLSL)
+{
+	auto Float3 = [](const FVector3f& Value)
+	{
+		return FString::Printf(TEXT("float3(%s, %s, %s)"),
+			*NDIEnvironment::HLSLFloat(Value.X), *NDIEnvironment::HLSLFloat(Value.Y), *NDIEnvironment::HLSLFloat(Value.Z));
+	};
+
+	// Gust constants come from FAtmosphereModel so CPU and GPU cannot drift apart
+	FString HLSL = NDIEnvironment::ParameterTemplateHLSL;
+	HLSL.ReplaceInline(TEXT("{S}"), *ParamInfo.DataInterfaceHLSLSymbol);
+	HLSL.ReplaceInline(TEXT("{Mask}"), *FString::FromInt(FAtmosphereModel::GustLatticePeriod - 1));
+	HLSL.ReplaceInline(TEXT("{GustFrequency}"), *NDIEnvironment::HLSLFloat(FAtmosphereModel::GustSpatialFrequency));
+	HLSL.ReplaceInline(TEXT("{GustOffset0}"), *Float3(FAtmosphereModel::GustAxisOffsets[0]));
+	HLSL.ReplaceInline(TEXT("{GustOffset1}"), *Float3(FAtmosphereModel::GustAxisOffsets[1]));
+	HLSL.ReplaceInline(TEXT("{GustOffset2}"), *Float3(FAtmosphereModel::GustAxisOffsets[2]));
+	OutHLSL += HLSL;
+}
+
+bool UNiagaraDataInterfaceEnvironment::GetFunctionHLSL(const FNiagaraDataInterfaceGPUParamInfo& ParamInfo, const FNiagaraDataInterfaceGeneratedFunction& FunctionInfo,
+	int FunctionInstanceIndex, FString& OutHLSL)
+{
+	const FString& Symbol = ParamInfo.DataInterfaceHLSLSymbol;
+
+	if (FunctionInfo.DefinitionName == NDIEnvironment::SampleEnvironmentName)
+	{
+		OutHLSL += FString::Printf(TEXT(
+			"void %s(in float3 In_Position, out float3 Out_Wind, out float Out_Density, out float Out_Temperature, out float Out_Pressure, out bool Out_InVolume)\n"
+			"{\n"
+			"\t%s_Sample(In_Position, Out_Wind, Out_Density, Out_Temperature, Out_Pressure, Out_InVolume);\n"
+			"}\n"), *FunctionInfo.InstanceName, *Symbol);
+		return true;
+	}
+
+	if (FunctionInfo.DefinitionName == NDIEnvironment::SampleWindName)
+	{
+		OutHLSL += FString::Printf(TEXT(
+			"void %s(in float3 In_Position, out float3 Out_Wind)\n"
+			"{\n"
+			"\tfloat Density, Temperature, Pressure;\n"
+			"\tbool bInVolume;\n"
+			"\t%s_Sample(In_Position, Out_Wind, Density, Temperature, Pressure, bInVolume);\n"
+			"}\n"), *FunctionInfo.InstanceName, *Symbol);
+		return true;
+	}
+
+	return false;
+}
+#endif
+
+void UNiagaraDataInterfaceEnvironment::BuildShaderParameters(FNiagaraShaderParametersBuilder& ShaderParametersBuilder) const
+{
+	ShaderParametersBuilder.AddNestedStruct<FShaderParameters>();
+}
+
+void UNiagaraDataInterfaceEnvironment::SetShaderParameters(const FNiagaraDataInterfaceSetShaderParametersContext& Context) const
+{
+	using namespace NDIEnvironment;
+	const FProxy& DIProxy = Context.GetProxy<FProxy>();
+	const FRenderData* Data = DIProxy.InstanceData.Find(Context.GetSystemInstanceID());
+	const FConstants Constants = Data ? Data->Constants : FConstants();
+
+	FShaderParameters* Parameters = Context.GetParameterNestedStruct<FShaderParameters>();
+	Parameters->AtmosphereParams = Constants.AtmosphereParams;
+	Parameters->WindParams = Constants.WindParams;
+	Parameters->GustParams = Constants.GustParams;
+	Parameters->DefaultMedium = Constants.DefaultMedium;
+	Parameters->DefaultWind = Constants.DefaultWind;
+	Parameters->GridOrigin = Constants.GridOrigin;
+	Parameters->GridInvCellSize = Constants.GridInvCellSize;
+
+	// A missing buffer disables its stage (row count / grid size zero) and binds a dummy
+	const bool bHasProfile = Data && Data->ProfileBuffer.SRV.IsValid();
+	const bool bHasGrid = Data && Data->GridBuffer.SRV.IsValid();
+	if (!bHasProfile)
+	{
+		Parameters->AtmosphereParams.W = 0.0f;
+	}
+	Parameters->GridSize = bHasGrid ? Constants.GridSize : FIntVector::ZeroValue;
+	Parameters->ProfileBuffer = bHasProfile ? Data->ProfileBuffer.SRV.GetReference() : FNiagaraRenderer::GetDummyFloat4Buffer();
+	Parameters->GridBuffer = bHasGrid ? Data->GridBuffer.SRV.GetReference() : FNiagaraRenderer::GetDummyFloat4Buffer();
+}
+
+#undef LOCTEXT_NAMESPACE
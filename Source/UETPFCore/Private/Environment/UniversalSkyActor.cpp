@@ -5,9 +5,13 @@
 #include "Environment/UniversalSkyActor.h"
 
 #include "SpecTypes.h"
+#include "TPFCoreStats.h"
 #include "Subsystems/TimeSubsystem.h"
+#include "Subsystems/WeatherFieldSubsystem.h"
 #include "Space/Subsystems/SolarSystemSubsystem.h"
 #include "Space/Subsystems/StarCatalogSubsystem.h"
+#include "Space/Subsystems/WorldFrameSubsystem.h"
+#include "Space/Subsystems/CelestialMathLibrary.h"
 #include "Components/SceneComponent.h"
 #include "Components/DirectionalLightComponent.h"
 #include "Components/SkyAtmosphereComponent.h"
@@ -18,12 +22,20 @@
 
 #include "Engine/World.h"
 #include "Engine/Engine.h"
+#include "GameFramework/PlayerController.h"
 #include "Kismet/KismetMathLibrary.h"
 
 #include "NiagaraComponent.h"
 #include "NiagaraSystem.h"
 #include "NiagaraDataInterfaceArrayFunctionLibrary.h"
-#include "Materials/MaterialCreator.h"
+#include "Scalability.h"
+#include "Materials/MaterialInstanceDynamic.h"
+
+namespace
+{
+	/** GMST advance per sim second (one turn per sidereal day) */
+	constexpr double SiderealDegreesPerSimSecond = 360.0 / 86164.0905;
+}
 
 AUniversalSkyActor::AUniversalSkyActor()
 {
@@ -269,12 +281,24 @@ void AUniversalSkyActor::ConfigureDefaults()
 
 void AUniversalSkyActor::EndPlay(const EEndPlayReason::Type EndPlayReason)
 {
+	Scalability::OnScalabilitySettingsChanged.Remove(ScalabilityChangedHandle);
+
+	if (UWorldFrameSubsystem* WorldFrame = GetWorld() ? GetWorld()->GetSubsystem<UWorldFrameSubsystem>() : nullptr)
+	{
+		WorldFrame->OnWorldOriginRebased.Remove(OriginRebasedHandle);
+	}
+
 	// Unsubscribe from TimeSubsystem
 	if (UGameInstance* GI = GetGameInstance())
 	{
 		if (UTimeSubsystem* TimeSys = GI->GetSubsystem<UTimeSubsystem>())
 		{
-			TimeSys->OnSimTimeAdvanced.Remove(TimeAdvancedHandle);
+			TimeSys->UnsubscribeSimTime(TimeAdvancedHandle);
+			TimeSys->OnSimClockChanged.Remove(SimClockChangedHandle);
+		}
+		if (USolarSystemSubsystem* SolarSys = GI->GetSubsystem<USolarSystemSubsystem>())
+		{
+			SolarSys->OnEpochChanged.Remove(EpochChangedHandle);
 		}
 	}
 
@@ -304,17 +328,8 @@ void AUniversalSkyActor::BeginPlay()
 	{
 		StarfieldComponent->SetAsset(StarfieldNiagaraSystem);
 		UE_LOG(LogTemp, Log, TEXT("UniversalSkyActor: Assigned StarfieldNiagaraSystem to component"));		
-		// Create and apply procedural star material
-		UMaterial* StarMaterial = UMaterialCreator::CreateStarMaterial(
-			TEXT("/Game/Core/Materials"),
-			FName("M_StarProcedural"),
-			1000.0f // Default brightness multiplier
-		);
-		
-		if (StarMaterial)
-		{
-			UMaterialCreator::ApplyMaterialToNiagara(StarfieldComponent, StarMaterial);
-		}	}
+		ApplyStarMaterial();
+	}
 	else
 	{
 		UE_LOG(LogTemp, Warning, TEXT("UniversalSkyActor: StarfieldComponent or StarfieldNiagaraSystem not available. Assign StarfieldNiagaraSystem in editor."));
@@ -351,15 +366,35 @@ void AUniversalSkyActor::BeginPlay()
 	{
 		if (UTimeSubsystem* TimeSys = GI->GetSubsystem<UTimeSubsystem>())
 		{
-			TimeAdvancedHandle = TimeSys->OnSimTimeAdvanced.AddUObject(this, &AUniversalSkyActor::OnTimeAdvanced);
+			// Rate-limited: time-lapse advances many steps per frame, the sky needs one update at most
+			TimeAdvancedHandle = TimeSys->SubscribeSimTime(TimeUpdateRateHz,
+				FOnSimTimeInterval::CreateWeakLambda(this, [this](double NewSimTimeSeconds, double /*ElapsedSimSeconds*/)
+				{
+					OnTimeAdvanced(NewSimTimeSeconds);
+				}));
 			UE_LOG(LogTemp, Log, TEXT("UniversalSkyActor: Subscribed to TimeSubsystem events"));
+
+			// The starfield extrapolates GMST on the GPU; it only needs a new epoch when the rate changes
+			SimClockChangedHandle = TimeSys->OnSimClockChanged.AddUObject(this, &AUniversalSkyActor::UpdateStarfieldRotation);
+		}
+		if (USolarSystemSubsystem* SolarSys = GI->GetSubsystem<USolarSystemSubsystem>())
+		{
+			EpochChangedHandle = SolarSys->OnEpochChanged.AddUObject(this, &AUniversalSkyActor::UpdateStarfieldRotation);
 		}
 	}
 
+	// Effects quality picks the starfield's magnitude tier
+	ScalabilityChangedHandle = Scalability::OnScalabilitySettingsChanged.AddUObject(this, &AUniversalSkyActor::HandleScalabilityChanged);
+
+	if (UWorldFrameSubsystem* WorldFrame = GetWorld() ? GetWorld()->GetSubsystem<UWorldFrameSubsystem>() : nullptr)
+	{
+		OriginRebasedHandle = WorldFrame->OnWorldOriginRebased.AddUObject(this, &AUniversalSkyActor::HandleWorldOriginRebased);
+	}
+
 	// Initialize starfield BEFORE applying environment - why?
 	ApplyStarfield();
 	
-	// Apply initial environment state
+	// Apply initial environment state; the weather set on this actor is what the field relaxes to
 	ApplyEnvironment(CurrentMedium, CurrentWeather);
 }
 
@@ -367,12 +402,20 @@ void AUniversalSkyActor::Tick(float DeltaSeconds)
 {
 	Super::Tick(DeltaSeconds);
 
-	// Only update starfield rotation in Tick (lightweight)
-	// Sun/atmosphere/weather updates are event-driven via OnTimeAdvanced
+	// Time update held back by the wall-clock budget
+	if (TimeUpdateLimiter.bPending)
+	{
+		TryTimeUpdate(TimeUpdateLimiter.PendingSimSeconds);
+	}
+
+	// Deferred recapture from a rate-limited ApplyEnvironment
+	UpdateSkyRecapture();
+
+	// Starfield rotation runs on the GPU from the epoch set by UpdateStarfieldRotation;
+	// sun/atmosphere/weather updates are event-driven via OnTimeAdvanced.
+	// A positive StarfieldUpdateRateHz only adds a periodic re-anchor against drift.
 	if (StarfieldUpdateRateHz <= 0.0f)
 	{
-		UE_LOG(LogTemp, Verbose, TEXT("UniversalSkyActor: Tick Rotation StarfieldUpdateAccumulator hertz update rate=%.2f"), StarfieldUpdateRateHz);
-		UpdateStarfieldRotation();
 		return;
 	}
 
@@ -388,100 +431,274 @@ void AUniversalSkyActor::Tick(float DeltaSeconds)
 
 void AUniversalSkyActor::OnTimeAdvanced(double NewSimTimeSeconds)
 {
-	// Throttle: Only update if time actually changed
-	static double LastSimTime = -1.0;
-	if (FMath::Abs(NewSimTimeSeconds - LastSimTime) < 0.01)
+	TryTimeUpdate(NewSimTimeSeconds);
+}
+
+void AUniversalSkyActor::TryTimeUpdate(double NewSimTimeSeconds)
+{
+	FSkyUpdateLimiter& Limiter = TimeUpdateLimiter;
+	Limiter.bPending = false;
+
+	const double Now = FPlatformTime::Seconds();
+	if (Now - Limiter.WindowStartRealSeconds >= 1.0)
 	{
-		return; // Skip duplicate calls
+		Limiter.WindowStartRealSeconds = Now;
+		Limiter.WindowSpentSeconds = 0.0;
 	}
-	LastSimTime = NewSimTimeSeconds;
-	
+
+	// Too little sim time to show: drop it, the next advance carries the change
+	if (Limiter.bHasApplied && FMath::Abs(NewSimTimeSeconds - Limiter.LastSimSeconds) < MinSimSecondsBetweenUpdates)
+	{
+		Limiter.Skipped++;
+		INC_DWORD_STAT(STAT_TPF_SkyUpdatesSkipped);
+		return;
+	}
+
+	// Out of wall-clock budget for this second: keep it pending so Tick applies it
+	// even if time stops advancing
+	if (SkyUpdateBudgetMsPerSecond > 0.0f && Limiter.WindowSpentSeconds * 1000.0 >= SkyUpdateBudgetMsPerSecond)
+	{
+		Limiter.bPending = true;
+		Limiter.PendingSimSeconds = NewSimTimeSeconds;
+		Limiter.Skipped++;
+		INC_DWORD_STAT(STAT_TPF_SkyUpdatesSkipped);
+		return;
+	}
+
 	// Event-driven update when simulation time changes
-	ApplyEnvironment(CurrentMedium, CurrentWeather);
+	RefreshWeatherFromField();
+	ApplyEnvironmentState(CurrentMedium, CurrentWeather);
+
+	Limiter.WindowSpentSeconds += FPlatformTime::Seconds() - Now;
+	Limiter.LastSimSeconds = NewSimTimeSeconds;
+	Limiter.bHasApplied = true;
+	Limiter.Applied++;
+	INC_DWORD_STAT(STAT_TPF_SkyUpdatesApplied);
 	UE_LOG(LogTemp, Verbose, TEXT("UniversalSkyActor: Applied environment at SimTime=%.2f"), NewSimTimeSeconds);
 }
 
+void AUniversalSkyActor::RefreshWeatherFromField()
+{
+	UWorld* World = GetWorld();
+	const UWeatherFieldSubsystem* WeatherField = bUseWeatherField && World ? World->GetSubsystem<UWeatherFieldSubsystem>() : nullptr;
+	if (!WeatherField || !WeatherField->HasField())
+	{
+		return;
+	}
+
+	// Weather at the player's view rather than at the sky actor
+	FVector ViewLocation = GetActorLocation();
+	if (const APlayerController* PlayerController = World->GetFirstPlayerController())
+	{
+		FRotator ViewRotation;
+		PlayerController->GetPlayerViewPoint(ViewLocation, ViewRotation);
+	}
+	CurrentWeather = WeatherField->SampleWeather(ViewLocation);
+}
+
+void AUniversalSkyActor::GetSkyUpdateCounts(int32& OutApplied, int32& OutSkipped) const
+{
+	OutApplied = static_cast<int32>(TimeUpdateLimiter.Applied);
+	OutSkipped = static_cast<int32>(TimeUpdateLimiter.Skipped);
+}
+
 void AUniversalSkyActor::ApplyEnvironment(const FRuntimeMediumSpec& Medium, const FRuntimeWeatherState& Weather)
 {
+	CurrentWeather = Weather;
+
+	// The field owns the weather: hand it the new base, then show the field at the view
+	UWeatherFieldSubsystem* WeatherField = bUseWeatherField && GetWorld() ? GetWorld()->GetSubsystem<UWeatherFieldSubsystem>() : nullptr;
+	if (WeatherField)
+	{
+		WeatherField->SetBaseWeather(Weather);
+		RefreshWeatherFromField();
+	}
+
+	ApplyEnvironmentState(Medium, CurrentWeather);
+}
+
+void AUniversalSkyActor::ApplyEnvironmentState(const FRuntimeMediumSpec& Medium, const FRuntimeWeatherState& Weather)
+{
+	SCOPE_CYCLE_COUNTER(STAT_TPF_SkyApplyEnvironment);
+	CSV_SCOPED_TIMING_STAT(TPFCore, SkyApplyEnvironment);
+
 	// Cache for auto apply
 	CurrentMedium = Medium;
 	CurrentWeather = Weather;
 	// Throttle spam - only log on actual changes
-	static FRuntimeMediumSpec LastMedium;
-	static FRuntimeWeatherState LastWeather;
-	static bool bFirstRun = true;
-	
-	if (bFirstRun || 
-	    FMath::Abs(LastMedium.Density - Medium.Density) > 0.001f ||
-	    FMath::Abs(LastWeather.CloudCover01 - Weather.CloudCover01) > 0.01f)
+	if (!LogState.bLoggedEnvironment ||
+	    FMath::Abs(LogState.EnvironmentDensity - Medium.Density) > 0.001f ||
+	    FMath::Abs(LogState.EnvironmentCloudCover - Weather.CloudCover01) > 0.01f)
 	{
 		UE_LOG(LogTemp, Log, TEXT("UniversalSkyActor: Applying environment - Medium Density=%.3f, Pressure=%.1f Pa; Weather CloudCover=%.2f"), 
 			Medium.Density, Medium.PressurePa, Weather.CloudCover01);
-		LastMedium = Medium;
-		LastWeather = Weather;
-		bFirstRun = false;
+		LogState.EnvironmentDensity = Medium.Density;
+		LogState.EnvironmentCloudCover = Weather.CloudCover01;
+		LogState.bLoggedEnvironment = true;
+	}
+
+	const UGameInstance* GI = GetGameInstance();
+	const USolarSystemSubsystem* SolarSys = GI ? GI->GetSubsystem<USolarSystemSubsystem>() : nullptr;
+	if (!SolarSys)
+	{
+		UE_LOG(LogTemp, Error, TEXT("UniversalSkyActor: SolarSystemSubsystem not found"));
+	}
+	// Read the world's published sky frame so every consumer this step sees the same solar state
+	const UWorldFrameSubsystem* WorldFrame = GetWorld() ? GetWorld()->GetSubsystem<UWorldFrameSubsystem>() : nullptr;
+	const FSolarSystemState SolarState = WorldFrame && SolarSys ? WorldFrame->GetSkyFrame().Solar
+		: SolarSys ? SolarSys->GetSolarSystemState() : FSolarSystemState();
+	const FVector SunDir = SolarState.SunDir_World.GetSafeNormal();
+
+	// Each component re-applies only when one of its own inputs drifts past a tolerance.
+	// Direction components use the chord for the threshold angle; tuning scales use 0 (any edit).
+	const float SunTol = FMath::Sin(FMath::DegreesToRadians(SunDirectionThresholdDeg));
+	const float WeatherTol = WeatherChangeThreshold;
+	const auto MediumTol = [this](float Value) { return MediumChangeThreshold * FMath::Max(FMath::Abs(Value), KINDA_SMALL_NUMBER); };
+	const float DensityTol = MediumTol(Medium.Density);
+	const float PressureTol = MediumTol(Medium.PressurePa);
+
+	if (SolarSys && ConsumeSkyInputs(ESkyComponent::Sun,
+		{ float(SunDir.X), float(SunDir.Y), float(SunDir.Z), SolarState.SunIlluminanceLux, Medium.SolarIrradiance_Wm2, Medium.TemperatureK, Weather.CloudCover01, Weather.Storm01, SunIntensityScale },
+		{ SunTol, SunTol, SunTol, MediumTol(SolarState.SunIlluminanceLux), MediumTol(Medium.SolarIrradiance_Wm2), MediumTol(Medium.TemperatureK), WeatherTol, WeatherTol, 0.0f }))
+	{
+		ApplySun(Medium, Weather, SolarState);
+
+		// The captured sky only goes stale once the sun has travelled visibly
+		if (FVector::DotProduct(SunDir, CapturedSunDir) < FMath::Cos(FMath::DegreesToRadians(SkyRecaptureSunAngleDeg)))
+		{
+			RequestSkyRecapture();
+		}
+	}
+
+	if (ConsumeSkyInputs(ESkyComponent::Atmosphere,
+		{ Medium.Density, Medium.PressurePa, Weather.Humidity01 },
+		{ DensityTol, PressureTol, WeatherTol }))
+	{
+		ApplyAtmosphere(Medium, Weather);
+		RequestSkyRecapture();
+	}
+
+	if (ConsumeSkyInputs(ESkyComponent::Fog,
+		{ Medium.Density, Medium.PressurePa, Weather.Fog01, Weather.CloudCover01, Weather.Storm01, FogIntensityScale },
+		{ DensityTol, PressureTol, WeatherTol, WeatherTol, WeatherTol, 0.0f }))
+	{
+		ApplyFog(Medium, Weather);
+	}
+
+	if (ConsumeSkyInputs(ESkyComponent::Clouds,
+		{ Medium.Density, Medium.PressurePa, Weather.CloudCover01, CloudDensityScale },
+		{ DensityTol, PressureTol, WeatherTol, 0.0f }))
+	{
+		ApplyClouds(Medium, Weather);
+		RequestSkyRecapture();
 	}
 
-	ApplySun(Medium, Weather);
-	ApplyAtmosphere(Medium, Weather);
-	ApplyFog(Medium, Weather);
-	ApplyClouds(Medium, Weather);
-	ApplySkyLight(Medium, Weather);
+	if (ConsumeSkyInputs(ESkyComponent::SkyLight,
+		{ Medium.Density, Medium.PressurePa, Weather.CloudCover01, SkyLightIntensityScale },
+		{ DensityTol, PressureTol, WeatherTol, 0.0f }))
+	{
+		ApplySkyLight(Medium, Weather);
+	}
+
+	UpdateSkyRecapture();
 }
 
-void AUniversalSkyActor::ApplySun(const FRuntimeMediumSpec& Medium, const FRuntimeWeatherState& Weather)
+void AUniversalSkyActor::MarkSkyDirty()
 {
-    if (UGameInstance* GI = GetGameInstance())
+	for (TArray<float>& Applied : AppliedSkyInputs)
+	{
+		Applied.Reset();
+	}
+}
+
+bool AUniversalSkyActor::ConsumeSkyInputs(ESkyComponent Component, TConstArrayView<float> Values, TConstArrayView<float> Tolerances)
+{
+	check(Values.Num() == Tolerances.Num());
+
+	TArray<float>& Applied = AppliedSkyInputs[static_cast<int32>(Component)];
+	bool bChanged = Applied.Num() != Values.Num();
+	for (int32 Index = 0; !bChanged && Index < Values.Num(); Index++)
+	{
+		bChanged = FMath::Abs(Values[Index] - Applied[Index]) > Tolerances[Index];
+	}
+
+	if (bChanged)
+	{
+		Applied.Reset(Values.Num());
+		Applied.Append(Values.GetData(), Values.Num());
+	}
+	return bChanged;
+}
+
+void AUniversalSkyActor::RequestSkyRecapture()
+{
+	// Real-time capture re-renders the sky itself, time-sliced across frames
+	if (SkyLight && !SkyLight->bRealTimeCapture)
+	{
+		bSkyRecapturePending = true;
+	}
+}
+
+void AUniversalSkyActor::UpdateSkyRecapture()
+{
+	if (!bSkyRecapturePending || !SkyLight)
+	{
+		return;
+	}
+
+	const double Now = FPlatformTime::Seconds();
+	if (Now - LastSkyRecaptureRealSeconds < SkyRecaptureMinIntervalSeconds)
+	{
+		return; // Tick retries once the interval has elapsed
+	}
+
+	SkyLight->RecaptureSky();
+	LastSkyRecaptureRealSeconds = Now;
+	bSkyRecapturePending = false;
+
+	// DirectionalLight points from the sun toward the scene
+	CapturedSunDir = SunLight ? -SunLight->GetForwardVector() : FVector::ZeroVector;
+	UE_LOG(LogTemp, Verbose, TEXT("UniversalSkyActor: Sky light recaptured"));
+}
+
+void AUniversalSkyActor::ApplySun(const FRuntimeMediumSpec& Medium, const FRuntimeWeatherState& Weather, const FSolarSystemState& SolarState)
+{
+    // Use solar system's sun direction (authoritative sun/moon directions)
+    FVector SunDir = SolarState.SunDir_World.GetSafeNormal();
+
+    // DirectionalLight points *from* light toward scene; use -SunDir
+    const FRotator SunRot = UKismetMathLibrary::MakeRotFromX(-SunDir);
+    SunLight->SetWorldRotation(SunRot);
+
+    // Intensity: use SolarState illuminance or fallback to medium
+    const float Irr = FMath::Max(0.0f, Medium.SolarIrradiance_Wm2);
+    const float CloudDim = 1.0f - 0.75f * FMath::Clamp(Weather.CloudCover01, 0.0f, 1.0f);
+    const float StormDim = 1.0f - 0.5f * FMath::Clamp(Weather.Storm01, 0.0f, 1.0f);
+    const float BaseIntensity = (SolarState.SunIlluminanceLux > 0.0f) ? SolarState.SunIlluminanceLux : (Irr * 10.0f);
+    const float FinalIntensity = BaseIntensity * CloudDim * StormDim * SunIntensityScale;
+
+    SunLight->SetIntensity(FinalIntensity);
+
+    // Color temperature (rough proxy)
+    const float T = Medium.TemperatureK;
+    const float Kelvin = FMath::Clamp(6500.0f - (288.0f - T) * 10.0f, 2500.0f, 9000.0f);
+    SunLight->SetTemperature(Kelvin);
+
+    // Log sun state with component diagnostics
+    if (FVector::Dist(SunDir, LogState.SunDir) > 0.01f || LogState.SunDiagnostics < 3)
     {
-        // Query SolarSystemSubsystem for authoritative sun/moon directions
-        if (USolarSystemSubsystem* SolarSys = GI->GetSubsystem<USolarSystemSubsystem>())
-        {
-            FSolarSystemState SolarState = SolarSys->GetSolarSystemState();
-
-            // Use solar system's sun direction
-            FVector SunDir = SolarState.SunDir_World.GetSafeNormal();
-
-            // DirectionalLight points *from* light toward scene; use -SunDir
-            const FRotator SunRot = UKismetMathLibrary::MakeRotFromX(-SunDir);
-            SunLight->SetWorldRotation(SunRot);
-
-            // Intensity: use SolarState illuminance or fallback to medium
-            const float Irr = FMath::Max(0.0f, Medium.SolarIrradiance_Wm2);
-            const float CloudDim = 1.0f - 0.75f * FMath::Clamp(Weather.CloudCover01, 0.0f, 1.0f);
-            const float StormDim = 1.0f - 0.5f * FMath::Clamp(Weather.Storm01, 0.0f, 1.0f);
-            const float BaseIntensity = (SolarState.SunIlluminanceLux > 0.0f) ? SolarState.SunIlluminanceLux : (Irr * 10.0f);
-            const float FinalIntensity = BaseIntensity * CloudDim * StormDim * SunIntensityScale;
-
-            SunLight->SetIntensity(FinalIntensity);
-
-            // Color temperature (rough proxy)
-            const float T = Medium.TemperatureK;
-            const float Kelvin = FMath::Clamp(6500.0f - (288.0f - T) * 10.0f, 2500.0f, 9000.0f);
-            SunLight->SetTemperature(Kelvin);
-
-            // Log sun state with component diagnostics
-            static FVector LastLoggedSunDir = FVector::ZeroVector;
-            static int32 SunUpdateCount = 0;
-            if (FVector::Dist(SunDir, LastLoggedSunDir) > 0.01f || SunUpdateCount < 3)
-            {
-                UE_LOG(LogTemp, Warning, TEXT("☀️ SUN DIAGNOSTICS:"));
-                UE_LOG(LogTemp, Warning, TEXT("  └─ Direction: %s"), *SunDir.ToCompactString());
-                UE_LOG(LogTemp, Warning, TEXT("  └─ Rotation: %s"), *SunRot.ToCompactString());
-                UE_LOG(LogTemp, Warning, TEXT("  └─ Intensity: %.0f lux (Base: %.0f, Cloud: %.2f, Storm: %.2f)"), FinalIntensity, BaseIntensity, CloudDim, StormDim);
-                UE_LOG(LogTemp, Warning, TEXT("  └─ Temperature: %.0fK"), Kelvin);
-                UE_LOG(LogTemp, Warning, TEXT("  └─ Visible: %d, Hidden: %d, CastShadows: %d"), 
-                    SunLight->IsVisible(), SunLight->bHiddenInGame, SunLight->CastShadows);
-                UE_LOG(LogTemp, Warning, TEXT("  └─ AtmosSunLight: %d, Component Active: %d"), 
-                    SunLight->bAtmosphereSunLight, SunLight->IsActive());
-                UE_LOG(LogTemp, Warning, TEXT("  └─ World Location: %s"), *SunLight->GetComponentLocation().ToString());
-                LastLoggedSunDir = SunDir;
-                SunUpdateCount++;
-            }
-        }
-        else
-        {
-            UE_LOG(LogTemp, Error, TEXT("UniversalSkyActor: SolarSystemSubsystem not found"));
-        }
+        UE_LOG(LogTemp, Warning, TEXT("☀️ SUN DIAGNOSTICS:"));
+        UE_LOG(LogTemp, Warning, TEXT("  └─ Direction: %s"), *SunDir.ToCompactString());
+        UE_LOG(LogTemp, Warning, TEXT("  └─ Rotation: %s"), *SunRot.ToCompactString());
+        UE_LOG(LogTemp, Warning, TEXT("  └─ Intensity: %.0f lux (Base: %.0f, Cloud: %.2f, Storm: %.2f)"), FinalIntensity, BaseIntensity, CloudDim, StormDim);
+        UE_LOG(LogTemp, Warning, TEXT("  └─ Temperature: %.0fK"), Kelvin);
+        UE_LOG(LogTemp, Warning, TEXT("  └─ Visible: %d, Hidden: %d, CastShadows: %d"), 
+            SunLight->IsVisible(), SunLight->bHiddenInGame, SunLight->CastShadows);
+        UE_LOG(LogTemp, Warning, TEXT("  └─ AtmosSunLight: %d, Component Active: %d"), 
+            SunLight->bAtmosphereSunLight, SunLight->IsActive());
+        UE_LOG(LogTemp, Warning, TEXT("  └─ World Location: %s"), *SunLight->GetComponentLocation().ToString());
+        LogState.SunDir = SunDir;
+        LogState.SunDiagnostics++;
     }
     SunLight->bUseTemperature = true;
 }
@@ -490,15 +707,14 @@ void AUniversalSkyActor::ApplyAtmosphere(const FRuntimeMediumSpec& Medium, const
 {
 	// If we’re in vacuum, atmosphere should be effectively off.
 	const bool bVacuum = (Medium.Density <= KINDA_SMALL_NUMBER) || (Medium.PressurePa <= 1.0f);	
-	static int32 AtmosUpdateCount = 0;
-	if (AtmosUpdateCount < 3)
+	if (LogState.AtmosphereDiagnostics < 3)
 	{
 		UE_LOG(LogTemp, Warning, TEXT("🌍 ATMOSPHERE DIAGNOSTICS:"));
 		UE_LOG(LogTemp, Warning, TEXT("  └─ Density: %.3f kg/m³"), Medium.Density);
 		UE_LOG(LogTemp, Warning, TEXT("  └─ Pressure: %.1f Pa"), Medium.PressurePa);
 		UE_LOG(LogTemp, Warning, TEXT("  └─ Vacuum Mode: %d"), bVacuum);
 		UE_LOG(LogTemp, Warning, TEXT("  └─ Component Visible: %d, Active: %d"), SkyAtmosphere->IsVisible(), SkyAtmosphere->IsActive());
-		AtmosUpdateCount++;
+		LogState.AtmosphereDiagnostics++;
 	}
 	// SkyAtmosphere doesn’t have a single “enable” flag; we approximate by scaling density-related settings.
 	// Rayleigh scattering ~ density proxy, Mie scattering ~ humidity/aerosols proxy.
@@ -519,12 +735,11 @@ void AUniversalSkyActor::ApplyAtmosphere(const FRuntimeMediumSpec& Medium, const
 	SkyAtmosphere->SetOtherAbsorptionScale(bVacuum ? 0.0f : 1.0f);
 
 	// Log only on significant changes (throttle to avoid spam)
-	static float LastLoggedDensity = -1.0f;
-	if (FMath::Abs(Medium.Density - LastLoggedDensity) > 0.01f)
+	if (FMath::Abs(Medium.Density - LogState.AtmosphereDensity) > 0.01f)
 	{
 		UE_LOG(LogTemp, Log, TEXT("UniversalSkyActor: Atmosphere updated - Density: %.3f, Pressure: %.1f Pa, AtmosStrength: %.3f"), 
 			Medium.Density, Medium.PressurePa, AtmosStrength);
-		LastLoggedDensity = Medium.Density;
+		LogState.AtmosphereDensity = Medium.Density;
 	}
 }
 
@@ -584,8 +799,7 @@ void AUniversalSkyActor::ApplySkyLight(const FRuntimeMediumSpec& Medium, const F
 
 	SkyLight->SetIntensity(Base * CloudDim * SkyLightIntensityScale);
 
-	// Optionally force a recapture occasionally; realtime capture already does this.
-	SkyLight->RecaptureSky();  // avoid spamming
+	// Intensity alone doesn't stale the capture; sky changes go through RequestSkyRecapture
 }
 
 void AUniversalSkyActor::ApplyStarfield()
@@ -634,14 +848,30 @@ void AUniversalSkyActor::ApplyStarfield()
 		return;
 	}
 
-	// Ensure star data is loaded (idempotent - won't reload if already loaded)
-	if (!StarSys->EnsureLoaded())
+	// Load off the game thread; the starfield fills in when the catalog arrives
+	if (!StarSys->IsLoaded())
 	{
-		UE_LOG(LogTemp, Warning, TEXT("UniversalSkyActor::ApplyStarfield - Failed to load star catalog"));
+		if (!bWaitingForStarCatalog)
+		{
+			bWaitingForStarCatalog = true;
+			StarSys->EnsureLoadedAsync(FOnStarCatalogReady::CreateWeakLambda(this, [this](bool bLoaded)
+			{
+				bWaitingForStarCatalog = false;
+				if (bLoaded)
+				{
+					ApplyStarfield();
+				}
+				else
+				{
+					UE_LOG(LogTemp, Warning, TEXT("UniversalSkyActor::ApplyStarfield - Failed to load star catalog"));
+				}
+			}));
+		}
 		return;
 	}
 
-	const TArray<FStarRecord>& Stars = StarSys->GetStars();
+	// Render buffers: sorted brightest first, colours precomputed, no strings
+	const FStarRenderBuffers& Stars = StarSys->GetRenderBuffers();
 	const int32 TotalStarCount = Stars.Num();
 	if (TotalStarCount <= 0)
 	{
@@ -651,14 +881,15 @@ void AUniversalSkyActor::ApplyStarfield()
 		return;
 	}
 
-	// Build filtered arrays with magnitude culling
-	// Only rebuild if not yet initialized or if configuration changed
-	if (!bStarfieldInitialized || CachedStarCount != TotalStarCount)
+	// Upload once per catalog (or sphere radius): every star, brightest first.
+	// Magnitude limits and scalability only change how many of them are spawned.
+	if (!bStarfieldInitialized || CachedStarCount != TotalStarCount || CachedStarSphereRadiusCm != StarSphereRadiusCm)
 	{
 		/* ================================================================================
 		 * STARFIELD DATA PIPELINE: C++ → NIAGARA
 		 * ================================================================================
-		 * We generate 3 parallel arrays for Niagara consumption:
+		 * We upload 3 parallel arrays for Niagara consumption, sorted by magnitude
+		 * (brightest first) so the stars visible at any limit are the first StarCount:
 		 *
 		 * 1. StarPositions (TArray<FVector>) → User.StarPositions (Niagara Array Position)
 		 *    - Absolute positions in local space (normalized dir × StarSphereRadius)
@@ -672,105 +903,53 @@ void AUniversalSkyActor::ApplyStarfield()
 		 * 3. StarColors (TArray<FLinearColor>) → User.StarColors (Niagara Array Color)
 		 *    - Processed RGB colors derived from B-V index (blue stars ~-0.3, Sun ~+0.65, red giants ~+2.0)
 		 *    - Used for sprite color by spectral class (O, B, A, F, G, K, M types)
+		 *
+		 * The array data interfaces keep their copies, so later limit changes touch only
+		 * User.StarCount (see UpdateStarfieldVisibleCount).
 		 * ================================================================================ */
 
+		// Positions are the only per-star work: unit direction scaled onto the sphere
 		TArray<FVector> StarPositions;       // Absolute positions on sphere
-		TArray<float> StarMagnitudes;        // Apparent magnitude for brightness
-		TArray<FLinearColor> StarColors;     // Processed RGB colors from B-V index
-		
-		// Reserve max possible size (all stars)
-		StarPositions.Reserve(TotalStarCount);
-		StarMagnitudes.Reserve(TotalStarCount);
-		StarColors.Reserve(TotalStarCount);
-
-		// Filter and build arrays
-		int32 CulledCount = 0;
-		for (const FStarRecord& Star : Stars)
+		StarPositions.SetNumUninitialized(TotalStarCount);
+		for (int32 StarIndex = 0; StarIndex < TotalStarCount; StarIndex++)
 		{
-			// Apply magnitude culling (dimmer stars have higher magnitude)
-			if (Star.Mag > MaxVisibleMagnitude)
-			{
-				CulledCount++;
-				continue;
-			}
-
-			// Convert FVector3f to FVector and normalize
-			FVector Dir = FVector(Star.DirEquatorial.X, Star.DirEquatorial.Y, Star.DirEquatorial.Z);
-			FVector NormalizedDir = Dir.GetSafeNormal();
-			if (NormalizedDir.IsNearlyZero())
-			{
-				NormalizedDir = FVector::ForwardVector; // Fallback to avoid zero vectors
-				UE_LOG(LogTemp, Warning, TEXT("UniversalSkyActor::ApplyStarfield - Near-zero star direction detected, using fallback"));
-			}
-
-			// Scale normalized direction by sphere radius to get absolute position
-			FVector Position = NormalizedDir * StarSphereRadiusCm;
-
-			// Convert B-V color index to RGB color
-			FLinearColor StarColor = BVIndexToColor(Star.CI);
-
-			// Add to arrays (indices must stay aligned!)
-			StarPositions.Add(Position);
-			StarMagnitudes.Add(Star.Mag);
-			StarColors.Add(StarColor);
+			StarPositions[StarIndex] = FVector(Stars.Directions[StarIndex]) * StarSphereRadiusCm;
 		}
 
-		const int32 VisibleStarCount = StarPositions.Num();
+		// CRITICAL: Use SetNiagaraArrayPosition for spatial data (not SetNiagaraArrayVector)
+		// NOTE: Niagara converts User.ParameterName to User_ParameterName automatically
+		UNiagaraDataInterfaceArrayFunctionLibrary::SetNiagaraArrayPosition(StarfieldComponent, FName(TEXT("User_StarPositions")), StarPositions);
+		UNiagaraDataInterfaceArrayFunctionLibrary::SetNiagaraArrayFloat(StarfieldComponent, FName(TEXT("User_StarMagnitudes")), Stars.Magnitudes);
+		UNiagaraDataInterfaceArrayFunctionLibrary::SetNiagaraArrayColor(StarfieldComponent, FName(TEXT("User_StarColors")), Stars.Colors);
 
-		// Production-ready logging
-		UE_LOG(LogTemp, Log, TEXT("UniversalSkyActor::ApplyStarfield - Filtered %d/%d stars (culled %d dimmer than mag %.1f)"),
-			VisibleStarCount, TotalStarCount, CulledCount, MaxVisibleMagnitude);
+		UE_LOG(LogTemp, Log, TEXT("UniversalSkyActor::ApplyStarfield - Pushed arrays to Niagara: Positions=%d, Magnitudes=%d, Colors=%d"),
+			StarPositions.Num(), Stars.Magnitudes.Num(), Stars.Colors.Num());
 
-		// Push arrays to Niagara using UE 5.7 Data Interface Array Function Library
-		if (VisibleStarCount > 0)
+		// Debug: Log first 3 star data with RGB colors
+		for (int32 i = 0; i < FMath::Min(3, StarPositions.Num()); i++)
 		{
-			// CRITICAL: Use SetNiagaraArrayPosition for spatial data (not SetNiagaraArrayVector)
-			// NOTE: Niagara converts User.ParameterName to User_ParameterName automatically
-			UNiagaraDataInterfaceArrayFunctionLibrary::SetNiagaraArrayPosition(StarfieldComponent, FName(TEXT("User_StarPositions")), StarPositions);
-			UNiagaraDataInterfaceArrayFunctionLibrary::SetNiagaraArrayFloat(StarfieldComponent, FName(TEXT("User_StarMagnitudes")), StarMagnitudes);
-			UNiagaraDataInterfaceArrayFunctionLibrary::SetNiagaraArrayColor(StarfieldComponent, FName(TEXT("User_StarColors")), StarColors);
-
-			UE_LOG(LogTemp, Log, TEXT("UniversalSkyActor::ApplyStarfield - Pushed arrays to Niagara: Positions=%d, Magnitudes=%d, Colors=%d"),
-				StarPositions.Num(), StarMagnitudes.Num(), StarColors.Num());
-			
-			// Debug: Log first 3 star data with RGB colors
-			for (int32 i = 0; i < FMath::Min(3, StarPositions.Num()); i++)
-			{
-				UE_LOG(LogTemp, Log, TEXT("  Star[%d]: Pos=(%.1f, %.1f, %.1f), Mag=%.2f, Color=(R:%.2f G:%.2f B:%.2f)"),
-					i, StarPositions[i].X, StarPositions[i].Y, StarPositions[i].Z, 
-					StarMagnitudes[i], StarColors[i].R, StarColors[i].G, StarColors[i].B);
-			}
+			UE_LOG(LogTemp, Log, TEXT("  Star[%d]: Pos=(%.1f, %.1f, %.1f), Mag=%.2f, Color=(R:%.2f G:%.2f B:%.2f)"),
+				i, StarPositions[i].X, StarPositions[i].Y, StarPositions[i].Z,
+				Stars.Magnitudes[i], Stars.Colors[i].R, Stars.Colors[i].G, Stars.Colors[i].B);
 		}
 
-		// Set scalar user parameters to match filtered arrays
 		// NOTE: Niagara converts dots to underscores in parameter names
-		StarfieldComponent->SetVariableInt(FName(TEXT("User_StarCount")), VisibleStarCount);
 		StarfieldComponent->SetVariableFloat(FName(TEXT("User_StarSphereRadius")), StarSphereRadiusCm);
 
 		// Mark as initialized
 		bStarfieldInitialized = true;
 		CachedStarCount = TotalStarCount;
+		CachedStarSphereRadiusCm = StarSphereRadiusCm;
+		CachedVisibleStarCount = INDEX_NONE;
+		UpdateStarfieldVisibleCount();
+
+		UE_LOG(LogTemp, Log, TEXT("UniversalSkyActor::ApplyStarfield - Starfield uploaded successfully. Stars=%d, SphereRadius=%.0f cm"),
+			TotalStarCount, StarSphereRadiusCm);
 
-		UE_LOG(LogTemp, Log, TEXT("UniversalSkyActor::ApplyStarfield - Starfield initialized successfully. VisibleStars=%d, SphereRadius=%.0f cm"),
-			VisibleStarCount, StarSphereRadiusCm);
-		
-		// DIAGNOSTIC: Log Niagara parameter values to verify data reception
-		bool bStarCountValid = false;
-		bool bSphereRadiusValid = false;
-		int32 VerifyStarCount = StarfieldComponent->GetVariableInt(FName(TEXT("User_StarCount")), bStarCountValid);
-		float VerifySphereRadius = StarfieldComponent->GetVariableFloat(FName(TEXT("User_StarSphereRadius")), bSphereRadiusValid);
-		
-		UE_LOG(LogTemp, Warning, TEXT("🔍 NIAGARA DIAGNOSTICS:"));
-		UE_LOG(LogTemp, Warning, TEXT("  └─ User_StarCount read back: %d (valid: %d, expected: %d)"), VerifyStarCount, bStarCountValid, VisibleStarCount);
-		UE_LOG(LogTemp, Warning, TEXT("  └─ User_StarSphereRadius read back: %.1f (valid: %d, expected: %.1f)"), VerifySphereRadius, bSphereRadiusValid, StarSphereRadiusCm);
-		UE_LOG(LogTemp, Warning, TEXT("  └─ Component Location: %s"), *StarfieldComponent->GetComponentLocation().ToString());
-		UE_LOG(LogTemp, Warning, TEXT("  └─ Component Visibility: %d"), StarfieldComponent->IsVisible());
-		UE_LOG(LogTemp, Warning, TEXT("  └─ Component World Scale: %s"), *StarfieldComponent->GetComponentScale().ToString());
-		
 		// Force component to acknowledge changes
 		StarfieldComponent->ReinitializeSystem();
 		UE_LOG(LogTemp, Log, TEXT("UniversalSkyActor::ApplyStarfield - Reinitialized Niagara system"));
-		
+
 		// CRITICAL: Force skylight recapture after initializing starfield and sun
 		// This updates Lumen GI with procedural sky data
 		if (SkyLight)
@@ -779,6 +958,10 @@ void AUniversalSkyActor::ApplyStarfield()
 			UE_LOG(LogTemp, Warning, TEXT("🌤️ SKYLIGHT RECAPTURED after starfield initialization"));
 		}
 	}
+	else
+	{
+		UpdateStarfieldVisibleCount();
+	}
 
 	// Verify component state
 	UE_LOG(LogTemp, Log, TEXT("UniversalSkyActor::ApplyStarfield - Component Active=%d, Asset=%s"),
@@ -800,9 +983,11 @@ void AUniversalSkyActor::ApplyStarfield()
 	 * User.StarPositions        Position Array    Absolute positions on celestial sphere (cm)
 	 * User.StarMagnitudes       Float Array       Apparent magnitude (lower = brighter)
 	 * User.StarColorIndices     Float Array       B-V color index for spectral classification
-	 * User.StarCount            Int               Number of visible stars (after culling)
+	 * User.StarCount            Int               Stars to spawn: a prefix of the magnitude-sorted arrays
 	 * User.StarSphereRadius     Float             Sphere radius in cm (default 1mkm = 1000000)
-	 * User.RotationAngle        Float             GMST rotation in degrees (updated per frame)
+	 * User.RotationAngle        Float             GMST in degrees at User.RotationEpochTime
+	 * User.RotationRate         Float             GMST degrees per second of Engine.Time (0 when paused)
+	 * User.RotationEpochTime    Float             Engine.Time (world seconds) the angle was sampled at
 	 * -------------------------------------------------------------------------------
 	 *
 	 * ┌─────────────────────────────────────────────────────────────────────────────┐
@@ -810,22 +995,25 @@ void AUniversalSkyActor::ApplyStarfield()
 	 * └─────────────────────────────────────────────────────────────────────────────┘
 	 * • For 5000+ stars, use GPU Compute Sim (GPUComputeSim) for better performance
 	 * • Enable Niagara Culling by distance (cull stars beyond camera far plane)
-	 * • Consider LOD: reduce StarCount based on camera distance or performance budget
+	 * • LOD is built in: StarCount follows MaxVisibleMagnitude and the effects-quality
+	 *   tier (StarfieldQualityMagnitudeLimits); spawn only Index < StarCount
 	 * • Use material complexity view to ensure star material is lightweight
 	 * • Profile with "stat Niagara" and "stat GPU" to measure overhead
 	 *
 	 * ┌─────────────────────────────────────────────────────────────────────────────┐
 	 * │ SIDEREAL TIME ROTATION NOTES                                                │
 	 * └─────────────────────────────────────────────────────────────────────────────┘
-	 * • C++ updates User.RotationAngle every frame based on GMST (Greenwich Mean
-	 *   Sidereal Time) from SolarSystemSubsystem
+	 * • C++ sets an epoch only when the sim clock rate (pause/time scale/clock mode)
+	 *   or the game epoch changes; the Update stack computes the angle per frame:
+	 *     Angle = User.RotationAngle + User.RotationRate * (Engine.Time - User.RotationEpochTime)
+	 *   (GMST = Greenwich Mean Sidereal Time, from SolarSystemSubsystem)
 	 * • GMST tracks Earth's rotation relative to distant stars (23h 56m 4s period)
 	 * • Rotation is applied in Update stack around celestial north pole (Z-axis)
 	 * • Ensure actor's Local Space = FALSE so rotation is in world coordinates
 	 * • If sky dome also rotates, ensure consistent rotation center/axis
 	 * • For accuracy, verify celestial pole alignment with your world's +Z axis
-	 * • Alternative: Use Emitter.Age × (360° / 86164s) for constant rotation without
-	 *   depending on subsystem (less accurate but simpler for prototyping)
+	 * • Don't use Emitter.Age for the elapsed term: ResetSystem (star count changes)
+	 *   restarts it, Engine.Time does not
 	 *
 	 * ================================================================================ */
 }
@@ -838,63 +1026,134 @@ void AUniversalSkyActor::UpdateStarfieldRotation()
 	}
 
 	UGameInstance* GI = GetGameInstance();
-	if (!GI)
+	UWorld* World = GetWorld();
+	if (!GI || !World)
 	{
 		return;
 	}
 
-	// Update rotation based on GMST (lightweight, called at StarfieldUpdateRateHz)
-	if (USolarSystemSubsystem* SolarSys = GI->GetSubsystem<USolarSystemSubsystem>())
+	USolarSystemSubsystem* SolarSys = GI->GetSubsystem<USolarSystemSubsystem>();
+	if (!SolarSys)
 	{
-		const double GMST = SolarSys->GetGMSTAngleRad();
-		const float GMSTDegrees = FMath::RadiansToDegrees(static_cast<float>(GMST));
-		// NOTE: Niagara converts dots to underscores in parameter names
-		StarfieldComponent->SetVariableFloat(FName(TEXT("User_RotationAngle")), GMSTDegrees);
+		return;
+	}
+
+	// Sim time advances by world delta x sim rate, so GMST is linear in Engine.Time
+	// until the rate or epoch changes:
+	//   RotationAngle(t) = User.RotationAngle + User.RotationRate * (t - User.RotationEpochTime)
+	const UTimeSubsystem* TimeSys = GI->GetSubsystem<UTimeSubsystem>();
+	const double SimRate = TimeSys ? TimeSys->GetSimRate() : 0.0;
+
+	const float GMSTDegrees = FMath::RadiansToDegrees(static_cast<float>(SolarSys->GetGMSTAngleRad()));
+	const float RateDegreesPerSecond = static_cast<float>(SiderealDegreesPerSimSecond * SimRate);
+
+	// NOTE: Niagara converts dots to underscores in parameter names
+	StarfieldComponent->SetVariableFloat(FName(TEXT("User_RotationAngle")), GMSTDegrees);
+	StarfieldComponent->SetVariableFloat(FName(TEXT("User_RotationRate")), RateDegreesPerSecond);
+	StarfieldComponent->SetVariableFloat(FName(TEXT("User_RotationEpochTime")), World->GetTimeSeconds());
+
+	UE_LOG(LogTemp, Verbose, TEXT("UniversalSkyActor: Starfield epoch GMST=%.3f deg, rate=%.6f deg/s"), GMSTDegrees, RateDegreesPerSecond);
+}
+
+void AUniversalSkyActor::ApplyStarMaterial()
+{
+	// Cooked asset + MID: no material compilation at runtime
+	UMaterialInterface* BaseMaterial = StarMaterial.LoadSynchronous();
+	if (!BaseMaterial)
+	{
+		if (!StarMaterial.IsNull())
+		{
+			UE_LOG(LogTemp, Warning, TEXT("UniversalSkyActor: Star material %s not found. Generate it in the editor with TPF.Editor.CreateStarMaterial"),
+				*StarMaterial.ToString());
+		}
+		return;
+	}
+
+	StarMaterialInstance = UMaterialInstanceDynamic::Create(BaseMaterial, this);
+	StarMaterialInstance->SetScalarParameterValue(FName("StarBrightness"), StarBrightness);
+	StarfieldComponent->SetMaterial(0, StarMaterialInstance);
+	UE_LOG(LogTemp, Log, TEXT("UniversalSkyActor: Applied star material %s"), *BaseMaterial->GetName());
+}
+
+void AUniversalSkyActor::SetStarBrightness(float InBrightness)
+{
+	StarBrightness = InBrightness;
+	if (StarMaterialInstance)
+	{
+		StarMaterialInstance->SetScalarParameterValue(FName("StarBrightness"), StarBrightness);
 	}
 }
 
+float AUniversalSkyActor::GetEffectiveStarMagnitudeLimit() const
+{
+	float Limit = MaxVisibleMagnitude;
+	if (StarfieldQualityMagnitudeLimits.Num() > 0)
+	{
+		// Cinematic (and anything past the table) uses the last entry
+		const int32 Quality = FMath::Clamp(Scalability::GetQualityLevels().EffectsQuality, 0, StarfieldQualityMagnitudeLimits.Num() - 1);
+		Limit = FMath::Min(Limit, StarfieldQualityMagnitudeLimits[Quality]);
+	}
+	return Limit;
+}
+
+void AUniversalSkyActor::RefreshStarfieldVisibility()
+{
+	UpdateStarfieldVisibleCount();
+}
+
+void AUniversalSkyActor::UpdateStarfieldVisibleCount()
+{
+	if (!bStarfieldInitialized || !StarfieldComponent)
+	{
+		return;
+	}
+
+	const UGameInstance* GI = GetGameInstance();
+	const UStarCatalogSubsystem* StarSys = GI ? GI->GetSubsystem<UStarCatalogSubsystem>() : nullptr;
+	if (!StarSys)
+	{
+		return;
+	}
+
+	const float Limit = GetEffectiveStarMagnitudeLimit();
+	const int32 VisibleStarCount = StarSys->GetRenderBuffers().CountVisible(Limit);
+	if (VisibleStarCount == CachedVisibleStarCount)
+	{
+		return;
+	}
+
+	// Uploaded arrays stay as they are; only the spawn count changes
+	StarfieldComponent->SetVariableInt(FName(TEXT("User_StarCount")), VisibleStarCount);
+	if (CachedVisibleStarCount != INDEX_NONE)
+	{
+		// Stars are a spawn burst, so respawn them against the new count
+		StarfieldComponent->ResetSystem();
+	}
+	CachedVisibleStarCount = VisibleStarCount;
+
+	UE_LOG(LogTemp, Log, TEXT("UniversalSkyActor::ApplyStarfield - Drawing %d/%d stars (culled %d dimmer than mag %.1f)"),
+		VisibleStarCount, CachedStarCount, CachedStarCount - VisibleStarCount, Limit);
+}
+
+void AUniversalSkyActor::HandleScalabilityChanged(const Scalability::FQualityLevels& QualityLevels)
+{
+	UpdateStarfieldVisibleCount();
+}
+
+void AUniversalSkyActor::HandleWorldOriginRebased(const FIntVector& ShiftCm)
+{
+	// The actor itself moved with the shift; respawn stars around its new location
+	if (StarfieldComponent)
+	{
+		StarfieldComponent->ResetSystem();
+	}
+
+	RequestSkyRecapture();
+}
+
 FLinearColor AUniversalSkyActor::BVIndexToColor(float BV) const
 {
-	/* ================================================================================
-	 * B-V COLOR INDEX TO RGB CONVERSION
-	 * ================================================================================
-	 * Physically accurate stellar colors based on B-V color index.
-	 * B-V represents the difference between blue and visual magnitude.
-	 * Temperature correlation: BV = -0.3 (~30000K) to BV = 2.0 (~3000K)
-	 *
-	 * Spectral Classifications (Harvard System):
-	 * O-type: BV < -0.20  (Hot blue stars: Rigel, Zeta Puppis)
-	 * B-type: BV < 0.00   (Blue-white stars: Spica, Achernar)
-	 * A-type: BV < 0.30   (White stars: Vega, Sirius)
-	 * F-type: BV < 0.60   (Yellow-white stars: Procyon, Canopus)
-	 * G-type: BV < 0.80   (Yellow stars: Sun, Alpha Centauri A)
-	 * K-type: BV < 1.20   (Orange stars: Arcturus, Aldebaran)
-	 * M-type: BV >= 1.20  (Red stars: Betelgeuse, Antares)
-	 *
-	 * RGB values derived from blackbody radiation curves and atmospheric effects.
-	 * Alpha = 1.0 for all stars (emissive material handles brightness via magnitude).
-	 * ================================================================================ */
-	
-	if (BV < -0.20f)  // O-type: Hot blue stars
-		return FLinearColor(0.61f, 0.73f, 1.00f, 1.0f);
-	
-	if (BV < 0.00f)   // B-type: Blue-white stars
-		return FLinearColor(0.78f, 0.87f, 1.00f, 1.0f);
-	
-	if (BV < 0.30f)   // A-type: White stars
-		return FLinearColor(0.96f, 0.97f, 1.00f, 1.0f);
-	
-	if (BV < 0.60f)   // F-type: Yellow-white stars
-		return FLinearColor(1.00f, 0.98f, 0.92f, 1.0f);
-	
-	if (BV < 0.80f)   // G-type: Yellow stars (like our Sun)
-		return FLinearColor(1.00f, 0.93f, 0.74f, 1.0f);
-	
-	if (BV < 1.20f)   // K-type: Orange stars
-		return FLinearColor(1.00f, 0.82f, 0.56f, 1.0f);
-	
-	// M-type: Red stars (BV >= 1.20)
-	return FLinearColor(1.00f, 0.65f, 0.38f, 1.0f);
+	return UCelestialMathLibrary::StarColor_FromBVIndex(BV);
 }
 
 void AUniversalSkyActor::SetStarfieldBounds(float BoundsRadiusCm)
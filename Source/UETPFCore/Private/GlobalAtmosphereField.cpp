@@ -3,6 +3,50 @@
 // SPDX-License-Identifier: Apache-2.0
 
 #include "GlobalAtmosphereField.h"
+#include "Async/ParallelFor.h"
+#include "Engine/World.h"
+
+namespace
+{
+	/** Lattice coordinates wrap to [0, GustLatticePeriod) before hashing */
+	constexpr uint32 GustLatticeMask = FAtmosphereModel::GustLatticePeriod - 1;
+	static_assert((FAtmosphereModel::GustLatticePeriod & GustLatticeMask) == 0, "Gust lattice period must be a power of two");
+
+	/** PCG hash of a wrapped lattice corner */
+	uint32 HashGustCorner(int32 X, int32 Y, int32 Z)
+	{
+		uint32 Hash = (uint32(X) & GustLatticeMask) | ((uint32(Y) & GustLatticeMask) << 8) | ((uint32(Z) & GustLatticeMask) << 16);
+		Hash = Hash * 747796405u + 2891336453u;
+		Hash = ((Hash >> ((Hash >> 28u) + 4u)) ^ Hash) * 277803737u;
+		return (Hash >> 22u) ^ Hash;
+	}
+
+	/** Dot product with one of the 12 cube-edge gradients (improved Perlin noise) */
+	float GustGradient(uint32 Hash, float X, float Y, float Z)
+	{
+		const uint32 H = Hash & 15u;
+		const float U = H < 8u ? X : Y;
+		const float V = H < 4u ? Y : (H == 12u || H == 14u ? X : Z);
+		return ((H & 1u) ? -U : U) + ((H & 2u) ? -V : V);
+	}
+
+	float GustFade(float T)
+	{
+		return T * T * T * (T * (T * 6.0f - 15.0f) + 10.0f);
+	}
+
+	/** One gradient-noise channel in [-1, 1] */
+	float SampleGustAxis(const FVector& LatticePoint, int32 Axis)
+	{
+		// Wrap in double first so planetary coordinates keep full precision in the float noise
+		const FVector P = LatticePoint + FVector(FAtmosphereModel::GustAxisOffsets[Axis]);
+		const double Period = FAtmosphereModel::GustLatticePeriod;
+		return FAtmosphereModel::SampleGustLattice(FVector3f(
+			FMath::Fmod(P.X, Period),
+			FMath::Fmod(P.Y, Period),
+			FMath::Fmod(P.Z, Period)));
+	}
+}
 
 //=============================================================================
 // UAtmosphereConfig
@@ -13,212 +57,326 @@ UAtmosphereConfig::UAtmosphereConfig()
 	DisplayName = FText::FromString(TEXT("Earth Standard"));
 }
 
+#if WITH_EDITOR
+void UAtmosphereConfig::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
+{
+	Super::PostEditChangeProperty(PropertyChangedEvent);
+	MarkModified();
+}
+#endif
+
 //=============================================================================
-// UGlobalAtmosphereField
+// FAtmosphereModel
 //=============================================================================
 
-UGlobalAtmosphereField::UGlobalAtmosphereField()
+FAtmosphereModel::FAtmosphereModel(const UAtmosphereConfig& Config, float WorldOriginZ)
+	: bHasConfig(true)
+	, SeaLevelAltitude(Config.SeaLevelAltitude - WorldOriginZ)
+	, SeaLevelPressure(Config.SeaLevelPressure)
+	, SeaLevelTemperature(Config.SeaLevelTemperature)
+	, SeaLevelDensity(Config.SeaLevelDensity)
+	, TemperatureLapseRate(Config.TemperatureLapseRate)
+	, PressureScaleHeight(Config.PressureScaleHeight)
+	, AtmosphereTopAltitude(Config.AtmosphereTopAltitude)
+	, VacuumDensityThreshold(Config.VacuumDensityThreshold)
+	, SpecificGasConstant(Config.SpecificGasConstant)
+	, HeatCapacityRatio(Config.HeatCapacityRatio)
+	, BaseWindVelocity(Config.BaseWindVelocity)
+	, WindAltitudeScale(Config.WindAltitudeScale)
+	, WindGustStrength(Config.WindGustStrength)
 {
-	PrimaryComponentTick.bCanEverTick = false;
-	
-	// Initialize random stream with a consistent seed for reproducibility
-	GustRandomStream.Initialize(12345);
+	BakeProfile();
 }
 
-FAtmosphereState UGlobalAtmosphereField::GetAtmosphereAtLocation(const FVector& WorldLocation) const
+void FAtmosphereModel::BakeProfile()
 {
-	FAtmosphereState State;
-
-	if (!AtmosphereConfig)
+	if (AtmosphereTopAltitude <= 0.0f)
 	{
-		// Return default Earth-like values if no config
-		return State;
+		// Nothing between sea level and the top - EvaluateAltitude falls back to the analytic model
+		return;
 	}
 
-	// Calculate altitude (in cm, relative to sea level)
-	const float AltitudeCm = WorldLocation.Z - AtmosphereConfig->SeaLevelAltitude;
-	State.Altitude = AltitudeCm;
+	TArray<FAtmosphereSample> Rows;
+	Rows.SetNumUninitialized(ProfileSampleCount);
 
-	// Check if above atmosphere top
-	if (AltitudeCm >= AtmosphereConfig->AtmosphereTopAltitude)
+	const float SpacingCm = AtmosphereTopAltitude / (ProfileSampleCount - 1);
+	for (int32 i = 0; i < ProfileSampleCount; i++)
 	{
-		// Vacuum
-		State.Pressure = 0.0f;
-		State.Density = 0.0f;
-		State.Temperature = 2.7f; // Cosmic background temperature
-		State.SpeedOfSound = 0.0f;
-		State.WindVelocity = FVector::ZeroVector;
-		State.Humidity = 0.0f;
-		State.bIsVacuum = true;
-		return State;
+		Rows[i] = EvaluateAltitudeAnalytic(i * SpacingCm);
 	}
 
-	// Calculate atmospheric properties
-	State.Temperature = GetTemperatureAtAltitude(AltitudeCm);
-	State.Pressure = GetPressureAtAltitude(AltitudeCm);
-	State.Density = GetDensityAtAltitude(AltitudeCm);
-	State.SpeedOfSound = GetSpeedOfSoundAtAltitude(AltitudeCm);
-	State.WindVelocity = GetWindAtLocation(WorldLocation);
-	
-	// Simple humidity model - decreases with altitude
-	const float AltitudeM = AltitudeCm / 100.0f;
-	State.Humidity = FMath::Clamp(1.0f - (AltitudeM / 10000.0f), 0.0f, 1.0f) * 0.5f;
-
-	// Check vacuum threshold
-	State.bIsVacuum = State.Density < AtmosphereConfig->VacuumDensityThreshold;
-
-	return State;
+	ProfileSamplesPerCm = 1.0f / SpacingCm;
+	Profile = MakeShared<const TArray<FAtmosphereSample>, ESPMode::ThreadSafe>(MoveTemp(Rows));
 }
 
-float UGlobalAtmosphereField::GetPressureAtAltitude(float AltitudeCm) const
+FAtmosphereSample FAtmosphereModel::EvaluateAltitudeAnalytic(float AltitudeCm) const
 {
-	if (!AtmosphereConfig)
+	FAtmosphereSample Sample;
+	if (!bHasConfig)
 	{
-		return 101.325f; // Default sea level pressure
+		return Sample;
 	}
 
-	// Barometric formula: P = P0 * exp(-h/H)
-	// where H is the scale height
 	const float AltitudeM = AltitudeCm / 100.0f;
-	
-	// Clamp to valid range
 	if (AltitudeM <= 0.0f)
 	{
-		return AtmosphereConfig->SeaLevelPressure;
+		Sample.Temperature = SeaLevelTemperature;
+		Sample.Pressure = SeaLevelPressure;
+		Sample.Density = SeaLevelDensity;
 	}
+	else
+	{
+		// Linear lapse rate (K per 100m), clamped at an approximate tropopause minimum
+		const float LapseRatePerMeter = TemperatureLapseRate / 100.0f;
+		Sample.Temperature = FMath::Max(SeaLevelTemperature - (LapseRatePerMeter * AltitudeM), 180.0f);
 
-	const float Exponent = -AltitudeM / AtmosphereConfig->PressureScaleHeight;
-	float Pressure = AtmosphereConfig->SeaLevelPressure * FMath::Exp(Exponent);
+		// Barometric formula: P = P0 * exp(-h/H)
+		Sample.Pressure = FMath::Max(SeaLevelPressure * FMath::Exp(-AltitudeM / PressureScaleHeight), 0.0f);
 
-	return FMath::Max(Pressure, 0.0f);
+		// Ideal gas law: ρ = P * 1000 / (R * T)  (P in kPa, need to convert to Pa)
+		Sample.Density = FMath::Max((Sample.Pressure * 1000.0f) / (SpecificGasConstant * Sample.Temperature), 0.0f);
+	}
+
+	// Speed of sound: c = sqrt(γ * R * T)
+	Sample.SpeedOfSound = IsVacuum(Sample)
+		? 0.0f
+		: FMath::Sqrt(HeatCapacityRatio * SpecificGasConstant * Sample.Temperature);
+
+	return Sample;
 }
 
-float UGlobalAtmosphereField::GetDensityAtAltitude(float AltitudeCm) const
+FAtmosphereSample FAtmosphereModel::EvaluateAltitude(float AltitudeCm) const
 {
-	if (!AtmosphereConfig)
+	if (!bHasConfig)
 	{
-		return 1.225f; // Default sea level density
+		return FAtmosphereSample();
 	}
 
-	// TODO: implement Ideal gas law: ρ = P / (R * T)
-	// But for simplicity, we use the same exponential decay as pressure
-	// (which is accurate for isothermal atmosphere)
-	
-	const float AltitudeM = AltitudeCm / 100.0f;
-	
-	if (AltitudeM <= 0.0f)
+	if (AltitudeCm >= AtmosphereTopAltitude)
 	{
-		return AtmosphereConfig->SeaLevelDensity;
+		FAtmosphereSample Vacuum;
+		Vacuum.Temperature = 2.7f; // Cosmic background temperature
+		Vacuum.Pressure = 0.0f;
+		Vacuum.Density = 0.0f;
+		Vacuum.SpeedOfSound = 0.0f;
+		return Vacuum;
 	}
 
-	// For a more accurate model, account for temperature lapse
-	const float Temperature = GetTemperatureAtAltitude(AltitudeCm);
-	const float Pressure = GetPressureAtAltitude(AltitudeCm);
-	
-	// ρ = P * 1000 / (R * T)  (P in kPa, need to convert to Pa)
-	float Density = (Pressure * 1000.0f) / (AtmosphereConfig->SpecificGasConstant * Temperature);
+	if (!Profile)
+	{
+		return EvaluateAltitudeAnalytic(AltitudeCm);
+	}
+
+	// Below sea level clamps to row 0, which is exactly the sea-level state
+	const float Position = FMath::Clamp(AltitudeCm * ProfileSamplesPerCm, 0.0f, float(ProfileSampleCount - 1));
+	const int32 Index = FMath::Min(FMath::FloorToInt32(Position), ProfileSampleCount - 2);
+	const float Alpha = Position - Index;
+
+	const FAtmosphereSample& Lo = (*Profile)[Index];
+	const FAtmosphereSample& Hi = (*Profile)[Index + 1];
+
+	FAtmosphereSample Sample;
+	Sample.Temperature = FMath::Lerp(Lo.Temperature, Hi.Temperature, Alpha);
+	Sample.Pressure = FMath::Lerp(Lo.Pressure, Hi.Pressure, Alpha);
+	Sample.Density = FMath::Lerp(Lo.Density, Hi.Density, Alpha);
 
-	return FMath::Max(Density, 0.0f);
+	// Re-test vacuum on the interpolated density so the cutoff stays sharp
+	Sample.SpeedOfSound = IsVacuum(Sample) ? 0.0f : FMath::Lerp(Lo.SpeedOfSound, Hi.SpeedOfSound, Alpha);
+
+	return Sample;
 }
 
-float UGlobalAtmosphereField::GetTemperatureAtAltitude(float AltitudeCm) const
+void FAtmosphereModel::EvaluateAltitudes(TConstArrayView<float> AltitudesCm, TArrayView<FAtmosphereSample> OutSamples) const
 {
-	if (!AtmosphereConfig)
-	{
-		return 288.15f; // Default sea level temperature
-	}
+	check(AltitudesCm.Num() == OutSamples.Num());
 
-	// Linear lapse rate model: T = T0 - L * h
-	// where L is lapse rate (K per 100m)
-	const float AltitudeM = AltitudeCm / 100.0f;
-	
-	if (AltitudeM <= 0.0f)
+	if (!Profile)
 	{
-		return AtmosphereConfig->SeaLevelTemperature;
+		for (int32 i = 0; i < AltitudesCm.Num(); i++)
+		{
+			OutSamples[i] = EvaluateAltitude(AltitudesCm[i]);
+		}
+		return;
 	}
 
-	// Lapse rate is per 100m, so convert
-	const float LapseRatePerMeter = AtmosphereConfig->TemperatureLapseRate / 100.0f;
-	float Temperature = AtmosphereConfig->SeaLevelTemperature - (LapseRatePerMeter * AltitudeM);
-
-	// In reality, temperature stops decreasing around tropopause (~11km)
-	// and even increases in stratosphere. TODO: Implement for accuracy.
-    // for now, for simplicity, clamp at minimum.
-	const float MinTemperature = 180.0f; // Approximate tropopause minimum
-	Temperature = FMath::Max(Temperature, MinTemperature);
+	// Same lookup as EvaluateAltitude with the per-call checks hoisted out of the loop
+	const FAtmosphereSample* Rows = Profile->GetData();
+	const float MaxPosition = float(ProfileSampleCount - 1);
+	const float SamplesPerCm = ProfileSamplesPerCm;
+	const float TopAltitude = AtmosphereTopAltitude;
+	const float VacuumThreshold = VacuumDensityThreshold;
 
-	return Temperature;
+	for (int32 i = 0; i < AltitudesCm.Num(); i++)
+	{
+		const float AltitudeCm = AltitudesCm[i];
+		FAtmosphereSample& Sample = OutSamples[i];
+		if (AltitudeCm >= TopAltitude)
+		{
+			Sample.Temperature = 2.7f;
+			Sample.Pressure = 0.0f;
+			Sample.Density = 0.0f;
+			Sample.SpeedOfSound = 0.0f;
+			continue;
+		}
+
+		const float Position = FMath::Clamp(AltitudeCm * SamplesPerCm, 0.0f, MaxPosition);
+		const int32 Index = FMath::Min(FMath::FloorToInt32(Position), ProfileSampleCount - 2);
+		const float Alpha = Position - Index;
+
+		const FAtmosphereSample& Lo = Rows[Index];
+		const FAtmosphereSample& Hi = Rows[Index + 1];
+
+		Sample.Temperature = FMath::Lerp(Lo.Temperature, Hi.Temperature, Alpha);
+		Sample.Pressure = FMath::Lerp(Lo.Pressure, Hi.Pressure, Alpha);
+		Sample.Density = FMath::Lerp(Lo.Density, Hi.Density, Alpha);
+		Sample.SpeedOfSound = Sample.Density < VacuumThreshold ? 0.0f : FMath::Lerp(Lo.SpeedOfSound, Hi.SpeedOfSound, Alpha);
+	}
 }
 
-float UGlobalAtmosphereField::GetSpeedOfSoundAtAltitude(float AltitudeCm) const
+void FAtmosphereModel::Evaluate(const FVector& WorldLocation, FAtmosphereState& State, double TimeSeconds) const
 {
-	if (!AtmosphereConfig)
+	if (!bHasConfig)
 	{
-		return 343.0f; // Default sea level speed of sound
+		// Default Earth-like values if no config
+		State = FAtmosphereState();
+		return;
 	}
 
-	// Speed of sound: c = sqrt(γ * R * T)
-	const float Temperature = GetTemperatureAtAltitude(AltitudeCm);
-	
-	// Check for near-vacuum conditions
-	const float Density = GetDensityAtAltitude(AltitudeCm);
-	if (Density < AtmosphereConfig->VacuumDensityThreshold)
+	// Calculate altitude (in cm, relative to sea level)
+	const float AltitudeCm = WorldLocation.Z - SeaLevelAltitude;
+	State.Altitude = AltitudeCm;
+
+	// Check if above atmosphere top
+	if (AltitudeCm >= AtmosphereTopAltitude)
 	{
-		return 0.0f; // No sound propagation in vacuum
+		// Vacuum
+		State.Pressure = 0.0f;
+		State.Density = 0.0f;
+		State.Temperature = 2.7f; // Cosmic background temperature
+		State.SpeedOfSound = 0.0f;
+		State.WindVelocity = FVector::ZeroVector;
+		State.Humidity = 0.0f;
+		State.bIsVacuum = true;
+		return;
 	}
 
-	const float SpeedOfSound = FMath::Sqrt(
-		AtmosphereConfig->HeatCapacityRatio * 
-		AtmosphereConfig->SpecificGasConstant * 
-		Temperature
-	);
+	// Same profile as the Get*AtAltitude functions
+	const FAtmosphereSample Sample = EvaluateAltitude(AltitudeCm);
+	State.Temperature = Sample.Temperature;
+	State.Pressure = Sample.Pressure;
+	State.Density = Sample.Density;
+	State.SpeedOfSound = Sample.SpeedOfSound;
+	State.bIsVacuum = IsVacuum(Sample);
+	State.WindVelocity = GetWindAtLocation(WorldLocation, TimeSeconds);
 
-	return SpeedOfSound;
+	// Simple humidity model - decreases with altitude
+	const float AltitudeM = AltitudeCm / 100.0f;
+	State.Humidity = FMath::Clamp(1.0f - (AltitudeM / 10000.0f), 0.0f, 1.0f) * 0.5f;
 }
 
-FVector UGlobalAtmosphereField::GetWindAtLocation(const FVector& WorldLocation) const
+FVector FAtmosphereModel::GetWindAtLocation(const FVector& WorldLocation, double TimeSeconds) const
 {
-	if (!AtmosphereConfig)
+	if (!bHasConfig)
 	{
 		return FVector::ZeroVector;
 	}
 
 	// Start with base wind
-	FVector Wind = AtmosphereConfig->BaseWindVelocity;
+	FVector Wind = BaseWindVelocity;
 
 	// Scale with altitude
-	const float AltitudeCm = WorldLocation.Z - AtmosphereConfig->SeaLevelAltitude;
+	const float AltitudeCm = WorldLocation.Z - SeaLevelAltitude;
 	const float AltitudeM = FMath::Max(AltitudeCm / 100.0f, 0.0f);
 	
 	// Wind typically increases with altitude (logarithmic profile simplified to linear)
-	const float AltitudeMultiplier = 1.0f + (AltitudeM / 1000.0f) * AtmosphereConfig->WindAltitudeScale;
+	const float AltitudeMultiplier = 1.0f + (AltitudeM / 1000.0f) * WindAltitudeScale;
 	Wind *= AltitudeMultiplier;
 
 	// Add gust noise
-	if (AtmosphereConfig->WindGustStrength > 0.0f)
+	if (WindGustStrength > 0.0f)
 	{
-		Wind += CalculateGustNoise(WorldLocation);
+		Wind += GetGustNoise(WorldLocation, TimeSeconds);
 	}
 
 	return Wind;
 }
 
-bool UGlobalAtmosphereField::IsVacuumAtAltitude(float AltitudeCm) const
+FVector FAtmosphereModel::GetGustNoise(const FVector& Location, double TimeSeconds) const
 {
-	if (!AtmosphereConfig)
+	if (!bHasConfig || WindGustStrength <= 0.0f)
 	{
-		return false;
+		return FVector::ZeroVector;
 	}
 
-	const float Density = GetDensityAtAltitude(AltitudeCm);
-	return Density < AtmosphereConfig->VacuumDensityThreshold;
+	const FVector LatticePoint = GetGustLatticePoint(Location, TimeSeconds);
+	const float NoiseX = SampleGustAxis(LatticePoint, 0);
+	const float NoiseY = SampleGustAxis(LatticePoint, 1);
+	const float NoiseZ = SampleGustAxis(LatticePoint, 2);
+
+	FVector Gust(NoiseX, NoiseY, NoiseZ * 0.3f); // Less vertical variation
+	Gust *= GetGustAmplitude();
+
+	return Gust;
 }
 
-FEnvironmentContext UGlobalAtmosphereField::CreateEnvironmentContextAtLocation(const FVector& WorldLocation) const
+FVector FAtmosphereModel::GetGustLatticePoint(const FVector& Location, double TimeSeconds) const
 {
-	FEnvironmentContext Context;
+	// Frozen turbulence: the gust pattern is carried along by the base wind,
+	// and drifts through the lattice's third axis so it also changes in place
+	FVector LatticePoint = (Location - BaseWindVelocity * TimeSeconds) * GustSpatialFrequency;
+	LatticePoint.Z += TimeSeconds * GustEvolutionRate;
+	return LatticePoint;
+}
+
+float FAtmosphereModel::GetGustAmplitude() const
+{
+	if (!bHasConfig || WindGustStrength <= 0.0f)
+	{
+		return 0.0f;
+	}
+
+	// Gusts scale with the base wind, with a default magnitude if there is none
+	float BaseWindMagnitude = BaseWindVelocity.Size();
+	if (BaseWindMagnitude < 1.0f)
+	{
+		BaseWindMagnitude = 100.0f;
+	}
+	return BaseWindMagnitude * WindGustStrength;
+}
 
-	FAtmosphereState AtmoState = GetAtmosphereAtLocation(WorldLocation);
+const FVector3f FAtmosphereModel::GustAxisOffsets[3] =
+{
+	FVector3f(0.0f, 0.0f, 0.0f),
+	FVector3f(71.3f, 19.7f, 43.1f),
+	FVector3f(137.9f, 101.3f, 11.5f),
+};
+
+float FAtmosphereModel::SampleGustLattice(const FVector3f& P)
+{
+	const int32 X = FMath::FloorToInt32(P.X);
+	const int32 Y = FMath::FloorToInt32(P.Y);
+	const int32 Z = FMath::FloorToInt32(P.Z);
+	const float FX = P.X - X;
+	const float FY = P.Y - Y;
+	const float FZ = P.Z - Z;
+	const float U = GustFade(FX);
+	const float V = GustFade(FY);
+	const float W = GustFade(FZ);
+
+	auto Corner = [X, Y, Z, FX, FY, FZ](int32 DX, int32 DY, int32 DZ)
+	{
+		return GustGradient(HashGustCorner(X + DX, Y + DY, Z + DZ), FX - DX, FY - DY, FZ - DZ);
+	};
+
+	return FMath::Lerp(
+		FMath::Lerp(FMath::Lerp(Corner(0, 0, 0), Corner(1, 0, 0), U), FMath::Lerp(Corner(0, 1, 0), Corner(1, 1, 0), U), V),
+		FMath::Lerp(FMath::Lerp(Corner(0, 0, 1), Corner(1, 0, 1), U), FMath::Lerp(Corner(0, 1, 1), Corner(1, 1, 1), U), V),
+		W);
+}
+
+FEnvironmentContext FAtmosphereModel::MakeEnvironmentContext(const FAtmosphereState& AtmoState)
+{
+	FEnvironmentContext Context;
 
 	// Map atmosphere state to environment context
 	Context.Density = AtmoState.Density;
@@ -248,43 +406,150 @@ FEnvironmentContext UGlobalAtmosphereField::CreateEnvironmentContextAtLocation(c
 }
 
 //=============================================================================
-// INTERNAL
+// UGlobalAtmosphereField
 //=============================================================================
 
-float UGlobalAtmosphereField::WorldZToAltitudeMeters(float WorldZ) const
+UGlobalAtmosphereField::UGlobalAtmosphereField()
 {
-	if (!AtmosphereConfig)
+	PrimaryComponentTick.bCanEverTick = false;
+}
+
+FAtmosphereState UGlobalAtmosphereField::GetAtmosphereAtLocation(const FVector& WorldLocation) const
+{
+	FAtmosphereState State;
+	GetCachedModel().Evaluate(WorldLocation, State, GetGustTimeSeconds());
+	return State;
+}
+
+float UGlobalAtmosphereField::GetPressureAtAltitude(float AltitudeCm) const
+{
+	return GetCachedModel().EvaluateAltitude(AltitudeCm).Pressure;
+}
+
+float UGlobalAtmosphereField::GetDensityAtAltitude(float AltitudeCm) const
+{
+	return GetCachedModel().EvaluateAltitude(AltitudeCm).Density;
+}
+
+float UGlobalAtmosphereField::GetTemperatureAtAltitude(float AltitudeCm) const
+{
+	return GetCachedModel().EvaluateAltitude(AltitudeCm).Temperature;
+}
+
+float UGlobalAtmosphereField::GetSpeedOfSoundAtAltitude(float AltitudeCm) const
+{
+	return GetCachedModel().EvaluateAltitude(AltitudeCm).SpeedOfSound;
+}
+
+FVector UGlobalAtmosphereField::GetWindAtLocation(const FVector& WorldLocation) const
+{
+	return GetCachedModel().GetWindAtLocation(WorldLocation, GetGustTimeSeconds());
+}
+
+bool UGlobalAtmosphereField::IsVacuumAtAltitude(float AltitudeCm) const
+{
+	const FAtmosphereModel& Model = GetCachedModel();
+	return Model.IsVacuum(Model.EvaluateAltitude(AltitudeCm));
+}
+
+FEnvironmentContext UGlobalAtmosphereField::CreateEnvironmentContextAtLocation(const FVector& WorldLocation) const
+{
+	FAtmosphereState AtmoState;
+	GetCachedModel().Evaluate(WorldLocation, AtmoState, GetGustTimeSeconds());
+	return FAtmosphereModel::MakeEnvironmentContext(AtmoState);
+}
+
+void UGlobalAtmosphereField::CreateEnvironmentContextsAtLocations(TConstArrayView<FVector> WorldLocations,
+	TArrayView<FEnvironmentContext> OutContexts) const
+{
+	check(WorldLocations.Num() == OutContexts.Num());
+
+	// Config is read once; the model is immutable so batches share it freely
+	const FAtmosphereModel Model = GetAtmosphereModel();
+	const double TimeSeconds = GetGustTimeSeconds();
+
+	const int32 NumBatches = FMath::DivideAndRoundUp(WorldLocations.Num(), ParallelBatchSize);
+	ParallelFor(NumBatches, [&Model, TimeSeconds, WorldLocations, OutContexts](int32 BatchIndex)
 	{
-		return WorldZ / 100.0f;
-	}
+		const int32 Start = BatchIndex * ParallelBatchSize;
+		const int32 End = FMath::Min(Start + ParallelBatchSize, WorldLocations.Num());
+
+		FAtmosphereState AtmoState;
+		for (int32 i = Start; i < End; i++)
+		{
+			Model.Evaluate(WorldLocations[i], AtmoState, TimeSeconds);
+			OutContexts[i] = FAtmosphereModel::MakeEnvironmentContext(AtmoState);
+		}
+	}, NumBatches <= 1 ? EParallelForFlags::ForceSingleThread : EParallelForFlags::None);
+}
 
-	return (WorldZ - AtmosphereConfig->SeaLevelAltitude) / 100.0f;
+void UGlobalAtmosphereField::GetAtmosphereSamplesAtAltitudes(TConstArrayView<float> AltitudesCm,
+	TArrayView<FAtmosphereSample> OutSamples) const
+{
+	check(AltitudesCm.Num() == OutSamples.Num());
+
+	const FAtmosphereModel Model = GetAtmosphereModel();
+
+	const int32 NumBatches = FMath::DivideAndRoundUp(AltitudesCm.Num(), ParallelBatchSize);
+	ParallelFor(NumBatches, [&Model, AltitudesCm, OutSamples](int32 BatchIndex)
+	{
+		const int32 Start = BatchIndex * ParallelBatchSize;
+		const int32 Count = FMath::Min(ParallelBatchSize, AltitudesCm.Num() - Start);
+		Model.EvaluateAltitudes(AltitudesCm.Slice(Start, Count), OutSamples.Slice(Start, Count));
+	}, NumBatches <= 1 ? EParallelForFlags::ForceSingleThread : EParallelForFlags::None);
 }
 
-FVector UGlobalAtmosphereField::CalculateGustNoise(const FVector& Location) const
+FAtmosphereModel UGlobalAtmosphereField::GetAtmosphereModel() const
 {
-	if (!AtmosphereConfig || AtmosphereConfig->WindGustStrength <= 0.0f)
+	return GetCachedModel();
+}
+
+const FAtmosphereModel& UGlobalAtmosphereField::GetCachedModel() const
+{
+	const UAtmosphereConfig* Config = AtmosphereConfig;
+	const uint32 Revision = Config ? Config->GetRevision() : 0;
+	const float OriginZ = GetWorldOriginZ();
+
+	if (!bCachedModelValid || CachedModelConfig.Get() != Config || CachedModelRevision != Revision || CachedModelOriginZ != OriginZ)
 	{
-		return FVector::ZeroVector;
+		check(IsInGameThread());
+		CachedModel = Config ? FAtmosphereModel(*Config, OriginZ) : FAtmosphereModel();
+		CachedModelConfig = Config;
+		CachedModelRevision = Revision;
+		CachedModelOriginZ = OriginZ;
+		bCachedModelValid = true;
 	}
 
-	// Use location-based noise for spatial coherence
-	// This creates a simple Perlin-like pattern using sine waves
-	const float Scale = 0.001f; // Spatial frequency
-	
-	float NoiseX = FMath::Sin(Location.X * Scale) * FMath::Cos(Location.Y * Scale * 1.3f);
-	float NoiseY = FMath::Sin(Location.Y * Scale * 0.7f) * FMath::Cos(Location.X * Scale);
-	float NoiseZ = FMath::Sin((Location.X + Location.Y) * Scale * 0.5f);
+	return CachedModel;
+}
 
-	// Get base wind magnitude for scaling gusts
-	float BaseWindMagnitude = AtmosphereConfig->BaseWindVelocity.Size();
-	if (BaseWindMagnitude < 1.0f)
+//=============================================================================
+// INTERNAL
+//=============================================================================
+
+float UGlobalAtmosphereField::WorldZToAltitudeMeters(float WorldZ) const
+{
+	if (!AtmosphereConfig)
 	{
-		BaseWindMagnitude = 100.0f; // Default gust magnitude if no base wind
+		return WorldZ / 100.0f;
 	}
 
-	FVector Gust(NoiseX, NoiseY, NoiseZ * 0.3f); // Less vertical variation
-	Gust *= BaseWindMagnitude * AtmosphereConfig->WindGustStrength;
+	return (WorldZ + GetWorldOriginZ() - AtmosphereConfig->SeaLevelAltitude) / 100.0f;
+}
 
-	return Gust;
+float UGlobalAtmosphereField::GetWorldOriginZ() const
+{
+	const UWorld* World = GetWorld();
+	return World ? static_cast<float>(World->OriginLocation.Z) : 0.0f;
+}
+
+FVector UGlobalAtmosphereField::CalculateGustNoise(const FVector& Location) const
+{
+	return GetCachedModel().GetGustNoise(Location, GetGustTimeSeconds());
+}
+
+double UGlobalAtmosphereField::GetGustTimeSeconds() const
+{
+	const UWorld* World = GetWorld();
+	return World ? World->GetTimeSeconds() : 0.0;
 }
@@ -0,0 +1,131 @@
+// Copyright 2026 Threaded Pixel Factory
+// Licensed under the Apache License, Version 2.0 (the "License");
+// SPDX-License-Identifier: Apache-2.0
+
+#include "Space/EphemerisTable.h"
+
+namespace
+{
+	/** Clenshaw evaluation of sum(C[k] * T_k(Tau)) with the usual half-weight C[0] */
+	double EvaluateChebyshev(const double* C, int32 Num, double Tau)
+	{
+		double B1 = 0.0;
+		double B2 = 0.0;
+		const double TwoTau = 2.0 * Tau;
+		for (int32 k = Num - 1; k >= 1; k--)
+		{
+			const double B0 = TwoTau * B1 - B2 + C[k];
+			B2 = B1;
+			B1 = B0;
+		}
+		return Tau * B1 - B2 + 0.5 * C[0];
+	}
+}
+
+void FEphemerisTable::Build(double InStartJD, double InRangeDays, double InSegmentDays, int32 Degree, TFunctionRef<FVector3d(double JulianDate)> Function)
+{
+	Reset();
+
+	if (InRangeDays <= 0.0 || InSegmentDays <= 0.0 || Degree < 1)
+	{
+		return;
+	}
+
+	StartJD = InStartJD;
+	SegmentDays = InSegmentDays;
+	NumSegments = FMath::CeilToInt32(InRangeDays / InSegmentDays);
+	NumCoefficients = Degree + 1;
+	Coefficients.SetNumZeroed(NumSegments * 6 * NumCoefficients);
+
+	const int32 N = NumCoefficients;
+	TArray<FVector3d, TInlineAllocator<32>> Samples;
+	Samples.SetNumUninitialized(N);
+
+	for (int32 Segment = 0; Segment < NumSegments; Segment++)
+	{
+		const double SegmentStart = StartJD + Segment * SegmentDays;
+		const double HalfSpan = 0.5 * SegmentDays;
+		const double Mid = SegmentStart + HalfSpan;
+
+		// Sample at the Chebyshev nodes of this segment
+		for (int32 k = 0; k < N; k++)
+		{
+			const double Tau = FMath::Cos(PI * (k + 0.5) / N);
+			Samples[k] = Function(Mid + Tau * HalfSpan);
+		}
+
+		double* Value = Coefficients.GetData() + Segment * 6 * N;
+		double* Derivative = Value + 3 * N;
+
+		for (int32 Axis = 0; Axis < 3; Axis++)
+		{
+			double* C = Value + Axis * N;
+			for (int32 j = 0; j < N; j++)
+			{
+				double Sum = 0.0;
+				for (int32 k = 0; k < N; k++)
+				{
+					Sum += Samples[k][Axis] * FMath::Cos(PI * j * (k + 0.5) / N);
+				}
+				C[j] = 2.0 * Sum / N;
+			}
+
+			// Derivative series (d/dTau): D[n-1] = 2n C[n], D[k-1] = D[k+1] + 2k C[k]
+			double* D = Derivative + Axis * N;
+			for (int32 k = N - 1; k >= 1; k--)
+			{
+				D[k - 1] = (k + 1 < N ? D[k + 1] : 0.0) + 2.0 * k * C[k];
+			}
+		}
+	}
+}
+
+void FEphemerisTable::Reset()
+{
+	StartJD = 0.0;
+	SegmentDays = 1.0;
+	NumSegments = 0;
+	NumCoefficients = 0;
+	Coefficients.Empty();
+}
+
+int32 FEphemerisTable::Locate(double JulianDate, double& OutTau) const
+{
+	const double Offset = (JulianDate - StartJD) / SegmentDays;
+	const int32 Segment = FMath::Clamp(FMath::FloorToInt32(Offset), 0, NumSegments - 1);
+	OutTau = 2.0 * (Offset - Segment) - 1.0;
+	return Segment;
+}
+
+bool FEphemerisTable::Evaluate(double JulianDate, FVector3d& OutValue) const
+{
+	if (!Covers(JulianDate))
+	{
+		return false;
+	}
+
+	double Tau;
+	const double* C = GetSegment(Locate(JulianDate, Tau));
+	const int32 N = NumCoefficients;
+	OutValue = FVector3d(EvaluateChebyshev(C, N, Tau), EvaluateChebyshev(C + N, N, Tau), EvaluateChebyshev(C + 2 * N, N, Tau));
+	return true;
+}
+
+bool FEphemerisTable::Evaluate(double JulianDate, FVector3d& OutValue, FVector3d& OutRatePerDay) const
+{
+	if (!Covers(JulianDate))
+	{
+		return false;
+	}
+
+	double Tau;
+	const double* C = GetSegment(Locate(JulianDate, Tau));
+	const double* D = C + 3 * NumCoefficients;
+	const int32 N = NumCoefficients;
+	OutValue = FVector3d(EvaluateChebyshev(C, N, Tau), EvaluateChebyshev(C + N, N, Tau), EvaluateChebyshev(C + 2 * N, N, Tau));
+
+	// dTau/dJD = 2 / SegmentDays
+	const double Scale = 2.0 / SegmentDays;
+	OutRatePerDay = Scale * FVector3d(EvaluateChebyshev(D, N, Tau), EvaluateChebyshev(D + N, N, Tau), EvaluateChebyshev(D + 2 * N, N, Tau));
+	return true;
+}
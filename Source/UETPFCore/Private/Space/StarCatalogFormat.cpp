@@ -0,0 +1,306 @@
+// Copyright 2026 Threaded Pixel Factory
+// Licensed under the Apache License, Version 2.0 (the "License");
+// SPDX-License-Identifier: Apache-2.0
+
+#include "Space/StarCatalogFormat.h"
+#include "Space/Subsystems/CelestialMathLibrary.h"
+#include "HAL/FileManager.h"
+#include "Misc/Crc.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+
+static_assert(sizeof(FVector3d) == 3 * sizeof(double), "FVector3d is written to the star cache verbatim");
+
+namespace
+{
+	/** ra,dec,mag,ci are columns 4-7 */
+	constexpr int32 MinColumns = 8;
+
+	/** Longer numeric fields are truncated (the generator writes ~10 significant digits) */
+	constexpr int32 MaxNumberChars = 63;
+
+	/** Rough CSV row size, for reserving */
+	constexpr int32 ApproxRowBytes = 96;
+
+	/** Byte size of everything after the header except the string table */
+	constexpr int64 BytesPerStar = sizeof(int32) + sizeof(FVector3d) + 3 * sizeof(float) + FPackedStarCatalog::NumStrings * sizeof(int32);
+
+	/** Interning key viewing the CSV buffer (valid for one ParseCsv call) */
+	struct FStringKey
+	{
+		FAnsiStringView View;
+
+		bool operator==(const FStringKey& Other) const { return View.Equals(Other.View, ESearchCase::CaseSensitive); }
+		friend uint32 GetTypeHash(const FStringKey& Key) { return FCrc::MemCrc32(Key.View.GetData(), Key.View.Len()); }
+	};
+
+	double ParseNumber(FAnsiStringView Field)
+	{
+		ANSICHAR Buffer[MaxNumberChars + 1];
+		const int32 Len = FMath::Min(Field.Len(), MaxNumberChars);
+		FMemory::Memcpy(Buffer, Field.GetData(), Len);
+		Buffer[Len] = '\0';
+		return FCStringAnsi::Atod(Buffer);
+	}
+
+	int32 InternString(FPackedStarCatalog& Catalog, TMap<FStringKey, int32>& Interned, FAnsiStringView Field)
+	{
+		if (Field.IsEmpty())
+		{
+			return 0;
+		}
+
+		if (const int32* Existing = Interned.Find(FStringKey{ Field }))
+		{
+			return *Existing;
+		}
+
+		const int32 Offset = Catalog.StringTable.Num();
+		Catalog.StringTable.Append(Field.GetData(), Field.Len());
+		Catalog.StringTable.Add('\0');
+		Interned.Add(FStringKey{ Field }, Offset);
+		return Offset;
+	}
+
+	/** Next non-empty line, without its terminator */
+	bool NextLine(const ANSICHAR* Data, int32 Size, int32& Pos, FAnsiStringView& OutLine)
+	{
+		while (Pos < Size && (Data[Pos] == '\r' || Data[Pos] == '\n'))
+		{
+			Pos++;
+		}
+		if (Pos >= Size)
+		{
+			return false;
+		}
+
+		const int32 Start = Pos;
+		while (Pos < Size && Data[Pos] != '\r' && Data[Pos] != '\n')
+		{
+			Pos++;
+		}
+		OutLine = FAnsiStringView(Data + Start, Pos - Start);
+		return true;
+	}
+
+	template<typename T>
+	void WriteRaw(FArchive& Ar, const TArray<T>& Array)
+	{
+		// FArchive::Serialize takes a mutable pointer but only reads when saving
+		Ar.Serialize(const_cast<T*>(Array.GetData()), static_cast<int64>(Array.Num()) * sizeof(T));
+	}
+
+	template<typename T>
+	void ReadRaw(FArchive& Ar, TArray<T>& Array, int32 Num)
+	{
+		Array.SetNumUninitialized(Num);
+		Ar.Serialize(Array.GetData(), static_cast<int64>(Num) * sizeof(T));
+	}
+}
+
+//=============================================================================
+// FPackedStarCatalog
+//=============================================================================
+
+void FPackedStarCatalog::Reset()
+{
+	Ids.Reset();
+	Directions.Reset();
+	Magnitudes.Reset();
+	ColorIndices.Reset();
+	Distances.Reset();
+	StringOffsets.Reset();
+	StringTable.Reset();
+}
+
+FString FPackedStarCatalog::GetString(int32 StarIndex, EStarString Field) const
+{
+	const int32 OffsetIndex = StarIndex * NumStrings + static_cast<int32>(Field);
+	if (!StringOffsets.IsValidIndex(OffsetIndex) || !StringTable.IsValidIndex(StringOffsets[OffsetIndex]))
+	{
+		return FString();
+	}
+	return FString(UTF8_TO_TCHAR(&StringTable[StringOffsets[OffsetIndex]]));
+}
+
+//=============================================================================
+// StarCatalogFormat
+//=============================================================================
+
+bool StarCatalogFormat::GetSourceStamp(const FString& CsvPath, int32 MaxStars, FSourceStamp& OutStamp)
+{
+	const FFileStatData Stat = IFileManager::Get().GetStatData(*CsvPath);
+	if (!Stat.bIsValid || Stat.bIsDirectory)
+	{
+		return false;
+	}
+
+	OutStamp.SourceBytes = Stat.FileSize;
+	OutStamp.SourceTimestamp = Stat.ModificationTime.GetTicks();
+	OutStamp.MaxStars = MaxStars;
+	return true;
+}
+
+bool StarCatalogFormat::ParseCsv(TConstArrayView<uint8> CsvBytes, int32 MaxStars, FPackedStarCatalog& OutCatalog)
+{
+	OutCatalog.Reset();
+
+	const ANSICHAR* Data = reinterpret_cast<const ANSICHAR*>(CsvBytes.GetData());
+	const int32 Size = CsvBytes.Num();
+	int32 Pos = 0;
+
+	// The generator writes UTF-8; skip its BOM if present
+	if (Size >= 3 && CsvBytes[0] == 0xEF && CsvBytes[1] == 0xBB && CsvBytes[2] == 0xBF)
+	{
+		Pos = 3;
+	}
+
+	// Header expectations (from the generator):
+	// id,name,proper,bf,ra,dec,mag,ci,dist,x,y,z,spect,con
+	FAnsiStringView Line;
+	if (!NextLine(Data, Size, Pos, Line))
+	{
+		return false;
+	}
+
+	const FString Header(Line);
+	if (!Header.Contains(TEXT("ra"))
+	|| !Header.Contains(TEXT("dec"))
+	|| !Header.Contains(TEXT("mag"))
+	|| !Header.Contains(TEXT("ci")))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("[StarCatalog] CSV header unexpected. Using positional parse anyway."));
+	}
+
+	const int32 ReserveStars = FMath::Min(MaxStars, Size / ApproxRowBytes + 1);
+	OutCatalog.Ids.Reserve(ReserveStars);
+	OutCatalog.Directions.Reserve(ReserveStars);
+	OutCatalog.Magnitudes.Reserve(ReserveStars);
+	OutCatalog.ColorIndices.Reserve(ReserveStars);
+	OutCatalog.Distances.Reserve(ReserveStars);
+	OutCatalog.StringOffsets.Reserve(ReserveStars * FPackedStarCatalog::NumStrings);
+
+	// Offset 0 is the shared empty string
+	OutCatalog.StringTable.Add('\0');
+	TMap<FStringKey, int32> Interned;
+
+	TArray<FAnsiStringView, TInlineAllocator<32>> Cols;
+	while (OutCatalog.Num() < MaxStars && NextLine(Data, Size, Pos, Line))
+	{
+		Cols.Reset();
+		int32 FieldStart = 0;
+		for (int32 i = 0; i < Line.Len(); i++)
+		{
+			if (Line[i] == ',')
+			{
+				Cols.Add(Line.Mid(FieldStart, i - FieldStart));
+				FieldStart = i + 1;
+			}
+		}
+		Cols.Add(Line.RightChop(FieldStart));
+
+		if (Cols.Num() < MinColumns) continue; // need at least ra,dec,mag,ci
+
+		// 0:id 1:name 2:proper 3:bf 4:ra 5:dec 6:mag 7:ci 8:dist 9:x 10:y 11:z 12:spect 13:con
+		const double RaHours = ParseNumber(Cols[4]);
+		const double DecDeg = ParseNumber(Cols[5]);
+		const float Mag = static_cast<float>(ParseNumber(Cols[6]));
+		if (!FMath::IsFinite(RaHours) || !FMath::IsFinite(DecDeg) || !FMath::IsFinite(Mag))
+		{
+			continue;
+		}
+
+		const FVector3d Dir = UCelestialMathLibrary::EquatorialDir_FromRaDec(RaHours, DecDeg);
+		if (Dir.IsNearlyZero()) continue;
+
+		OutCatalog.Ids.Add(static_cast<int32>(ParseNumber(Cols[0])));
+		OutCatalog.Directions.Add(Dir);
+		OutCatalog.Magnitudes.Add(Mag);
+		OutCatalog.ColorIndices.Add(static_cast<float>(ParseNumber(Cols[7])));
+		OutCatalog.Distances.Add(Cols.Num() > 8 ? static_cast<float>(ParseNumber(Cols[8])) : 1000.0f);
+
+		OutCatalog.StringOffsets.Add(InternString(OutCatalog, Interned, Cols[1]));
+		OutCatalog.StringOffsets.Add(InternString(OutCatalog, Interned, Cols[2]));
+		OutCatalog.StringOffsets.Add(InternString(OutCatalog, Interned, Cols[3]));
+		OutCatalog.StringOffsets.Add(Cols.Num() > 12 ? InternString(OutCatalog, Interned, Cols[12]) : 0);
+		OutCatalog.StringOffsets.Add(Cols.Num() > 13 ? InternString(OutCatalog, Interned, Cols[13]) : 0);
+	}
+
+	return OutCatalog.Num() > 0;
+}
+
+void StarCatalogFormat::WriteBinary(const FPackedStarCatalog& Catalog, const FSourceStamp& Stamp, TArray<uint8>& OutBytes)
+{
+	OutBytes.Reset();
+	FMemoryWriter Ar(OutBytes);
+
+	uint32 FileMagic = Magic;
+	uint16 Version = CurrentVersion;
+	uint16 Flags = 0;
+	FSourceStamp SourceStamp = Stamp;
+	int32 NumStars = Catalog.Num();
+	int32 StringTableBytes = Catalog.StringTable.Num();
+
+	Ar << FileMagic << Version << Flags;
+	Ar << SourceStamp.SourceBytes << SourceStamp.SourceTimestamp << SourceStamp.MaxStars;
+	Ar << NumStars << StringTableBytes;
+
+	WriteRaw(Ar, Catalog.Ids);
+	WriteRaw(Ar, Catalog.Directions);
+	WriteRaw(Ar, Catalog.Magnitudes);
+	WriteRaw(Ar, Catalog.ColorIndices);
+	WriteRaw(Ar, Catalog.Distances);
+	WriteRaw(Ar, Catalog.StringOffsets);
+	WriteRaw(Ar, Catalog.StringTable);
+}
+
+bool StarCatalogFormat::ReadBinary(TConstArrayView<uint8> Bytes, const FSourceStamp* ExpectedStamp, FPackedStarCatalog& OutCatalog)
+{
+	OutCatalog.Reset();
+	FMemoryReaderView Ar(Bytes);
+
+	uint32 FileMagic = 0;
+	uint16 Version = 0;
+	uint16 Flags = 0;
+	FSourceStamp Stamp;
+	int32 NumStars = 0;
+	int32 StringTableBytes = 0;
+
+	Ar << FileMagic << Version << Flags;
+	Ar << Stamp.SourceBytes << Stamp.SourceTimestamp << Stamp.MaxStars;
+	Ar << NumStars << StringTableBytes;
+
+	if (Ar.IsError() || FileMagic != Magic || Version != CurrentVersion)
+	{
+		return false;
+	}
+	if (ExpectedStamp && *ExpectedStamp != Stamp)
+	{
+		return false;
+	}
+	if (NumStars < 0 || StringTableBytes < 1 || Ar.TotalSize() - Ar.Tell() < NumStars * BytesPerStar + StringTableBytes)
+	{
+		return false;
+	}
+
+	ReadRaw(Ar, OutCatalog.Ids, NumStars);
+	ReadRaw(Ar, OutCatalog.Directions, NumStars);
+	ReadRaw(Ar, OutCatalog.Magnitudes, NumStars);
+	ReadRaw(Ar, OutCatalog.ColorIndices, NumStars);
+	ReadRaw(Ar, OutCatalog.Distances, NumStars);
+	ReadRaw(Ar, OutCatalog.StringOffsets, NumStars * FPackedStarCatalog::NumStrings);
+	ReadRaw(Ar, OutCatalog.StringTable, StringTableBytes);
+
+	// Every offset must land inside a terminated table
+	bool bValid = !Ar.IsError() && OutCatalog.StringTable.Last() == '\0';
+	for (int32 Offset : OutCatalog.StringOffsets)
+	{
+		bValid &= Offset >= 0 && Offset < StringTableBytes;
+	}
+	if (!bValid)
+	{
+		OutCatalog.Reset();
+		return false;
+	}
+	return true;
+}
@@ -3,6 +3,43 @@
 // SPDX-License-Identifier: Apache-2.0
 
 #include "Space/Subsystems/CelestialMathLibrary.h"
+#include "Math/VectorRegister.h"
+
+namespace
+{
+	constexpr double MetersPerParsec = 3.085677581e16;
+
+	/** Upper B-V bound of each spectral class but the last (O, B, A, F, G, K) */
+	constexpr float BVClassThresholds[] = { -0.20f, 0.00f, 0.30f, 0.60f, 0.80f, 1.20f };
+
+	/** Colour per spectral class (O, B, A, F, G, K, M) */
+	const FLinearColor BVClassColors[] =
+	{
+		FLinearColor(0.61f, 0.73f, 1.00f, 1.0f),  // O-type: Hot blue stars
+		FLinearColor(0.78f, 0.87f, 1.00f, 1.0f),  // B-type: Blue-white stars
+		FLinearColor(0.96f, 0.97f, 1.00f, 1.0f),  // A-type: White stars
+		FLinearColor(1.00f, 0.98f, 0.92f, 1.0f),  // F-type: Yellow-white stars
+		FLinearColor(1.00f, 0.93f, 0.74f, 1.0f),  // G-type: Yellow stars (like our Sun)
+		FLinearColor(1.00f, 0.82f, 0.56f, 1.0f),  // K-type: Orange stars
+		FLinearColor(1.00f, 0.65f, 0.38f, 1.0f),  // M-type: Red stars (BV >= 1.20)
+	};
+	constexpr int32 NumBVThresholds = UE_ARRAY_COUNT(BVClassThresholds);
+	static_assert(UE_ARRAY_COUNT(BVClassColors) == NumBVThresholds + 1);
+
+	constexpr float MaxStarIntensity = 100000.0f;
+
+	/** Copy up to 4 floats into a register, zero-padding the rest */
+	FORCEINLINE VectorRegister4Float LoadPartial(const float* Src, int32 Count)
+	{
+		if (Count >= 4)
+		{
+			return VectorLoad(Src);
+		}
+		alignas(16) float Padded[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+		FMemory::Memcpy(Padded, Src, Count * sizeof(float));
+		return VectorLoadAligned(Padded);
+	}
+}
 
 FVector UCelestialMathLibrary::EquatorialDir_FromRaDec(double RaHours, double DecDegrees)
 {
@@ -22,7 +59,6 @@ double UCelestialMathLibrary::ParsecsToCentimeters(double Parsecs)
 {
 	// 1 parsec ≈ 3.085677581e16 meters
 	// meters -> cm = * 100
-	constexpr double MetersPerParsec = 3.085677581e16;
 	return Parsecs * MetersPerParsec * 100.0;
 }
 
@@ -37,7 +73,39 @@ float UCelestialMathLibrary::MagToIntensity(float ApparentMag, float kExposure)
 	// Standard photometric relation: brightness ratio = 10^(-0.4 * mag)
 	// We clamp for stability and artistic control.
 	const float I = FMath::Pow(10.0f, -0.4f * ApparentMag) * kExposure;
-	return FMath::Clamp(I, 0.0f, 100000.0f);
+	return FMath::Clamp(I, 0.0f, MaxStarIntensity);
+}
+
+FLinearColor UCelestialMathLibrary::StarColor_FromBVIndex(float BV)
+{
+	/* ================================================================================
+	 * B-V COLOR INDEX TO RGB CONVERSION
+	 * ================================================================================
+	 * Physically accurate stellar colors based on B-V color index.
+	 * B-V represents the difference between blue and visual magnitude.
+	 * Temperature correlation: BV = -0.3 (~30000K) to BV = 2.0 (~3000K)
+	 *
+	 * Spectral Classifications (Harvard System):
+	 * O-type: BV < -0.20  (Hot blue stars: Rigel, Zeta Puppis)
+	 * B-type: BV < 0.00   (Blue-white stars: Spica, Achernar)
+	 * A-type: BV < 0.30   (White stars: Vega, Sirius)
+	 * F-type: BV < 0.60   (Yellow-white stars: Procyon, Canopus)
+	 * G-type: BV < 0.80   (Yellow stars: Sun, Alpha Centauri A)
+	 * K-type: BV < 1.20   (Orange stars: Arcturus, Aldebaran)
+	 * M-type: BV >= 1.20  (Red stars: Betelgeuse, Antares)
+	 *
+	 * RGB values derived from blackbody radiation curves and atmospheric effects.
+	 * Alpha = 1.0 for all stars (emissive material handles brightness via magnitude).
+	 * ================================================================================ */
+	
+	// Same class as StarColors_FromBVIndices: the first threshold BV is below.
+	// NaN passes no '<' and ends up M-type.
+	int32 Class = 0;
+	while (Class < NumBVThresholds && !(BV < BVClassThresholds[Class]))
+	{
+		++Class;
+	}
+	return BVClassColors[Class];
 }
 
 double UCelestialMathLibrary::ApproxGMST_Radians(double SimTimeSeconds, double EarthSiderealDaySeconds)
@@ -54,3 +122,121 @@ double UCelestialMathLibrary::ApproxGMST_Radians(double SimTimeSeconds, double E
 	const double PhaseWrapped = (Phase01 < 0.0) ? (Phase01 + 1.0) : Phase01;
 	return PhaseWrapped * TWO_PI;
 }
+
+// ---------------- Batch conversions ----------------
+
+void UCelestialMathLibrary::EquatorialDirs_FromRaDec(TConstArrayView<float> RaHours, TConstArrayView<float> DecDegrees, TArrayView<FVector3f> OutDirs)
+{
+	const int32 Num = OutDirs.Num();
+	check(RaHours.Num() == Num && DecDegrees.Num() == Num);
+
+	const VectorRegister4Float RaToRad = VectorSetFloat1(UE_PI / 12.0f);
+	const VectorRegister4Float DegToRad = VectorSetFloat1(UE_PI / 180.0f);
+
+	for (int32 Base = 0; Base < Num; Base += 4)
+	{
+		const int32 Count = FMath::Min(4, Num - Base);
+		const VectorRegister4Float RaRad = VectorMultiply(LoadPartial(RaHours.GetData() + Base, Count), RaToRad);
+		const VectorRegister4Float DecRad = VectorMultiply(LoadPartial(DecDegrees.GetData() + Base, Count), DegToRad);
+
+		VectorRegister4Float SinRa, CosRa, SinDec, CosDec;
+		VectorSinCos(&SinRa, &CosRa, &RaRad);
+		VectorSinCos(&SinDec, &CosDec, &DecRad);
+
+		// Unit length by construction, no normalize needed
+		alignas(16) float X[4], Y[4], Z[4];
+		VectorStoreAligned(VectorMultiply(CosDec, CosRa), X);
+		VectorStoreAligned(VectorMultiply(CosDec, SinRa), Y);
+		VectorStoreAligned(SinDec, Z);
+
+		for (int32 Lane = 0; Lane < Count; ++Lane)
+		{
+			OutDirs[Base + Lane] = FVector3f(X[Lane], Y[Lane], Z[Lane]);
+		}
+	}
+}
+
+void UCelestialMathLibrary::ParsecsToCentimeters(TConstArrayView<double> Parsecs, TArrayView<double> OutCentimeters)
+{
+	const int32 Num = OutCentimeters.Num();
+	check(Parsecs.Num() == Num);
+
+	const double CentimetersPerParsec = MetersPerParsec * 100.0;
+	const VectorRegister4Double Scale = MakeVectorRegisterDouble(CentimetersPerParsec, CentimetersPerParsec, CentimetersPerParsec, CentimetersPerParsec);
+
+	int32 Index = 0;
+	for (; Index + 4 <= Num; Index += 4)
+	{
+		VectorStore(VectorMultiply(VectorLoad(Parsecs.GetData() + Index), Scale), OutCentimeters.GetData() + Index);
+	}
+	for (; Index < Num; ++Index)
+	{
+		OutCentimeters[Index] = Parsecs[Index] * CentimetersPerParsec;
+	}
+}
+
+void UCelestialMathLibrary::MagsToIntensities(TConstArrayView<float> ApparentMags, TArrayView<float> OutIntensities, float kExposure)
+{
+	const int32 Num = OutIntensities.Num();
+	check(ApparentMags.Num() == Num);
+
+	// 10^(-0.4 m) == 2^(-0.4 log2(10) m)
+	const VectorRegister4Float MagToExp2 = VectorSetFloat1(-0.4f * 3.32192809f);
+	const VectorRegister4Float Exposure = VectorSetFloat1(kExposure);
+	const VectorRegister4Float MaxIntensity = VectorSetFloat1(MaxStarIntensity);
+
+	for (int32 Base = 0; Base < Num; Base += 4)
+	{
+		const int32 Count = FMath::Min(4, Num - Base);
+		const VectorRegister4Float Mags = LoadPartial(ApparentMags.GetData() + Base, Count);
+
+		VectorRegister4Float Intensity = VectorMultiply(VectorExp2(VectorMultiply(Mags, MagToExp2)), Exposure);
+		Intensity = VectorMin(VectorMax(Intensity, VectorZeroFloat()), MaxIntensity);
+
+		if (Count == 4)
+		{
+			VectorStore(Intensity, OutIntensities.GetData() + Base);
+		}
+		else
+		{
+			alignas(16) float Tail[4];
+			VectorStoreAligned(Intensity, Tail);
+			FMemory::Memcpy(OutIntensities.GetData() + Base, Tail, Count * sizeof(float));
+		}
+	}
+}
+
+void UCelestialMathLibrary::StarColors_FromBVIndices(TConstArrayView<float> BVIndices, TArrayView<FLinearColor> OutColors)
+{
+	const int32 Num = OutColors.Num();
+	check(BVIndices.Num() == Num);
+
+	VectorRegister4Float Thresholds[NumBVThresholds];
+	for (int32 i = 0; i < NumBVThresholds; ++i)
+	{
+		Thresholds[i] = VectorSetFloat1(BVClassThresholds[i]);
+	}
+	const VectorRegister4Float One = VectorOneFloat();
+	const VectorRegister4Float LastClass = VectorSetFloat1(float(NumBVThresholds));
+
+	for (int32 Base = 0; Base < Num; Base += 4)
+	{
+		const int32 Count = FMath::Min(4, Num - Base);
+		const VectorRegister4Float BV = LoadPartial(BVIndices.GetData() + Base, Count);
+
+		// Class = thresholds passed = last class minus the thresholds BV is below,
+		// which sends NaN to M-type like the scalar version
+		VectorRegister4Float Class = LastClass;
+		for (int32 i = 0; i < NumBVThresholds; ++i)
+		{
+			Class = VectorSubtract(Class, VectorBitwiseAnd(VectorCompareLT(BV, Thresholds[i]), One));
+		}
+
+		alignas(16) float Classes[4];
+		VectorStoreAligned(Class, Classes);
+		for (int32 Lane = 0; Lane < Count; ++Lane)
+		{
+			OutColors[Base + Lane] = BVClassColors[int32(Classes[Lane])];
+		}
+	}
+}
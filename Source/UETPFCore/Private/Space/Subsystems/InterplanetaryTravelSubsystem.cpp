@@ -3,17 +3,313 @@
 // SPDX-License-Identifier: Apache-2.0
 
 #include "Space/Subsystems/InterplanetaryTravelSubsystem.h"
+#include "Space/Subsystems/WorldFrameSubsystem.h"
 #include "Kismet/GameplayStatics.h"
+#include "Engine/Engine.h"
 #include "Engine/GameInstance.h"
+#include "Engine/LevelStreamingDynamic.h"
+#include "Engine/World.h"
+#include "GameFramework/GameModeBase.h"
+#include "Misc/PackageName.h"
+#include "UObject/Package.h"
+#include "DeltaTypes.h"
+#include "TPFTimingRecorder.h"
+
+void UInterplanetaryTravelSubsystem::Deinitialize()
+{
+    if (PendingStreamingLevel)
+    {
+        PendingStreamingLevel->OnLevelShown.RemoveDynamic(this, &UInterplanetaryTravelSubsystem::HandleStreamedLevelShown);
+        PendingStreamingLevel = nullptr;
+    }
+    CurrentStreamingLevel = nullptr;
+    ClearLoadMapTravel();
+    ReleasePreloadedDestinations();
+
+    Super::Deinitialize();
+}
+
+FOnTravelDestination& UInterplanetaryTravelSubsystem::OnTravelPreload()
+{
+    static FOnTravelDestination Delegate;
+    return Delegate;
+}
+
+FString UInterplanetaryTravelSubsystem::ResolveMapPackage(FName Map)
+{
+    const FString MapName = Map.ToString();
+    if (FPackageName::IsValidLongPackageName(MapName))
+    {
+        return MapName;
+    }
+
+    FString LongName;
+    if (FPackageName::SearchForPackageOnDisk(MapName, &LongName))
+    {
+        return LongName;
+    }
+
+    UE_LOG(LogTemp, Warning, TEXT("InterplanetaryTravel: Could not resolve map package for %s"), *MapName);
+    return FString();
+}
+
+FString UInterplanetaryTravelSubsystem::GetTimingSessionName(FName Map)
+{
+    return TEXT("Travel_") + FPackageName::GetShortName(Map.ToString());
+}
+
+ECelestialBodyId UInterplanetaryTravelSubsystem::GetAnchorForMap(FName Map) const
+{
+    if (Map == MoonMap)
+    {
+        return ECelestialBodyId::Moon;
+    }
+    if (Map == SpaceMap)
+    {
+        return SpaceAnchorBody;
+    }
+    return ECelestialBodyId::Earth;
+}
+
+void UInterplanetaryTravelSubsystem::PreloadDestination(FName Map)
+{
+    if (Map.IsNone() || PreloadedMaps.Contains(Map) || PreloadsInFlight.Contains(Map))
+    {
+        return;
+    }
+
+    const FString PackageName = ResolveMapPackage(Map);
+    if (PackageName.IsEmpty())
+    {
+        return;
+    }
+
+    // Game modules warm the destination's SpecPacks alongside the map package
+    OnTravelPreload().Broadcast(Map);
+
+    if (UPackage* Existing = FindPackage(nullptr, *PackageName))
+    {
+        if (UWorld* ExistingWorld = UWorld::FindWorldInPackage(Existing))
+        {
+            PreloadedMaps.Add(Map, ExistingWorld);
+            return;
+        }
+    }
+
+    PreloadsInFlight.Add(Map);
+    LoadPackageAsync(PackageName, FLoadPackageAsyncDelegate::CreateWeakLambda(this,
+        [this, Map](const FName& LoadedPackageName, UPackage* LoadedPackage, EAsyncLoadingResult::Type Result)
+        {
+            PreloadsInFlight.Remove(Map);
+            UWorld* LoadedWorld = (Result == EAsyncLoadingResult::Succeeded && LoadedPackage)
+                ? UWorld::FindWorldInPackage(LoadedPackage) : nullptr;
+            if (LoadedWorld)
+            {
+                // The package alone can lose its world to GC before travel
+                PreloadedMaps.Add(Map, LoadedWorld);
+                UE_LOG(LogTemp, Log, TEXT("InterplanetaryTravel: Preloaded %s"), *LoadedPackageName.ToString());
+            }
+            else
+            {
+                UE_LOG(LogTemp, Warning, TEXT("InterplanetaryTravel: Failed to preload %s"), *LoadedPackageName.ToString());
+            }
+        }));
+}
+
+void UInterplanetaryTravelSubsystem::ReleasePreloadedDestinations()
+{
+    // In-flight loads still complete; their packages are simply not retained
+    PreloadedMaps.Reset();
+    PreloadsInFlight.Reset();
+}
 
 void UInterplanetaryTravelSubsystem::OpenMap(FName Map)
 {
-    if (UWorld* World = GetWorld())
+    UWorld* World = GetWorld();
+    if (!World)
+    {
+        return;
+    }
+
+    if (IsTravelInProgress())
+    {
+        UE_LOG(LogTemp, Warning, TEXT("InterplanetaryTravel: Ignoring travel to %s while travelling to %s"),
+            *Map.ToString(), *PendingTravelMap.ToString());
+        return;
+    }
+
+    if (TravelMode == ETravelMode::LevelStreaming)
+    {
+        StreamMap(Map);
+        return;
+    }
+
+    // Closed when the destination map has loaded
+    FTPFTimingRecorder::Get().BeginSession(GetTimingSessionName(Map), Map);
+    TPF_TIMING_SCOPE(TEXT("InterplanetaryTravel::OpenMap"));
+
+    // Let delta stores persist the outgoing map before it unloads
+    IDeltaStore::OnPreLevelTransition().Broadcast();
+
+    TravelByLoadMap(World, Map);
+}
+
+void UInterplanetaryTravelSubsystem::TravelByLoadMap(UWorld* World, FName Map)
+{
+    // The streamed-in destination belongs to the outgoing world
+    CurrentStreamingLevel = nullptr;
+
+    PendingTravelMap = Map;
+    if (!PostLoadMapHandle.IsValid())
+    {
+        PostLoadMapHandle = FCoreUObjectDelegates::PostLoadMapWithWorld.AddUObject(this, &UInterplanetaryTravelSubsystem::HandlePostLoadMap);
+    }
+    if (GEngine && !TravelFailureHandle.IsValid())
+    {
+        TravelFailureHandle = GEngine->OnTravelFailure().AddUObject(this, &UInterplanetaryTravelSubsystem::HandleTravelFailure);
+    }
+
+    AGameModeBase* GameMode = World->GetAuthGameMode();
+    if (TravelMode == ETravelMode::SeamlessTravel && GameMode)
+    {
+        // Loads the destination asynchronously behind the transition map
+        GameMode->bUseSeamlessTravel = true;
+        World->ServerTravel(Map.ToString());
+    }
+    else
     {
         UGameplayStatics::OpenLevel(World, Map);
     }
 }
 
+void UInterplanetaryTravelSubsystem::HandlePostLoadMap(UWorld* LoadedWorld)
+{
+    if (PendingTravelMap.IsNone() || !LoadedWorld)
+    {
+        return;
+    }
+
+    // Seamless travel loads the transition map first; wait for the destination
+    const FString LoadedMap = FPackageName::GetShortName(UWorld::RemovePIEPrefix(LoadedWorld->GetOutermost()->GetName()));
+    if (LoadedMap != FPackageName::GetShortName(PendingTravelMap.ToString()))
+    {
+        return;
+    }
+
+    const FName Map = PendingTravelMap;
+    ClearLoadMapTravel();
+
+    // The loaded world now holds what it needs; the destination map anchors itself
+    PreloadedMaps.Remove(Map);
+
+    UE_LOG(LogTemp, Log, TEXT("InterplanetaryTravel: Arrived at %s"), *Map.ToString());
+    OnTravelCompleted.Broadcast(Map);
+}
+
+void UInterplanetaryTravelSubsystem::HandleTravelFailure(UWorld* World, ETravelFailure::Type FailureType, const FString& ErrorString)
+{
+    if (PendingTravelMap.IsNone())
+    {
+        return;
+    }
+
+    UE_LOG(LogTemp, Warning, TEXT("InterplanetaryTravel: Travel to %s failed: %s"), *PendingTravelMap.ToString(), *ErrorString);
+    FTPFTimingRecorder::Get().EndSession(GetTimingSessionName(PendingTravelMap), false);
+    ClearLoadMapTravel();
+}
+
+void UInterplanetaryTravelSubsystem::ClearLoadMapTravel()
+{
+    PendingTravelMap = NAME_None;
+    if (PostLoadMapHandle.IsValid())
+    {
+        FCoreUObjectDelegates::PostLoadMapWithWorld.Remove(PostLoadMapHandle);
+        PostLoadMapHandle.Reset();
+    }
+    if (TravelFailureHandle.IsValid())
+    {
+        if (GEngine)
+        {
+            GEngine->OnTravelFailure().Remove(TravelFailureHandle);
+        }
+        TravelFailureHandle.Reset();
+    }
+}
+
+void UInterplanetaryTravelSubsystem::StreamMap(FName Map)
+{
+    UWorld* World = GetWorld();
+    const FString PackageName = ResolveMapPackage(Map);
+    if (!World || PackageName.IsEmpty())
+    {
+        return;
+    }
+
+    if (CurrentStreamingLevel && CurrentStreamingLevel->GetWorldAssetPackageFName() == FName(*PackageName))
+    {
+        UE_LOG(LogTemp, Log, TEXT("InterplanetaryTravel: Already at %s"), *Map.ToString());
+        return;
+    }
+
+    // Closed when the level is shown
+    FTPFTimingRecorder::Get().BeginSession(GetTimingSessionName(Map));
+    TPF_TIMING_SCOPE(TEXT("InterplanetaryTravel::StreamMap"));
+
+    // The outgoing destination stays loaded until the new one is visible; persist its deltas now
+    IDeltaStore::OnPreLevelTransition().Broadcast();
+
+    bool bSuccess = false;
+    ULevelStreamingDynamic* Level = ULevelStreamingDynamic::LoadLevelInstance(
+        World, PackageName, FVector::ZeroVector, FRotator::ZeroRotator, bSuccess);
+    if (!bSuccess || !Level)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("InterplanetaryTravel: Failed to stream %s, falling back to OpenLevel"), *Map.ToString());
+        FTPFTimingRecorder::Get().EndSession(GetTimingSessionName(Map), false);
+        TravelByLoadMap(World, Map);
+        return;
+    }
+
+    PendingTravelMap = Map;
+    PendingStreamingLevel = Level;
+    Level->OnLevelShown.AddDynamic(this, &UInterplanetaryTravelSubsystem::HandleStreamedLevelShown);
+
+    UE_LOG(LogTemp, Log, TEXT("InterplanetaryTravel: Streaming in %s"), *PackageName);
+}
+
+void UInterplanetaryTravelSubsystem::HandleStreamedLevelShown()
+{
+    if (!PendingStreamingLevel)
+    {
+        return;
+    }
+
+    PendingStreamingLevel->OnLevelShown.RemoveDynamic(this, &UInterplanetaryTravelSubsystem::HandleStreamedLevelShown);
+
+    if (CurrentStreamingLevel)
+    {
+        CurrentStreamingLevel->SetIsRequestingUnloadAndRemoval(true);
+    }
+    CurrentStreamingLevel = PendingStreamingLevel;
+    PendingStreamingLevel = nullptr;
+
+    const FName Map = PendingTravelMap;
+    PendingTravelMap = NAME_None;
+    PreloadedMaps.Remove(Map);
+
+    // Streamed levels run no game mode, so nothing else sets the anchor
+    if (UWorld* World = GetWorld())
+    {
+        if (UWorldFrameSubsystem* WorldFrame = World->GetSubsystem<UWorldFrameSubsystem>())
+        {
+            WorldFrame->SetAnchorBody(GetAnchorForMap(Map));
+        }
+    }
+
+    UE_LOG(LogTemp, Log, TEXT("InterplanetaryTravel: Arrived at %s"), *Map.ToString());
+    FTPFTimingRecorder::Get().EndSession(GetTimingSessionName(Map));
+    OnTravelCompleted.Broadcast(Map);
+}
+
 void UInterplanetaryTravelSubsystem::TravelToEarth() { OpenMap(EarthMap); }
 void UInterplanetaryTravelSubsystem::TravelToMoon()  { OpenMap(MoonMap); }
 void UInterplanetaryTravelSubsystem::TravelToSpace() { OpenMap(SpaceMap); }
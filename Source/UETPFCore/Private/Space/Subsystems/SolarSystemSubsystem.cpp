@@ -6,10 +6,15 @@
 #include "Subsystems/TimeSubsystem.h"
 #include "Environment/SkyContext.h"
 #include "Misc/DateTime.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
 #include "Math/UnrealMathUtility.h"
-
-// If you want hard dependency, include your TimeSubsystem header path here:
-#include "Subsystems/TimeSubsystem.h"
+#include "HAL/PlatformTime.h"
+#include "Async/Async.h"
+#include "Dom/JsonObject.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+#include "TPFTimingRecorder.h"
 
 namespace SolarMath
 {
@@ -27,27 +32,498 @@ namespace SolarMath
 		const double L2 = V.SquaredLength();
 		return (L2 > 1e-18) ? (V / FMath::Sqrt(L2)) : Fallback;
 	}
+
+	// Unix epoch 1970-01-01 00:00:00 UTC = JD 2440587.5
+	static constexpr double UnixEpochJD = 2440587.5;
+	static constexpr double SecondsPerDay = 86400.0;
+
+	static constexpr double AstronomicalUnitKm = 149597870.7;
+
+	// Table sizing (see FEphemerisTable): the Sun moves ~1 deg/day; orbits get
+	// ~27 segments per period (one day for the Moon's ~13 deg/day)
+	static constexpr double SunSegmentDays = 8.0;
+	static constexpr int32 SunDegree = 10;
+	static constexpr double OrbitSegmentsPerPeriod = 27.0;
+	static constexpr double MinOrbitSegmentDays = 0.25;
+	static constexpr double MaxOrbitSegmentDays = 32.0;
+	static constexpr int32 OrbitDegree = 12;
+}
+
+namespace
+{
+	ECelestialBodyId BuiltinIdFromName(FName Name)
+	{
+		if (Name == TEXT("Sun"))
+		{
+			return ECelestialBodyId::Sun;
+		}
+		if (Name == TEXT("Earth"))
+		{
+			return ECelestialBodyId::Earth;
+		}
+		if (Name == TEXT("Moon"))
+		{
+			return ECelestialBodyId::Moon;
+		}
+		return ECelestialBodyId::Custom;
+	}
+
+	bool OrbitModelFromString(const FString& Model, ECelestialOrbitModel& OutModel)
+	{
+		if (Model == TEXT("fixed"))
+		{
+			OutModel = ECelestialOrbitModel::Fixed;
+		}
+		else if (Model == TEXT("sun_direction"))
+		{
+			OutModel = ECelestialOrbitModel::SunDirection;
+		}
+		else if (Model == TEXT("circular"))
+		{
+			OutModel = ECelestialOrbitModel::Circular;
+		}
+		else
+		{
+			return false;
+		}
+		return true;
+	}
 }
 
 
 void USolarSystemSubsystem::Initialize(FSubsystemCollectionBase& Collection)
 {
+	TPF_TIMING_SCOPE(TEXT("SolarSystemSubsystem::Initialize"));
+
 	Super::Initialize(Collection);
+
+	// Subscribe to TimeSubsystem's authoritative time updates; the tables are anchored on its clock
+	if (UTimeSubsystem* TimeSys = Collection.InitializeDependency<UTimeSubsystem>())
+	{
+		TimeAdvancedHandle = TimeSys->OnSimTimeAdvanced.AddUObject(this, &USolarSystemSubsystem::OnTimeAdvanced);
+	}
+
+	// Built-in table first so a missing or bad spec pack still leaves Sun/Earth/Moon;
+	// the pack and the table fit follow on a worker
 	InitDefaults();
+	WarmUpAsync(FSimpleDelegate());
+}
 
-	// Subscribe to TimeSubsystem's authoritative time updates
-	const UGameInstance* GI = GetGameInstance();
-	if (GI)
+void USolarSystemSubsystem::WarmUpAsync(FSimpleDelegate OnReady)
+{
+	if (bWarmedUp && !PendingWarmUp.IsValid())
 	{
-		if (UTimeSubsystem* TimeSys = GI->GetSubsystem<UTimeSubsystem>())
+		OnReady.ExecuteIfBound();
+		return;
+	}
+
+	if (OnReady.IsBound())
+	{
+		WarmUpCallbacks.Add(MoveTemp(OnReady));
+	}
+
+	if (PendingWarmUp.IsValid())
+	{
+		return;
+	}
+
+	// Everything the worker needs is copied here; it touches no UObject
+	const FString PackPath = ResolveBodySpecPackPath();
+	TArray<FCelestialBodyDef> CurrentBodies = Bodies;
+	const bool bBuildTables = bUseEphemerisTables;
+	const double StartJD = GetEphemerisStartJD();
+	const double RangeDays = FMath::Max(1.0, EphemerisRangeDays);
+
+	const uint32 Serial = ++WarmUpSerial;
+	TWeakObjectPtr<USolarSystemSubsystem> WeakThis(this);
+
+	PendingWarmUp = UE::Tasks::Launch(UE_SOURCE_LOCATION,
+		[WeakThis, Serial, PackPath, CurrentBodies = MoveTemp(CurrentBodies), bBuildTables, StartJD, RangeDays]() mutable -> FWarmUpResultPtr
+		{
+			FWarmUpResultPtr Result = MakeShared<FWarmUpResult, ESPMode::ThreadSafe>();
+			Result->PackPath = PackPath;
+			Result->bFromSpecPack = !PackPath.IsEmpty() && ParseBodySpecPack(PackPath, Result->Bodies);
+			if (!Result->bFromSpecPack)
+			{
+				Result->Bodies = MoveTemp(CurrentBodies);
+			}
+
+			if (bBuildTables)
+			{
+				Result->TableBytes = BuildEphemerisTables(Result->Bodies, StartJD, RangeDays, Result->SunTable, Result->OrbitTables);
+			}
+
+			AsyncTask(ENamedThreads::GameThread, [WeakThis, Serial]()
+			{
+				if (USolarSystemSubsystem* This = WeakThis.Get())
+				{
+					This->CompleteWarmUp(Serial);
+				}
+			});
+			return Result;
+		});
+}
+
+void USolarSystemSubsystem::FinishWarmUp()
+{
+	if (PendingWarmUp.IsValid())
+	{
+		CompleteWarmUp(WarmUpSerial);
+	}
+}
+
+void USolarSystemSubsystem::CompleteWarmUp(uint32 Serial)
+{
+	// Stale completion (already finished synchronously, or superseded)
+	if (Serial != WarmUpSerial || !PendingWarmUp.IsValid())
+	{
+		return;
+	}
+
+	FWarmUpResultPtr Result = PendingWarmUp.GetResult();
+	PendingWarmUp = {};
+
+	if (Result.IsValid())
+	{
+		// Tables are parallel to the worker's (unordered) body list; SetBodies reorders by parent
+		TMap<FName, int32> TableIndexByName;
+		for (int32 i = 0; i < Result->Bodies.Num(); ++i)
+		{
+			TableIndexByName.Add(Result->Bodies[i].Name, i);
+		}
+
+		const int32 NumParsed = Result->Bodies.Num();
+		const bool bApplied = !Result->bFromSpecPack || SetBodies(MoveTemp(Result->Bodies));
+
+		if (!bApplied)
+		{
+			// Pack rejected; the built-in table stays, fitted here
+			RebuildEphemeris();
+		}
+		else
+		{
+			SunTable = MoveTemp(Result->SunTable);
+			for (int32 i = 0; i < Bodies.Num(); ++i)
+			{
+				const int32* TableIndex = TableIndexByName.Find(Bodies[i].Name);
+				OrbitTables[i] = (TableIndex && Result->OrbitTables.IsValidIndex(*TableIndex))
+					? MoveTemp(Result->OrbitTables[*TableIndex])
+					: FEphemerisTable();
+			}
+			Snapshot.SimUnixSeconds = -1.0;
+
+			if (Result->bFromSpecPack)
+			{
+				UE_LOG(LogTemp, Log, TEXT("SolarSystemSubsystem: Loaded %d celestial bodies from %s"), NumParsed, *Result->PackPath);
+			}
+			if (SunTable.IsValid())
+			{
+				UE_LOG(LogTemp, Log, TEXT("SolarSystemSubsystem: Built ephemeris tables for JD %.1f..%.1f (%.1f KB, async)"),
+					SunTable.GetStartJD(), SunTable.GetEndJD(), Result->TableBytes / 1024.0);
+			}
+		}
+	}
+
+	bWarmedUp = true;
+
+	TArray<FSimpleDelegate> Callbacks = MoveTemp(WarmUpCallbacks);
+	for (FSimpleDelegate& Callback : Callbacks)
+	{
+		Callback.ExecuteIfBound();
+	}
+}
+
+FString USolarSystemSubsystem::ResolveBodySpecPackPath() const
+{
+	if (BodySpecPackPath.IsEmpty())
+	{
+		return FString();
+	}
+
+	const FString ContentPath = FPaths::Combine(FPaths::ProjectContentDir(), BodySpecPackPath);
+	if (FPaths::FileExists(ContentPath))
+	{
+		return ContentPath;
+	}
+
+	// Same fallback as the star catalog: the module's bundled spec packs
+	const FString LegacyPath = FPaths::Combine(FPaths::ProjectDir(), TEXT("Source/UETPFCore/Resources/SpecPacks"), FPaths::GetCleanFilename(BodySpecPackPath));
+	if (FPaths::FileExists(LegacyPath))
+	{
+		return LegacyPath;
+	}
+
+	UE_LOG(LogTemp, Log, TEXT("SolarSystemSubsystem: No body spec pack at %s, using built-in bodies"), *ContentPath);
+	return FString();
+}
+
+bool USolarSystemSubsystem::LoadBodySpecPack(const FString& FilePath)
+{
+	// A warm-up landing later would overwrite this table
+	FinishWarmUp();
+
+	TArray<FCelestialBodyDef> Parsed;
+	if (!ParseBodySpecPack(FilePath, Parsed))
+	{
+		return false;
+	}
+
+	const int32 NumParsed = Parsed.Num();
+	if (!SetBodies(MoveTemp(Parsed)))
+	{
+		return false;
+	}
+
+	RebuildEphemeris();
+
+	UE_LOG(LogTemp, Log, TEXT("SolarSystemSubsystem: Loaded %d celestial bodies from %s"), NumParsed, *FilePath);
+	return true;
+}
+
+bool USolarSystemSubsystem::ParseBodySpecPack(const FString& FilePath, TArray<FCelestialBodyDef>& OutBodies)
+{
+	TPF_TIMING_SCOPE(TEXT("SolarSystem::ParseBodySpecPack"));
+
+	FString JsonString;
+	if (!FFileHelper::LoadFileToString(JsonString, *FilePath))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("SolarSystemSubsystem: Failed to read body spec pack %s"), *FilePath);
+		return false;
+	}
+	FTPFTimingRecorder::AddBytesRead(JsonString.Len());
+
+	TSharedPtr<FJsonObject> RootObject;
+	TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(JsonString);
+	if (!FJsonSerializer::Deserialize(Reader, RootObject) || !RootObject.IsValid())
+	{
+		UE_LOG(LogTemp, Warning, TEXT("SolarSystemSubsystem: Failed to parse body spec pack %s"), *FilePath);
+		return false;
+	}
+
+	const TArray<TSharedPtr<FJsonValue>>* BodyArray;
+	if (!RootObject->TryGetArrayField(TEXT("celestial_bodies"), BodyArray))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("SolarSystemSubsystem: %s has no 'celestial_bodies' array"), *FilePath);
+		return false;
+	}
+
+	TArray<FCelestialBodyDef>& Parsed = OutBodies;
+	Parsed.Reset(BodyArray->Num());
+
+	for (const TSharedPtr<FJsonValue>& Value : *BodyArray)
+	{
+		const TSharedPtr<FJsonObject>* BodyObj;
+		if (!Value->TryGetObject(BodyObj))
+		{
+			continue;
+		}
+
+		FString NameString;
+		if (!(*BodyObj)->TryGetStringField(TEXT("name"), NameString) || NameString.IsEmpty())
+		{
+			UE_LOG(LogTemp, Warning, TEXT("SolarSystemSubsystem: Celestial body missing 'name' field"));
+			continue;
+		}
+
+		FCelestialBodyDef Def;
+		Def.Name = FName(*NameString);
+		Def.Id = BuiltinIdFromName(Def.Name);
+		(*BodyObj)->TryGetNumberField(TEXT("radius_km"), Def.RadiusKm);
+		(*BodyObj)->TryGetBoolField(TEXT("has_atmosphere"), Def.bHasAtmosphere);
+		(*BodyObj)->TryGetBoolField(TEXT("has_clouds"), Def.bHasClouds);
+
+		const TSharedPtr<FJsonObject>* OrbitObj;
+		if ((*BodyObj)->TryGetObjectField(TEXT("orbit"), OrbitObj))
+		{
+			FString ModelString;
+			if ((*OrbitObj)->TryGetStringField(TEXT("model"), ModelString) && !OrbitModelFromString(ModelString, Def.OrbitModel))
+			{
+				UE_LOG(LogTemp, Warning, TEXT("SolarSystemSubsystem: Body %s has unknown orbit model '%s', treating as fixed"), *NameString, *ModelString);
+			}
+
+			FString ParentString;
+			if ((*OrbitObj)->TryGetStringField(TEXT("parent"), ParentString) && !ParentString.IsEmpty())
+			{
+				Def.ParentName = FName(*ParentString);
+			}
+
+			double PeriodDays = 0.0;
+			if ((*OrbitObj)->TryGetNumberField(TEXT("period_days"), PeriodDays))
+			{
+				Def.OrbitPeriodS = PeriodDays * SolarMath::SecondsPerDay;
+			}
+			(*OrbitObj)->TryGetNumberField(TEXT("radius_km"), Def.OrbitRadiusKm);
+			(*OrbitObj)->TryGetNumberField(TEXT("inclination_deg"), Def.OrbitInclinationDeg);
+			(*OrbitObj)->TryGetNumberField(TEXT("ascending_node_deg"), Def.OrbitAscendingNodeDeg);
+			(*OrbitObj)->TryGetNumberField(TEXT("phase_deg"), Def.OrbitPhaseDeg);
+		}
+
+		Parsed.Add(Def);
+	}
+
+	if (Parsed.Num() == 0)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("SolarSystemSubsystem: %s defines no celestial bodies"), *FilePath);
+		return false;
+	}
+	return true;
+}
+
+bool USolarSystemSubsystem::SetBodies(TArray<FCelestialBodyDef>&& InBodies)
+{
+	const int32 NumBodies = InBodies.Num();
+
+	TSet<FName> Names;
+	for (const FCelestialBodyDef& Def : InBodies)
+	{
+		bool bDuplicate = false;
+		Names.Add(Def.Name, &bDuplicate);
+		if (Def.Name.IsNone() || bDuplicate)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("SolarSystemSubsystem: Body table rejected - missing or duplicate body name '%s'"), *Def.Name.ToString());
+			return false;
+		}
+	}
+
+	// Parents before children, so one pass over the table evaluates every body
+	TArray<FCelestialBodyDef> Ordered;
+	Ordered.Reserve(NumBodies);
+	TMap<FName, int32> IndexByName;
+	TArray<bool> Placed;
+	Placed.Init(false, NumBodies);
+
+	while (Ordered.Num() < NumBodies)
+	{
+		bool bPlacedAny = false;
+		for (int32 i = 0; i < NumBodies; ++i)
+		{
+			const FCelestialBodyDef& Def = InBodies[i];
+			if (!Placed[i] && (Def.ParentName.IsNone() || IndexByName.Contains(Def.ParentName)))
+			{
+				IndexByName.Add(Def.Name, Ordered.Add(Def));
+				Placed[i] = true;
+				bPlacedAny = true;
+			}
+		}
+
+		if (!bPlacedAny)
+		{
+			const int32 Unplaced = Placed.Find(false);
+			UE_LOG(LogTemp, Warning, TEXT("SolarSystemSubsystem: Body table rejected - parent '%s' of '%s' is missing or cyclic"),
+				*InBodies[Unplaced].ParentName.ToString(), *InBodies[Unplaced].Name.ToString());
+			return false;
+		}
+	}
+
+	Bodies = MoveTemp(Ordered);
+	BodyIndexByName = MoveTemp(IndexByName);
+
+	ParentIndices.SetNumUninitialized(NumBodies);
+	for (int32& Index : BuiltinBodyIndices)
+	{
+		Index = INDEX_NONE;
+	}
+
+	for (int32 i = 0; i < NumBodies; ++i)
+	{
+		const FCelestialBodyDef& Def = Bodies[i];
+		ParentIndices[i] = Def.ParentName.IsNone() ? INDEX_NONE : BodyIndexByName.FindChecked(Def.ParentName);
+
+		const int32 BuiltinIndex = static_cast<int32>(Def.Id);
+		if (BuiltinIndex < NumBuiltinBodies && BuiltinBodyIndices[BuiltinIndex] == INDEX_NONE)
+		{
+			BuiltinBodyIndices[BuiltinIndex] = i;
+		}
+	}
+
+	OrbitTables.Reset();
+	OrbitTables.SetNum(NumBodies);
+	Snapshot.SimUnixSeconds = -1.0;
+	return true;
+}
+
+void USolarSystemSubsystem::RebuildEphemeris()
+{
+	// A warm-up landing later would overwrite these tables
+	FinishWarmUp();
+
+	SunTable.Reset();
+	for (FEphemerisTable& Table : OrbitTables)
+	{
+		Table.Reset();
+	}
+	Snapshot.SimUnixSeconds = -1.0;
+
+	if (!bUseEphemerisTables)
+	{
+		return;
+	}
+
+	const double BuildStart = FPlatformTime::Seconds();
+
+	const SIZE_T TableBytes = BuildEphemerisTables(Bodies, GetEphemerisStartJD(), FMath::Max(1.0, EphemerisRangeDays), SunTable, OrbitTables);
+
+	UE_LOG(LogTemp, Log, TEXT("SolarSystemSubsystem: Built ephemeris tables for JD %.1f..%.1f (%.1f KB, %.2f ms)"),
+		SunTable.GetStartJD(), SunTable.GetEndJD(),
+		TableBytes / 1024.0,
+		(FPlatformTime::Seconds() - BuildStart) * 1000.0);
+}
+
+double USolarSystemSubsystem::GetEphemerisStartJD() const
+{
+	const double StartUnix = EphemerisStartUnixSeconds != 0.0
+		? EphemerisStartUnixSeconds
+		: GetSimUnixSeconds() - EphemerisLeadDays * SolarMath::SecondsPerDay;
+	return UnixSecondsToJulianDate(StartUnix);
+}
+
+SIZE_T USolarSystemSubsystem::BuildEphemerisTables(TConstArrayView<FCelestialBodyDef> InBodies, double StartJD, double RangeDays,
+	FEphemerisTable& OutSunTable, TArray<FEphemerisTable>& OutOrbitTables)
+{
+	TPF_TIMING_SCOPE(TEXT("SolarSystem::BuildEphemerisTables"));
+
+	OutSunTable.Build(StartJD, RangeDays, SolarMath::SunSegmentDays, SolarMath::SunDegree, [](double JD)
+	{
+		return ComputeSunDirApprox_J2000(JD);
+	});
+
+	SIZE_T TableBytes = OutSunTable.GetAllocatedSize();
+
+	OutOrbitTables.SetNum(InBodies.Num());
+	for (int32 i = 0; i < InBodies.Num(); ++i)
+	{
+		const FCelestialBodyDef& Def = InBodies[i];
+		OutOrbitTables[i].Reset();
+		if (Def.OrbitModel != ECelestialOrbitModel::Circular || Def.OrbitPeriodS <= 0.0)
 		{
-			TimeAdvancedHandle = TimeSys->OnSimTimeAdvanced.AddUObject(this, &USolarSystemSubsystem::OnTimeAdvanced);
+			continue;
 		}
+
+		const double SegmentDays = FMath::Clamp(Def.OrbitPeriodS / SolarMath::SecondsPerDay / SolarMath::OrbitSegmentsPerPeriod,
+			SolarMath::MinOrbitSegmentDays, SolarMath::MaxOrbitSegmentDays);
+
+		OutOrbitTables[i].Build(StartJD, RangeDays, SegmentDays, SolarMath::OrbitDegree, [&Def](double JD)
+		{
+			FVector3d PositionKm, VelocityKmS;
+			ComputeCircularOrbit(Def, (JD - SolarMath::UnixEpochJD) * SolarMath::SecondsPerDay, PositionKm, VelocityKmS);
+			return PositionKm;
+		});
+		TableBytes += OutOrbitTables[i].GetAllocatedSize();
 	}
+	return TableBytes;
 }
 
 void USolarSystemSubsystem::Deinitialize()
 {
+	// The worker holds no reference to us, but its result must not land after teardown
+	if (PendingWarmUp.IsValid())
+	{
+		PendingWarmUp.Wait();
+		PendingWarmUp = {};
+	}
+	++WarmUpSerial;
+	WarmUpCallbacks.Reset();
+
 	// Unsubscribe
 	const UGameInstance* GI = GetGameInstance();
 	if (GI)
@@ -64,81 +540,112 @@ void USolarSystemSubsystem::Deinitialize()
 void USolarSystemSubsystem::OnTimeAdvanced(double NewSimTimeSeconds)
 {
 	// Invalidate cache to force recompute on next query
-	CachedSimUnixSeconds = -1.0;
+	Snapshot.SimUnixSeconds = -1.0;
 }
 
 void USolarSystemSubsystem::InitDefaults()
 {
-	BodyDefs.Empty();
+	TArray<FCelestialBodyDef> Defaults;
 
 	{
 		FCelestialBodyDef Sun;
 		Sun.Id = ECelestialBodyId::Sun;
+		Sun.Name = TEXT("Sun");
 		Sun.RadiusKm = 696340.0; // mean solar radius (km)
 		Sun.bHasAtmosphere = false;
 		Sun.bHasClouds = false;
-		BodyDefs.Add(Sun.Id, Sun);
+		Sun.OrbitModel = ECelestialOrbitModel::SunDirection;
+		Sun.OrbitRadiusKm = SolarMath::AstronomicalUnitKm;
+		Defaults.Add(Sun);
 	}
 	{
 		FCelestialBodyDef Earth;
 		Earth.Id = ECelestialBodyId::Earth;
+		Earth.Name = TEXT("Earth");
 		Earth.RadiusKm = 6371.0;
 		Earth.bHasAtmosphere = true;
 		Earth.bHasClouds = true;
-		BodyDefs.Add(Earth.Id, Earth);
+		Earth.OrbitModel = ECelestialOrbitModel::Fixed; // canonical origin
+		Defaults.Add(Earth);
 	}
 	{
 		FCelestialBodyDef Moon;
 		Moon.Id = ECelestialBodyId::Moon;
+		Moon.Name = TEXT("Moon");
 		Moon.RadiusKm = 1737.4;
 		Moon.bHasAtmosphere = false;
 		Moon.bHasClouds = false;
-		BodyDefs.Add(Moon.Id, Moon);
+		Moon.OrbitModel = ECelestialOrbitModel::Circular;
+		Moon.ParentName = TEXT("Earth");
+		Moon.OrbitRadiusKm = EarthMoonDistanceKm;
+		Moon.OrbitPeriodS = MoonOrbitalPeriodS;
+		Moon.OrbitInclinationDeg = MoonInclinationDeg;
+		Defaults.Add(Moon);
 	}
+
+	SetBodies(MoveTemp(Defaults));
+}
+
+int32 USolarSystemSubsystem::GetBodyIndex(ECelestialBodyId Body) const
+{
+	const int32 BuiltinIndex = static_cast<int32>(Body);
+	return BuiltinIndex < NumBuiltinBodies ? BuiltinBodyIndices[BuiltinIndex] : INDEX_NONE;
+}
+
+int32 USolarSystemSubsystem::FindBodyIndex(FName BodyName) const
+{
+	const int32* Index = BodyIndexByName.Find(BodyName);
+	return Index ? *Index : INDEX_NONE;
 }
 
 FCelestialBodyDef USolarSystemSubsystem::GetBodyDef(ECelestialBodyId Body) const
 {
-	if (const FCelestialBodyDef* Def = BodyDefs.Find(Body))
-	{
-		return *Def;
-	}
-	return FCelestialBodyDef{};
+	const int32 Index = GetBodyIndex(Body);
+	return Index != INDEX_NONE ? Bodies[Index] : FCelestialBodyDef{};
 }
 
 FCelestialBodyState USolarSystemSubsystem::GetBodyState(ECelestialBodyId Body) const
 {
 	EnsureCacheUpToDate();
 
-	// Canonical choice: Earth at origin, Sun is a direction (we don't place it at AU distance in this cheap model).
-	// If you later add AU distance, you can return Sun position too.
-	if (Body == ECelestialBodyId::Earth)
-	{
-		return FCelestialBodyState{}; // origin
-	}
-	if (Body == ECelestialBodyId::Moon)
+	FCelestialBodyState State;
+	const int32 Index = GetBodyIndex(Body);
+	if (Index != INDEX_NONE)
 	{
-		FCelestialBodyState M;
-		M.PositionKm = FVector(CachedMoonPositionKm_D);
-		M.VelocityKmS = FVector(CachedMoonVelocityKmS_D);
-		return M;
+		State.PositionKm = FVector(Snapshot.PositionsKm[Index]);
+		State.VelocityKmS = FVector(Snapshot.VelocitiesKmS[Index]);
 	}
-	if (Body == ECelestialBodyId::Sun)
+	return State;
+}
+
+void USolarSystemSubsystem::GetAllBodyStates(TArrayView<FCelestialBodyState> OutStates) const
+{
+	EnsureCacheUpToDate();
+
+	const int32 Count = FMath::Min(OutStates.Num(), Snapshot.Num());
+	for (int32 i = 0; i < Count; ++i)
 	{
-		FCelestialBodyState S;
-		// Put Sun at far direction for “visual proxy” placement if you want:
-		// Distance here is arbitrary unless you introduce AU scale.
-		S.PositionKm = FVector(CachedSunDir_D * 100000.0);
-		S.VelocityKmS = FVector::ZeroVector;
-		return S;
+		OutStates[i].PositionKm = FVector(Snapshot.PositionsKm[i]);
+		OutStates[i].VelocityKmS = FVector(Snapshot.VelocitiesKmS[i]);
 	}
-	return FCelestialBodyState{};
+}
+
+const FSolarSystemSnapshot& USolarSystemSubsystem::GetSnapshot() const
+{
+	EnsureCacheUpToDate();
+	return Snapshot;
+}
+
+FVector3d USolarSystemSubsystem::GetCachedPositionKm(ECelestialBodyId Body) const
+{
+	const int32 Index = GetBodyIndex(Body);
+	return Index != INDEX_NONE ? Snapshot.PositionsKm[Index] : FVector3d::Zero();
 }
 
 FVector USolarSystemSubsystem::GetSunDirCanonical() const
 {
 	EnsureCacheUpToDate();
-	return FVector(CachedSunDir_D);
+	return FVector(Snapshot.SunDir);
 }
 
 float USolarSystemSubsystem::GetMoonPhaseRad() const
@@ -146,9 +653,9 @@ float USolarSystemSubsystem::GetMoonPhaseRad() const
 	EnsureCacheUpToDate();
 
 	// Earth at origin. ToMoon = Moon - Earth.
-	const FVector3d ToMoon = CachedMoonPositionKm_D;
+	const FVector3d ToMoon = GetCachedPositionKm(ECelestialBodyId::Moon) - GetCachedPositionKm(ECelestialBodyId::Earth);
 	// ToSun: in our model, SunDir is the direction from Earth towards Sun.
-	const FVector3d ToSun = CachedSunDir_D;
+	const FVector3d ToSun = Snapshot.SunDir;
 
 	return ComputePhaseAngleRad(FVector(ToMoon), FVector(ToSun));
 }
@@ -160,16 +667,27 @@ double USolarSystemSubsystem::GetMoonIlluminationFraction() const
 	return 0.5 * (1.0 - FMath::Cos(Phase));
 }
 
+void USolarSystemSubsystem::SetGameEpochUnixSeconds(double InUnixSeconds)
+{
+	if (GameEpochUnixSeconds == InUnixSeconds)
+	{
+		return;
+	}
+
+	GameEpochUnixSeconds = InUnixSeconds;
+	OnEpochChanged.Broadcast();
+}
+
 double USolarSystemSubsystem::GetGMSTAngleRad() const
 {
 	EnsureCacheUpToDate();
-	return CachedGMST;
+	return Snapshot.GMSTRad;
 }
 
 double USolarSystemSubsystem::GetJulianDate() const
 {
 	EnsureCacheUpToDate();
-	return CachedJulianDate;
+	return Snapshot.JulianDate;
 }
 
 FSolarSystemState USolarSystemSubsystem::GetSolarSystemState() const
@@ -177,11 +695,11 @@ FSolarSystemState USolarSystemSubsystem::GetSolarSystemState() const
 	EnsureCacheUpToDate();
 
 	FSolarSystemState State;
-	State.SunDir_World = FVector(CachedSunDir_D);  // For now, canonical == world; transform later if needed
+	State.SunDir_World = FVector(Snapshot.SunDir);  // For now, canonical == world; transform later if needed
 	State.SunIlluminanceLux = 100000.0f;  // Placeholder; compute based on distance/angle later
-	State.MoonDir_World = FVector(CachedMoonPositionKm_D.GetSafeNormal());
+	State.MoonDir_World = FVector((GetCachedPositionKm(ECelestialBodyId::Moon) - GetCachedPositionKm(ECelestialBodyId::Earth)).GetSafeNormal());
 	State.MoonPhase01 = (float)GetMoonIlluminationFraction();
-	State.LocalSiderealTimeRad = CachedGMST;
+	State.LocalSiderealTimeRad = (float)Snapshot.GMSTRad;
 	State.ActiveBody = ECelestialBodyId::Earth;  // Placeholder; drive from WorldFrameSubsystem later
 
 	return State;
@@ -214,25 +732,72 @@ double USolarSystemSubsystem::GetSimUnixSeconds() const
 void USolarSystemSubsystem::EnsureCacheUpToDate() const
 {
 	const double SimUnix = GetSimUnixSeconds();
-	if (FMath::IsNearlyEqual(SimUnix, CachedSimUnixSeconds, 1e-6))
+	if (FMath::IsNearlyEqual(SimUnix, Snapshot.SimUnixSeconds, 1e-6))
 	{
 		return; // cache valid
 	}
 
-	CachedSimUnixSeconds = SimUnix;
-	CachedJulianDate = UnixSecondsToJulianDate(SimUnix);
+	Snapshot.SimUnixSeconds = SimUnix;
+	Snapshot.JulianDate = UnixSecondsToJulianDate(SimUnix);
+	const double JD = Snapshot.JulianDate;
+
+	Snapshot.GMSTRad = ComputeGMSTAngleRad_FromJD(JD);
 
-	CachedSunDir_D = ComputeSunDirApprox_J2000(CachedJulianDate);
-	CachedGMST = ComputeGMSTAngleRad_FromJD(CachedJulianDate);
+	// Tables inside the covered range, analytic models outside it
+	FVector3d SunDir;
+	Snapshot.SunDir = SunTable.Evaluate(JD, SunDir)
+		? SolarMath::SafeNormal(SunDir)
+		: ComputeSunDirApprox_J2000(JD);
 
-	ComputeMoonState(SimUnix);
+	// One pass in table order; parents precede children so their entries are already filled
+	const int32 NumBodies = Bodies.Num();
+	Snapshot.PositionsKm.SetNumUninitialized(NumBodies);
+	Snapshot.VelocitiesKmS.SetNumUninitialized(NumBodies);
+
+	for (int32 i = 0; i < NumBodies; ++i)
+	{
+		const FCelestialBodyDef& Def = Bodies[i];
+		const int32 Parent = ParentIndices[i];
+
+		FVector3d PositionKm = Parent != INDEX_NONE ? Snapshot.PositionsKm[Parent] : FVector3d::Zero();
+		FVector3d VelocityKmS = Parent != INDEX_NONE ? Snapshot.VelocitiesKmS[Parent] : FVector3d::Zero();
+
+		switch (Def.OrbitModel)
+		{
+		case ECelestialOrbitModel::SunDirection:
+			PositionKm = Snapshot.SunDir * Def.OrbitRadiusKm;
+			VelocityKmS = FVector3d::Zero();
+			break;
+
+		case ECelestialOrbitModel::Circular:
+		{
+			FVector3d LocalPositionKm, LocalVelocityKmS, LocalRateKmPerDay;
+			if (OrbitTables[i].Evaluate(JD, LocalPositionKm, LocalRateKmPerDay))
+			{
+				LocalVelocityKmS = LocalRateKmPerDay / SolarMath::SecondsPerDay;
+			}
+			else
+			{
+				ComputeCircularOrbit(Def, SimUnix, LocalPositionKm, LocalVelocityKmS);
+			}
+			PositionKm += LocalPositionKm;
+			VelocityKmS += LocalVelocityKmS;
+			break;
+		}
+
+		case ECelestialOrbitModel::Fixed:
+		default:
+			break;
+		}
+
+		Snapshot.PositionsKm[i] = PositionKm;
+		Snapshot.VelocitiesKmS[i] = VelocityKmS;
+	}
 }
 
 double USolarSystemSubsystem::UnixSecondsToJulianDate(double UnixSeconds)
 {
-	// Unix epoch 1970-01-01 00:00:00 UTC = JD 2440587.5
-	static constexpr double UnixEpochJD = 2440587.5;
-	return UnixEpochJD + (UnixSeconds / 86400.0);
+	return SolarMath::UnixEpochJD + (UnixSeconds / SolarMath::SecondsPerDay);
 }
 
 FVector3d USolarSystemSubsystem::ComputeSunDirApprox_J2000(double JD)
@@ -281,34 +846,39 @@ double USolarSystemSubsystem::ComputeGMSTAngleRad_FromJD(double JD)
 	return SolarMath::Wrap0ToTwoPi(GMST_Rad);
 }
 
-void USolarSystemSubsystem::ComputeMoonState(double SimUnixSeconds) const
+void USolarSystemSubsystem::ComputeCircularOrbit(const FCelestialBodyDef& Def, double SimUnixSeconds, FVector3d& OutPositionKm, FVector3d& OutVelocityKmS)
 {
-	// Simple circular inclined orbit around Earth:
+	// Simple circular inclined orbit around the parent:
 	// - Enough for moon position in sky + lighting phase behavior.
-	// - Upgrade later to a better lunar model without changing callers.
+	// - Upgrade later to a better orbit model without changing callers.
 
 	const double t = SimUnixSeconds; // seconds
-	const double w = SolarMath::TwoPi / FMath::Max(1.0, MoonOrbitalPeriodS); // rad/s
-	const double theta = SolarMath::Wrap0ToTwoPi(w * t);
+	const double w = SolarMath::TwoPi / FMath::Max(1.0, Def.OrbitPeriodS); // rad/s
+	const double theta = SolarMath::Wrap0ToTwoPi(w * t + Def.OrbitPhaseDeg * SolarMath::DegToRad);
 
-	const double R = EarthMoonDistanceKm;
-	const double inc = MoonInclinationDeg * SolarMath::DegToRad;
+	const double R = Def.OrbitRadiusKm;
+	const double inc = Def.OrbitInclinationDeg * SolarMath::DegToRad;
+	const double node = Def.OrbitAscendingNodeDeg * SolarMath::DegToRad;
+	const double cn = FMath::Cos(node);
+	const double sn = FMath::Sin(node);
 
-	// Orbit in X-Y plane, then incline about X axis (cheap)
-	const double x = R * FMath::Cos(theta);
+	// Orbit in X-Y plane, incline about X axis, then turn the node about Z (cheap)
+	const double x0 = R * FMath::Cos(theta);
 	const double y0 = R * FMath::Sin(theta);
+	const double x = x0;
 	const double y = y0 * FMath::Cos(inc);
 	const double z = y0 * FMath::Sin(inc);
 
-	CachedMoonPositionKm_D = FVector3d(x, y, z);
+	OutPositionKm = FVector3d(x * cn - y * sn, x * sn + y * cn, z);
 
 	// Velocity (derivative)
-	const double vx = -R * w * FMath::Sin(theta);
+	const double vx0 = -R * w * FMath::Sin(theta);
 	const double vy0 = R * w * FMath::Cos(theta);
+	const double vx = vx0;
 	const double vy = vy0 * FMath::Cos(inc);
 	const double vz = vy0 * FMath::Sin(inc);
 
-	CachedMoonVelocityKmS_D = FVector3d(vx, vy, vz);
+	OutVelocityKmS = FVector3d(vx * cn - vy * sn, vx * sn + vy * cn, vz);
 }
 
 float USolarSystemSubsystem::ComputePhaseAngleRad(const FVector& ToMoon, const FVector& ToSun)
@@ -4,157 +4,370 @@
 
 #include "Space/Subsystems/StarCatalogSubsystem.h"
 #include "Space/Subsystems/CelestialMathLibrary.h"
+#include "TPFCoreStats.h"
+#include "TPFTimingRecorder.h"
 
 #include "Misc/Paths.h"
 #include "Misc/FileHelper.h"
+#include "Misc/ScopeLock.h"
+#include "Async/Async.h"
+#include "Algo/BinarySearch.h"
+#include "Algo/StableSort.h"
 
-static bool ParseCsvLineFast(const FString& Line, TArray<FString>& OutCols)
+/** Per-user cache, rebuilt whenever the CSV changes */
+static FString GetSavedCachePath(const FString& CsvPath)
 {
-	OutCols.Reset();
-	Line.ParseIntoArray(OutCols, TEXT(","), /*CullEmpty*/ false);
-	return OutCols.Num() > 0;
+	return FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("StarCatalog"),
+		FPaths::GetBaseFilename(CsvPath) + TEXT(".") + StarCatalogFormat::CacheExtension);
 }
 
+/** Prebuilt cache shipped next to the CSV (or instead of it) */
+static FString GetStagedCachePath(const FString& CsvPath)
+{
+	return FPaths::ChangeExtension(CsvPath, StarCatalogFormat::CacheExtension);
+}
+
+static bool ReadCatalogCache(const FString& CachePath, const StarCatalogFormat::FSourceStamp* ExpectedStamp, FPackedStarCatalog& OutCatalog)
+{
+	TArray<uint8> Bytes;
+	if (!FFileHelper::LoadFileToArray(Bytes, *CachePath, FILEREAD_Silent))
+	{
+		return false;
+	}
+	FTPFTimingRecorder::AddBytesRead(Bytes.Num());
+	return StarCatalogFormat::ReadBinary(Bytes, ExpectedStamp, OutCatalog);
+}
+
+//=============================================================================
+// FStarRenderBuffers
+//=============================================================================
+
+int32 FStarRenderBuffers::CountVisible(float MaxMagnitude) const
+{
+	return Algo::UpperBound(Magnitudes, MaxMagnitude);
+}
+
+void FStarRenderBuffers::Build(const FPackedStarCatalog& Catalog)
+{
+	const int32 NumStars = Catalog.Num();
+
+	CatalogIndices.SetNumUninitialized(NumStars);
+	for (int32 i = 0; i < NumStars; i++)
+	{
+		CatalogIndices[i] = i;
+	}
+
+	// Stable, so equal magnitudes keep catalog order
+	Algo::StableSortBy(CatalogIndices, [&Catalog](int32 Index) { return Catalog.Magnitudes[Index]; });
+
+	Directions.SetNumUninitialized(NumStars);
+	Magnitudes.SetNumUninitialized(NumStars);
+	TArray<float> ColorIndices;
+	ColorIndices.SetNumUninitialized(NumStars);
+	for (int32 i = 0; i < NumStars; i++)
+	{
+		const int32 Source = CatalogIndices[i];
+		Directions[i] = FVector3f(Catalog.Directions[Source]);
+		Magnitudes[i] = Catalog.Magnitudes[Source];
+		ColorIndices[i] = Catalog.ColorIndices[Source];
+	}
+
+	Colors.SetNumUninitialized(NumStars);
+	UCelestialMathLibrary::StarColors_FromBVIndices(ColorIndices, Colors);
+}
+
+void FStarRenderBuffers::Reset()
+{
+	Directions.Reset();
+	Magnitudes.Reset();
+	Colors.Reset();
+	CatalogIndices.Reset();
+}
+
+//=============================================================================
+// UStarCatalogSubsystem
+//=============================================================================
+
 void UStarCatalogSubsystem::Initialize(FSubsystemCollectionBase& Collection)
 {
+	TPF_TIMING_SCOPE(TEXT("StarCatalogSubsystem::Initialize"));
+
 	Super::Initialize(Collection);
 	// Don’t auto-load here if you want faster startup; call EnsureLoaded from sky/level on demand.
 }
 
 void UStarCatalogSubsystem::Deinitialize()
 {
-	StarsInternal.Reset();
-	Stars.Reset();
-	bLoaded = false;
+	// The worker only touches its own catalog; wait so it does not outlive the subsystem's world
+	if (PendingLoad.IsValid())
+	{
+		PendingLoad.Wait();
+		PendingLoad = UE::Tasks::TTask<FCatalogPtr>();
+	}
+	++LoadSerial;
+	PendingCallbacks.Reset();
+
+	ResetCatalog();
 	Super::Deinitialize();
 }
 
 bool UStarCatalogSubsystem::EnsureLoaded()
 {
-	if (bLoaded && StarsInternal.Num() > 0)
+	check(IsInGameThread());
+
+	if (bLoaded && Catalog.Num() > 0)
 	{
 		return true;
 	}
 
-	const FString FullPath = FPaths::Combine(FPaths::ProjectDir(), TEXT("Source/UETPFCore/Resources/SpecPacks/starmap_milkyway.csv"));
-	bLoaded = LoadFromCsv(FullPath);
-	if (bLoaded && StarsInternal.Num() > 0)
+	// Someone already started it; finish that load rather than parsing twice
+	if (PendingLoad.IsValid())
 	{
-		ConvertInternalToOutput();
-		return true;
+		CompleteAsyncLoad(LoadSerial);
+		return IsLoaded();
+	}
+
+	FLoadedCatalog Loaded;
+	if (LoadCatalog(GetCsvFullPath(), MaxStars, Loaded))
+	{
+		SetCatalog(MoveTemp(Loaded));
 	}
-	return false;
+	return IsLoaded();
 }
 
-bool UStarCatalogSubsystem::Reload()
+void UStarCatalogSubsystem::EnsureLoadedAsync(FOnStarCatalogReady OnReady)
 {
-	StarsInternal.Reset();
-	Stars.Reset();
-	bLoaded = false;
-	return EnsureLoaded();
+	check(IsInGameThread());
+
+	if (IsLoaded())
+	{
+		OnReady.ExecuteIfBound(true);
+		return;
+	}
+
+	PendingCallbacks.Add(MoveTemp(OnReady));
+	if (PendingLoad.IsValid())
+	{
+		return;
+	}
+
+	const uint32 Serial = ++LoadSerial;
+	TWeakObjectPtr<UStarCatalogSubsystem> WeakThis(this);
+
+	// Worker only touches the path and catalog it was given - no UObject access off the game thread
+	PendingLoad = UE::Tasks::Launch(UE_SOURCE_LOCATION,
+		[WeakThis, Serial, CsvPath = GetCsvFullPath(), MaxStarCount = MaxStars]()
+		{
+			FCatalogPtr Loaded = MakeShared<FLoadedCatalog, ESPMode::ThreadSafe>();
+			if (!LoadCatalog(CsvPath, MaxStarCount, *Loaded))
+			{
+				Loaded.Reset();
+			}
+
+			AsyncTask(ENamedThreads::GameThread, [WeakThis, Serial]()
+			{
+				if (UStarCatalogSubsystem* This = WeakThis.Get())
+				{
+					This->CompleteAsyncLoad(Serial);
+				}
+			});
+			return Loaded;
+		});
 }
 
-bool UStarCatalogSubsystem::LoadFromCsv(const FString& FullPath)
+void UStarCatalogSubsystem::CompleteAsyncLoad(uint32 Serial)
 {
-	FString Text;
-	if (!FFileHelper::LoadFileToString(Text, *FullPath))
+	// Already completed by a blocking EnsureLoaded, or superseded
+	if (Serial != LoadSerial || !PendingLoad.IsValid())
 	{
-		UE_LOG(LogTemp, Warning, TEXT("[StarCatalog] Failed to load CSV: %s"), *FullPath);
-		return false;
+		return;
 	}
 
-	TArray<FString> Lines;
-	Text.ParseIntoArrayLines(Lines, /*CullEmpty*/ true);
-	if (Lines.Num() < 2)
+	FCatalogPtr Loaded = PendingLoad.GetResult();
+	PendingLoad = UE::Tasks::TTask<FCatalogPtr>();
+	if (Loaded.IsValid())
 	{
-		UE_LOG(LogTemp, Warning, TEXT("[StarCatalog] CSV empty/too small: %s"), *FullPath);
-		return false;
+		SetCatalog(MoveTemp(*Loaded));
 	}
 
-	// Header expectations (from your generator):
-	// id,name,proper,bf,ra,dec,mag,ci,dist,x,y,z,spect,con
-	const int32 HeaderIdx = 0;
-	const FString& Header = Lines[HeaderIdx];
-	if (!Header.Contains(TEXT("ra")) 
-	|| !Header.Contains(TEXT("dec")) 
-	|| !Header.Contains(TEXT("mag"))
-	|| !Header.Contains(TEXT("ci")))
+	// Callbacks may start another load or query the catalog
+	TArray<FOnStarCatalogReady> Callbacks = MoveTemp(PendingCallbacks);
+	const bool bReady = IsLoaded();
+	for (FOnStarCatalogReady& Callback : Callbacks)
 	{
-		UE_LOG(LogTemp, Warning, TEXT("[StarCatalog] CSV header unexpected. Using positional parse anyway."));
+		Callback.ExecuteIfBound(bReady);
+	}
+}
+
+bool UStarCatalogSubsystem::Reload()
+{
+	check(IsInGameThread());
+
+	// Let an in-flight load deliver to its callers before it is replaced
+	if (PendingLoad.IsValid())
+	{
+		CompleteAsyncLoad(LoadSerial);
 	}
 
-	StarsInternal.Reserve(FMath::Min(MaxStars, Lines.Num()));
+	ResetCatalog();
+	return EnsureLoaded();
+}
 
-	TArray<FString> Cols;
-	for (int32 i = 1; i < Lines.Num(); ++i)
+FString UStarCatalogSubsystem::GetCsvFullPath() const
+{
+	if (!FPaths::IsRelative(RelativeCsvPath))
 	{
-		if (StarsInternal.Num() >= MaxStars) break;
+		return RelativeCsvPath;
+	}
+
+	const FString ContentPath = FPaths::Combine(FPaths::ProjectContentDir(), RelativeCsvPath);
+	if (FPaths::FileExists(ContentPath) || FPaths::FileExists(FPaths::ChangeExtension(ContentPath, StarCatalogFormat::CacheExtension)))
+	{
+		return ContentPath;
+	}
+
+	// Projects that predate RelativeCsvPath keep the catalog in the module's resources
+	const FString LegacyPath = FPaths::Combine(FPaths::ProjectDir(), TEXT("Source/UETPFCore/Resources/SpecPacks"), FPaths::GetCleanFilename(RelativeCsvPath));
+	return FPaths::FileExists(LegacyPath) ? LegacyPath : ContentPath;
+}
+
+void UStarCatalogSubsystem::SetCatalog(FLoadedCatalog&& Loaded)
+{
+	FScopeLock Lock(&StarsLock);
+	Catalog = MoveTemp(Loaded.Catalog);
+	RenderBuffers = MoveTemp(Loaded.RenderBuffers);
+	Stars.Reset();
+	bStarsBuilt = false;
+	NameLookup.Reset();
+	bNameLookupBuilt = false;
+	bLoaded = Catalog.Num() > 0;
+}
+
+void UStarCatalogSubsystem::ResetCatalog()
+{
+	FScopeLock Lock(&StarsLock);
+	Catalog.Reset();
+	RenderBuffers.Reset();
+	Stars.Reset();
+	bStarsBuilt = false;
+	NameLookup.Reset();
+	bNameLookupBuilt = false;
+	bLoaded = false;
+}
+
+bool UStarCatalogSubsystem::LoadCatalog(const FString& CsvPath, int32 InMaxStars, FLoadedCatalog& OutLoaded)
+{
+	FPackedStarCatalog& OutCatalog = OutLoaded.Catalog;
 
-		if (!ParseCsvLineFast(Lines[i], Cols)) continue;
-		if (Cols.Num() < 8) continue; // need at least ra,dec,mag,ci
+	SCOPE_CYCLE_COUNTER(STAT_TPF_StarCatalogLoad);
+	CSV_SCOPED_TIMING_STAT(TPFCore, StarCatalogLoad);
+	TPF_TIMING_SCOPE(TEXT("StarCatalog::LoadCatalog"));
 
-		// Column positions per your out_cols:
-		// 0:id 1:name 2:proper 3:bf 4:ra 5:dec 6:mag 7:ci 8:dist 9:x 10:y 11:z 12:spect 13:con
-		const int32 StarId = FCString::Atoi(*Cols[0]);
-		const FString Name = Cols[1];
-		const FString ProperName = Cols[2];
-		const FString BayerFlamsteed = Cols[3];
-		const double RaHours = FCString::Atod(*Cols[4]);
-		const double DecDeg = FCString::Atod(*Cols[5]);
-		const float Mag = (float)FCString::Atof(*Cols[6]);
-		const float CI = (float)FCString::Atof(*Cols[7]);
-		const float DistParsecs = (Cols.Num() > 8) ? (float)FCString::Atof(*Cols[8]) : 1000.0f;
-		const FString SpectralType = (Cols.Num() > 12) ? Cols[12] : TEXT("");
-		const FString Constellation = (Cols.Num() > 13) ? Cols[13] : TEXT("");
+	// Without the CSV (staged builds) any cache is current; with it, only one built from it
+	StarCatalogFormat::FSourceStamp Stamp;
+	const bool bHasCsv = StarCatalogFormat::GetSourceStamp(CsvPath, InMaxStars, Stamp);
+	const StarCatalogFormat::FSourceStamp* ExpectedStamp = bHasCsv ? &Stamp : nullptr;
 
-		if (!FMath::IsFinite(RaHours) || !FMath::IsFinite(DecDeg) || !FMath::IsFinite(Mag))
+	for (const FString& CachePath : { GetStagedCachePath(CsvPath), GetSavedCachePath(CsvPath) })
+	{
+		if (ReadCatalogCache(CachePath, ExpectedStamp, OutCatalog))
 		{
-			continue;
+			OutLoaded.RenderBuffers.Build(OutCatalog);
+			UE_LOG(LogTemp, Log, TEXT("[StarCatalog] Loaded %d stars from %s"), OutCatalog.Num(), *CachePath);
+			return true;
 		}
+	}
 
-		const FVector3d Dir = UCelestialMathLibrary::EquatorialDir_FromRaDec(RaHours, DecDeg);
-		if (Dir.IsNearlyZero()) continue;
+	TArray<uint8> CsvBytes;
+	if (!bHasCsv || !FFileHelper::LoadFileToArray(CsvBytes, *CsvPath))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("[StarCatalog] Failed to load CSV: %s"), *CsvPath);
+		return false;
+	}
+	FTPFTimingRecorder::AddBytesRead(CsvBytes.Num());
+
+	if (!StarCatalogFormat::ParseCsv(CsvBytes, InMaxStars, OutCatalog))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("[StarCatalog] CSV empty/too small: %s"), *CsvPath);
+		return false;
+	}
 
-		FStarRecordInternal R;
-		R.Id = StarId;
-		R.Name = Name;
-		R.ProperName = ProperName;
-		R.BayerFlamsteed = BayerFlamsteed;
-		R.DirEquatorial = Dir;
-		R.Mag = Mag;
-		R.CI = CI;
-		R.DistanceParsecs = DistParsecs;
-		R.SpectralType = SpectralType;
-		R.Constellation = Constellation;
-		StarsInternal.Add(R);
+	// Next load skips the parse; a failed write only costs that
+	TArray<uint8> CacheBytes;
+	StarCatalogFormat::WriteBinary(OutCatalog, Stamp, CacheBytes);
+	const FString SavedCachePath = GetSavedCachePath(CsvPath);
+	if (!FFileHelper::SaveArrayToFile(CacheBytes, *SavedCachePath))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("[StarCatalog] Failed to write cache: %s"), *SavedCachePath);
 	}
 
-	UE_LOG(LogTemp, Log, TEXT("[StarCatalog] Loaded %d stars from %s"), StarsInternal.Num(), *FullPath);
-	return StarsInternal.Num() > 0;
+	OutLoaded.RenderBuffers.Build(OutCatalog);
+	UE_LOG(LogTemp, Log, TEXT("[StarCatalog] Loaded %d stars from %s"), OutCatalog.Num(), *CsvPath);
+	return true;
 }
 
-void UStarCatalogSubsystem::ConvertInternalToOutput()
+void UStarCatalogSubsystem::ConvertPackedToOutput() const
 {
 	Stars.Reset();
-	Stars.Reserve(StarsInternal.Num());
-	for (const FStarRecordInternal& Internal : StarsInternal)
+	Stars.SetNum(Catalog.Num());
+	for (int32 i = 0; i < Catalog.Num(); ++i)
 	{
-		FStarRecord R;
-		R.Id = Internal.Id;
-		R.Name = Internal.Name;
-		R.ProperName = Internal.ProperName;
-		R.BayerFlamsteed = Internal.BayerFlamsteed;
-		R.DirEquatorial = FVector3f(Internal.DirEquatorial.X, Internal.DirEquatorial.Y, Internal.DirEquatorial.Z);
-		R.Mag = Internal.Mag;
-		R.CI = Internal.CI;
-		R.DistanceParsecs = Internal.DistanceParsecs;
-		R.SpectralType = Internal.SpectralType;
-		R.Constellation = Internal.Constellation;
-		Stars.Add(R);
+		GetStarRecord(i, Stars[i]);
 	}
 }
 
 const TArray<FStarRecord>& UStarCatalogSubsystem::GetStars() const
 {
+	FScopeLock Lock(&StarsLock);
+	if (!bStarsBuilt && Catalog.Num() > 0)
+	{
+		ConvertPackedToOutput();
+		bStarsBuilt = true;
+	}
 	return Stars;
 }
+
+bool UStarCatalogSubsystem::GetStarRecord(int32 CatalogIndex, FStarRecord& OutStar) const
+{
+	if (CatalogIndex < 0 || CatalogIndex >= Catalog.Num())
+	{
+		return false;
+	}
+
+	const FVector3d& Dir = Catalog.Directions[CatalogIndex];
+	OutStar.Id = Catalog.Ids[CatalogIndex];
+	OutStar.Name = Catalog.GetString(CatalogIndex, EStarString::Name);
+	OutStar.ProperName = Catalog.GetString(CatalogIndex, EStarString::ProperName);
+	OutStar.BayerFlamsteed = Catalog.GetString(CatalogIndex, EStarString::BayerFlamsteed);
+	OutStar.DirEquatorial = FVector3f(Dir.X, Dir.Y, Dir.Z);
+	OutStar.Mag = Catalog.Magnitudes[CatalogIndex];
+	OutStar.CI = Catalog.ColorIndices[CatalogIndex];
+	OutStar.DistanceParsecs = Catalog.Distances[CatalogIndex];
+	OutStar.SpectralType = Catalog.GetString(CatalogIndex, EStarString::SpectralType);
+	OutStar.Constellation = Catalog.GetString(CatalogIndex, EStarString::Constellation);
+	return true;
+}
+
+int32 UStarCatalogSubsystem::FindStarByName(const FString& StarName) const
+{
+	FScopeLock Lock(&StarsLock);
+	if (!bNameLookupBuilt)
+	{
+		// Earlier catalog entries win duplicate names
+		for (int32 i = 0; i < Catalog.Num(); ++i)
+		{
+			for (EStarString Field : { EStarString::ProperName, EStarString::BayerFlamsteed, EStarString::Name })
+			{
+				FString Key = Catalog.GetString(i, Field);
+				if (!Key.IsEmpty() && !NameLookup.Contains(Key))
+				{
+					NameLookup.Add(MoveTemp(Key), i);
+				}
+			}
+		}
+		bNameLookupBuilt = true;
+	}
+
+	const int32* Index = NameLookup.Find(StarName);
+	return Index ? *Index : INDEX_NONE;
+}
@@ -4,16 +4,132 @@
 
 #include "Space/Subsystems/WorldFrameSubsystem.h"
 #include "Space/Subsystems/SolarSystemSubsystem.h"
+#include "Subsystems/TimeSubsystem.h"
 #include "Engine/GameInstance.h"
+#include "Engine/World.h"
+#include "GameFramework/PlayerController.h"
+#include "TPFTimingRecorder.h"
 
 void UWorldFrameSubsystem::Initialize(FSubsystemCollectionBase& Collection)
 {
+	TPF_TIMING_SCOPE(TEXT("WorldFrameSubsystem::Initialize"));
+
     Super::Initialize(Collection);
+
+    // Republish once per sim-time step so off-thread readers see fresh frames
+    UGameInstance* GI = GetWorld() ? GetWorld()->GetGameInstance() : nullptr;
+    if (UTimeSubsystem* TimeSys = GI ? GI->GetSubsystem<UTimeSubsystem>() : nullptr)
+    {
+        TimeAdvancedHandle = TimeSys->OnSimTimeAdvanced.AddUObject(this, &UWorldFrameSubsystem::HandleSimTimeAdvanced);
+    }
+    if (USolarSystemSubsystem* Solar = GetSolar())
+    {
+        EpochChangedHandle = Solar->OnEpochChanged.AddUObject(this, &UWorldFrameSubsystem::RefreshSkyFrame);
+    }
+
+    // Engine-driven shifts (world composition, RequestNewWorldOrigin) fire the same event as ours
+    OriginOffsetHandle = FWorldDelegates::PostWorldOriginOffset.AddUObject(this, &UWorldFrameSubsystem::HandlePostWorldOriginOffset);
+}
+
+void UWorldFrameSubsystem::Deinitialize()
+{
+    UGameInstance* GI = GetWorld() ? GetWorld()->GetGameInstance() : nullptr;
+    if (UTimeSubsystem* TimeSys = GI ? GI->GetSubsystem<UTimeSubsystem>() : nullptr)
+    {
+        TimeSys->OnSimTimeAdvanced.Remove(TimeAdvancedHandle);
+    }
+    if (USolarSystemSubsystem* Solar = GetSolar())
+    {
+        Solar->OnEpochChanged.Remove(EpochChangedHandle);
+    }
+    FWorldDelegates::PostWorldOriginOffset.Remove(OriginOffsetHandle);
+    OnWorldOriginRebased.Clear();
+
+    Super::Deinitialize();
+}
+
+void UWorldFrameSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+    Super::OnWorldBeginPlay(InWorld);
+    PublishSkyFrame();
+}
+
+void UWorldFrameSubsystem::Tick(float DeltaTime)
+{
+    if (!bEnableOriginRebasing) return;
+
+    UWorld* World = GetWorld();
+    const APlayerController* PlayerController = World && World->IsGameWorld() ? World->GetFirstPlayerController() : nullptr;
+    if (!PlayerController) return;
+
+    FVector ViewLocation;
+    FRotator ViewRotation;
+    PlayerController->GetPlayerViewPoint(ViewLocation, ViewRotation);
+    if (ViewLocation.SquaredLength() < FMath::Square(OriginRebaseDistanceCm)) return;
+
+    // Whole chunks keep cell-keyed grids (surface, biome) aligned across the shift
+    const double ChunkCm = FMath::Max(OriginRebaseChunkCm, 1.0);
+    const auto Snap = [ChunkCm](double Cm) { return static_cast<int32>(FMath::RoundToDouble(Cm / ChunkCm) * ChunkCm); };
+    RebaseOrigin(FIntVector(Snap(ViewLocation.X), Snap(ViewLocation.Y), Snap(ViewLocation.Z)));
+}
+
+TStatId UWorldFrameSubsystem::GetStatId() const
+{
+    RETURN_QUICK_DECLARE_CYCLE_STAT(UWorldFrameSubsystem, STATGROUP_Tickables);
+}
+
+bool UWorldFrameSubsystem::RebaseOrigin(const FIntVector& ShiftCm)
+{
+    UWorld* World = GetWorld();
+    if (!World || ShiftCm == FIntVector::ZeroValue) return false;
+
+    // UWorld::OriginLocation is int32 cm (~21,000 km); refuse rather than wrap
+    const FIntVector Origin = World->OriginLocation;
+    const int64 X = int64(Origin.X) + ShiftCm.X;
+    const int64 Y = int64(Origin.Y) + ShiftCm.Y;
+    const int64 Z = int64(Origin.Z) + ShiftCm.Z;
+    if (FMath::Max3(FMath::Abs(X), FMath::Abs(Y), FMath::Abs(Z)) > MAX_int32)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("WorldFrameSubsystem: Origin rebase by %s would overflow the world origin"), *ShiftCm.ToString());
+        return false;
+    }
+
+    // Listeners run from HandlePostWorldOriginOffset once actors have moved
+    return World->SetNewWorldOrigin(FIntVector(int32(X), int32(Y), int32(Z)));
+}
+
+FIntVector UWorldFrameSubsystem::GetWorldOriginCm() const
+{
+    const UWorld* World = GetWorld();
+    return World ? World->OriginLocation : FIntVector::ZeroValue;
+}
+
+FVector UWorldFrameSubsystem::WorldCmToAbsoluteCm(const FVector& WorldPosCm) const
+{
+    return WorldPosCm + FVector(GetWorldOriginCm());
+}
+
+FVector UWorldFrameSubsystem::AbsoluteCmToWorldCm(const FVector& AbsolutePosCm) const
+{
+    return AbsolutePosCm - FVector(GetWorldOriginCm());
+}
+
+void UWorldFrameSubsystem::HandlePostWorldOriginOffset(UWorld* InWorld, FIntVector SrcOrigin, FIntVector DstOrigin)
+{
+    if (InWorld != GetWorld()) return;
+
+    const FIntVector ShiftCm = DstOrigin - SrcOrigin;
+    UE_LOG(LogTemp, Log, TEXT("WorldFrameSubsystem: World origin rebased by %s to %s"), *ShiftCm.ToString(), *DstOrigin.ToString());
+
+    OnWorldOriginRebased.Broadcast(ShiftCm);
 }
 
 void UWorldFrameSubsystem::SetAnchorBody(ECelestialBodyId InAnchor)
 {
+    if (AnchorBody == InAnchor) return;
+
     AnchorBody = InAnchor;
+    PublishSkyFrame();
 }
 
 USolarSystemSubsystem* UWorldFrameSubsystem::GetSolar() const
@@ -23,16 +139,49 @@ USolarSystemSubsystem* UWorldFrameSubsystem::GetSolar() const
     return GI ? GI->GetSubsystem<USolarSystemSubsystem>() : nullptr;
 }
 
+FVector3d UWorldFrameSubsystem::GetAnchorPositionKm(const USolarSystemSubsystem& Solar, const FSolarSystemSnapshot& Snapshot) const
+{
+    const int32 AnchorIndex = Solar.GetBodyIndex(AnchorBody);
+    return AnchorIndex != INDEX_NONE ? Snapshot.PositionsKm[AnchorIndex] : FVector3d::Zero();
+}
+
 FVector UWorldFrameSubsystem::CanonicalKmToWorldCm(const FVector& CanonicalPosKm) const
 {
     USolarSystemSubsystem* Solar = GetSolar();
     if (!Solar) return FVector::ZeroVector;
 
-    const FVector AnchorKm = Solar->GetBodyState(AnchorBody).PositionKm;
-    const FVector RelKm = CanonicalPosKm - AnchorKm; // anchor at world origin
-    const FVector RelCm = RelKm * KmToCm;
+    // Read the anchor from the shared snapshot rather than re-evaluating its state
+    const FVector3d AnchorKm = GetAnchorPositionKm(*Solar, Solar->GetSnapshot());
+    const FVector3d RelKm = FVector3d(CanonicalPosKm) - AnchorKm; // anchor at absolute origin
+
+    // Stay in doubles: a float cast here loses metres at lunar distance
+    return AbsoluteCmToWorldCm(RelKm * KmToCm);
+}
+
+FVector UWorldFrameSubsystem::WorldCmToCanonicalKm(const FVector& WorldPosCm) const
+{
+    USolarSystemSubsystem* Solar = GetSolar();
+    if (!Solar) return FVector::ZeroVector;
+
+    const FVector3d AnchorKm = GetAnchorPositionKm(*Solar, Solar->GetSnapshot());
+    return WorldCmToAbsoluteCm(WorldPosCm) / KmToCm + AnchorKm;
+}
+
+void UWorldFrameSubsystem::GetAllBodiesWorldCm(TArrayView<FVector> OutWorldCm) const
+{
+    USolarSystemSubsystem* Solar = GetSolar();
+    if (!Solar) return;
+
+    const FSolarSystemSnapshot& Snapshot = Solar->GetSnapshot();
+    const FVector3d AnchorKm = GetAnchorPositionKm(*Solar, Snapshot);
 
-    return FVector((float)RelCm.X, (float)RelCm.Y, (float)RelCm.Z);
+    const FVector3d OriginCm = FVector3d(GetWorldOriginCm());
+
+    const int32 Count = FMath::Min(OutWorldCm.Num(), Snapshot.Num());
+    for (int32 i = 0; i < Count; ++i)
+    {
+        OutWorldCm[i] = FVector((Snapshot.PositionsKm[i] - AnchorKm) * KmToCm - OriginCm);
+    }
 }
 
 FVector UWorldFrameSubsystem::GetMoonWorldCm() const
@@ -40,8 +189,11 @@ FVector UWorldFrameSubsystem::GetMoonWorldCm() const
     USolarSystemSubsystem* Solar = GetSolar();
     if (!Solar) return FVector::ZeroVector;
 
-    const FVector3d MoonKm = Solar->GetBodyState(ECelestialBodyId::Moon).PositionKm;
-    return CanonicalKmToWorldCm(MoonKm);
+    const FSolarSystemSnapshot& Snapshot = Solar->GetSnapshot();
+    const int32 MoonIndex = Solar->GetBodyIndex(ECelestialBodyId::Moon);
+    if (MoonIndex == INDEX_NONE) return FVector::ZeroVector;
+
+    return AbsoluteCmToWorldCm((Snapshot.PositionsKm[MoonIndex] - GetAnchorPositionKm(*Solar, Snapshot)) * KmToCm);
 }
 
 FSkyContext UWorldFrameSubsystem::BuildSkyContext() const
@@ -64,3 +216,90 @@ FSkyContext UWorldFrameSubsystem::BuildSkyContext() const
 
     return Ctx;
 }
+
+void UWorldFrameSubsystem::BuildSkyFrame(const USolarSystemSubsystem& Solar, FSkyFrame& OutFrame) const
+{
+    // One solar evaluation feeds both halves of the frame
+    OutFrame.SimUnixSeconds = Solar.GetSnapshot().SimUnixSeconds;
+    OutFrame.Solar = Solar.GetSolarSystemState();
+    OutFrame.Solar.ActiveBody = AnchorBody;
+
+    const int32 AnchorIndex = Solar.GetBodyIndex(AnchorBody);
+    const FCelestialBodyDef DefaultDef;
+    const FCelestialBodyDef& Def = AnchorIndex != INDEX_NONE ? Solar.GetBodyDefs()[AnchorIndex] : DefaultDef;
+
+    FSkyContext& Ctx = OutFrame.Sky;
+    Ctx = FSkyContext();
+    Ctx.SunDirWorld = OutFrame.Solar.SunDir_World;
+    Ctx.SunIntensity = 10.0f; // map this in UniversalSkyActor into UE units
+    Ctx.bEnableAtmosphere = Def.bHasAtmosphere;
+    Ctx.bEnableClouds = Def.bHasClouds;
+    Ctx.StarRotationRad = OutFrame.Solar.LocalSiderealTimeRad;
+    Ctx.AnchorBodyRadiusKm = Def.RadiusKm;
+
+    // Invert the illuminated fraction rather than recomputing the phase angle
+    Ctx.MoonPhaseRad = FMath::Acos(FMath::Clamp(1.0f - 2.0f * OutFrame.Solar.MoonPhase01, -1.0f, 1.0f));
+}
+
+void UWorldFrameSubsystem::PublishSkyFrame() const
+{
+    check(IsInGameThread());
+
+    const USolarSystemSubsystem* Solar = GetSolar();
+    if (!Solar) return;
+
+    const uint32 Next = SkyFrameGeneration.load(std::memory_order_relaxed) + 1;
+    FSkyFrameSlot& Slot = SkyFrameSlots[Next & 1];
+
+    Slot.Sequence.fetch_add(1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    BuildSkyFrame(*Solar, Slot.Frame);
+    Slot.Frame.Generation = Next;
+
+    Slot.Sequence.fetch_add(1, std::memory_order_release);
+    SkyFrameGeneration.store(Next, std::memory_order_release);
+}
+
+FSkyFrame UWorldFrameSubsystem::GetSkyFrame() const
+{
+    if (IsInGameThread())
+    {
+        // Delegate order is not guaranteed, so a game-thread reader may run before our time handler
+        const USolarSystemSubsystem* Solar = GetSolar();
+        const uint32 Generation = SkyFrameGeneration.load(std::memory_order_relaxed);
+        if (Solar && (Generation == 0 || SkyFrameSlots[Generation & 1].Frame.SimUnixSeconds != Solar->GetSnapshot().SimUnixSeconds))
+        {
+            PublishSkyFrame();
+        }
+    }
+
+    for (;;)
+    {
+        const uint32 Generation = SkyFrameGeneration.load(std::memory_order_acquire);
+        const FSkyFrameSlot& Slot = SkyFrameSlots[Generation & 1];
+
+        const uint32 Before = Slot.Sequence.load(std::memory_order_acquire);
+        if (Before & 1)
+        {
+            continue;
+        }
+
+        FSkyFrame Frame = Slot.Frame;
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (Slot.Sequence.load(std::memory_order_relaxed) == Before)
+        {
+            return Frame;
+        }
+    }
+}
+
+void UWorldFrameSubsystem::RefreshSkyFrame()
+{
+    PublishSkyFrame();
+}
+
+void UWorldFrameSubsystem::HandleSimTimeAdvanced(double NewSimTimeSeconds)
+{
+    PublishSkyFrame();
+}
@@ -0,0 +1,13 @@
+// Copyright 2026 Threaded Pixel Factory
+// Licensed under the Apache License, Version 2.0 (the "License");
+// SPDX-License-Identifier: Apache-2.0
+
+#include "SpecRegistry.h"
+#include <atomic>
+
+uint32 SpecRegistry::NextGeneration()
+{
+	// Starts at 1 so a default FSpecHandle (generation 0) never resolves
+	static std::atomic<uint32> Generation{ 0 };
+	return ++Generation;
+}
@@ -4,6 +4,31 @@
 
 #include "SpecTypes.h"
 
+//=============================================================================
+// FSurfaceCurveLUT
+//=============================================================================
+
+FSurfaceCurveLUT::FSurfaceCurveLUT()
+{
+	for (float& Sample : Samples)
+	{
+		Sample = 1.0f;
+	}
+}
+
+void FSurfaceCurveLUT::Bake(const FRichCurve* Curve, float InMinX, float InMaxX, float DefaultValue)
+{
+	MinX = InMinX;
+	InvRange = (InMaxX > InMinX) ? 1.0f / (InMaxX - InMinX) : 0.0f;
+
+	const bool bHasCurve = Curve && Curve->GetNumKeys() > 0;
+	for (int32 i = 0; i < NumSamples; i++)
+	{
+		const float X = FMath::Lerp(InMinX, InMaxX, static_cast<float>(i) / static_cast<float>(NumSamples - 1));
+		Samples[i] = bHasCurve ? Curve->Eval(X) : DefaultValue;
+	}
+}
+
 //=============================================================================
 // USurfaceSpec
 //=============================================================================
@@ -5,9 +5,312 @@
 #include "Subsystems/BiomeSubsystem.h"
 #include "Subsystems/SurfaceQuerySubsystem.h"
 #include "Subsystems/EnvironmentSubsystem.h"
+#include "Space/Subsystems/WorldFrameSubsystem.h"
+#include "TPFCoreStats.h"
+#include "TPFTimingRecorder.h"
 #include "Engine/World.h"
+#include "EngineUtils.h"
 #include "LandscapeComponent.h"
+#include "LandscapeProxy.h"
 #include "Kismet/KismetSystemLibrary.h"
+#include "Algo/BinarySearch.h"
+#include "Async/ParallelFor.h"
+#include "Kismet/KismetRenderingLibrary.h"
+#include "Engine/TextureRenderTarget2D.h"
+#include "Materials/MaterialInstanceDynamic.h"
+#include "GameFramework/PlayerController.h"
+#include "Camera/PlayerCameraManager.h"
+#include "RenderingThread.h"
+#include "RHIGPUReadback.h"
+#include "TextureResource.h"
+#include <atomic>
+
+namespace
+{
+	/** FBiomeTile::TerrainStates values */
+	enum class EBiomeTexelTerrain : uint8
+	{
+		/** Not sampled yet, or sampled without hitting terrain (retried: it may not be loaded yet) */
+		Unbaked = 0,
+		Terrain,
+	};
+
+	/** FBiomeTile::BiomeIndices value for a texel whose rules have not been resolved */
+	constexpr uint8 BiomeTexelUnresolved = 0xFF;
+
+	/** FBiomeTile::BiomeIndices value for a texel whose rules matched no biome */
+	constexpr uint8 BiomeTexelNone = 0xFE;
+
+	/** Palette indices must stay below the markers */
+	constexpr int32 MaxBiomePaletteSize = BiomeTexelNone;
+
+	/** Points per ParallelFor task in batch classification */
+	constexpr int32 BiomeQueryBatchSize = 256;
+
+	/** Largest GetBiomesInCell grid per axis */
+	constexpr int32 MaxCellQueryResolution = 1024;
+
+	float SlopeAngleFromUpDot(float UpDot)
+	{
+		return FMath::RadiansToDegrees(FMath::Acos(FMath::Clamp(UpDot, -1.0f, 1.0f)));
+	}
+
+	/** Capture material parameters, set per tile */
+	const FName RVTCaptureOriginParam(TEXT("CaptureOrigin"));
+	const FName RVTCaptureSizeParam(TEXT("CaptureSize"));
+}
+
+/** One in-flight RVT tile capture; copied out on the render thread once the GPU is done */
+struct FRVTBiomeReadback
+{
+	FWorldCellKey CellKey;
+	TUniquePtr<FRHIGPUTextureReadback> Readback;
+
+	/** Written on the render thread before bComplete is set; game thread only reads after */
+	TArray<FColor> Texels;
+	std::atomic<bool> bComplete{ false };
+};
+
+//=============================================================================
+// FBiomeRuleTable
+//=============================================================================
+
+void FBiomeRuleTable::Reset()
+{
+	Rules.Reset();
+	AltitudeAxis = FAxis();
+	SlopeAxis = FAxis();
+	NumWords = 0;
+}
+
+void FBiomeRuleTable::Build(TConstArrayView<const FBiomeSpec*> Specs, bool bInUseAltitude, bool bInUseSlope)
+{
+	Reset();
+	bUseAltitude = bInUseAltitude;
+	bUseSlope = bInUseSlope;
+
+	for (const FBiomeSpec* Spec : Specs)
+	{
+		if (Spec)
+		{
+			Rules.Add({ Spec->BiomeId, Spec->AltitudeRange, Spec->SlopeRange });
+		}
+	}
+
+	NumWords = FMath::DivideAndRoundUp(Rules.Num(), 64);
+
+	if (bUseAltitude)
+	{
+		BuildAxis(AltitudeAxis, [](const FRule& Rule) { return Rule.AltitudeRange; });
+	}
+	if (bUseSlope)
+	{
+		BuildAxis(SlopeAxis, [](const FRule& Rule) { return Rule.SlopeRange; });
+	}
+}
+
+void FBiomeRuleTable::BuildAxis(FAxis& Axis, TFunctionRef<FVector2D(const FRule&)> GetRange) const
+{
+	for (const FRule& Rule : Rules)
+	{
+		const FVector2D Range = GetRange(Rule);
+		Axis.Breakpoints.Add(Range.X);
+		Axis.Breakpoints.Add(Range.Y);
+	}
+
+	Axis.Breakpoints.Sort();
+	for (int32 i = Axis.Breakpoints.Num() - 1; i > 0; i--)
+	{
+		if (Axis.Breakpoints[i] == Axis.Breakpoints[i - 1])
+		{
+			Axis.Breakpoints.RemoveAt(i, 1, EAllowShrinking::No);
+		}
+	}
+
+	// A single breakpoint still forms one (degenerate) interval
+	const int32 NumIntervals = FMath::Max(Axis.Breakpoints.Num() - 1, 1);
+	Axis.Masks.SetNumZeroed(NumIntervals * NumWords);
+
+	for (int32 Interval = 0; Interval < NumIntervals && Axis.Breakpoints.Num() > 0; Interval++)
+	{
+		const double Lo = Axis.Breakpoints[Interval];
+		const double Hi = Axis.Breakpoints[FMath::Min(Interval + 1, Axis.Breakpoints.Num() - 1)];
+		uint64* Mask = &Axis.Masks[Interval * NumWords];
+
+		// Closed overlap, so rules that only touch an endpoint stay candidates; ScoreRule settles them
+		for (int32 RuleIndex = 0; RuleIndex < Rules.Num(); RuleIndex++)
+		{
+			const FVector2D Range = GetRange(Rules[RuleIndex]);
+			if (Range.X <= Hi && Range.Y >= Lo)
+			{
+				Mask[RuleIndex / 64] |= uint64(1) << (RuleIndex % 64);
+			}
+		}
+	}
+}
+
+int32 FBiomeRuleTable::FAxis::FindInterval(double Value) const
+{
+	if (Breakpoints.Num() == 0 || Value < Breakpoints[0] || Value > Breakpoints.Last())
+	{
+		return INDEX_NONE;
+	}
+
+	const int32 NumIntervals = FMath::Max(Breakpoints.Num() - 1, 1);
+	return FMath::Clamp(Algo::UpperBound(Breakpoints, Value) - 1, 0, NumIntervals - 1);
+}
+
+bool FBiomeRuleTable::ScoreRule(const FRule& Rule, float Altitude, float SlopeAngle, float& OutScore) const
+{
+	float Score = 0.0f;
+
+	// Check altitude range
+	if (bUseAltitude)
+	{
+		if (Altitude < Rule.AltitudeRange.X || Altitude > Rule.AltitudeRange.Y)
+		{
+			return false;
+		}
+
+		// Score based on how centered we are in the range
+		float AltitudeRange = Rule.AltitudeRange.Y - Rule.AltitudeRange.X;
+		if (AltitudeRange > 0.0f)
+		{
+			float AltitudeCenter = (Rule.AltitudeRange.X + Rule.AltitudeRange.Y) * 0.5f;
+			float AltitudeDistance = FMath::Abs(Altitude - AltitudeCenter) / (AltitudeRange * 0.5f);
+			Score += 1.0f - AltitudeDistance; // Higher score for being closer to center
+		}
+	}
+
+	// Check slope range
+	if (bUseSlope)
+	{
+		if (SlopeAngle < Rule.SlopeRange.X || SlopeAngle > Rule.SlopeRange.Y)
+		{
+			return false;
+		}
+
+		float SlopeRange = Rule.SlopeRange.Y - Rule.SlopeRange.X;
+		if (SlopeRange > 0.0f)
+		{
+			float SlopeCenter = (Rule.SlopeRange.X + Rule.SlopeRange.Y) * 0.5f;
+			float SlopeDistance = FMath::Abs(SlopeAngle - SlopeCenter) / (SlopeRange * 0.5f);
+			Score += 1.0f - SlopeDistance;
+		}
+	}
+
+	OutScore = Score;
+	return true;
+}
+
+FBiomeId FBiomeRuleTable::Resolve(float Altitude, float SlopeAngle) const
+{
+	const uint64* AltitudeMask = nullptr;
+	if (bUseAltitude)
+	{
+		const int32 Interval = AltitudeAxis.FindInterval(Altitude);
+		if (Interval == INDEX_NONE)
+		{
+			return FBiomeId();
+		}
+		AltitudeMask = &AltitudeAxis.Masks[Interval * NumWords];
+	}
+
+	const uint64* SlopeMask = nullptr;
+	if (bUseSlope)
+	{
+		const int32 Interval = SlopeAxis.FindInterval(SlopeAngle);
+		if (Interval == INDEX_NONE)
+		{
+			return FBiomeId();
+		}
+		SlopeMask = &SlopeAxis.Masks[Interval * NumWords];
+	}
+
+	float BestScore = -1.0f;
+	int32 BestRule = INDEX_NONE;
+
+	// Bits are visited in rule order, so ties resolve exactly as the linear scan did
+	for (int32 Word = 0; Word < NumWords; Word++)
+	{
+		uint64 Candidates = (AltitudeMask ? AltitudeMask[Word] : ~uint64(0)) & (SlopeMask ? SlopeMask[Word] : ~uint64(0));
+		while (Candidates)
+		{
+			const int32 RuleIndex = Word * 64 + static_cast<int32>(FMath::CountTrailingZeros64(Candidates));
+			Candidates &= Candidates - 1;
+			if (RuleIndex >= Rules.Num())
+			{
+				break;
+			}
+
+			float Score = 0.0f;
+			if (ScoreRule(Rules[RuleIndex], Altitude, SlopeAngle, Score) && Score > BestScore)
+			{
+				BestScore = Score;
+				BestRule = RuleIndex;
+			}
+		}
+	}
+
+	return BestRule != INDEX_NONE ? Rules[BestRule].BiomeId : FBiomeId();
+}
+
+//=============================================================================
+// FBiomeQuerySnapshot
+//=============================================================================
+
+void FBiomeBatchResult::SetNum(int32 NumPoints)
+{
+	Biomes.SetNum(NumPoints);
+	SurfaceSpecIds.SetNum(NumPoints);
+	MediumSpecIds.SetNum(NumPoints);
+	TerrainHeights.SetNum(NumPoints);
+	SlopeAngles.SetNum(NumPoints);
+}
+
+FBiomeId FBiomeQuerySnapshot::ResolveBiome(float Altitude, float SlopeAngle) const
+{
+	const FBiomeId Biome = Rules.Resolve(Altitude, SlopeAngle);
+	return Biome.IsValid() ? Biome : DefaultBiomeId;
+}
+
+void FBiomeQuerySnapshot::SetBiome(FBiomeBatchResult& OutResult, int32 Index, const FBiomeId& BiomeId) const
+{
+	const FSpecIds* Ids = SpecIds.Find(BiomeId);
+	OutResult.Biomes[Index] = BiomeId;
+	OutResult.SurfaceSpecIds[Index] = Ids ? Ids->SurfaceSpecId : FSurfaceSpecId();
+	OutResult.MediumSpecIds[Index] = Ids ? Ids->MediumSpecId : FMediumSpecId();
+}
+
+void FBiomeQuerySnapshot::ClassifyPoints(TConstArrayView<float> TerrainHeights, TConstArrayView<float> SlopeAngles,
+	FBiomeBatchResult& OutResult) const
+{
+	check(TerrainHeights.Num() == SlopeAngles.Num());
+	const int32 NumPoints = TerrainHeights.Num();
+	OutResult.SetNum(NumPoints);
+
+	// The subsystem's batch query passes views of OutResult's own arrays
+	if (OutResult.TerrainHeights.GetData() != TerrainHeights.GetData())
+	{
+		FMemory::Memcpy(OutResult.TerrainHeights.GetData(), TerrainHeights.GetData(), NumPoints * sizeof(float));
+	}
+	if (OutResult.SlopeAngles.GetData() != SlopeAngles.GetData())
+	{
+		FMemory::Memcpy(OutResult.SlopeAngles.GetData(), SlopeAngles.GetData(), NumPoints * sizeof(float));
+	}
+
+	const int32 NumBatches = FMath::DivideAndRoundUp(NumPoints, BiomeQueryBatchSize);
+	ParallelFor(NumBatches, [this, &OutResult, NumPoints](int32 BatchIndex)
+	{
+		const int32 Start = BatchIndex * BiomeQueryBatchSize;
+		const int32 End = FMath::Min(Start + BiomeQueryBatchSize, NumPoints);
+
+		for (int32 i = Start; i < End; i++)
+		{
+			SetBiome(OutResult, i, ResolveBiome(OutResult.TerrainHeights[i] - SeaLevelAltitude, OutResult.SlopeAngles[i]));
+		}
+	}, NumBatches <= 1 ? EParallelForFlags::ForceSingleThread : EParallelForFlags::None);
+}
 
 //=============================================================================
 // UBiomeSubsystem
@@ -19,18 +322,43 @@ UBiomeSubsystem::UBiomeSubsystem()
 
 void UBiomeSubsystem::Initialize(FSubsystemCollectionBase& Collection)
 {
+	TPF_TIMING_SCOPE(TEXT("BiomeSubsystem::Initialize"));
+
 	Super::Initialize(Collection);
 
 	// Get references to other subsystems
 	SurfaceQuerySubsystem = GetWorld()->GetSubsystem<USurfaceQuerySubsystem>();
 	EnvironmentSubsystem = GetWorld()->GetSubsystem<UEnvironmentSubsystem>();
 
+	// Streaming terrain in or out changes what cached texels would trace
+	LevelAddedHandle = FWorldDelegates::LevelAddedToWorld.AddUObject(this, &UBiomeSubsystem::HandleLevelChanged);
+	LevelRemovedHandle = FWorldDelegates::LevelRemovedFromWorld.AddUObject(this, &UBiomeSubsystem::HandleLevelChanged);
+
+	if (UWorldFrameSubsystem* WorldFrame = Collection.InitializeDependency<UWorldFrameSubsystem>())
+	{
+		OriginRebasedHandle = WorldFrame->OnWorldOriginRebased.AddUObject(this, &UBiomeSubsystem::HandleWorldOriginRebased);
+	}
+
 	UE_LOG(LogTemp, Log, TEXT("BiomeSubsystem initialized for world: %s"), 
 		*GetWorld()->GetName());
 }
 
 void UBiomeSubsystem::Deinitialize()
 {
+	FWorldDelegates::LevelAddedToWorld.Remove(LevelAddedHandle);
+	FWorldDelegates::LevelRemovedFromWorld.Remove(LevelRemovedHandle);
+	if (UWorldFrameSubsystem* WorldFrame = GetWorld()->GetSubsystem<UWorldFrameSubsystem>())
+	{
+		WorldFrame->OnWorldOriginRebased.Remove(OriginRebasedHandle);
+	}
+
+	InvalidateBiomeCache();
+	LandscapeEntries.Reset();
+	RVTTiles.Empty();
+	RequestedRVTTiles.Empty();
+	PendingRVTReadbacks.Empty();
+	RVTCaptureTarget = nullptr;
+	RVTCaptureMaterialInstance = nullptr;
 	BiomeSpecs.Empty();
 	DefaultBiomeId = FBiomeId();
 
@@ -52,77 +380,44 @@ bool UBiomeSubsystem::ShouldCreateSubsystem(UObject* Outer) const
 
 FBiomeQueryResult UBiomeSubsystem::GetBiomeAtLocation(const FVector& WorldLocation) const
 {
-	FBiomeQueryResult Result;
+	SCOPE_CYCLE_COUNTER(STAT_TPF_BiomeQuery);
+	INC_DWORD_STAT(STAT_TPF_BiomeQueries);
 
-	// Calculate terrain properties
-	float TerrainHeight = GetTerrainHeightAtLocation(WorldLocation);
-	float Altitude = WorldLocation.Z - SeaLevelAltitude;
-	float SlopeAngle = GetTerrainSlopeAtLocation(WorldLocation);
+	FBiomeQueryResult Result;
 
-	Result.Altitude = Altitude;
-	Result.SlopeAngle = SlopeAngle;
+	// Terrain altitude and slope, as GetBiomesAtLocations; the query altitude only without terrain below
+	float Height = WorldLocation.Z;
+	float SlopeAngle = 0.0f;
 
-	// Try RVT-based lookup first if enabled
-	if (bUseRVTBiomeLookup)
+	// Texels with terrain carry their rule result
+	FBiomeId CachedRuleBiome;
+	bool bHasCachedRuleBiome = false;
+	if (bCacheBiomeTiles)
 	{
-		TArray<float> RVTWeights;
-		if (SampleRVTAtLocation(WorldLocation, RVTWeights))
+		bHasCachedRuleBiome = FetchBiomeTexel(WorldLocation, CachedRuleBiome, Height, SlopeAngle);
+	}
+	else
+	{
+		float TerrainHeight = 0.0f;
+		FVector Normal = FVector::UpVector;
+		if (SampleTerrain(WorldLocation, TerrainHeight, Normal))
 		{
-			// Find the biome with highest weight
-			float MaxWeight = 0.0f;
-			float SecondMaxWeight = 0.0f;
-			int32 MaxChannel = -1;
-			int32 SecondMaxChannel = -1;
-
-			for (int32 i = 0; i < RVTWeights.Num(); ++i)
-			{
-				if (RVTWeights[i] > MaxWeight)
-				{
-					SecondMaxWeight = MaxWeight;
-					SecondMaxChannel = MaxChannel;
-					MaxWeight = RVTWeights[i];
-					MaxChannel = i;
-				}
-				else if (RVTWeights[i] > SecondMaxWeight)
-				{
-					SecondMaxWeight = RVTWeights[i];
-					SecondMaxChannel = i;
-				}
-			}
-
-			// Map channels to biomes
-			if (MaxChannel >= 0)
-			{
-				for (const auto& Pair : BiomeSpecs)
-				{
-					if (Pair.Value.RVTChannel == MaxChannel)
-					{
-						Result.PrimaryBiome = Pair.Value.BiomeId;
-						Result.PrimaryWeight = MaxWeight;
-						break;
-					}
-				}
-
-				if (SecondMaxChannel >= 0 && SecondMaxWeight > 0.01f)
-				{
-					for (const auto& Pair : BiomeSpecs)
-					{
-						if (Pair.Value.RVTChannel == SecondMaxChannel)
-						{
-							Result.SecondaryBiome = Pair.Value.BiomeId;
-							Result.SecondaryWeight = SecondMaxWeight;
-							break;
-						}
-					}
-				}
-			}
+			Height = TerrainHeight;
+			SlopeAngle = SlopeAngleFromUpDot(Normal.Z);
 		}
 	}
 
+	const float Altitude = Height - SeaLevelAltitude;
+	Result.Altitude = Altitude;
+	Result.SlopeAngle = SlopeAngle;
+
+	// Try RVT-based lookup first if enabled
+	ResolveBiomeFromRVT(WorldLocation, Result);
+
 	// Fall back to rule-based resolution if no RVT result
 	if (!Result.PrimaryBiome.IsValid())
 	{
-		Result.PrimaryBiome = ResolveBiomeFromRules(Altitude, SlopeAngle);
+		Result.PrimaryBiome = bHasCachedRuleBiome ? CachedRuleBiome : ResolveBiomeFromRules(Altitude, SlopeAngle);
 		Result.PrimaryWeight = 1.0f;
 	}
 
@@ -180,21 +475,129 @@ FSurfaceSpecId UBiomeSubsystem::GetSurfaceSpecAtLocation(const FVector& WorldLoc
 	return Result.SurfaceSpecId;
 }
 
+void UBiomeSubsystem::GetBiomesAtLocations(TConstArrayView<FVector> WorldLocations, FBiomeBatchResult& OutResult) const
+{
+	SCOPE_CYCLE_COUNTER(STAT_TPF_BiomeQuery);
+	INC_DWORD_STAT_BY(STAT_TPF_BiomeQueries, WorldLocations.Num());
+
+	const int32 NumPoints = WorldLocations.Num();
+	OutResult.SetNum(NumPoints);
+
+	// Pass 1: terrain, on this thread. Through the tile cache, points sharing a texel share one bake.
+	for (int32 i = 0; i < NumPoints; i++)
+	{
+		const FVector& Location = WorldLocations[i];
+		float Height = Location.Z;
+		float SlopeAngle = 0.0f;
+
+		if (bCacheBiomeTiles)
+		{
+			int32 Texel = 0;
+			const FBiomeTile& Tile = FetchTerrainTexel(Location, Texel);
+			if (Tile.TerrainStates[Texel] == static_cast<uint8>(EBiomeTexelTerrain::Terrain))
+			{
+				Height = Tile.Heights[Texel];
+				SlopeAngle = SlopeAngleFromUpDot(Tile.Normals[Texel].Z);
+			}
+		}
+		else
+		{
+			float TerrainHeight = 0.0f;
+			FVector Normal = FVector::UpVector;
+			if (SampleTerrain(Location, TerrainHeight, Normal))
+			{
+				Height = TerrainHeight;
+				SlopeAngle = SlopeAngleFromUpDot(Normal.Z);
+			}
+		}
+
+		OutResult.TerrainHeights[i] = Height;
+		OutResult.SlopeAngles[i] = SlopeAngle;
+	}
+
+	// Pass 2: rules and spec lookup, across workers
+	const TSharedRef<const FBiomeQuerySnapshot, ESPMode::ThreadSafe> Snapshot = GetQuerySnapshot();
+	Snapshot->ClassifyPoints(OutResult.TerrainHeights, OutResult.SlopeAngles, OutResult);
+
+	// Pass 3: RVT masks override rules where their tiles are resident (misses request the tile)
+	if (bUseRVTBiomeLookup)
+	{
+		for (int32 i = 0; i < NumPoints; i++)
+		{
+			FBiomeQueryResult RVTResult;
+			if (ResolveBiomeFromRVT(WorldLocations[i], RVTResult))
+			{
+				Snapshot->SetBiome(OutResult, i, RVTResult.PrimaryBiome);
+			}
+		}
+	}
+}
+
+void UBiomeSubsystem::GetBiomesInCell(const FWorldCellKey& CellKey, int32 Resolution, float QueryZ, FBiomeBatchResult& OutResult) const
+{
+	const int32 Samples = FMath::Clamp(Resolution, 1, MaxCellQueryResolution);
+	const FBox Bounds = CellKey.GetWorldBounds(BiomeTileCellSize);
+	const double Spacing = (Bounds.Max.X - Bounds.Min.X) / Samples;
+
+	TArray<FVector> Locations;
+	Locations.Reserve(Samples * Samples);
+	for (int32 Y = 0; Y < Samples; Y++)
+	{
+		for (int32 X = 0; X < Samples; X++)
+		{
+			Locations.Emplace(Bounds.Min.X + (X + 0.5) * Spacing, Bounds.Min.Y + (Y + 0.5) * Spacing, QueryZ);
+		}
+	}
+
+	GetBiomesAtLocations(Locations, OutResult);
+}
+
+TSharedRef<const FBiomeQuerySnapshot, ESPMode::ThreadSafe> UBiomeSubsystem::GetQuerySnapshot() const
+{
+	check(IsInGameThread());
+
+	// Holders of an old snapshot keep it alive; a rule change just publishes a new one
+	const uint32 RuleKey = GetBiomeRuleKey();
+	if (!QuerySnapshot.IsValid() || QuerySnapshotKey != RuleKey)
+	{
+		TSharedRef<FBiomeQuerySnapshot, ESPMode::ThreadSafe> Snapshot = MakeShared<FBiomeQuerySnapshot, ESPMode::ThreadSafe>();
+		Snapshot->Rules = GetCompiledRules();
+		Snapshot->DefaultBiomeId = DefaultBiomeId;
+		Snapshot->SeaLevelAltitude = SeaLevelAltitude;
+		Snapshot->SpecIds.Reserve(BiomeSpecs.Num());
+		for (const auto& Pair : BiomeSpecs)
+		{
+			Snapshot->SpecIds.Add(Pair.Value.BiomeId, { Pair.Value.DefaultSurfaceSpecId, Pair.Value.DefaultMediumSpecId });
+		}
+
+		QuerySnapshot = Snapshot;
+		QuerySnapshotKey = RuleKey;
+	}
+	return QuerySnapshot.ToSharedRef();
+}
+
 //=============================================================================
 // TERRAIN QUERIES
 //=============================================================================
 
 float UBiomeSubsystem::GetTerrainHeightAtLocation(const FVector& WorldLocation) const
 {
+	float LandscapeHeight = 0.0f;
+	if (SampleLandscape(WorldLocation, LandscapeHeight, nullptr))
+	{
+		return LandscapeHeight;
+	}
+
 	UWorld* World = GetWorld();
 	if (!World)
 	{
 		return 0.0f;
 	}
 
-	// Perform a line trace downward to find terrain
-	FVector Start = FVector(WorldLocation.X, WorldLocation.Y, WorldLocation.Z + 100000.0f);
-	FVector End = FVector(WorldLocation.X, WorldLocation.Y, WorldLocation.Z - 100000.0f);
+	// Perform a line trace downward to find terrain, through the same fixed column as SampleTerrain
+	const double OriginZ = World->OriginLocation.Z;
+	const FVector Start(WorldLocation.X, WorldLocation.Y, TerrainTraceMaxZ - OriginZ);
+	const FVector End(WorldLocation.X, WorldLocation.Y, TerrainTraceMinZ - OriginZ);
 
 	FHitResult HitResult;
 	FCollisionQueryParams QueryParams;
@@ -228,6 +631,13 @@ float UBiomeSubsystem::GetTerrainSlopeAtLocation(const FVector& WorldLocation) c
 
 FVector UBiomeSubsystem::GetTerrainNormalAtLocation(const FVector& WorldLocation) const
 {
+	float LandscapeHeight = 0.0f;
+	FVector LandscapeNormal = FVector::UpVector;
+	if (SampleLandscape(WorldLocation, LandscapeHeight, &LandscapeNormal))
+	{
+		return LandscapeNormal;
+	}
+
 	UWorld* World = GetWorld();
 	if (!World)
 	{
@@ -235,8 +645,10 @@ FVector UBiomeSubsystem::GetTerrainNormalAtLocation(const FVector& WorldLocation
 	}
 
 	// Perform a line trace downward to find terrain normal
-	FVector Start = FVector(WorldLocation.X, WorldLocation.Y, WorldLocation.Z + 100000.0f);
-	FVector End = FVector(WorldLocation.X, WorldLocation.Y, WorldLocation.Z - 100000.0f);
+	// Fixed column, never the query's Z: a baked texel holds for every altitude in it
+	const double OriginZ = World->OriginLocation.Z;
+	const FVector Start(WorldLocation.X, WorldLocation.Y, TerrainTraceMaxZ - OriginZ);
+	const FVector End(WorldLocation.X, WorldLocation.Y, TerrainTraceMinZ - OriginZ);
 
 	FHitResult HitResult;
 	FCollisionQueryParams QueryParams;
@@ -259,11 +671,44 @@ void UBiomeSubsystem::RegisterBiomeSpec(const FBiomeSpec& Spec)
 	if (Spec.BiomeId.IsValid())
 	{
 		BiomeSpecs.Add(Spec.BiomeId.Id, Spec);
+		BiomeRulesRevision++;
+		RebuildRVTChannelTable();
 
 		UE_LOG(LogTemp, Verbose, TEXT("Registered BiomeSpec: %s"), *Spec.BiomeId.Id.ToString());
 	}
 }
 
+int32 UBiomeSubsystem::UpdateBiomeSpecs(TConstArrayView<FBiomeSpec> Specs)
+{
+	UScriptStruct* SpecStruct = FBiomeSpec::StaticStruct();
+
+	int32 NumChanged = 0;
+	for (const FBiomeSpec& Spec : Specs)
+	{
+		if (!Spec.BiomeId.IsValid())
+		{
+			continue;
+		}
+
+		const FBiomeSpec* Existing = BiomeSpecs.Find(Spec.BiomeId.Id);
+		if (Existing && SpecStruct->CompareScriptStruct(Existing, &Spec, PPF_None))
+		{
+			continue;
+		}
+
+		BiomeSpecs.Add(Spec.BiomeId.Id, Spec);
+		NumChanged++;
+	}
+
+	if (NumChanged > 0)
+	{
+		BiomeRulesRevision++;
+		RebuildRVTChannelTable();
+		UE_LOG(LogTemp, Verbose, TEXT("Updated %d BiomeSpecs"), NumChanged);
+	}
+	return NumChanged;
+}
+
 const FBiomeSpec* UBiomeSubsystem::GetBiomeSpec(const FBiomeId& BiomeId) const
 {
 	if (!BiomeId.IsValid())
@@ -277,6 +722,7 @@ const FBiomeSpec* UBiomeSubsystem::GetBiomeSpec(const FBiomeId& BiomeId) const
 void UBiomeSubsystem::SetDefaultBiome(const FBiomeId& BiomeId)
 {
 	DefaultBiomeId = BiomeId;
+	BiomeRulesRevision++;
 
 	UE_LOG(LogTemp, Log, TEXT("Default biome set to: %s"), *BiomeId.Id.ToString());
 }
@@ -294,89 +740,585 @@ TArray<FBiomeId> UBiomeSubsystem::GetAllBiomeIds() const
 	return Result;
 }
 
+//=============================================================================
+// BIOME TILE CACHE
+//=============================================================================
+
+void UBiomeSubsystem::InvalidateBiomeCache()
+{
+	BiomeTiles.Empty();
+	BiomeTilePalette.Reset();
+}
+
+void UBiomeSubsystem::InvalidateBiomeCacheInBounds(const FBox& WorldBounds)
+{
+	if (!WorldBounds.IsValid)
+	{
+		return;
+	}
+
+	const FWorldCellKey MinCell = FWorldCellKey::FromWorldLocation(WorldBounds.Min, BiomeTileCellSize);
+	const FWorldCellKey MaxCell = FWorldCellKey::FromWorldLocation(WorldBounds.Max, BiomeTileCellSize);
+
+	for (auto It = BiomeTiles.CreateIterator(); It; ++It)
+	{
+		const FWorldCellKey& Cell = It->Key;
+		if (Cell.X >= MinCell.X && Cell.X <= MaxCell.X && Cell.Y >= MinCell.Y && Cell.Y <= MaxCell.Y)
+		{
+			It.RemoveCurrent();
+		}
+	}
+}
+
+void UBiomeSubsystem::HandleLevelChanged(ULevel* Level, UWorld* World)
+{
+	if (World == GetWorld())
+	{
+		InvalidateBiomeCache();
+		bLandscapeEntriesDirty = true;
+	}
+}
+
+void UBiomeSubsystem::HandleWorldOriginRebased(const FIntVector& ShiftCm)
+{
+	// Sea level moves with the terrain; the rule key changes, so resolved texels re-resolve
+	SeaLevelAltitude -= static_cast<float>(ShiftCm.Z);
+
+	InvalidateBiomeCache();
+	RVTTiles.Empty();
+	RequestedRVTTiles.Empty();
+	PendingRVTReadbacks.Empty();
+	bLandscapeEntriesDirty = true;
+}
+
+uint32 UBiomeSubsystem::GetBiomeRuleKey() const
+{
+	uint32 Key = HashCombine(GetTypeHash(BiomeRulesRevision), GetTypeHash(SeaLevelAltitude));
+	return HashCombine(Key, (bUseAltitudeRules ? 1u : 0u) | (bUseSlopeRules ? 2u : 0u));
+}
+
+UBiomeSubsystem::FBiomeTile& UBiomeSubsystem::FindOrAddBiomeTile(const FWorldCellKey& CellKey) const
+{
+	const uint64 Frame = GFrameCounter;
+	const uint32 RuleKey = GetBiomeRuleKey();
+
+	FBiomeTile* Tile = BiomeTiles.Find(CellKey);
+	if (!Tile)
+	{
+		if (BiomeTiles.Num() > 0 && BiomeTiles.Num() >= MaxResidentBiomeTiles)
+		{
+			auto Oldest = BiomeTiles.CreateIterator();
+			for (auto It = BiomeTiles.CreateIterator(); It; ++It)
+			{
+				if (It->Value.LastUsedFrame < Oldest->Value.LastUsedFrame)
+				{
+					Oldest = It;
+				}
+			}
+			Oldest.RemoveCurrent();
+		}
+
+		Tile = &BiomeTiles.Add(CellKey);
+		Tile->TerrainStates.SetNumZeroed(FBiomeTile::TexelCount);
+		Tile->BiomeIndices.Init(BiomeTexelUnresolved, FBiomeTile::TexelCount);
+		Tile->Heights.SetNumZeroed(FBiomeTile::TexelCount);
+		Tile->Normals.SetNumZeroed(FBiomeTile::TexelCount);
+		Tile->RuleKey = RuleKey;
+	}
+	else if (Tile->RuleKey != RuleKey)
+	{
+		// Terrain is still valid; only the rule results are stale
+		FMemory::Memset(Tile->BiomeIndices.GetData(), BiomeTexelUnresolved, FBiomeTile::TexelCount);
+		Tile->RuleKey = RuleKey;
+	}
+
+	Tile->LastUsedFrame = Frame;
+	return *Tile;
+}
+
+int32 UBiomeSubsystem::FindOrAddBiomePaletteIndex(const FBiomeId& BiomeId) const
+{
+	const int32 Existing = BiomeTilePalette.IndexOfByKey(BiomeId);
+	if (Existing != INDEX_NONE)
+	{
+		return Existing;
+	}
+
+	if (BiomeTilePalette.Num() >= MaxBiomePaletteSize)
+	{
+		return INDEX_NONE;
+	}
+
+	return BiomeTilePalette.Add(BiomeId);
+}
+
+UBiomeSubsystem::FBiomeTile& UBiomeSubsystem::FetchTerrainTexel(const FVector& WorldLocation, int32& OutTexel) const
+{
+	const FWorldCellKey CellKey = FWorldCellKey::FromWorldLocation(WorldLocation, BiomeTileCellSize);
+	FBiomeTile& Tile = FindOrAddBiomeTile(CellKey);
+	const int32 Texel = FSurfaceTileDelta::TileIndexFromWorldLocation(WorldLocation, CellKey, BiomeTileCellSize);
+
+	if (Tile.TerrainStates[Texel] == static_cast<uint8>(EBiomeTexelTerrain::Unbaked))
+	{
+		// Sample at the texel centre so every query in the texel bakes the same terrain
+		const float TexelSize = BiomeTileCellSize / FBiomeTile::TexelsPerAxis;
+		const FVector TexelCentre(
+			CellKey.X * static_cast<double>(BiomeTileCellSize) + (Texel % FBiomeTile::TexelsPerAxis + 0.5f) * TexelSize,
+			CellKey.Y * static_cast<double>(BiomeTileCellSize) + (Texel / FBiomeTile::TexelsPerAxis + 0.5f) * TexelSize,
+			0.0); // Z is not used: terrain is traced through a fixed column
+
+		float Height = 0.0f;
+		FVector Normal = FVector::UpVector;
+		if (SampleTerrain(TexelCentre, Height, Normal))
+		{
+			Tile.TerrainStates[Texel] = static_cast<uint8>(EBiomeTexelTerrain::Terrain);
+			Tile.Heights[Texel] = Height;
+			Tile.Normals[Texel] = FVector3f(Normal);
+		}
+	}
+	else
+	{
+		INC_DWORD_STAT(STAT_TPF_BiomeTileCacheHits);
+	}
+
+	OutTexel = Texel;
+	return Tile;
+}
+
+bool UBiomeSubsystem::FetchBiomeTexel(const FVector& WorldLocation, FBiomeId& OutRuleBiome, float& OutTerrainHeight, float& OutSlopeAngle) const
+{
+	int32 Texel = 0;
+	FBiomeTile& Tile = FetchTerrainTexel(WorldLocation, Texel);
+
+	if (Tile.TerrainStates[Texel] != static_cast<uint8>(EBiomeTexelTerrain::Terrain))
+	{
+		// Same as an uncached query that hits nothing: flat
+		OutSlopeAngle = 0.0f;
+		return false;
+	}
+
+	OutTerrainHeight = Tile.Heights[Texel];
+	OutSlopeAngle = SlopeAngleFromUpDot(Tile.Normals[Texel].Z);
+
+	uint8& BiomeIndex = Tile.BiomeIndices[Texel];
+	if (BiomeIndex == BiomeTexelUnresolved)
+	{
+		const FBiomeId Biome = ResolveBiomeFromRules(OutTerrainHeight - SeaLevelAltitude, OutSlopeAngle);
+		const int32 PaletteIndex = Biome.IsValid() ? FindOrAddBiomePaletteIndex(Biome) : BiomeTexelNone;
+		if (PaletteIndex == INDEX_NONE)
+		{
+			// Palette full - correct result, just not cached
+			OutRuleBiome = Biome;
+			return true;
+		}
+		BiomeIndex = static_cast<uint8>(PaletteIndex);
+	}
+
+	OutRuleBiome = BiomeIndex == BiomeTexelNone ? FBiomeId() : BiomeTilePalette[BiomeIndex];
+	return true;
+}
+
 //=============================================================================
 // INTERNAL
 //=============================================================================
 
+bool UBiomeSubsystem::SampleTerrain(const FVector& WorldLocation, float& OutHeight, FVector& OutNormal) const
+{
+	if (SampleLandscape(WorldLocation, OutHeight, &OutNormal))
+	{
+		return true;
+	}
+
+	UWorld* World = GetWorld();
+	if (!World)
+	{
+		return false;
+	}
+
+	// Fixed column, never the query's Z: a baked texel holds for every altitude in it
+	const double OriginZ = World->OriginLocation.Z;
+	const FVector Start(WorldLocation.X, WorldLocation.Y, TerrainTraceMaxZ - OriginZ);
+	const FVector End(WorldLocation.X, WorldLocation.Y, TerrainTraceMinZ - OriginZ);
+
+	FHitResult HitResult;
+	FCollisionQueryParams QueryParams;
+	QueryParams.bTraceComplex = true; // Need complex for accurate normal
+	QueryParams.bReturnPhysicalMaterial = false;
+
+	if (World->LineTraceSingleByChannel(HitResult, Start, End, ECC_WorldStatic, QueryParams) && HitResult.Component.IsValid())
+	{
+		OutHeight = HitResult.Location.Z;
+		OutNormal = HitResult.ImpactNormal;
+		return true;
+	}
+
+	return false;
+}
+
 FBiomeId UBiomeSubsystem::ResolveBiomeFromRules(float Altitude, float SlopeAngle) const
 {
-	// Score each biome based on how well it matches the rules
-	float BestScore = -1.0f;
-	FBiomeId BestBiome;
+	// Return best match or default
+	const FBiomeId BestBiome = GetCompiledRules().Resolve(Altitude, SlopeAngle);
+	if (BestBiome.IsValid())
+	{
+		return BestBiome;
+	}
+
+	return DefaultBiomeId;
+}
+
+const FBiomeRuleTable& UBiomeSubsystem::GetCompiledRules() const
+{
+	// Lazily, so loading a SpecPack of N biomes compiles once rather than N times
+	const uint32 RuleKey = GetBiomeRuleKey();
+	if (!bCompiledRulesValid || CompiledRulesKey != RuleKey)
+	{
+		TArray<const FBiomeSpec*> Specs;
+		Specs.Reserve(BiomeSpecs.Num());
+		for (const auto& Pair : BiomeSpecs)
+		{
+			Specs.Add(&Pair.Value);
+		}
+
+		CompiledRules.Build(Specs, bUseAltitudeRules, bUseSlopeRules);
+		CompiledRulesKey = RuleKey;
+		bCompiledRulesValid = true;
+	}
+
+	return CompiledRules;
+}
+
+bool UBiomeSubsystem::ResolveBiomeFromRVT(const FVector& WorldLocation, FBiomeQueryResult& OutResult) const
+{
+	if (!bUseRVTBiomeLookup)
+	{
+		return false;
+	}
+
+	TStaticArray<float, NumRVTBiomeChannels> RVTWeights;
+	if (!SampleRVTAtLocation(WorldLocation, RVTWeights))
+	{
+		return false;
+	}
+
+	// Find the biome with highest weight
+	float MaxWeight = 0.0f;
+	float SecondMaxWeight = 0.0f;
+	int32 MaxChannel = -1;
+	int32 SecondMaxChannel = -1;
+
+	for (int32 i = 0; i < RVTWeights.Num(); ++i)
+	{
+		if (RVTWeights[i] > MaxWeight)
+		{
+			SecondMaxWeight = MaxWeight;
+			SecondMaxChannel = MaxChannel;
+			MaxWeight = RVTWeights[i];
+			MaxChannel = i;
+		}
+		else if (RVTWeights[i] > SecondMaxWeight)
+		{
+			SecondMaxWeight = RVTWeights[i];
+			SecondMaxChannel = i;
+		}
+	}
+
+	// Map channels to biomes
+	if (MaxChannel < 0 || !RVTChannelBiomes[MaxChannel].IsValid())
+	{
+		return false;
+	}
+
+	OutResult.PrimaryBiome = RVTChannelBiomes[MaxChannel];
+	OutResult.PrimaryWeight = MaxWeight;
+
+	if (SecondMaxChannel >= 0 && SecondMaxWeight > 0.01f && RVTChannelBiomes[SecondMaxChannel].IsValid())
+	{
+		OutResult.SecondaryBiome = RVTChannelBiomes[SecondMaxChannel];
+		OutResult.SecondaryWeight = SecondMaxWeight;
+	}
+	return true;
+}
+
+bool UBiomeSubsystem::SampleRVTAtLocation(const FVector& WorldLocation, TStaticArray<float, NumRVTBiomeChannels>& OutWeights) const
+{
+	if (!RVTBiomeCaptureMaterial)
+	{
+		return false;
+	}
 
+	const FWorldCellKey CellKey = FWorldCellKey::FromWorldLocation(WorldLocation, BiomeTileCellSize);
+	FRVTBiomeTile* Tile = RVTTiles.Find(CellKey);
+	if (!Tile)
+	{
+		// Rules answer this query; the tile is captured on the next Tick
+		RequestedRVTTiles.Add(CellKey);
+		return false;
+	}
+
+	Tile->LastUsedFrame = GFrameCounter;
+
+	const int32 Texel = FSurfaceTileDelta::TileIndexFromWorldLocation(WorldLocation, CellKey, BiomeTileCellSize);
+	const FColor& Mask = Tile->Texels[Texel];
+	OutWeights[0] = Mask.R / 255.0f;
+	OutWeights[1] = Mask.G / 255.0f;
+	OutWeights[2] = Mask.B / 255.0f;
+	OutWeights[3] = Mask.A / 255.0f;
+	return true;
+}
+
+void UBiomeSubsystem::RebuildRVTChannelTable()
+{
+	for (FBiomeId& Biome : RVTChannelBiomes)
+	{
+		Biome = FBiomeId();
+	}
+
+	// Map iteration follows registration order, so the first spec per channel wins as before
 	for (const auto& Pair : BiomeSpecs)
 	{
-		const FBiomeSpec& Spec = Pair.Value;
-		float Score = 0.0f;
-		bool bMatches = true;
+		const int32 Channel = Pair.Value.RVTChannel;
+		if (Channel >= 0 && Channel < NumRVTBiomeChannels && !RVTChannelBiomes[Channel].IsValid())
+		{
+			RVTChannelBiomes[Channel] = Pair.Value.BiomeId;
+		}
+	}
+}
 
-		// Check altitude range
-		if (bUseAltitudeRules)
+void UBiomeSubsystem::Tick(float DeltaTime)
+{
+	if (!bUseRVTBiomeLookup || !RVTBiomeCaptureMaterial)
+	{
+		return;
+	}
+
+	CollectRVTReadbacks();
+	UpdateRVTCaptures();
+}
+
+void UBiomeSubsystem::CollectRVTReadbacks()
+{
+	if (PendingRVTReadbacks.Num() == 0)
+	{
+		return;
+	}
+
+	// Readbacks are locked on the render thread; anything it finishes lands on a later Tick
+	ENQUEUE_RENDER_COMMAND(TPFBiomeRVTCollect)([Pending = PendingRVTReadbacks](FRHICommandListImmediate& RHICmdList)
+	{
+		for (const TSharedPtr<FRVTBiomeReadback, ESPMode::ThreadSafe>& Capture : Pending)
 		{
-			if (Altitude < Spec.AltitudeRange.X || Altitude > Spec.AltitudeRange.Y)
+			if (Capture->bComplete || !Capture->Readback->IsReady())
 			{
-				bMatches = false;
+				continue;
 			}
-			else
+
+			int32 RowPitchInPixels = 0;
+			const FColor* Data = static_cast<const FColor*>(Capture->Readback->Lock(RowPitchInPixels));
+			Capture->Texels.SetNumUninitialized(RVTTileResolution * RVTTileResolution);
+			for (int32 Row = 0; Row < RVTTileResolution; Row++)
 			{
-				// Score based on how centered we are in the range
-				float AltitudeRange = Spec.AltitudeRange.Y - Spec.AltitudeRange.X;
-				if (AltitudeRange > 0.0f)
-				{
-					float AltitudeCenter = (Spec.AltitudeRange.X + Spec.AltitudeRange.Y) * 0.5f;
-					float AltitudeDistance = FMath::Abs(Altitude - AltitudeCenter) / (AltitudeRange * 0.5f);
-					Score += 1.0f - AltitudeDistance; // Higher score for being closer to center
-				}
+				FMemory::Memcpy(&Capture->Texels[Row * RVTTileResolution], Data + Row * RowPitchInPixels,
+					RVTTileResolution * sizeof(FColor));
 			}
+			Capture->Readback->Unlock();
+			Capture->Readback.Reset();
+			Capture->bComplete = true;
+		}
+	});
+
+	const uint64 Frame = GFrameCounter;
+	for (int32 i = PendingRVTReadbacks.Num() - 1; i >= 0; i--)
+	{
+		FRVTBiomeReadback& Capture = *PendingRVTReadbacks[i];
+		if (!Capture.bComplete)
+		{
+			continue;
 		}
 
-		// Check slope range
-		if (bMatches && bUseSlopeRules)
+		if (RVTTiles.Num() > 0 && RVTTiles.Num() >= MaxResidentRVTTiles && !RVTTiles.Contains(Capture.CellKey))
 		{
-			if (SlopeAngle < Spec.SlopeRange.X || SlopeAngle > Spec.SlopeRange.Y)
+			auto Oldest = RVTTiles.CreateIterator();
+			for (auto It = RVTTiles.CreateIterator(); It; ++It)
 			{
-				bMatches = false;
+				if (It->Value.LastUsedFrame < Oldest->Value.LastUsedFrame)
+				{
+					Oldest = It;
+				}
 			}
-			else
+			Oldest.RemoveCurrent();
+		}
+
+		FRVTBiomeTile& Tile = RVTTiles.FindOrAdd(Capture.CellKey);
+		Tile.Texels = MoveTemp(Capture.Texels);
+		Tile.LastUsedFrame = Frame;
+
+		PendingRVTReadbacks.RemoveAtSwap(i, 1, EAllowShrinking::No);
+	}
+}
+
+void UBiomeSubsystem::UpdateRVTCaptures()
+{
+	// Keep the tiles around the view resident and refreshed in the LRU
+	const UWorld* World = GetWorld();
+	const APlayerController* PlayerController = World ? World->GetFirstPlayerController() : nullptr;
+	if (PlayerController && PlayerController->PlayerCameraManager)
+	{
+		const uint64 Frame = GFrameCounter;
+		const FWorldCellKey ViewCell = FWorldCellKey::FromWorldLocation(
+			PlayerController->PlayerCameraManager->GetCameraLocation(), BiomeTileCellSize);
+
+		for (int32 DY = -RVTCaptureRadiusTiles; DY <= RVTCaptureRadiusTiles; DY++)
+		{
+			for (int32 DX = -RVTCaptureRadiusTiles; DX <= RVTCaptureRadiusTiles; DX++)
 			{
-				// Score based on how centered we are in the range
-				float SlopeRange = Spec.SlopeRange.Y - Spec.SlopeRange.X;
-				if (SlopeRange > 0.0f)
+				const FWorldCellKey CellKey(ViewCell.X + DX, ViewCell.Y + DY);
+				if (FRVTBiomeTile* Tile = RVTTiles.Find(CellKey))
+				{
+					Tile->LastUsedFrame = Frame;
+				}
+				else
 				{
-					float SlopeCenter = (Spec.SlopeRange.X + Spec.SlopeRange.Y) * 0.5f;
-					float SlopeDistance = FMath::Abs(SlopeAngle - SlopeCenter) / (SlopeRange * 0.5f);
-					Score += 1.0f - SlopeDistance;
+					RequestedRVTTiles.Add(CellKey);
 				}
 			}
 		}
+	}
+
+	for (auto It = RequestedRVTTiles.CreateIterator(); It && PendingRVTReadbacks.Num() < MaxRVTReadbacksInFlight; ++It)
+	{
+		const FWorldCellKey CellKey = *It;
+		It.RemoveCurrent();
 
-		if (bMatches && Score > BestScore)
+		const bool bInFlight = PendingRVTReadbacks.ContainsByPredicate(
+			[&CellKey](const TSharedPtr<FRVTBiomeReadback, ESPMode::ThreadSafe>& Capture) { return Capture->CellKey == CellKey; });
+		if (!bInFlight && !RVTTiles.Contains(CellKey))
 		{
-			BestScore = Score;
-			BestBiome = Spec.BiomeId;
+			IssueRVTCapture(CellKey);
 		}
 	}
+}
 
-	// Return best match or default
-	if (BestBiome.IsValid())
+void UBiomeSubsystem::IssueRVTCapture(const FWorldCellKey& CellKey)
+{
+	UWorld* World = GetWorld();
+	if (!World)
 	{
-		return BestBiome;
+		return;
 	}
 
-	return DefaultBiomeId;
+	if (!RVTCaptureTarget)
+	{
+		RVTCaptureTarget = UKismetRenderingLibrary::CreateRenderTarget2D(World, RVTTileResolution, RVTTileResolution, RTF_RGBA8);
+	}
+
+	if (!RVTCaptureMaterialInstance || RVTCaptureMaterialInstance->Parent != RVTBiomeCaptureMaterial)
+	{
+		RVTCaptureMaterialInstance = UMaterialInstanceDynamic::Create(RVTBiomeCaptureMaterial, this);
+	}
+
+	if (!RVTCaptureTarget || !RVTCaptureMaterialInstance)
+	{
+		return;
+	}
+
+	// Parameter updates and the draw are queued in order, so several tiles can share one target per frame
+	const double OriginX = CellKey.X * static_cast<double>(BiomeTileCellSize);
+	const double OriginY = CellKey.Y * static_cast<double>(BiomeTileCellSize);
+	RVTCaptureMaterialInstance->SetVectorParameterValue(RVTCaptureOriginParam, FLinearColor(OriginX, OriginY, 0.0f, 0.0f));
+	RVTCaptureMaterialInstance->SetScalarParameterValue(RVTCaptureSizeParam, BiomeTileCellSize);
+	UKismetRenderingLibrary::DrawMaterialToRenderTarget(World, RVTCaptureTarget, RVTCaptureMaterialInstance);
+
+	TSharedPtr<FRVTBiomeReadback, ESPMode::ThreadSafe> Capture = MakeShared<FRVTBiomeReadback, ESPMode::ThreadSafe>();
+	Capture->CellKey = CellKey;
+	Capture->Readback = MakeUnique<FRHIGPUTextureReadback>(TEXT("TPFBiomeRVTReadback"));
+
+	FTextureRenderTargetResource* Resource = RVTCaptureTarget->GameThread_GetRenderTargetResource();
+	ENQUEUE_RENDER_COMMAND(TPFBiomeRVTCopy)([Capture, Resource](FRHICommandListImmediate& RHICmdList)
+	{
+		Capture->Readback->EnqueueCopy(RHICmdList, Resource->GetRenderTargetTexture());
+	});
+
+	PendingRVTReadbacks.Add(MoveTemp(Capture));
 }
 
-bool UBiomeSubsystem::SampleRVTAtLocation(const FVector& WorldLocation, TArray<float>& OutWeights) const
+bool UBiomeSubsystem::SampleLandscape(const FVector& WorldLocation, float& OutHeight, FVector* OutNormal) const
 {
-	// TODO: Implement RVT sampling when RVT system is set up
-	// This would sample the Runtime Virtual Texture at the given location
-	// and return the biome mask weights from the R, G, B, A channels
-	
-	// For now, return false to indicate RVT sampling is not available
-	// The system will fall back to rule-based resolution
+	if (!bUseLandscapeHeightfield)
+	{
+		return false;
+	}
+
+	if (bLandscapeEntriesDirty)
+	{
+		RefreshLandscapeEntries();
+	}
+
+	const FVector2D Point(WorldLocation.X, WorldLocation.Y);
+	for (const FLandscapeEntry& Entry : LandscapeEntries)
+	{
+		const ALandscapeProxy* Proxy = Entry.Proxy.Get();
+		if (!Proxy || !Entry.Bounds.IsInside(Point))
+		{
+			continue;
+		}
+
+		// Unset where the heightfield isn't loaded (streamed out, holes)
+		const TOptional<float> Height = Proxy->GetHeightAtLocation(WorldLocation);
+		if (!Height.IsSet())
+		{
+			continue;
+		}
+
+		OutHeight = Height.GetValue();
+
+		if (OutNormal)
+		{
+			// Central differences one quad apart; an edge sample falls back to the centre (one-sided)
+			const float Step = Entry.QuadSize;
+			auto HeightAt = [Proxy, &WorldLocation, Center = OutHeight](float DX, float DY)
+			{
+				return Proxy->GetHeightAtLocation(WorldLocation + FVector(DX, DY, 0.0f)).Get(Center);
+			};
+
+			const float DHDX = (HeightAt(Step, 0.0f) - HeightAt(-Step, 0.0f)) / (2.0f * Step);
+			const float DHDY = (HeightAt(0.0f, Step) - HeightAt(0.0f, -Step)) / (2.0f * Step);
+			*OutNormal = FVector(-DHDX, -DHDY, 1.0f).GetSafeNormal(UE_SMALL_NUMBER, FVector::UpVector);
+		}
+
+		return true;
+	}
+
 	return false;
 }
 
+void UBiomeSubsystem::RefreshLandscapeEntries() const
+{
+	LandscapeEntries.Reset();
+	bLandscapeEntriesDirty = false;
+
+	UWorld* World = GetWorld();
+	if (!World)
+	{
+		return;
+	}
+
+	for (TActorIterator<ALandscapeProxy> It(World); It; ++It)
+	{
+		ALandscapeProxy* Proxy = *It;
+		const FBox Bounds = Proxy->GetComponentsBoundingBox();
+		if (!Bounds.IsValid)
+		{
+			continue;
+		}
+
+		FLandscapeEntry& Entry = LandscapeEntries.AddDefaulted_GetRef();
+		Entry.Proxy = Proxy;
+		Entry.Bounds = FBox2D(FVector2D(Bounds.Min), FVector2D(Bounds.Max));
+		Entry.QuadSize = FMath::Max(static_cast<float>(Proxy->GetActorScale3D().X), 1.0f);
+	}
+}
+
 ULandscapeComponent* UBiomeSubsystem::FindLandscapeAtLocation(const FVector& WorldLocation) const
 {
 	UWorld* World = GetWorld();
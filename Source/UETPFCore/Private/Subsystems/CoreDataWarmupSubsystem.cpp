@@ -0,0 +1,266 @@
+// Copyright 2026 Threaded Pixel Factory
+// Licensed under the Apache License, Version 2.0 (the "License");
+// SPDX-License-Identifier: Apache-2.0
+
+#include "Subsystems/CoreDataWarmupSubsystem.h"
+#include "Space/Subsystems/StarCatalogSubsystem.h"
+#include "Space/Subsystems/SolarSystemSubsystem.h"
+#include "HAL/PlatformTime.h"
+#include "TPFTimingRecorder.h"
+
+FOnGatherWarmupTasks& UCoreDataWarmupSubsystem::OnGatherWarmupTasks()
+{
+	static FOnGatherWarmupTasks Delegate;
+	return Delegate;
+}
+
+void UCoreDataWarmupSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	TPF_TIMING_SCOPE(TEXT("CoreDataWarmupSubsystem::Initialize"));
+
+	Super::Initialize(Collection);
+
+	if (UStarCatalogSubsystem* StarCatalog = Collection.InitializeDependency<UStarCatalogSubsystem>())
+	{
+		TWeakObjectPtr<UStarCatalogSubsystem> WeakCatalog(StarCatalog);
+		AddWarmupTask(TEXT("StarCatalog"), {}, [WeakCatalog](FSimpleDelegate OnDone)
+		{
+			if (UStarCatalogSubsystem* Catalog = WeakCatalog.Get())
+			{
+				Catalog->EnsureLoadedAsync(FOnStarCatalogReady::CreateLambda([OnDone](bool /*bLoaded*/)
+				{
+					OnDone.ExecuteIfBound();
+				}));
+			}
+			else
+			{
+				OnDone.ExecuteIfBound();
+			}
+		});
+	}
+
+	if (USolarSystemSubsystem* SolarSystem = Collection.InitializeDependency<USolarSystemSubsystem>())
+	{
+		TWeakObjectPtr<USolarSystemSubsystem> WeakSolar(SolarSystem);
+		AddWarmupTask(TEXT("SolarSystem"), {}, [WeakSolar](FSimpleDelegate OnDone)
+		{
+			if (USolarSystemSubsystem* Solar = WeakSolar.Get())
+			{
+				Solar->WarmUpAsync(MoveTemp(OnDone));
+			}
+			else
+			{
+				OnDone.ExecuteIfBound();
+			}
+		});
+	}
+
+	OnGatherWarmupTasks().Broadcast(*this);
+}
+
+void UCoreDataWarmupSubsystem::Deinitialize()
+{
+	// Tasks still in flight complete into weak delegates and are ignored
+	Tasks.Reset();
+	ReadyCallbacks.Reset();
+	bWarmupStarted = false;
+
+	Super::Deinitialize();
+}
+
+bool UCoreDataWarmupSubsystem::AddWarmupTask(FName Name, TArray<FName> Prerequisites, FWarmupTaskStart Start)
+{
+	if (Name.IsNone() || FindTask(Name) != INDEX_NONE)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("CoreDataWarmupSubsystem: Warm-up task '%s' is unnamed or already added"), *Name.ToString());
+		return false;
+	}
+
+	FWarmupTask& Task = Tasks.AddDefaulted_GetRef();
+	Task.Name = Name;
+	Task.Prerequisites = MoveTemp(Prerequisites);
+	Task.Start = MoveTemp(Start);
+
+	if (bWarmupStarted)
+	{
+		StartReadyTasks();
+	}
+	return true;
+}
+
+void UCoreDataWarmupSubsystem::BeginWarmup()
+{
+	if (bWarmupStarted)
+	{
+		return;
+	}
+	bWarmupStarted = true;
+	WarmupStartSeconds = FPlatformTime::Seconds();
+
+	for (const FWarmupTask& Task : Tasks)
+	{
+		for (const FName& Prerequisite : Task.Prerequisites)
+		{
+			if (FindTask(Prerequisite) == INDEX_NONE)
+			{
+				UE_LOG(LogTemp, Warning, TEXT("CoreDataWarmupSubsystem: Task '%s' needs unknown task '%s', not waiting for it"),
+					*Task.Name.ToString(), *Prerequisite.ToString());
+			}
+		}
+	}
+
+	UE_LOG(LogTemp, Log, TEXT("CoreDataWarmupSubsystem: Warming up %d tasks"), Tasks.Num());
+	StartReadyTasks();
+}
+
+float UCoreDataWarmupSubsystem::GetWarmupProgress() const
+{
+	if (Tasks.Num() == 0)
+	{
+		return 1.0f;
+	}
+
+	int32 NumComplete = 0;
+	for (const FWarmupTask& Task : Tasks)
+	{
+		NumComplete += Task.bComplete ? 1 : 0;
+	}
+	return static_cast<float>(NumComplete) / Tasks.Num();
+}
+
+bool UCoreDataWarmupSubsystem::IsWarmupTaskComplete(FName Name) const
+{
+	const int32 TaskIndex = FindTask(Name);
+	return TaskIndex != INDEX_NONE && Tasks[TaskIndex].bComplete;
+}
+
+void UCoreDataWarmupSubsystem::CallWhenCoreDataReady(FSimpleDelegate Callback)
+{
+	if (bReady)
+	{
+		Callback.ExecuteIfBound();
+	}
+	else if (Callback.IsBound())
+	{
+		ReadyCallbacks.Add(MoveTemp(Callback));
+	}
+}
+
+void UCoreDataWarmupSubsystem::StartReadyTasks()
+{
+	if (bStartingTasks)
+	{
+		return;
+	}
+
+	{
+		TGuardValue<bool> StartingGuard(bStartingTasks, true);
+
+		// Repeat while tasks finish synchronously inside their start and unblock others
+		bool bStartedAny = true;
+		while (bStartedAny)
+		{
+			bStartedAny = false;
+			for (int32 i = 0; i < Tasks.Num(); ++i)
+			{
+				if (!Tasks[i].bStarted && ArePrerequisitesComplete(Tasks[i]))
+				{
+					StartTask(i);
+					bStartedAny = true;
+				}
+			}
+
+			// Nothing in flight but tasks still waiting: their prerequisites form a cycle
+			if (!bStartedAny)
+			{
+				const bool bInFlight = Tasks.ContainsByPredicate([](const FWarmupTask& Task) { return Task.bStarted && !Task.bComplete; });
+				const int32 Blocked = Tasks.IndexOfByPredicate([](const FWarmupTask& Task) { return !Task.bStarted; });
+				if (!bInFlight && Blocked != INDEX_NONE)
+				{
+					UE_LOG(LogTemp, Warning, TEXT("CoreDataWarmupSubsystem: Task '%s' is in a prerequisite cycle, starting it anyway"),
+						*Tasks[Blocked].Name.ToString());
+					StartTask(Blocked);
+					bStartedAny = true;
+				}
+			}
+		}
+	}
+
+	if (bReady || Tasks.ContainsByPredicate([](const FWarmupTask& Task) { return !Task.bComplete; }))
+	{
+		return;
+	}
+
+	bReady = true;
+	UE_LOG(LogTemp, Log, TEXT("CoreDataWarmupSubsystem: Core data ready (%d tasks, %.2f ms)"),
+		Tasks.Num(), (FPlatformTime::Seconds() - WarmupStartSeconds) * 1000.0);
+
+	TArray<FSimpleDelegate> Callbacks = MoveTemp(ReadyCallbacks);
+	for (FSimpleDelegate& Callback : Callbacks)
+	{
+		Callback.ExecuteIfBound();
+	}
+	OnCoreDataReady.Broadcast();
+}
+
+void UCoreDataWarmupSubsystem::StartTask(int32 TaskIndex)
+{
+	FWarmupTask& Task = Tasks[TaskIndex];
+	Task.bStarted = true;
+	Task.StartSeconds = FPlatformTime::Seconds();
+
+	// Released before running: the task may add tasks (reallocating Tasks) or finish synchronously
+	FWarmupTaskStart Start = MoveTemp(Task.Start);
+	FSimpleDelegate OnDone = FSimpleDelegate::CreateWeakLambda(this, [this, Name = Task.Name]()
+	{
+		CompleteTask(Name);
+	});
+
+	if (Start)
+	{
+		Start(MoveTemp(OnDone));
+	}
+	else
+	{
+		OnDone.Execute();
+	}
+}
+
+void UCoreDataWarmupSubsystem::CompleteTask(FName Name)
+{
+	check(IsInGameThread());
+
+	const int32 TaskIndex = FindTask(Name);
+	if (TaskIndex == INDEX_NONE || Tasks[TaskIndex].bComplete)
+	{
+		return;
+	}
+
+	FWarmupTask& Task = Tasks[TaskIndex];
+	Task.bComplete = true;
+
+	const double Now = FPlatformTime::Seconds();
+	FTPFTimingRecorder::Get().RecordPhase(TEXT("Warmup.") + Task.Name.ToString(), Task.StartSeconds, Now);
+	UE_LOG(LogTemp, Log, TEXT("CoreDataWarmupSubsystem: '%s' done in %.2f ms"),
+		*Task.Name.ToString(), (Now - Task.StartSeconds) * 1000.0);
+
+	StartReadyTasks();
+}
+
+bool UCoreDataWarmupSubsystem::ArePrerequisitesComplete(const FWarmupTask& Task) const
+{
+	for (const FName& Prerequisite : Task.Prerequisites)
+	{
+		const int32 TaskIndex = FindTask(Prerequisite);
+		if (TaskIndex != INDEX_NONE && !Tasks[TaskIndex].bComplete)
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+int32 UCoreDataWarmupSubsystem::FindTask(FName Name) const
+{
+	return Tasks.IndexOfByPredicate([Name](const FWarmupTask& Task) { return Task.Name == Name; });
+}
@@ -4,8 +4,30 @@
 
 #include "Subsystems/EnvironmentSubsystem.h"
 #include "GlobalAtmosphereField.h"
+#include "Space/Subsystems/WorldFrameSubsystem.h"
+#include "TPFCoreStats.h"
+#include "TPFTimingRecorder.h"
 #include "Engine/World.h"
 #include "Engine/CollisionProfile.h"
+#include "Async/ParallelFor.h"
+
+namespace
+{
+	/** Points per ParallelFor task in batch environment queries */
+	constexpr int32 EnvironmentQueryBatchSize = 256;
+
+	/** Oriented box test against cached placement (Transform has no scale) */
+	bool OrientedBoxContains(const FBox& Bounds, const FTransform& Transform, const FVector& Extent, const FVector& WorldLocation)
+	{
+		if (!Bounds.IsInsideOrOn(WorldLocation))
+		{
+			return false;
+		}
+
+		const FVector Local = Transform.InverseTransformPositionNoScale(WorldLocation);
+		return FMath::Abs(Local.X) <= Extent.X && FMath::Abs(Local.Y) <= Extent.Y && FMath::Abs(Local.Z) <= Extent.Z;
+	}
+}
 
 // Static fallback medium spec - Earth sea-level atmosphere (never fails)
 FRuntimeMediumSpec UEnvironmentSubsystem::FallbackMediumSpec = []()
@@ -39,6 +61,46 @@ UEnvironmentVolumeComponent::UEnvironmentVolumeComponent()
 	bVisibleInReflectionCaptures = false;
 }
 
+void UEnvironmentVolumeComponent::OnRegister()
+{
+	Super::OnRegister();
+
+	if (UWorld* World = GetWorld())
+	{
+		if (UEnvironmentSubsystem* Environment = World->GetSubsystem<UEnvironmentSubsystem>())
+		{
+			Environment->RegisterVolume(this);
+		}
+	}
+}
+
+void UEnvironmentVolumeComponent::OnUnregister()
+{
+	if (UWorld* World = GetWorld())
+	{
+		if (UEnvironmentSubsystem* Environment = World->GetSubsystem<UEnvironmentSubsystem>())
+		{
+			Environment->UnregisterVolume(this);
+		}
+	}
+
+	Super::OnUnregister();
+}
+
+void UEnvironmentVolumeComponent::UpdateBounds()
+{
+	Super::UpdateBounds();
+
+	// Covers moves (UpdateComponentToWorld) and SetBoxExtent
+	if (IsRegistered())
+	{
+		if (UEnvironmentSubsystem* Environment = GetWorld() ? GetWorld()->GetSubsystem<UEnvironmentSubsystem>() : nullptr)
+		{
+			Environment->UpdateVolume(this);
+		}
+	}
+}
+
 //=============================================================================
 // UEnvironmentSubsystem
 //=============================================================================
@@ -50,7 +112,14 @@ UEnvironmentSubsystem::UEnvironmentSubsystem()
 
 void UEnvironmentSubsystem::Initialize(FSubsystemCollectionBase& Collection)
 {
+	TPF_TIMING_SCOPE(TEXT("EnvironmentSubsystem::Initialize"));
+
 	Super::Initialize(Collection);
+
+	if (UWorldFrameSubsystem* WorldFrame = Collection.InitializeDependency<UWorldFrameSubsystem>())
+	{
+		OriginRebasedHandle = WorldFrame->OnWorldOriginRebased.AddUObject(this, &UEnvironmentSubsystem::HandleWorldOriginRebased);
+	}
 	
 	UE_LOG(LogTemp, Log, TEXT("EnvironmentSubsystem initialized for world: %s"), 
 		*GetWorld()->GetName());
@@ -58,10 +127,21 @@ void UEnvironmentSubsystem::Initialize(FSubsystemCollectionBase& Collection)
 
 void UEnvironmentSubsystem::Deinitialize()
 {
+	if (UWorldFrameSubsystem* WorldFrame = GetWorld()->GetSubsystem<UWorldFrameSubsystem>())
+	{
+		WorldFrame->OnWorldOriginRebased.Remove(OriginRebasedHandle);
+	}
+
 	MediumSpecMap.Empty();
-	RuntimeMediumSpecs.Empty();
+	RuntimeMediumSpecs.Reset();
+	RuntimeAuthoredMediumIds.Empty();
 	DefaultMediumSpec = nullptr;
 	RegisteredVolumes.Empty();
+	VolumeEntries.Empty();
+	VolumeEntryIndices.Empty();
+	VolumeGrid.Empty();
+	OversizedVolumes.Empty();
+	QuerySnapshot.Reset();
 	
 	Super::Deinitialize();
 }
@@ -81,22 +161,19 @@ bool UEnvironmentSubsystem::ShouldCreateSubsystem(UObject* Outer) const
 
 FEnvironmentContext UEnvironmentSubsystem::GetEnvironmentAtLocation(const FVector& WorldLocation) const
 {
-	// Find the volume at this location (if any)
-	UEnvironmentVolumeComponent* Volume = FindVolumeAtLocation(WorldLocation);
-	
+	SCOPE_CYCLE_COUNTER(STAT_TPF_EnvironmentQuery);
+	INC_DWORD_STAT(STAT_TPF_EnvironmentQueries);
+
 	// Priority order:
 	// 1. Volume with MediumSpec (local override)
 	// 2. GlobalAtmosphereField (altitude-based default)
 	// 3. DefaultMediumSpec (fallback)
 	
-	// If inside a volume, use volume's spec
-	if (Volume && Volume->MediumSpecId.IsValid())
+	// If inside a volume, use its pre-resolved context
+	const FVolumeIndexEntry* Entry = FindVolumeEntryAtLocation(WorldLocation);
+	if (Entry && Entry->Context.bIsValid)
 	{
-		const UMediumSpec* Spec = GetMediumSpec(Volume->MediumSpecId);
-		if (Spec)
-		{
-			return BuildEnvironmentContext(Spec, Volume);
-		}
+		return Entry->Context;
 	}
 	
 	// Not in a volume - use GlobalAtmosphereField if available
@@ -116,6 +193,114 @@ FEnvironmentContext UEnvironmentSubsystem::GetEnvironmentAtLocation(const FVecto
 	return FEnvironmentContext();
 }
 
+void UEnvironmentSubsystem::GetEnvironmentAtLocations(TConstArrayView<FVector> WorldLocations,
+	TArrayView<FEnvironmentContext> OutContexts) const
+{
+	check(WorldLocations.Num() == OutContexts.Num());
+
+	const int32 NumLocations = WorldLocations.Num();
+	if (NumLocations == 0)
+	{
+		return;
+	}
+
+	SCOPE_CYCLE_COUNTER(STAT_TPF_EnvironmentBatchQuery);
+	INC_DWORD_STAT_BY(STAT_TPF_EnvironmentQueries, NumLocations);
+
+	// Pass 1: volume overrides (same priority order as GetEnvironmentAtLocation).
+	// Points outside every volume are left invalid for the fallback pass.
+	const bool bHasVolumes = VolumeEntries.Num() > 0;
+	if (bHasVolumes)
+	{
+		const int32 NumBatches = FMath::DivideAndRoundUp(NumLocations, EnvironmentQueryBatchSize);
+		ParallelFor(NumBatches, [this, WorldLocations, OutContexts](int32 BatchIndex)
+		{
+			const int32 Start = BatchIndex * EnvironmentQueryBatchSize;
+			const int32 End = FMath::Min(Start + EnvironmentQueryBatchSize, WorldLocations.Num());
+
+			for (int32 i = Start; i < End; i++)
+			{
+				const FVolumeIndexEntry* Entry = FindVolumeEntryAtLocation(WorldLocations[i]);
+				OutContexts[i] = Entry ? Entry->Context : FEnvironmentContext();
+			}
+		}, NumBatches <= 1 ? EParallelForFlags::ForceSingleThread : EParallelForFlags::None);
+	}
+
+	// Pass 2: everything not in a volume comes from the atmosphere field, in one batch
+	if (GlobalAtmosphereField)
+	{
+		if (!bHasVolumes)
+		{
+			GlobalAtmosphereField->CreateEnvironmentContextsAtLocations(WorldLocations, OutContexts);
+			return;
+		}
+
+		TArray<int32> OutsideIndices;
+		TArray<FVector> OutsideLocations;
+		for (int32 i = 0; i < NumLocations; i++)
+		{
+			if (!OutContexts[i].bIsValid)
+			{
+				OutsideIndices.Add(i);
+				OutsideLocations.Add(WorldLocations[i]);
+			}
+		}
+
+		TArray<FEnvironmentContext> OutsideContexts;
+		OutsideContexts.SetNum(OutsideLocations.Num());
+		GlobalAtmosphereField->CreateEnvironmentContextsAtLocations(OutsideLocations, OutsideContexts);
+
+		for (int32 j = 0; j < OutsideIndices.Num(); j++)
+		{
+			OutContexts[OutsideIndices[j]] = OutsideContexts[j];
+		}
+		return;
+	}
+
+	// Final fallback to default medium spec - identical for every point, built once
+	const FEnvironmentContext Fallback = DefaultMediumSpec ? BuildEnvironmentContext(DefaultMediumSpec, nullptr) : FEnvironmentContext();
+	for (int32 i = 0; i < NumLocations; i++)
+	{
+		if (!bHasVolumes || !OutContexts[i].bIsValid)
+		{
+			OutContexts[i] = Fallback;
+		}
+	}
+}
+
+TSharedRef<const FEnvironmentQuerySnapshot, ESPMode::ThreadSafe> UEnvironmentSubsystem::GetQuerySnapshot() const
+{
+	check(IsInGameThread());
+
+	// Config edits (MarkModified) and reassignment do not notify us; compare against what was baked
+	const UAtmosphereConfig* Config = GlobalAtmosphereField ? GlobalAtmosphereField->AtmosphereConfig.Get() : nullptr;
+	const uint32 Revision = Config ? Config->GetRevision() : 0;
+	if (!QuerySnapshot.IsValid() || QuerySnapshot->AtmosphereConfig != TObjectKey<UAtmosphereConfig>(Config)
+		|| QuerySnapshot->AtmosphereRevision != Revision)
+	{
+		QuerySnapshot = BuildQuerySnapshot();
+	}
+	return QuerySnapshot.ToSharedRef();
+}
+
+void UEnvironmentSubsystem::InvalidateQuerySnapshot()
+{
+	// Any spec or override may have changed under the cached contexts
+	for (FVolumeIndexEntry& Entry : VolumeEntries)
+	{
+		ResolveVolumeContext(Entry);
+	}
+
+	// Holders of the old snapshot keep it alive; the next request republishes
+	QuerySnapshot.Reset();
+}
+
+void UEnvironmentSubsystem::HandleWorldOriginRebased(const FIntVector& ShiftCm)
+{
+	// Placement only - contexts do not depend on position
+	QuerySnapshot.Reset();
+}
+
 FMediumSpecId UEnvironmentSubsystem::GetMediumAtLocation(const FVector& WorldLocation) const
 {
 	UEnvironmentVolumeComponent* Volume = FindVolumeAtLocation(WorldLocation);
@@ -154,8 +339,35 @@ float UEnvironmentSubsystem::GetSoundAttenuationAtLocation(const FVector& WorldL
 FVector UEnvironmentSubsystem::CalculateDragForce(const FVector& WorldLocation, const FVector& Velocity, 
 	float DragArea, float DragCoefficient) const
 {
-	FEnvironmentContext Context = GetEnvironmentAtLocation(WorldLocation);
-	
+	return CalculateDragForceInContext(GetEnvironmentAtLocation(WorldLocation), Velocity, DragArea, DragCoefficient);
+}
+
+FVector UEnvironmentSubsystem::CalculateBuoyancyForce(const FVector& WorldLocation, float DisplacedVolume) const
+{
+	return CalculateBuoyancyForceInContext(GetEnvironmentAtLocation(WorldLocation), DisplacedVolume);
+}
+
+FEnvironmentalForces UEnvironmentSubsystem::CalculateEnvironmentalForces(const FVector& WorldLocation, const FVector& Velocity,
+	float DragArea, float DragCoefficient, float DisplacedVolume) const
+{
+	return CalculateEnvironmentalForcesInContext(GetEnvironmentAtLocation(WorldLocation), Velocity, DragArea, DragCoefficient, DisplacedVolume);
+}
+
+FEnvironmentalForces UEnvironmentSubsystem::CalculateEnvironmentalForcesInContext(const FEnvironmentContext& Context,
+	const FVector& Velocity, float DragArea, float DragCoefficient, float DisplacedVolume)
+{
+	FEnvironmentalForces Forces;
+	Forces.Drag = CalculateDragForceInContext(Context, Velocity, DragArea, DragCoefficient);
+	if (DisplacedVolume > 0.0f)
+	{
+		Forces.Buoyancy = CalculateBuoyancyForceInContext(Context, DisplacedVolume);
+	}
+	return Forces;
+}
+
+FVector UEnvironmentSubsystem::CalculateDragForceInContext(const FEnvironmentContext& Context, const FVector& Velocity, 
+	float DragArea, float DragCoefficient)
+{
 	if (!Context.bIsValid || Context.Density < VacuumDensityThreshold)
 	{
 		// No drag in vacuum
@@ -191,10 +403,8 @@ FVector UEnvironmentSubsystem::CalculateDragForce(const FVector& WorldLocation,
 	return DragDirection * DragMagnitudeUE;
 }
 
-FVector UEnvironmentSubsystem::CalculateBuoyancyForce(const FVector& WorldLocation, float DisplacedVolume) const
+FVector UEnvironmentSubsystem::CalculateBuoyancyForceInContext(const FEnvironmentContext& Context, float DisplacedVolume)
 {
-	FEnvironmentContext Context = GetEnvironmentAtLocation(WorldLocation);
-	
 	if (!Context.bIsValid || Context.Density < VacuumDensityThreshold)
 	{
 		// No buoyancy in vacuum
@@ -233,11 +443,27 @@ void UEnvironmentSubsystem::RegisterMediumSpec(const FMediumSpecId& SpecId, UMed
 	if (SpecId.IsValid() && Spec)
 	{
 		MediumSpecMap.Add(SpecId.Id, Spec);
+		InternMediumSpecAsset(SpecId.Id, Spec);
+		InvalidateQuerySnapshot();
 		
 		UE_LOG(LogTemp, Verbose, TEXT("Registered MediumSpec: %s"), *SpecId.Id.ToString());
 	}
 }
 
+void UEnvironmentSubsystem::InternMediumSpecAsset(const FName& Id, const UMediumSpec* Spec)
+{
+	if (!Spec || RuntimeAuthoredMediumIds.Contains(Id))
+	{
+		return;
+	}
+
+	FRuntimeMediumSpec Converted;
+	if (Spec->ToStruct(Converted))
+	{
+		RuntimeMediumSpecs.Register(Id, Converted);
+	}
+}
+
 UMediumSpec* UEnvironmentSubsystem::GetMediumSpec(const FMediumSpecId& SpecId) const
 {
 	if (!SpecId.IsValid())
@@ -257,6 +483,7 @@ UMediumSpec* UEnvironmentSubsystem::GetMediumSpec(const FMediumSpecId& SpecId) c
 void UEnvironmentSubsystem::SetDefaultMediumSpec(UMediumSpec* Spec)
 {
 	DefaultMediumSpec = Spec;
+	InvalidateQuerySnapshot();
 	
 	if (Spec)
 	{
@@ -267,6 +494,9 @@ void UEnvironmentSubsystem::SetDefaultMediumSpec(UMediumSpec* Spec)
 void UEnvironmentSubsystem::SetGlobalAtmosphereField(UGlobalAtmosphereField* AtmosphereField)
 {
 	GlobalAtmosphereField = AtmosphereField;
+
+	// Volume contexts do not read the atmosphere
+	QuerySnapshot.Reset();
 	
 	if (AtmosphereField)
 	{
@@ -280,9 +510,15 @@ void UEnvironmentSubsystem::SetGlobalAtmosphereField(UGlobalAtmosphereField* Atm
 
 void UEnvironmentSubsystem::RegisterVolume(UEnvironmentVolumeComponent* Volume)
 {
-	if (Volume && !RegisteredVolumes.Contains(Volume))
+	if (Volume && !VolumeEntryIndices.Contains(Volume))
 	{
 		RegisteredVolumes.Add(Volume);
+
+		FVolumeIndexEntry Entry;
+		Entry.Volume = Volume;
+		const int32 EntryIndex = VolumeEntries.Add(Entry);
+		VolumeEntryIndices.Add(Volume, EntryIndex);
+		UpdateVolume(Volume);
 		
 		UE_LOG(LogTemp, Verbose, TEXT("Registered EnvironmentVolume with MediumSpec: %s"), 
 			*Volume->MediumSpecId.Id.ToString());
@@ -292,6 +528,108 @@ void UEnvironmentSubsystem::RegisterVolume(UEnvironmentVolumeComponent* Volume)
 void UEnvironmentSubsystem::UnregisterVolume(UEnvironmentVolumeComponent* Volume)
 {
 	RegisteredVolumes.Remove(Volume);
+
+	int32 EntryIndex = INDEX_NONE;
+	if (VolumeEntryIndices.RemoveAndCopyValue(Volume, EntryIndex))
+	{
+		RemoveVolumeFromGrid(EntryIndex);
+		VolumeEntries.RemoveAt(EntryIndex);
+		QuerySnapshot.Reset();
+	}
+}
+
+void UEnvironmentSubsystem::UpdateVolume(UEnvironmentVolumeComponent* Volume)
+{
+	const int32* EntryIndex = VolumeEntryIndices.Find(Volume);
+	if (!EntryIndex)
+	{
+		return;
+	}
+
+	RemoveVolumeFromGrid(*EntryIndex);
+
+	FVolumeIndexEntry& Entry = VolumeEntries[*EntryIndex];
+	Entry.Transform = Volume->GetComponentTransform();
+	Entry.Extent = Volume->GetScaledBoxExtent();
+	Entry.Transform.RemoveScaling();
+	Entry.Bounds = Volume->Bounds.GetBox();
+	ResolveVolumeContext(Entry);
+
+	AddVolumeToGrid(*EntryIndex);
+	QuerySnapshot.Reset();
+}
+
+void UEnvironmentSubsystem::ResolveVolumeContext(FVolumeIndexEntry& Entry) const
+{
+	Entry.Context = FEnvironmentContext();
+	if (IsValid(Entry.Volume) && Entry.Volume->MediumSpecId.IsValid())
+	{
+		if (const UMediumSpec* Spec = GetMediumSpec(Entry.Volume->MediumSpecId))
+		{
+			Entry.Context = BuildEnvironmentContext(Spec, Entry.Volume);
+		}
+	}
+}
+
+bool UEnvironmentSubsystem::FVolumeIndexEntry::Contains(const FVector& WorldLocation) const
+{
+	return OrientedBoxContains(Bounds, Transform, Extent, WorldLocation);
+}
+
+bool UEnvironmentSubsystem::GetVolumeGridRange(const FBox& Bounds, FIntPoint& OutMin, FIntPoint& OutMax)
+{
+	const FWorldCellKey MinCell = FWorldCellKey::FromWorldLocation(Bounds.Min, VolumeGridCellSize);
+	const FWorldCellKey MaxCell = FWorldCellKey::FromWorldLocation(Bounds.Max, VolumeGridCellSize);
+	OutMin = FIntPoint(MinCell.X, MinCell.Y);
+	OutMax = FIntPoint(MaxCell.X, MaxCell.Y);
+
+	const int64 CellCount = int64(OutMax.X - OutMin.X + 1) * int64(OutMax.Y - OutMin.Y + 1);
+	return CellCount <= MaxVolumeGridCells;
+}
+
+void UEnvironmentSubsystem::AddVolumeToGrid(int32 EntryIndex)
+{
+	FIntPoint Min, Max;
+	if (!GetVolumeGridRange(VolumeEntries[EntryIndex].Bounds, Min, Max))
+	{
+		OversizedVolumes.Add(EntryIndex);
+		return;
+	}
+
+	for (int32 Y = Min.Y; Y <= Max.Y; Y++)
+	{
+		for (int32 X = Min.X; X <= Max.X; X++)
+		{
+			VolumeGrid.FindOrAdd(FWorldCellKey(X, Y)).Add(EntryIndex);
+		}
+	}
+}
+
+void UEnvironmentSubsystem::RemoveVolumeFromGrid(int32 EntryIndex)
+{
+	if (OversizedVolumes.Remove(EntryIndex) > 0)
+	{
+		return;
+	}
+
+	// Bounds still hold the placement the entry was inserted with
+	FIntPoint Min, Max;
+	GetVolumeGridRange(VolumeEntries[EntryIndex].Bounds, Min, Max);
+	for (int32 Y = Min.Y; Y <= Max.Y; Y++)
+	{
+		for (int32 X = Min.X; X <= Max.X; X++)
+		{
+			const FWorldCellKey CellKey(X, Y);
+			if (TArray<int32>* Cell = VolumeGrid.Find(CellKey))
+			{
+				Cell->RemoveSwap(EntryIndex);
+				if (Cell->Num() == 0)
+				{
+					VolumeGrid.Remove(CellKey);
+				}
+			}
+		}
+	}
 }
 
 //=============================================================================
@@ -300,32 +638,112 @@ void UEnvironmentSubsystem::UnregisterVolume(UEnvironmentVolumeComponent* Volume
 
 UEnvironmentVolumeComponent* UEnvironmentSubsystem::FindVolumeAtLocation(const FVector& WorldLocation) const
 {
-	UEnvironmentVolumeComponent* BestVolume = nullptr;
+	const FVolumeIndexEntry* Entry = FindVolumeEntryAtLocation(WorldLocation);
+	return Entry ? Entry->Volume : nullptr;
+}
+
+const UEnvironmentSubsystem::FVolumeIndexEntry* UEnvironmentSubsystem::FindVolumeEntryAtLocation(const FVector& WorldLocation) const
+{
+	const FVolumeIndexEntry* BestEntry = nullptr;
 	int32 BestPriority = INT_MIN;
 
-	for (UEnvironmentVolumeComponent* Volume : RegisteredVolumes)
+	auto TestEntry = [this, &WorldLocation, &BestEntry, &BestPriority](int32 EntryIndex)
 	{
-		if (!Volume || !IsValid(Volume))
+		const FVolumeIndexEntry& Entry = VolumeEntries[EntryIndex];
+		if (!IsValid(Entry.Volume) || Entry.Volume->Priority <= BestPriority)
+		{
+			return;
+		}
+
+		if (Entry.Contains(WorldLocation))
+		{
+			BestPriority = Entry.Volume->Priority;
+			BestEntry = &Entry;
+		}
+	};
+
+	// Only the volumes overlapping this location's grid cell, plus the oversized ones
+	const FWorldCellKey CellKey = FWorldCellKey::FromWorldLocation(WorldLocation, VolumeGridCellSize);
+	const TArray<int32>* Cell = VolumeGrid.Find(CellKey);
+	if (Cell)
+	{
+		for (int32 EntryIndex : *Cell)
+		{
+			TestEntry(EntryIndex);
+		}
+	}
+
+	for (int32 EntryIndex : OversizedVolumes)
+	{
+		TestEntry(EntryIndex);
+	}
+
+	INC_DWORD_STAT_BY(STAT_TPF_VolumeTests, (Cell ? Cell->Num() : 0) + OversizedVolumes.Num());
+
+	return BestEntry;
+}
+
+TSharedRef<FEnvironmentQuerySnapshot, ESPMode::ThreadSafe> UEnvironmentSubsystem::BuildQuerySnapshot() const
+{
+	SCOPE_CYCLE_COUNTER(STAT_TPF_EnvironmentSnapshotBuild);
+
+	TSharedRef<FEnvironmentQuerySnapshot, ESPMode::ThreadSafe> Snapshot = MakeShared<FEnvironmentQuerySnapshot, ESPMode::ThreadSafe>();
+	Snapshot->VolumeGridCellSize = VolumeGridCellSize;
+
+	// Pack live entries densely with their resolved contexts, so workers never touch UObjects
+	TArray<int32> DenseIndices;
+	DenseIndices.Init(INDEX_NONE, VolumeEntries.GetMaxIndex());
+	for (auto It = VolumeEntries.CreateConstIterator(); It; ++It)
+	{
+		const FVolumeIndexEntry& Entry = *It;
+		if (!IsValid(Entry.Volume))
 		{
 			continue;
 		}
 
-		// Check if location is inside this volume
-		FVector ClosestPoint;
-		float DistSq = Volume->GetSquaredDistanceToCollision(WorldLocation, DistSq, ClosestPoint);
-		
-		// If distance is 0 or very small, we're inside
-		if (DistSq < 1.0f)
+		FEnvironmentQuerySnapshot::FVolume& Volume = Snapshot->Volumes.AddDefaulted_GetRef();
+		Volume.Transform = Entry.Transform;
+		Volume.Extent = Entry.Extent;
+		Volume.Bounds = Entry.Bounds;
+		Volume.Priority = Entry.Volume->Priority;
+		Volume.Context = Entry.Context;
+		DenseIndices[It.GetIndex()] = Snapshot->Volumes.Num() - 1;
+	}
+
+	auto Remap = [&DenseIndices](const TArray<int32>& EntryIndices, TArray<int32>& OutIndices)
+	{
+		for (int32 EntryIndex : EntryIndices)
 		{
-			if (Volume->Priority > BestPriority)
+			if (DenseIndices[EntryIndex] != INDEX_NONE)
 			{
-				BestPriority = Volume->Priority;
-				BestVolume = Volume;
+				OutIndices.Add(DenseIndices[EntryIndex]);
 			}
 		}
+	};
+
+	Snapshot->VolumeGrid.Reserve(VolumeGrid.Num());
+	for (const TPair<FWorldCellKey, TArray<int32>>& Cell : VolumeGrid)
+	{
+		Remap(Cell.Value, Snapshot->VolumeGrid.Add(Cell.Key));
 	}
+	Remap(OversizedVolumes, Snapshot->OversizedVolumes);
 
-	return BestVolume;
+	if (GlobalAtmosphereField)
+	{
+		Snapshot->bHasAtmosphere = true;
+		Snapshot->Atmosphere = GlobalAtmosphereField->GetAtmosphereModel();
+
+		const UAtmosphereConfig* Config = GlobalAtmosphereField->AtmosphereConfig.Get();
+		Snapshot->AtmosphereConfig = Config;
+		Snapshot->AtmosphereRevision = Config ? Config->GetRevision() : 0;
+	}
+
+	if (DefaultMediumSpec)
+	{
+		Snapshot->DefaultContext = BuildEnvironmentContext(DefaultMediumSpec, nullptr);
+	}
+
+	return Snapshot;
 }
 
 FEnvironmentContext UEnvironmentSubsystem::BuildEnvironmentContext(const UMediumSpec* Spec, 
@@ -382,53 +800,141 @@ FEnvironmentContext UEnvironmentSubsystem::BuildEnvironmentContext(const UMedium
 	return Context;
 }
 
+//=============================================================================
+// FEnvironmentQuerySnapshot
+//=============================================================================
+
+FEnvironmentContext FEnvironmentQuerySnapshot::GetEnvironmentAtLocation(const FVector& WorldLocation, double TimeSeconds) const
+{
+	// Same order as the live query: volume medium, atmosphere field, default medium
+	const FVolume* Volume = FindVolumeAtLocation(WorldLocation);
+	if (Volume && Volume->Context.bIsValid)
+	{
+		return Volume->Context;
+	}
+
+	if (bHasAtmosphere)
+	{
+		FAtmosphereState AtmoState;
+		Atmosphere.Evaluate(WorldLocation, AtmoState, TimeSeconds);
+		return FAtmosphereModel::MakeEnvironmentContext(AtmoState);
+	}
+
+	return DefaultContext;
+}
+
+const FEnvironmentQuerySnapshot::FVolume* FEnvironmentQuerySnapshot::FindVolumeAtLocation(const FVector& WorldLocation) const
+{
+	const FVolume* BestVolume = nullptr;
+	int32 BestPriority = INT_MIN;
+
+	auto TestVolume = [this, &WorldLocation, &BestVolume, &BestPriority](int32 VolumeIndex)
+	{
+		const FVolume& Volume = Volumes[VolumeIndex];
+		if (Volume.Priority > BestPriority && OrientedBoxContains(Volume.Bounds, Volume.Transform, Volume.Extent, WorldLocation))
+		{
+			BestPriority = Volume.Priority;
+			BestVolume = &Volume;
+		}
+	};
+
+	const FWorldCellKey CellKey = FWorldCellKey::FromWorldLocation(WorldLocation, VolumeGridCellSize);
+	if (const TArray<int32>* Cell = VolumeGrid.Find(CellKey))
+	{
+		for (int32 VolumeIndex : *Cell)
+		{
+			TestVolume(VolumeIndex);
+		}
+	}
+
+	for (int32 VolumeIndex : OversizedVolumes)
+	{
+		TestVolume(VolumeIndex);
+	}
+
+	return BestVolume;
+}
+
+void FEnvironmentQuerySnapshot::GetEnvironmentAtLocations(TConstArrayView<FVector> WorldLocations,
+	TArrayView<FEnvironmentContext> OutContexts, double TimeSeconds) const
+{
+	check(WorldLocations.Num() == OutContexts.Num());
+
+	for (int32 i = 0; i < WorldLocations.Num(); i++)
+	{
+		OutContexts[i] = GetEnvironmentAtLocation(WorldLocations[i], TimeSeconds);
+	}
+}
+
 //=============================================================================
 // RUNTIME SPEC REGISTRATION (SpecPack / JSON)
 //=============================================================================
 
-void UEnvironmentSubsystem::RegisterRuntimeMediumSpec(const FMediumSpecId& Id, const FRuntimeMediumSpec & Spec)
+FSpecHandle UEnvironmentSubsystem::RegisterRuntimeMediumSpec(const FMediumSpecId& Id, const FRuntimeMediumSpec & Spec)
 {
-	RuntimeMediumSpecs.Add(Id.Id, Spec);
+	RuntimeAuthoredMediumIds.Add(Id.Id);
+	const FSpecHandle Handle = RuntimeMediumSpecs.Register(Id.Id, Spec);
 	
-	UE_LOG(LogTemp, Verbose, TEXT("Registered runtime MediumSpec: %s"), *Id.Id.ToString());
+	UE_LOG(LogTemp, Verbose, TEXT("Registered runtime MediumSpec: %s (handle %d)"), *Id.Id.ToString(), Handle.Index);
+	return Handle;
 }
 
 bool UEnvironmentSubsystem::ResolveMediumSpec(const FMediumSpecId& Id, FRuntimeMediumSpec & OutSpec) const
 {
-	// Resolution order: Runtime registry → DataAsset fallback → Default
+	bool bFound = false;
+	OutSpec = ResolveMediumSpecRef(Id, &bFound);
+	return bFound;
+}
 
-	// 1. Check runtime registry first (SpecPack / JSON loaded)
-	if (const FRuntimeMediumSpec * RuntimeSpec = RuntimeMediumSpecs.Find(Id.Id))
+const FRuntimeMediumSpec& UEnvironmentSubsystem::ResolveMediumSpecRef(const FMediumSpecId& Id, bool* bOutFound) const
+{
+	// Resolution order: Runtime registry → DataAsset → Default
+	// Both sources are interned in one registry (runtime entries shadow assets),
+	// so either costs a single lookup
+	if (const FRuntimeMediumSpec* RegisteredSpec = RuntimeMediumSpecs.Find(Id.Id))
 	{
-		OutSpec = *RuntimeSpec;
-		return true;
+		if (bOutFound)
+		{
+			*bOutFound = true;
+		}
+		return *RegisteredSpec;
 	}
 
-	// 2. Check DataAsset registry (editor workflow)
-	// Currently MediumSpecMap maps FName → UMediumSpec*, so ID lookup is available
-	// But we can't easily convert UMediumSpec* to FRuntimeMediumSpec  without the struct
-	// TODO: Add struct conversion or cache structs from DataAssets
+	// Return fallback (never fails)
+	if (bOutFound)
+	{
+		*bOutFound = false;
+	}
+	return FallbackMediumSpec;
+}
 
-	// 3. Return fallback (never fails)
-	OutSpec = FallbackMediumSpec;
-	return false;
+FSpecHandle UEnvironmentSubsystem::GetMediumSpecHandle(const FMediumSpecId& Id) const
+{
+	return RuntimeMediumSpecs.FindHandle(Id.Id);
+}
+
+const FRuntimeMediumSpec& UEnvironmentSubsystem::GetRuntimeMediumSpec(FSpecHandle Handle) const
+{
+	const FRuntimeMediumSpec* Spec = RuntimeMediumSpecs.Get(Handle);
+	return Spec ? *Spec : FallbackMediumSpec;
 }
 
 bool UEnvironmentSubsystem::HasRuntimeMediumSpec(const FMediumSpecId& Id) const
 {
-	return RuntimeMediumSpecs.Contains(Id.Id);
+	return RuntimeAuthoredMediumIds.Contains(Id.Id);
 }
 
 TArray<FMediumSpecId> UEnvironmentSubsystem::GetAllRuntimeMediumSpecIds() const
 {
 	TArray<FMediumSpecId> Result;
-	Result.Reserve(RuntimeMediumSpecs.Num());
+	Result.Reserve(RuntimeAuthoredMediumIds.Num());
 	
-	for (const auto& Pair : RuntimeMediumSpecs)
+	for (const FName& SpecId : RuntimeMediumSpecs.GetIds())
 	{
-		FMediumSpecId Id;
-		Id.Id = Pair.Key;
-		Result.Add(Id);
+		if (RuntimeAuthoredMediumIds.Contains(SpecId))
+		{
+			Result.Add(FMediumSpecId(SpecId));
+		}
 	}
 	
 	return Result;
@@ -436,10 +942,42 @@ TArray<FMediumSpecId> UEnvironmentSubsystem::GetAllRuntimeMediumSpecIds() const
 
 void UEnvironmentSubsystem::ClearRuntimeMediumSpecs()
 {
-	RuntimeMediumSpecs.Empty();
+	// Invalidates every handle handed out so far
+	RuntimeMediumSpecs.Reset();
+	RuntimeAuthoredMediumIds.Empty();
+
+	// Asset specs are not runtime specs - put them back
+	for (const TPair<FName, UMediumSpec*>& Pair : MediumSpecMap)
+	{
+		InternMediumSpecAsset(Pair.Key, Pair.Value);
+	}
 	UE_LOG(LogTemp, Log, TEXT("Cleared all runtime MediumSpecs"));
 }
 
+int32 UEnvironmentSubsystem::UpdateRuntimeMediumSpecs(TConstArrayView<FRuntimeMediumSpec> Specs)
+{
+	UScriptStruct* SpecStruct = FRuntimeMediumSpec::StaticStruct();
+
+	int32 NumChanged = 0;
+	for (const FRuntimeMediumSpec& Spec : Specs)
+	{
+		const FRuntimeMediumSpec* Existing = RuntimeMediumSpecs.Find(Spec.SpecId);
+		if (Existing && RuntimeAuthoredMediumIds.Contains(Spec.SpecId) && SpecStruct->CompareScriptStruct(Existing, &Spec, PPF_None))
+		{
+			continue;
+		}
+
+		RegisterRuntimeMediumSpec(FMediumSpecId(Spec.SpecId), Spec);
+		NumChanged++;
+	}
+
+	if (NumChanged > 0)
+	{
+		InvalidateQuerySnapshot();
+	}
+	return NumChanged;
+}
+
 const FRuntimeMediumSpec & UEnvironmentSubsystem::GetFallbackMediumSpec()
 {
 	return FallbackMediumSpec;
@@ -5,11 +5,99 @@
 #include "Subsystems/PhysicsIntegrationSubsystem.h"
 #include "Subsystems/SurfaceQuerySubsystem.h"
 #include "Subsystems/EnvironmentSubsystem.h"
+#include "Space/Subsystems/WorldFrameSubsystem.h"
+#include "TPFCoreStats.h"
+#include "TPFTimingRecorder.h"
 #include "Components/PrimitiveComponent.h"
 #include "Engine/World.h"
+#include "GameFramework/PlayerController.h"
 #include "PhysicsEngine/BodyInstance.h"
+#include "Async/ParallelFor.h"
+#include "Chaos/SimCallbackObject.h"
+#include "Chaos/SimCallbackInput.h"
+#include "PBDRigidsSolver.h"
+#include "Chaos/ChaosSolverConfiguration.h"
+#include "Physics/Experimental/PhysScene_Chaos.h"
+#include "PhysicsProxy/SingleParticlePhysicsProxy.h"
+
+namespace
+{
+	/** Below this many bodies the force compute phase stays on the game thread */
+	constexpr int32 ParallelForceThreshold = 64;
+}
 
-DECLARE_CYCLE_STAT(TEXT("PhysicsIntegration Tick"), STAT_PhysicsIntegrationTick, STATGROUP_Game);
+//=============================================================================
+// FEnvironmentForceSimCallback
+//=============================================================================
+
+/** One body handed to the physics thread */
+struct FEnvironmentForceBody
+{
+	Chaos::FSingleParticlePhysicsProxy* Proxy = nullptr;
+	float Radius = 0.0f;
+	bool bApplyBuoyancy = true;
+};
+
+/** Game thread -> physics thread, produced once per game frame */
+struct FEnvironmentForceAsyncInput : public Chaos::FSimCallbackInput
+{
+	TSharedPtr<const FEnvironmentQuerySnapshot, ESPMode::ThreadSafe> Snapshot;
+	TArray<FEnvironmentForceBody> Bodies;
+	float MinDragVelocity = 0.0f;
+
+	/** World time the snapshot's gust field is sampled at */
+	double TimeSeconds = 0.0;
+
+	void Reset()
+	{
+		Snapshot.Reset();
+		Bodies.Reset();
+	}
+};
+
+/**
+ * Applies drag and buoyancy before every physics step. Reads only the snapshot and
+ * the particles' physics-thread state, so no UObject is touched off the game thread.
+ */
+class FEnvironmentForceSimCallback : public Chaos::TSimCallbackObject<
+	FEnvironmentForceAsyncInput, Chaos::FSimCallbackNoOutput, Chaos::ESimCallbackOptions::Presimulate>
+{
+	virtual void OnPreSimulate_Internal() override
+	{
+		const FEnvironmentForceAsyncInput* Input = GetConsumerInput_Internal();
+		const float DeltaTime = GetDeltaTime_Internal();
+		if (!Input || !Input->Snapshot || DeltaTime <= 0.0f)
+		{
+			return;
+		}
+
+		for (const FEnvironmentForceBody& Body : Input->Bodies)
+		{
+			Chaos::FRigidBodyHandle_Internal* Handle = Body.Proxy ? Body.Proxy->GetPhysicsThreadAPI() : nullptr;
+			if (!Handle || Handle->ObjectState() != Chaos::EObjectStateType::Dynamic)
+			{
+				continue;
+			}
+
+			UPhysicsIntegrationSubsystem::FBodyForceWork Work;
+			Work.Location = FVector(Handle->X());
+			Work.Velocity = FVector(Handle->V());
+			Work.Radius = Body.Radius;
+			Work.Mass = float(Handle->M());
+			Work.ElapsedTime = DeltaTime;
+			Work.bApplyBuoyancy = Body.bApplyBuoyancy;
+
+			UPhysicsIntegrationSubsystem::ComputeBodyImpulse(Work,
+				Input->Snapshot->GetEnvironmentAtLocation(Work.Location, Input->TimeSeconds), Input->MinDragVelocity);
+
+			if (!Work.Impulse.IsNearlyZero())
+			{
+				// Same clamped step impulse as the game-thread path, spread over the step
+				Handle->AddForce(Work.Impulse / DeltaTime);
+			}
+		}
+	}
+};
 
 //=============================================================================
 // UPhysicsIntegrationSubsystem
@@ -17,23 +105,77 @@ DECLARE_CYCLE_STAT(TEXT("PhysicsIntegration Tick"), STAT_PhysicsIntegrationTick,
 
 UPhysicsIntegrationSubsystem::UPhysicsIntegrationSubsystem()
 {
+	// Near: full rate and model. Mid: slower queries, every 4th frame. Far: drag only, rarely.
+	FPhysicsLODTier Near;
+	Near.MaxDistance = 5000.0f;
+	Near.EnvironmentQueryRate = 10.0f;
+	Near.ServiceInterval = 1;
+	LODTiers.Add(Near);
+
+	FPhysicsLODTier Mid;
+	Mid.MaxDistance = 20000.0f;
+	Mid.EnvironmentQueryRate = 2.0f;
+	Mid.ServiceInterval = 4;
+	LODTiers.Add(Mid);
+
+	FPhysicsLODTier Far;
+	Far.MaxDistance = 100000.0f;
+	Far.EnvironmentQueryRate = 0.5f;
+	Far.ServiceInterval = 16;
+	Far.bApplyBuoyancy = false;
+	LODTiers.Add(Far);
 }
 
 void UPhysicsIntegrationSubsystem::Initialize(FSubsystemCollectionBase& Collection)
 {
+	TPF_TIMING_SCOPE(TEXT("PhysicsIntegrationSubsystem::Initialize"));
+
 	Super::Initialize(Collection);
 
 	// Get references to other subsystems
 	SurfaceQuerySubsystem = GetWorld()->GetSubsystem<USurfaceQuerySubsystem>();
 	EnvironmentSubsystem = GetWorld()->GetSubsystem<UEnvironmentSubsystem>();
 
+	if (UWorldFrameSubsystem* WorldFrame = Collection.InitializeDependency<UWorldFrameSubsystem>())
+	{
+		OriginRebasedHandle = WorldFrame->OnWorldOriginRebased.AddUObject(this, &UPhysicsIntegrationSubsystem::HandleWorldOriginRebased);
+	}
+
 	UE_LOG(LogTemp, Log, TEXT("PhysicsIntegrationSubsystem initialized"));
 }
 
 void UPhysicsIntegrationSubsystem::Deinitialize()
 {
-	RegisteredBodies.Empty();
-	BodyCaches.Empty();
+	SetAsyncPhysicsForcesEnabled(false);
+
+	// Hand the solver's collision filter back to whoever else uses hit notifies
+	ApplyContactFilter(0.0f);
+
+	if (UWorldFrameSubsystem* WorldFrame = GetWorld()->GetSubsystem<UWorldFrameSubsystem>())
+	{
+		WorldFrame->OnWorldOriginRebased.Remove(OriginRebasedHandle);
+	}
+
+	BodyComponents.Empty();
+	BodyKeys.Empty();
+	BodyDamageSpecIds.Empty();
+	BodyMinImpulses.Empty();
+	BodyHitNotifyEnabled.Empty();
+	BodyEnvironmentContexts.Empty();
+	BodyLastQueryTimes.Empty();
+	BodyLastServiceTimes.Empty();
+	BodyLastServiceFrames.Empty();
+	BodyLODTiers.Empty();
+	BodySlotIndices.Empty();
+	BodySlots.Empty();
+	FreeBodySlots.Empty();
+	BodyIndexByComponent.Empty();
+	NumActiveBodies = 0;
+	ScheduleCursor = 0;
+	SleepingPruneCursor = 0;
+	PendingImpacts.Empty();
+	PendingImpactByPair.Empty();
+	ImpactBatch.Empty();
 	DamageSpecMap.Empty();
 
 	Super::Deinitialize();
@@ -48,48 +190,414 @@ bool UPhysicsIntegrationSubsystem::ShouldCreateSubsystem(UObject* Outer) const
 	return false;
 }
 
+void UPhysicsIntegrationSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	if (bUseAsyncPhysicsForces)
+	{
+		SetAsyncPhysicsForcesEnabled(true);
+	}
+}
+
+void UPhysicsIntegrationSubsystem::SetAsyncPhysicsForcesEnabled(bool bEnabled)
+{
+	bUseAsyncPhysicsForces = bEnabled;
+
+	if (bEnabled == (AsyncForceCallback != nullptr))
+	{
+		return;
+	}
+
+	FPhysScene* PhysScene = GetWorld() ? GetWorld()->GetPhysicsScene() : nullptr;
+	Chaos::FPhysicsSolver* Solver = PhysScene ? PhysScene->GetSolver() : nullptr;
+
+	if (!bEnabled)
+	{
+		if (Solver)
+		{
+			Solver->UnregisterAndFreeSimCallbackObject_External(AsyncForceCallback);
+		}
+		AsyncForceCallback = nullptr;
+		return;
+	}
+
+	if (!Solver)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("PhysicsIntegrationSubsystem: No physics solver, forces stay on the game thread"));
+		return;
+	}
+
+	AsyncForceCallback = Solver->CreateAndRegisterSimCallbackObject_External<FEnvironmentForceSimCallback>();
+}
+
+void UPhysicsIntegrationSubsystem::PushAsyncForceInput()
+{
+	FEnvironmentForceAsyncInput* Input = AsyncForceCallback->GetProducerInputData_External();
+	if (!Input)
+	{
+		return;
+	}
+
+	Input->Snapshot = EnvironmentSubsystem ? EnvironmentSubsystem->GetQuerySnapshot().ToSharedPtr() : nullptr;
+	Input->MinDragVelocity = MinDragVelocity;
+	Input->TimeSeconds = GetWorld()->GetTimeSeconds();
+	Input->Bodies.Reset(BodyComponents.Num());
+
+	// Proxies are re-sent every frame rather than cached on the physics thread, so
+	// a body destroyed this frame is never stepped from a stale list
+	for (int32 BodyIndex = 0; BodyIndex < NumActiveBodies; BodyIndex++)
+	{
+		const UPrimitiveComponent* Component = BodyComponents[BodyIndex];
+		if (!IsValid(Component) || !Component->IsSimulatingPhysics())
+		{
+			continue;
+		}
+
+		const FBodyInstance* BodyInstance = Component->GetBodyInstance();
+		if (Chaos::FSingleParticlePhysicsProxy* Proxy = BodyInstance ? BodyInstance->GetPhysicsActorHandle() : nullptr)
+		{
+			const int32 Tier = BodyLODTiers[BodyIndex];
+			const bool bApplyBuoyancy = !LODTiers.IsValidIndex(Tier) || LODTiers[Tier].bApplyBuoyancy;
+			Input->Bodies.Add({ Proxy, Component->Bounds.SphereRadius, bApplyBuoyancy });
+		}
+	}
+}
+
 void UPhysicsIntegrationSubsystem::Tick(float DeltaTime)
 {
-	SCOPE_CYCLE_COUNTER(STAT_PhysicsIntegrationTick);
+	SCOPE_CYCLE_COUNTER(STAT_TPF_PhysicsIntegrationTick);
+	CSV_SCOPED_TIMING_STAT(TPFCore, PhysicsIntegrationTick);
 
 	CurrentFrame++;
+	BodiesServicedLastFrame = 0;
+	LastTickSeconds = 0.0;
+
+	FlushPendingImpacts();
+
+	if (bContactFilterDirty)
+	{
+		UpdateContactFilter();
+	}
+
+	// Sleeping bodies are never swept; reap one per frame in case it was destroyed
+	if (NumActiveBodies < BodyComponents.Num())
+	{
+		if (SleepingPruneCursor < NumActiveBodies || SleepingPruneCursor >= BodyComponents.Num())
+		{
+			SleepingPruneCursor = NumActiveBodies;
+		}
+		if (!IsValid(BodyComponents[SleepingPruneCursor]))
+		{
+			RemoveBodyAt(SleepingPruneCursor);
+		}
+		else
+		{
+			SleepingPruneCursor++;
+		}
+	}
+
+	LODTierFrameStats.Reset();
+	LODTierFrameStats.SetNum(LODTiers.Num());
+
+	if (NumActiveBodies == 0)
+	{
+		return;
+	}
+
+	ViewLocations.Reset();
+	for (FConstPlayerControllerIterator It = GetWorld()->GetPlayerControllerIterator(); It; ++It)
+	{
+		if (const APlayerController* PlayerController = It->Get())
+		{
+			FVector ViewLocation;
+			FRotator ViewRotation;
+			PlayerController->GetPlayerViewPoint(ViewLocation, ViewRotation);
+			ViewLocations.Add(ViewLocation);
+		}
+	}
 
-	// Process registered bodies
-	int32 BodiesProcessed = 0;
 	const double CurrentTime = GetWorld()->GetTimeSeconds();
 	const double QueryInterval = 1.0 / FMath::Max(EnvironmentQueryRate, 1.0f);
+	const uint64 StartCycles = FPlatformTime::Cycles64();
+
+	if (AsyncForceCallback)
+	{
+		PushAsyncForceInput();
+	}
+
+	// 1. Gather (serial): which bodies, and their physics state
+	GatherScheduledBodies(CurrentTime, QueryInterval, DeltaTime);
+
+	// With physics-thread forces the scheduled bodies only get sleep tracking;
+	// their impulses stay zero
+	if (!AsyncForceCallback)
+	{
+		// 2. Environment: one batched query for the bodies that are due
+		RefreshBodyEnvironments(CurrentTime);
+
+		// 3. Compute (parallel): snapshots + cached contexts → impulses
+		ParallelFor(ForceWork.Num(), [this](int32 i)
+		{
+			FBodyForceWork& Work = ForceWork[i];
+			ComputeBodyImpulse(Work, BodyEnvironmentContexts[Work.BodyIndex], MinDragVelocity);
+		}, ForceWork.Num() < ParallelForceThreshold ? EParallelForFlags::ForceSingleThread : EParallelForFlags::None);
+	}
+
+	// 4. Apply (serial). Sleep transitions arrive as Chaos events, not from here.
+	for (const FBodyForceWork& Work : ForceWork)
+	{
+		if (!Work.Impulse.IsNearlyZero())
+		{
+			BodyComponents[Work.BodyIndex]->AddImpulse(Work.Impulse, NAME_None, false);
+		}
+	}
+
+	// ForceWork holds body indices, so bodies found dead go only now, highest index
+	// first: a removal moves bodies from higher indices only, leaving the rest valid
+	if (DeadBodyIndices.Num() > 0)
+	{
+		DeadBodyIndices.Sort(TGreater<int32>());
+		for (const int32 BodyIndex : DeadBodyIndices)
+		{
+			RemoveBodyAt(BodyIndex);
+		}
+		DeadBodyIndices.Reset();
+	}
+
+	BodiesServicedLastFrame = ForceWork.Num();
+	INC_DWORD_STAT_BY(STAT_TPF_BodiesServiced, BodiesServicedLastFrame);
+	SET_DWORD_STAT(STAT_TPF_BodiesActive, NumActiveBodies);
+	CSV_CUSTOM_STAT(TPFCore, BodiesServiced, BodiesServicedLastFrame, ECsvCustomStatOp::Set);
 
-	for (auto& Pair : RegisteredBodies)
+	LastTickSeconds = FPlatformTime::ToSeconds64(FPlatformTime::Cycles64() - StartCycles);
+	if (ForceWork.Num() > 0)
 	{
-		UPrimitiveComponent* Component = Pair.Key;
+		const double ElapsedSeconds = LastTickSeconds;
+		AverageBodyCostSeconds = FMath::Lerp(AverageBodyCostSeconds, ElapsedSeconds / ForceWork.Num(), 0.1);
+	}
+}
+
+void UPhysicsIntegrationSubsystem::GatherScheduledBodies(double CurrentTime, double QueryInterval, float FrameDeltaTime)
+{
+	ForceWork.Reset();
+	DeadBodyIndices.Reset();
+
+	// TimeBudget mode sizes the frame from the measured per-body cost, since the
+	// compute phase runs after selection
+	const int32 BodyBudget = ScheduleMode == EPhysicsBodyScheduleMode::TimeBudget
+		? FMath::Max(1, int32(BodyTimeBudgetMicroseconds * 1e-6 / FMath::Max(AverageBodyCostSeconds, 1e-8)))
+		: MaxBodiesPerFrame;
+
+	// Round-robin over the awake bodies from where the last frame stopped, at most one lap per frame
+	const int32 NumBodies = NumActiveBodies;
+	for (int32 Visited = 0; Visited < NumBodies && ForceWork.Num() < BodyBudget; Visited++)
+	{
+		if (ScheduleCursor >= NumBodies)
+		{
+			ScheduleCursor = 0;
+		}
+		const int32 BodyIndex = ScheduleCursor;
+		ScheduleCursor++;
 		
-		if (!IsValid(Component))
+		if (!IsValid(BodyComponents[BodyIndex]))
+		{
+			// Destroyed without unregistering - removed after the apply phase
+			DeadBodyIndices.Add(BodyIndex);
+			continue;
+		}
+
+		// Low-priority bodies wait out their interval without using budget
+		if (bPrioritizeActiveBodies && BodyLastServiceTimes[BodyIndex] > 0.0
+			&& CurrentFrame - BodyLastServiceFrames[BodyIndex] < LowPriorityServiceInterval
+			&& !IsHighPriorityBody(BodyIndex))
 		{
 			continue;
 		}
 
-		// Throttle updates
-		if (BodiesProcessed >= MaxBodiesPerFrame)
+		// Farther tiers are evaluated less often and re-query less often
+		double BodyQueryInterval = QueryInterval;
+		bool bApplyBuoyancy = true;
+		const int32 Tier = SelectLODTier(BodyComponents[BodyIndex]->GetComponentLocation());
+		if (Tier != INDEX_NONE)
+		{
+			const FPhysicsLODTier& LOD = LODTiers[Tier];
+			BodyLODTiers[BodyIndex] = uint8(Tier);
+			if (BodyLastServiceTimes[BodyIndex] > 0.0 && CurrentFrame - BodyLastServiceFrames[BodyIndex] < LOD.ServiceInterval)
+			{
+				continue;
+			}
+			BodyQueryInterval = 1.0 / FMath::Max(LOD.EnvironmentQueryRate, 0.01f);
+			bApplyBuoyancy = LOD.bApplyBuoyancy;
+			LODTierFrameStats[Tier].BodiesServiced++;
+		}
+
+		// Forces cover the whole interval since this body was last serviced
+		const double LastServiceTime = BodyLastServiceTimes[BodyIndex];
+		const float ElapsedTime = LastServiceTime > 0.0 ? float(CurrentTime - LastServiceTime) : FrameDeltaTime;
+		BodyLastServiceTimes[BodyIndex] = CurrentTime;
+		BodyLastServiceFrames[BodyIndex] = CurrentFrame;
+
+		// A body that isn't simulating snapshots zero mass, which skips forces
+		FBodyForceWork& Work = ForceWork.AddDefaulted_GetRef();
+		SnapshotBodyForceInput(BodyIndex, ElapsedTime, Work);
+		Work.bNeedsEnvironment = (CurrentTime - BodyLastQueryTimes[BodyIndex]) >= BodyQueryInterval;
+		Work.bApplyBuoyancy = bApplyBuoyancy;
+	}
+}
+
+int32 UPhysicsIntegrationSubsystem::SelectLODTier(const FVector& Location) const
+{
+	if (LODTiers.Num() == 0)
+	{
+		return INDEX_NONE;
+	}
+
+	if (ViewLocations.Num() == 0)
+	{
+		return 0;
+	}
+
+	double NearestDistSq = TNumericLimits<double>::Max();
+	for (const FVector& ViewLocation : ViewLocations)
+	{
+		NearestDistSq = FMath::Min(NearestDistSq, FVector::DistSquared(Location, ViewLocation));
+	}
+
+	// Tier indices are stored as uint8
+	const int32 LastTier = FMath::Min(LODTiers.Num(), 256) - 1;
+	for (int32 Tier = 0; Tier < LastTier; Tier++)
+	{
+		if (NearestDistSq < FMath::Square(double(LODTiers[Tier].MaxDistance)))
+		{
+			return Tier;
+		}
+	}
+	return LastTier;
+}
+
+TArray<FPhysicsLODTierStats> UPhysicsIntegrationSubsystem::GetLODTierStats() const
+{
+	TArray<FPhysicsLODTierStats> Stats = LODTierFrameStats;
+	Stats.SetNum(LODTiers.Num());
+	for (const uint8 Tier : BodyLODTiers)
+	{
+		if (Stats.IsValidIndex(Tier))
+		{
+			Stats[Tier].NumBodies++;
+		}
+	}
+	return Stats;
+}
+
+void UPhysicsIntegrationSubsystem::RefreshBodyEnvironments(double CurrentTime)
+{
+	if (!EnvironmentSubsystem)
+	{
+		return;
+	}
+
+	TArray<int32> DueWork;
+	TArray<FVector> Locations;
+	for (int32 i = 0; i < ForceWork.Num(); i++)
+	{
+		if (ForceWork[i].bNeedsEnvironment)
 		{
-			break;
+			DueWork.Add(i);
+			Locations.Add(ForceWork[i].Location);
 		}
+	}
 
-		// Get or create cache
-		FBodyPhysicsCache& Cache = BodyCaches.FindOrAdd(Component);
+	if (DueWork.Num() == 0)
+	{
+		return;
+	}
+
+	TArray<FEnvironmentContext> Contexts;
+	Contexts.SetNum(Locations.Num());
+	EnvironmentSubsystem->GetEnvironmentAtLocations(Locations, Contexts);
+
+	for (int32 j = 0; j < DueWork.Num(); j++)
+	{
+		const int32 BodyIndex = ForceWork[DueWork[j]].BodyIndex;
+		BodyEnvironmentContexts[BodyIndex] = Contexts[j];
+		BodyLastQueryTimes[BodyIndex] = CurrentTime;
 
-		// Check if we need to update environment cache
-		if ((CurrentTime - Cache.LastQueryTime) >= QueryInterval)
+		if (LODTierFrameStats.IsValidIndex(BodyLODTiers[BodyIndex]))
 		{
-			UpdateBodyEnvironmentCache(Component, Cache);
+			LODTierFrameStats[BodyLODTiers[BodyIndex]].EnvironmentQueries++;
 		}
+	}
+}
+
+bool UPhysicsIntegrationSubsystem::SnapshotBodyForceInput(int32 BodyIndex, float ElapsedTime, FBodyForceWork& OutWork) const
+{
+	UPrimitiveComponent* Component = BodyComponents[BodyIndex];
+	OutWork.BodyIndex = BodyIndex;
+	OutWork.Location = Component->GetComponentLocation();
+	OutWork.ElapsedTime = ElapsedTime;
+
+	// Get body instance for physics properties
+	const FBodyInstance* BodyInstance = Component->GetBodyInstance();
+	if (!Component->IsSimulatingPhysics() || !BodyInstance)
+	{
+		return false;
+	}
 
-		// Apply environmental forces
-		ApplyEnvironmentalForces(Component, DeltaTime);
+	OutWork.Velocity = Component->GetPhysicsLinearVelocity();
+	OutWork.Radius = Component->Bounds.SphereRadius;
+	OutWork.Mass = BodyInstance->GetBodyMass();
+	return true;
+}
 
-		// Check sleep state for settle events
-		CheckBodySleepState(Component, Cache);
+void UPhysicsIntegrationSubsystem::ComputeBodyImpulse(FBodyForceWork& Work, const FEnvironmentContext& Context,
+	float MinDragVelocity)
+{
+	Work.Impulse = FVector::ZeroVector;
 
-		BodiesProcessed++;
+	// Not simulating, nearly stationary, or no environment yet
+	if (Work.Mass <= 0.0f || Work.Velocity.SizeSquared() < MinDragVelocity * MinDragVelocity || !Context.bIsValid)
+	{
+		return;
+	}
+
+	// Estimate drag area and displaced volume from bounds (simplified)
+	const float Radius = Work.Radius;
+	const float DragArea = PI * Radius * Radius; // Cross-sectional area estimate
+	const float DragCoeff = 0.5f; // Default sphere Cd
+
+	// Buoyancy only in dense media (denser than thin atmosphere), and only in tiers that model it
+	const float DisplacedVolume = Work.bApplyBuoyancy && Context.Density > 10.0f
+		? (4.0f / 3.0f) * PI * Radius * Radius * Radius
+		: 0.0f;
+
+	// Both forces from the cached context - no per-force environment lookups
+	const FEnvironmentalForces Forces = UEnvironmentSubsystem::CalculateEnvironmentalForcesInContext(
+		Context, Work.Velocity, DragArea, DragCoeff, DisplacedVolume);
+
+	// Integrate over the elapsed time; drag may stop the body but never reverse it
+	const float MaxDragImpulse = Work.Mass * Work.Velocity.Size();
+	Work.Impulse = (Forces.Drag * Work.ElapsedTime).GetClampedToMaxSize(MaxDragImpulse) + Forces.Buoyancy * Work.ElapsedTime;
+}
+
+bool UPhysicsIntegrationSubsystem::IsHighPriorityBody(int32 BodyIndex) const
+{
+	if (IsBodySleeping(BodyIndex))
+	{
+		return false;
+	}
+
+	const UPrimitiveComponent* Component = BodyComponents[BodyIndex];
+	return Component->GetPhysicsLinearVelocity().SizeSquared() >= MinDragVelocity * MinDragVelocity
+		|| Component->WasRecentlyRendered(0.2f);
+}
+
+void UPhysicsIntegrationSubsystem::HandleWorldOriginRebased(const FIntVector& ShiftCm)
+{
+	// Cached contexts predate the shift; re-resolve them against the moved volumes
+	for (double& LastQueryTime : BodyLastQueryTimes)
+	{
+		LastQueryTime = 0.0;
 	}
 }
 
@@ -102,11 +610,11 @@ TStatId UPhysicsIntegrationSubsystem::GetStatId() const
 // BODY REGISTRATION
 //=============================================================================
 
-void UPhysicsIntegrationSubsystem::RegisterPhysicsBody(UPrimitiveComponent* Component, FDamageSpecId DamageSpecId)
+FPhysicsBodyHandle UPhysicsIntegrationSubsystem::RegisterPhysicsBody(UPrimitiveComponent* Component, FDamageSpecId DamageSpecId)
 {
 	if (!Component)
 	{
-		return;
+		return FPhysicsBodyHandle();
 	}
 
 	if (!Component->IsSimulatingPhysics())
@@ -115,24 +623,211 @@ void UPhysicsIntegrationSubsystem::RegisterPhysicsBody(UPrimitiveComponent* Comp
 			*Component->GetName());
 	}
 
-	RegisteredBodies.Add(Component, DamageSpecId);
-	BodyCaches.Add(Component, FBodyPhysicsCache());
+	// Re-registering updates the damage spec and resets the cached state
+	const int32 ExistingIndex = FindBodyIndex(Component);
+	if (ExistingIndex != INDEX_NONE)
+	{
+		BodyDamageSpecIds[ExistingIndex] = DamageSpecId;
+		BodyEnvironmentContexts[ExistingIndex] = FEnvironmentContext();
+		BodyLastQueryTimes[ExistingIndex] = 0.0;
+		BodyLastServiceTimes[ExistingIndex] = 0.0;
+		BodyLastServiceFrames[ExistingIndex] = 0;
+		BodyLODTiers[ExistingIndex] = 0;
+		UpdateBodyImpactBinding(ExistingIndex);
+		SetBodySleeping(ExistingIndex, !Component->IsAnyRigidBodyAwake());
+		return GetPhysicsBodyHandle(Component);
+	}
+
+	int32 SlotIndex;
+	if (FreeBodySlots.Num() > 0)
+	{
+		SlotIndex = FreeBodySlots.Pop(EAllowShrinking::No);
+	}
+	else
+	{
+		SlotIndex = BodySlots.AddDefaulted();
+	}
+
+	const int32 BodyIndex = BodyComponents.Add(Component);
+	BodyKeys.Add(Component);
+	BodyDamageSpecIds.Add(DamageSpecId);
+	BodyMinImpulses.Add(0.0f);
+	BodyHitNotifyEnabled.Add(false);
+	BodyEnvironmentContexts.AddDefaulted();
+	BodyLastQueryTimes.Add(0.0);
+	BodyLastServiceTimes.Add(0.0);
+	BodyLastServiceFrames.Add(0);
+	BodyLODTiers.Add(0);
+	BodySlotIndices.Add(SlotIndex);
+
+	BodySlots[SlotIndex].BodyIndex = BodyIndex;
+	BodyIndexByComponent.Add(Component, BodyIndex);
+
+	// Appended into the sleeping range; awake bodies move into the sweep
+	SetBodySleeping(BodyIndex, !Component->IsAnyRigidBodyAwake());
+
+	// Sleep tracking is event-driven
+	Component->BodyInstance.bGenerateWakeEvents = true;
+	Component->OnComponentSleep.AddUniqueDynamic(this, &UPhysicsIntegrationSubsystem::HandleBodySleep);
+	Component->OnComponentWake.AddUniqueDynamic(this, &UPhysicsIntegrationSubsystem::HandleBodyWake);
+
+	// Impact damage is event-driven too
+	UpdateBodyImpactBinding(BodyIndex);
 
 	UE_LOG(LogTemp, Verbose, TEXT("Registered physics body: %s"), *Component->GetName());
+	return FPhysicsBodyHandle{ SlotIndex, BodySlots[SlotIndex].Generation };
 }
 
 void UPhysicsIntegrationSubsystem::UnregisterPhysicsBody(UPrimitiveComponent* Component)
 {
-	if (Component)
+	const int32 BodyIndex = FindBodyIndex(Component);
+	if (BodyIndex != INDEX_NONE)
 	{
-		RegisteredBodies.Remove(Component);
-		BodyCaches.Remove(Component);
+		RemoveBodyAt(BodyIndex);
 	}
 }
 
 bool UPhysicsIntegrationSubsystem::IsBodyRegistered(UPrimitiveComponent* Component) const
 {
-	return Component && RegisteredBodies.Contains(Component);
+	return FindBodyIndex(Component) != INDEX_NONE;
+}
+
+FPhysicsBodyHandle UPhysicsIntegrationSubsystem::GetPhysicsBodyHandle(UPrimitiveComponent* Component) const
+{
+	const int32 BodyIndex = FindBodyIndex(Component);
+	if (BodyIndex == INDEX_NONE)
+	{
+		return FPhysicsBodyHandle();
+	}
+
+	const int32 SlotIndex = BodySlotIndices[BodyIndex];
+	return FPhysicsBodyHandle{ SlotIndex, BodySlots[SlotIndex].Generation };
+}
+
+UPrimitiveComponent* UPhysicsIntegrationSubsystem::GetPhysicsBodyComponent(FPhysicsBodyHandle Handle) const
+{
+	if (!BodySlots.IsValidIndex(Handle.Slot))
+	{
+		return nullptr;
+	}
+
+	const FBodySlot& Slot = BodySlots[Handle.Slot];
+	if (Slot.Generation != Handle.Generation || Slot.BodyIndex == INDEX_NONE)
+	{
+		return nullptr;
+	}
+
+	return BodyComponents[Slot.BodyIndex];
+}
+
+int32 UPhysicsIntegrationSubsystem::FindBodyIndex(const UPrimitiveComponent* Component) const
+{
+	if (!Component)
+	{
+		return INDEX_NONE;
+	}
+
+	const int32* BodyIndex = BodyIndexByComponent.Find(Component);
+	return BodyIndex ? *BodyIndex : INDEX_NONE;
+}
+
+void UPhysicsIntegrationSubsystem::SwapBodies(int32 IndexA, int32 IndexB)
+{
+	if (IndexA == IndexB)
+	{
+		return;
+	}
+
+	BodyComponents.Swap(IndexA, IndexB);
+	BodyKeys.Swap(IndexA, IndexB);
+	BodyDamageSpecIds.Swap(IndexA, IndexB);
+	BodyMinImpulses.Swap(IndexA, IndexB);
+	BodyHitNotifyEnabled.Swap(IndexA, IndexB);
+	BodyEnvironmentContexts.Swap(IndexA, IndexB);
+	BodyLastQueryTimes.Swap(IndexA, IndexB);
+	BodyLastServiceTimes.Swap(IndexA, IndexB);
+	BodyLastServiceFrames.Swap(IndexA, IndexB);
+	BodyLODTiers.Swap(IndexA, IndexB);
+	BodySlotIndices.Swap(IndexA, IndexB);
+
+	for (const int32 Index : { IndexA, IndexB })
+	{
+		BodySlots[BodySlotIndices[Index]].BodyIndex = Index;
+		BodyIndexByComponent.Add(BodyKeys[Index], Index);
+	}
+}
+
+int32 UPhysicsIntegrationSubsystem::DeactivateBodyAt(int32 BodyIndex)
+{
+	// An already-visited body is first swapped with the last visited one, so the
+	// body that fills its place from the end of the active range is still ahead of the cursor
+	if (BodyIndex < ScheduleCursor)
+	{
+		ScheduleCursor--;
+		SwapBodies(BodyIndex, ScheduleCursor);
+		BodyIndex = ScheduleCursor;
+	}
+
+	NumActiveBodies--;
+	SwapBodies(BodyIndex, NumActiveBodies);
+	return NumActiveBodies;
+}
+
+void UPhysicsIntegrationSubsystem::SetBodySleeping(int32 BodyIndex, bool bSleeping)
+{
+	if (bSleeping == IsBodySleeping(BodyIndex))
+	{
+		return;
+	}
+
+	if (bSleeping)
+	{
+		DeactivateBodyAt(BodyIndex);
+	}
+	else
+	{
+		// Lands at the end of the active range, ahead of the cursor
+		SwapBodies(BodyIndex, NumActiveBodies);
+		NumActiveBodies++;
+	}
+}
+
+void UPhysicsIntegrationSubsystem::RemoveBodyAt(int32 BodyIndex)
+{
+	ReleaseBodyImpactBinding(BodyIndex);
+
+	if (UPrimitiveComponent* Component = BodyComponents[BodyIndex])
+	{
+		Component->OnComponentSleep.RemoveDynamic(this, &UPhysicsIntegrationSubsystem::HandleBodySleep);
+		Component->OnComponentWake.RemoveDynamic(this, &UPhysicsIntegrationSubsystem::HandleBodyWake);
+	}
+
+	if (!IsBodySleeping(BodyIndex))
+	{
+		BodyIndex = DeactivateBodyAt(BodyIndex);
+	}
+
+	SwapBodies(BodyIndex, BodyComponents.Num() - 1);
+
+	const int32 SlotIndex = BodySlotIndices.Last();
+	FBodySlot& Slot = BodySlots[SlotIndex];
+	Slot.BodyIndex = INDEX_NONE;
+	Slot.Generation++;
+	FreeBodySlots.Add(SlotIndex);
+
+	BodyIndexByComponent.Remove(BodyKeys.Last());
+
+	BodyComponents.Pop(EAllowShrinking::No);
+	BodyKeys.Pop(EAllowShrinking::No);
+	BodyDamageSpecIds.Pop(EAllowShrinking::No);
+	BodyMinImpulses.Pop(EAllowShrinking::No);
+	BodyHitNotifyEnabled.Pop(EAllowShrinking::No);
+	BodyEnvironmentContexts.Pop(EAllowShrinking::No);
+	BodyLastQueryTimes.Pop(EAllowShrinking::No);
+	BodyLastServiceTimes.Pop(EAllowShrinking::No);
+	BodyLastServiceFrames.Pop(EAllowShrinking::No);
+	BodyLODTiers.Pop(EAllowShrinking::No);
+	BodySlotIndices.Pop(EAllowShrinking::No);
 }
 
 //=============================================================================
@@ -175,64 +870,30 @@ FVector UPhysicsIntegrationSubsystem::CalculateBodyBuoyancy(UPrimitiveComponent*
 
 void UPhysicsIntegrationSubsystem::ApplyEnvironmentalForces(UPrimitiveComponent* Component, float DeltaTime)
 {
-	if (!Component || !Component->IsSimulatingPhysics())
-	{
-		return;
-	}
-
-	// Get body instance for physics properties
-	FBodyInstance* BodyInstance = Component->GetBodyInstance();
-	if (!BodyInstance)
+	const int32 BodyIndex = FindBodyIndex(Component);
+	if (BodyIndex != INDEX_NONE)
 	{
-		return;
+		ApplyBodyForces(BodyIndex, DeltaTime);
 	}
+}
 
-	// Get current velocity
-	const FVector Velocity = Component->GetPhysicsLinearVelocity();
-
-	// Skip if nearly stationary
-	if (Velocity.SizeSquared() < MinDragVelocity * MinDragVelocity)
+void UPhysicsIntegrationSubsystem::ApplyBodyForces(int32 BodyIndex, float DeltaTime)
+{
+	if (!IsValid(BodyComponents[BodyIndex]))
 	{
 		return;
 	}
 
-	// Get cached environment context
-	FBodyPhysicsCache* Cache = BodyCaches.Find(Component);
-	if (!Cache || !Cache->EnvironmentContext.bIsValid)
+	FBodyForceWork Work;
+	if (!SnapshotBodyForceInput(BodyIndex, DeltaTime, Work))
 	{
 		return;
 	}
 
-	// Calculate drag using cached environment
-	// Estimate drag area from bounds (simplified)
-	FBoxSphereBounds Bounds = Component->Bounds;
-	float DragArea = PI * Bounds.SphereRadius * Bounds.SphereRadius; // Cross-sectional area estimate
-
-	// Get drag coefficient from component or use default
-	float DragCoeff = 0.5f; // Default sphere Cd
-	
-	// Calculate drag force
-	const FVector Location = Component->GetComponentLocation();
-	FVector DragForce = EnvironmentSubsystem->CalculateDragForce(Location, Velocity, DragArea, DragCoeff);
-
-	// Apply drag force
-	if (!DragForce.IsNearlyZero())
+	ComputeBodyImpulse(Work, BodyEnvironmentContexts[BodyIndex], MinDragVelocity);
+	if (!Work.Impulse.IsNearlyZero())
 	{
-		Component->AddForce(DragForce, NAME_None, false);
-	}
-
-	// Calculate and apply buoyancy if in dense medium
-	if (Cache->EnvironmentContext.Density > 10.0f) // Denser than thin atmosphere
-	{
-		// Estimate displaced volume from bounds
-		float DisplacedVolume = (4.0f / 3.0f) * PI * FMath::Pow(Bounds.SphereRadius, 3.0f);
-		
-		FVector BuoyancyForce = EnvironmentSubsystem->CalculateBuoyancyForce(Location, DisplacedVolume);
-		
-		if (!BuoyancyForce.IsNearlyZero())
-		{
-			Component->AddForce(BuoyancyForce, NAME_None, false);
-		}
+		BodyComponents[BodyIndex]->AddImpulse(Work.Impulse, NAME_None, false);
 	}
 }
 
@@ -301,92 +962,279 @@ float UPhysicsIntegrationSubsystem::CalculateImpactEnergy(float NormalImpulse, f
 	return Energy;
 }
 
-void UPhysicsIntegrationSubsystem::ProcessCollisionHit(
-	UPrimitiveComponent* Component,
-	UPrimitiveComponent* OtherComponent,
-	FVector NormalImpulse,
-	const FHitResult& HitResult)
+void UPhysicsIntegrationSubsystem::RegisterDamageSpec(UDamageSpec* Spec)
 {
-	if (!Component)
+	if (!Spec || !Spec->SpecId.IsValid())
+	{
+		UE_LOG(LogTemp, Warning, TEXT("RegisterDamageSpec: Spec is null or has no SpecId"));
+		return;
+	}
+
+	DamageSpecMap.Add(Spec->SpecId.Id, Spec);
+
+	// Bodies registered before their spec get its thresholds now
+	for (int32 BodyIndex = 0; BodyIndex < BodyComponents.Num(); BodyIndex++)
+	{
+		if (BodyDamageSpecIds[BodyIndex] == Spec->SpecId)
+		{
+			UpdateBodyImpactBinding(BodyIndex);
+		}
+	}
+}
+
+void UPhysicsIntegrationSubsystem::UpdateBodyImpactBinding(int32 BodyIndex)
+{
+	UPrimitiveComponent* Component = BodyComponents[BodyIndex];
+	if (!IsValid(Component))
 	{
 		return;
 	}
 
-	// Get damage spec for this component
-	FDamageSpecId* FoundSpecId = RegisteredBodies.Find(Component);
-	if (!FoundSpecId || !FoundSpecId->IsValid())
+	bContactFilterDirty = true;
+
+	const FDamageSpecId DamageSpecId = BodyDamageSpecIds[BodyIndex];
+	if (!bAutoBindImpactHits || !DamageSpecId.IsValid())
 	{
+		ReleaseBodyImpactBinding(BodyIndex);
 		return;
 	}
 
-	// Get the damage spec
-	UDamageSpec* DamageSpec = GetDamageSpecForComponent(Component);
-	if (!DamageSpec)
+	// Inverse of CalculateImpactEnergy: the impulse that delivers ImpactThresholdMin at this mass
+	BodyMinImpulses[BodyIndex] = 0.0f;
+	UDamageSpec* const* DamageSpec = DamageSpecMap.Find(DamageSpecId.Id);
+	const FBodyInstance* BodyInstance = Component->GetBodyInstance();
+	if (DamageSpec && *DamageSpec && BodyInstance)
+	{
+		const float Mass = BodyInstance->GetBodyMass();
+		BodyMinImpulses[BodyIndex] = FMath::Sqrt(2.0f * Mass * (*DamageSpec)->ImpactThresholdMin) * 100.0f;
+	}
+
+	if (!Component->BodyInstance.bNotifyRigidBodyCollision)
 	{
+		Component->SetNotifyRigidBodyCollision(true);
+		BodyHitNotifyEnabled[BodyIndex] = true;
+	}
+	Component->OnComponentHit.AddUniqueDynamic(this, &UPhysicsIntegrationSubsystem::HandleBodyHit);
+}
+
+void UPhysicsIntegrationSubsystem::ReleaseBodyImpactBinding(int32 BodyIndex)
+{
+	bContactFilterDirty = true;
+	BodyMinImpulses[BodyIndex] = 0.0f;
+
+	UPrimitiveComponent* Component = BodyComponents[BodyIndex];
+	if (!IsValid(Component))
+	{
+		BodyHitNotifyEnabled[BodyIndex] = false;
 		return;
 	}
 
-	// Calculate impact energy
-	FBodyInstance* BodyInstance = Component->GetBodyInstance();
-	float Mass = BodyInstance ? BodyInstance->GetBodyMass() : 1.0f;
-	float ImpactEnergy = CalculateImpactEnergy(NormalImpulse.Size(), Mass);
+	Component->OnComponentHit.RemoveDynamic(this, &UPhysicsIntegrationSubsystem::HandleBodyHit);
+	if (BodyHitNotifyEnabled[BodyIndex])
+	{
+		Component->SetNotifyRigidBodyCollision(false);
+		BodyHitNotifyEnabled[BodyIndex] = false;
+	}
+}
+
+void UPhysicsIntegrationSubsystem::UpdateContactFilter()
+{
+	bContactFilterDirty = false;
+
+	// The filter is solver-wide, so it may only drop what no bound body could take damage from.
+	// A bound body with an unresolved spec (0) keeps every contact.
+	float MinImpulse = 0.0f;
+	if (bFilterContactsOnPhysicsThread && bAutoBindImpactHits)
+	{
+		bool bAnyBound = false;
+		MinImpulse = TNumericLimits<float>::Max();
+		for (int32 BodyIndex = 0; BodyIndex < BodyDamageSpecIds.Num(); BodyIndex++)
+		{
+			if (BodyDamageSpecIds[BodyIndex].IsValid())
+			{
+				MinImpulse = FMath::Min(MinImpulse, BodyMinImpulses[BodyIndex]);
+				bAnyBound = true;
+			}
+		}
+		MinImpulse = bAnyBound ? MinImpulse * ContactFilterImpulseScale : 0.0f;
+	}
+
+	ApplyContactFilter(MinImpulse);
+}
 
-	// Check against threshold
-	if (ImpactEnergy >= DamageSpec->ImpactThresholdMin)
+void UPhysicsIntegrationSubsystem::ApplyContactFilter(float MinImpulse)
+{
+	if (MinImpulse == AppliedContactFilterImpulse)
 	{
-		// Broadcast damage event
-		OnImpactDamage.Broadcast(Component, HitResult, ImpactEnergy, *FoundSpecId);
+		return;
+	}
 
-		UE_LOG(LogTemp, Verbose, TEXT("Impact damage: %s, Energy: %.2f J (threshold: %.2f J)"),
-			*Component->GetName(), ImpactEnergy, DamageSpec->ImpactThresholdMin);
+	FPhysScene* PhysScene = GetWorld() ? GetWorld()->GetPhysicsScene() : nullptr;
+	Chaos::FPhysicsSolver* Solver = PhysScene ? PhysScene->GetSolver() : nullptr;
+	if (!Solver)
+	{
+		return;
 	}
+
+	FSolverCollisionFilterSettings FilterSettings;
+	FilterSettings.FilterEnabled = MinImpulse > 0.0f;
+	FilterSettings.MinMass = 0.0f;
+	FilterSettings.MinSpeed = 0.0f;
+	FilterSettings.MinImpulse = MinImpulse;
+	AppliedContactFilterImpulse = MinImpulse;
+
+	// The filter is read while the solver gathers collision events
+	Solver->EnqueueCommandImmediate([Solver, FilterSettings]()
+	{
+		Solver->SetCollisionFilterSettings(FilterSettings);
+	});
+
+	UE_LOG(LogTemp, Verbose, TEXT("PhysicsIntegration: Contact filter MinImpulse=%.1f"), MinImpulse);
 }
 
-//=============================================================================
-// INTERNAL
-//=============================================================================
+void UPhysicsIntegrationSubsystem::HandleBodyHit(UPrimitiveComponent* HitComponent, AActor* OtherActor,
+	UPrimitiveComponent* OtherComponent, FVector NormalImpulse, const FHitResult& Hit)
+{
+	ProcessCollisionHit(HitComponent, OtherComponent, NormalImpulse, Hit);
+}
 
-void UPhysicsIntegrationSubsystem::UpdateBodyEnvironmentCache(UPrimitiveComponent* Component, 
-	FBodyPhysicsCache& Cache)
+void UPhysicsIntegrationSubsystem::ProcessCollisionHit(
+	UPrimitiveComponent* Component,
+	UPrimitiveComponent* OtherComponent,
+	FVector NormalImpulse,
+	const FHitResult& HitResult)
 {
-	if (!Component || !EnvironmentSubsystem)
+	// Runs once per contact callback - only reject and buffer here
+	const int32 BodyIndex = FindBodyIndex(Component);
+	if (BodyIndex == INDEX_NONE || !BodyDamageSpecIds[BodyIndex].IsValid())
 	{
 		return;
 	}
 
-	const FVector Location = Component->GetComponentLocation();
-	Cache.EnvironmentContext = EnvironmentSubsystem->GetEnvironmentAtLocation(Location);
-	Cache.LastQueryTime = GetWorld()->GetTimeSeconds();
+	// Too weak to reach the damage threshold; nothing to buffer
+	const float ImpulseSize = NormalImpulse.Size();
+	if (ImpulseSize < BodyMinImpulses[BodyIndex])
+	{
+		return;
+	}
+
+	const int32 SlotIndex = BodySlotIndices[BodyIndex];
+	const FPhysicsBodyHandle Body(SlotIndex, BodySlots[SlotIndex].Generation);
+
+	// Several contacts between the same pair in one frame: keep the strongest
+	const int32* Existing = PendingImpactByPair.Find({ Body, TObjectKey<UPrimitiveComponent>(OtherComponent) });
+	if (Existing)
+	{
+		FPendingImpact& Pending = PendingImpacts[*Existing];
+		if (ImpulseSize > Pending.NormalImpulse)
+		{
+			Pending.NormalImpulse = ImpulseSize;
+			Pending.Hit = HitResult;
+		}
+		return;
+	}
+
+	INC_DWORD_STAT(STAT_TPF_ImpactsQueued);
+	PendingImpactByPair.Add({ Body, TObjectKey<UPrimitiveComponent>(OtherComponent) }, PendingImpacts.Num());
+	PendingImpacts.Add({ Body, OtherComponent, ImpulseSize, HitResult });
 }
 
-void UPhysicsIntegrationSubsystem::CheckBodySleepState(UPrimitiveComponent* Component, 
-	FBodyPhysicsCache& Cache)
+void UPhysicsIntegrationSubsystem::FlushPendingImpacts()
 {
-	if (!Component)
+	if (PendingImpacts.Num() == 0)
 	{
 		return;
 	}
 
-	FBodyInstance* BodyInstance = Component->GetBodyInstance();
-	if (!BodyInstance)
+	ImpactBatch.Reset();
+	for (const FPendingImpact& Pending : PendingImpacts)
+	{
+		// Unregistered or destroyed since the hit
+		UPrimitiveComponent* Component = GetPhysicsBodyComponent(Pending.Body);
+		if (!IsValid(Component))
+		{
+			continue;
+		}
+
+		const int32 BodyIndex = BodySlots[Pending.Body.Slot].BodyIndex;
+		const FDamageSpecId DamageSpecId = BodyDamageSpecIds[BodyIndex];
+		UDamageSpec* const* DamageSpec = DamageSpecId.IsValid() ? DamageSpecMap.Find(DamageSpecId.Id) : nullptr;
+		if (!DamageSpec || !*DamageSpec)
+		{
+			continue;
+		}
+
+		const FBodyInstance* BodyInstance = Component->GetBodyInstance();
+		const float Mass = BodyInstance ? BodyInstance->GetBodyMass() : 1.0f;
+		const float ImpactEnergy = CalculateImpactEnergy(Pending.NormalImpulse, Mass);
+
+		// Check against threshold
+		if (ImpactEnergy >= (*DamageSpec)->ImpactThresholdMin)
+		{
+			FImpactDamageEvent& Event = ImpactBatch.AddDefaulted_GetRef();
+			Event.Component = Component;
+			Event.OtherComponent = Pending.OtherComponent.Get();
+			Event.Hit = Pending.Hit;
+			Event.ImpactEnergy = ImpactEnergy;
+			Event.DamageSpecId = DamageSpecId;
+		}
+	}
+
+	PendingImpacts.Reset();
+	PendingImpactByPair.Reset();
+
+	if (ImpactBatch.Num() == 0)
 	{
 		return;
 	}
 
-	bool bCurrentlySleeping = BodyInstance->IsInstanceAwake() == false;
+	UE_LOG(LogTemp, Verbose, TEXT("Impact damage: %d damaging impacts this frame"), ImpactBatch.Num());
 
-	// Detect transition to sleep
-	if (bCurrentlySleeping && !Cache.bIsSleeping)
+	// Handlers may queue new hits or unregister bodies; both are safe from here
+	OnImpactDamageBatch.Broadcast(ImpactBatch);
+
+	if (OnImpactDamage.IsBound())
 	{
-		// Body just settled - broadcast event
-		FTransform FinalTransform = Component->GetComponentTransform();
-		OnBodySettled.Broadcast(Component, FinalTransform);
+		for (const FImpactDamageEvent& Event : ImpactBatch)
+		{
+			OnImpactDamage.Broadcast(Event.Component, Event.Hit, Event.ImpactEnergy, Event.DamageSpecId);
+		}
+	}
+}
+
+//=============================================================================
+// INTERNAL
+//=============================================================================
 
-		UE_LOG(LogTemp, Verbose, TEXT("Body settled: %s at %s"),
-			*Component->GetName(), *FinalTransform.GetLocation().ToString());
+void UPhysicsIntegrationSubsystem::HandleBodySleep(UPrimitiveComponent* SleepingComponent, FName BoneName)
+{
+	const int32 BodyIndex = FindBodyIndex(SleepingComponent);
+	if (BodyIndex == INDEX_NONE || IsBodySleeping(BodyIndex))
+	{
+		return;
+	}
+
+	SetBodySleeping(BodyIndex, true);
+
+	// Body just settled - broadcast event
+	const FTransform FinalTransform = SleepingComponent->GetComponentTransform();
+	OnBodySettled.Broadcast(SleepingComponent, FinalTransform);
+
+	UE_LOG(LogTemp, Verbose, TEXT("Body settled: %s at %s"),
+		*SleepingComponent->GetName(), *FinalTransform.GetLocation().ToString());
+}
+
+void UPhysicsIntegrationSubsystem::HandleBodyWake(UPrimitiveComponent* WakingComponent, FName BoneName)
+{
+	const int32 BodyIndex = FindBodyIndex(WakingComponent);
+	if (BodyIndex == INDEX_NONE || !IsBodySleeping(BodyIndex))
+	{
+		return;
 	}
 
-	Cache.bIsSleeping = bCurrentlySleeping;
+	// Forces restart from this frame rather than integrating over the whole sleep
+	BodyLastServiceTimes[BodyIndex] = 0.0;
+	SetBodySleeping(BodyIndex, false);
 }
 
 UDamageSpec* UPhysicsIntegrationSubsystem::GetDamageSpecForComponent(UPrimitiveComponent* Component) const
@@ -396,13 +1244,13 @@ UDamageSpec* UPhysicsIntegrationSubsystem::GetDamageSpecForComponent(UPrimitiveC
 		return nullptr;
 	}
 
-	FDamageSpecId const* FoundSpecId = RegisteredBodies.Find(Component);
-	if (!FoundSpecId || !FoundSpecId->IsValid())
+	const int32 BodyIndex = FindBodyIndex(Component);
+	if (BodyIndex == INDEX_NONE || !BodyDamageSpecIds[BodyIndex].IsValid())
 	{
 		return nullptr;
 	}
 
-	UDamageSpec* const* FoundSpec = DamageSpecMap.Find(FoundSpecId->Id);
+	UDamageSpec* const* FoundSpec = DamageSpecMap.Find(BodyDamageSpecIds[BodyIndex].Id);
 	if (FoundSpec)
 	{
 		return *FoundSpec;
@@ -3,9 +3,29 @@
 // SPDX-License-Identifier: Apache-2.0
 
 #include "Subsystems/SurfaceQuerySubsystem.h"
+#include "Subsystems/SurfaceThermalSubsystem.h"
+#include "Subsystems/WeatherFieldSubsystem.h"
+#include "TPFCoreStats.h"
+#include "TPFTimingRecorder.h"
 #include "PhysicalMaterials/PhysicalMaterial.h"
 #include "Engine/World.h"
 #include "CollisionQueryParams.h"
+#include "WorldCollision.h"
+#include "Async/ParallelFor.h"
+
+namespace
+{
+	/** Below this many states the modifier pass stays on the calling thread */
+	constexpr int32 ParallelBuildThreshold = 64;
+
+	FCollisionQueryParams MakeSurfaceQueryParams()
+	{
+		FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(SurfaceQuery));
+		QueryParams.bReturnPhysicalMaterial = true;
+		QueryParams.bTraceComplex = false;
+		return QueryParams;
+	}
+}
 
 // Static fallback spec - hardcoded realistic defaults that never fail
 FRuntimeSurfaceSpec USurfaceQuerySubsystem::FallbackSurfaceSpec = []()
@@ -32,10 +52,17 @@ USurfaceQuerySubsystem::USurfaceQuerySubsystem()
 
 void USurfaceQuerySubsystem::Initialize(FSubsystemCollectionBase& Collection)
 {
+	TPF_TIMING_SCOPE(TEXT("SurfaceQuerySubsystem::Initialize"));
+
 	Super::Initialize(Collection);
 	
 	// Default trace channel for surface queries
 	SurfaceTraceChannel = ECC_Visibility;
+
+	SurfaceCache.SetNum(SurfaceCacheSetCount * SurfaceCacheWays);
+	SurfaceCacheHits = 0;
+	SurfaceCacheMisses = 0;
+	SurfaceDeltasChangedHandle = IDeltaStore::OnSurfaceDeltasChanged().AddUObject(this, &USurfaceQuerySubsystem::HandleSurfaceDeltasChanged);
 	
 	UE_LOG(LogTemp, Log, TEXT("SurfaceQuerySubsystem initialized for world: %s"), 
 		*GetWorld()->GetName());
@@ -43,8 +70,16 @@ void USurfaceQuerySubsystem::Initialize(FSubsystemCollectionBase& Collection)
 
 void USurfaceQuerySubsystem::Deinitialize()
 {
+	IDeltaStore::OnSurfaceDeltasChanged().Remove(SurfaceDeltasChangedHandle);
+	SurfaceCache.Empty();
+	SurfaceGrids.Empty();
+	DeltaStore.Reset();
 	SurfaceSpecMap.Empty();
-	RuntimeSurfaceSpecs.Empty();
+	RuntimeSurfaceSpecs.Reset();
+	RuntimeAuthoredSurfaceIds.Empty();
+	SurfaceSpecsById.Empty();
+	PendingBatches.Empty();
+	SpecKernels.Empty();
 	DefaultSurfaceSpec = nullptr;
 	
 	Super::Deinitialize();
@@ -66,6 +101,9 @@ bool USurfaceQuerySubsystem::ShouldCreateSubsystem(UObject* Outer) const
 
 FSurfaceState USurfaceQuerySubsystem::GetSurfaceStateFromHit(const FHitResult& HitResult) const
 {
+	SCOPE_CYCLE_COUNTER(STAT_TPF_SurfaceQuery);
+	INC_DWORD_STAT(STAT_TPF_SurfaceQueries);
+
 	FSurfaceState Result;
 	
 	if (!HitResult.bBlockingHit)
@@ -75,6 +113,46 @@ FSurfaceState USurfaceQuerySubsystem::GetSurfaceStateFromHit(const FHitResult& H
 
 	// Get the physical material from the hit
 	UPhysicalMaterial* PhysMat = HitResult.PhysMaterial.Get();
+
+	// Same material on the same tile builds the same state until a delta lands on it
+	FSurfaceCacheEntry* CacheSlot = nullptr;
+	FWorldCellKey CellKey;
+	int32 TileIndex = INDEX_NONE;
+	const double Now = GetWorld()->GetTimeSeconds();
+	if (bEnableSurfaceCache && SurfaceCache.Num() > 0)
+	{
+		const FVector AbsoluteLocation = ToAbsoluteLocation(HitResult.ImpactPoint);
+		CellKey = FWorldCellKey::FromWorldLocation(AbsoluteLocation);
+		TileIndex = FSurfaceTileDelta::TileIndexFromWorldLocation(AbsoluteLocation, CellKey);
+
+		const TObjectKey<UPhysicalMaterial> MatKey(PhysMat);
+		FSurfaceCacheEntry* Set = &SurfaceCache[GetSurfaceCacheSet(CellKey, TileIndex)];
+		for (int32 Way = 0; Way < SurfaceCacheWays; Way++)
+		{
+			FSurfaceCacheEntry& Entry = Set[Way];
+			if (Entry.TileIndex == TileIndex && Entry.CellKey == CellKey && Entry.PhysMat == MatKey)
+			{
+				if (SurfaceCacheLifetimeSeconds <= 0.0f || Now - Entry.CachedTime < SurfaceCacheLifetimeSeconds)
+				{
+					SurfaceCacheHits++;
+					INC_DWORD_STAT(STAT_TPF_SurfaceCacheHits);
+					return Entry.State;
+				}
+
+				// Expired - refresh in place
+				CacheSlot = &Entry;
+				break;
+			}
+
+			// Otherwise replace an empty way, or the oldest
+			if (!CacheSlot || (CacheSlot->TileIndex != INDEX_NONE && 
+				(Entry.TileIndex == INDEX_NONE || Entry.CachedTime < CacheSlot->CachedTime)))
+			{
+				CacheSlot = &Entry;
+			}
+		}
+		SurfaceCacheMisses++;
+	}
 	
 	// Look up the surface spec
 	const USurfaceSpec* Spec = GetSurfaceSpecForMaterial(PhysMat);
@@ -88,6 +166,15 @@ FSurfaceState USurfaceQuerySubsystem::GetSurfaceStateFromHit(const FHitResult& H
 		Result = BuildSurfaceState(Spec, HitResult.ImpactPoint);
 	}
 
+	if (CacheSlot)
+	{
+		CacheSlot->PhysMat = PhysMat;
+		CacheSlot->CellKey = CellKey;
+		CacheSlot->TileIndex = TileIndex;
+		CacheSlot->CachedTime = Now;
+		CacheSlot->State = Result;
+	}
+
 	return Result;
 }
 
@@ -106,11 +193,7 @@ FSurfaceState USurfaceQuerySubsystem::GetSurfaceStateAtLocation(const FVector& W
 	FVector Start = WorldLocation;
 	FVector End = WorldLocation - FVector(0.0f, 0.0f, TraceDistance);
 	
-	FCollisionQueryParams QueryParams;
-	QueryParams.bReturnPhysicalMaterial = true;
-	QueryParams.bTraceComplex = false;
-
-	if (World->LineTraceSingleByChannel(HitResult, Start, End, SurfaceTraceChannel, QueryParams))
+	if (World->LineTraceSingleByChannel(HitResult, Start, End, SurfaceTraceChannel, MakeSurfaceQueryParams()))
 	{
 		return GetSurfaceStateFromHit(HitResult);
 	}
@@ -121,16 +204,81 @@ FSurfaceState USurfaceQuerySubsystem::GetSurfaceStateAtLocation(const FVector& W
 TArray<FSurfaceState> USurfaceQuerySubsystem::BatchGetSurfaceStates(const TArray<FVector>& WorldLocations, float TraceDistance) const
 {
 	TArray<FSurfaceState> Results;
-	Results.Reserve(WorldLocations.Num());
+	UWorld* World = GetWorld();
+	if (!World)
+	{
+		Results.SetNum(WorldLocations.Num());
+		return Results;
+	}
 
-	for (const FVector& Location : WorldLocations)
+	const FCollisionQueryParams QueryParams = MakeSurfaceQueryParams();
+	TArray<FHitResult> Hits;
+	Hits.SetNum(WorldLocations.Num());
+	for (int32 i = 0; i < WorldLocations.Num(); i++)
 	{
-		Results.Add(GetSurfaceStateAtLocation(Location, TraceDistance));
+		const FVector& Start = WorldLocations[i];
+		World->LineTraceSingleByChannel(Hits[i], Start, Start - FVector(0.0f, 0.0f, TraceDistance), SurfaceTraceChannel, QueryParams);
 	}
 
+	BuildSurfaceStates(Hits, Results);
 	return Results;
 }
 
+uint32 USurfaceQuerySubsystem::BatchGetSurfaceStatesAsync(const TArray<FVector>& WorldLocations, float TraceDistance, FOnSurfaceStatesReady OnComplete)
+{
+	UWorld* World = GetWorld();
+	if (!World || WorldLocations.Num() == 0)
+	{
+		return 0;
+	}
+
+	const uint32 BatchId = NextBatchId++;
+	FPendingSurfaceBatch& Batch = PendingBatches.Add(BatchId);
+	Batch.Hits.SetNum(WorldLocations.Num());
+	Batch.RemainingTraces = WorldLocations.Num();
+	Batch.OnComplete = MoveTemp(OnComplete);
+
+	const FCollisionQueryParams QueryParams = MakeSurfaceQueryParams();
+	const FTraceDelegate TraceDelegate = FTraceDelegate::CreateUObject(this, &USurfaceQuerySubsystem::HandleAsyncSurfaceTrace, BatchId);
+	for (int32 i = 0; i < WorldLocations.Num(); i++)
+	{
+		// UserData carries the result slot
+		const FVector& Start = WorldLocations[i];
+		World->AsyncLineTraceByChannel(EAsyncTraceType::Single, Start, Start - FVector(0.0f, 0.0f, TraceDistance),
+			SurfaceTraceChannel, QueryParams, FCollisionResponseParams::DefaultResponseParam, &TraceDelegate, static_cast<uint32>(i));
+	}
+
+	return BatchId;
+}
+
+void USurfaceQuerySubsystem::HandleAsyncSurfaceTrace(const FTraceHandle& Handle, FTraceDatum& Datum, uint32 BatchId)
+{
+	FPendingSurfaceBatch* Batch = PendingBatches.Find(BatchId);
+	if (!Batch)
+	{
+		return;
+	}
+
+	const int32 Slot = static_cast<int32>(Datum.UserData);
+	if (Batch->Hits.IsValidIndex(Slot) && Datum.OutHits.Num() > 0)
+	{
+		Batch->Hits[Slot] = Datum.OutHits[0];
+	}
+
+	if (--Batch->RemainingTraces > 0)
+	{
+		return;
+	}
+
+	// Detach before broadcasting so the callback may queue new batches
+	FPendingSurfaceBatch Completed = MoveTemp(*Batch);
+	PendingBatches.Remove(BatchId);
+
+	TArray<FSurfaceState> States;
+	BuildSurfaceStates(Completed.Hits, States);
+	Completed.OnComplete.ExecuteIfBound(States);
+}
+
 //=============================================================================
 // SPEC REGISTRATION
 //=============================================================================
@@ -140,6 +288,9 @@ void USurfaceQuerySubsystem::RegisterSurfaceSpec(UPhysicalMaterial* PhysMat, USu
 	if (PhysMat && Spec)
 	{
 		SurfaceSpecMap.Add(PhysMat, Spec);
+		SpecKernels.Add(Spec, FSurfaceResponseKernel::Bake(*Spec));
+		IndexSurfaceSpecAsset(Spec);
+		InvalidateSurfaceCache();
 		
 		UE_LOG(LogTemp, Verbose, TEXT("Registered SurfaceSpec '%s' for PhysicalMaterial '%s'"),
 			*Spec->SpecId.Id.ToString(), *PhysMat->GetName());
@@ -168,40 +319,267 @@ void USurfaceQuerySubsystem::SetDefaultSurfaceSpec(USurfaceSpec* Spec)
 	
 	if (Spec)
 	{
+		SpecKernels.Add(Spec, FSurfaceResponseKernel::Bake(*Spec));
+		IndexSurfaceSpecAsset(Spec);
+		InvalidateSurfaceCache();
 		UE_LOG(LogTemp, Log, TEXT("Default SurfaceSpec set to: %s"), *Spec->SpecId.Id.ToString());
 	}
 }
 
+void USurfaceQuerySubsystem::RebakeSurfaceSpec(USurfaceSpec* Spec)
+{
+	if (Spec)
+	{
+		SpecKernels.Add(Spec, FSurfaceResponseKernel::Bake(*Spec));
+		IndexSurfaceSpecAsset(Spec);
+		InvalidateSurfaceCache();
+	}
+}
+
+USurfaceSpec* USurfaceQuerySubsystem::FindSurfaceSpecById(const FSurfaceSpecId& Id) const
+{
+	const TObjectPtr<USurfaceSpec>* Found = SurfaceSpecsById.Find(Id.Id);
+	return Found ? Found->Get() : nullptr;
+}
+
+void USurfaceQuerySubsystem::IndexSurfaceSpecAsset(USurfaceSpec* Spec)
+{
+	if (!Spec || !Spec->SpecId.IsValid())
+	{
+		return;
+	}
+
+	SurfaceSpecsById.Add(Spec->SpecId.Id, Spec);
+
+	// Runtime-authored specs win; the asset still resolves through FindSurfaceSpecById
+	if (RuntimeAuthoredSurfaceIds.Contains(Spec->SpecId.Id))
+	{
+		return;
+	}
+
+	FRuntimeSurfaceSpec Converted;
+	if (Spec->ToStruct(Converted))
+	{
+		RuntimeSurfaceSpecs.Register(Spec->SpecId.Id, Converted);
+	}
+}
+
+const FSurfaceResponseKernel* USurfaceQuerySubsystem::FindOrBakeKernel(const USurfaceSpec* Spec) const
+{
+	if (!Spec)
+	{
+		return nullptr;
+	}
+
+	if (const FSurfaceResponseKernel* Found = SpecKernels.Find(Spec))
+	{
+		return Found;
+	}
+	return &SpecKernels.Add(Spec, FSurfaceResponseKernel::Bake(*Spec));
+}
+
 //=============================================================================
-// DELTA INTEGRATION (base implementations - override for real delta storage)
+// STATE CACHE
 //=============================================================================
 
+int32 USurfaceQuerySubsystem::GetSurfaceCacheSet(const FWorldCellKey& CellKey, int32 TileIndex)
+{
+	const uint32 Hash = HashCombine(GetTypeHash(CellKey), ::GetTypeHash(TileIndex));
+	return static_cast<int32>(Hash % SurfaceCacheSetCount) * SurfaceCacheWays;
+}
+
+void USurfaceQuerySubsystem::InvalidateSurfaceCache()
+{
+	for (FSurfaceCacheEntry& Entry : SurfaceCache)
+	{
+		Entry.TileIndex = INDEX_NONE;
+	}
+}
+
+void USurfaceQuerySubsystem::InvalidateSurfaceCacheForSpecs(const TSet<FName>& SpecIds)
+{
+	if (SpecIds.Num() == 0)
+	{
+		return;
+	}
+
+	for (FSurfaceCacheEntry& Entry : SurfaceCache)
+	{
+		if (Entry.TileIndex != INDEX_NONE && SpecIds.Contains(Entry.State.SpecId.Id))
+		{
+			Entry.TileIndex = INDEX_NONE;
+		}
+	}
+}
+
+void USurfaceQuerySubsystem::InvalidateSurfaceCacheTile(const FWorldCellKey& CellKey, int32 TileIndex)
+{
+	if (SurfaceCache.Num() == 0)
+	{
+		return;
+	}
+
+	if (TileIndex == INDEX_NONE)
+	{
+		// Whole cell - its tiles are spread over every set
+		for (FSurfaceCacheEntry& Entry : SurfaceCache)
+		{
+			if (Entry.CellKey == CellKey)
+			{
+				Entry.TileIndex = INDEX_NONE;
+			}
+		}
+		return;
+	}
+
+	FSurfaceCacheEntry* Set = &SurfaceCache[GetSurfaceCacheSet(CellKey, TileIndex)];
+	for (int32 Way = 0; Way < SurfaceCacheWays; Way++)
+	{
+		if (Set[Way].TileIndex == TileIndex && Set[Way].CellKey == CellKey)
+		{
+			Set[Way].TileIndex = INDEX_NONE;
+		}
+	}
+}
+
+void USurfaceQuerySubsystem::HandleSurfaceDeltasChanged(const IDeltaStore* Store, const FWorldCellKey& CellKey, int32 TileIndex, const FSurfaceTileDelta* AppendedDelta)
+{
+	if (!Store || Store != DeltaStore.Get())
+	{
+		return;
+	}
+
+	if (FSurfaceChannelGrid* Grid = SurfaceGrids.Find(CellKey))
+	{
+		if (AppendedDelta)
+		{
+			Grid->ApplyDelta(*AppendedDelta);
+		}
+		else
+		{
+			// Reloaded or cleared - rebuild on next query
+			SurfaceGrids.Remove(CellKey);
+		}
+	}
+
+	if (TileIndex == INDEX_NONE)
+	{
+		InvalidateSurfaceCacheTile(CellKey, INDEX_NONE);
+		return;
+	}
+
+	// Bilinear samples reach half a tile into the neighbours
+	const int32 TileX = TileIndex % FSurfaceTileDelta::TilesPerCellAxis;
+	const int32 TileY = TileIndex / FSurfaceTileDelta::TilesPerCellAxis;
+	for (int32 Y = FMath::Max(TileY - 1, 0); Y <= FMath::Min(TileY + 1, FSurfaceTileDelta::TilesPerCellAxis - 1); Y++)
+	{
+		for (int32 X = FMath::Max(TileX - 1, 0); X <= FMath::Min(TileX + 1, FSurfaceTileDelta::TilesPerCellAxis - 1); X++)
+		{
+			InvalidateSurfaceCacheTile(CellKey, Y * FSurfaceTileDelta::TilesPerCellAxis + X);
+		}
+	}
+}
+
+//=============================================================================
+// DELTA INTEGRATION
+//=============================================================================
+
+void USurfaceQuerySubsystem::SetDeltaStore(TScriptInterface<IDeltaStore> InDeltaStore)
+{
+	DeltaStore = TWeakInterfacePtr<IDeltaStore>(InDeltaStore.GetObject());
+	SurfaceGrids.Empty();
+	InvalidateSurfaceCache();
+}
+
+const FSurfaceChannelGrid* USurfaceQuerySubsystem::FindOrBuildSurfaceGrid(const FWorldCellKey& CellKey) const
+{
+	const uint64 Frame = GFrameCounter;
+	if (FSurfaceChannelGrid* Found = SurfaceGrids.Find(CellKey))
+	{
+		Found->LastUsedFrame = Frame;
+		return Found;
+	}
+
+	IDeltaStore* Store = DeltaStore.Get();
+	if (!Store)
+	{
+		return nullptr;
+	}
+
+	if (SurfaceGrids.Num() >= MaxResidentSurfaceGrids)
+	{
+		auto Oldest = SurfaceGrids.CreateIterator();
+		for (auto It = SurfaceGrids.CreateIterator(); It; ++It)
+		{
+			if (It->Value.LastUsedFrame < Oldest->Value.LastUsedFrame)
+			{
+				Oldest = It;
+			}
+		}
+		Oldest.RemoveCurrent();
+	}
+
+	// The view makes the cell resident first; a load broadcast during it finds no grid yet
+	TConstArrayView<FSurfaceTileDelta> Deltas = Store->ViewSurfaceDeltas(CellKey);
+	FSurfaceChannelGrid& Grid = SurfaceGrids.Add(CellKey);
+	Grid.Rebuild(Deltas);
+	Grid.LastUsedFrame = Frame;
+	return &Grid;
+}
+
+float USurfaceQuerySubsystem::SampleSurfaceChannel(const FVector& WorldLocation, ESurfaceDeltaChannel Channel) const
+{
+	const FVector AbsoluteLocation = ToAbsoluteLocation(WorldLocation);
+	const FWorldCellKey CellKey = FWorldCellKey::FromWorldLocation(AbsoluteLocation);
+	const FSurfaceChannelGrid* Grid = FindOrBuildSurfaceGrid(CellKey);
+	return Grid ? Grid->Sample(Channel, AbsoluteLocation, CellKey) : 0.0f;
+}
+
+FVector USurfaceQuerySubsystem::ToAbsoluteLocation(const FVector& WorldLocation) const
+{
+	// Deltas persist across origin rebases, so they are keyed by absolute position
+	const UWorld* World = GetWorld();
+	return World ? WorldLocation + FVector(World->OriginLocation) : WorldLocation;
+}
+
 float USurfaceQuerySubsystem::GetWetnessAtLocation(const FVector& WorldLocation) const
 {
-	// Base implementation returns 0 (dry)
-	// Override in derived class to integrate with SurfaceDeltaSubsystem
-	return 0.0f;
+	// 0 (dry) without a delta store, plus whatever rain the weather field has left behind
+	float Wetness = SampleSurfaceChannel(WorldLocation, ESurfaceDeltaChannel::Wetness);
+	if (const UWeatherFieldSubsystem* WeatherField = GetWorld()->GetSubsystem<UWeatherFieldSubsystem>())
+	{
+		Wetness += WeatherField->SampleGroundWetnessAbsolute(ToAbsoluteLocation(WorldLocation));
+	}
+	return FMath::Clamp(Wetness, 0.0f, 1.0f);
 }
 
 float USurfaceQuerySubsystem::GetSnowDepthAtLocation(const FVector& WorldLocation) const
 {
-	// Base implementation returns 0 (no snow)
-	// Override in derived class to integrate with SurfaceDeltaSubsystem
-	return 0.0f;
+	// 0 (no snow) without a delta store
+	return FMath::Max(SampleSurfaceChannel(WorldLocation, ESurfaceDeltaChannel::SnowDepth), 0.0f);
 }
 
 float USurfaceQuerySubsystem::GetCompactionAtLocation(const FVector& WorldLocation) const
 {
-	// Base implementation returns 0 (no compaction)
-	// Override in derived class to integrate with SurfaceDeltaSubsystem
-	return 0.0f;
+	// 0 (no compaction) without a delta store
+	return FMath::Clamp(SampleSurfaceChannel(WorldLocation, ESurfaceDeltaChannel::SnowCompaction), 0.0f, 1.0f);
 }
 
 float USurfaceQuerySubsystem::GetTemperatureAtLocation(const FVector& WorldLocation) const
 {
-	// Base implementation returns Earth standard temperature (288K / 15°C)
+	// The live field where the thermal simulation covers the cell
+	if (const USurfaceThermalSubsystem* Thermal = GetWorld()->GetSubsystem<USurfaceThermalSubsystem>())
+	{
+		float DeviationK = 0.0f;
+		if (Thermal->SampleTemperatureDeviation(ToAbsoluteLocation(WorldLocation), DeviationK))
+		{
+			return Thermal->AmbientTemperatureK + DeviationK;
+		}
+	}
+
+	// Earth standard temperature (288K / 15°C) plus any local deviation
 	// Override in derived class to integrate with EnvironmentSubsystem
-	return 288.0f;
+	return 288.0f + SampleSurfaceChannel(WorldLocation, ESurfaceDeltaChannel::TemperatureDelta);
 }
 
 //=============================================================================
@@ -210,21 +588,30 @@ float USurfaceQuerySubsystem::GetTemperatureAtLocation(const FVector& WorldLocat
 
 FSurfaceState USurfaceQuerySubsystem::BuildSurfaceState(const USurfaceSpec* Spec, const FVector& Location) const
 {
-	FSurfaceState State;
-	
-	if (!Spec)
+	const FSurfaceResponseKernel* Kernel = FindOrBakeKernel(Spec);
+	if (!Kernel)
 	{
-		return State;
+		return FSurfaceState();
 	}
 
+	// Apply environmental modifiers to friction
+	FSurfaceState State = GatherSurfaceState(*Kernel, Location);
+	ApplyEnvironmentalModifiers(State, *Kernel);
+	return State;
+}
+
+FSurfaceState USurfaceQuerySubsystem::GatherSurfaceState(const FSurfaceResponseKernel& Kernel, const FVector& Location) const
+{
+	FSurfaceState State;
+
 	// Copy base properties from spec
-	State.SpecId = Spec->SpecId;
-	State.FrictionStatic = Spec->FrictionStatic;
-	State.FrictionDynamic = Spec->FrictionDynamic;
-	State.Restitution = Spec->Restitution;
-	State.Compliance = Spec->Compliance;
-	State.DeformationStrength = Spec->DeformationStrength;
-	State.FXProfileId = Spec->FXProfileId;
+	State.SpecId = Kernel.SpecId;
+	State.FrictionStatic = Kernel.FrictionStatic;
+	State.FrictionDynamic = Kernel.FrictionDynamic;
+	State.Restitution = Kernel.Restitution;
+	State.Compliance = Kernel.Compliance;
+	State.DeformationStrength = Kernel.DeformationStrength;
+	State.FXProfileId = Kernel.FXProfileId;
 
 	// Get environmental conditions at this location
 	State.Wetness = GetWetnessAtLocation(Location);
@@ -232,40 +619,80 @@ FSurfaceState USurfaceQuerySubsystem::BuildSurfaceState(const USurfaceSpec* Spec
 	State.Compaction = GetCompactionAtLocation(Location);
 	State.Temperature = GetTemperatureAtLocation(Location);
 
-	// Apply environmental modifiers to friction
-	ApplyEnvironmentalModifiers(State, Spec);
-
 	State.bIsValid = true;
 	return State;
 }
 
-void USurfaceQuerySubsystem::ApplyEnvironmentalModifiers(FSurfaceState& State, const USurfaceSpec* Spec) const
+void USurfaceQuerySubsystem::BuildSurfaceStates(TConstArrayView<FHitResult> Hits, TArray<FSurfaceState>& OutStates) const
 {
-	if (!Spec)
-	{
-		return;
-	}
+	SCOPE_CYCLE_COUNTER(STAT_TPF_SurfaceBatchBuild);
+	INC_DWORD_STAT_BY(STAT_TPF_SurfaceQueries, Hits.Num());
 
-	float FrictionMultiplier = 1.0f;
+	OutStates.Reset();
+	OutStates.SetNum(Hits.Num());
 
-	// Apply wetness response curve
-	if (State.Wetness > 0.0f)
+	// Gather: spec + environment samples (virtual, may read game state)
+	TArray<const USurfaceSpec*> Specs;
+	Specs.SetNumZeroed(Hits.Num());
+	for (int32 i = 0; i < Hits.Num(); i++)
 	{
-		const FRichCurve* WetnessCurve = Spec->WetnessResponseCurve.GetRichCurveConst();
-		if (WetnessCurve && WetnessCurve->GetNumKeys() > 0)
+		const FHitResult& Hit = Hits[i];
+		const USurfaceSpec* Spec = Hit.bBlockingHit ? GetSurfaceSpecForMaterial(Hit.PhysMaterial.Get()) : nullptr;
+		if (const FSurfaceResponseKernel* Kernel = FindOrBakeKernel(Spec))
 		{
-			FrictionMultiplier *= WetnessCurve->Eval(State.Wetness);
+			OutStates[i] = GatherSurfaceState(*Kernel, Hit.ImpactPoint);
+			Specs[i] = Spec;
 		}
 	}
 
-	// Apply temperature response curve
+	// Resolve kernels once baking is done so the pointers stay stable
+	TArray<const FSurfaceResponseKernel*> Kernels;
+	Kernels.SetNumZeroed(Hits.Num());
+	for (int32 i = 0; i < Hits.Num(); i++)
+	{
+		Kernels[i] = Specs[i] ? SpecKernels.Find(Specs[i]) : nullptr;
+	}
+
+	// Modify: pure function of state + POD kernel
+	ParallelFor(Hits.Num(), [&OutStates, &Kernels](int32 i)
 	{
-		const FRichCurve* TempCurve = Spec->TemperatureResponseCurve.GetRichCurveConst();
-		if (TempCurve && TempCurve->GetNumKeys() > 0)
+		if (Kernels[i])
 		{
-			FrictionMultiplier *= TempCurve->Eval(State.Temperature);
+			ApplyEnvironmentalModifiers(OutStates[i], *Kernels[i]);
 		}
+	}, Hits.Num() < ParallelBuildThreshold ? EParallelForFlags::ForceSingleThread : EParallelForFlags::None);
+}
+
+FSurfaceResponseKernel FSurfaceResponseKernel::Bake(const USurfaceSpec& Spec)
+{
+	FSurfaceResponseKernel Kernel;
+	Kernel.SpecId = Spec.SpecId;
+	Kernel.FXProfileId = Spec.FXProfileId;
+	Kernel.FrictionStatic = Spec.FrictionStatic;
+	Kernel.FrictionDynamic = Spec.FrictionDynamic;
+	Kernel.Restitution = Spec.Restitution;
+	Kernel.Compliance = Spec.Compliance;
+	Kernel.DeformationStrength = Spec.DeformationStrength;
+
+	Kernel.WetnessLUT.Bake(Spec.WetnessResponseCurve.GetRichCurveConst(), 0.0f, 1.0f);
+
+	// Cover the curve's own key range; outside it the curve is flat anyway
+	const FRichCurve* TempCurve = Spec.TemperatureResponseCurve.GetRichCurveConst();
+	float MinTempK = 200.0f;
+	float MaxTempK = 400.0f;
+	if (TempCurve && TempCurve->GetNumKeys() > 1)
+	{
+		TempCurve->GetTimeRange(MinTempK, MaxTempK);
 	}
+	Kernel.TemperatureLUT.Bake(TempCurve, MinTempK, MaxTempK);
+	return Kernel;
+}
+
+void USurfaceQuerySubsystem::ApplyEnvironmentalModifiers(FSurfaceState& State, const FSurfaceResponseKernel& Kernel)
+{
+	// Missing curves bake to 1.0, so both lookups are unconditional; dry keeps the base value
+	float FrictionMultiplier = State.Wetness > 0.0f ? Kernel.WetnessLUT.Evaluate(State.Wetness) : 1.0f;
+	FrictionMultiplier *= Kernel.TemperatureLUT.Evaluate(State.Temperature);
 
 	// Apply snow depth effect (deeper snow = more resistance but less friction)
 	if (State.SnowDepth > 0.0f)
@@ -301,49 +728,71 @@ void USurfaceQuerySubsystem::ApplyEnvironmentalModifiers(FSurfaceState& State, c
 // RUNTIME SPEC REGISTRATION (SpecPack / JSON)
 //=============================================================================
 
-void USurfaceQuerySubsystem::RegisterRuntimeSurfaceSpec(const FSurfaceSpecId& Id, const FRuntimeSurfaceSpec& Spec)
+FSpecHandle USurfaceQuerySubsystem::RegisterRuntimeSurfaceSpec(const FSurfaceSpecId& Id, const FRuntimeSurfaceSpec& Spec)
 {
-	RuntimeSurfaceSpecs.Add(Id.Id, Spec);
+	RuntimeAuthoredSurfaceIds.Add(Id.Id);
+	const FSpecHandle Handle = RuntimeSurfaceSpecs.Register(Id.Id, Spec);
 	
-	UE_LOG(LogTemp, Verbose, TEXT("Registered runtime SurfaceSpec: %s"), *Id.Id.ToString());
+	UE_LOG(LogTemp, Verbose, TEXT("Registered runtime SurfaceSpec: %s (handle %d)"), *Id.Id.ToString(), Handle.Index);
+	return Handle;
 }
 
 bool USurfaceQuerySubsystem::ResolveSurfaceSpec(const FSurfaceSpecId& Id, FRuntimeSurfaceSpec& OutSpec) const
 {
-	// Resolution order: Runtime registry → DataAsset fallback → Default
+	bool bFound = false;
+	OutSpec = ResolveSurfaceSpecRef(Id, &bFound);
+	return bFound;
+}
+
+const FRuntimeSurfaceSpec& USurfaceQuerySubsystem::ResolveSurfaceSpecRef(const FSurfaceSpecId& Id, bool* bOutFound) const
+{
+	// Resolution order: Runtime registry → DataAsset → Default
+	// Both sources are interned in one registry (runtime entries shadow assets),
+	// so either costs a single lookup
+	if (const FRuntimeSurfaceSpec* RegisteredSpec = RuntimeSurfaceSpecs.Find(Id.Id))
+	{
+		if (bOutFound)
+		{
+			*bOutFound = true;
+		}
+		return *RegisteredSpec;
+	}
 
-	// 1. Check runtime registry first (SpecPack / JSON loaded)
-	if (const FRuntimeSurfaceSpec* RuntimeSpec = RuntimeSurfaceSpecs.Find(Id.Id))
+	// Return fallback (never fails)
+	if (bOutFound)
 	{
-		OutSpec = *RuntimeSpec;
-		return true;
+		*bOutFound = false;
 	}
+	return FallbackSurfaceSpec;
+}
 
-	// 2. Check DataAsset registry (editor workflow)
-	// Would need to iterate SurfaceSpecMap to find by ID, but that maps PhysMat -> Spec
-	// For now, DataAsset lookup by ID is not supported in the current design
-	// TODO: Add TMap<FSurfaceSpecId, USurfaceSpec*> for asset-based ID lookup if needed
+FSpecHandle USurfaceQuerySubsystem::GetSurfaceSpecHandle(const FSurfaceSpecId& Id) const
+{
+	return RuntimeSurfaceSpecs.FindHandle(Id.Id);
+}
 
-	// 3. Return fallback (never fails)
-	OutSpec = FallbackSurfaceSpec;
-	return false;
+const FRuntimeSurfaceSpec& USurfaceQuerySubsystem::GetRuntimeSurfaceSpec(FSpecHandle Handle) const
+{
+	const FRuntimeSurfaceSpec* Spec = RuntimeSurfaceSpecs.Get(Handle);
+	return Spec ? *Spec : FallbackSurfaceSpec;
 }
 
 bool USurfaceQuerySubsystem::HasRuntimeSpec(const FSurfaceSpecId& Id) const
 {
-	return RuntimeSurfaceSpecs.Contains(Id.Id);
+	return RuntimeAuthoredSurfaceIds.Contains(Id.Id);
 }
 
 TArray<FSurfaceSpecId> USurfaceQuerySubsystem::GetAllRuntimeSpecIds() const
 {
 	TArray<FSurfaceSpecId> Result;
-	Result.Reserve(RuntimeSurfaceSpecs.Num());
+	Result.Reserve(RuntimeAuthoredSurfaceIds.Num());
 	
-	for (const auto& Pair : RuntimeSurfaceSpecs)
+	for (const FName& SpecId : RuntimeSurfaceSpecs.GetIds())
 	{
-		FSurfaceSpecId Id;
-		Id.Id = Pair.Key;
-		Result.Add(Id);
+		if (RuntimeAuthoredSurfaceIds.Contains(SpecId))
+		{
+			Result.Add(FSurfaceSpecId(SpecId));
+		}
 	}
 	
 	return Result;
@@ -351,10 +800,41 @@ TArray<FSurfaceSpecId> USurfaceQuerySubsystem::GetAllRuntimeSpecIds() const
 
 void USurfaceQuerySubsystem::ClearRuntimeSpecs()
 {
-	RuntimeSurfaceSpecs.Empty();
+	// Invalidates every handle handed out so far
+	RuntimeSurfaceSpecs.Reset();
+	RuntimeAuthoredSurfaceIds.Empty();
+
+	// Asset specs are not runtime specs - put them back
+	TArray<TObjectPtr<USurfaceSpec>> AssetSpecs;
+	SurfaceSpecsById.GenerateValueArray(AssetSpecs);
+	for (USurfaceSpec* Spec : AssetSpecs)
+	{
+		IndexSurfaceSpecAsset(Spec);
+	}
 	UE_LOG(LogTemp, Log, TEXT("Cleared all runtime SurfaceSpecs"));
 }
 
+int32 USurfaceQuerySubsystem::UpdateRuntimeSurfaceSpecs(TConstArrayView<FRuntimeSurfaceSpec> Specs)
+{
+	UScriptStruct* SpecStruct = FRuntimeSurfaceSpec::StaticStruct();
+
+	TSet<FName> ChangedIds;
+	for (const FRuntimeSurfaceSpec& Spec : Specs)
+	{
+		const FRuntimeSurfaceSpec* Existing = RuntimeSurfaceSpecs.Find(Spec.SpecId);
+		if (Existing && RuntimeAuthoredSurfaceIds.Contains(Spec.SpecId) && SpecStruct->CompareScriptStruct(Existing, &Spec, PPF_None))
+		{
+			continue;
+		}
+
+		RegisterRuntimeSurfaceSpec(FSurfaceSpecId(Spec.SpecId), Spec);
+		ChangedIds.Add(Spec.SpecId);
+	}
+
+	InvalidateSurfaceCacheForSpecs(ChangedIds);
+	return ChangedIds.Num();
+}
+
 const FRuntimeSurfaceSpec& USurfaceQuerySubsystem::GetFallbackSpec()
 {
 	return FallbackSurfaceSpec;
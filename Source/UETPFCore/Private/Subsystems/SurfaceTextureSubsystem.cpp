@@ -0,0 +1,331 @@
+// Copyright 2026 Threaded Pixel Factory
+// Licensed under the Apache License, Version 2.0 (the "License");
+// SPDX-License-Identifier: Apache-2.0
+
+#include "Subsystems/SurfaceTextureSubsystem.h"
+#include "Subsystems/SurfaceQuerySubsystem.h"
+#include "Subsystems/SurfaceThermalSubsystem.h"
+#include "TPFCoreStats.h"
+#include "TPFTimingRecorder.h"
+#include "Engine/Texture2D.h"
+#include "Engine/World.h"
+#include "GameFramework/PlayerController.h"
+#include "Materials/MaterialInstanceDynamic.h"
+#include "Materials/MaterialParameterCollection.h"
+#include "Materials/MaterialParameterCollectionInstance.h"
+#include "Misc/App.h"
+
+namespace
+{
+	const FName AtlasTextureParameter(TEXT("SurfaceAtlas"));
+	const FName AtlasMappingParameter(TEXT("SurfaceAtlasMapping"));
+	const FName AtlasWindowParameter(TEXT("SurfaceAtlasWindow"));
+
+	constexpr int32 TilesPerAxis = FSurfaceTileDelta::TilesPerCellAxis;
+}
+
+bool USurfaceTextureSubsystem::ShouldCreateSubsystem(UObject* Outer) const
+{
+	// Nothing samples the atlas on dedicated servers
+	if (const UWorld* World = Cast<UWorld>(Outer))
+	{
+		return World->IsGameWorld() && FApp::CanEverRender();
+	}
+	return false;
+}
+
+void USurfaceTextureSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	TPF_TIMING_SCOPE(TEXT("SurfaceTextureSubsystem::Initialize"));
+
+	Super::Initialize(Collection);
+
+	// The atlas is filled from the query subsystem's grids and the thermal field
+	Collection.InitializeDependency<USurfaceQuerySubsystem>();
+	Collection.InitializeDependency<USurfaceThermalSubsystem>();
+
+	CreateAtlas();
+	SurfaceDeltasChangedHandle = IDeltaStore::OnSurfaceDeltasChanged().AddUObject(this, &USurfaceTextureSubsystem::HandleSurfaceDeltasChanged);
+}
+
+void USurfaceTextureSubsystem::Deinitialize()
+{
+	IDeltaStore::OnSurfaceDeltasChanged().Remove(SurfaceDeltasChangedHandle);
+	Slots.Empty();
+	AtlasTexture = nullptr;
+	bHasWindow = false;
+
+	Super::Deinitialize();
+}
+
+void USurfaceTextureSubsystem::CreateAtlas()
+{
+	const int32 Size = AtlasCellsPerAxis * TilesPerAxis;
+
+	// Zeroed so slots read as untouched until their first upload
+	TArray64<uint8> ZeroTexels;
+	ZeroTexels.SetNumZeroed(static_cast<int64>(Size) * Size * sizeof(FFloat16Color));
+
+	AtlasTexture = UTexture2D::CreateTransient(Size, Size, PF_FloatRGBA, NAME_None, ZeroTexels);
+	AtlasTexture->SRGB = false;
+	AtlasTexture->CompressionSettings = TC_HDR;
+	AtlasTexture->Filter = TF_Bilinear;
+	AtlasTexture->AddressX = TA_Wrap;
+	AtlasTexture->AddressY = TA_Wrap;
+	AtlasTexture->NeverStream = true;
+	AtlasTexture->UpdateResource();
+
+	Slots.SetNum(AtlasCellsPerAxis * AtlasCellsPerAxis);
+
+	UE_LOG(LogTemp, Log, TEXT("SurfaceTextureSubsystem: %dx%d atlas (%d cells)"), Size, Size, Slots.Num());
+}
+
+int32 USurfaceTextureSubsystem::GetSlotIndex(const FWorldCellKey& CellKey) const
+{
+	const int32 SlotX = ((CellKey.X % AtlasCellsPerAxis) + AtlasCellsPerAxis) % AtlasCellsPerAxis;
+	const int32 SlotY = ((CellKey.Y % AtlasCellsPerAxis) + AtlasCellsPerAxis) % AtlasCellsPerAxis;
+	return SlotY * AtlasCellsPerAxis + SlotX;
+}
+
+void USurfaceTextureSubsystem::HandleSurfaceDeltasChanged(const IDeltaStore* Store, const FWorldCellKey& CellKey, int32 TileIndex, const FSurfaceTileDelta* AppendedDelta)
+{
+	// The atlas mirrors the surface query's store; a store bind change invalidates it in Tick
+	const USurfaceQuerySubsystem* Surface = GetWorld()->GetSubsystem<USurfaceQuerySubsystem>();
+	if (!Store || !Surface || Store != Surface->GetDeltaStore())
+	{
+		return;
+	}
+
+	// Slots outside the window keep following their cell, so re-entry needs no upload
+	FAtlasSlot& Slot = Slots[GetSlotIndex(CellKey)];
+	if (!Slot.bOccupied || Slot.CellKey != CellKey)
+	{
+		return;
+	}
+
+	if (!AppendedDelta || TileIndex == INDEX_NONE)
+	{
+		// Reloaded or cleared
+		Slot.MarkAllDirty();
+		return;
+	}
+
+	Slot.MarkDirty(TileIndex % TilesPerAxis, TileIndex / TilesPerAxis);
+}
+
+void USurfaceTextureSubsystem::InvalidateAtlas()
+{
+	for (FAtlasSlot& Slot : Slots)
+	{
+		if (Slot.bOccupied)
+		{
+			Slot.MarkAllDirty();
+		}
+	}
+}
+
+void USurfaceTextureSubsystem::Tick(float DeltaTime)
+{
+	if (!AtlasTexture || Slots.Num() == 0)
+	{
+		return;
+	}
+
+	SCOPE_CYCLE_COUNTER(STAT_TPF_SurfaceAtlasUpload);
+
+	// Binding a store changes every cell's values at once
+	const USurfaceQuerySubsystem* Surface = GetWorld()->GetSubsystem<USurfaceQuerySubsystem>();
+	UObject* Store = Surface ? Surface->GetDeltaStoreObject() : nullptr;
+	if (SourceStore.Get() != Store)
+	{
+		SourceStore = Store;
+		InvalidateAtlas();
+	}
+
+	UpdateWindow();
+
+	// The thermal field changes every step without any delta being appended
+	ThermalRefreshElapsed += DeltaTime;
+	if (ThermalRefreshElapsed >= ThermalRefreshSeconds)
+	{
+		ThermalRefreshElapsed = 0.0f;
+		if (const USurfaceThermalSubsystem* Thermal = GetWorld()->GetSubsystem<USurfaceThermalSubsystem>())
+		{
+			for (FAtlasSlot& Slot : Slots)
+			{
+				if (Slot.bOccupied && Thermal->FindCell(Slot.CellKey))
+				{
+					Slot.MarkAllDirty();
+				}
+			}
+		}
+	}
+
+	int32 Uploads = 0;
+	for (int32 Step = 0; Step < Slots.Num() && Uploads < MaxSlotUploadsPerTick; Step++)
+	{
+		const int32 SlotIndex = (NextUploadSlot + Step) % Slots.Num();
+		FAtlasSlot& Slot = Slots[SlotIndex];
+		if (Slot.bOccupied && !Slot.DirtyTiles.IsEmpty())
+		{
+			UploadSlot(Slot, SlotIndex);
+			Uploads++;
+			NextUploadSlot = (SlotIndex + 1) % Slots.Num();
+		}
+	}
+
+	UpdateParameterCollection();
+}
+
+void USurfaceTextureSubsystem::UpdateWindow()
+{
+	UWorld* World = GetWorld();
+	const APlayerController* PlayerController = World->GetFirstPlayerController();
+	if (!PlayerController)
+	{
+		return;
+	}
+
+	FVector ViewLocation;
+	FRotator ViewRotation;
+	PlayerController->GetPlayerViewPoint(ViewLocation, ViewRotation);
+
+	// Cells are keyed by absolute position, like the surface deltas
+	const FWorldCellKey Center = FWorldCellKey::FromWorldLocation(ViewLocation + FVector(World->OriginLocation), DeltaCellSize);
+	if (bHasWindow && Center == WindowCenter)
+	{
+		return;
+	}
+	WindowCenter = Center;
+	bHasWindow = true;
+
+	const int32 Radius = GetEffectiveRadius();
+	for (int32 Y = Center.Y - Radius; Y <= Center.Y + Radius; Y++)
+	{
+		for (int32 X = Center.X - Radius; X <= Center.X + Radius; X++)
+		{
+			const FWorldCellKey CellKey(X, Y, Center.LOD);
+			FAtlasSlot& Slot = Slots[GetSlotIndex(CellKey)];
+			if (!Slot.bOccupied || Slot.CellKey != CellKey)
+			{
+				Slot.CellKey = CellKey;
+				Slot.bOccupied = true;
+				Slot.MarkAllDirty();
+			}
+		}
+	}
+}
+
+void USurfaceTextureSubsystem::UploadSlot(FAtlasSlot& Slot, int32 SlotIndex)
+{
+	const FIntRect Rect = Slot.DirtyTiles;
+	Slot.DirtyTiles = FIntRect();
+
+	const USurfaceQuerySubsystem* Surface = GetWorld()->GetSubsystem<USurfaceQuerySubsystem>();
+	const FSurfaceChannelGrid* Grid = Surface ? Surface->GetSurfaceGrid(Slot.CellKey) : nullptr;
+	const USurfaceThermalSubsystem* Thermal = GetWorld()->GetSubsystem<USurfaceThermalSubsystem>();
+	const FSurfaceThermalCell* ThermalCell = Thermal ? Thermal->FindCell(Slot.CellKey) : nullptr;
+
+	const int32 Width = Rect.Width();
+	const int32 Height = Rect.Height();
+
+	// Owned by the render command; freed by the cleanup callback
+	FFloat16Color* Texels = new FFloat16Color[Width * Height];
+	for (int32 Y = 0; Y < Height; Y++)
+	{
+		for (int32 X = 0; X < Width; X++)
+		{
+			FLinearColor Value = FLinearColor::Transparent;
+			const int32 TileIndex = (Rect.Min.Y + Y) * TilesPerAxis + Rect.Min.X + X;
+			if (Grid)
+			{
+				Value.R = Grid->GetTileValue(ESurfaceDeltaChannel::SnowDepth, TileIndex);
+				Value.G = Grid->GetTileValue(ESurfaceDeltaChannel::SnowCompaction, TileIndex);
+				Value.B = Grid->GetTileValue(ESurfaceDeltaChannel::Wetness, TileIndex);
+				Value.A = Grid->GetTileValue(ESurfaceDeltaChannel::TemperatureDelta, TileIndex);
+			}
+			if (ThermalCell)
+			{
+				Value.A = ThermalCell->GetTile(TileIndex);
+			}
+			Texels[Y * Width + X] = FFloat16Color(Value);
+		}
+	}
+
+	const int32 SlotX = SlotIndex % AtlasCellsPerAxis;
+	const int32 SlotY = SlotIndex / AtlasCellsPerAxis;
+	FUpdateTextureRegion2D* Region = new FUpdateTextureRegion2D(
+		SlotX * TilesPerAxis + Rect.Min.X, SlotY * TilesPerAxis + Rect.Min.Y, 0, 0, Width, Height);
+
+	AtlasTexture->UpdateTextureRegions(0, 1, Region, Width * sizeof(FFloat16Color), sizeof(FFloat16Color),
+		reinterpret_cast<uint8*>(Texels),
+		[](uint8* SrcData, const FUpdateTextureRegion2D* Regions)
+		{
+			delete[] reinterpret_cast<FFloat16Color*>(SrcData);
+			delete Regions;
+		});
+
+	INC_DWORD_STAT_BY(STAT_TPF_SurfaceAtlasTexels, Width * Height);
+}
+
+FLinearColor USurfaceTextureSubsystem::GetAtlasMapping() const
+{
+	const FVector Origin(GetWorld()->OriginLocation);
+	const float AtlasSize = AtlasCellsPerAxis * DeltaCellSize;
+	return FLinearColor(Origin.X, Origin.Y, 1.0f / AtlasSize, DeltaCellSize);
+}
+
+FLinearColor USurfaceTextureSubsystem::GetAtlasWindow() const
+{
+	if (!bHasWindow)
+	{
+		return FLinearColor::Transparent;
+	}
+
+	const FVector Origin(GetWorld()->OriginLocation);
+	const int32 Radius = GetEffectiveRadius();
+	return FLinearColor(
+		(WindowCenter.X - Radius) * DeltaCellSize - Origin.X,
+		(WindowCenter.Y - Radius) * DeltaCellSize - Origin.Y,
+		(WindowCenter.X + Radius + 1) * DeltaCellSize - Origin.X,
+		(WindowCenter.Y + Radius + 1) * DeltaCellSize - Origin.Y);
+}
+
+void USurfaceTextureSubsystem::ApplyToMaterial(UMaterialInstanceDynamic* Material) const
+{
+	if (!Material)
+	{
+		return;
+	}
+
+	Material->SetTextureParameterValue(AtlasTextureParameter, AtlasTexture);
+	Material->SetVectorParameterValue(AtlasMappingParameter, GetAtlasMapping());
+	Material->SetVectorParameterValue(AtlasWindowParameter, GetAtlasWindow());
+}
+
+void USurfaceTextureSubsystem::UpdateParameterCollection()
+{
+	if (SurfaceParameterCollection.IsNull())
+	{
+		return;
+	}
+
+	const FLinearColor Mapping = GetAtlasMapping();
+	const FLinearColor Window = GetAtlasWindow();
+	if (Mapping == PublishedMapping && Window == PublishedWindow)
+	{
+		return;
+	}
+
+	UMaterialParameterCollection* Collection = SurfaceParameterCollection.LoadSynchronous();
+	UMaterialParameterCollectionInstance* Instance = Collection ? GetWorld()->GetParameterCollectionInstance(Collection) : nullptr;
+	if (!Instance)
+	{
+		return;
+	}
+
+	Instance->SetVectorParameterValue(AtlasMappingParameter, Mapping);
+	Instance->SetVectorParameterValue(AtlasWindowParameter, Window);
+	PublishedMapping = Mapping;
+	PublishedWindow = Window;
+}
@@ -0,0 +1,573 @@
+// Copyright 2026 Threaded Pixel Factory
+// Licensed under the Apache License, Version 2.0 (the "License");
+// SPDX-License-Identifier: Apache-2.0
+
+#include "Subsystems/SurfaceThermalSubsystem.h"
+#include "Subsystems/SurfaceQuerySubsystem.h"
+#include "Subsystems/BiomeSubsystem.h"
+#include "Subsystems/TimeSubsystem.h"
+#include "TPFCoreStats.h"
+#include "TPFTimingRecorder.h"
+#include "Engine/GameInstance.h"
+#include "Engine/World.h"
+#include "GameFramework/PlayerController.h"
+#include "Async/ParallelFor.h"
+#include "Async/TaskGraphInterfaces.h"
+#include "Math/VectorRegister.h"
+
+namespace
+{
+	constexpr float StefanBoltzmann = 5.670374e-8f; // W/(m^2*K^4)
+
+	/** Explicit 5-point diffusion is stable below 0.25; keep a margin */
+	constexpr float StableDiffusionNumber = 0.2f;
+
+	int32 CellDistance(const FWorldCellKey& A, const FWorldCellKey& B)
+	{
+		return FMath::Max(FMath::Abs(A.X - B.X), FMath::Abs(A.Y - B.Y));
+	}
+}
+
+//=============================================================================
+// FSurfaceThermalCell
+//=============================================================================
+
+void FSurfaceThermalCell::Init()
+{
+	Temperature.SetNumZeroed(PaddedAxis * PaddedAxis);
+	Scratch.SetNumZeroed(PaddedAxis * PaddedAxis);
+	Diffusivity.SetNumZeroed(TilesPerPlane);
+	LinearCooling.SetNumZeroed(TilesPerPlane);
+	RadiativeCooling.SetNumZeroed(TilesPerPlane);
+	MaxDiffusivity = 0.0f;
+}
+
+float FSurfaceThermalCell::GetStableStep() const
+{
+	return MaxDiffusivity > 0.0f ? StableDiffusionNumber / MaxDiffusivity : UE_BIG_NUMBER;
+}
+
+void FSurfaceThermalCell::Step(float DeltaSeconds, float AmbientK)
+{
+	static_assert(TilesPerAxis % 4 == 0, "Rows are processed four tiles at a time");
+
+	const VectorRegister4Float Dt = VectorSetFloat1(DeltaSeconds);
+	const VectorRegister4Float Four = VectorSetFloat1(4.0f);
+	const VectorRegister4Float One = VectorOne();
+	const VectorRegister4Float Ambient = VectorSetFloat1(AmbientK);
+	const VectorRegister4Float AmbientSq = VectorSetFloat1(AmbientK * AmbientK);
+
+	const float* In = Temperature.GetData();
+	float* Out = Scratch.GetData();
+
+	for (int32 Y = 0; Y < TilesPerAxis; Y++)
+	{
+		const float* Center = In + PaddedIndex(0, Y);
+		float* Dest = Out + PaddedIndex(0, Y);
+		const float* Alpha = Diffusivity.GetData() + Y * TilesPerAxis;
+		const float* Linear = LinearCooling.GetData() + Y * TilesPerAxis;
+		const float* Radiative = RadiativeCooling.GetData() + Y * TilesPerAxis;
+
+		for (int32 X = 0; X < TilesPerAxis; X += 4)
+		{
+			const VectorRegister4Float C = VectorLoad(Center + X);
+			const VectorRegister4Float Neighbours = VectorAdd(
+				VectorAdd(VectorLoad(Center + X - 1), VectorLoad(Center + X + 1)),
+				VectorAdd(VectorLoad(Center + X - PaddedAxis), VectorLoad(Center + X + PaddedAxis)));
+			const VectorRegister4Float Laplacian = VectorSubtract(Neighbours, VectorMultiply(Four, C));
+			const VectorRegister4Float Diffused = VectorMultiplyAdd(VectorMultiply(VectorLoad(Alpha + X), Dt), Laplacian, C);
+
+			// T^4 - Ta^4 = dT * (T^2 + Ta^2) * (T + Ta); dividing the deviation keeps it monotone for any step
+			const VectorRegister4Float T = VectorAdd(Diffused, Ambient);
+			const VectorRegister4Float RadiativeFactor = VectorMultiply(VectorMultiplyAdd(T, T, AmbientSq), VectorAdd(T, Ambient));
+			const VectorRegister4Float Rate = VectorMultiplyAdd(VectorLoad(Radiative + X), RadiativeFactor, VectorLoad(Linear + X));
+			VectorStore(VectorDivide(Diffused, VectorMultiplyAdd(Rate, Dt, One)), Dest + X);
+		}
+	}
+
+	// The halo was written to both planes, so swapping keeps it
+	Swap(Temperature, Scratch);
+}
+
+float FSurfaceThermalCell::GetTile(int32 TileIndex) const
+{
+	return Temperature[PaddedIndex(TileIndex % TilesPerAxis, TileIndex / TilesPerAxis)];
+}
+
+void FSurfaceThermalCell::SetTile(int32 TileIndex, float DeviationK)
+{
+	Temperature[PaddedIndex(TileIndex % TilesPerAxis, TileIndex / TilesPerAxis)] = DeviationK;
+}
+
+void FSurfaceThermalCell::CopyEdgeToHalo(FSurfaceThermalCell& Neighbour, int32 DirX, int32 DirY) const
+{
+	// The neighbour at +Dir sees our edge on its -Dir side
+	for (int32 i = 0; i < TilesPerAxis; i++)
+	{
+		int32 Source;
+		int32 Dest;
+		if (DirX != 0)
+		{
+			Source = PaddedIndex(DirX > 0 ? TilesPerAxis - 1 : 0, i);
+			Dest = PaddedIndex(DirX > 0 ? -1 : TilesPerAxis, i);
+		}
+		else
+		{
+			Source = PaddedIndex(i, DirY > 0 ? TilesPerAxis - 1 : 0);
+			Dest = PaddedIndex(i, DirY > 0 ? -1 : TilesPerAxis);
+		}
+		Neighbour.Temperature[Dest] = Temperature[Source];
+		Neighbour.Scratch[Dest] = Temperature[Source];
+	}
+}
+
+void FSurfaceThermalCell::MirrorHalo(int32 DirX, int32 DirY)
+{
+	for (int32 i = 0; i < TilesPerAxis; i++)
+	{
+		int32 Source;
+		int32 Dest;
+		if (DirX != 0)
+		{
+			Source = PaddedIndex(DirX > 0 ? TilesPerAxis - 1 : 0, i);
+			Dest = PaddedIndex(DirX > 0 ? TilesPerAxis : -1, i);
+		}
+		else
+		{
+			Source = PaddedIndex(i, DirY > 0 ? TilesPerAxis - 1 : 0);
+			Dest = PaddedIndex(i, DirY > 0 ? TilesPerAxis : -1);
+		}
+		Temperature[Dest] = Temperature[Source];
+		Scratch[Dest] = Temperature[Source];
+	}
+}
+
+void FSurfaceThermalCell::FillHaloCorners()
+{
+	const int32 Last = TilesPerAxis;
+	Temperature[PaddedIndex(-1, -1)] = Temperature[PaddedIndex(0, -1)];
+	Temperature[PaddedIndex(Last, -1)] = Temperature[PaddedIndex(Last - 1, -1)];
+	Temperature[PaddedIndex(-1, Last)] = Temperature[PaddedIndex(0, Last)];
+	Temperature[PaddedIndex(Last, Last)] = Temperature[PaddedIndex(Last - 1, Last)];
+	for (const int32 Corner : { PaddedIndex(-1, -1), PaddedIndex(Last, -1), PaddedIndex(-1, Last), PaddedIndex(Last, Last) })
+	{
+		Scratch[Corner] = Temperature[Corner];
+	}
+}
+
+float FSurfaceThermalCell::Sample(const FVector& AbsoluteLocation, const FWorldCellKey& CellKey, float CellSize) const
+{
+	const float EffectiveCellSize = CellSize * FMath::Pow(2.0f, static_cast<float>(CellKey.LOD));
+	const float InvTileSize = TilesPerAxis / EffectiveCellSize;
+
+	// Padded space: tile i sits at i + 1, the halo at 0 and PaddedAxis - 1
+	const float U = FMath::Clamp(static_cast<float>(AbsoluteLocation.X - CellKey.X * EffectiveCellSize) * InvTileSize + 0.5f, 0.0f, PaddedAxis - 1.0f);
+	const float V = FMath::Clamp(static_cast<float>(AbsoluteLocation.Y - CellKey.Y * EffectiveCellSize) * InvTileSize + 0.5f, 0.0f, PaddedAxis - 1.0f);
+
+	const int32 X0 = FMath::Min(static_cast<int32>(U), PaddedAxis - 2);
+	const int32 Y0 = FMath::Min(static_cast<int32>(V), PaddedAxis - 2);
+	const float FX = U - X0;
+	const float FY = V - Y0;
+
+	const float* Row0 = Temperature.GetData() + Y0 * PaddedAxis + X0;
+	const float* Row1 = Row0 + PaddedAxis;
+	return FMath::Lerp(FMath::Lerp(Row0[0], Row0[1], FX), FMath::Lerp(Row1[0], Row1[1], FX), FY);
+}
+
+//=============================================================================
+// USurfaceThermalSubsystem
+//=============================================================================
+
+bool USurfaceThermalSubsystem::ShouldCreateSubsystem(UObject* Outer) const
+{
+	if (const UWorld* World = Cast<UWorld>(Outer))
+	{
+		return World->IsGameWorld();
+	}
+	return false;
+}
+
+void USurfaceThermalSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	TPF_TIMING_SCOPE(TEXT("SurfaceThermalSubsystem::Initialize"));
+
+	Super::Initialize(Collection);
+
+	// Cells seed from the query subsystem's grids
+	Collection.InitializeDependency<USurfaceQuerySubsystem>();
+
+	SurfaceDeltasChangedHandle = IDeltaStore::OnSurfaceDeltasChanged().AddUObject(this, &USurfaceThermalSubsystem::HandleSurfaceDeltasChanged);
+}
+
+void USurfaceThermalSubsystem::Deinitialize()
+{
+	IDeltaStore::OnSurfaceDeltasChanged().Remove(SurfaceDeltasChangedHandle);
+	Cells.Empty();
+	PendingSeeds.Empty();
+	bHasView = false;
+
+	Super::Deinitialize();
+}
+
+void USurfaceThermalSubsystem::ResetSimulation()
+{
+	Cells.Empty();
+	PendingSeeds.Empty();
+	bHasView = false;
+}
+
+double USurfaceThermalSubsystem::GetSimTime() const
+{
+	const UWorld* World = GetWorld();
+	if (const UGameInstance* GI = World->GetGameInstance())
+	{
+		if (const UTimeSubsystem* Time = GI->GetSubsystem<UTimeSubsystem>())
+		{
+			return Time->GetSimTimeSeconds();
+		}
+	}
+	return World->GetTimeSeconds();
+}
+
+void USurfaceThermalSubsystem::HandleSurfaceDeltasChanged(const IDeltaStore* Store, const FWorldCellKey& CellKey, int32 TileIndex, const FSurfaceTileDelta* AppendedDelta)
+{
+	// Reloads and clears leave the live field alone; unseeded cells pick deltas up from the grid
+	if (!AppendedDelta || AppendedDelta->Channel != ESurfaceDeltaChannel::TemperatureDelta
+		|| TileIndex < 0 || TileIndex >= FSurfaceThermalCell::TilesPerPlane)
+	{
+		return;
+	}
+
+	// Cells seed from the surface query's store, so only its appends apply
+	const USurfaceQuerySubsystem* Surface = GetWorld()->GetSubsystem<USurfaceQuerySubsystem>();
+	if (!Store || !Surface || Store != Surface->GetDeltaStore())
+	{
+		return;
+	}
+
+	if (FSurfaceThermalCell* Cell = Cells.Find(CellKey))
+	{
+		Cell->SetTile(TileIndex, FMath::Max(AppendedDelta->ApplyTo(Cell->GetTile(TileIndex)), -AmbientTemperatureK));
+	}
+}
+
+void USurfaceThermalSubsystem::Tick(float DeltaTime)
+{
+	SCOPE_CYCLE_COUNTER(STAT_TPF_SurfaceThermalStep);
+
+	UWorld* World = GetWorld();
+	if (const APlayerController* PlayerController = World->GetFirstPlayerController())
+	{
+		FVector ViewLocation;
+		FRotator ViewRotation;
+		PlayerController->GetPlayerViewPoint(ViewLocation, ViewRotation);
+		ViewHeight = ViewLocation.Z;
+
+		// Cells are keyed by absolute position, like the surface deltas
+		const FWorldCellKey Center = FWorldCellKey::FromWorldLocation(ViewLocation + FVector(World->OriginLocation), DeltaCellSize);
+		if (!bHasView || Center != ViewCenter)
+		{
+			ViewCenter = Center;
+			bHasView = true;
+			UpdateCellSet(Center);
+		}
+	}
+
+	if (!bHasView)
+	{
+		return;
+	}
+
+	const double Now = GetSimTime();
+	const double BudgetEnd = FPlatformTime::Seconds() + TimeBudgetMs * 0.001;
+	bool bRanAny = false;
+
+	while (PendingSeeds.Num() > 0 && (!bRanAny || FPlatformTime::Seconds() < BudgetEnd))
+	{
+		const FWorldCellKey CellKey = PendingSeeds[0];
+		PendingSeeds.RemoveAt(0);
+
+		FSurfaceThermalCell& Cell = Cells.Add(CellKey);
+		SeedCell(CellKey, Cell, Now);
+		Cell.bActive = CellDistance(CellKey, ViewCenter) <= ActiveRadiusCells;
+		bRanAny = true;
+	}
+
+	struct FDueCell
+	{
+		FWorldCellKey CellKey;
+		FSurfaceThermalCell* Cell;
+		double Overdue;
+	};
+
+	TArray<FDueCell> Due;
+	Due.Reserve(Cells.Num());
+	for (TPair<FWorldCellKey, FSurfaceThermalCell>& Pair : Cells)
+	{
+		FSurfaceThermalCell& Cell = Pair.Value;
+		const double Elapsed = Now - Cell.SimulatedTime;
+		if (Elapsed < 0.0)
+		{
+			// Sim time went backwards; the field doesn't rewind
+			Cell.SimulatedTime = Now;
+			continue;
+		}
+
+		const double Interval = Cell.bActive ? 0.0 : DistantStepIntervalSeconds;
+		if (Elapsed > 0.0 && Elapsed >= Interval)
+		{
+			Due.Add({ Pair.Key, &Cell, Elapsed - Interval });
+		}
+	}
+
+	// Active cells first, then whoever has waited longest
+	Due.Sort([](const FDueCell& A, const FDueCell& B)
+	{
+		if (A.Cell->bActive != B.Cell->bActive)
+		{
+			return A.Cell->bActive;
+		}
+		return A.Overdue > B.Overdue;
+	});
+
+	const int32 BatchSize = FMath::Max(1, FTaskGraphInterface::Get().GetNumWorkerThreads());
+	const float TimeScale = ThermalTimeScale;
+	const float AmbientK = AmbientTemperatureK;
+	const int32 StepLimit = MaxSubsteps;
+
+	for (int32 First = 0; First < Due.Num() && (!bRanAny || FPlatformTime::Seconds() < BudgetEnd); First += BatchSize)
+	{
+		const int32 Count = FMath::Min(BatchSize, Due.Num() - First);
+
+		// Halos are copied before any cell of the batch steps, so tasks touch only their own cell
+		for (int32 i = 0; i < Count; i++)
+		{
+			GatherHalo(Due[First + i].CellKey, *Due[First + i].Cell);
+		}
+
+		ParallelFor(Count, [&Due, First, Now, TimeScale, AmbientK, StepLimit](int32 i)
+		{
+			FSurfaceThermalCell& Cell = *Due[First + i].Cell;
+			const float ThermalSeconds = static_cast<float>(Now - Cell.SimulatedTime) * TimeScale;
+			Cell.SimulatedTime = Now;
+			if (ThermalSeconds <= 0.0f)
+			{
+				return;
+			}
+
+			// Gaps longer than StepLimit stable steps are dropped rather than integrated unstably
+			const float StableStep = Cell.GetStableStep();
+			const int32 Substeps = FMath::Max(1, FMath::CeilToInt(FMath::Min(ThermalSeconds / StableStep, static_cast<float>(StepLimit))));
+			const float StepSeconds = FMath::Min(ThermalSeconds / Substeps, StableStep);
+			for (int32 Substep = 0; Substep < Substeps; Substep++)
+			{
+				Cell.Step(StepSeconds, AmbientK);
+			}
+		}, Count <= 1 ? EParallelForFlags::ForceSingleThread : EParallelForFlags::None);
+
+		INC_DWORD_STAT_BY(STAT_TPF_ThermalCellsStepped, Count);
+		bRanAny = true;
+	}
+
+	// Sample reads the halo, so refresh it for every cell that stepped or gained a neighbour
+	for (FDueCell& Entry : Due)
+	{
+		GatherHalo(Entry.CellKey, *Entry.Cell);
+	}
+}
+
+void USurfaceThermalSubsystem::UpdateCellSet(const FWorldCellKey& Center)
+{
+	// Hysteresis: keep cells one ring past the simulation radius
+	const int32 DropDistance = SimulationRadiusCells + 1;
+	for (auto It = Cells.CreateIterator(); It; ++It)
+	{
+		const int32 Distance = CellDistance(It->Key, Center);
+		if (Distance > DropDistance || It->Key.LOD != Center.LOD)
+		{
+			WriteBackCell(It->Key, It->Value);
+			It.RemoveCurrent();
+			continue;
+		}
+		It->Value.bActive = Distance <= ActiveRadiusCells;
+	}
+	PendingSeeds.RemoveAll([&](const FWorldCellKey& CellKey) { return CellDistance(CellKey, Center) > DropDistance; });
+
+	for (int32 Y = Center.Y - SimulationRadiusCells; Y <= Center.Y + SimulationRadiusCells; Y++)
+	{
+		for (int32 X = Center.X - SimulationRadiusCells; X <= Center.X + SimulationRadiusCells; X++)
+		{
+			const FWorldCellKey CellKey(X, Y, Center.LOD);
+			if (!Cells.Contains(CellKey) && !PendingSeeds.Contains(CellKey))
+			{
+				PendingSeeds.Add(CellKey);
+			}
+		}
+	}
+
+	PendingSeeds.StableSort([&](const FWorldCellKey& A, const FWorldCellKey& B)
+	{
+		return CellDistance(A, Center) < CellDistance(B, Center);
+	});
+}
+
+void USurfaceThermalSubsystem::SeedCell(const FWorldCellKey& CellKey, FSurfaceThermalCell& Cell, double Now) const
+{
+	const UWorld* World = GetWorld();
+	const USurfaceQuerySubsystem* Surface = World->GetSubsystem<USurfaceQuerySubsystem>();
+	const UBiomeSubsystem* Biomes = World->GetSubsystem<UBiomeSubsystem>();
+
+	Cell.Init();
+	Cell.SimulatedTime = Now;
+
+	constexpr int32 TilesPerAxis = FSurfaceThermalCell::TilesPerAxis;
+	const float EffectiveCellSize = DeltaCellSize * FMath::Pow(2.0f, static_cast<float>(CellKey.LOD));
+	const int32 Samples = FMath::Clamp(MaterialSampleResolution, 1, TilesPerAxis);
+
+	// Thermal properties per biome sample; the fallback spec where nothing resolves
+	TArray<const FRuntimeSurfaceSpec*> SampleSpecs;
+	SampleSpecs.Init(&USurfaceQuerySubsystem::GetFallbackSpec(), Samples * Samples);
+	if (Surface && Biomes)
+	{
+		// Biomes are queried in world space
+		const FVector Origin(World->OriginLocation);
+		const double Spacing = EffectiveCellSize / Samples;
+		TArray<FVector> Locations;
+		Locations.Reserve(Samples * Samples);
+		for (int32 Y = 0; Y < Samples; Y++)
+		{
+			for (int32 X = 0; X < Samples; X++)
+			{
+				Locations.Emplace(
+					CellKey.X * EffectiveCellSize + (X + 0.5) * Spacing - Origin.X,
+					CellKey.Y * EffectiveCellSize + (Y + 0.5) * Spacing - Origin.Y,
+					ViewHeight);
+			}
+		}
+
+		FBiomeBatchResult Result;
+		Biomes->GetBiomesAtLocations(Locations, Result);
+		for (int32 i = 0; i < Result.Num(); i++)
+		{
+			if (Result.SurfaceSpecIds[i].IsValid())
+			{
+				SampleSpecs[i] = &Surface->ResolveSurfaceSpecRef(Result.SurfaceSpecIds[i]);
+			}
+		}
+	}
+
+	const float TileSizeM = EffectiveCellSize / TilesPerAxis * 0.01f;
+	const float LayerDepthM = LayerDepthCm * 0.01f;
+	for (int32 TileIndex = 0; TileIndex < FSurfaceThermalCell::TilesPerPlane; TileIndex++)
+	{
+		const int32 SampleX = (TileIndex % TilesPerAxis) * Samples / TilesPerAxis;
+		const int32 SampleY = (TileIndex / TilesPerAxis) * Samples / TilesPerAxis;
+		const FRuntimeSurfaceSpec& Spec = *SampleSpecs[SampleY * Samples + SampleX];
+
+		const float VolumetricHeat = LayerDensityKgM3 * FMath::Max(Spec.HeatCapacityJkgK, 1.0f); // J/(m^3*K)
+		const float ArealHeat = VolumetricHeat * LayerDepthM; // J/(m^2*K)
+
+		Cell.Diffusivity[TileIndex] = FMath::Max(Spec.ThermalConductivityWmK, 0.0f) / VolumetricHeat / (TileSizeM * TileSizeM);
+		Cell.LinearCooling[TileIndex] = ConvectiveCoefficientWm2K / ArealHeat;
+		Cell.RadiativeCooling[TileIndex] = FMath::Clamp(Spec.Emissivity01, 0.0f, 1.0f) * StefanBoltzmann / ArealHeat;
+		Cell.MaxDiffusivity = FMath::Max(Cell.MaxDiffusivity, Cell.Diffusivity[TileIndex]);
+	}
+
+	// Start from the deltas recorded so far
+	const FSurfaceChannelGrid* Grid = Surface ? Surface->GetSurfaceGrid(CellKey) : nullptr;
+	if (Grid && Grid->HasChannel(ESurfaceDeltaChannel::TemperatureDelta))
+	{
+		for (int32 TileIndex = 0; TileIndex < FSurfaceThermalCell::TilesPerPlane; TileIndex++)
+		{
+			const float Deviation = Grid->GetTileValue(ESurfaceDeltaChannel::TemperatureDelta, TileIndex);
+			Cell.SetTile(TileIndex, FMath::Max(Deviation, -AmbientTemperatureK));
+		}
+	}
+
+	GatherHalo(CellKey, Cell);
+}
+
+void USurfaceThermalSubsystem::WriteBackCell(const FWorldCellKey& CellKey, const FSurfaceThermalCell& Cell) const
+{
+	const USurfaceQuerySubsystem* Surface = GetWorld()->GetSubsystem<USurfaceQuerySubsystem>();
+	IDeltaStore* Store = Surface ? Cast<IDeltaStore>(Surface->GetDeltaStoreObject()) : nullptr;
+	if (!Store)
+	{
+		return;
+	}
+
+	constexpr int32 TilesPerAxis = FSurfaceThermalCell::TilesPerAxis;
+	const float EffectiveCellSize = DeltaCellSize * FMath::Pow(2.0f, static_cast<float>(CellKey.LOD));
+	const float TileSize = EffectiveCellSize / TilesPerAxis;
+	const double Now = GetSimTime();
+
+	// Collected first: appending invalidates the grid
+	TArray<FSurfaceTileDelta> Writes;
+	const FSurfaceChannelGrid* Grid = Surface->GetSurfaceGrid(CellKey);
+	for (int32 TileIndex = 0; TileIndex < FSurfaceThermalCell::TilesPerPlane; TileIndex++)
+	{
+		const float Live = Cell.GetTile(TileIndex);
+		const float Recorded = Grid ? Grid->GetTileValue(ESurfaceDeltaChannel::TemperatureDelta, TileIndex) : 0.0f;
+		if (FMath::Abs(Live - Recorded) <= WritebackThresholdK)
+		{
+			continue;
+		}
+
+		FSurfaceTileDelta& Delta = Writes.AddDefaulted_GetRef();
+		Delta.CellKey = CellKey;
+		Delta.TileIndex = TileIndex;
+		Delta.WorldLocation = FVector(
+			CellKey.X * EffectiveCellSize + (TileIndex % TilesPerAxis + 0.5f) * TileSize,
+			CellKey.Y * EffectiveCellSize + (TileIndex / TilesPerAxis + 0.5f) * TileSize,
+			0.0);
+		Delta.Radius = TileSize * 0.5f;
+		Delta.Channel = ESurfaceDeltaChannel::TemperatureDelta;
+		Delta.Operation = ESurfaceDeltaOperation::Set;
+		Delta.Value = Live;
+		Delta.Timestamp = Now;
+	}
+
+	for (const FSurfaceTileDelta& Delta : Writes)
+	{
+		Store->AppendSurfaceDelta(Delta);
+	}
+}
+
+void USurfaceThermalSubsystem::GatherHalo(const FWorldCellKey& CellKey, FSurfaceThermalCell& Cell) const
+{
+	static const FIntPoint Directions[] = { { 1, 0 }, { -1, 0 }, { 0, 1 }, { 0, -1 } };
+	for (const FIntPoint& Dir : Directions)
+	{
+		const FWorldCellKey NeighbourKey(CellKey.X + Dir.X, CellKey.Y + Dir.Y, CellKey.LOD);
+		if (const FSurfaceThermalCell* Neighbour = Cells.Find(NeighbourKey))
+		{
+			Neighbour->CopyEdgeToHalo(Cell, -Dir.X, -Dir.Y);
+		}
+		else
+		{
+			Cell.MirrorHalo(Dir.X, Dir.Y);
+		}
+	}
+	Cell.FillHaloCorners();
+}
+
+bool USurfaceThermalSubsystem::SampleTemperatureDeviation(const FVector& AbsoluteLocation, float& OutDeviationK) const
+{
+	const FWorldCellKey CellKey = FWorldCellKey::FromWorldLocation(AbsoluteLocation, DeltaCellSize);
+	const FSurfaceThermalCell* Cell = Cells.Find(CellKey);
+	if (!Cell)
+	{
+		return false;
+	}
+
+	OutDeviationK = Cell->Sample(AbsoluteLocation, CellKey, DeltaCellSize);
+	return true;
+}
+
+float USurfaceThermalSubsystem::GetSimulatedTemperatureAtLocation(const FVector& WorldLocation) const
+{
+	const FVector AbsoluteLocation = WorldLocation + FVector(GetWorld()->OriginLocation);
+	float Deviation = 0.0f;
+	SampleTemperatureDeviation(AbsoluteLocation, Deviation);
+	return AmbientTemperatureK + Deviation;
+}
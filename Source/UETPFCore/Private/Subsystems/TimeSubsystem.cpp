@@ -5,21 +5,35 @@
 #include "Subsystems/TimeSubsystem.h"
 #include "Engine/World.h"
 #include "Misc/ScopeLock.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+#include "TPFTimingRecorder.h"
 
 void UTimeSubsystem::Initialize(FSubsystemCollectionBase& Collection)
 {
+	TPF_TIMING_SCOPE(TEXT("TimeSubsystem::Initialize"));
+
 	Super::Initialize(Collection);
 	ClampAndValidate();
 }
 
 void UTimeSubsystem::Deinitialize()
 {
+	Subscriptions.Empty();
+	RewindStates.Empty();
+	ClearRewindKeyframes();
+	OnSimClockChanged.Clear();
+	OnSimTimeRewound.Clear();
 	Super::Deinitialize();
 }
 
 void UTimeSubsystem::SetPaused(bool bInPaused)
 {
-	bPaused = bInPaused;
+	if (bPaused != bInPaused)
+	{
+		bPaused = bInPaused;
+		OnSimClockChanged.Broadcast();
+	}
 }
 
 void UTimeSubsystem::SetTimeScale(double InTimeScale)
@@ -28,16 +42,23 @@ void UTimeSubsystem::SetTimeScale(double InTimeScale)
 	{
 		InTimeScale = FMath::Max(0.0, InTimeScale);
 	}
+	const double PreviousTimeScale = TimeScale;
 	TimeScale = InTimeScale;
 	ClampAndValidate();
+
+	if (TimeScale != PreviousTimeScale)
+	{
+		OnSimClockChanged.Broadcast();
+	}
 }
 
 void UTimeSubsystem::SetAllowNegativeTimeScale(bool bAllow)
 {
 	bAllowNegativeTimeScale = bAllow;
-	if (!bAllowNegativeTimeScale)
+	if (!bAllowNegativeTimeScale && TimeScale < 0.0)
 	{
-		TimeScale = FMath::Max(0.0, TimeScale);
+		TimeScale = 0.0;
+		OnSimClockChanged.Broadcast();
 	}
 }
 
@@ -45,6 +66,7 @@ void UTimeSubsystem::SetClockMode(ESimClockMode InMode)
 {
 	ClockMode = InMode;
 	Accumulator = 0.0;
+	OnSimClockChanged.Broadcast();
 }
 
 void UTimeSubsystem::SetFixedStepSeconds(double InFixedStepSeconds)
@@ -52,6 +74,121 @@ void UTimeSubsystem::SetFixedStepSeconds(double InFixedStepSeconds)
 	FixedStepSeconds = FMath::Clamp(InFixedStepSeconds, 1.0 / 240.0, 1.0); // 240Hz..1Hz sync guard
 }
 
+void UTimeSubsystem::SetMaxFixedStepsPerAdvance(int32 InMaxSteps)
+{
+	MaxFixedStepsPerAdvance = FMath::Max(1, InMaxSteps);
+}
+
+void UTimeSubsystem::SetBroadcastEachFixedStep(bool bEnable)
+{
+	bBroadcastEachFixedStep = bEnable;
+}
+
+void UTimeSubsystem::SetRewindKeyframesEnabled(bool bEnable)
+{
+	bRewindKeyframes = bEnable;
+	if (!bRewindKeyframes)
+	{
+		ClearRewindKeyframes();
+	}
+}
+
+void UTimeSubsystem::SetRewindKeyframeInterval(double InSimSeconds)
+{
+	RewindKeyframeIntervalSeconds = FMath::Max(InSimSeconds, 1.0 / 240.0);
+}
+
+void UTimeSubsystem::SetMaxRewindKeyframes(int32 InMaxKeyframes)
+{
+	MaxRewindKeyframes = FMath::Max(1, InMaxKeyframes);
+	ClearRewindKeyframes();
+}
+
+double UTimeSubsystem::GetEarliestRewindSimTime() const
+{
+	return NumRewindKeyframes > 0 ? GetRewindKeyframe(0).SimTimeSeconds : SimTimeSeconds;
+}
+
+FDelegateHandle UTimeSubsystem::RegisterRewindState(FName Name, FOnSerializeRewindState Delegate)
+{
+	if (!Delegate.IsBound() || RewindStates.ContainsByPredicate([Name](const FRewindState& State) { return State.Name == Name; }))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("TimeSubsystem: Rewind state '%s' is unbound or already registered"), *Name.ToString());
+		return FDelegateHandle();
+	}
+
+	FRewindState& State = RewindStates.AddDefaulted_GetRef();
+	State.Name = Name;
+	State.Delegate = MoveTemp(Delegate);
+	return State.Delegate.GetHandle();
+}
+
+void UTimeSubsystem::UnregisterRewindState(FDelegateHandle Handle)
+{
+	RewindStates.RemoveAll([Handle](const FRewindState& State)
+	{
+		return State.Delegate.GetHandle() == Handle;
+	});
+}
+
+bool UTimeSubsystem::ScrubToSimTime(double TargetSimTimeSeconds)
+{
+	// A scrub is a rewind; forward jumps would skip the steps in between
+	if (!bAllowNegativeTimeScale || TargetSimTimeSeconds > SimTimeSeconds)
+	{
+		UE_LOG(LogTemp, Verbose, TEXT("TimeSubsystem: Ignoring scrub to %.3f (rewind %s, now %.3f)"),
+			TargetSimTimeSeconds, bAllowNegativeTimeScale ? TEXT("allowed") : TEXT("not allowed"), SimTimeSeconds);
+		return false;
+	}
+
+	// The keyframe ring bounds how far back a scrub reaches
+	if (FindRewindKeyframe(TargetSimTimeSeconds) == INDEX_NONE)
+	{
+		return false;
+	}
+
+	LastStepSeconds = TargetSimTimeSeconds - SimTimeSeconds;
+	Accumulator = 0.0;
+
+	// A scrub is one jump, never steps; the keyframe is only worth its replay when it restores state
+	const int32 Keyframe = ChooseRewindKeyframe(TargetSimTimeSeconds, MAX_int32);
+	if (Keyframe != INDEX_NONE)
+	{
+		RewindToKeyframe(Keyframe, TargetSimTimeSeconds);
+	}
+	else
+	{
+		SimTimeSeconds = TargetSimTimeSeconds;
+	}
+	DispatchAdvance(0.0, 1);
+
+	// Discontinuous jump: anything anchored on (time, rate) must re-anchor
+	OnSimClockChanged.Broadcast();
+	return true;
+}
+
+FDelegateHandle UTimeSubsystem::SubscribeSimTime(float RateHz, FOnSimTimeInterval Delegate)
+{
+	if (!Delegate.IsBound())
+	{
+		return FDelegateHandle();
+	}
+
+	FSimTimeSubscription& Subscription = Subscriptions.AddDefaulted_GetRef();
+	Subscription.Delegate = MoveTemp(Delegate);
+	Subscription.IntervalSeconds = RateHz > 0.0f ? 1.0 / RateHz : 0.0;
+	Subscription.LastSimTimeSeconds = SimTimeSeconds;
+	return Subscription.Delegate.GetHandle();
+}
+
+void UTimeSubsystem::UnsubscribeSimTime(FDelegateHandle Handle)
+{
+	Subscriptions.RemoveAll([Handle](const FSimTimeSubscription& Subscription)
+	{
+		return Subscription.Delegate.GetHandle() == Handle;
+	});
+}
+
 void UTimeSubsystem::ClampAndValidate()
 {
 	// Keep sane bounds; you can widen later.
@@ -76,36 +213,253 @@ void UTimeSubsystem::Advance(double RealDeltaSeconds)
 	// Scaled simulation delta
 	const double ScaledDelta = RealDeltaSeconds * TimeScale;
 
+	const double PreviousSimTime = SimTimeSeconds;
+
 	if (ClockMode == ESimClockMode::RealTime)
 	{
-		SimTimeSeconds += ScaledDelta;
+		const double NewSimTime = SimTimeSeconds + ScaledDelta;
+		const int32 Keyframe = ScaledDelta < 0.0 ? ChooseRewindKeyframe(NewSimTime, 1) : INDEX_NONE;
+		if (Keyframe != INDEX_NONE)
+		{
+			RewindToKeyframe(Keyframe, NewSimTime);
+		}
+		else
+		{
+			SimTimeSeconds = NewSimTime;
+		}
 		LastStepSeconds = ScaledDelta;
-		OnSimTimeAdvanced.Broadcast(SimTimeSeconds);
+		DispatchAdvance(RealDeltaSeconds, 1);
+		RecordRewindKeyframe(PreviousSimTime);
 		return;
 	}
 
-	// Fixed-step deterministic advancement:
+	// Fixed-step deterministic advancement. Whole steps are taken arithmetically;
+	// negative accumulators step backwards (rewind) when allowed.
 	Accumulator += ScaledDelta;
 
-	// Handle negative time scale (rewind) if allowed:
-	if (Accumulator >= 0.0)
+	const double Direction = Accumulator >= 0.0 ? 1.0 : -1.0;
+	const double AvailableSteps = FMath::FloorToDouble(FMath::Abs(Accumulator) / FixedStepSeconds);
+	const int32 NumSteps = int32(FMath::Min(AvailableSteps, double(MaxFixedStepsPerAdvance)));
+
+	if (AvailableSteps > NumSteps)
 	{
-		while (Accumulator >= FixedStepSeconds)
+		// Over the catch-up cap: drop the excess whole steps, keep the fraction
+		UE_LOG(LogTemp, Verbose, TEXT("TimeSubsystem: Dropped %.0f fixed steps over the per-frame cap"), AvailableSteps - NumSteps);
+		Accumulator = Direction * FMath::Fmod(FMath::Abs(Accumulator), FixedStepSeconds) + Direction * NumSteps * FixedStepSeconds;
+	}
+
+	if (NumSteps == 0)
+	{
+		return;
+	}
+
+	LastStepSeconds = Direction * FixedStepSeconds;
+
+	// Repeated addition keeps results bit-identical to stepping one at a time
+	double NewSimTime = SimTimeSeconds;
+	for (int32 Step = 0; Step < NumSteps; Step++)
+	{
+		NewSimTime += LastStepSeconds;
+	}
+
+	// Rewinding onto a keyframe replays forward from it instead of stepping back, when that is cheaper
+	const int32 Keyframe = Direction < 0.0 ? ChooseRewindKeyframe(NewSimTime, NumSteps) : INDEX_NONE;
+	if (Keyframe != INDEX_NONE)
+	{
+		RewindToKeyframe(Keyframe, NewSimTime);
+		Accumulator -= NumSteps * LastStepSeconds;
+	}
+	else if (bBroadcastEachFixedStep)
+	{
+		for (int32 Step = 0; Step < NumSteps; Step++)
 		{
-			SimTimeSeconds += FixedStepSeconds;
-			Accumulator -= FixedStepSeconds;
-			LastStepSeconds = FixedStepSeconds;
+			SimTimeSeconds += LastStepSeconds;
+			Accumulator -= LastStepSeconds;
 			OnSimTimeAdvanced.Broadcast(SimTimeSeconds);
 		}
 	}
 	else
 	{
-		while (Accumulator <= -FixedStepSeconds)
+		SimTimeSeconds = NewSimTime;
+		Accumulator -= NumSteps * LastStepSeconds;
+	}
+
+	DispatchAdvance(RealDeltaSeconds, NumSteps);
+	RecordRewindKeyframe(PreviousSimTime);
+}
+
+void UTimeSubsystem::DispatchAdvance(double RealDeltaSeconds, int32 NumSteps)
+{
+	if (!bBroadcastEachFixedStep || ClockMode == ESimClockMode::RealTime)
+	{
+		OnSimTimeAdvanced.Broadcast(SimTimeSeconds);
+	}
+	OnSimTimeStepped.Broadcast(SimTimeSeconds, NumSteps);
+
+	// Index loop: a callback may subscribe or unsubscribe
+	for (int32 i = 0; i < Subscriptions.Num(); i++)
+	{
+		FSimTimeSubscription& Subscription = Subscriptions[i];
+		Subscription.RealSecondsSinceCall += RealDeltaSeconds;
+		if (Subscription.RealSecondsSinceCall < Subscription.IntervalSeconds)
+		{
+			continue;
+		}
+
+		const double Elapsed = SimTimeSeconds - Subscription.LastSimTimeSeconds;
+		Subscription.RealSecondsSinceCall = 0.0;
+		Subscription.LastSimTimeSeconds = SimTimeSeconds;
+
+		// Copy: the callback may reallocate Subscriptions
+		const FOnSimTimeInterval Delegate = Subscription.Delegate;
+		Delegate.ExecuteIfBound(SimTimeSeconds, Elapsed);
+	}
+}
+
+int32 UTimeSubsystem::FindRewindKeyframe(double InSimTimeSeconds) const
+{
+	if (!bRewindKeyframes)
+	{
+		return INDEX_NONE;
+	}
+
+	for (int32 Age = NumRewindKeyframes - 1; Age >= 0; --Age)
+	{
+		if (GetRewindKeyframe(Age).SimTimeSeconds <= InSimTimeSeconds)
+		{
+			return Age;
+		}
+	}
+	return INDEX_NONE;
+}
+
+int32 UTimeSubsystem::ChooseRewindKeyframe(double TargetSimTimeSeconds, int32 StepBackSteps) const
+{
+	const int32 Age = FindRewindKeyframe(TargetSimTimeSeconds);
+	if (Age == INDEX_NONE)
+	{
+		return INDEX_NONE;
+	}
+
+	// Restoring just the clock gains nothing over stepping back: time-derived state recomputes either way
+	const FRewindKeyframe& Keyframe = GetRewindKeyframe(Age);
+	const bool bRestoresState = Keyframe.States.ContainsByPredicate([this](const TPair<FName, TArray<uint8>>& State)
+	{
+		return RewindStates.ContainsByPredicate([&State](const FRewindState& Registered) { return Registered.Name == State.Key; });
+	});
+	if (!bRestoresState)
+	{
+		return INDEX_NONE;
+	}
+
+	// Broadcasts each way: per-step listeners see every replayed step (as capped in RewindToKeyframe)
+	// or every step back; otherwise both are a single dispatch
+	if (ClockMode == ESimClockMode::FixedStep && bBroadcastEachFixedStep)
+	{
+		const int32 NumReplaySteps = FMath::RoundToInt((TargetSimTimeSeconds - Keyframe.SimTimeSeconds) / FixedStepSeconds);
+		if (FMath::Min(NumReplaySteps, MaxFixedStepsPerAdvance) > StepBackSteps)
+		{
+			return INDEX_NONE;
+		}
+	}
+	return Age;
+}
+
+void UTimeSubsystem::RewindToKeyframe(int32 Age, double TargetSimTimeSeconds)
+{
+	const FRewindKeyframe& Keyframe = GetRewindKeyframe(Age);
+	SimTimeSeconds = Keyframe.SimTimeSeconds;
+
+	// States registered after the keyframe was taken keep their current values
+	for (const TPair<FName, TArray<uint8>>& State : Keyframe.States)
+	{
+		const FRewindState* Registered = RewindStates.FindByPredicate([&State](const FRewindState& Candidate) { return Candidate.Name == State.Key; });
+		if (Registered)
 		{
-			SimTimeSeconds -= FixedStepSeconds;
-			Accumulator += FixedStepSeconds;
-			LastStepSeconds = -FixedStepSeconds;
+			FMemoryReader Reader(State.Value);
+			Registered->Delegate.ExecuteIfBound(Reader);
+		}
+	}
+	OnSimTimeRewound.Broadcast(SimTimeSeconds);
+
+	// Per-step listeners integrate the replayed steps; the last lands exactly on the target
+	if (ClockMode == ESimClockMode::FixedStep && bBroadcastEachFixedStep)
+	{
+		const int32 NumReplaySteps = FMath::RoundToInt((TargetSimTimeSeconds - SimTimeSeconds) / FixedStepSeconds);
+		const int32 NumSkipped = FMath::Max(0, NumReplaySteps - MaxFixedStepsPerAdvance);
+		if (NumSkipped > 0)
+		{
+			UE_LOG(LogTemp, Verbose, TEXT("TimeSubsystem: Dropped %d replay steps over the per-frame cap"), NumSkipped);
+		}
+
+		SimTimeSeconds += NumSkipped * FixedStepSeconds;
+		for (int32 Step = NumSkipped + 1; Step < NumReplaySteps; Step++)
+		{
+			SimTimeSeconds += FixedStepSeconds;
 			OnSimTimeAdvanced.Broadcast(SimTimeSeconds);
 		}
+		SimTimeSeconds = TargetSimTimeSeconds;
+		OnSimTimeAdvanced.Broadcast(SimTimeSeconds);
+	}
+	else
+	{
+		SimTimeSeconds = TargetSimTimeSeconds;
+	}
+}
+
+void UTimeSubsystem::RecordRewindKeyframe(double PreviousSimTimeSeconds)
+{
+	if (!bRewindKeyframes || SimTimeSeconds <= PreviousSimTimeSeconds)
+	{
+		return;
+	}
+
+	// Moving forward from a rewound time starts a new timeline; later keyframes no longer apply
+	while (NumRewindKeyframes > 0 && GetRewindKeyframe(NumRewindKeyframes - 1).SimTimeSeconds > PreviousSimTimeSeconds)
+	{
+		--NumRewindKeyframes;
+	}
+
+	if (NumRewindKeyframes > 0 && SimTimeSeconds - GetRewindKeyframe(NumRewindKeyframes - 1).SimTimeSeconds < RewindKeyframeIntervalSeconds)
+	{
+		return;
+	}
+
+	if (RewindKeyframes.Num() != MaxRewindKeyframes)
+	{
+		RewindKeyframes.SetNum(MaxRewindKeyframes);
+	}
+
+	int32 Slot;
+	if (NumRewindKeyframes < MaxRewindKeyframes)
+	{
+		Slot = (RewindHead + NumRewindKeyframes) % MaxRewindKeyframes;
+		++NumRewindKeyframes;
 	}
+	else
+	{
+		// Full: overwrite the oldest
+		Slot = RewindHead;
+		RewindHead = (RewindHead + 1) % MaxRewindKeyframes;
+	}
+
+	FRewindKeyframe& Keyframe = RewindKeyframes[Slot];
+	Keyframe.SimTimeSeconds = SimTimeSeconds;
+	Keyframe.States.SetNum(RewindStates.Num());
+	for (int32 i = 0; i < RewindStates.Num(); i++)
+	{
+		TPair<FName, TArray<uint8>>& State = Keyframe.States[i];
+		State.Key = RewindStates[i].Name;
+		State.Value.Reset();
+
+		FMemoryWriter Writer(State.Value);
+		RewindStates[i].Delegate.ExecuteIfBound(Writer);
+	}
+}
+
+void UTimeSubsystem::ClearRewindKeyframes()
+{
+	RewindKeyframes.Empty();
+	RewindHead = 0;
+	NumRewindKeyframes = 0;
 }
@@ -0,0 +1,476 @@
+// Copyright 2026 Threaded Pixel Factory
+// Licensed under the Apache License, Version 2.0 (the "License");
+// SPDX-License-Identifier: Apache-2.0
+
+#include "Subsystems/WeatherFieldSubsystem.h"
+#include "Subsystems/TimeSubsystem.h"
+#include "TPFCoreStats.h"
+#include "TPFTimingRecorder.h"
+#include "Engine/GameInstance.h"
+#include "Engine/World.h"
+#include "GameFramework/PlayerController.h"
+
+namespace
+{
+	FVector2f GetWindVelocity(const FRuntimeWeatherState& Weather)
+	{
+		return FVector2f(FVector2D(Weather.WindDir).GetSafeNormal() * Weather.WindSpeed);
+	}
+
+	/** Fraction of the way to the target after DeltaSeconds with time constant Tau (0 = never) */
+	float ExponentialBlend(float DeltaSeconds, float Tau)
+	{
+		return Tau > 0.0f ? 1.0f - FMath::Exp(-DeltaSeconds / Tau) : 0.0f;
+	}
+}
+
+//=============================================================================
+// GRID
+//=============================================================================
+
+void FWeatherFieldGrid::Init(const FWorldCellKey& InOrigin, int32 InSize, float InCellSize, const FRuntimeWeatherState& Weather)
+{
+	Origin = InOrigin;
+	Size = InSize;
+	CellSize = InCellSize;
+
+	const int32 Count = Num();
+	const FVector2f Wind = GetWindVelocity(Weather);
+	CloudCover.Init(FMath::Clamp(Weather.CloudCover01, 0.0f, 1.0f), Count);
+	Fog.Init(FMath::Clamp(Weather.Fog01, 0.0f, 1.0f), Count);
+	Precip.Init(FMath::Clamp(Weather.Precip01, 0.0f, 1.0f), Count);
+	Storm.Init(FMath::Clamp(Weather.Storm01, 0.0f, 1.0f), Count);
+	Humidity.Init(FMath::Clamp(Weather.Humidity01, 0.0f, 1.0f), Count);
+	WindX.Init(Wind.X, Count);
+	WindY.Init(Wind.Y, Count);
+	GroundWetness.Init(0.0f, Count);
+}
+
+FVector2D FWeatherFieldGrid::ToGrid(const FVector& AbsoluteLocation) const
+{
+	return FVector2D(
+		AbsoluteLocation.X / CellSize - Origin.X - 0.5,
+		AbsoluteLocation.Y / CellSize - Origin.Y - 0.5);
+}
+
+float FWeatherFieldGrid::SamplePlane(const TArray<float>& Plane, float OutsideValue, double GridX, double GridY) const
+{
+	const int32 X0 = FMath::FloorToInt32(GridX);
+	const int32 Y0 = FMath::FloorToInt32(GridY);
+	const float FracX = static_cast<float>(GridX - X0);
+	const float FracY = static_cast<float>(GridY - Y0);
+
+	// Taps beyond the window read the outside value, so the field fades into it at the edge
+	const auto Tap = [this, &Plane, OutsideValue](int32 X, int32 Y)
+	{
+		return X >= 0 && Y >= 0 && X < Size && Y < Size ? Plane[Y * Size + X] : OutsideValue;
+	};
+
+	const float Bottom = FMath::Lerp(Tap(X0, Y0), Tap(X0 + 1, Y0), FracX);
+	const float Top = FMath::Lerp(Tap(X0, Y0 + 1), Tap(X0 + 1, Y0 + 1), FracX);
+	return FMath::Lerp(Bottom, Top, FracY);
+}
+
+FRuntimeWeatherState FWeatherFieldGrid::Sample(const FVector& AbsoluteLocation, const FRuntimeWeatherState& Outside) const
+{
+	if (Size <= 0)
+	{
+		return Outside;
+	}
+
+	const FVector2D Grid = ToGrid(AbsoluteLocation);
+	const FVector2f OutsideWind = GetWindVelocity(Outside);
+
+	FRuntimeWeatherState Weather = Outside;
+	Weather.CloudCover01 = SamplePlane(CloudCover, Outside.CloudCover01, Grid.X, Grid.Y);
+	Weather.Fog01 = SamplePlane(Fog, Outside.Fog01, Grid.X, Grid.Y);
+	Weather.Precip01 = SamplePlane(Precip, Outside.Precip01, Grid.X, Grid.Y);
+	Weather.Storm01 = SamplePlane(Storm, Outside.Storm01, Grid.X, Grid.Y);
+	Weather.Humidity01 = SamplePlane(Humidity, Outside.Humidity01, Grid.X, Grid.Y);
+
+	const FVector Wind(
+		SamplePlane(WindX, OutsideWind.X, Grid.X, Grid.Y),
+		SamplePlane(WindY, OutsideWind.Y, Grid.X, Grid.Y),
+		0.0f);
+	Weather.WindSpeed = Wind.Size();
+	if (Weather.WindSpeed > KINDA_SMALL_NUMBER)
+	{
+		// Calm air keeps the outside direction rather than snapping to +X
+		Weather.WindDir = Wind / Weather.WindSpeed;
+	}
+	return Weather;
+}
+
+void FWeatherFieldGrid::Serialize(FArchive& Ar)
+{
+	Ar << Origin.X << Origin.Y << Origin.LOD;
+	Ar << Size << CellSize;
+	Ar << CloudCover << Fog << Precip << Storm << Humidity;
+	Ar << WindX << WindY << GroundWetness;
+}
+
+float FWeatherFieldGrid::SampleGroundWetness(const FVector& AbsoluteLocation) const
+{
+	if (Size <= 0)
+	{
+		return 0.0f;
+	}
+	const FVector2D Grid = ToGrid(AbsoluteLocation);
+	return SamplePlane(GroundWetness, 0.0f, Grid.X, Grid.Y);
+}
+
+//=============================================================================
+// SUBSYSTEM
+//=============================================================================
+
+bool UWeatherFieldSubsystem::ShouldCreateSubsystem(UObject* Outer) const
+{
+	if (const UWorld* World = Cast<UWorld>(Outer))
+	{
+		return World->IsGameWorld();
+	}
+	return false;
+}
+
+void UWeatherFieldSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	TPF_TIMING_SCOPE(TEXT("WeatherFieldSubsystem::Initialize"));
+
+	Super::Initialize(Collection);
+
+	if (UGameInstance* GI = GetWorld()->GetGameInstance())
+	{
+		if (UTimeSubsystem* Time = GI->GetSubsystem<UTimeSubsystem>())
+		{
+			// One name per world, so streamed-in worlds keep separate grids
+			RewindStateHandle = Time->RegisterRewindState(
+				FName(*FString::Printf(TEXT("WeatherField.%s"), *GetWorld()->GetName())),
+				FOnSerializeRewindState::CreateUObject(this, &UWeatherFieldSubsystem::SerializeRewindState));
+		}
+	}
+}
+
+void UWeatherFieldSubsystem::Deinitialize()
+{
+	if (RewindStateHandle.IsValid())
+	{
+		if (UGameInstance* GI = GetWorld()->GetGameInstance())
+		{
+			if (UTimeSubsystem* Time = GI->GetSubsystem<UTimeSubsystem>())
+			{
+				Time->UnregisterRewindState(RewindStateHandle);
+			}
+		}
+		RewindStateHandle.Reset();
+	}
+
+	// The worker only reads its own snapshot; wait so it does not outlive the subsystem
+	if (PendingStep.IsValid())
+	{
+		PendingStep.Wait();
+		PendingStep = UE::Tasks::TTask<FWeatherFieldPtr>();
+	}
+	Field.Reset();
+	PendingStamps.Empty();
+
+	Super::Deinitialize();
+}
+
+void UWeatherFieldSubsystem::ResetField()
+{
+	// An in-flight step would publish the old weather again
+	if (PendingStep.IsValid())
+	{
+		PendingStep.Wait();
+		PendingStep = UE::Tasks::TTask<FWeatherFieldPtr>();
+	}
+	Field.Reset();
+}
+
+void UWeatherFieldSubsystem::SetBaseWeather(const FRuntimeWeatherState& Weather)
+{
+	BaseWeather = Weather;
+}
+
+void UWeatherFieldSubsystem::AddWeatherStamp(const FVector& WorldLocation, float RadiusCm, const FRuntimeWeatherState& Weather, float Strength)
+{
+	if (RadiusCm <= 0.0f || Strength <= 0.0f)
+	{
+		return;
+	}
+
+	FWeatherStamp& Stamp = PendingStamps.AddDefaulted_GetRef();
+	Stamp.AbsoluteLocation = ToAbsoluteLocation(WorldLocation);
+	Stamp.Radius = RadiusCm;
+	Stamp.Weather = Weather;
+	Stamp.Strength = FMath::Min(Strength, 1.0f);
+}
+
+FRuntimeWeatherState UWeatherFieldSubsystem::SampleWeather(const FVector& WorldLocation) const
+{
+	return SampleWeatherAbsolute(ToAbsoluteLocation(WorldLocation));
+}
+
+FRuntimeWeatherState UWeatherFieldSubsystem::SampleWeatherAbsolute(const FVector& AbsoluteLocation) const
+{
+	return Field.IsValid() ? Field->Sample(AbsoluteLocation, BaseWeather) : BaseWeather;
+}
+
+float UWeatherFieldSubsystem::GetGroundWetnessAtLocation(const FVector& WorldLocation) const
+{
+	return SampleGroundWetnessAbsolute(ToAbsoluteLocation(WorldLocation));
+}
+
+float UWeatherFieldSubsystem::SampleGroundWetnessAbsolute(const FVector& AbsoluteLocation) const
+{
+	return Field.IsValid() ? Field->SampleGroundWetness(AbsoluteLocation) : 0.0f;
+}
+
+FVector UWeatherFieldSubsystem::ToAbsoluteLocation(const FVector& WorldLocation) const
+{
+	// Weather cells stay put across origin rebases, like the surface deltas
+	const UWorld* World = GetWorld();
+	return World ? WorldLocation + FVector(World->OriginLocation) : WorldLocation;
+}
+
+float UWeatherFieldSubsystem::GetWeatherCellSize() const
+{
+	return DeltaCellSize * static_cast<float>(1 << FMath::Clamp(WeatherCellLOD, 0, 12));
+}
+
+FWorldCellKey UWeatherFieldSubsystem::GetWindowOrigin(const FVector& AbsoluteViewLocation) const
+{
+	const int32 LOD = FMath::Clamp(WeatherCellLOD, 0, 12);
+	const FWorldCellKey Center = FWorldCellKey::FromWorldLocation(AbsoluteViewLocation, DeltaCellSize, LOD);
+	const int32 Half = GridCellsPerAxis / 2;
+	return FWorldCellKey(Center.X - Half, Center.Y - Half, LOD);
+}
+
+double UWeatherFieldSubsystem::GetSimTime() const
+{
+	const UWorld* World = GetWorld();
+	if (const UGameInstance* GI = World->GetGameInstance())
+	{
+		if (const UTimeSubsystem* Time = GI->GetSubsystem<UTimeSubsystem>())
+		{
+			return Time->GetSimTimeSeconds();
+		}
+	}
+	return World->GetTimeSeconds();
+}
+
+void UWeatherFieldSubsystem::CompleteStep()
+{
+	FWeatherFieldPtr Stepped = PendingStep.GetResult();
+	PendingStep = UE::Tasks::TTask<FWeatherFieldPtr>();
+	if (Stepped.IsValid())
+	{
+		Field = MoveTemp(Stepped);
+	}
+}
+
+void UWeatherFieldSubsystem::SerializeRewindState(FArchive& Ar)
+{
+	if (PendingStep.IsValid())
+	{
+		// Saving keeps the step it launched; a restore replaces the grid it was stepping
+		PendingStep.Wait();
+		if (Ar.IsSaving())
+		{
+			CompleteStep();
+		}
+		else
+		{
+			PendingStep = UE::Tasks::TTask<FWeatherFieldPtr>();
+		}
+	}
+
+	bool bHasField = Field.IsValid();
+	Ar << bHasField << LastStepSimTime;
+	if (Ar.IsSaving())
+	{
+		if (bHasField)
+		{
+			// Saving only reads the grid
+			const_cast<FWeatherFieldGrid&>(*Field).Serialize(Ar);
+		}
+		return;
+	}
+
+	Field.Reset();
+	PendingStamps.Reset();
+	if (bHasField)
+	{
+		TSharedRef<FWeatherFieldGrid, ESPMode::ThreadSafe> Restored = MakeShared<FWeatherFieldGrid, ESPMode::ThreadSafe>();
+		Restored->Serialize(Ar);
+		if (!Ar.IsError() && Restored->Size > 0 && Restored->CloudCover.Num() == Restored->Num())
+		{
+			Field = Restored;
+		}
+	}
+}
+
+void UWeatherFieldSubsystem::Tick(float DeltaTime)
+{
+	if (PendingStep.IsValid())
+	{
+		if (!PendingStep.IsCompleted())
+		{
+			return;
+		}
+		CompleteStep();
+	}
+
+	// The window follows the view; without one it stays where it is
+	UWorld* World = GetWorld();
+	const APlayerController* PlayerController = World->GetFirstPlayerController();
+	FWorldCellKey Origin;
+	if (PlayerController)
+	{
+		FVector ViewLocation;
+		FRotator ViewRotation;
+		PlayerController->GetPlayerViewPoint(ViewLocation, ViewRotation);
+		Origin = GetWindowOrigin(ToAbsoluteLocation(ViewLocation));
+	}
+	else if (Field.IsValid())
+	{
+		Origin = Field->Origin;
+	}
+	else
+	{
+		return;
+	}
+
+	const double Now = GetSimTime();
+	if (!Field.IsValid())
+	{
+		TSharedRef<FWeatherFieldGrid, ESPMode::ThreadSafe> Initial = MakeShared<FWeatherFieldGrid, ESPMode::ThreadSafe>();
+		Initial->Init(Origin, GridCellsPerAxis, GetWeatherCellSize(), BaseWeather);
+		Field = Initial;
+		LastStepSimTime = Now;
+		return;
+	}
+
+	const double Elapsed = Now - LastStepSimTime;
+	if (Elapsed < 0.0)
+	{
+		// Sim time went backwards past no keyframe (SerializeRewindState restores those); restart the step clock
+		LastStepSimTime = Now;
+		return;
+	}
+	if (Elapsed <= 0.0 || Elapsed < StepIntervalSeconds)
+	{
+		return;
+	}
+
+	FStepParams Params;
+	Params.Origin = Origin;
+	Params.Size = GridCellsPerAxis;
+	Params.CellSize = GetWeatherCellSize();
+	Params.DeltaSeconds = static_cast<float>(Elapsed);
+	Params.Base = BaseWeather;
+	Params.RelaxationSeconds = BaseRelaxationSeconds;
+	Params.SoakSeconds = GroundSoakSeconds;
+	Params.DryingSeconds = GroundDryingSeconds;
+	Params.Stamps = MoveTemp(PendingStamps);
+	PendingStamps.Reset();
+	LastStepSimTime = Now;
+
+	// Worker only touches the snapshot and params it was given - no UObject access off the game thread
+	PendingStep = UE::Tasks::Launch(UE_SOURCE_LOCATION,
+		[Previous = Field, Params = MoveTemp(Params)]()
+		{
+			return StepField(*Previous, Params);
+		});
+}
+
+UWeatherFieldSubsystem::FWeatherFieldPtr UWeatherFieldSubsystem::StepField(const FWeatherFieldGrid& Previous, const FStepParams& Params)
+{
+	SCOPE_CYCLE_COUNTER(STAT_TPF_WeatherFieldStep);
+
+	TSharedRef<FWeatherFieldGrid, ESPMode::ThreadSafe> Next = MakeShared<FWeatherFieldGrid, ESPMode::ThreadSafe>();
+	Next->Init(Params.Origin, Params.Size, Params.CellSize, Params.Base);
+
+	const FRuntimeWeatherState& Base = Params.Base;
+	const FVector2f BaseWind = GetWindVelocity(Base);
+	const float Dt = Params.DeltaSeconds;
+	const float Relax = ExponentialBlend(Dt, Params.RelaxationSeconds);
+	const float Drying = FMath::Exp(-Dt / Params.DryingSeconds);
+
+	for (int32 Y = 0; Y < Params.Size; Y++)
+	{
+		for (int32 X = 0; X < Params.Size; X++)
+		{
+			const int32 Index = Y * Params.Size + X;
+			const FVector Center(
+				(Params.Origin.X + X + 0.5) * Params.CellSize,
+				(Params.Origin.Y + Y + 0.5) * Params.CellSize,
+				0.0);
+
+			// Semi-Lagrangian: pull every channel from where the wind here came from (m/s -> cm)
+			const FVector2D Here = Previous.ToGrid(Center);
+			const float WindX = Previous.SamplePlane(Previous.WindX, BaseWind.X, Here.X, Here.Y);
+			const float WindY = Previous.SamplePlane(Previous.WindY, BaseWind.Y, Here.X, Here.Y);
+			const FVector2D From = Previous.ToGrid(Center - FVector(WindX, WindY, 0.0f) * (Dt * 100.0f));
+
+			const auto Advect = [&Previous, &From, Relax](const TArray<float>& Plane, float BaseValue)
+			{
+				return FMath::Lerp(Previous.SamplePlane(Plane, BaseValue, From.X, From.Y), BaseValue, Relax);
+			};
+
+			Next->CloudCover[Index] = Advect(Previous.CloudCover, Base.CloudCover01);
+			Next->Fog[Index] = Advect(Previous.Fog, Base.Fog01);
+			Next->Precip[Index] = Advect(Previous.Precip, Base.Precip01);
+			Next->Storm[Index] = Advect(Previous.Storm, Base.Storm01);
+			Next->Humidity[Index] = Advect(Previous.Humidity, Base.Humidity01);
+			Next->WindX[Index] = Advect(Previous.WindX, BaseWind.X);
+			Next->WindY[Index] = Advect(Previous.WindY, BaseWind.Y);
+
+			// Ground stays put: it only wets under rain and dries out
+			Next->GroundWetness[Index] = Previous.SamplePlane(Previous.GroundWetness, 0.0f, Here.X, Here.Y);
+		}
+	}
+
+	for (const FWeatherStamp& Stamp : Params.Stamps)
+	{
+		const FVector2f StampWind = GetWindVelocity(Stamp.Weather);
+		for (int32 Y = 0; Y < Params.Size; Y++)
+		{
+			for (int32 X = 0; X < Params.Size; X++)
+			{
+				const FVector2D Center((Params.Origin.X + X + 0.5) * Params.CellSize, (Params.Origin.Y + Y + 0.5) * Params.CellSize);
+				const double Distance = FVector2D::Distance(Center, FVector2D(Stamp.AbsoluteLocation));
+				if (Distance >= Stamp.Radius)
+				{
+					continue;
+				}
+
+				const float Weight = Stamp.Strength * (1.0f - FMath::SmoothStep(0.0f, 1.0f, static_cast<float>(Distance / Stamp.Radius)));
+				const int32 Index = Y * Params.Size + X;
+				Next->CloudCover[Index] = FMath::Lerp(Next->CloudCover[Index], Stamp.Weather.CloudCover01, Weight);
+				Next->Fog[Index] = FMath::Lerp(Next->Fog[Index], Stamp.Weather.Fog01, Weight);
+				Next->Precip[Index] = FMath::Lerp(Next->Precip[Index], Stamp.Weather.Precip01, Weight);
+				Next->Storm[Index] = FMath::Lerp(Next->Storm[Index], Stamp.Weather.Storm01, Weight);
+				Next->Humidity[Index] = FMath::Lerp(Next->Humidity[Index], Stamp.Weather.Humidity01, Weight);
+				Next->WindX[Index] = FMath::Lerp(Next->WindX[Index], StampWind.X, Weight);
+				Next->WindY[Index] = FMath::Lerp(Next->WindY[Index], StampWind.Y, Weight);
+			}
+		}
+	}
+
+	for (int32 Index = 0; Index < Next->Num(); Index++)
+	{
+		Next->CloudCover[Index] = FMath::Clamp(Next->CloudCover[Index], 0.0f, 1.0f);
+		Next->Fog[Index] = FMath::Clamp(Next->Fog[Index], 0.0f, 1.0f);
+		Next->Precip[Index] = FMath::Clamp(Next->Precip[Index], 0.0f, 1.0f);
+		Next->Storm[Index] = FMath::Clamp(Next->Storm[Index], 0.0f, 1.0f);
+		Next->Humidity[Index] = FMath::Clamp(Next->Humidity[Index], 0.0f, 1.0f);
+
+		// dW/dt = Precip / Soak - W / Drying, integrated exactly over the step
+		const float Equilibrium = Next->Precip[Index] * Params.DryingSeconds / Params.SoakSeconds;
+		const float Wetness = Equilibrium + (Next->GroundWetness[Index] - Equilibrium) * Drying;
+		Next->GroundWetness[Index] = FMath::Clamp(Wetness, 0.0f, 1.0f);
+	}
+
+	return Next;
+}
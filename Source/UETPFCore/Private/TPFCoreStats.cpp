@@ -0,0 +1,51 @@
+// Copyright 2026 Threaded Pixel Factory
+// Licensed under the Apache License, Version 2.0 (the "License");
+// SPDX-License-Identifier: Apache-2.0
+
+#include "TPFCoreStats.h"
+
+DEFINE_STAT(STAT_TPF_SurfaceQuery);
+DEFINE_STAT(STAT_TPF_SurfaceBatchBuild);
+DEFINE_STAT(STAT_TPF_SurfaceAtlasUpload);
+DEFINE_STAT(STAT_TPF_SurfaceThermalStep);
+DEFINE_STAT(STAT_TPF_WeatherFieldStep);
+DEFINE_STAT(STAT_TPF_EnvironmentQuery);
+DEFINE_STAT(STAT_TPF_EnvironmentBatchQuery);
+DEFINE_STAT(STAT_TPF_EnvironmentSnapshotBuild);
+DEFINE_STAT(STAT_TPF_EnvironmentGridBake);
+DEFINE_STAT(STAT_TPF_BiomeQuery);
+DEFINE_STAT(STAT_TPF_PhysicsIntegrationTick);
+DEFINE_STAT(STAT_TPF_DeltaFlush);
+DEFINE_STAT(STAT_TPF_DeltaFlushWrite);
+DEFINE_STAT(STAT_TPF_DeltaCompaction);
+DEFINE_STAT(STAT_TPF_DeltaStreamingApply);
+DEFINE_STAT(STAT_TPF_DeltaReplication);
+DEFINE_STAT(STAT_TPF_StarCatalogLoad);
+DEFINE_STAT(STAT_TPF_SpecPackLoad);
+DEFINE_STAT(STAT_TPF_SkyApplyEnvironment);
+
+DEFINE_STAT(STAT_TPF_SurfaceQueries);
+DEFINE_STAT(STAT_TPF_SurfaceCacheHits);
+DEFINE_STAT(STAT_TPF_SurfaceAtlasTexels);
+DEFINE_STAT(STAT_TPF_ThermalCellsStepped);
+DEFINE_STAT(STAT_TPF_EnvironmentQueries);
+DEFINE_STAT(STAT_TPF_VolumeTests);
+DEFINE_STAT(STAT_TPF_BiomeQueries);
+DEFINE_STAT(STAT_TPF_BiomeTileCacheHits);
+DEFINE_STAT(STAT_TPF_BodiesServiced);
+DEFINE_STAT(STAT_TPF_BodiesActive);
+DEFINE_STAT(STAT_TPF_ImpactsQueued);
+DEFINE_STAT(STAT_TPF_SkyUpdatesApplied);
+DEFINE_STAT(STAT_TPF_SkyUpdatesSkipped);
+DEFINE_STAT(STAT_TPF_StreamedDeltasApplied);
+DEFINE_STAT(STAT_TPF_DeltaReplicationBytes);
+
+DEFINE_STAT(STAT_TPF_DeltaResidentCells);
+DEFINE_STAT(STAT_TPF_DeltaCellEvictions);
+DEFINE_STAT(STAT_TPF_DeltaCellReloads);
+
+DEFINE_STAT(STAT_TPF_DeltaCacheMemory);
+DEFINE_STAT(STAT_TPF_DeltaPendingMemory);
+DEFINE_STAT(STAT_TPF_DeltaCacheBudget);
+
+CSV_DEFINE_CATEGORY_MODULE(UETPFCORE_API, TPFCore, true);
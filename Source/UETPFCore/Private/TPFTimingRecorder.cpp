@@ -0,0 +1,276 @@
+// Copyright 2026 Threaded Pixel Factory
+// Licensed under the Apache License, Version 2.0 (the "License");
+// SPDX-License-Identifier: Apache-2.0
+
+#include "TPFTimingRecorder.h"
+#include "Engine/World.h"
+#include "Dom/JsonObject.h"
+#include "HAL/PlatformMemory.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/App.h"
+#include "Misc/DateTime.h"
+#include "Misc/FileHelper.h"
+#include "Misc/PackageName.h"
+#include "Misc/Paths.h"
+#include "Misc/ScopeLock.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+#include "ProfilingDebugging/MiscTrace.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+#include "UObject/Package.h"
+#include "UObject/UObjectGlobals.h"
+
+namespace
+{
+	/** Innermost open scope per thread, for FTPFTimingRecorder::AddBytesRead */
+	thread_local FTPFTimingScope* CurrentTimingScope = nullptr;
+
+	FName GetMapShortName(FName Map)
+	{
+		return Map.IsNone() ? NAME_None : FName(*FPackageName::GetShortName(Map.ToString()));
+	}
+}
+
+//=============================================================================
+// FTPFTimingRecorder
+//=============================================================================
+
+FTPFTimingRecorder& FTPFTimingRecorder::Get()
+{
+	static FTPFTimingRecorder Recorder;
+	return Recorder;
+}
+
+uint64 FTPFTimingRecorder::GetUsedPhysicalBytes()
+{
+	return FPlatformMemory::GetStats().UsedPhysical;
+}
+
+void FTPFTimingRecorder::BeginSession(const FString& InSessionName, FName InEndOnMapLoaded)
+{
+	check(IsInGameThread());
+
+	if (IsSessionOpen())
+	{
+		UE_LOG(LogTemp, Warning, TEXT("TPFTiming: Session %s still open when %s began, writing it as incomplete"), *SessionName, *InSessionName);
+		WriteSession(false);
+	}
+
+	{
+		FScopeLock ScopeLock(&Lock);
+		SessionName = InSessionName;
+		SessionStartSeconds = FPlatformTime::Seconds();
+		SessionStartUsedPhysical = GetUsedPhysicalBytes();
+		Phases.Reset();
+		EndOnMapLoaded = GetMapShortName(InEndOnMapLoaded);
+	}
+
+	if (!EndOnMapLoaded.IsNone() && !PostLoadMapHandle.IsValid())
+	{
+		PostLoadMapHandle = FCoreUObjectDelegates::PostLoadMapWithWorld.AddRaw(this, &FTPFTimingRecorder::HandlePostLoadMap);
+	}
+
+	TRACE_BEGIN_REGION(*SessionName);
+	bSessionOpen = true;
+}
+
+void FTPFTimingRecorder::EndSession(const FString& InSessionName, bool bCompleted)
+{
+	check(IsInGameThread());
+
+	if (IsSessionOpen() && SessionName == InSessionName)
+	{
+		WriteSession(bCompleted);
+	}
+}
+
+void FTPFTimingRecorder::RecordPhase(const FString& Name, double StartSeconds, double EndSeconds, int64 BytesRead, int64 AllocatedBytes)
+{
+	if (!IsSessionOpen())
+	{
+		return;
+	}
+
+	FTPFTimingPhase Phase;
+	Phase.Name = Name;
+	Phase.DurationMs = (EndSeconds - StartSeconds) * 1000.0;
+	Phase.BytesRead = BytesRead;
+	Phase.AllocatedBytes = AllocatedBytes;
+	Phase.bGameThread = IsInGameThread();
+	AddPhase(MoveTemp(Phase), StartSeconds);
+}
+
+void FTPFTimingRecorder::AddBytesRead(int64 Bytes)
+{
+	if (CurrentTimingScope)
+	{
+		CurrentTimingScope->AddBytesRead(Bytes);
+	}
+}
+
+void FTPFTimingRecorder::AddPhase(FTPFTimingPhase&& Phase, double StartSeconds)
+{
+	FScopeLock ScopeLock(&Lock);
+	if (bSessionOpen.load(std::memory_order_relaxed) && StartSeconds >= SessionStartSeconds)
+	{
+		Phase.StartMs = (StartSeconds - SessionStartSeconds) * 1000.0;
+		Phases.Add(MoveTemp(Phase));
+	}
+}
+
+void FTPFTimingRecorder::HandlePostLoadMap(UWorld* LoadedWorld)
+{
+	if (!IsSessionOpen() || EndOnMapLoaded.IsNone() || !LoadedWorld)
+	{
+		return;
+	}
+
+	// Seamless travel loads the transition map first; only the destination closes the session
+	const FString LoadedMap = UWorld::RemovePIEPrefix(LoadedWorld->GetOutermost()->GetName());
+	if (GetMapShortName(FName(*LoadedMap)) == EndOnMapLoaded)
+	{
+		WriteSession(true);
+	}
+}
+
+void FTPFTimingRecorder::WriteSession(bool bCompleted)
+{
+	FString Name;
+	double StartSeconds;
+	uint64 StartUsedPhysical;
+	TArray<FTPFTimingPhase> SessionPhases;
+	{
+		FScopeLock ScopeLock(&Lock);
+		bSessionOpen = false;
+		Name = MoveTemp(SessionName);
+		StartSeconds = SessionStartSeconds;
+		StartUsedPhysical = SessionStartUsedPhysical;
+		SessionPhases = MoveTemp(Phases);
+		EndOnMapLoaded = NAME_None;
+	}
+
+	TRACE_END_REGION(*Name);
+
+	if (PostLoadMapHandle.IsValid())
+	{
+		FCoreUObjectDelegates::PostLoadMapWithWorld.Remove(PostLoadMapHandle);
+		PostLoadMapHandle.Reset();
+	}
+
+	const double TotalMs = (FPlatformTime::Seconds() - StartSeconds) * 1000.0;
+	const uint64 EndUsedPhysical = GetUsedPhysicalBytes();
+
+	SessionPhases.Sort([](const FTPFTimingPhase& A, const FTPFTimingPhase& B) { return A.StartMs < B.StartMs; });
+
+	TSharedRef<FJsonObject> Root = MakeShared<FJsonObject>();
+	Root->SetStringField(TEXT("session"), Name);
+	Root->SetBoolField(TEXT("completed"), bCompleted);
+	Root->SetStringField(TEXT("build_version"), FApp::GetBuildVersion());
+	Root->SetStringField(TEXT("build_configuration"), LexToString(FApp::GetBuildConfiguration()));
+	Root->SetStringField(TEXT("timestamp"), FDateTime::UtcNow().ToIso8601());
+	Root->SetNumberField(TEXT("process_seconds_at_begin"), StartSeconds - GStartTime);
+	Root->SetNumberField(TEXT("total_ms"), TotalMs);
+
+	TSharedRef<FJsonObject> Memory = MakeShared<FJsonObject>();
+	Memory->SetNumberField(TEXT("used_physical_begin"), double(StartUsedPhysical));
+	Memory->SetNumberField(TEXT("used_physical_end"), double(EndUsedPhysical));
+	Root->SetObjectField(TEXT("memory_bytes"), Memory);
+
+	TArray<TSharedPtr<FJsonValue>> PhaseValues;
+	PhaseValues.Reserve(SessionPhases.Num());
+	for (const FTPFTimingPhase& Phase : SessionPhases)
+	{
+		TSharedRef<FJsonObject> PhaseObject = MakeShared<FJsonObject>();
+		PhaseObject->SetStringField(TEXT("name"), Phase.Name);
+		PhaseObject->SetStringField(TEXT("thread"), Phase.bGameThread ? TEXT("game") : TEXT("worker"));
+		PhaseObject->SetNumberField(TEXT("start_ms"), Phase.StartMs);
+		PhaseObject->SetNumberField(TEXT("duration_ms"), Phase.DurationMs);
+		PhaseObject->SetNumberField(TEXT("bytes_read"), double(Phase.BytesRead));
+		PhaseObject->SetNumberField(TEXT("allocated_bytes"), double(Phase.AllocatedBytes));
+		PhaseValues.Add(MakeShared<FJsonValueObject>(PhaseObject));
+	}
+	Root->SetArrayField(TEXT("phases"), PhaseValues);
+
+	FString Output;
+	const TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&Output);
+	FJsonSerializer::Serialize(Root, Writer);
+
+	const FString Path = FPaths::ProfilingDir() / TEXT("TPFTiming")
+		/ Name + FDateTime::Now().ToString(TEXT("_%Y%m%d_%H%M%S")) + TEXT(".json");
+	if (FFileHelper::SaveStringToFile(Output, *Path))
+	{
+		UE_LOG(LogTemp, Log, TEXT("TPFTiming: %s took %.1f ms over %d phases, written to %s"), *Name, TotalMs, SessionPhases.Num(), *Path);
+	}
+	else
+	{
+		UE_LOG(LogTemp, Warning, TEXT("TPFTiming: Failed to write %s timings to %s"), *Name, *Path);
+	}
+}
+
+//=============================================================================
+// FTPFTimingScope
+//=============================================================================
+
+FTPFTimingScope::FTPFTimingScope(const TCHAR* InName)
+	: Name(InName)
+{
+	Begin();
+}
+
+FTPFTimingScope::FTPFTimingScope(FString&& InName)
+	: Name(MoveTemp(InName))
+{
+	Begin();
+}
+
+void FTPFTimingScope::Begin()
+{
+#if CPUPROFILERTRACE_ENABLED
+	bTraced = UE_TRACE_CHANNELEXPR_IS_ENABLED(CpuChannel);
+	if (bTraced)
+	{
+		FCpuProfilerTrace::OutputBeginDynamicEvent(*Name);
+	}
+#endif
+
+	Outer = CurrentTimingScope;
+	CurrentTimingScope = this;
+
+	// Memory stats cost a syscall on some platforms; only pay it when the result is kept
+	bRecording = FTPFTimingRecorder::Get().IsSessionOpen();
+	if (bRecording)
+	{
+		StartUsedPhysical = FTPFTimingRecorder::GetUsedPhysicalBytes();
+	}
+	StartSeconds = FPlatformTime::Seconds();
+}
+
+FTPFTimingScope::~FTPFTimingScope()
+{
+	const double EndSeconds = FPlatformTime::Seconds();
+	CurrentTimingScope = Outer;
+
+	// Nested reads count towards the outer phase too
+	if (Outer)
+	{
+		Outer->AddBytesRead(BytesRead);
+	}
+
+	if (bRecording)
+	{
+		FTPFTimingPhase Phase;
+		Phase.Name = MoveTemp(Name);
+		Phase.DurationMs = (EndSeconds - StartSeconds) * 1000.0;
+		Phase.BytesRead = BytesRead;
+		Phase.AllocatedBytes = int64(FTPFTimingRecorder::GetUsedPhysicalBytes()) - int64(StartUsedPhysical);
+		Phase.bGameThread = IsInGameThread();
+		FTPFTimingRecorder::Get().AddPhase(MoveTemp(Phase), StartSeconds);
+	}
+
+#if CPUPROFILERTRACE_ENABLED
+	if (bTraced)
+	{
+		FCpuProfilerTrace::OutputEndEvent();
+	}
+#endif
+}
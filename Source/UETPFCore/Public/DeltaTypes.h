@@ -85,6 +85,20 @@ struct UETPFCORE_API FWorldCellKey
 
 	/** Get world bounds for this cell */
 	FBox GetWorldBounds(float CellSize = 6400.0f) const;
+
+	/** Cell at a coarser LOD containing this one (ParentLOD >= LOD) */
+	FWorldCellKey GetParent(int32 ParentLOD) const
+	{
+		// Arithmetic shift floors negative coordinates, matching FromWorldLocation
+		const int32 Shift = FMath::Max(ParentLOD - LOD, 0);
+		return FWorldCellKey(X >> Shift, Y >> Shift, LOD + Shift);
+	}
+
+	/** Cells per axis of this LOD inside one cell of ParentLOD */
+	static int32 GetCellsPerAxis(int32 ChildLOD, int32 ParentLOD)
+	{
+		return 1 << FMath::Max(ParentLOD - ChildLOD, 0);
+	}
 };
 
 //=============================================================================
@@ -179,6 +193,256 @@ struct UETPFCORE_API FSurfaceTileDelta
 	FName AuthorPlayerId;
 
 	FSurfaceTileDelta() = default;
+
+	/** True if both deltas target the same tile channel (candidates for folding) */
+	bool TargetsSameTile(const FSurfaceTileDelta& Other) const
+	{
+		return CellKey == Other.CellKey && TileIndex == Other.TileIndex && Channel == Other.Channel;
+	}
+
+	/** Apply this delta's operation to a current value */
+	float ApplyTo(float Current) const;
+
+	/**
+	 * Fold a later delta on the same tile channel into this one, if the pair
+	 * collapses to a single operation:
+	 * - Any op, then Set      -> Set (later value)
+	 * - Set, then any op      -> Set (op applied to the set value)
+	 * - Add/Subtract chains   -> Add (net value)
+	 * - Multiply chains       -> Multiply (product)
+	 * - Max chains / Min chains -> Max / Min of the values
+	 *
+	 * On success this record takes the later delta's timestamp, author, location
+	 * and the larger radius.
+	 *
+	 * @param Later - Delta appended after this one
+	 * @return true if Later was folded in and should be discarded
+	 */
+	bool TryCoalesce(const FSurfaceTileDelta& Later);
+
+	/**
+	 * Fold an append-ordered array in place, keeping one record per run of
+	 * composable operations on each tile channel. Relative order per tile channel
+	 * is preserved; different tile channels are independent.
+	 *
+	 * @return Number of records removed
+	 */
+	static int32 CoalesceInPlace(TArray<FSurfaceTileDelta>& Deltas);
+
+	/** Tiles along each cell edge; TileIndex = Y * TilesPerCellAxis + X */
+	static constexpr int32 TilesPerCellAxis = 64;
+
+	/** Tile index of a world location inside a cell (clamped to the cell) */
+	static int32 TileIndexFromWorldLocation(const FVector& Location, const FWorldCellKey& CellKey, float CellSize = 6400.0f);
+
+	/** Key identifying a tile channel within one cell */
+	static uint64 MakeTileChannelKey(int32 InTileIndex, ESurfaceDeltaChannel InChannel)
+	{
+		return (static_cast<uint64>(static_cast<uint32>(InTileIndex)) << 8) | static_cast<uint64>(InChannel);
+	}
+};
+
+/**
+ * Dense surface values for one cell, rebuilt from its FSurfaceTileDelta records.
+ * One TilesPerCellAxis^2 float plane per ESurfaceDeltaChannel (SoA); a plane is only
+ * allocated once a delta touches its channel, untouched channels read as 0.
+ */
+struct UETPFCORE_API FSurfaceChannelGrid
+{
+	static constexpr int32 NumChannels = static_cast<int32>(ESurfaceDeltaChannel::CustomB) + 1;
+	static constexpr int32 TilesPerAxis = FSurfaceTileDelta::TilesPerCellAxis;
+	static constexpr int32 TilesPerPlane = TilesPerAxis * TilesPerAxis;
+
+	/** Replay a cell's deltas in append order */
+	void Rebuild(TConstArrayView<FSurfaceTileDelta> Deltas);
+
+	/** Apply one more delta on top of the current values */
+	void ApplyDelta(const FSurfaceTileDelta& Delta);
+
+	/** Tile value, no filtering */
+	float GetTileValue(ESurfaceDeltaChannel Channel, int32 TileIndex) const;
+
+	/**
+	 * Bilinear sample between tile centers. Samples near the cell border clamp
+	 * to the border tiles rather than reading the neighbouring cell.
+	 */
+	float Sample(ESurfaceDeltaChannel Channel, const FVector& WorldLocation, const FWorldCellKey& CellKey, float CellSize = 6400.0f) const;
+
+	bool HasChannel(ESurfaceDeltaChannel Channel) const { return Planes[static_cast<int32>(Channel)].Num() > 0; }
+
+	/** Mean tile value of a channel over the whole cell (0 if untouched) */
+	float GetMean(ESurfaceDeltaChannel Channel) const;
+
+	/** Last frame this grid was sampled (owner-managed, for eviction) */
+	uint64 LastUsedFrame = 0;
+
+private:
+	TArray<float> Planes[NumChannels];
+};
+
+//=============================================================================
+// PACKED SURFACE DELTAS - Compact POD form of FSurfaceTileDelta
+//=============================================================================
+
+/**
+ * 24-byte POD form of FSurfaceTileDelta (which is ~72 bytes with FVector,
+ * double timestamp and FName). Only meaningful inside an FPackedSurfaceDeltaList,
+ * which supplies the cell, epoch and author table.
+ * 
+ * Quantization:
+ * - X/Y: 16 bits across the cell (~0.1cm at 6400cm), Z stays a float
+ * - Radius: whole centimetres, up to 65535
+ * - Timestamp: milliseconds after the list's epoch (~49 days of range)
+ */
+struct FPackedSurfaceTileDelta
+{
+	uint16 TileIndex = 0;
+	uint8 Channel = 0;
+	uint8 Operation = 0;
+	float Value = 0.0f;
+	uint16 LocalX = 0;
+	uint16 LocalY = 0;
+	float Z = 0.0f;
+	uint16 RadiusCm = 0;
+	uint16 AuthorIndex = 0;
+	uint32 TimeOffsetMs = 0;
+};
+
+static_assert(sizeof(FPackedSurfaceTileDelta) == 24, "FPackedSurfaceTileDelta is serialized as raw bytes");
+
+template<> struct TIsPODType<FPackedSurfaceTileDelta> { enum { Value = true }; };
+
+/**
+ * One cell's surface deltas as FPackedSurfaceTileDelta records.
+ * Appending and copying move 24-byte PODs only; the author table is inline for
+ * the usual handful of authors per cell.
+ */
+struct UETPFCORE_API FPackedSurfaceDeltaList
+{
+	/** Cell size the X/Y quantization spans (scaled by 2^LOD) */
+	static constexpr float PackCellSize = 6400.0f;
+
+	static constexpr double MaxTimeSpanSeconds = MAX_uint32 / 1000.0;
+
+	FWorldCellKey CellKey;
+
+	/** Timestamp that TimeOffsetMs counts from */
+	double EpochSeconds = 0.0;
+
+	TArray<FName, TInlineAllocator<4>> Authors;
+	TArray<FPackedSurfaceTileDelta> Records;
+
+	/** Empty the list for a cell, keeping allocations */
+	void Reset(const FWorldCellKey& InCellKey, double InEpochSeconds);
+
+	/** True if the delta fits the quantization ranges (inside the cell, after the epoch, within range) */
+	bool CanPack(const FSurfaceTileDelta& Delta) const;
+
+	/** Pack and append a delta. @return false (nothing added) if CanPack() fails */
+	bool Add(const FSurfaceTileDelta& Delta);
+
+	/** Expand one record back into a full delta */
+	void Unpack(int32 Index, FSurfaceTileDelta& OutDelta) const;
+
+	/** Expand every record, appending to OutDeltas */
+	void UnpackAll(TArray<FSurfaceTileDelta>& OutDeltas) const;
+
+	/**
+	 * Pack a whole array, using its earliest timestamp as the epoch.
+	 * @return false if any delta does not fit; OutList is then incomplete
+	 */
+	static bool PackAll(TConstArrayView<FSurfaceTileDelta> Deltas, const FWorldCellKey& InCellKey, FPackedSurfaceDeltaList& OutList);
+
+	int32 Num() const { return Records.Num(); }
+
+	int64 GetAllocatedSize() const { return Authors.GetAllocatedSize() + Records.GetAllocatedSize(); }
+
+	/** Epoch, author table and raw records; CellKey is not serialized */
+	friend UETPFCORE_API FArchive& operator<<(FArchive& Ar, FPackedSurfaceDeltaList& List);
+};
+
+//=============================================================================
+// DELTA CELL SUMMARY - Aggregates for coarse LOD cells
+//=============================================================================
+
+/**
+ * Cheap aggregate of a cell's deltas, for far-field rendering and gameplay that
+ * must not load fine-grained deltas for every distant cell.
+ * 
+ * For a coarse cell (LOD > base LOD) the means are area-weighted over all of its
+ * base cells (cells without deltas count as 0) and the counts are totals, so
+ * summaries combine additively: see Accumulate.
+ */
+USTRUCT(BlueprintType)
+struct UETPFCORE_API FDeltaCellSummary
+{
+	GENERATED_BODY()
+
+	/** Cell this summary covers */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Location")
+	FWorldCellKey CellKey;
+
+	/** Mean snow depth over the cell area (cm) */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Surface")
+	float MeanSnowDepth = 0.0f;
+
+	/** Mean snow compaction over the cell area (0-1) */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Surface")
+	float MeanSnowCompaction = 0.0f;
+
+	/** Mean wetness over the cell area (0-1) */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Surface")
+	float MeanWetness = 0.0f;
+
+	/** Mean temperature deviation over the cell area (Kelvin) */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Surface")
+	float MeanTemperatureDelta = 0.0f;
+
+	/** Mean toxicity over the cell area (0-1) */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Surface")
+	float MeanToxicity = 0.0f;
+
+	/** Distinct actors removed (destroyed/harvested) */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Counts")
+	int32 RemovedActors = 0;
+
+	/** Distinct actors moved or settled */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Counts")
+	int32 MovedActors = 0;
+
+	/** Distinct actors spawned (promoted PCG instances) */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Counts")
+	int32 SpawnedActors = 0;
+
+	/** Distinct actors fractured */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Counts")
+	int32 FracturedActors = 0;
+
+	/** Distinct assemblies with recorded state */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Counts")
+	int32 Assemblies = 0;
+
+	/** Base cells with any deltas that contributed to this summary */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Counts")
+	int32 CellsWithDeltas = 0;
+
+	/** Newest delta timestamp seen (not reduced when a child changes) */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Meta")
+	double LatestTimestamp = 0.0;
+
+	/** Fill the surface means from a cell's surface deltas (replays them onto a grid) */
+	void SetSurfaceFromDeltas(TConstArrayView<FSurfaceTileDelta> Deltas);
+
+	/**
+	 * Add (Sign = 1) or remove (Sign = -1) a child's contribution to this coarser summary.
+	 * @param ChildrenPerCell - Child cells covering this cell (4^(LOD difference))
+	 */
+	void Accumulate(const FDeltaCellSummary& Child, int32 ChildrenPerCell, int32 Sign = 1);
+
+	/** True if nothing contributes (safe to drop) */
+	bool IsEmpty() const { return CellsWithDeltas <= 0; }
+
+	friend UETPFCORE_API FArchive& operator<<(FArchive& Ar, FDeltaCellSummary& Summary);
 };
 
 //=============================================================================
@@ -381,6 +645,16 @@ struct UETPFCORE_API FAssemblyDelta
 	FAssemblyDelta() = default;
 };
 
+class IDeltaStore;
+
+/**
+ * Store, cell and tile whose surface deltas changed. TileIndex is INDEX_NONE when the whole
+ * cell changed; AppendedDelta is set when exactly one delta was appended. Several stores can
+ * be live at once (a server store and its replicated mirror), so subscribers compare Store
+ * against the one they are bound to.
+ */
+DECLARE_MULTICAST_DELEGATE_FourParams(FOnSurfaceDeltasChanged, const IDeltaStore* /*Store*/, const FWorldCellKey& /*CellKey*/, int32 /*TileIndex*/, const FSurfaceTileDelta* /*AppendedDelta*/);
+
 //=============================================================================
 // DELTA STORE INTERFACE
 //=============================================================================
@@ -437,9 +711,58 @@ public:
 	/** Get all assembly deltas for a cell */
 	virtual TArray<FAssemblyDelta> GetAssemblyDeltas(const FWorldCellKey& CellKey) const = 0;
 
+	//==========================================================================
+	// ZERO-COPY QUERIES
+	//==========================================================================
+	// Views reference the store's own storage - no allocation, no deep copy.
+	//
+	// Lifetime: a view stays valid until the next mutating call on the store
+	// (Append*, ClearCellDeltas, Flush, or any implementation-specific reset/
+	// eviction). Querying other cells does not invalidate it. Do not hold views
+	// across frames; copy (or use Get*Deltas) if the data must outlive that.
+
+	/** View surface deltas for a cell */
+	virtual TConstArrayView<FSurfaceTileDelta> ViewSurfaceDeltas(const FWorldCellKey& CellKey) const = 0;
+
+	/** View fracture deltas for a cell */
+	virtual TConstArrayView<FFractureDelta> ViewFractureDeltas(const FWorldCellKey& CellKey) const = 0;
+
+	/** View transform deltas for a cell */
+	virtual TConstArrayView<FTransformDelta> ViewTransformDeltas(const FWorldCellKey& CellKey) const = 0;
+
+	/** View spawn deltas for a cell */
+	virtual TConstArrayView<FSpawnDelta> ViewSpawnDeltas(const FWorldCellKey& CellKey) const = 0;
+
+	/** View remove deltas for a cell */
+	virtual TConstArrayView<FRemoveDelta> ViewRemoveDeltas(const FWorldCellKey& CellKey) const = 0;
+
+	/** View assembly deltas for a cell */
+	virtual TConstArrayView<FAssemblyDelta> ViewAssemblyDeltas(const FWorldCellKey& CellKey) const = 0;
+
 	/** Clear all deltas for a cell (for testing/reset) */
 	virtual void ClearCellDeltas(const FWorldCellKey& CellKey) = 0;
 
 	/** Flush pending writes to storage */
 	virtual void Flush() = 0;
+
+	/**
+	 * Aggregate for a cell at any LOD (see FDeltaCellSummary), without loading
+	 * its deltas. Stores without summaries return false.
+	 */
+	virtual bool GetCellSummary(const FWorldCellKey& CellKey, FDeltaCellSummary& OutSummary) const { return false; }
+
+	/**
+	 * Broadcast just before the game leaves the current map (module load/unload,
+	 * interplanetary travel). Store owners bind this to get deltas written before
+	 * the world tears down.
+	 */
+	static FSimpleMulticastDelegate& OnPreLevelTransition();
+
+	/**
+	 * Broadcast on the game thread when a store's surface data for a tile changes
+	 * (append, clear, or a cell load merging persisted deltas). Surface caches and
+	 * derived grids bind this to invalidate or update incrementally, ignoring
+	 * broadcasts from stores other than the one they read.
+	 */
+	static FOnSurfaceDeltasChanged& OnSurfaceDeltasChanged();
 };
@@ -0,0 +1,109 @@
+// Copyright 2026 Threaded Pixel Factory
+// Licensed under the Apache License, Version 2.0 (the "License");
+// SPDX-License-Identifier: Apache-2.0
+
+/**
+ * Niagara Environment Data Interface - Wind, density and medium per particle
+ *
+ * Purpose:
+ * Lets Niagara emitters (dust, smoke, rain, sparks) sample the same environment
+ * UEnvironmentSubsystem resolves, without per-emitter CPU queries or user parameters.
+ *
+ * GPU Emitters:
+ * Once per change, the system instance uploads
+ * - the atmosphere profile (FAtmosphereModel rows: temperature, pressure, density)
+ * - the base wind, altitude scaling and gust lattice parameters (per frame, constants only)
+ * - a coarse grid of volume media around the system (GridResolution x GridCellSize),
+ *   baked from the environment query snapshot and re-centered as the system moves
+ * The shader evaluates volume, then atmosphere, then default medium: the same order
+ * as the CPU query. Gusts use the shared FAtmosphereModel::SampleGustLattice noise.
+ *
+ * CPU Emitters:
+ * Sample the FEnvironmentQuerySnapshot directly (exact volume shapes, no grid).
+ *
+ * Functions:
+ * - SampleEnvironment(Position) -> Wind, Density, Temperature, Pressure, InVolume
+ * - SampleWind(Position) -> Wind
+ *
+ * Accuracy:
+ * Volume media are resolved at grid cell centers, so volume edges are quantized
+ * to GridCellSize on the GPU. Outside the grid only the atmosphere applies.
+ *
+ * @see UEnvironmentSubsystem::GetQuerySnapshot for the data source
+ * @see FAtmosphereModel for the atmosphere and gust model
+ */
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "NiagaraDataInterface.h"
+#include "NiagaraDataInterfaceEnvironment.generated.h"
+
+/**
+ * Niagara data interface exposing the world environment field.
+ */
+UCLASS(EditInlineNew, Category = "Environment", CollapseCategories, meta = (DisplayName = "TPF Environment Field"))
+class UETPFCORE_API UNiagaraDataInterfaceEnvironment : public UNiagaraDataInterface
+{
+	GENERATED_UCLASS_BODY()
+
+	BEGIN_SHADER_PARAMETER_STRUCT(FShaderParameters, )
+		SHADER_PARAMETER(FVector4f, AtmosphereParams)
+		SHADER_PARAMETER(FVector4f, WindParams)
+		SHADER_PARAMETER(FVector4f, GustParams)
+		SHADER_PARAMETER(FVector4f, DefaultMedium)
+		SHADER_PARAMETER(FVector4f, DefaultWind)
+		SHADER_PARAMETER(FVector3f, GridOrigin)
+		SHADER_PARAMETER(float, GridInvCellSize)
+		SHADER_PARAMETER(FIntVector, GridSize)
+		SHADER_PARAMETER_SRV(Buffer<float4>, ProfileBuffer)
+		SHADER_PARAMETER_SRV(Buffer<float4>, GridBuffer)
+	END_SHADER_PARAMETER_STRUCT()
+
+public:
+	/** Volume grid cell size (cm); smaller cells follow volume edges more closely */
+	UPROPERTY(EditAnywhere, Category = "Environment", meta = (ClampMin = "50"))
+	float GridCellSize = 400.0f;
+
+	/** Volume grid cells per axis around the system (GPU only) */
+	UPROPERTY(EditAnywhere, Category = "Environment", meta = (ClampMin = "1", ClampMax = "128"))
+	FIntVector GridResolution = FIntVector(32, 32, 8);
+
+	/** Skip the volume grid; GPU emitters see only the atmosphere and default medium */
+	UPROPERTY(EditAnywhere, Category = "Environment")
+	bool bIgnoreVolumes = false;
+
+	//--- UObject Interface ---
+	virtual void PostInitProperties() override;
+
+	//--- UNiagaraDataInterface Interface ---
+	virtual bool CanExecuteOnTarget(ENiagaraSimTarget Target) const override { return true; }
+	virtual void GetVMExternalFunction(const FVMExternalFunctionBindingInfo& BindingInfo, void* InstanceData, FVMExternalFunction& OutFunc) override;
+	virtual bool Equals(const UNiagaraDataInterface* Other) const override;
+
+	virtual bool InitPerInstanceData(void* PerInstanceData, FNiagaraSystemInstance* SystemInstance) override;
+	virtual void DestroyPerInstanceData(void* PerInstanceData, FNiagaraSystemInstance* SystemInstance) override;
+	virtual int32 PerInstanceDataSize() const override;
+	virtual bool PerInstanceTick(void* PerInstanceData, FNiagaraSystemInstance* SystemInstance, float DeltaSeconds) override;
+	virtual bool HasPreSimulateTick() const override { return true; }
+	virtual void ProvidePerInstanceDataForRenderThread(void* DataForRenderThread, void* PerInstanceData, const FNiagaraSystemInstanceID& SystemInstance) override;
+
+#if WITH_EDITORONLY_DATA
+	virtual bool AppendCompileHash(FNiagaraCompileHashVisitor* InVisitor) const override;
+	virtual void GetParameterDefinitionHLSL(const FNiagaraDataInterfaceGPUParamInfo& ParamInfo, FString& OutHLSL) override;
+	virtual bool GetFunctionHLSL(const FNiagaraDataInterfaceGPUParamInfo& ParamInfo, const FNiagaraDataInterfaceGeneratedFunction& FunctionInfo,
+		int FunctionInstanceIndex, FString& OutHLSL) override;
+#endif
+	virtual void BuildShaderParameters(FNiagaraShaderParametersBuilder& ShaderParametersBuilder) const override;
+	virtual void SetShaderParameters(const FNiagaraDataInterfaceSetShaderParametersContext& Context) const override;
+
+protected:
+#if WITH_EDITORONLY_DATA
+	virtual void GetFunctionsInternal(TArray<FNiagaraFunctionSignature>& OutFunctions) const override;
+#endif
+	virtual bool CopyToInternal(UNiagaraDataInterface* Destination) const override;
+
+private:
+	void VMSampleEnvironment(FVectorVMExternalFunctionContext& Context);
+	void VMSampleWind(FVectorVMExternalFunctionContext& Context);
+};
@@ -13,6 +13,9 @@ enum class ECelestialBodyId : uint8
     Sun   UMETA(DisplayName="Sun"),
     Earth UMETA(DisplayName="Earth"),
     Moon  UMETA(DisplayName="Moon"),
+
+    // Spec-pack bodies beyond the built-ins; address these by name
+    Custom UMETA(DisplayName="Custom"),
 };
 
 USTRUCT(BlueprintType)
@@ -27,18 +27,25 @@
  * Usage:
  * 1. Place AUniversalSkyActor in level
  * 2. Configure StarfieldNiagaraSystem (or leave default)
- * 3. ApplyEnvironment() will be called automatically by subsystems
- * 4. Or manually: SkyActor->ApplyEnvironment(MediumSpec, WeatherState)
+ * 3. Time updates re-apply the environment automatically, with weather sampled
+ *    from UWeatherFieldSubsystem at the view (bUseWeatherField)
+ * 4. Or manually: SkyActor->ApplyEnvironment(MediumSpec, WeatherState); with the
+ *    field in use WeatherState becomes the field's base weather
  * 
  * Integration:
  * - EnvironmentSubsystem: Provides MediumSpec at player location
  * - SolarSystemSubsystem: Provides sun direction, moon phase
- * - TimeSubsystem: Triggers updates via OnTimeAdvanced delegate
+ * - TimeSubsystem: Triggers updates via a SubscribeSimTime subscription (TimeUpdateRateHz)
  * - StarCatalogSubsystem: Provides star data for starfield rendering
  * 
  * Performance:
- * - Starfield update rate configurable (StarfieldUpdateRateHz)
- * - Most components update only when environment changes
+ * - Starfield sidereal rotation is extrapolated on the GPU; the CPU only re-anchors it
+ *   when time scale, pause or epoch change (optional periodic resync: StarfieldUpdateRateHz)
+ * - Star arrays are uploaded once per catalog; magnitude limit and effects quality
+ *   only change User.StarCount (stars are sorted brightest first)
+ * - Each sky component is re-applied only when its own inputs move past a threshold
+ *   (SunDirectionThresholdDeg, WeatherChangeThreshold, MediumChangeThreshold)
+ * - Sky light recaptures are coalesced and rate-limited (SkyRecaptureMinIntervalSeconds)
  * - Niagara bounds configured for large-scale scenes
  * 
  * @see FRuntimeMediumSpec for atmosphere configuration
@@ -56,6 +63,7 @@
 
 // Forward declares for engine components
 class USceneComponent;
+namespace Scalability { struct FQualityLevels; }
 class UDirectionalLightComponent;
 class USkyAtmosphereComponent;
 class USkyLightComponent;
@@ -64,6 +72,9 @@ class UExponentialHeightFogComponent;
 class UPostProcessComponent;
 class UNiagaraComponent;
 class UNiagaraSystem;
+class UMaterialInterface;
+class UMaterialInstanceDynamic;
+struct FSolarSystemState;
 
 /**
  * Runtime weather state for sky rendering.
@@ -90,10 +101,10 @@ class UNiagaraSystem;
  *   Weather.CloudCover01 = 0.7f; // Mostly cloudy
  *   Weather.Fog01 = 0.3f; // Light fog
  *   Weather.WindSpeed = 10.0f; // 10 m/s wind
- *   SkyActor->ApplyEnvironment(MediumSpec, Weather);
+ *   SkyActor->ApplyEnvironment(MediumSpec, Weather); // or WeatherField->SetBaseWeather(Weather)
  * 
  * @note Values outside 0-1 are clamped internally
- * @note Future expansion may add precipitation type, storm cells, etc.
+ * @note UWeatherFieldSubsystem stores one of these per weather cell
  */
 USTRUCT(BlueprintType)
 struct UETPFCORE_API FRuntimeWeatherState
@@ -177,19 +188,80 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Sky|Starfield", meta=(ClampMin="1000.0"))
 	float StarSphereRadiusCm = 1000000.0f; // default 10 km
 
+	/**
+	 * Cooked star sprite material (StarColor/StarBrightness parameters), applied through a
+	 * dynamic instance. Null = keep the Niagara system's own material.
+	 * Generate the default asset in the editor with TPF.Editor.CreateStarMaterial.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Sky|Starfield")
+	TSoftObjectPtr<UMaterialInterface> StarMaterial = TSoftObjectPtr<UMaterialInterface>(FSoftObjectPath(TEXT("/Game/Core/Materials/M_StarProcedural.M_StarProcedural")));
+
+	/** Emissive multiplier (StarMaterial's StarBrightness parameter). Use SetStarBrightness at runtime. */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Sky|Starfield", meta=(ClampMin="0.0"))
+	float StarBrightness = 1000.0f;
+
 	/** Maximum magnitude to render (dimmer stars culled). Default 6.0 = naked eye limit */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Sky|Starfield", meta=(ClampMin="0.0", ClampMax="10.0"))
 	float MaxVisibleMagnitude = 6.0f;
 
+	/**
+	 * Magnitude limit per effects quality level (Low, Medium, High, Epic, Cinematic...).
+	 * Levels past the end use the last entry; the limit never exceeds MaxVisibleMagnitude.
+	 * Empty = MaxVisibleMagnitude at every level.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Sky|Starfield")
+	TArray<float> StarfieldQualityMagnitudeLimits = { 4.5f, 5.5f, 6.5f, 7.5f };
+
 	/** Reference celestial body for sun direction (affects physics and sky). */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Sky|Solar")
 	ECelestialBodyId ReferenceBody = ECelestialBodyId::Earth;
 
 	// --- Tuning knobs (gameplay-friendly defaults; you can adjust in BP) ---
-	/** Update rate for starfield rotation (Hz). Lower = better performance. 0 = every tick. */
+	/**
+	 * Periodic re-anchor rate for starfield rotation (Hz). 0 = never: the GPU extrapolates
+	 * from the epoch set when the sim clock rate or game epoch changes.
+	 */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Sky|Runtime", meta=(ClampMin="0.0", ClampMax="60.0"))
 	float StarfieldUpdateRateHz = 0.0f;
 
+	/** Max rate (Hz, real time) of sun/atmosphere updates from sim time changes. 0 = every time advance. Read at BeginPlay. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Sky|Runtime", meta=(ClampMin="0.0", ClampMax="120.0"))
+	float TimeUpdateRateHz = 30.0f;
+
+	/** Sim-time change (seconds) below which a time update is skipped. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Sky|Runtime", meta=(ClampMin="0.0"))
+	float MinSimSecondsBetweenUpdates = 0.01f;
+
+	/**
+	 * Wall-clock milliseconds time updates may spend in ApplyEnvironment per real second.
+	 * Over budget, the latest update waits for the next second. 0 = unlimited.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Sky|Runtime", meta=(ClampMin="0.0"))
+	float SkyUpdateBudgetMsPerSecond = 4.0f;
+
+	/** Sun moves at ~0.25 deg per sim minute; smaller moves are not re-applied (degrees). */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Sky|Runtime", meta=(ClampMin="0.0"))
+	float SunDirectionThresholdDeg = 0.05f;
+
+	/** Smallest weather change (0..1 cloud/fog/storm/humidity) that re-applies a component. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Sky|Runtime", meta=(ClampMin="0.0", ClampMax="1.0"))
+	float WeatherChangeThreshold = 0.01f;
+
+	/** Smallest relative medium change (density, pressure, temperature, irradiance) that re-applies a component. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Sky|Runtime", meta=(ClampMin="0.0", ClampMax="1.0"))
+	float MediumChangeThreshold = 0.01f;
+
+	/**
+	 * Minimum real seconds between sky light recaptures. Only used when the sky light is not
+	 * bRealTimeCapture (real-time capture already time-slices itself and is never forced).
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Sky|Runtime", meta=(ClampMin="0.0"))
+	float SkyRecaptureMinIntervalSeconds = 2.0f;
+
+	/** Sun travel (degrees) since the last capture before a recapture is requested. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Sky|Runtime", meta=(ClampMin="0.0"))
+	float SkyRecaptureSunAngleDeg = 1.0f;
+
 	/** Overall intensity scale for sun (lets you tune without touching physical proxies). */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Sky|Tuning", meta=(ClampMin="0.0"))
 	float SunIntensityScale = 1.0f;
@@ -213,6 +285,15 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Sky|State")
 	FRuntimeWeatherState CurrentWeather;
 
+	/**
+	 * Take CurrentWeather from UWeatherFieldSubsystem at the view on each time update.
+	 * ApplyEnvironment (and BeginPlay, with CurrentWeather) forwards its weather to the
+	 * field as the base weather, so manual weather persists; local weather goes through
+	 * AddWeatherStamp.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Sky|State")
+	bool bUseWeatherField = true;
+
 	/** 
 	 * Apply environment configuration to sky rendering.
 	 * 
@@ -233,6 +314,8 @@ public:
 	 * @param Medium - Atmosphere properties (density, pressure, temperature, solar direction)
 	 * @param Weather - Weather state (clouds, fog, precipitation, wind)
 	 * 
+	 * @note With bUseWeatherField, Weather is handed to UWeatherFieldSubsystem::SetBaseWeather
+	 *       and the sky shows the field's weather at the view, which relaxes toward it
 	 * @note Caches state to avoid redundant updates
 	 * @note Safe to call every frame, but typically only needed on environment change
 	 * @note Subsystems call this automatically - manual calls usually unnecessary
@@ -248,10 +331,34 @@ public:
 	UFUNCTION(BlueprintCallable, Category="Sky")
 	void ApplyEnvironment(const FRuntimeMediumSpec& Medium, const FRuntimeWeatherState& Weather);
 
+	/** Time-driven updates applied vs skipped by this actor's throttle since BeginPlay */
+	UFUNCTION(BlueprintPure, Category="Sky")
+	void GetSkyUpdateCounts(int32& OutApplied, int32& OutSkipped) const;
+
+	/** Re-apply every sky component on the next ApplyEnvironment, ignoring change thresholds */
+	UFUNCTION(BlueprintCallable, Category="Sky")
+	void MarkSkyDirty();
+
+	/** Queue a sky light recapture (rate-limited by SkyRecaptureMinIntervalSeconds) */
+	UFUNCTION(BlueprintCallable, Category="Sky")
+	void RequestSkyRecapture();
+
 	/** Get the Niagara starfield component for configuration */
 	UFUNCTION(BlueprintPure, Category="Sky")
 	UNiagaraComponent* GetStarfieldComponent() const { return StarfieldComponent; }
 
+	/** Update the star material's brightness parameter */
+	UFUNCTION(BlueprintCallable, Category="Sky|Starfield")
+	void SetStarBrightness(float InBrightness);
+
+	/** Re-apply MaxVisibleMagnitude / StarfieldQualityMagnitudeLimits without re-uploading stars */
+	UFUNCTION(BlueprintCallable, Category="Sky|Starfield")
+	void RefreshStarfieldVisibility();
+
+	/** Magnitude limit for the current effects quality level */
+	UFUNCTION(BlueprintPure, Category="Sky|Starfield")
+	float GetEffectiveStarMagnitudeLimit() const;
+
 protected:
 	virtual void BeginPlay() override;
 	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
@@ -260,24 +367,119 @@ protected:
 private:
 	float StarfieldUpdateAccumulator = 0.0f;
 	FDelegateHandle TimeAdvancedHandle;
+	FDelegateHandle SimClockChangedHandle;
+	FDelegateHandle EpochChangedHandle;
 
 	// Starfield caching (prevents re-pushing arrays + reinitializing every ApplyEnvironment call)
 	bool bStarfieldInitialized = false;
 	int32 CachedStarCount = 0;
+	float CachedStarSphereRadiusCm = 0.0f;
+
+	/** User.StarCount last pushed; INDEX_NONE until the first push after an upload */
+	int32 CachedVisibleStarCount = INDEX_NONE;
+
+	FDelegateHandle ScalabilityChangedHandle;
+	FDelegateHandle OriginRebasedHandle;
+
+	/** Dynamic instance of StarMaterial on the starfield renderer */
+	UPROPERTY(Transient)
+	TObjectPtr<UMaterialInstanceDynamic> StarMaterialInstance = nullptr;
+
+	/** An async star catalog load will call ApplyStarfield when it lands */
+	bool bWaitingForStarCatalog = false;
+
+	/** Sky components updated change-driven by ApplyEnvironment */
+	enum class ESkyComponent : uint8
+	{
+		Sun,
+		Atmosphere,
+		Fog,
+		Clouds,
+		SkyLight,
+		Count
+	};
+
+	/** Inputs each component was last applied with; empty = apply next time */
+	TArray<float> AppliedSkyInputs[static_cast<int32>(ESkyComponent::Count)];
+
+	/** Sun direction at the last sky light capture */
+	FVector CapturedSunDir = FVector::ZeroVector;
+	bool bSkyRecapturePending = false;
+	double LastSkyRecaptureRealSeconds = -UE_BIG_NUMBER;
+
+	/**
+	 * True if any input moved past its tolerance since the component was last applied;
+	 * the new inputs are then remembered as applied.
+	 */
+	bool ConsumeSkyInputs(ESkyComponent Component, TConstArrayView<float> Values, TConstArrayView<float> Tolerances);
+
+	/** Recapture now if one is pending and the interval has elapsed */
+	void UpdateSkyRecapture();
+
+	/** Per-actor throttle for time-driven ApplyEnvironment calls */
+	struct FSkyUpdateLimiter
+	{
+		double LastSimSeconds = 0.0;
+		bool bHasApplied = false;
+
+		/** Update deferred by the wall-clock budget */
+		bool bPending = false;
+		double PendingSimSeconds = 0.0;
+
+		/** Real-time window the budget is measured over */
+		double WindowStartRealSeconds = 0.0;
+		double WindowSpentSeconds = 0.0;
+
+		uint32 Applied = 0;
+		uint32 Skipped = 0;
+	};
+	FSkyUpdateLimiter TimeUpdateLimiter;
+
+	/** Per-actor log throttles (diagnostics only) */
+	struct FSkyLogState
+	{
+		bool bLoggedEnvironment = false;
+		float EnvironmentDensity = 0.0f;
+		float EnvironmentCloudCover = 0.0f;
+		FVector SunDir = FVector::ZeroVector;
+		int32 SunDiagnostics = 0;
+		int32 AtmosphereDiagnostics = 0;
+		float AtmosphereDensity = -1.0f;
+	};
+	FSkyLogState LogState;
 
 	// Event handlers
 	void OnTimeAdvanced(double NewSimTimeSeconds);
 
+	/** Apply a time update unless the limiter skips or defers it */
+	void TryTimeUpdate(double NewSimTimeSeconds);
+
+	/** Sample CurrentWeather from the weather field at the view (bUseWeatherField) */
+	void RefreshWeatherFromField();
+
+	/** ApplyEnvironment without forwarding Weather to the field (Weather is already the field's sample) */
+	void ApplyEnvironmentState(const FRuntimeMediumSpec& Medium, const FRuntimeWeatherState& Weather);
+
 	// Helpers
 	void ConfigureDefaults();
-	void ApplySun(const FRuntimeMediumSpec& Medium, const FRuntimeWeatherState& Weather);
+	void ApplySun(const FRuntimeMediumSpec& Medium, const FRuntimeWeatherState& Weather, const FSolarSystemState& SolarState);
 	void ApplyAtmosphere(const FRuntimeMediumSpec& Medium, const FRuntimeWeatherState& Weather);
 	void ApplyFog(const FRuntimeMediumSpec& Medium, const FRuntimeWeatherState& Weather);
 	void ApplyClouds(const FRuntimeMediumSpec& Medium, const FRuntimeWeatherState& Weather);
 	void ApplySkyLight(const FRuntimeMediumSpec& Medium, const FRuntimeWeatherState& Weather);
 	void ApplyStarfield();
+	void ApplyStarMaterial();
+
+	/** Set the sidereal epoch (angle, rate, world time) the starfield extrapolates from */
 	void UpdateStarfieldRotation();
 
+	/** Push User.StarCount for the current magnitude limit if it changed */
+	void UpdateStarfieldVisibleCount();
+	void HandleScalabilityChanged(const Scalability::FQualityLevels& QualityLevels);
+
+	/** Floating origin moved: the captured sky and world-space star particles are stale */
+	void HandleWorldOriginRebased(const FIntVector& ShiftCm);
+
 	/** Convert B-V color index to RGB color for star rendering */
 	FLinearColor BVIndexToColor(float BV) const;
 
@@ -64,13 +64,26 @@ class UETPFCORE_API UAtmosphereConfig : public UDataAsset
 public:
 	UAtmosphereConfig();
 
+#if WITH_EDITOR
+	virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+#endif
+
+	/**
+	 * Call after changing properties at runtime.
+	 * Atmosphere fields using this config re-bake their profile on their next query.
+	 */
+	void MarkModified() { ++Revision; }
+
+	/** Incremented on every change, used to invalidate baked profiles */
+	uint32 GetRevision() const { return Revision; }
+
 	/** Display name for this atmosphere */
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Identity")
 	FText DisplayName;
 
 	//--- Sea Level Reference ---
 	
-	/** Sea level altitude (Z coordinate in world units, cm) */
+	/** Sea level altitude (absolute Z in cm: world Z with the world origin unshifted) */
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Reference")
 	float SeaLevelAltitude = 0.0f;
 
@@ -133,6 +146,147 @@ public:
 	/** Wind gust strength (random variation, 0-1) */
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Wind", meta = (ClampMin = "0.0", ClampMax = "1.0"))
 	float WindGustStrength = 0.1f;
+
+private:
+	uint32 Revision = 0;
+};
+
+/**
+ * Altitude-dependent atmospheric properties (no wind/humidity).
+ * Also the row type of the baked profile table.
+ */
+struct FAtmosphereSample
+{
+	/** Temperature in Kelvin */
+	float Temperature = 288.15f;
+	/** Pressure in kPa */
+	float Pressure = 101.325f;
+	/** Density in kg/m³ */
+	float Density = 1.225f;
+	/** Speed of sound in m/s (0 in vacuum) */
+	float SpeedOfSound = 343.0f;
+};
+
+/**
+ * Immutable copy of an atmosphere config's model parameters.
+ * Every query is a pure function of location, so one model can be
+ * evaluated from any number of threads at once.
+ * A default-constructed model (no config) yields default FAtmosphereState values.
+ *
+ * Profile:
+ * Constructing from a config bakes temperature/pressure/density/speed of sound
+ * at ProfileSampleCount evenly spaced altitudes between sea level and
+ * AtmosphereTopAltitude. Altitude queries are then a clamped index and one lerp
+ * between two adjacent rows (32 bytes) instead of an Exp and a Sqrt.
+ * The table is shared between copies, so snapshots stay cheap to take.
+ */
+struct UETPFCORE_API FAtmosphereModel
+{
+	/** Rows in the baked profile (~100m spacing for a 100km atmosphere) */
+	static constexpr int32 ProfileSampleCount = 1024;
+
+	FAtmosphereModel() = default;
+
+	/** @param WorldOriginZ - UWorld::OriginLocation.Z, so world-space queries keep absolute altitudes */
+	explicit FAtmosphereModel(const UAtmosphereConfig& Config, float WorldOriginZ = 0.0f);
+
+	/**
+	 * Evaluate every atmospheric property at a location in one pass.
+	 * Thermodynamic properties come from the baked profile.
+	 *
+	 * @param TimeSeconds - Gust field time (world seconds); same inputs always give the same wind
+	 */
+	void Evaluate(const FVector& WorldLocation, FAtmosphereState& OutState, double TimeSeconds = 0.0) const;
+
+	/**
+	 * Fused temperature/pressure/density/speed of sound at an altitude.
+	 * Above AtmosphereTopAltitude this is vacuum (matching Evaluate).
+	 *
+	 * @param AltitudeCm - Height above sea level (cm)
+	 */
+	FAtmosphereSample EvaluateAltitude(float AltitudeCm) const;
+
+	/**
+	 * Batch version of EvaluateAltitude for per-body/per-particle sampling.
+	 * Single-threaded and allocation-free; callers split large batches themselves.
+	 *
+	 * @param AltitudesCm - Heights above sea level (cm)
+	 * @param OutSamples - One sample per altitude (same length as AltitudesCm)
+	 */
+	void EvaluateAltitudes(TConstArrayView<float> AltitudesCm, TArrayView<FAtmosphereSample> OutSamples) const;
+
+	/** Closed-form model the profile is baked from (one Exp + one Sqrt) */
+	FAtmosphereSample EvaluateAltitudeAnalytic(float AltitudeCm) const;
+
+	/** True if density at this sample is below the vacuum threshold */
+	bool IsVacuum(const FAtmosphereSample& Sample) const
+	{
+		return bHasConfig && Sample.Density < VacuumDensityThreshold;
+	}
+
+	/** Base wind + altitude scaling + gust noise (cm/s) */
+	FVector GetWindAtLocation(const FVector& WorldLocation, double TimeSeconds = 0.0) const;
+
+	/**
+	 * Gust noise (cm/s): gradient noise over a fixed 256³ lattice, sampled at the
+	 * location carried back along the base wind and slowly evolving with time.
+	 * A pure function of location and time - no shared state, safe from any thread.
+	 */
+	FVector GetGustNoise(const FVector& WorldLocation, double TimeSeconds = 0.0) const;
+
+	//--- Gust lattice (also evaluated on the GPU by UNiagaraDataInterfaceEnvironment) ---
+
+	/** The gust lattice repeats every GustLatticePeriod units on each axis */
+	static constexpr int32 GustLatticePeriod = 256;
+
+	/** Lattice units per cm - gusts roughly 200m across */
+	static constexpr double GustSpatialFrequency = 1.0 / 20000.0;
+
+	/** Lattice units per second the gust pattern evolves, on top of drifting with the base wind */
+	static constexpr double GustEvolutionRate = 0.05;
+
+	/** Per-axis lattice offsets so the three gust components are uncorrelated */
+	static const FVector3f GustAxisOffsets[3];
+
+	/** Lattice point a location maps to at a time (before the per-axis offset, not wrapped) */
+	FVector GetGustLatticePoint(const FVector& WorldLocation, double TimeSeconds) const;
+
+	/** Gust speed (cm/s) of a unit noise value; 0 when gusts are off */
+	float GetGustAmplitude() const;
+
+	/**
+	 * Periodic gradient noise in about [-1, 1] (hashed lattice, GustLatticePeriod period).
+	 * Integer hashing only, so the HLSL copy in UNiagaraDataInterfaceEnvironment matches it.
+	 */
+	static float SampleGustLattice(const FVector3f& LatticePoint);
+
+	/** Map an atmosphere state to an environment context */
+	static FEnvironmentContext MakeEnvironmentContext(const FAtmosphereState& AtmoState);
+
+	bool bHasConfig = false;
+	float SeaLevelAltitude = 0.0f;
+	float SeaLevelPressure = 101.325f;
+	float SeaLevelTemperature = 288.15f;
+	float SeaLevelDensity = 1.225f;
+	float TemperatureLapseRate = 0.65f;
+	float PressureScaleHeight = 8500.0f;
+	float AtmosphereTopAltitude = 10000000.0f;
+	float VacuumDensityThreshold = 0.00001f;
+	float SpecificGasConstant = 287.05f;
+	float HeatCapacityRatio = 1.4f;
+	FVector BaseWindVelocity = FVector::ZeroVector;
+	float WindAltitudeScale = 1.0f;
+	float WindGustStrength = 0.1f;
+
+private:
+	/** Bake Profile from the parameters above */
+	void BakeProfile();
+
+	/** ProfileSampleCount rows from sea level to AtmosphereTopAltitude; null without a config */
+	TSharedPtr<const TArray<FAtmosphereSample>, ESPMode::ThreadSafe> Profile;
+
+	/** Rows per cm of altitude */
+	float ProfileSamplesPerCm = 0.0f;
 };
 
 /**
@@ -173,7 +327,7 @@ public:
 
 	/**
 	 * Get pressure at altitude.
-	 * Uses barometric formula: P = P0 * exp(-h/H)
+	 * Uses barometric formula: P = P0 * exp(-h/H), read from the baked profile.
 	 * 
 	 * @param Altitude - Height above sea level (cm)
 	 * @return Pressure in kPa
@@ -213,7 +367,7 @@ public:
 
 	/**
 	 * Get wind velocity at location.
-	 * Includes base wind + altitude scaling + gust noise.
+	 * Includes base wind + altitude scaling + gust noise at the current world time.
 	 * 
 	 * @param WorldLocation - Location to query (cm)
 	 * @return Wind velocity in cm/s
@@ -237,6 +391,37 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Atmosphere")
 	FEnvironmentContext CreateEnvironmentContextAtLocation(const FVector& WorldLocation) const;
 
+	/**
+	 * Batch version of CreateEnvironmentContextAtLocation.
+	 * Large batches are split across worker threads.
+	 * 
+	 * @param WorldLocations - Locations to query (cm)
+	 * @param OutContexts - One context per location (same length as WorldLocations)
+	 */
+	void CreateEnvironmentContextsAtLocations(TConstArrayView<FVector> WorldLocations,
+		TArrayView<FEnvironmentContext> OutContexts) const;
+
+	/**
+	 * Temperature/pressure/density/speed of sound for many altitudes at once.
+	 * Large batches are split across worker threads.
+	 *
+	 * @param AltitudesCm - Heights above sea level (cm)
+	 * @param OutSamples - One sample per altitude (same length as AltitudesCm)
+	 */
+	void GetAtmosphereSamplesAtAltitudes(TConstArrayView<float> AltitudesCm,
+		TArrayView<FAtmosphereSample> OutSamples) const;
+
+	/** Batches larger than this are evaluated with ParallelFor */
+	static constexpr int32 ParallelBatchSize = 256;
+
+	/**
+	 * Snapshot of the current config for thread-safe evaluation.
+	 * Re-take it after changing AtmosphereConfig or its properties.
+	 * The profile is re-baked only when AtmosphereConfig or its revision changes;
+	 * otherwise this is a shared-pointer copy. Game thread only.
+	 */
+	FAtmosphereModel GetAtmosphereModel() const;
+
 protected:
 	/** Convert world Z to altitude above sea level (in meters for calculations) */
 	float WorldZToAltitudeMeters(float WorldZ) const;
@@ -244,6 +429,19 @@ protected:
 	/** Calculate wind gust noise at a location */
 	FVector CalculateGustNoise(const FVector& Location) const;
 
-	/** Cached random stream for wind gusts */
-	mutable FRandomStream GustRandomStream;
+	/** Time the gust field is sampled at (world seconds, follows pause and dilation) */
+	double GetGustTimeSeconds() const;
+
+	/** Current model, re-baked when the config, its revision or the world origin changes */
+	const FAtmosphereModel& GetCachedModel() const;
+
+	/** UWorld::OriginLocation.Z (0 without a world) */
+	float GetWorldOriginZ() const;
+
+private:
+	mutable FAtmosphereModel CachedModel;
+	mutable TWeakObjectPtr<const UAtmosphereConfig> CachedModelConfig;
+	mutable uint32 CachedModelRevision = 0;
+	mutable float CachedModelOriginZ = 0.0f;
+	mutable bool bCachedModelValid = false;
 };
@@ -0,0 +1,72 @@
+// Copyright 2026 Threaded Pixel Factory
+// Licensed under the Apache License, Version 2.0 (the "License");
+// SPDX-License-Identifier: Apache-2.0
+
+/**
+ * Ephemeris Table - Piecewise Chebyshev fit of a vector quantity over time
+ *
+ * Purpose:
+ * Body positions are smooth in time, so over a short segment they are matched to
+ * well below visual precision by a low-degree Chebyshev polynomial per axis.
+ * A table fits an expensive model once over a date range, after which evaluation
+ * is a segment lookup plus a Clenshaw recurrence (Degree multiply-adds per axis).
+ *
+ * Layout:
+ * - The range [StartJD, StartJD + NumSegments * SegmentDays) is split into equal segments
+ * - Each segment stores NumCoefficients coefficients for X, Y and Z (value) and the
+ *   same for the derivative, so rates come at the same cost as positions
+ *
+ * Sizing: 1-day segments at degree 12 fit the Moon far below a metre; 8-day segments
+ * at degree 10 are plenty for the Sun direction. A year of both is ~250 KB.
+ *
+ * @see USolarSystemSubsystem for the tables it builds and the analytic fallback
+ */
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+struct UETPFCORE_API FEphemerisTable
+{
+	/**
+	 * Fit Function over [InStartJD, InStartJD + InRangeDays).
+	 * @param Degree - Polynomial degree per segment (coefficients = Degree + 1)
+	 * @param Function - Model to sample at Chebyshev nodes; called (Degree + 1) x segments times
+	 */
+	void Build(double InStartJD, double InRangeDays, double InSegmentDays, int32 Degree, TFunctionRef<FVector3d(double JulianDate)> Function);
+
+	void Reset();
+
+	bool IsValid() const { return NumSegments > 0; }
+
+	/** Whether JulianDate falls inside the fitted range */
+	bool Covers(double JulianDate) const
+	{
+		return IsValid() && JulianDate >= StartJD && JulianDate < StartJD + NumSegments * SegmentDays;
+	}
+
+	double GetStartJD() const { return StartJD; }
+	double GetEndJD() const { return StartJD + NumSegments * SegmentDays; }
+
+	/** @return false (OutValue untouched) outside the fitted range */
+	bool Evaluate(double JulianDate, FVector3d& OutValue) const;
+
+	/** Value and its rate of change per day; false outside the fitted range */
+	bool Evaluate(double JulianDate, FVector3d& OutValue, FVector3d& OutRatePerDay) const;
+
+	SIZE_T GetAllocatedSize() const { return Coefficients.GetAllocatedSize(); }
+
+private:
+	double StartJD = 0.0;
+	double SegmentDays = 1.0;
+	int32 NumSegments = 0;
+	int32 NumCoefficients = 0;
+
+	/** Per segment: value X, Y, Z then derivative X, Y, Z, NumCoefficients each */
+	TArray<double> Coefficients;
+
+	/** Segment index and normalized time [-1, 1] within it */
+	int32 Locate(double JulianDate, double& OutTau) const;
+
+	const double* GetSegment(int32 Segment) const { return Coefficients.GetData() + Segment * 6 * NumCoefficients; }
+};
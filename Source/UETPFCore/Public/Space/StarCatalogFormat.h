@@ -0,0 +1,129 @@
+// Copyright 2026 Threaded Pixel Factory
+// Licensed under the Apache License, Version 2.0 (the "License");
+// SPDX-License-Identifier: Apache-2.0
+
+/**
+ * Star Catalog Format - Packed in-memory catalog and its binary cache file
+ *
+ * Purpose:
+ * The HYG CSV is convenient to generate but slow to load: every field of every row
+ * becomes an FString. The packed catalog keeps stars as parallel arrays plus one
+ * UTF-8 string table, and its binary file is a header followed by those arrays
+ * verbatim, so loading is one bulk read and a handful of memcpys.
+ *
+ * Binary Layout (little endian):
+ *   Header:
+ *     uint32  Magic            'TPFS'
+ *     uint16  Version          StarCatalogFormat::CurrentVersion
+ *     uint16  Flags            0
+ *     int64   SourceBytes      Size of the CSV the cache was built from
+ *     int64   SourceTimestamp  CSV modification time (FDateTime ticks)
+ *     int32   MaxStars         Star cap the CSV was parsed with
+ *     int32   NumStars
+ *     int32   StringTableBytes
+ *   Arrays (NumStars elements each unless noted):
+ *     int32   Ids
+ *     double  Directions[3]    Unit vectors, equatorial J2000
+ *     float   Magnitudes
+ *     float   ColorIndices     B-V
+ *     float   Distances        Parsecs
+ *     int32   StringOffsets[NumStrings]  Offsets into the string table per star
+ *     char    StringTable[StringTableBytes]  Null-terminated UTF-8, deduplicated
+ *
+ * Cache Lookup (see UStarCatalogSubsystem):
+ * - A .tpfstars file next to the CSV is used as-is when the CSV is absent
+ *   (cooked/staged builds ship only the binary)
+ * - Otherwise the cache under Saved/StarCatalog is used if its source stamp
+ *   matches the CSV, and rebuilt from the CSV if not
+ *
+ * @see UStarCatalogSubsystem for the owner of the loaded catalog
+ */
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/** Per-star strings stored in the string table, in StringOffsets order */
+enum class EStarString : uint8
+{
+	Name,
+	ProperName,
+	BayerFlamsteed,
+	SpectralType,
+	Constellation,
+	Count
+};
+
+/**
+ * Star catalog as parallel arrays (one element per star) plus a string table.
+ * Plain data - safe to build on a worker and move to the game thread.
+ */
+struct UETPFCORE_API FPackedStarCatalog
+{
+	static constexpr int32 NumStrings = static_cast<int32>(EStarString::Count);
+
+	TArray<int32> Ids;
+	TArray<FVector3d> Directions;
+	TArray<float> Magnitudes;
+	TArray<float> ColorIndices;
+	TArray<float> Distances;
+
+	/** NumStrings offsets per star into StringTable; offset 0 is the empty string */
+	TArray<int32> StringOffsets;
+
+	/** Null-terminated UTF-8 strings, each distinct string stored once */
+	TArray<ANSICHAR> StringTable;
+
+	int32 Num() const { return Ids.Num(); }
+
+	void Reset();
+
+	/** Decode one of a star's strings (allocates; keep off hot paths) */
+	FString GetString(int32 StarIndex, EStarString Field) const;
+};
+
+namespace StarCatalogFormat
+{
+	/** 'TPFS' */
+	constexpr uint32 Magic = 0x53465054;
+
+	/** Bump when the layout changes; older caches are rebuilt */
+	constexpr uint16 CurrentVersion = 1;
+
+	/** Binary cache extension */
+	inline const TCHAR* CacheExtension = TEXT("tpfstars");
+
+	/** Identifies the CSV a cache was built from */
+	struct FSourceStamp
+	{
+		int64 SourceBytes = 0;
+		int64 SourceTimestamp = 0;
+		int32 MaxStars = 0;
+
+		bool operator==(const FSourceStamp& Other) const
+		{
+			return SourceBytes == Other.SourceBytes && SourceTimestamp == Other.SourceTimestamp && MaxStars == Other.MaxStars;
+		}
+		bool operator!=(const FSourceStamp& Other) const { return !(*this == Other); }
+	};
+
+	/** Stamp for a CSV on disk; false if the file does not exist */
+	UETPFCORE_API bool GetSourceStamp(const FString& CsvPath, int32 MaxStars, FSourceStamp& OutStamp);
+
+	/**
+	 * Parse HYG CSV bytes (id,name,proper,bf,ra,dec,mag,ci,dist,x,y,z,spect,con) without
+	 * per-field allocation. Rows that are short, non-finite or have no direction are skipped.
+	 * @return false if there is no data row
+	 */
+	UETPFCORE_API bool ParseCsv(TConstArrayView<uint8> CsvBytes, int32 MaxStars, FPackedStarCatalog& OutCatalog);
+
+	/** Encode a catalog and the stamp of the CSV it came from */
+	UETPFCORE_API void WriteBinary(const FPackedStarCatalog& Catalog, const FSourceStamp& Stamp, TArray<uint8>& OutBytes);
+
+	/**
+	 * Decode a binary cache.
+	 * @param ExpectedStamp - Reject caches built from a different CSV; null accepts any
+	 * @return false on bad magic, unsupported version, stale stamp or truncated data
+	 */
+	UETPFCORE_API bool ReadBinary(TConstArrayView<uint8> Bytes, const FSourceStamp* ExpectedStamp, FPackedStarCatalog& OutCatalog);
+}
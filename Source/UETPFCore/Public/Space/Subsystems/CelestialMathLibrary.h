@@ -43,6 +43,15 @@
  *   float Intensity = UCelestialMathLibrary::MagToIntensity(-1.46f); // Sirius magnitude
  * \endcode
  * 
+ * Batch Conversions:
+ * - C++-only overloads over contiguous arrays (EquatorialDirs_FromRaDec,
+ *   MagsToIntensities, StarColors_FromBVIndices, ParsecsToCentimeters)
+ * - Four entries per step with VectorRegister math; the last partial step is
+ *   padded, so every entry takes the same path
+ * - For catalog builds and procedural star fields with millions of entries
+ * - Results match the scalar functions to float precision (the batch trig and
+ *   exp2 are float approximations); colours match exactly
+ * 
  * @see USolarSystemSubsystem for stateful astronomy engine
  * @see UWorldFrameSubsystem for coordinate transforms
  * @see UStarCatalogSubsystem for star database
@@ -51,6 +60,7 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "Containers/ArrayView.h"
 #include "Kismet/BlueprintFunctionLibrary.h"
 #include "CelestialMathLibrary.generated.h"
 
@@ -120,6 +130,13 @@ public:
 	UFUNCTION(BlueprintPure, Category="Space|Rendering")
 	static float MagToIntensity(float ApparentMag, float kExposure = 1.0f);
 
+	/**
+	 * Star tint from its B-V colour index, stepped by Harvard spectral class (O to M).
+	 * Alpha is 1; brightness comes from magnitude, not the colour.
+	 */
+	UFUNCTION(BlueprintPure, Category="Space|Rendering")
+	static FLinearColor StarColor_FromBVIndex(float BV);
+
 	/**
 	 * Approximate sidereal angle (Greenwich Mean Sidereal Time) in radians.
 	 * Input: Unix-like seconds since an epoch you define. For now we assume:
@@ -130,4 +147,19 @@ public:
 	 */
 	UFUNCTION(BlueprintPure, Category="Space|Time")
 	static double ApproxGMST_Radians(double SimTimeSeconds, double EarthSiderealDaySeconds = 86164.0905);
+
+	// ---------------- Batch conversions ----------------
+	// All arrays of one call have the same length; outputs may not alias inputs.
+
+	/** EquatorialDir_FromRaDec per entry (RA hours, Dec degrees), float precision */
+	static void EquatorialDirs_FromRaDec(TConstArrayView<float> RaHours, TConstArrayView<float> DecDegrees, TArrayView<FVector3f> OutDirs);
+
+	/** ParsecsToCentimeters per entry */
+	static void ParsecsToCentimeters(TConstArrayView<double> Parsecs, TArrayView<double> OutCentimeters);
+
+	/** MagToIntensity per entry */
+	static void MagsToIntensities(TConstArrayView<float> ApparentMags, TArrayView<float> OutIntensities, float kExposure = 1.0f);
+
+	/** StarColor_FromBVIndex per entry */
+	static void StarColors_FromBVIndices(TConstArrayView<float> BVIndices, TArrayView<FLinearColor> OutColors);
 };
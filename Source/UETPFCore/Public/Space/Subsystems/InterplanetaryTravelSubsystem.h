@@ -11,14 +11,34 @@
  * 
  * Architecture:
  * - GameInstance subsystem (persists across level loads)
- * - Does NOT handle anchoring (that's WorldFrameSubsystem's job)
+ * - Does NOT handle anchoring in OpenLevel/SeamlessTravel modes (that's WorldFrameSubsystem's job)
  * - Preserves TimeSubsystem state across transitions
  * - Preserves SolarSystemSubsystem state (sun/moon positions)
  * 
+ * Travel Modes (TravelMode):
+ * - OpenLevel: UGameplayStatics::OpenLevel. Blocking load; tears down the world
+ *   and every UWorldSubsystem.
+ * - SeamlessTravel: UWorld::ServerTravel with the game mode's bUseSeamlessTravel.
+ *   The destination loads asynchronously behind the transition map; world
+ *   subsystems are still recreated for the new world.
+ * - LevelStreaming: destinations are streamed into the current (persistent) world
+ *   as level instances. The outgoing destination unloads once the new one is
+ *   visible, so world subsystems (environment volumes, biome caches, physics
+ *   registrations) stay warm. Streamed levels have no game mode, so this subsystem
+ *   sets the world frame anchor from the destination's anchor body.
+ * 
+ * Preloading:
+ * - PreloadDestination() starts an async load of a destination map package while
+ *   the player is still in transit, and broadcasts the static OnTravelPreload so game
+ *   modules (SinglePlayerStoryTemplate) can warm the destination's SpecPacks
+ * - The preloaded UWorld is held until the destination has loaded (PostLoadMap or
+ *   level shown), so travel finds it already resident
+ * - OnTravelCompleted fires once the destination is loaded, in every travel mode
+ * 
  * Travel Flow:
  * 1. Player initiates travel (e.g., clicks "Travel to Moon")
  * 2. TravelToMoon() called
- * 3. Current map unloads
+ * 3. Current map unloads (or streams out after the new one is visible)
  * 4. Moon map loads
  * 5. Moon map's WorldFrameSubsystem sets AnchorBody = Moon
  * 6. Time continues, astronomy remains consistent
@@ -41,10 +61,10 @@
  * Usage:
  * \code{.cpp}
  *   UInterplanetaryTravelSubsystem* Travel = GameInstance->GetSubsystem<UInterplanetaryTravelSubsystem>();
- *   Travel->TravelToMoon(); // Loads moon map
+ *   Travel->PreloadDestination(Travel->MoonMap); // While in transit
+ *   Travel->TravelToMoon();
  * \endcode
  * 
- * @note Does not handle anchoring - each map sets its own anchor
  * @note Preserves all GameInstance subsystems across transitions
  * @see UWorldFrameSubsystem for per-world anchoring
  * @see UTimeSubsystem for continuous time
@@ -54,14 +74,30 @@
 
 #include "CoreMinimal.h"
 #include "Subsystems/GameInstanceSubsystem.h"
+#include "Engine/EngineBaseTypes.h"
 #include "Environment/SkyContext.h"
 #include "InterplanetaryTravelSubsystem.generated.h"
 
+class UWorld;
+class ULevelStreamingDynamic;
+
+UENUM(BlueprintType)
+enum class ETravelMode : uint8
+{
+    OpenLevel       UMETA(DisplayName="Open Level"),
+    SeamlessTravel  UMETA(DisplayName="Seamless Travel"),
+    LevelStreaming  UMETA(DisplayName="Level Streaming"),
+};
+
+/** Fired with the destination map name */
+DECLARE_MULTICAST_DELEGATE_OneParam(FOnTravelDestination, FName /*Map*/);
+
 /**
  * Owns map transitions between Earth/Travel/Moon.
  * Keeps solar/time continuous while swapping worlds.
  * 
  * Important: Travel subsystem does not do anchoring — anchoring is done in each map via WorldFrameSubsystem.SetAnchorBody().
+ * The exception is LevelStreaming mode, where destinations have no game mode of their own.
  */
 UCLASS()
 class UETPFCORE_API UInterplanetaryTravelSubsystem : public UGameInstanceSubsystem
@@ -69,6 +105,8 @@ class UETPFCORE_API UInterplanetaryTravelSubsystem : public UGameInstanceSubsyst
     GENERATED_BODY()
 
 public:
+    virtual void Deinitialize() override;
+
     UFUNCTION(BlueprintCallable, Category="Travel")
     void TravelToEarth();
 
@@ -88,6 +126,74 @@ public:
     UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Travel")
     FName SpaceMap = "Lvl_SpaceTravel";
 
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Travel")
+    ETravelMode TravelMode = ETravelMode::OpenLevel;
+
+    // Anchor applied when streaming into the space map (Earth/Moon maps anchor to themselves).
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Travel")
+    ECelestialBodyId SpaceAnchorBody = ECelestialBodyId::Earth;
+
+    /**
+     * Start loading a destination map package in the background and let game modules
+     * warm its SpecPacks (OnTravelPreload). Safe to call repeatedly.
+     */
+    UFUNCTION(BlueprintCallable, Category="Travel")
+    void PreloadDestination(FName Map);
+
+    /** Drop preloaded packages that were never travelled to. */
+    UFUNCTION(BlueprintCallable, Category="Travel")
+    void ReleasePreloadedDestinations();
+
+    UFUNCTION(BlueprintPure, Category="Travel")
+    bool IsTravelInProgress() const { return !PendingTravelMap.IsNone(); }
+
+    // PreloadDestination started a load (SpecPacks, caches). Static so modules can bind at startup.
+    static FOnTravelDestination& OnTravelPreload();
+
+    // The destination map has loaded (OpenLevel/SeamlessTravel) or is visible (streaming).
+    FOnTravelDestination OnTravelCompleted;
+
 private:
     void OpenMap(FName Map);
+
+    // OpenLevel or ServerTravel; the travel completes in HandlePostLoadMap
+    void TravelByLoadMap(UWorld* World, FName Map);
+
+    void HandlePostLoadMap(UWorld* LoadedWorld);
+
+    void HandleTravelFailure(UWorld* World, ETravelFailure::Type FailureType, const FString& ErrorString);
+
+    void ClearLoadMapTravel();
+
+    void StreamMap(FName Map);
+
+    // Long package name for a short map name ("Lvl_Moon" -> "/Game/Maps/Lvl_Moon")
+    static FString ResolveMapPackage(FName Map);
+
+    ECelestialBodyId GetAnchorForMap(FName Map) const;
+
+    // TPF timing session covering one travel ("Travel_Lvl_Moon")
+    static FString GetTimingSessionName(FName Map);
+
+    UFUNCTION()
+    void HandleStreamedLevelShown();
+
+    // Map currently being travelled to (None when idle)
+    FName PendingTravelMap;
+
+    UPROPERTY()
+    TObjectPtr<ULevelStreamingDynamic> PendingStreamingLevel;
+
+    UPROPERTY()
+    TObjectPtr<ULevelStreamingDynamic> CurrentStreamingLevel;
+
+    // Keeps async-preloaded map worlds (and so their packages) resident until loaded into or released
+    UPROPERTY()
+    TMap<FName, TObjectPtr<UWorld>> PreloadedMaps;
+
+    TSet<FName> PreloadsInFlight;
+
+    FDelegateHandle PostLoadMapHandle;
+
+    FDelegateHandle TravelFailureHandle;
 };
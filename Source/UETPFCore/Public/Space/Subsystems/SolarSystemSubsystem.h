@@ -18,6 +18,14 @@
  * - Sun direction computed from time
  * - Units: kilometers for positions, km/s for velocities
  * 
+ * Body Table:
+ * - Bodies and their orbit models come from a spec pack (BodySpecPackPath,
+ *   "celestial_bodies" array); the built-in Sun/Earth/Moon table is the fallback
+ * - Each body is fixed, placed along the sun direction, or on a circular orbit
+ *   around a parent; parents are evaluated before their children
+ * - All bodies are evaluated together into one FSolarSystemSnapshot per sim time,
+ *   which GetBodyState and UWorldFrameSubsystem read by index
+ * 
  * Time Anchoring:
  * Two modes controlled by bUseUnixEpochTime:
  * 1. Unix Epoch Mode (bUseUnixEpochTime=true):
@@ -28,6 +36,22 @@
  *    - SimTimeSeconds=0 anchored to GameEpochUnixSeconds
  *    - Allows fictional timelines while preserving astronomy
  * 
+ * Ephemeris Tables:
+ * - At Initialize the sun and moon models are fitted to Chebyshev tables
+ *   (FEphemerisTable) over EphemerisRangeDays; queries inside the range cost a few
+ *   multiply-adds, queries outside it fall back to the analytic models
+ *
+ * Warm-up:
+ * - Initialize installs the built-in table, then parses the spec pack and fits
+ *   the tables on a worker (WarmUpAsync); the result swaps in on the game thread
+ * - Until then queries answer from the built-in bodies and the analytic models
+ * - LoadBodySpecPack and RebuildEphemeris finish a pending warm-up first
+ * - GMST is a closed-form linear function of time and is never tabulated
+ * 
+ * Rewind:
+ * - The snapshot is a pure function of sim time, so it registers no UTimeSubsystem
+ *   rewind state; any time change (rewinds included) recomputes it on the next query
+ * 
  * Accuracy:
  * - NOT a full ephemeris - simplified models for performance
  * - Accurate enough for visual/gameplay purposes (< 1° error)
@@ -48,10 +72,26 @@
 
 #include "CoreMinimal.h"
 #include "Environment/SkyContext.h"
+#include "Space/EphemerisTable.h"
 #include "Subsystems/GameInstanceSubsystem.h"
+#include "Tasks/Task.h"
 #include "SolarSystemSubsystem.generated.h"
 
 
+/** How a body's canonical position is derived each evaluation */
+UENUM(BlueprintType)
+enum class ECelestialOrbitModel : uint8
+{
+	/** At its parent's position (or the origin without a parent) */
+	Fixed			UMETA(DisplayName="Fixed"),
+
+	/** Along the computed sun direction at OrbitRadiusKm from the origin */
+	SunDirection	UMETA(DisplayName="Sun Direction"),
+
+	/** Circular inclined orbit around the parent */
+	Circular		UMETA(DisplayName="Circular"),
+};
+
 /**
  * Static definition for a celestial body (design-time constants).
  * 
@@ -85,6 +125,36 @@ struct UETPFCORE_API FCelestialBodyDef
 	/** Does this body have clouds? (affects rendering) */
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Body")
 	bool bHasClouds = false;
+
+	/** Spec pack name; built-ins are "Sun", "Earth" and "Moon" */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Body")
+	FName Name;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Orbit")
+	ECelestialOrbitModel OrbitModel = ECelestialOrbitModel::Fixed;
+
+	/** Body this one orbits (None = canonical origin) */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Orbit")
+	FName ParentName;
+
+	/** Orbit radius, or distance along the sun direction (km) */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Orbit")
+	double OrbitRadiusKm = 0.0;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Orbit")
+	double OrbitPeriodS = 0.0;
+
+	/** Tilt of the orbit plane about canonical X (vernal equinox) */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Orbit")
+	double OrbitInclinationDeg = 0.0;
+
+	/** Rotation of the tilted plane about canonical Z */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Orbit")
+	double OrbitAscendingNodeDeg = 0.0;
+
+	/** Orbit angle at the Unix epoch */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category="Orbit")
+	double OrbitPhaseDeg = 0.0;
 };
 
 /**
@@ -119,6 +189,26 @@ struct UETPFCORE_API FCelestialBodyState
 	FVector VelocityKmS = FVector::ZeroVector;  // Changed to FVector for Blueprint compatibility
 };
 
+/**
+ * Every body's state at one sim time, as parallel arrays in body-table order
+ * (see USolarSystemSubsystem::GetBodyIndex / FindBodyIndex).
+ * Rebuilt once per distinct sim time; world frames and the sky read it by index.
+ */
+struct UETPFCORE_API FSolarSystemSnapshot
+{
+	double SimUnixSeconds = -1.0;
+	double JulianDate = 0.0;
+	double GMSTRad = 0.0;
+
+	/** Unit direction from Earth to the Sun */
+	FVector3d SunDir = FVector3d(1, 0, 0);
+
+	TArray<FVector3d> PositionsKm;
+	TArray<FVector3d> VelocitiesKmS;
+
+	int32 Num() const { return PositionsKm.Num(); }
+};
+
 /**
  * Consolidated solar system state for rendering/physics.
  * Single truth for sun direction, moon phase, starfield rotation, etc.
@@ -220,7 +310,7 @@ struct UETPFCORE_API FEnvironmentState
  *   Get Game Instance -> Get Subsystem (Solar System) -> Get Sun Dir Canonical
  * 
  * Performance:
- * - Calculations are O(1) trigonometry, very cheap
+ * - Calculations are O(bodies) per sim time: table lookups in range, trigonometry outside it
  * - Results cached between time updates
  * - Safe to query every frame from multiple systems
  * 
@@ -252,9 +342,23 @@ public:
 	double GameEpochUnixSeconds = 1704067200.0; // 2024-01-01 00:00:00 UTC
 
 	UFUNCTION(BlueprintCallable, Category="Solar|Time")
-	void SetGameEpochUnixSeconds(double InUnixSeconds) { GameEpochUnixSeconds = InUnixSeconds; }
+	void SetGameEpochUnixSeconds(double InUnixSeconds);
+
+	/** Fires when GameEpochUnixSeconds changes (sky/GMST jump without sim time moving) */
+	FSimpleMulticastDelegate OnEpochChanged;
 
 	// ---------------- Body def/state ----------------
+	/** Spec pack with the "celestial_bodies" table, relative to the project Content directory */
+	UPROPERTY(EditAnywhere, Category="Solar|Bodies")
+	FString BodySpecPackPath = TEXT("SpecPacks/SolarSystem.json");
+
+	/**
+	 * Replace the body table with a spec pack's "celestial_bodies" array.
+	 * @return false (table unchanged) if the file is unreadable, has no bodies, or a parent is missing or cyclic
+	 */
+	UFUNCTION(BlueprintCallable, Category="Solar|Bodies")
+	bool LoadBodySpecPack(const FString& FilePath);
+
 	UFUNCTION(BlueprintCallable, Category="Solar|Bodies")
 	FCelestialBodyDef GetBodyDef(ECelestialBodyId Body) const;
 
@@ -265,6 +369,25 @@ public:
 	UFUNCTION(BlueprintCallable, Category="Solar|Bodies")
 	FCelestialBodyState GetBodyState(ECelestialBodyId Body) const;
 
+	UFUNCTION(BlueprintPure, Category="Solar|Bodies")
+	int32 GetNumBodies() const { return Bodies.Num(); }
+
+	/** Snapshot index of a built-in body, INDEX_NONE if the table lacks it */
+	int32 GetBodyIndex(ECelestialBodyId Body) const;
+
+	/** Snapshot index of a body by spec pack name, INDEX_NONE if unknown */
+	UFUNCTION(BlueprintPure, Category="Solar|Bodies")
+	int32 FindBodyIndex(FName BodyName) const;
+
+	/** Body definitions in snapshot order */
+	TConstArrayView<FCelestialBodyDef> GetBodyDefs() const { return Bodies; }
+
+	/** Copy every body's state (snapshot order) into OutStates; extra elements are untouched */
+	void GetAllBodyStates(TArrayView<FCelestialBodyState> OutStates) const;
+
+	/** All bodies at the current sim time; valid until the next sim time change or table reload */
+	const FSolarSystemSnapshot& GetSnapshot() const;
+
 	// ---------------- Key Outputs ----------------
 	/** Sun direction in canonical frame (unit vector). */
 	UFUNCTION(BlueprintCallable, Category="Solar|Outputs")
@@ -298,6 +421,7 @@ public:
 	FSolarSystemState GetSolarSystemState() const;
 
 	// ---------------- Tunables ----------------
+	// Moon orbit for the built-in table (spec packs define their own)
 	UPROPERTY(EditAnywhere, Category="Solar|Moon")
 	float EarthMoonDistanceKm = 384400.0f;
 
@@ -307,9 +431,61 @@ public:
 	UPROPERTY(EditAnywhere, Category="Solar|Moon")
 	float MoonInclinationDeg = 5.145f;
 
+	// ---------------- Ephemeris Tables ----------------
+	/** Evaluate the sun and orbiting bodies from precomputed tables inside the covered range. */
+	UPROPERTY(EditAnywhere, Category="Solar|Ephemeris")
+	bool bUseEphemerisTables = true;
+
+	/** First covered date (Unix seconds). 0 = EphemerisLeadDays before the sim time at Initialize. */
+	UPROPERTY(EditAnywhere, Category="Solar|Ephemeris")
+	double EphemerisStartUnixSeconds = 0.0;
+
+	/** Days covered from the start (the campaign's date range). */
+	UPROPERTY(EditAnywhere, Category="Solar|Ephemeris", meta=(ClampMin="1.0"))
+	double EphemerisRangeDays = 400.0;
+
+	/** Days covered before the start sim time when EphemerisStartUnixSeconds is 0 (rewind headroom). */
+	UPROPERTY(EditAnywhere, Category="Solar|Ephemeris", meta=(ClampMin="0.0"))
+	double EphemerisLeadDays = 30.0;
+
+	/** Refit the tables (call after changing the range or the body table). */
+	UFUNCTION(BlueprintCallable, Category="Solar|Ephemeris")
+	void RebuildEphemeris();
+
+	// ---------------- Warm-up ----------------
+	/**
+	 * Load the spec pack and fit the tables on a worker; OnReady fires on the game
+	 * thread once they are in (immediately if already warmed up).
+	 */
+	void WarmUpAsync(FSimpleDelegate OnReady);
+
+	/** True once the spec pack and tables from Initialize are in */
+	UFUNCTION(BlueprintPure, Category="Solar|Bodies")
+	bool IsWarmedUp() const { return bWarmedUp; }
+
 private:
 	void InitDefaults();
 
+	/** Read a spec pack's "celestial_bodies" (thread-safe); false if there are none */
+	static bool ParseBodySpecPack(const FString& FilePath, TArray<FCelestialBodyDef>& OutBodies);
+
+	/** Fit the sun table and one orbit table per body (parallel to InBodies); returns bytes (thread-safe) */
+	static SIZE_T BuildEphemerisTables(TConstArrayView<FCelestialBodyDef> InBodies, double StartJD, double RangeDays,
+		FEphemerisTable& OutSunTable, TArray<FEphemerisTable>& OutOrbitTables);
+
+	double GetEphemerisStartJD() const;
+
+	/** Apply a finished warm-up (game thread) */
+	void CompleteWarmUp(uint32 Serial);
+
+	/** Apply a pending warm-up now, waiting for the worker if needed */
+	void FinishWarmUp();
+
+	/** Order by parent, resolve indices and refit; false (table unchanged) on a missing or cyclic parent */
+	bool SetBodies(TArray<FCelestialBodyDef>&& InBodies);
+
+	FString ResolveBodySpecPackPath() const;
+
 	void OnTimeAdvanced(double NewSimTimeSeconds);
 
 	// Returns sim time as Unix seconds (UTC-ish), regardless of how TimeSubsystem is configured.
@@ -318,27 +494,61 @@ private:
 	// Cache update (called lazily on getter)
 	void EnsureCacheUpToDate() const;
 
+	// Snapshot position of a built-in body (origin if absent); cache must be current
+	FVector3d GetCachedPositionKm(ECelestialBodyId Body) const;
+
 	// Helpers
 	static double UnixSecondsToJulianDate(double UnixSeconds);
 	static FVector3d ComputeSunDirApprox_J2000(double JulianDate);
 	static double ComputeGMSTAngleRad_FromJD(double JulianDate);
-	void ComputeMoonState(double SimUnixSeconds) const;
+
+	// Position and velocity relative to the parent for a circular orbit
+	static void ComputeCircularOrbit(const FCelestialBodyDef& Def, double SimUnixSeconds, FVector3d& OutPositionKm, FVector3d& OutVelocityKmS);
 
 	// General phase computation:
 	// PhaseAngle = acos( dot( normalize(Moon-Planet), normalize(Sun-Planet) ) ) with sign conventions.
 	static float ComputePhaseAngleRad(const FVector& ToMoon, const FVector& ToSun);
 
 private:
-	TMap<ECelestialBodyId, FCelestialBodyDef> BodyDefs;
+	// Body table, parents before children
+	TArray<FCelestialBodyDef> Bodies;
+	TArray<int32> ParentIndices;
+	TMap<FName, int32> BodyIndexByName;
+
+	// Index per built-in ECelestialBodyId (Custom excluded)
+	static constexpr int32 NumBuiltinBodies = static_cast<int32>(ECelestialBodyId::Custom);
+	int32 BuiltinBodyIndices[NumBuiltinBodies] = { INDEX_NONE, INDEX_NONE, INDEX_NONE };
+
+	// Unit sun direction over the covered range
+	FEphemerisTable SunTable;
+
+	// Per body (parallel to Bodies): position relative to the parent (km) for circular orbits
+	TArray<FEphemerisTable> OrbitTables;
 
 	// ---- Cached state (mutable because getters are const) ----
-	mutable double CachedSimUnixSeconds = -1.0;
-	mutable double CachedJulianDate = 0.0;
-	mutable FVector3d CachedSunDir_D = FVector3d(1,0,0);
-	mutable float CachedGMST = 0.0f;
-	mutable FVector3d CachedMoonPositionKm_D = FVector3d::Zero();
-	mutable FVector3d CachedMoonVelocityKmS_D = FVector3d::Zero();
+	mutable FSolarSystemSnapshot Snapshot;
 
 	// Event subscription
 	FDelegateHandle TimeAdvancedHandle;
+
+	// ---- Warm-up ----
+	struct FWarmUpResult
+	{
+		FString PackPath;
+		bool bFromSpecPack = false;
+
+		// Spec pack bodies (or the table at launch), in file order
+		TArray<FCelestialBodyDef> Bodies;
+
+		// Parallel to Bodies; empty without bUseEphemerisTables
+		FEphemerisTable SunTable;
+		TArray<FEphemerisTable> OrbitTables;
+		SIZE_T TableBytes = 0;
+	};
+	using FWarmUpResultPtr = TSharedPtr<FWarmUpResult, ESPMode::ThreadSafe>;
+
+	UE::Tasks::TTask<FWarmUpResultPtr> PendingWarmUp;
+	uint32 WarmUpSerial = 0;
+	TArray<FSimpleDelegate> WarmUpCallbacks;
+	bool bWarmedUp = false;
 };
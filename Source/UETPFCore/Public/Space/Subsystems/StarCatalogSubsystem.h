@@ -10,27 +10,33 @@
  * Provides precise celestial positions for ~5000+ visible stars.
  * 
  * Data Source:
- * - HYG Database v3.7 (CSV format)
+ * - HYG Database v3.7 (CSV format), cached as a packed binary (see StarCatalogFormat.h)
  * - Contains: Position (RA/Dec), Magnitude, Color, Distance, Names
  * - Stars down to magnitude ~6.5 (naked eye visible)
  * 
  * Architecture:
  * - Loads once at initialization (lazy on first EnsureLoaded() call)
- * - Internal storage: High-precision (double) for calculations
- * - Output format: Single-precision (float) for Niagara/Blueprint
- * - Cached conversion to avoid redundant precision downgrade
+ * - Internal storage: FPackedStarCatalog - parallel arrays (double directions)
+ *   plus one string table, bulk-read from the binary cache
+ * - Render format: FStarRenderBuffers - float directions, magnitudes and
+ *   precomputed colours, sorted brightest first, built once per load
+ * - Metadata: FStarRecords (with strings) built only on request - per star via
+ *   GetStarRecord/FindStarByName, or all at once on the first GetStars() call
  * 
  * Usage:
  * \code{.cpp}
  *   UStarCatalogSubsystem* Catalog = GameInstance->GetSubsystem<UStarCatalogSubsystem>();
- *   Catalog->EnsureLoaded();
- *   const TArray<FStarRecord>& Stars = Catalog->GetStars();
- *   // Pass to Niagara for rendering
+ *   Catalog->EnsureLoadedAsync(FOnStarCatalogReady::CreateWeakLambda(this, [this, Catalog](bool bLoaded)
+ *   {
+ *       // Game thread; pass Catalog->GetPackedCatalog() to Niagara for rendering
+ *   }));
  * \endcode
  * 
  * Performance:
- * - One-time load cost: ~50ms for 5000 stars
- * - Memory: ~500KB for full catalog
+ * - First load parses the CSV (no per-field allocation) and writes the cache
+ * - Later loads: one file read and a memcpy per array - well under 1ms for 5000
+ *   stars, and linear in catalog size for 100k+ star catalogs
+ * - Memory: ~64 bytes per star packed, plus deduplicated strings
  * - No per-frame cost (static data)
  * 
  * Coordinate System:
@@ -46,29 +52,16 @@
 
 #include "CoreMinimal.h"
 #include "Subsystems/GameInstanceSubsystem.h"
+#include "Space/StarCatalogFormat.h"
+#include "Tasks/Task.h"
 #include "StarCatalogSubsystem.generated.h"
 
-/**
- * Internal star record for precise astronomical calculations.
- * Uses double/FVector3d for sidereal math precision.
- */
-struct FStarRecordInternal
-{
-	int32 Id = 0;            // Star catalog ID
-	FString Name;            // Harvard Revised catalog name
-	FString ProperName;      // Common name (e.g., "Sirius", "Betelgeuse")
-	FString BayerFlamsteed;  // Bayer/Flamsteed designation (e.g., "Alpha CMa")
-	FVector3d DirEquatorial; // Unit vector in equatorial J2000 frame (double precision)
-	float Mag;               // Apparent magnitude
-	float CI;                // Color index (B-V)
-	float DistanceParsecs;   // Distance in parsecs for parallax
-	FString SpectralType;    // Spectral classification (e.g., "A1V")
-	FString Constellation;   // 3-letter constellation code (e.g., "CMa")
-};
+/** Fired on the game thread when an async catalog load finishes (bLoaded = stars available) */
+DECLARE_DELEGATE_OneParam(FOnStarCatalogReady, bool /*bLoaded*/);
 
 /**
- * Minimal star record for GPU starfield rendering (Niagara-compatible).
- * Converted from internal double precision at the edge.
+ * Star record for Blueprint/UI consumers.
+ * Converted from the packed catalog at the edge; renderers should use GetRenderBuffers().
  */
 USTRUCT(BlueprintType)
 struct UETPFCORE_API FStarRecord
@@ -87,25 +80,60 @@ struct UETPFCORE_API FStarRecord
 	UPROPERTY(BlueprintReadOnly) FString Constellation;
 };
 
+/**
+ * Render-ready starfield arrays, sorted brightest first.
+ * Built once per load. Everything a starfield needs and nothing it does not: the
+ * stars visible at a magnitude limit are a prefix of every array, so culling is a
+ * binary search instead of a filter pass.
+ */
+struct UETPFCORE_API FStarRenderBuffers
+{
+	/** Unit directions, equatorial J2000 */
+	TArray<FVector3f> Directions;
+
+	/** Apparent magnitude, ascending */
+	TArray<float> Magnitudes;
+
+	/** Precomputed from B-V (UCelestialMathLibrary::StarColor_FromBVIndex) */
+	TArray<FLinearColor> Colors;
+
+	/** Index of each star in the packed catalog (for metadata lookup) */
+	TArray<int32> CatalogIndices;
+
+	int32 Num() const { return Magnitudes.Num(); }
+
+	/** Stars with magnitude <= MaxMagnitude, i.e. the length of the visible prefix */
+	int32 CountVisible(float MaxMagnitude) const;
+
+	/** Rebuild from a packed catalog */
+	void Build(const FPackedStarCatalog& Catalog);
+
+	void Reset();
+};
+
 /**
  * Star catalog subsystem for astronomical starfield rendering.
  * 
  * Lifecycle:
  * 1. Initialize() - Registers subsystem (does not load data yet)
- * 2. EnsureLoaded() - Lazy loads star catalog from CSV on first call
- * 3. GetStars() - Returns array of star records for rendering
+ * 2. EnsureLoadedAsync() - Loads the catalog (binary cache, else CSV) on a worker;
+ *    EnsureLoaded() does the same synchronously, finishing any in-flight async load
+ * 3. GetRenderBuffers() for rendering; GetStarRecord()/FindStarByName() for metadata
  * 4. Deinitialize() - Cleanup
  * 
  * Data Flow:
- * 1. Load CSV from Content/SpecPacks/Space/starmap_milkyway.csv - generate with script if needed
- * 2. Parse each line: ID, Name, RA, Dec, Magnitude, Color, Distance
- * 3. Convert to internal high-precision format (FStarRecordInternal)
- * 4. Convert to output format (FStarRecord) for Niagara
- * 5. Cache both for efficient access
+ * 0. Resolve Content/RelativeCsvPath (legacy fallback: the plugin's Resources/SpecPacks)
+ * 1. Read the binary cache if it matches the CSV (size, timestamp, MaxStars)
+ * 2. Otherwise parse the CSV (ID, Name, RA, Dec, Magnitude, Color, Distance) straight
+ *    into an FPackedStarCatalog and write the cache under Saved/StarCatalog
+ * 3. Convert to output format (FStarRecord) only when GetStars() is first called
  * 
  * Thread Safety:
- * - Loading is synchronous on game thread
- * - Once loaded, GetStars() is read-only and safe from any thread
+ * - EnsureLoaded()/EnsureLoadedAsync()/Reload() are game-thread calls
+ * - Async loads read and parse into a private catalog on a worker; it is swapped
+ *   in on the game thread just before the ready callbacks run
+ * - Once loaded, GetPackedCatalog() and GetStars() are read-only and safe from any
+ *   thread (the first GetStars() call builds the records under a lock)
  * - No locking needed after initial load
  * 
  * Integration:
@@ -114,7 +142,7 @@ struct UETPFCORE_API FStarRecord
  * - Editor tools: Can use for procedural sky generation
  * 
  * Configuration:
- * - RelativeCsvPath: Path to CSV file (relative to Content/)
+ * - RelativeCsvPath: Path to CSV file (relative to Content/, or absolute)
  * - MaxStars: Safety cap to prevent memory explosion on bad files
  * 
  * CSV Format:
@@ -124,6 +152,7 @@ struct UETPFCORE_API FStarRecord
  * ```
  * 
  * @note Uses double precision internally for astronomical accuracy
+ * @note The CSV must be UTF-8 (the generator's output); strings are stored as-is
  * @note Converts to float for rendering (Niagara compatibility)
  */
 UCLASS()
@@ -135,25 +164,57 @@ public:
 	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
 	virtual void Deinitialize() override;
 
-	/** Load once (idempotent). Returns true if we have stars after call. */
+	/** Load once (idempotent), blocking. Returns true if we have stars after call. */
 	UFUNCTION(BlueprintCallable, Category="Astro|Stars")
 	bool EnsureLoaded();
 
+	/**
+	 * Load once (idempotent) on a worker thread.
+	 * OnReady runs on the game thread when the load finishes - immediately if the
+	 * catalog is already loaded. Concurrent requests share one load; callbacks
+	 * still pending when the subsystem shuts down are dropped.
+	 */
+	void EnsureLoadedAsync(FOnStarCatalogReady OnReady);
+
+	/** True while an async load is in flight */
+	bool IsLoading() const { return PendingLoad.IsValid(); }
+
+	/** Absolute CSV path RelativeCsvPath resolves to */
+	FString GetCsvFullPath() const;
+
 	/** Optional manual reload for dev. */
 	UFUNCTION(BlueprintCallable, Category="Astro|Stars")
 	bool Reload();
 
-	/** Get stars in Niagara-compatible format (converted from internal precision). */
+	/** Packed catalog (catalog order, no string conversion) */
+	const FPackedStarCatalog& GetPackedCatalog() const { return Catalog; }
+
+	/** Render-ready arrays, brightest first; what starfields should upload */
+	const FStarRenderBuffers& GetRenderBuffers() const { return RenderBuffers; }
+
+	/** Get stars as records (converted from the packed catalog on first call). */
 	const TArray<FStarRecord>& GetStars() const;
 
+	/** One star's record by packed catalog index (e.g. FStarRenderBuffers::CatalogIndices) */
+	UFUNCTION(BlueprintCallable, Category="Astro|Stars")
+	bool GetStarRecord(int32 CatalogIndex, FStarRecord& OutStar) const;
+
+	/**
+	 * Packed catalog index of a star by proper name, Bayer/Flamsteed designation or
+	 * catalog name (case-insensitive), or INDEX_NONE. The lookup is built on first use.
+	 */
+	UFUNCTION(BlueprintCallable, Category="Astro|Stars")
+	int32 FindStarByName(const FString& StarName) const;
+
 	UFUNCTION(BlueprintPure, Category="Astro|Stars")
-	int32 GetStarCount() const { return Stars.Num(); }
+	int32 GetStarCount() const { return Catalog.Num(); }
 
+	/** Deep-copies every record's strings; prefer GetStarRecord/FindStarByName for lookups */
 	UFUNCTION(BlueprintCallable, Category="Astro|Stars")
-	void GetStarsCopy(TArray<FStarRecord>& OutStars) const { OutStars = Stars; }
+	void GetStarsCopy(TArray<FStarRecord>& OutStars) const { OutStars = GetStars(); }
 
 	UFUNCTION(BlueprintPure, Category="Astro|Stars")
-	bool IsLoaded() const { return bLoaded && StarsInternal.Num() > 0; }
+	bool IsLoaded() const { return bLoaded && Catalog.Num() > 0; }
 
 	/** Config: relative to Content/ */
 	UPROPERTY(EditAnywhere, Category="Astro|Stars")
@@ -164,11 +225,46 @@ public:
 	int32 MaxStars = 5000;
 
 private:
-	bool LoadFromCsv(const FString& FullPath);
-	void ConvertInternalToOutput();
+	/** A load's products, built together on whichever thread loaded */
+	struct FLoadedCatalog
+	{
+		FPackedStarCatalog Catalog;
+		FStarRenderBuffers RenderBuffers;
+	};
+
+	using FCatalogPtr = TSharedPtr<FLoadedCatalog, ESPMode::ThreadSafe>;
+
+	/** Fill a catalog from the binary cache or, failing that, the CSV, and build its render buffers. Any thread. */
+	static bool LoadCatalog(const FString& CsvPath, int32 InMaxStars, FLoadedCatalog& OutLoaded);
+
+	/** Swap in a finished async load and fire callbacks; blocks if it is still running */
+	void CompleteAsyncLoad(uint32 Serial);
+
+	/** Take ownership of a loaded catalog */
+	void SetCatalog(FLoadedCatalog&& Loaded);
+
+	void ConvertPackedToOutput() const;
+	void ResetCatalog();
 
 private:
 	UPROPERTY() bool bLoaded = false;
-	TArray<FStarRecordInternal> StarsInternal;  // Internal precise data
-	UPROPERTY() TArray<FStarRecord> Stars;      // Output Niagara-compatible data
+	FPackedStarCatalog Catalog;                 // Packed precise data
+	FStarRenderBuffers RenderBuffers;           // Sorted float copy for rendering
+
+	/** Name -> catalog index (FString keys compare case-insensitively), built by FindStarByName() */
+	mutable TMap<FString, int32> NameLookup;
+	mutable bool bNameLookupBuilt = false;
+
+	/** Output records, built lazily by GetStars() */
+	mutable TArray<FStarRecord> Stars;
+	mutable bool bStarsBuilt = false;
+	mutable FCriticalSection StarsLock;
+
+	/** In-flight async load (null catalog on failure) */
+	UE::Tasks::TTask<FCatalogPtr> PendingLoad;
+
+	/** Bumped per async load so completions superseded by Reload/Deinitialize are ignored */
+	uint32 LoadSerial = 0;
+
+	TArray<FOnStarCatalogReady> PendingCallbacks;
 };
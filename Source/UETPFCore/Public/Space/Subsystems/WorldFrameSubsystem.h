@@ -21,9 +21,18 @@
  * World Frame (cm):        UE world space, Anchor body at origin
  * 
  * Transform:
- *   WorldPos_cm = (CanonicalPos_km - AnchorPos_km) * 100000.0
+ *   WorldPos_cm = (CanonicalPos_km - AnchorPos_km) * 100000.0 - WorldOrigin_cm
  * ```
  * 
+ * Floating Origin:
+ * - Canonical positions stay double precision end to end (no float casts)
+ * - With bEnableOriginRebasing, the world origin (UWorld::OriginLocation) is moved
+ *   in whole OriginRebaseChunkCm steps once the view is OriginRebaseDistanceCm out
+ * - Every origin shift (ours or the engine's) fires OnWorldOriginRebased once, after
+ *   actors have moved; the sky, biome and physics subsystems drop world-keyed caches
+ * - Absolute cm = world cm + origin; persistent data (surface deltas, atmosphere
+ *   sea level) is keyed in absolute space so it is unaffected by rebases
+ * 
  * Example Scenarios:
  * - Earth Map: Anchor = Earth, Moon appears 384,400 km away in world
  * - Moon Map: Anchor = Moon, Earth appears 384,400 km away
@@ -39,6 +48,14 @@
  *   FVector MoonWorldPos = Frame->GetMoonWorldCm();
  * \endcode
  * 
+ * Sky Frame:
+ * - Once per sim-time step the sky context and solar state for this world's anchor
+ *   are published as one immutable FSkyFrame into a double buffer
+ * - GetSkyFrame() copies the latest frame lock-free from any thread (audio, AI
+ *   lighting checks, render-thread parameter updates); on the game thread it first
+ *   republishes if the sim time moved since the last publish
+ * - Consumers read the same frame instead of each rebuilding the sky context
+ * 
  * Integration:
  * - Driven by USolarSystemSubsystem for canonical positions
  * - Consumed by AUniversalSkyActor for sun/moon rendering
@@ -53,9 +70,34 @@
 #include "CoreMinimal.h"
 #include "Subsystems/WorldSubsystem.h"
 #include "Environment/SkyContext.h"
+#include "Space/Subsystems/SolarSystemSubsystem.h"
+#include <atomic>
 #include "WorldFrameSubsystem.generated.h"
 
-class USolarSystemSubsystem;
+/** Fired once after the world origin moved; ShiftCm = new origin - old origin */
+DECLARE_MULTICAST_DELEGATE_OneParam(FOnWorldOriginRebased, const FIntVector& /*ShiftCm*/);
+
+/**
+ * Sky inputs for one world at one sim time.
+ * Plain data only: it is copied out of the publish buffer under a sequence check.
+ */
+USTRUCT(BlueprintType)
+struct UETPFCORE_API FSkyFrame
+{
+    GENERATED_BODY()
+
+    UPROPERTY(BlueprintReadOnly, Category="Frame")
+    double SimUnixSeconds = -1.0;
+
+    UPROPERTY(BlueprintReadOnly, Category="Frame")
+    FSkyContext Sky;
+
+    UPROPERTY(BlueprintReadOnly, Category="Frame")
+    FSolarSystemState Solar;
+
+    // Publish count; 0 = nothing published yet. Compare to skip unchanged frames.
+    uint32 Generation = 0;
+};
 
 /**
  * Per-world anchoring + transform utilities.
@@ -63,12 +105,18 @@ class USolarSystemSubsystem;
  * Converts canonical km positions into world cm relative to anchor.
  */
 UCLASS()
-class UETPFCORE_API UWorldFrameSubsystem : public UWorldSubsystem
+class UETPFCORE_API UWorldFrameSubsystem : public UTickableWorldSubsystem
 {
     GENERATED_BODY()
 
 public:
     virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+    virtual void Deinitialize() override;
+    virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+
+    //--- FTickableGameObject Interface ---
+    virtual void Tick(float DeltaTime) override;
+    virtual TStatId GetStatId() const override;
 
     UFUNCTION(BlueprintCallable, Category="Frame")
     void SetAnchorBody(ECelestialBodyId InAnchor);
@@ -76,22 +124,98 @@ public:
     UFUNCTION(BlueprintCallable, Category="Frame")
     ECelestialBodyId GetAnchorBody() const { return AnchorBody; }
 
-    // Convert canonical solar-frame position (km) into this world's cm position.
+    // Convert canonical solar-frame position (km) into this world's cm position (double precision).
     UFUNCTION(BlueprintCallable, Category="Frame")
     FVector CanonicalKmToWorldCm(const FVector& CanonicalPosKm) const;
 
+    // Inverse of CanonicalKmToWorldCm.
+    UFUNCTION(BlueprintCallable, Category="Frame")
+    FVector WorldCmToCanonicalKm(const FVector& WorldPosCm) const;
+
+    // Every body's world position (solar snapshot order, see USolarSystemSubsystem::FindBodyIndex).
+    // Fills min(OutWorldCm.Num(), body count) entries from one snapshot read.
+    void GetAllBodiesWorldCm(TArrayView<FVector> OutWorldCm) const;
+
     // Convenience: get Moon world position in this world.
     UFUNCTION(BlueprintCallable, Category="Frame")
     FVector GetMoonWorldCm() const;
 
     // Build sky context for the current world anchor.
+    // Rebuilds on every call - prefer GetSkyFrame().Sky.
     UFUNCTION(BlueprintCallable, Category="Frame")
     FSkyContext BuildSkyContext() const;
 
+    // Latest published sky frame. Lock-free from any thread; on the game thread it is
+    // republished first if the sim time has moved since the last publish.
+    UFUNCTION(BlueprintCallable, Category="Frame")
+    FSkyFrame GetSkyFrame() const;
+
+    // Generation of the latest published frame (any thread).
+    uint32 GetSkyFrameGeneration() const { return SkyFrameGeneration.load(std::memory_order_acquire); }
+
+    // Republish now (game thread), e.g. after editing the solar body table.
+    UFUNCTION(BlueprintCallable, Category="Frame")
+    void RefreshSkyFrame();
+
+    // ---------------- Floating Origin ----------------
+    // Move the world origin automatically as the view travels.
+    UPROPERTY(EditAnywhere, Category="Frame|Origin")
+    bool bEnableOriginRebasing = false;
+
+    // View distance from the origin that triggers a rebase (cm).
+    UPROPERTY(EditAnywhere, Category="Frame|Origin", meta=(ClampMin="100000.0"))
+    double OriginRebaseDistanceCm = 2000000.0; // 20 km
+
+    // Rebase step (cm). A multiple of the 6400 cm world cell keeps cell grids aligned.
+    UPROPERTY(EditAnywhere, Category="Frame|Origin", meta=(ClampMin="6400.0"))
+    double OriginRebaseChunkCm = 1024000.0; // 160 cells
+
+    // Shift the world origin by ShiftCm. False if the engine refused or the origin would overflow.
+    UFUNCTION(BlueprintCallable, Category="Frame|Origin")
+    bool RebaseOrigin(const FIntVector& ShiftCm);
+
+    // Current world origin in absolute cm (UWorld::OriginLocation).
+    UFUNCTION(BlueprintPure, Category="Frame|Origin")
+    FIntVector GetWorldOriginCm() const;
+
+    UFUNCTION(BlueprintPure, Category="Frame|Origin")
+    FVector WorldCmToAbsoluteCm(const FVector& WorldPosCm) const;
+
+    UFUNCTION(BlueprintPure, Category="Frame|Origin")
+    FVector AbsoluteCmToWorldCm(const FVector& AbsolutePosCm) const;
+
+    FOnWorldOriginRebased OnWorldOriginRebased;
+
 private:
     USolarSystemSubsystem* GetSolar() const;
 
+    FVector3d GetAnchorPositionKm(const USolarSystemSubsystem& Solar, const FSolarSystemSnapshot& Snapshot) const;
+
+    void BuildSkyFrame(const USolarSystemSubsystem& Solar, FSkyFrame& OutFrame) const;
+
+    // Game thread only: fill the back slot, then flip
+    void PublishSkyFrame() const;
+
+    void HandleSimTimeAdvanced(double NewSimTimeSeconds);
+
+    void HandlePostWorldOriginOffset(UWorld* InWorld, FIntVector SrcOrigin, FIntVector DstOrigin);
+
     static constexpr double KmToCm = 100000.0;
 
     ECelestialBodyId AnchorBody = ECelestialBodyId::Earth;
+
+    // Double-buffered publish. Readers use slot (Generation & 1); the writer only touches
+    // the other slot, so a reader retries only if it stalls across a whole publish.
+    struct FSkyFrameSlot
+    {
+        std::atomic<uint32> Sequence{ 0 };  // odd while being written
+        FSkyFrame Frame;
+    };
+
+    mutable FSkyFrameSlot SkyFrameSlots[2];
+    mutable std::atomic<uint32> SkyFrameGeneration{ 0 };
+
+    FDelegateHandle TimeAdvancedHandle;
+    FDelegateHandle EpochChangedHandle;
+    FDelegateHandle OriginOffsetHandle;
 };
@@ -0,0 +1,116 @@
+// Copyright 2026 Threaded Pixel Factory
+// Licensed under the Apache License, Version 2.0 (the "License");
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "SpecRegistry.generated.h"
+
+/**
+ * Compact handle to a spec interned in a TSpecRegistry.
+ * Store this instead of the spec's FName on hot paths - resolving it is an array index
+ * plus a generation compare.
+ * Stable across re-registration of the same ID (hot reload overwrites in place); a
+ * Reset moves the registry to a new generation, so handles taken before it resolve
+ * to nothing instead of to whichever spec later lands on the same index.
+ */
+USTRUCT(BlueprintType)
+struct UETPFCORE_API FSpecHandle
+{
+	GENERATED_BODY()
+
+	UPROPERTY(BlueprintReadOnly, Category = "Spec")
+	int32 Index = INDEX_NONE;
+
+	/** Generation of the registry that issued the handle */
+	UPROPERTY()
+	uint32 Generation = 0;
+
+	FSpecHandle() = default;
+	FSpecHandle(int32 InIndex, uint32 InGeneration) : Index(InIndex), Generation(InGeneration) {}
+
+	/** Refers to a slot; whether the slot is still current is checked on lookup */
+	bool IsValid() const { return Index != INDEX_NONE; }
+	bool operator==(const FSpecHandle& Other) const { return Index == Other.Index && Generation == Other.Generation; }
+	bool operator!=(const FSpecHandle& Other) const { return !(*this == Other); }
+
+	friend uint32 GetTypeHash(const FSpecHandle& Handle) { return HashCombine(::GetTypeHash(Handle.Index), ::GetTypeHash(Handle.Generation)); }
+};
+
+namespace SpecRegistry
+{
+	/** Process-wide generation source, so no two registry lifetimes share a generation */
+	UETPFCORE_API uint32 NextGeneration();
+}
+
+/**
+ * Specs interned into one contiguous array, indexed by ID.
+ *
+ * - Register: O(1) amortized; re-registering an ID overwrites in place
+ * - Lookup by handle: array index, no hashing
+ * - Lookup by ID: one hash probe
+ *
+ * Pointers and references returned by Find/Get stay valid until the next
+ * Register or Reset (the array may grow). Handles stay valid until Reset; after
+ * it Get returns null for them even once the index is reused.
+ */
+template<typename SpecType>
+class TSpecRegistry
+{
+public:
+	/** Intern a spec, returning its handle */
+	FSpecHandle Register(FName Id, const SpecType& Spec)
+	{
+		if (const int32* Existing = IndexById.Find(Id))
+		{
+			Specs[*Existing] = Spec;
+			return FSpecHandle(*Existing, Generation);
+		}
+
+		const int32 Index = Specs.Add(Spec);
+		Ids.Add(Id);
+		IndexById.Add(Id, Index);
+		return FSpecHandle(Index, Generation);
+	}
+
+	FSpecHandle FindHandle(FName Id) const
+	{
+		const int32* Index = IndexById.Find(Id);
+		return Index ? FSpecHandle(*Index, Generation) : FSpecHandle();
+	}
+
+	const SpecType* Find(FName Id) const
+	{
+		const int32* Index = IndexById.Find(Id);
+		return Index ? &Specs[*Index] : nullptr;
+	}
+
+	const SpecType* Get(FSpecHandle Handle) const
+	{
+		return Handle.Generation == Generation && Specs.IsValidIndex(Handle.Index) ? &Specs[Handle.Index] : nullptr;
+	}
+
+	bool Contains(FName Id) const { return IndexById.Contains(Id); }
+
+	int32 Num() const { return Specs.Num(); }
+
+	/** IDs in registration order (parallel to the spec array) */
+	TConstArrayView<FName> GetIds() const { return Ids; }
+
+	void Reset()
+	{
+		Specs.Reset();
+		Ids.Reset();
+		IndexById.Reset();
+		Generation = SpecRegistry::NextGeneration();
+	}
+
+private:
+	/** Current generation; stamped into every handle issued */
+	uint32 Generation = SpecRegistry::NextGeneration();
+
+	TArray<SpecType> Specs;
+	TArray<FName> Ids;
+	TMap<FName, int32> IndexById;
+};
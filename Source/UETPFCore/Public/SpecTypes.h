@@ -460,6 +460,34 @@ public:
 // RUNTIME SPEC STRUCTS (SpecPack / JSON loaded)
 //=============================================================================
 
+/**
+ * Fixed-size lookup table baked from a response curve.
+ * POD - no allocation, no UObject access; safe to evaluate on worker threads.
+ * Inputs outside [MinX, MaxX] clamp to the end samples (matches constant curve extrapolation).
+ */
+struct UETPFCORE_API FSurfaceCurveLUT
+{
+	static constexpr int32 NumSamples = 32;
+
+	float MinX = 0.0f;
+	float InvRange = 1.0f;
+	float Samples[NumSamples];
+
+	/** Identity table (always 1.0) */
+	FSurfaceCurveLUT();
+
+	/** Sample Curve over [InMinX, InMaxX]. A missing/empty curve bakes to DefaultValue. */
+	void Bake(const FRichCurve* Curve, float InMinX, float InMaxX, float DefaultValue = 1.0f);
+
+	/** Linear interpolation between the two nearest samples, no branches */
+	FORCEINLINE float Evaluate(float X) const
+	{
+		const float T = FMath::Clamp((X - MinX) * InvRange, 0.0f, 1.0f) * static_cast<float>(NumSamples - 1);
+		const int32 Index = FMath::Min(static_cast<int32>(T), NumSamples - 2);
+		return FMath::Lerp(Samples[Index], Samples[Index + 1], T - static_cast<float>(Index));
+	}
+};
+
 USTRUCT(BlueprintType)
 struct FTemperatureResponseLUT
 {
@@ -473,6 +501,18 @@ struct FTemperatureResponseLUT
 
 	UPROPERTY(BlueprintReadOnly, Category = "Thermal")
 	TArray<float> Samples; // e.g. 16 entries
+
+	/** Interpolated multiplier at TempK (1.0 if empty) */
+	float Evaluate(float TempK) const
+	{
+		if (Samples.Num() < 2 || MaxTempK <= MinTempK)
+		{
+			return Samples.Num() == 1 ? Samples[0] : 1.0f;
+		}
+		const float T = FMath::Clamp((TempK - MinTempK) / (MaxTempK - MinTempK), 0.0f, 1.0f) * static_cast<float>(Samples.Num() - 1);
+		const int32 Index = FMath::Min(static_cast<int32>(T), Samples.Num() - 2);
+		return FMath::Lerp(Samples[Index], Samples[Index + 1], T - static_cast<float>(Index));
+	}
 };
 
 /**
@@ -23,9 +23,40 @@
  * 3. Match against BiomeSpec rules (altitude range, slope range, RVT channel)
  * 4. Return primary biome + optional secondary for blending
  * 
+ * Terrain Sampling:
+ * - Where terrain is a landscape, height comes straight from the landscape's
+ *   collision heightfield and the normal from central differences of four
+ *   neighbouring samples one quad apart - no physics traces
+ * - Other geometry (meshes, off-landscape points) falls back to line traces
+ * 
+ * Biome Tile Cache:
+ * - With bCacheBiomeTiles, terrain height/normal and the rule-resolved biome are
+ *   cached per FWorldCellKey in one texel per surface tile (64x64, ~1m texels)
+ * - Texels are baked lazily on first query with a single downward trace, so a
+ *   repeated query in the same texel is a map lookup and an array read
+ * - The trace spans the fixed TerrainTraceMinZ..MaxZ column, so a baked texel is
+ *   the same whatever altitude the first query came from
+ * - Rules are evaluated against the terrain altitude at the texel centre; texels
+ *   with no terrain under them resolve from the query altitude as before and are
+ *   not cached (the ground may not be loaded yet), so they retrace on each query
+ * - Registering specs or changing the rule settings re-resolves biomes from the
+ *   cached terrain without re-tracing; level streaming drops all tiles
+ * - Up to MaxResidentBiomeTiles tiles are kept (least recently used evicted)
+ * 
+ * Batch Queries:
+ * - GetBiomesAtLocations / GetBiomesInCell classify many points into SoA arrays:
+ *   terrain is sampled on the game thread, rules and spec lookup run in parallel
+ * - GetQuerySnapshot() publishes the rules as an immutable FBiomeQuerySnapshot so
+ *   PCG can classify points it already has terrain for on a worker thread
+ * 
  * RVT Integration:
  * - Each BiomeSpec can specify an RVT channel (0-3 for RGBA)
  * - RVT provides high-resolution biome masks painted by artists
+ * - RVTBiomeCaptureMaterial renders the mask for one BiomeTileCellSize tile into a
+ *   small render target, which is read back asynchronously into a CPU tile cache
+ * - Tiles around the view are kept captured; queries elsewhere request their tile
+ *   and fall back to rules until it arrives (typically a few frames)
+ * - Channels map to biomes through a 4-entry table rebuilt on registration
  * - Fallback to altitude/slope rules if RVT not available
  * 
  * Integration Points:
@@ -41,13 +72,21 @@
 
 #include "CoreMinimal.h"
 #include "Subsystems/WorldSubsystem.h"
+#include "Containers/StaticArray.h"
 #include "SpecTypes.h"
+#include "DeltaTypes.h"
 #include "BiomeSubsystem.generated.h"
 
 class UGlobalAtmosphereField;
 class USurfaceQuerySubsystem;
 class UEnvironmentSubsystem;
 class ULandscapeComponent;
+class ALandscapeProxy;
+class ULevel;
+class UMaterialInterface;
+class UMaterialInstanceDynamic;
+class UTextureRenderTarget2D;
+struct FRVTBiomeReadback;
 
 /**
  * Biome identifier.
@@ -192,6 +231,124 @@ struct UETPFCORE_API FBiomeQueryResult
 	FBiomeQueryResult() = default;
 };
 
+/**
+ * BiomeSpec altitude/slope rules compiled into per-axis interval tables.
+ * 
+ * Each axis is split at every range endpoint, and each interval stores a bitmask of
+ * the rules whose closed range overlaps it. Resolving is one binary search per axis,
+ * an AND of the two masks, and scoring only the surviving candidates - the same
+ * result and tie-break order as scoring every spec, at a cost that no longer grows
+ * with the number of biomes that cannot match.
+ * 
+ * Plain data with no world dependency, so offline tools can build and query it too.
+ */
+struct UETPFCORE_API FBiomeRuleTable
+{
+	/**
+	 * Compile rules. Earlier specs win score ties.
+	 * A disabled axis accepts every altitude/slope and adds nothing to the score.
+	 */
+	void Build(TConstArrayView<const FBiomeSpec*> Specs, bool bInUseAltitude, bool bInUseSlope);
+
+	/** Best-scoring biome for an altitude (cm) and slope (degrees), or invalid if no rule matches */
+	FBiomeId Resolve(float Altitude, float SlopeAngle) const;
+
+	int32 NumRules() const { return Rules.Num(); }
+
+	void Reset();
+
+private:
+	struct FRule
+	{
+		FBiomeId BiomeId;
+		FVector2D AltitudeRange;
+		FVector2D SlopeRange;
+	};
+
+	struct FAxis
+	{
+		/** Sorted, unique range endpoints; interval i spans [Breakpoints[i], Breakpoints[i + 1]] */
+		TArray<double> Breakpoints;
+
+		/** NumWords masks per interval */
+		TArray<uint64> Masks;
+
+		/** Interval containing Value, or INDEX_NONE outside every range */
+		int32 FindInterval(double Value) const;
+	};
+
+	void BuildAxis(FAxis& Axis, TFunctionRef<FVector2D(const FRule&)> GetRange) const;
+
+	/** Same range tests and centring score as the original per-spec loop */
+	bool ScoreRule(const FRule& Rule, float Altitude, float SlopeAngle, float& OutScore) const;
+
+	TArray<FRule> Rules;
+	FAxis AltitudeAxis;
+	FAxis SlopeAxis;
+	int32 NumWords = 0;
+	bool bUseAltitude = true;
+	bool bUseSlope = true;
+};
+
+/**
+ * Structure-of-arrays result of a batch biome query, one element per point.
+ * Laid out for PCG/foliage filters that read a single channel across a whole cell.
+ */
+struct UETPFCORE_API FBiomeBatchResult
+{
+	/** Resolved biome (rules, RVT or default); invalid if nothing matched and there is no default */
+	TArray<FBiomeId> Biomes;
+	TArray<FSurfaceSpecId> SurfaceSpecIds;
+	TArray<FMediumSpecId> MediumSpecIds;
+
+	/** Terrain height under each point (cm); the query Z where there is no terrain */
+	TArray<float> TerrainHeights;
+
+	/** Terrain slope (degrees); 0 where there is no terrain */
+	TArray<float> SlopeAngles;
+
+	void SetNum(int32 NumPoints);
+	int32 Num() const { return Biomes.Num(); }
+};
+
+/**
+ * Immutable copy of everything rule-based biome resolution reads: the compiled
+ * rules, each biome's spec IDs, the default biome and sea level.
+ * 
+ * Take one on the game thread with UBiomeSubsystem::GetQuerySnapshot(), then
+ * classify from any thread without locks. RVT masks are not part of the snapshot;
+ * they live in a game-thread tile cache (see UBiomeSubsystem::GetBiomesAtLocations).
+ */
+struct UETPFCORE_API FBiomeQuerySnapshot
+{
+	/** Rules, then the default biome - same as the subsystem's rule fallback */
+	FBiomeId ResolveBiome(float Altitude, float SlopeAngle) const;
+
+	/**
+	 * Classify points from terrain the caller already has (e.g. PCG's landscape data).
+	 * Fills Biomes/SurfaceSpecIds/MediumSpecIds and copies in the heights and slopes;
+	 * large batches are split across worker threads.
+	 * 
+	 * @param TerrainHeights - Terrain height per point (cm, world Z)
+	 * @param SlopeAngles - Terrain slope per point (degrees)
+	 */
+	void ClassifyPoints(TConstArrayView<float> TerrainHeights, TConstArrayView<float> SlopeAngles, FBiomeBatchResult& OutResult) const;
+
+	/** Write a biome and its spec IDs into one element of a result */
+	void SetBiome(FBiomeBatchResult& OutResult, int32 Index, const FBiomeId& BiomeId) const;
+
+	struct FSpecIds
+	{
+		FSurfaceSpecId SurfaceSpecId;
+		FMediumSpecId MediumSpecId;
+	};
+
+	FBiomeRuleTable Rules;
+	TMap<FBiomeId, FSpecIds> SpecIds;
+	FBiomeId DefaultBiomeId;
+	float SeaLevelAltitude = 0.0f;
+};
+
 /**
  * BiomeSubsystem
  * 
@@ -212,7 +369,7 @@ struct UETPFCORE_API FBiomeQueryResult
  * - EnvironmentSubsystem uses GlobalAtmosphereField as default, biome modifies
  */
 UCLASS()
-class UETPFCORE_API UBiomeSubsystem : public UWorldSubsystem
+class UETPFCORE_API UBiomeSubsystem : public UTickableWorldSubsystem
 {
 	GENERATED_BODY()
 
@@ -224,13 +381,19 @@ public:
 	virtual void Deinitialize() override;
 	virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
 
+	//--- UTickableWorldSubsystem Interface ---
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override { RETURN_QUICK_DECLARE_CYCLE_STAT(UBiomeSubsystem, STATGROUP_Tickables); }
+
 	//==========================================================================
 	// BIOME QUERIES
 	//==========================================================================
 
 	/**
 	 * Query the biome at a world location.
-	 * Uses terrain height, slope, and RVT masks to determine biome.
+	 * Uses terrain height, slope, and RVT masks to determine biome; the query's own Z
+	 * only counts where no terrain lies below it, on every path (cached or not, single or batch).
+	 * Result.Altitude is that terrain altitude above sea level.
 	 * 
 	 * @param WorldLocation - Location to query (cm)
 	 * @return FBiomeQueryResult with biome info and associated spec IDs
@@ -247,6 +410,33 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Biome")
 	FBiomeId GetBiomeIdAtLocation(const FVector& WorldLocation) const;
 
+	/**
+	 * Batch biome query for PCG and foliage placement.
+	 * Terrain is sampled here (through the tile cache when enabled) and RVT masks are
+	 * applied where their tiles are resident; rule resolution and spec lookup then
+	 * run across worker threads. Rules use the terrain altitude, as GetBiomeAtLocation does.
+	 * 
+	 * @param WorldLocations - Locations to query (cm)
+	 * @param OutResult - One element per location
+	 */
+	void GetBiomesAtLocations(TConstArrayView<FVector> WorldLocations, FBiomeBatchResult& OutResult) const;
+
+	/**
+	 * Classify a Resolution x Resolution grid of texel centres covering one cell
+	 * (row-major, row = Y), e.g. everything a PCG graph places into that cell.
+	 * 
+	 * @param CellKey - Cell to cover (its LOD scales the cell size)
+	 * @param Resolution - Samples per cell axis (clamped to 1-1024)
+	 * @param QueryZ - Start height for terrain sampling where traces are needed
+	 */
+	void GetBiomesInCell(const FWorldCellKey& CellKey, int32 Resolution, float QueryZ, FBiomeBatchResult& OutResult) const;
+
+	/**
+	 * Current immutable rule snapshot, for classifying from worker threads.
+	 * Game thread only; republished lazily once specs or rule settings change.
+	 */
+	TSharedRef<const FBiomeQuerySnapshot, ESPMode::ThreadSafe> GetQuerySnapshot() const;
+
 	/**
 	 * Get the surface spec ID for a biome.
 	 * 
@@ -320,6 +510,15 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Biome|Registration")
 	void RegisterBiomeSpec(const FBiomeSpec& Spec);
 
+	/**
+	 * Register only the biome specs that are new or changed (hot reload).
+	 * Rules are recompiled once for the batch; cached tiles re-resolve lazily
+	 * through the rule key, so terrain is not re-sampled.
+	 * 
+	 * @return Number of specs registered
+	 */
+	int32 UpdateBiomeSpecs(TConstArrayView<FBiomeSpec> Specs);
+
 	/**
 	 * Get a registered biome spec.
 	 * 
@@ -342,18 +541,62 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Biome|Registration")
 	TArray<FBiomeId> GetAllBiomeIds() const;
 
+	//==========================================================================
+	// BIOME TILE CACHE
+	//==========================================================================
+
+	/** Drop every cached biome tile; terrain is re-sampled on the next query */
+	UFUNCTION(BlueprintCallable, Category = "Biome|Cache")
+	void InvalidateBiomeCache();
+
+	/** Drop cached tiles overlapping a world-space box (e.g. after deforming terrain) */
+	void InvalidateBiomeCacheInBounds(const FBox& WorldBounds);
+
+	/** Tiles currently resident */
+	int32 GetResidentBiomeTileCount() const { return BiomeTiles.Num(); }
+
+	/** Rule table for the registered specs and current rule settings, recompiled if stale */
+	const FBiomeRuleTable& GetCompiledRules() const;
+
 	//==========================================================================
 	// CONFIGURATION
 	//==========================================================================
 
-	/** Sea level altitude (Z coordinate in world units, cm) */
+	/** Sea level altitude (Z coordinate in world units, cm); follows world origin rebases */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Biome|Config")
 	float SeaLevelAltitude = 0.0f;
 
-	/** Enable RVT-based biome lookup (requires RVT setup) */
+	/** Enable RVT-based biome lookup (requires RVTBiomeCaptureMaterial) */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Biome|Config")
 	bool bUseRVTBiomeLookup = false;
 
+	/**
+	 * Material that renders one tile of the biome RVT mask.
+	 * Drawn over the whole capture target; it should sample the biome RVT at world
+	 * XY = CaptureOrigin + UV * CaptureSize (vector/scalar parameters set per tile)
+	 * and emit the four channel weights as RGBA.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Biome|RVT")
+	TObjectPtr<UMaterialInterface> RVTBiomeCaptureMaterial;
+
+	/** Tiles kept captured around the view in each direction (1 = 3x3) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Biome|RVT", meta = (ClampMin = "0"))
+	int32 RVTCaptureRadiusTiles = 1;
+
+	/** Captures waiting on the GPU at once; also caps captures issued per frame */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Biome|RVT", meta = (ClampMin = "1"))
+	int32 MaxRVTReadbacksInFlight = 4;
+
+	/** CPU tiles kept resident before the least recently sampled is evicted */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Biome|RVT", meta = (ClampMin = "1"))
+	int32 MaxResidentRVTTiles = 64;
+
+	/** RVT mask channels (RGBA) */
+	static constexpr int32 NumRVTBiomeChannels = 4;
+
+	/** Capture texels per tile axis (same texels as the biome tile cache) */
+	static constexpr int32 RVTTileResolution = FSurfaceTileDelta::TilesPerCellAxis;
+
 	/** Enable altitude-based biome rules */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Biome|Config")
 	bool bUseAltitudeRules = true;
@@ -362,6 +605,29 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Biome|Config")
 	bool bUseSlopeRules = true;
 
+	/** Sample landscape heightfields directly instead of tracing where terrain is a landscape */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Biome|Terrain")
+	bool bUseLandscapeHeightfield = true;
+
+	/** Top of the terrain trace (cm, unrebased); traces span a fixed column, never the query's Z */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Biome|Terrain")
+	float TerrainTraceMaxZ = 1000000.0f;
+
+	/** Bottom of the terrain trace (cm, unrebased) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Biome|Terrain")
+	float TerrainTraceMinZ = -1000000.0f;
+
+	/** Cache terrain and rule-resolved biomes per world cell instead of tracing every query */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Biome|Cache")
+	bool bCacheBiomeTiles = true;
+
+	/** Tiles kept resident before the least recently sampled is evicted */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Biome|Cache", meta = (ClampMin = "1"))
+	int32 MaxResidentBiomeTiles = 64;
+
+	/** World size of one cached tile (cm) */
+	static constexpr float BiomeTileCellSize = 6400.0f;
+
 protected:
 	/**
 	 * Resolve biome from altitude and slope rules.
@@ -371,16 +637,156 @@ protected:
 
 	/**
 	 * Sample RVT at a location for biome mask values.
-	 * Returns biome weights per channel.
+	 * Returns biome weights per channel from the CPU tile cache; on a miss the
+	 * tile is requested and false is returned.
 	 */
-	bool SampleRVTAtLocation(const FVector& WorldLocation, TArray<float>& OutWeights) const;
+	bool SampleRVTAtLocation(const FVector& WorldLocation, TStaticArray<float, NumRVTBiomeChannels>& OutWeights) const;
+
+	/** Rebuild RVTChannelBiomes from the registered specs */
+	void RebuildRVTChannelTable();
+
+	/** Move finished readbacks into RVTTiles */
+	void CollectRVTReadbacks();
+
+	/** Request tiles around the view and issue captures for requested tiles */
+	void UpdateRVTCaptures();
+
+	/** Draw the capture material for a tile and queue its readback */
+	void IssueRVTCapture(const FWorldCellKey& CellKey);
 
 	/**
 	 * Find the landscape component at a location.
 	 */
 	ULandscapeComponent* FindLandscapeAtLocation(const FVector& WorldLocation) const;
 
+	/**
+	 * One downward trace for both terrain height and normal, through the fixed
+	 * TerrainTraceMinZ..MaxZ column at the location's XY (its Z is ignored), so the
+	 * result is the same for every query altitude.
+	 * @return false if there is no terrain (or none loaded) under the location
+	 */
+	bool SampleTerrain(const FVector& WorldLocation, float& OutHeight, FVector& OutNormal) const;
+
+	/**
+	 * Highest-weight RVT channel biomes at a location (secondary only above 1% weight).
+	 * @return false if RVT lookup is off, the tile is not resident or the channel has no biome
+	 */
+	bool ResolveBiomeFromRVT(const FVector& WorldLocation, FBiomeQueryResult& OutResult) const;
+
+	/**
+	 * Cached terrain and rule biome for the texel containing a location, baking it if needed.
+	 * @return false if the texel has no terrain (OutRuleBiome and OutTerrainHeight are then unset)
+	 */
+	bool FetchBiomeTexel(const FVector& WorldLocation, FBiomeId& OutRuleBiome, float& OutTerrainHeight, float& OutSlopeAngle) const;
+
+	/**
+	 * Heightfield height (and optionally normal) from the landscape under a location.
+	 * @return false if no loaded landscape covers the location
+	 */
+	bool SampleLandscape(const FVector& WorldLocation, float& OutHeight, FVector* OutNormal) const;
+
+	/** Rebuild LandscapeEntries from the world's landscape proxies */
+	void RefreshLandscapeEntries() const;
+
+	void HandleLevelChanged(ULevel* Level, UWorld* World);
+
+	/** Tiles, RVT captures and landscape footprints are keyed in world space */
+	void HandleWorldOriginRebased(const FIntVector& ShiftCm);
+
 private:
+	/** Terrain and rule-resolved biome for one cell, one texel per surface tile */
+	struct FBiomeTile
+	{
+		static constexpr int32 TexelsPerAxis = FSurfaceTileDelta::TilesPerCellAxis;
+		static constexpr int32 TexelCount = TexelsPerAxis * TexelsPerAxis;
+
+		/** EBiomeTexelTerrain per texel */
+		TArray<uint8> TerrainStates;
+
+		/** Index into BiomeTilePalette per texel (see BiomeTexel* markers in the .cpp) */
+		TArray<uint8> BiomeIndices;
+
+		TArray<float> Heights;
+		TArray<FVector3f> Normals;
+
+		/** Rule key the BiomeIndices were resolved under */
+		uint32 RuleKey = 0;
+
+		/** Last frame this tile was sampled (for eviction) */
+		uint64 LastUsedFrame = 0;
+	};
+
+	/** Hash of everything ResolveBiomeFromRules depends on besides altitude/slope */
+	uint32 GetBiomeRuleKey() const;
+
+	/** Compiled on first resolve after the rule key changes (not per registration) */
+	mutable FBiomeRuleTable CompiledRules;
+	mutable uint32 CompiledRulesKey = 0;
+	mutable bool bCompiledRulesValid = false;
+
+	/** Published rule snapshot and the rule key it was built under */
+	mutable TSharedPtr<const FBiomeQuerySnapshot, ESPMode::ThreadSafe> QuerySnapshot;
+	mutable uint32 QuerySnapshotKey = 0;
+
+	/** Resident tile for a cell, allocated (unbaked) on first use */
+	FBiomeTile& FindOrAddBiomeTile(const FWorldCellKey& CellKey) const;
+
+	/** Tile for the texel containing a location, with that texel's terrain baked if it was not */
+	FBiomeTile& FetchTerrainTexel(const FVector& WorldLocation, int32& OutTexel) const;
+
+	/** Palette slot for a biome, or INDEX_NONE if the palette is full */
+	int32 FindOrAddBiomePaletteIndex(const FBiomeId& BiomeId) const;
+
+	/** Resident tiles (lazily baked, see FetchBiomeTexel) */
+	mutable TMap<FWorldCellKey, FBiomeTile> BiomeTiles;
+
+	/** Biomes referenced by tile texels; append-only until the cache is invalidated */
+	mutable TArray<FBiomeId> BiomeTilePalette;
+
+	/** Bumped by spec registration so cached texels re-resolve */
+	uint32 BiomeRulesRevision = 0;
+
+	FDelegateHandle LevelAddedHandle;
+	FDelegateHandle LevelRemovedHandle;
+	FDelegateHandle OriginRebasedHandle;
+
+	/** A landscape proxy and its XY footprint, gathered once per level change */
+	struct FLandscapeEntry
+	{
+		TWeakObjectPtr<ALandscapeProxy> Proxy;
+		FBox2D Bounds = FBox2D(ForceInit);
+
+		/** Heightfield quad size (cm), the spacing of the normal's neighbour samples */
+		float QuadSize = 100.0f;
+	};
+
+	mutable TArray<FLandscapeEntry> LandscapeEntries;
+	mutable bool bLandscapeEntriesDirty = true;
+
+	/** Read-back biome mask for one cell (RVTTileResolution^2 texels, row = Y) */
+	struct FRVTBiomeTile
+	{
+		TArray<FColor> Texels;
+		uint64 LastUsedFrame = 0;
+	};
+
+	mutable TMap<FWorldCellKey, FRVTBiomeTile> RVTTiles;
+
+	/** Tiles queries missed on, captured by the next Tick */
+	mutable TSet<FWorldCellKey> RequestedRVTTiles;
+
+	/** Captures waiting on the GPU (defined in the .cpp) */
+	TArray<TSharedPtr<FRVTBiomeReadback, ESPMode::ThreadSafe>> PendingRVTReadbacks;
+
+	/** Biome for each RVT channel; first registered spec per channel wins */
+	TStaticArray<FBiomeId, NumRVTBiomeChannels> RVTChannelBiomes;
+
+	UPROPERTY(Transient)
+	TObjectPtr<UTextureRenderTarget2D> RVTCaptureTarget;
+
+	UPROPERTY(Transient)
+	TObjectPtr<UMaterialInstanceDynamic> RVTCaptureMaterialInstance;
+
 	/** Registered biome specs (keyed by FBiomeId) */
 	UPROPERTY()
 	TMap<FName, FBiomeSpec> BiomeSpecs;
@@ -0,0 +1,131 @@
+// Copyright 2026 Threaded Pixel Factory
+// Licensed under the Apache License, Version 2.0 (the "License");
+// SPDX-License-Identifier: Apache-2.0
+
+/**
+ * Core Data Warmup Subsystem - Parallel startup loading of game-instance data
+ *
+ * Purpose:
+ * The star catalog, the solar system tables and the game's settings and spec
+ * packs are independent loads. Run back to back on the game thread they add up to
+ * a long first frame; started together on workers they overlap, and the menu can
+ * show while they finish.
+ *
+ * Tasks:
+ * - Each warm-up task has a name, the names of the tasks it needs first, and a
+ *   start function run on the game thread; the task calls OnDone (game thread)
+ *   when its data is in
+ * - A task starts as soon as its prerequisites are done; independent tasks are in
+ *   flight together
+ * - Unknown prerequisites count as done (with a warning); a cycle is broken by
+ *   starting the blocked tasks anyway
+ * - Built in: "StarCatalog" (UStarCatalogSubsystem::EnsureLoadedAsync) and
+ *   "SolarSystem" (USolarSystemSubsystem::WarmUpAsync)
+ * - Other modules add theirs from OnGatherWarmupTasks, or directly before
+ *   BeginWarmup; tasks added after BeginWarmup start right away
+ *
+ * Readiness:
+ * Once every task is done the core data is ready: OnCoreDataReady fires once and
+ * IsCoreDataReady() turns true (tasks added later do not reset it). Nothing stops
+ * queries earlier - each subsystem answers from its defaults until its data
+ * lands - this is for UI and flows that want to wait.
+ * Nothing starts until BeginWarmup; without it the subsystems load on first use.
+ *
+ * Usage:
+ *   UCoreDataWarmupSubsystem* Warmup = GameInstance->GetSubsystem<UCoreDataWarmupSubsystem>();
+ *   Warmup->AddWarmupTask(TEXT("Settings"), {}, [](FSimpleDelegate OnDone) { LoadSettingsAsync(OnDone); });
+ *   Warmup->BeginWarmup();
+ *   Warmup->CallWhenCoreDataReady(FSimpleDelegate::CreateUObject(this, &UMyMenu::ShowPlay));
+ *
+ * @see ULauncherGameInstance::Init for the startup sequence
+ */
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/GameInstanceSubsystem.h"
+#include "CoreDataWarmupSubsystem.generated.h"
+
+class UCoreDataWarmupSubsystem;
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE(FOnCoreDataReady);
+
+/** Lets modules add warm-up tasks when the subsystem initializes */
+DECLARE_MULTICAST_DELEGATE_OneParam(FOnGatherWarmupTasks, UCoreDataWarmupSubsystem& /*Warmup*/);
+
+/** Starts a warm-up task (game thread); call OnDone on the game thread when finished */
+using FWarmupTaskStart = TUniqueFunction<void(FSimpleDelegate /*OnDone*/)>;
+
+/**
+ * Game-instance subsystem starting the startup data loads in parallel.
+ */
+UCLASS()
+class UETPFCORE_API UCoreDataWarmupSubsystem : public UGameInstanceSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+
+	/**
+	 * Add a task, started once every task in Prerequisites is done.
+	 * @return false if a task with this name already exists
+	 */
+	bool AddWarmupTask(FName Name, TArray<FName> Prerequisites, FWarmupTaskStart Start);
+
+	/** Start every task whose prerequisites are done (idempotent) */
+	void BeginWarmup();
+
+	/** True once every task is done */
+	UFUNCTION(BlueprintPure, Category = "Warmup")
+	bool IsCoreDataReady() const { return bReady; }
+
+	/** Finished tasks over all tasks (1 with none) */
+	UFUNCTION(BlueprintPure, Category = "Warmup")
+	float GetWarmupProgress() const;
+
+	/** True once the named task is done */
+	UFUNCTION(BlueprintPure, Category = "Warmup")
+	bool IsWarmupTaskComplete(FName Name) const;
+
+	/** Run Callback once the core data is ready (immediately if it is) */
+	void CallWhenCoreDataReady(FSimpleDelegate Callback);
+
+	/** Fires once, when the last task finishes */
+	UPROPERTY(BlueprintAssignable, Category = "Warmup")
+	FOnCoreDataReady OnCoreDataReady;
+
+	/** Broadcast from Initialize, after the built-in tasks are added */
+	static FOnGatherWarmupTasks& OnGatherWarmupTasks();
+
+private:
+	struct FWarmupTask
+	{
+		FName Name;
+		TArray<FName> Prerequisites;
+		FWarmupTaskStart Start;
+		double StartSeconds = 0.0;
+		bool bStarted = false;
+		bool bComplete = false;
+	};
+
+	/** Start what can start; breaks a cycle when nothing is in flight */
+	void StartReadyTasks();
+
+	void StartTask(int32 TaskIndex);
+	void CompleteTask(FName Name);
+
+	bool ArePrerequisitesComplete(const FWarmupTask& Task) const;
+	int32 FindTask(FName Name) const;
+
+	TArray<FWarmupTask> Tasks;
+	TArray<FSimpleDelegate> ReadyCallbacks;
+
+	double WarmupStartSeconds = 0.0;
+	bool bWarmupStarted = false;
+	bool bReady = false;
+
+	/** Set while StartReadyTasks runs, so tasks finishing synchronously don't recurse */
+	bool bStartingTasks = false;
+};
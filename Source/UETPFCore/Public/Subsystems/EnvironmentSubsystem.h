@@ -8,10 +8,13 @@
 #include "Subsystems/WorldSubsystem.h"
 #include "Components/BoxComponent.h"
 #include "SpecTypes.h"
+#include "SpecRegistry.h"
+#include "DeltaTypes.h"
+#include "GlobalAtmosphereField.h"
+#include "UObject/ObjectKey.h"
 #include "EnvironmentSubsystem.generated.h"
 
 class UMediumSpec;
-class UGlobalAtmosphereField;
 
 /**
  * Volume component that defines an environmental medium region.
@@ -44,6 +47,82 @@ public:
 	/** Wind velocity within this volume */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Environment|Overrides")
 	FVector WindVelocity = FVector::ZeroVector;
+
+	//--- UActorComponent / USceneComponent Interface ---
+	virtual void OnRegister() override;
+	virtual void OnUnregister() override;
+	virtual void UpdateBounds() override;
+};
+
+/**
+ * Drag and buoyancy for one body, evaluated from a single environment lookup.
+ */
+USTRUCT(BlueprintType)
+struct UETPFCORE_API FEnvironmentalForces
+{
+	GENERATED_BODY()
+
+	/** Drag force (opposing velocity) */
+	UPROPERTY(BlueprintReadOnly, Category = "Environment")
+	FVector Drag = FVector::ZeroVector;
+
+	/** Buoyancy force (opposing gravity) */
+	UPROPERTY(BlueprintReadOnly, Category = "Environment")
+	FVector Buoyancy = FVector::ZeroVector;
+
+	FVector GetTotal() const { return Drag + Buoyancy; }
+};
+
+/**
+ * Immutable published copy of everything an environment query reads:
+ * volume placements with their medium contexts pre-resolved, the volume grid,
+ * the atmosphere model and the default medium.
+ * 
+ * Take one on the game thread with UEnvironmentSubsystem::GetQuerySnapshot(),
+ * then query it from any thread without locks. A held snapshot never changes;
+ * later edits publish a new one.
+ */
+struct UETPFCORE_API FEnvironmentQuerySnapshot
+{
+	/**
+	 * Same resolution order and results as UEnvironmentSubsystem::GetEnvironmentAtLocation.
+	 * TimeSeconds drives the atmosphere's gust field; pass the world time the live query would use.
+	 */
+	FEnvironmentContext GetEnvironmentAtLocation(const FVector& WorldLocation, double TimeSeconds = 0.0) const;
+
+	/** Batch version, evaluated on the calling thread */
+	void GetEnvironmentAtLocations(TConstArrayView<FVector> WorldLocations, TArrayView<FEnvironmentContext> OutContexts,
+		double TimeSeconds = 0.0) const;
+
+	struct FVolume
+	{
+		FTransform Transform;
+		FVector Extent = FVector::ZeroVector;
+		FBox Bounds = FBox(ForceInit);
+		int32 Priority = 0;
+
+		/** Medium spec with volume overrides applied; invalid if the volume has no spec */
+		FEnvironmentContext Context;
+	};
+
+	/** Highest-priority volume containing a location (null outside every volume) */
+	const FVolume* FindVolumeAtLocation(const FVector& WorldLocation) const;
+
+	TArray<FVolume> Volumes;
+	TMap<FWorldCellKey, TArray<int32>> VolumeGrid;
+	TArray<int32> OversizedVolumes;
+	float VolumeGridCellSize = 6400.0f;
+
+	/** Used outside volumes when bHasAtmosphere */
+	bool bHasAtmosphere = false;
+	FAtmosphereModel Atmosphere;
+
+	/** Config and revision Atmosphere was baked from; GetQuerySnapshot republishes when either changes */
+	TObjectKey<UAtmosphereConfig> AtmosphereConfig;
+	uint32 AtmosphereRevision = 0;
+
+	/** Final fallback (invalid if there is no default medium spec) */
+	FEnvironmentContext DefaultContext;
 };
 
 /**
@@ -53,6 +132,17 @@ public:
  * Usage:
  *   - Call GetEnvironmentAtLocation() to get the full environmental context
  *   - Used by drag/buoyancy calculations, audio system, precipitation
+ * 
+ * Volume lookup:
+ *   Registered volumes are bucketed into a uniform grid of FWorldCellKey cells
+ *   (VolumeGridCellSize). A point query tests only the volumes in its cell plus
+ *   the few oversized ones, against cached oriented boxes.
+ *   Each volume's FEnvironmentContext (medium spec plus overrides) is resolved when
+ *   it registers and whenever specs change, so a volume hit is a copy, not a rebuild.
+ * 
+ * Threading:
+ *   Live queries are game thread only. Worker threads (AI, audio, simulation tasks)
+ *   sample an immutable FEnvironmentQuerySnapshot from GetQuerySnapshot() instead.
  */
 UCLASS()
 class UETPFCORE_API UEnvironmentSubsystem : public UWorldSubsystem
@@ -81,6 +171,32 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Environment|Query")
 	FEnvironmentContext GetEnvironmentAtLocation(const FVector& WorldLocation) const;
 
+	/**
+	 * Batch version of GetEnvironmentAtLocation for many points (ballistics, debris).
+	 * Volume lookups run across worker threads; points outside every volume are
+	 * evaluated in one batch by the GlobalAtmosphereField.
+	 * Game thread only - volumes must not be registered or moved during the call.
+	 * 
+	 * @param WorldLocations - Locations to query
+	 * @param OutContexts - One context per location (same length as WorldLocations)
+	 */
+	void GetEnvironmentAtLocations(TConstArrayView<FVector> WorldLocations, TArrayView<FEnvironmentContext> OutContexts) const;
+
+	/**
+	 * Current immutable query snapshot, for sampling from worker threads.
+	 * Game thread only; republished lazily after volumes, medium specs, the
+	 * atmosphere field, its AtmosphereConfig or the config's revision change.
+	 * Queries on the returned snapshot are thread-safe.
+	 */
+	TSharedRef<const FEnvironmentQuerySnapshot, ESPMode::ThreadSafe> GetQuerySnapshot() const;
+
+	/**
+	 * Re-resolve every volume's medium context and force the next GetQuerySnapshot() to republish.
+	 * Call after editing volume properties or the atmosphere config in place.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Environment|Query")
+	void InvalidateQuerySnapshot();
+
 	/**
 	 * Get the medium spec ID at a world location.
 	 * Quick lookup without building full context.
@@ -130,6 +246,32 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Environment|Physics")
 	FVector CalculateBuoyancyForce(const FVector& WorldLocation, float DisplacedVolume) const;
 
+	/**
+	 * Drag and buoyancy from one environment lookup.
+	 * 
+	 * @param WorldLocation - Object's location
+	 * @param Velocity - Object's velocity (cm/s)
+	 * @param DragArea - Effective drag area (cm²)
+	 * @param DragCoefficient - Cd (typically 0.3-1.0)
+	 * @param DisplacedVolume - Volume of fluid displaced (cm³), 0 to skip buoyancy
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Environment|Physics")
+	FEnvironmentalForces CalculateEnvironmentalForces(const FVector& WorldLocation, const FVector& Velocity,
+		float DragArea, float DragCoefficient, float DisplacedVolume) const;
+
+	//--- Context kernels: no lookup, for callers that already hold a context ---
+
+	/** Drag force in a resolved environment (see CalculateDragForce) */
+	static FVector CalculateDragForceInContext(const FEnvironmentContext& Context, const FVector& Velocity,
+		float DragArea, float DragCoefficient = 0.5f);
+
+	/** Buoyancy force in a resolved environment (see CalculateBuoyancyForce) */
+	static FVector CalculateBuoyancyForceInContext(const FEnvironmentContext& Context, float DisplacedVolume);
+
+	/** Drag and buoyancy in a resolved environment */
+	static FEnvironmentalForces CalculateEnvironmentalForcesInContext(const FEnvironmentContext& Context,
+		const FVector& Velocity, float DragArea, float DragCoefficient, float DisplacedVolume);
+
 	//==========================================================================
 	// SPEC REGISTRATION
 	//==========================================================================
@@ -179,17 +321,32 @@ public:
 	/**
 	 * Register a runtime medium spec by ID.
 	 * This is the primary method for SpecPack loading.
+	 * Returns a handle for hot-path lookups (stable if the ID is registered again).
 	 */
 	UFUNCTION(BlueprintCallable, Category = "Environment|Registration")
-	void RegisterRuntimeMediumSpec(const FMediumSpecId& Id, const FRuntimeMediumSpec& Spec);
+	FSpecHandle RegisterRuntimeMediumSpec(const FMediumSpecId& Id, const FRuntimeMediumSpec& Spec);
 
 	/**
 	 * Resolve a medium spec by ID.
-	 * Resolution order: Runtime registry → DataAsset fallback → Default
+	 * Resolution order: Runtime registry → DataAsset (converted at registration) → Default
+	 * Copies the spec - C++ callers should prefer ResolveMediumSpecRef / GetRuntimeMediumSpec.
 	 */
 	UFUNCTION(BlueprintCallable, Category = "Environment|Query")
 	bool ResolveMediumSpec(const FMediumSpecId& Id, FRuntimeMediumSpec& OutSpec) const;
 
+	/**
+	 * Resolve a medium spec by ID without copying.
+	 * Valid until the next registration or ClearRuntimeMediumSpecs().
+	 */
+	const FRuntimeMediumSpec& ResolveMediumSpecRef(const FMediumSpecId& Id, bool* bOutFound = nullptr) const;
+
+	/** Handle for a registered runtime medium spec (invalid if not registered) */
+	UFUNCTION(BlueprintCallable, Category = "Environment|Query")
+	FSpecHandle GetMediumSpecHandle(const FMediumSpecId& Id) const;
+
+	/** Medium spec for a handle; the fallback spec if the handle is invalid or stale */
+	const FRuntimeMediumSpec& GetRuntimeMediumSpec(FSpecHandle Handle) const;
+
 	/**
 	 * Check if a runtime spec is registered.
 	 */
@@ -204,10 +361,21 @@ public:
 
 	/**
 	 * Clear all runtime medium specs.
+	 * Registered DataAsset specs are re-interned, so they keep resolving.
 	 */
 	UFUNCTION(BlueprintCallable, Category = "Environment|Registration")
 	void ClearRuntimeMediumSpecs();
 
+	/**
+	 * Register only the medium specs that differ from what is registered (hot reload).
+	 * A spec differs when it is new or its Version or any field changed. Changed
+	 * entries are overwritten in place, so handles stay valid; the query snapshot is
+	 * republished only if something changed.
+	 * 
+	 * @return Number of specs registered
+	 */
+	int32 UpdateRuntimeMediumSpecs(TConstArrayView<FRuntimeMediumSpec> Specs);
+
 	/**
 	 * Get the hardcoded fallback medium spec (Earth atmosphere).
 	 */
@@ -225,6 +393,18 @@ public:
 	 */
 	void UnregisterVolume(UEnvironmentVolumeComponent* Volume);
 
+	/**
+	 * Re-index a registered volume after it moved or was resized.
+	 * Called automatically from the component's bounds update.
+	 */
+	void UpdateVolume(UEnvironmentVolumeComponent* Volume);
+
+	/** Grid cell size for the volume index (cm) */
+	static constexpr float VolumeGridCellSize = 6400.0f;
+
+	/** Volumes spanning more grid cells than this are tested on every query instead */
+	static constexpr int32 MaxVolumeGridCells = 64;
+
 protected:
 	/** Find the highest-priority volume containing a location */
 	UEnvironmentVolumeComponent* FindVolumeAtLocation(const FVector& WorldLocation) const;
@@ -250,8 +430,61 @@ private:
 	UPROPERTY()
 	TArray<UEnvironmentVolumeComponent*> RegisteredVolumes;
 
-	/** Runtime medium spec registry (SpecPack / JSON workflow) */
-	TMap<FName, FRuntimeMediumSpec> RuntimeMediumSpecs;
+	/** Cached placement of a registered volume (oriented box) */
+	struct FVolumeIndexEntry
+	{
+		UEnvironmentVolumeComponent* Volume = nullptr;
+		FTransform Transform;
+		FVector Extent = FVector::ZeroVector;
+		FBox Bounds = FBox(ForceInit);
+
+		/** Medium spec with volume overrides applied; invalid if the volume has no spec */
+		FEnvironmentContext Context;
+
+		bool Contains(const FVector& WorldLocation) const;
+	};
+
+	/** Highest-priority entry containing a location */
+	const FVolumeIndexEntry* FindVolumeEntryAtLocation(const FVector& WorldLocation) const;
+
+	/** Resolve an entry's medium context from its volume's spec and overrides */
+	void ResolveVolumeContext(FVolumeIndexEntry& Entry) const;
+
+	/** Insert/remove an entry's cells (or the oversized list) */
+	void AddVolumeToGrid(int32 EntryIndex);
+	void RemoveVolumeFromGrid(int32 EntryIndex);
+
+	/** Grid cells covered by an entry's bounds; false if it exceeds MaxVolumeGridCells */
+	static bool GetVolumeGridRange(const FBox& Bounds, FIntPoint& OutMin, FIntPoint& OutMax);
+
+	/** Copy the current volumes, specs and atmosphere into a new snapshot */
+	TSharedRef<FEnvironmentQuerySnapshot, ESPMode::ThreadSafe> BuildQuerySnapshot() const;
+
+	/** Published snapshot; null when it needs to be rebuilt */
+	mutable TSharedPtr<const FEnvironmentQuerySnapshot, ESPMode::ThreadSafe> QuerySnapshot;
+
+	/** Volumes re-index themselves as they move; the snapshot's atmosphere sea level does not */
+	void HandleWorldOriginRebased(const FIntVector& ShiftCm);
+
+	FDelegateHandle OriginRebasedHandle;
+
+	/** Spatial index over RegisteredVolumes */
+	TSparseArray<FVolumeIndexEntry> VolumeEntries;
+	TMap<TObjectKey<UEnvironmentVolumeComponent>, int32> VolumeEntryIndices;
+	TMap<FWorldCellKey, TArray<int32>> VolumeGrid;
+	TArray<int32> OversizedVolumes;
+
+	/**
+	 * Resolved medium specs by ID, from both sources: runtime specs (SpecPack / JSON)
+	 * and DataAssets converted once with ToStruct. Runtime specs take precedence.
+	 */
+	TSpecRegistry<FRuntimeMediumSpec> RuntimeMediumSpecs;
+
+	/** IDs registered through RegisterRuntimeMediumSpec */
+	TSet<FName> RuntimeAuthoredMediumIds;
+
+	/** Intern an asset's converted struct unless a runtime spec owns the ID */
+	void InternMediumSpecAsset(const FName& Id, const UMediumSpec* Spec);
 
 	/** Hardcoded fallback medium spec (Earth atmosphere) */
 	static FRuntimeMediumSpec FallbackMediumSpec;
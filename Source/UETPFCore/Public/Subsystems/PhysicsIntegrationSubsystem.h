@@ -7,11 +7,13 @@
 #include "CoreMinimal.h"
 #include "Subsystems/WorldSubsystem.h"
 #include "SpecTypes.h"
+#include "UObject/ObjectKey.h"
 #include "PhysicsIntegrationSubsystem.generated.h"
 
 class USurfaceQuerySubsystem;
 class UEnvironmentSubsystem;
 class UPrimitiveComponent;
+class FEnvironmentForceSimCallback;
 
 /**
  * Delegate for when an impact exceeds damage threshold.
@@ -34,6 +36,47 @@ DECLARE_DYNAMIC_MULTICAST_DELEGATE_FourParams(
 	FDamageSpecId, DamageSpecId
 );
 
+/**
+ * One damaging impact, as delivered in an OnImpactDamageBatch broadcast.
+ */
+USTRUCT(BlueprintType)
+struct UETPFCORE_API FImpactDamageEvent
+{
+	GENERATED_BODY()
+
+	/** The component that experienced the impact */
+	UPROPERTY(BlueprintReadOnly, Category = "Physics|Impact")
+	TObjectPtr<UPrimitiveComponent> Component = nullptr;
+
+	/** What it hit (may be null, e.g. for world geometry) */
+	UPROPERTY(BlueprintReadOnly, Category = "Physics|Impact")
+	TObjectPtr<UPrimitiveComponent> OtherComponent = nullptr;
+
+	/** Hit of the strongest contact between the pair this frame */
+	UPROPERTY(BlueprintReadOnly, Category = "Physics|Impact")
+	FHitResult Hit;
+
+	/** Impact energy in Joules */
+	UPROPERTY(BlueprintReadOnly, Category = "Physics|Impact")
+	float ImpactEnergy = 0.0f;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Physics|Impact")
+	FDamageSpecId DamageSpecId;
+};
+
+/**
+ * Delegate for all damaging impacts of a frame, one broadcast per frame.
+ * 
+ * Parameters:
+ * - Impacts: One event per (component, other component) pair, strongest contact wins
+ * 
+ * @note Prefer this over FOnImpactDamage for destruction FX and fracture deltas during large collapses
+ */
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(
+	FOnImpactDamageBatch,
+	const TArray<FImpactDamageEvent>&, Impacts
+);
+
 /**
  * Delegate for when a body settles (goes to sleep).
  * Useful for delta persistence - allows saving final resting state.
@@ -53,28 +96,86 @@ DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(
 );
 
 /**
- * Per-body physics state cache.
- * Stored to avoid redundant queries each frame.
+ * How UPhysicsIntegrationSubsystem::Tick bounds its per-frame body work.
+ */
+UENUM(BlueprintType)
+enum class EPhysicsBodyScheduleMode : uint8
+{
+	/** Service up to MaxBodiesPerFrame bodies per frame */
+	BodyCount,
+	/** Service bodies until BodyTimeBudgetMicroseconds is spent (at least one per frame) */
+	TimeBudget
+};
+
+/**
+ * Level of detail for bodies within a distance of the nearest player view.
+ */
+USTRUCT(BlueprintType)
+struct UETPFCORE_API FPhysicsLODTier
+{
+	GENERATED_BODY()
+
+	/** Bodies closer than this (cm) to the nearest view use this tier; the last tier catches the rest */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Physics|LOD")
+	float MaxDistance = 5000.0f;
+
+	/** Environment re-query rate (Hz) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Physics|LOD", meta = (ClampMin = "0.01"))
+	float EnvironmentQueryRate = 10.0f;
+
+	/** Minimum frames between force evaluations */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Physics|LOD", meta = (ClampMin = "1"))
+	int32 ServiceInterval = 1;
+
+	/** Full model applies buoyancy; false skips it and applies drag only */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Physics|LOD")
+	bool bApplyBuoyancy = true;
+};
+
+/**
+ * Per-tier work from the last UPhysicsIntegrationSubsystem::Tick.
+ */
+USTRUCT(BlueprintType)
+struct UETPFCORE_API FPhysicsLODTierStats
+{
+	GENERATED_BODY()
+
+	/** Registered bodies last assigned to this tier */
+	UPROPERTY(BlueprintReadOnly, Category = "Physics|LOD")
+	int32 NumBodies = 0;
+
+	/** Bodies whose forces were evaluated */
+	UPROPERTY(BlueprintReadOnly, Category = "Physics|LOD")
+	int32 BodiesServiced = 0;
+
+	/** Environment queries issued */
+	UPROPERTY(BlueprintReadOnly, Category = "Physics|LOD")
+	int32 EnvironmentQueries = 0;
+};
+
+/**
+ * Stable handle to a body registered with UPhysicsIntegrationSubsystem.
+ * Survives other bodies being added/removed; goes stale when its body is unregistered.
  */
-USTRUCT()
-struct FBodyPhysicsCache
+USTRUCT(BlueprintType)
+struct UETPFCORE_API FPhysicsBodyHandle
 {
 	GENERATED_BODY()
 
-	/** Cached environment context */
-	FEnvironmentContext EnvironmentContext;
+	UPROPERTY(BlueprintReadOnly, Category = "Physics")
+	int32 Slot = INDEX_NONE;
 
-	/** Last query time */
-	double LastQueryTime = 0.0;
+	UPROPERTY(BlueprintReadOnly, Category = "Physics")
+	int32 Generation = 0;
 
-	/** Accumulated drag force this frame */
-	FVector AccumulatedDrag = FVector::ZeroVector;
+	FPhysicsBodyHandle() = default;
+	FPhysicsBodyHandle(int32 InSlot, int32 InGeneration) : Slot(InSlot), Generation(InGeneration) {}
 
-	/** Is body currently asleep? */
-	bool bIsSleeping = false;
+	bool IsValid() const { return Slot != INDEX_NONE; }
+	bool operator==(const FPhysicsBodyHandle& Other) const { return Slot == Other.Slot && Generation == Other.Generation; }
+	bool operator!=(const FPhysicsBodyHandle& Other) const { return !(*this == Other); }
 
-	/** Frame counter for update throttling */
-	int32 LastUpdateFrame = 0;
+	friend uint32 GetTypeHash(const FPhysicsBodyHandle& Handle) { return HashCombine(::GetTypeHash(Handle.Slot), ::GetTypeHash(Handle.Generation)); }
 };
 
 /**
@@ -87,6 +188,50 @@ struct FBodyPhysicsCache
  * - Track body sleep states → emit settle events for delta persistence
  * 
  * This is the "Systems consume context" step in the data flow pipeline.
+ * 
+ * Scheduling:
+ *   Tick services bodies round-robin from a persistent cursor, bounded by a body
+ *   count or a time budget, so every registered body is reached at a predictable
+ *   rate however many are registered. Forces are applied as impulses integrated
+ *   over the time since a body was last serviced. With bPrioritizeActiveBodies,
+ *   bodies that are asleep, or slow and off-screen, are serviced at most every
+ *   LowPriorityServiceInterval frames, leaving the budget to active bodies.
+ * 
+ * Tick pipeline (per frame):
+ *   1. Gather (serial)   - pick bodies, snapshot location/velocity/size/mass
+ *   2. Environment       - one batched query for bodies whose cache is due
+ *   3. Compute (parallel)- ParallelFor over snapshots → impulses, no UObject access
+ *   4. Apply (serial)    - AddImpulse, sleep checks, then settle broadcasts
+ * 
+ * Body storage:
+ *   Registered bodies live in packed structure-of-arrays storage (Body* arrays,
+ *   index i is one body), so the per-frame sweep is a linear walk with no hashing.
+ *   Removal swaps the last body into the hole; FPhysicsBodyHandle indirects through
+ *   a slot table so handles stay stable across that.
+ * 
+ * LOD tiers:
+ *   Each serviced body picks a tier from LODTiers by distance to the nearest player
+ *   view. The tier sets its environment query rate, how often its forces are
+ *   evaluated and whether buoyancy is applied. EnvironmentQueryRate applies only
+ *   when LODTiers is empty.
+ * 
+ * Sleep tracking:
+ *   Awake bodies are packed at [0, NumActiveBodies), sleeping ones after them.
+ *   Chaos sleep/wake events (OnComponentSleep/OnComponentWake) move bodies across
+ *   that boundary and fire OnBodySettled, so Tick never polls sleep state and only
+ *   sweeps the active range - with everything settled it does almost nothing.
+ * 
+ * Impact hits (bAutoBindImpactHits):
+ *   Bodies registered with a damage spec get hit notifies and an OnComponentHit
+ *   binding that feeds ProcessCollisionHit. Each body caches the impulse needed to
+ *   reach its ImpactThresholdMin; weaker hits are dropped before they are queued,
+ *   and the solver's collision event filter drops contacts below the weakest such
+ *   impulse on the physics thread, so resting contacts never reach the game thread.
+ * 
+ * Physics-thread forces (bUseAsyncPhysicsForces):
+ *   Drag and buoyancy are evaluated by a Chaos sim callback before every physics
+ *   step, at substep rate, against an immutable FEnvironmentQuerySnapshot. Tick then
+ *   only hands the callback the awake bodies' proxies and keeps sleep tracking.
  */
 UCLASS()
 class UETPFCORE_API UPhysicsIntegrationSubsystem : public UTickableWorldSubsystem
@@ -100,6 +245,7 @@ public:
 	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
 	virtual void Deinitialize() override;
 	virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
 	
 	//--- UTickableWorldSubsystem Interface ---
 	virtual void Tick(float DeltaTime) override;
@@ -112,12 +258,14 @@ public:
 	/**
 	 * Register a physics body for integration.
 	 * Registered bodies receive drag/buoyancy forces and contact friction modification.
+	 * With a damage spec (and bAutoBindImpactHits) its hits are routed to
+	 * ProcessCollisionHit automatically; no OnComponentHit handler is needed.
 	 * 
 	 * @param Component - The primitive component with physics
 	 * @param DamageSpecId - Optional damage spec for impact handling
 	 */
 	UFUNCTION(BlueprintCallable, Category = "Physics|Registration")
-	void RegisterPhysicsBody(UPrimitiveComponent* Component, FDamageSpecId DamageSpecId = FDamageSpecId());
+	FPhysicsBodyHandle RegisterPhysicsBody(UPrimitiveComponent* Component, FDamageSpecId DamageSpecId = FDamageSpecId());
 
 	/**
 	 * Unregister a physics body.
@@ -131,6 +279,18 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Physics|Registration")
 	bool IsBodyRegistered(UPrimitiveComponent* Component) const;
 
+	/** Handle for a registered component (invalid if not registered) */
+	UFUNCTION(BlueprintCallable, Category = "Physics|Registration")
+	FPhysicsBodyHandle GetPhysicsBodyHandle(UPrimitiveComponent* Component) const;
+
+	/** Component for a handle (null if the handle is stale) */
+	UFUNCTION(BlueprintCallable, Category = "Physics|Registration")
+	UPrimitiveComponent* GetPhysicsBodyComponent(FPhysicsBodyHandle Handle) const;
+
+	/** Number of registered bodies */
+	UFUNCTION(BlueprintCallable, Category = "Physics|Registration")
+	int32 GetNumRegisteredBodies() const { return BodyComponents.Num(); }
+
 	//==========================================================================
 	// DRAG AND BUOYANCY
 	//==========================================================================
@@ -160,8 +320,9 @@ public:
 	FVector CalculateBodyBuoyancy(UPrimitiveComponent* Component, float DisplacedVolume) const;
 
 	/**
-	 * Apply accumulated drag and buoyancy forces to a body.
-	 * Called automatically during Tick for registered bodies.
+	 * Apply drag and buoyancy to a body as an impulse over DeltaTime.
+	 * Called automatically during Tick for registered bodies, with the time since
+	 * the body was last serviced. Drag never removes more than the body's momentum.
 	 */
 	void ApplyEnvironmentalForces(UPrimitiveComponent* Component, float DeltaTime);
 
@@ -172,6 +333,7 @@ public:
 	/**
 	 * Get the surface state at a contact point.
 	 * Combines SurfaceQuerySubsystem with environmental modifiers.
+	 * Served from the SurfaceQuerySubsystem state cache when the tile is unchanged.
 	 * 
 	 * @param HitResult - The contact hit result
 	 * @return FSurfaceState with effective friction values
@@ -210,6 +372,13 @@ public:
 	UPROPERTY(BlueprintAssignable, Category = "Physics|Events")
 	FOnImpactDamage OnImpactDamage;
 
+	/**
+	 * Fired once per frame with every impact that exceeded its damage threshold.
+	 * Hits are deduplicated per body pair; OnImpactDamage still fires per event.
+	 */
+	UPROPERTY(BlueprintAssignable, Category = "Physics|Events")
+	FOnImpactDamageBatch OnImpactDamageBatch;
+
 	/**
 	 * Fired when a registered physics body goes to sleep (settles after movement).
 	 * Useful for persisting final object positions in world delta systems.
@@ -239,17 +408,26 @@ public:
 	float CalculateImpactEnergy(float NormalImpulse, float Mass) const;
 
 	/**
-	 * Process a collision hit for potential damage.
-	 * Compares impact energy against DamageSpec thresholds.
-	 * Fires OnImpactDamage delegate if threshold exceeded.
+	 * Make a damage spec resolvable by its SpecId. Bodies already registered with
+	 * that id pick up its thresholds.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Physics|Impact")
+	void RegisterDamageSpec(UDamageSpec* Spec);
+
+	/**
+	 * Queue a collision hit for potential damage.
+	 * Hits are buffered for the frame, keeping only the strongest per
+	 * (Component, OtherComponent) pair. Tick then compares their energy against
+	 * DamageSpec thresholds in one pass and fires OnImpactDamageBatch.
 	 * 
 	 * @param Component - The component that was hit
 	 * @param OtherComponent - The other component in collision
 	 * @param NormalImpulse - Impact impulse vector (kg·cm/s)
 	 * @param HitResult - Hit details including location, normal, etc.
 	 * 
-	 * @note Automatically called for registered bodies during collision processing
+	 * @note Automatically called for registered bodies with a damage spec (bAutoBindImpactHits)
 	 * @note Can be called manually if you have custom collision handling
+	 * @note Impulses below the body's threshold impulse (at its mass when registered) are dropped
 	 */
 	UFUNCTION(BlueprintCallable, Category = "Physics|Impact")
 	void ProcessCollisionHit(
@@ -275,16 +453,160 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Physics|Config")
 	float EnvironmentQueryRate = 10.0f;
 
-	/** Maximum bodies to update per frame (for throttling) */
+	/** How Tick bounds per-frame body work */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Physics|Config")
+	EPhysicsBodyScheduleMode ScheduleMode = EPhysicsBodyScheduleMode::BodyCount;
+
+	/** Maximum bodies to update per frame (BodyCount mode) */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Physics|Config")
 	int32 MaxBodiesPerFrame = 50;
 
+	/** Per-frame time budget for body updates in microseconds (TimeBudget mode) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Physics|Config", meta = (ClampMin = "1.0"))
+	float BodyTimeBudgetMicroseconds = 500.0f;
+
+	/** Service sleeping, or slow and off-screen, bodies less often */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Physics|Config")
+	bool bPrioritizeActiveBodies = true;
+
+	/** Minimum frames between services of a low-priority body */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Physics|Config", meta = (ClampMin = "1"))
+	int32 LowPriorityServiceInterval = 4;
+
+	/**
+	 * Evaluate drag/buoyancy on the physics thread each (sub)step instead of in Tick.
+	 * Applied at BeginPlay; use SetAsyncPhysicsForcesEnabled to switch at runtime.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Physics|Config")
+	bool bUseAsyncPhysicsForces = false;
+
+	/**
+	 * Enable hit notifies and bind OnComponentHit for bodies registered with a damage spec.
+	 * Applies to bodies registered afterwards.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Physics|Config")
+	bool bAutoBindImpactHits = true;
+
+	/**
+	 * Drop contacts too weak to damage any registered body on the physics thread.
+	 * This sets the solver's collision event filter, which applies to every hit
+	 * notify in the world: other hit consumers also lose contacts below it.
+	 * Re-evaluated when bodies register, unregister or get their spec.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Physics|Config")
+	bool bFilterContactsOnPhysicsThread = true;
+
+	/**
+	 * Fraction of the weakest threshold impulse the solver filter lets through.
+	 * Below 1 leaves slack for mass changes and impulses split across contacts;
+	 * the game thread still checks each hit against its own body's threshold.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Physics|Config", meta = (ClampMin = "0.0", ClampMax = "1.0"))
+	float ContactFilterImpulseScale = 0.5f;
+
+	/** Register or remove the physics-thread force callback */
+	UFUNCTION(BlueprintCallable, Category = "Physics|Config")
+	void SetAsyncPhysicsForcesEnabled(bool bEnabled);
+
+	/** True while forces are evaluated on the physics thread */
+	UFUNCTION(BlueprintCallable, Category = "Physics|Config")
+	bool IsUsingAsyncPhysicsForces() const { return AsyncForceCallback != nullptr; }
+
+	/**
+	 * Distance tiers, nearest first. Empty treats every body alike at EnvironmentQueryRate.
+	 * Without any player view every body uses the first tier.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Physics|Config")
+	TArray<FPhysicsLODTier> LODTiers;
+
+	/** Per-tier work done by the last Tick, parallel to LODTiers */
+	UFUNCTION(BlueprintCallable, Category = "Physics|Config")
+	TArray<FPhysicsLODTierStats> GetLODTierStats() const;
+
+	/** Bodies serviced by the last Tick */
+	UFUNCTION(BlueprintCallable, Category = "Physics|Config")
+	int32 GetBodiesServicedLastFrame() const { return BodiesServicedLastFrame; }
+
+	/** Game-thread cost of the last Tick's gather/compute/apply phases */
+	double GetLastTickSeconds() const { return LastTickSeconds; }
+
 protected:
-	/** Update environment cache for a body */
-	void UpdateBodyEnvironmentCache(UPrimitiveComponent* Component, FBodyPhysicsCache& Cache);
+	/** Inputs and result of one body's force evaluation */
+	struct FBodyForceWork
+	{
+		int32 BodyIndex = INDEX_NONE;
+		FVector Location = FVector::ZeroVector;
+		FVector Velocity = FVector::ZeroVector;
+		float Radius = 0.0f;
+		float Mass = 0.0f;
+		float ElapsedTime = 0.0f;
+		bool bNeedsEnvironment = false;
+		bool bApplyBuoyancy = true;
+
+		/** Output of the compute phase */
+		FVector Impulse = FVector::ZeroVector;
+	};
+
+	/** Pick this frame's bodies round-robin and snapshot their inputs into ForceWork */
+	void GatherScheduledBodies(double CurrentTime, double QueryInterval, float FrameDeltaTime);
+
+	/** Re-query environment for every gathered body whose cache is due, in one batch */
+	void RefreshBodyEnvironments(double CurrentTime);
+
+	/** Snapshot a body's physics state; false if it is not simulating */
+	bool SnapshotBodyForceInput(int32 BodyIndex, float ElapsedTime, FBodyForceWork& OutWork) const;
+
+	/** Pure: drag + buoyancy impulse from a snapshot and context. Safe on any thread. */
+	static void ComputeBodyImpulse(FBodyForceWork& Work, const FEnvironmentContext& Context, float MinDragVelocity);
+
+	/** Apply drag and buoyancy from the body's cached environment (serial path) */
+	void ApplyBodyForces(int32 BodyIndex, float DeltaTime);
+
+	/** Move a body between the active and sleeping ranges; no events */
+	void SetBodySleeping(int32 BodyIndex, bool bSleeping);
+
+	bool IsBodySleeping(int32 BodyIndex) const { return BodyIndex >= NumActiveBodies; }
+
+	/** Chaos sleep event for a registered component */
+	UFUNCTION()
+	void HandleBodySleep(UPrimitiveComponent* SleepingComponent, FName BoneName);
+
+	/** Chaos wake event for a registered component */
+	UFUNCTION()
+	void HandleBodyWake(UPrimitiveComponent* WakingComponent, FName BoneName);
+
+	/** Hit notify of a body with a damage spec */
+	UFUNCTION()
+	void HandleBodyHit(UPrimitiveComponent* HitComponent, AActor* OtherActor, UPrimitiveComponent* OtherComponent, FVector NormalImpulse, const FHitResult& Hit);
+
+	/** Resolve a body's threshold impulse and (un)bind its hits to match its damage spec */
+	void UpdateBodyImpactBinding(int32 BodyIndex);
+
+	/** Undo UpdateBodyImpactBinding before a body is removed */
+	void ReleaseBodyImpactBinding(int32 BodyIndex);
+
+	/** Push the weakest threshold impulse to the solver's collision filter if it changed */
+	void UpdateContactFilter();
+
+	/** Set the solver's collision filter MinImpulse (0 = off) if it differs from the applied one */
+	void ApplyContactFilter(float MinImpulse);
 
-	/** Check and emit settle events for sleeping bodies */
-	void CheckBodySleepState(UPrimitiveComponent* Component, FBodyPhysicsCache& Cache);
+	/** Floating origin moved: re-query every body's environment on its next service */
+	void HandleWorldOriginRebased(const FIntVector& ShiftCm);
+
+	FDelegateHandle OriginRebasedHandle;
+
+	/** Tier for a body given this frame's view locations (INDEX_NONE without tiers) */
+	int32 SelectLODTier(const FVector& Location) const;
+
+	/** Awake and either moving or recently rendered */
+	bool IsHighPriorityBody(int32 BodyIndex) const;
+
+	/** Hand the physics-thread callback this frame's environment snapshot and awake bodies */
+	void PushAsyncForceInput();
+
+	/** Resolve this frame's queued hits and broadcast the damaging ones */
+	void FlushPendingImpacts();
 
 	/** Get damage spec for a component */
 	UDamageSpec* GetDamageSpecForComponent(UPrimitiveComponent* Component) const;
@@ -298,12 +620,109 @@ private:
 	UPROPERTY()
 	TObjectPtr<UEnvironmentSubsystem> EnvironmentSubsystem;
 
-	/** Registered physics bodies and their damage specs */
+	//--- Packed body storage: index i in every Body* array is the same body ---
+
+	/** Registered components (doubles as the scheduling order) */
 	UPROPERTY()
-	TMap<UPrimitiveComponent*, FDamageSpecId> RegisteredBodies;
+	TArray<TObjectPtr<UPrimitiveComponent>> BodyComponents;
+
+	/** Identity of each body, still usable after its component is destroyed */
+	TArray<TObjectKey<UPrimitiveComponent>> BodyKeys;
+
+	TArray<FDamageSpecId> BodyDamageSpecIds;
+
+	/** Impulse (kg·cm/s) that reaches the body's ImpactThresholdMin; 0 = unknown or no spec */
+	TArray<float> BodyMinImpulses;
+
+	/** Registration turned on the body's hit notifies (turned off again on removal) */
+	TArray<bool> BodyHitNotifyEnabled;
+
+	/** Cached environment context and when it was queried */
+	TArray<FEnvironmentContext> BodyEnvironmentContexts;
+	TArray<double> BodyLastQueryTimes;
+
+	/** When the scheduler last serviced each body (time 0 = never) */
+	TArray<double> BodyLastServiceTimes;
+	TArray<int32> BodyLastServiceFrames;
+
+	/** LOD tier each body was last serviced at */
+	TArray<uint8> BodyLODTiers;
+
+	/** Slot owning each body */
+	TArray<int32> BodySlotIndices;
+
+	/** Handle indirection: slot -> body index */
+	struct FBodySlot
+	{
+		int32 BodyIndex = INDEX_NONE;
+		int32 Generation = 0;
+	};
+	TArray<FBodySlot> BodySlots;
+	TArray<int32> FreeBodySlots;
+
+	/** Component -> body index, for the component-based API (not used by Tick) */
+	TMap<TObjectKey<UPrimitiveComponent>, int32> BodyIndexByComponent;
+
+	int32 FindBodyIndex(const UPrimitiveComponent* Component) const;
+
+	/** Swap two bodies across every array, fixing up the slot and component tables */
+	void SwapBodies(int32 IndexA, int32 IndexB);
 
-	/** Cached physics state per body */
-	TMap<UPrimitiveComponent*, FBodyPhysicsCache> BodyCaches;
+	/** Remove a body, keeping the arrays packed and the sweep's cursor fair */
+	void RemoveBodyAt(int32 BodyIndex);
+
+	/** Move an active body to the front of the sleeping range; returns its new index */
+	int32 DeactivateBodyAt(int32 BodyIndex);
+
+	/** Bodies at [0, NumActiveBodies) are awake; the rest are asleep */
+	int32 NumActiveBodies = 0;
+
+	/** Next body index for the round-robin sweep (within the active range) */
+	int32 ScheduleCursor = 0;
+
+	/** Sleeping body checked for destruction this frame; they are never swept */
+	int32 SleepingPruneCursor = 0;
+
+	/** Per-frame scratch, reused across ticks */
+	TArray<FBodyForceWork> ForceWork;
+
+	/** Bodies the gather found destroyed, removed once ForceWork is applied */
+	TArray<int32> DeadBodyIndices;
+
+	/** Smoothed per-body cost, for sizing TimeBudget frames before the parallel phase */
+	double AverageBodyCostSeconds = 2e-6;
+
+	int32 BodiesServicedLastFrame = 0;
+
+	double LastTickSeconds = 0.0;
+
+	/** Player view locations gathered at the start of Tick */
+	TArray<FVector, TInlineAllocator<4>> ViewLocations;
+
+	/** Per-tier counts for the current frame */
+	TArray<FPhysicsLODTierStats> LODTierFrameStats;
+
+	/** A hit waiting for FlushPendingImpacts */
+	struct FPendingImpact
+	{
+		FPhysicsBodyHandle Body;
+		TWeakObjectPtr<UPrimitiveComponent> OtherComponent;
+		float NormalImpulse = 0.0f;
+		FHitResult Hit;
+	};
+
+	/** Frame-local hit buffer, and its index by (body, other component) */
+	TArray<FPendingImpact> PendingImpacts;
+	TMap<TPair<FPhysicsBodyHandle, TObjectKey<UPrimitiveComponent>>, int32> PendingImpactByPair;
+
+	/** Scratch for the batch broadcast, reused across frames */
+	TArray<FImpactDamageEvent> ImpactBatch;
+
+	/** Bodies' threshold impulses changed since the solver filter was set */
+	bool bContactFilterDirty = false;
+
+	/** MinImpulse last given to the solver's collision filter (0 = filter off) */
+	float AppliedContactFilterImpulse = 0.0f;
 
 	/** Registered damage specs */
 	UPROPERTY()
@@ -311,4 +730,9 @@ private:
 
 	/** Current frame counter for update distribution */
 	int32 CurrentFrame = 0;
+
+	/** Physics-thread force callback, owned by the solver while registered */
+	FEnvironmentForceSimCallback* AsyncForceCallback = nullptr;
+
+	friend class FEnvironmentForceSimCallback;
 };
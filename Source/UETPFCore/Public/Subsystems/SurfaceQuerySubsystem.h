@@ -6,11 +6,43 @@
 
 #include "CoreMinimal.h"
 #include "Subsystems/WorldSubsystem.h"
+#include "UObject/ObjectKey.h"
+#include "UObject/WeakInterfacePtr.h"
 #include "SpecTypes.h"
+#include "SpecRegistry.h"
+#include "DeltaTypes.h"
 #include "SurfaceQuerySubsystem.generated.h"
 
 class UPhysicalMaterial;
 class USurfaceSpec;
+struct FTraceHandle;
+struct FTraceDatum;
+
+/**
+ * Everything the modifier pass needs from a USurfaceSpec, baked once at registration.
+ * POD - no UObject access, so states can be evaluated on worker threads.
+ */
+struct UETPFCORE_API FSurfaceResponseKernel
+{
+	FSurfaceSpecId SpecId;
+	FFXProfileId FXProfileId;
+	float FrictionStatic = 0.8f;
+	float FrictionDynamic = 0.6f;
+	float Restitution = 0.2f;
+	float Compliance = 0.0f;
+	float DeformationStrength = 0.0f;
+
+	/** X = wetness (0-1) */
+	FSurfaceCurveLUT WetnessLUT;
+
+	/** X = temperature (Kelvin), range taken from the curve's keys */
+	FSurfaceCurveLUT TemperatureLUT;
+
+	static FSurfaceResponseKernel Bake(const USurfaceSpec& Spec);
+};
+
+/** Fired on the game thread when an async batch query completes (same order as input) */
+DECLARE_DELEGATE_OneParam(FOnSurfaceStatesReady, const TArray<FSurfaceState>& /*States*/);
 
 /**
  * World subsystem that provides surface state queries.
@@ -20,6 +52,22 @@ class USurfaceSpec;
  *   - Call GetSurfaceStateFromHit() with a hit result to get the full surface state
  *   - Surface state includes friction, deformation, wetness, snow depth, FX profile
  *   - Consumers: vehicles (tire forces), characters (footsteps), cloth, FX routing
+ *   - Many points per frame: BatchGetSurfaceStatesAsync() keeps traces off the game thread
+ * 
+ * State Cache:
+ *   GetSurfaceStateFromHit() caches built states per (physical material, cell, tile).
+ *   The cache is 4-way set associative with a fixed entry count; a tile's set is
+ *   cleared when IDeltaStore::OnSurfaceDeltasChanged fires for it, and entries
+ *   expire after SurfaceCacheLifetimeSeconds so non-delta inputs (temperature,
+ *   weather) are still picked up.
+ * 
+ * Delta Sampling:
+ *   With a delta store bound (SetDeltaStore), the Get*AtLocation queries sample a
+ *   FSurfaceChannelGrid per cell: built from the cell's surface deltas on first
+ *   query, updated in place as deltas are appended, dropped when the cell reloads
+ *   or is cleared. Up to MaxResidentSurfaceGrids grids are kept.
+ *   Cells are keyed by absolute position (world + UWorld::OriginLocation), so
+ *   deltas and cached states stay put across floating-origin rebases.
  */
 UCLASS()
 class UETPFCORE_API USurfaceQuerySubsystem : public UWorldSubsystem
@@ -70,6 +118,52 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Surface|Query")
 	TArray<FSurfaceState> BatchGetSurfaceStates(const TArray<FVector>& WorldLocations, float TraceDistance = 500.0f) const;
 
+	/**
+	 * Batch query without blocking on traces.
+	 * Traces are queued with AsyncLineTraceByChannel and run in the engine's
+	 * async trace pass alongside the physics scene; states are built once every
+	 * trace of the batch has returned (normally next frame).
+	 * 
+	 * @param WorldLocations - Locations to query
+	 * @param TraceDistance - How far to trace downward
+	 * @param OnComplete - Receives the states, same order as input
+	 * @return Batch id, or 0 if nothing was queued (OnComplete is not called)
+	 * 
+	 * @note Pending batches are dropped when the subsystem deinitializes
+	 */
+	uint32 BatchGetSurfaceStatesAsync(const TArray<FVector>& WorldLocations, float TraceDistance, FOnSurfaceStatesReady OnComplete);
+
+	/** Number of async batches still waiting on traces */
+	int32 GetPendingBatchCount() const { return PendingBatches.Num(); }
+
+	//==========================================================================
+	// STATE CACHE
+	//==========================================================================
+
+	/** Drop every cached surface state */
+	UFUNCTION(BlueprintCallable, Category = "Surface|Cache")
+	void InvalidateSurfaceCache();
+
+	/** Drop cached states resolved to any of these spec IDs */
+	void InvalidateSurfaceCacheForSpecs(const TSet<FName>& SpecIds);
+
+	/** Drop cached states for one tile (INDEX_NONE = the whole cell) */
+	void InvalidateSurfaceCacheTile(const FWorldCellKey& CellKey, int32 TileIndex);
+
+	/** Cache hits since Initialize */
+	int64 GetSurfaceCacheHits() const { return SurfaceCacheHits; }
+
+	/** Cache misses since Initialize */
+	int64 GetSurfaceCacheMisses() const { return SurfaceCacheMisses; }
+
+	/** Cache GetSurfaceStateFromHit() results */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Surface|Cache")
+	bool bEnableSurfaceCache = true;
+
+	/** Seconds a cached state stays valid when no delta invalidates it (0 = until invalidated) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Surface|Cache", meta = (ClampMin = "0"))
+	float SurfaceCacheLifetimeSeconds = 0.5f;
+
 	//==========================================================================
 	// SPEC REGISTRATION
 	//==========================================================================
@@ -105,6 +199,20 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Surface|Registration")
 	USurfaceSpec* GetDefaultSurfaceSpec() const { return DefaultSurfaceSpec; }
 
+	/**
+	 * Find a registered SurfaceSpec asset by its SpecId.
+	 * Covers every spec passed to RegisterSurfaceSpec / SetDefaultSurfaceSpec.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Surface|Registration")
+	USurfaceSpec* FindSurfaceSpecById(const FSurfaceSpecId& Id) const;
+
+	/**
+	 * Re-bake a spec's response LUTs after its curves changed at runtime.
+	 * Registration bakes automatically; this is only needed for live edits.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Surface|Registration")
+	void RebakeSurfaceSpec(USurfaceSpec* Spec);
+
 	//==========================================================================
 	// RUNTIME SPEC REGISTRATION (SpecPack / JSON)
 	//==========================================================================
@@ -115,13 +223,15 @@ public:
 	 * 
 	 * @param Id - Unique spec identifier
 	 * @param Spec - The struct spec data
+	 * @return Handle for hot-path lookups (stable if the ID is registered again)
 	 */
 	UFUNCTION(BlueprintCallable, Category = "Surface|Registration")
-	void RegisterRuntimeSurfaceSpec(const FSurfaceSpecId& Id, const FRuntimeSurfaceSpec& Spec);
+	FSpecHandle RegisterRuntimeSurfaceSpec(const FSurfaceSpecId& Id, const FRuntimeSurfaceSpec& Spec);
 
 	/**
 	 * Resolve a surface spec by ID.
-	 * Resolution order: Runtime registry → DataAsset fallback → Default
+	 * Resolution order: Runtime registry → DataAsset (converted at registration) → Default
+	 * Copies the spec - C++ callers should prefer ResolveSurfaceSpecRef / GetRuntimeSurfaceSpec.
 	 * 
 	 * @param Id - Spec ID to resolve
 	 * @param OutSpec - Output spec data
@@ -131,7 +241,22 @@ public:
 	bool ResolveSurfaceSpec(const FSurfaceSpecId& Id, FRuntimeSurfaceSpec& OutSpec) const;
 
 	/**
-	 * Check if a runtime spec is registered.
+	 * Resolve a surface spec by ID without copying.
+	 * Valid until the next registration or ClearRuntimeSpecs().
+	 * 
+	 * @param bOutFound - Optional, false if the fallback spec was returned
+	 */
+	const FRuntimeSurfaceSpec& ResolveSurfaceSpecRef(const FSurfaceSpecId& Id, bool* bOutFound = nullptr) const;
+
+	/** Handle for a registered runtime spec (invalid if not registered) */
+	UFUNCTION(BlueprintCallable, Category = "Surface|Query")
+	FSpecHandle GetSurfaceSpecHandle(const FSurfaceSpecId& Id) const;
+
+	/** Spec for a handle; the fallback spec if the handle is invalid or stale */
+	const FRuntimeSurfaceSpec& GetRuntimeSurfaceSpec(FSpecHandle Handle) const;
+
+	/**
+	 * Check if a runtime spec is registered (asset-authored specs don't count).
 	 */
 	UFUNCTION(BlueprintCallable, Category = "Surface|Query")
 	bool HasRuntimeSpec(const FSurfaceSpecId& Id) const;
@@ -144,10 +269,22 @@ public:
 
 	/**
 	 * Clear all runtime specs (for hot-reload / testing).
+	 * Registered DataAsset specs are re-interned, so they keep resolving.
 	 */
 	UFUNCTION(BlueprintCallable, Category = "Surface|Registration")
 	void ClearRuntimeSpecs();
 
+	/**
+	 * Register only the specs that differ from what is registered (hot reload).
+	 * A spec differs when it is new or its Version or any field changed. Changed
+	 * entries are overwritten in place, so handles stay valid, and only cached
+	 * surface states built from a changed spec are dropped.
+	 * 
+	 * @param Specs - Specs keyed by their SpecId
+	 * @return Number of specs registered
+	 */
+	int32 UpdateRuntimeSurfaceSpecs(TConstArrayView<FRuntimeSurfaceSpec> Specs);
+
 	/**
 	 * Get the hardcoded fallback spec (never fails).
 	 */
@@ -158,28 +295,57 @@ public:
 	//==========================================================================
 
 	/**
-	 * Get current wetness at a world location (from delta tiles).
-	 * Override this in derived classes to integrate with your delta storage.
+	 * Bind the store the Get*AtLocation queries read from (null to unbind).
+	 * Not owned - the store's owner must unbind before releasing it.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Surface|Delta")
+	void SetDeltaStore(TScriptInterface<IDeltaStore> InDeltaStore);
+
+	/** Bound store object (null when unbound) */
+	UObject* GetDeltaStoreObject() const { return DeltaStore.GetObject(); }
+
+	/** Bound store (null when unbound); compare against OnSurfaceDeltasChanged's Store */
+	const IDeltaStore* GetDeltaStore() const { return DeltaStore.Get(); }
+
+	/**
+	 * Channel grid for a cell, built from the bound store on first use.
+	 * Null without a store. Valid until the next delta change or query on another cell.
+	 */
+	const FSurfaceChannelGrid* GetSurfaceGrid(const FWorldCellKey& CellKey) const { return FindOrBuildSurfaceGrid(CellKey); }
+
+	/** Number of cells with a resident channel grid */
+	int32 GetResidentSurfaceGridCount() const { return SurfaceGrids.Num(); }
+
+	/** Grids kept resident before the least recently sampled is evicted */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Surface|Delta", meta = (ClampMin = "1"))
+	int32 MaxResidentSurfaceGrids = 64;
+
+	/**
+	 * Get current wetness at a world location (from delta tiles and rain).
+	 * Bilinear sample of the bound delta store's channel grid (0 when no store is bound)
+	 * plus UWeatherFieldSubsystem ground wetness, clamped to 0-1.
 	 */
 	UFUNCTION(BlueprintCallable, Category = "Surface|Delta")
 	virtual float GetWetnessAtLocation(const FVector& WorldLocation) const;
 
 	/**
 	 * Get current snow depth at a world location (from delta tiles).
-	 * Override this in derived classes to integrate with your delta storage.
+	 * Bilinear sample of the bound delta store's channel grid; 0 when no store is bound.
 	 */
 	UFUNCTION(BlueprintCallable, Category = "Surface|Delta")
 	virtual float GetSnowDepthAtLocation(const FVector& WorldLocation) const;
 
 	/**
 	 * Get current compaction at a world location (from delta tiles).
-	 * Override this in derived classes to integrate with your delta storage.
+	 * Bilinear sample of the bound delta store's channel grid; 0 when no store is bound.
 	 */
 	UFUNCTION(BlueprintCallable, Category = "Surface|Delta")
 	virtual float GetCompactionAtLocation(const FVector& WorldLocation) const;
 
 	/**
 	 * Get current temperature at a world location.
+	 * USurfaceThermalSubsystem's live field where it simulates the cell; elsewhere
+	 * Earth standard (288K) plus the TemperatureDelta channel of the bound delta store.
 	 * Override this to integrate with environment/weather systems.
 	 */
 	UFUNCTION(BlueprintCallable, Category = "Surface|Delta")
@@ -189,8 +355,21 @@ protected:
 	/** Build a complete SurfaceState from a spec and environmental conditions */
 	FSurfaceState BuildSurfaceState(const USurfaceSpec* Spec, const FVector& Location) const;
 
-	/** Apply environmental modifiers (wetness, temperature) to base friction values */
-	void ApplyEnvironmentalModifiers(FSurfaceState& State, const USurfaceSpec* Spec) const;
+	/** Spec base values + environment samples, before modifiers */
+	FSurfaceState GatherSurfaceState(const FSurfaceResponseKernel& Kernel, const FVector& Location) const;
+
+	/** Apply environmental modifiers (wetness, temperature, snow, compaction) to base friction values */
+	static void ApplyEnvironmentalModifiers(FSurfaceState& State, const FSurfaceResponseKernel& Kernel);
+
+	/** Baked kernel for a spec, baking on first use (game thread) */
+	const FSurfaceResponseKernel* FindOrBakeKernel(const USurfaceSpec* Spec) const;
+
+	/**
+	 * Build states for a set of hits.
+	 * Spec lookup and environment sampling run on the calling thread (the Get*AtLocation
+	 * overrides may touch game state); the modifier pass is data-parallel for large batches.
+	 */
+	void BuildSurfaceStates(TConstArrayView<FHitResult> Hits, TArray<FSurfaceState>& OutStates) const;
 
 private:
 	/** Map from PhysicalMaterial to SurfaceSpec (DataAsset workflow) */
@@ -204,9 +383,76 @@ private:
 	/** Cached trace channel for surface queries */
 	ECollisionChannel SurfaceTraceChannel;
 
-	/** Runtime spec registry (SpecPack / JSON workflow) */
-	TMap<FName, FRuntimeSurfaceSpec> RuntimeSurfaceSpecs;
+	/** Reverse index: SpecId -> SurfaceSpec asset (DataAsset workflow) */
+	UPROPERTY()
+	TMap<FName, TObjectPtr<USurfaceSpec>> SurfaceSpecsById;
+
+	/**
+	 * Resolved specs by ID, from both sources: runtime specs (SpecPack / JSON) and
+	 * DataAssets converted once with ToStruct. Runtime specs take precedence.
+	 */
+	TSpecRegistry<FRuntimeSurfaceSpec> RuntimeSurfaceSpecs;
+
+	/** IDs registered through RegisterRuntimeSurfaceSpec */
+	TSet<FName> RuntimeAuthoredSurfaceIds;
+
+	/** Add an asset to the reverse index and intern its converted struct */
+	void IndexSurfaceSpecAsset(USurfaceSpec* Spec);
+
+	/** Baked response kernels per registered spec */
+	mutable TMap<TObjectKey<USurfaceSpec>, FSurfaceResponseKernel> SpecKernels;
 
 	/** Hardcoded fallback spec */
 	static FRuntimeSurfaceSpec FallbackSurfaceSpec;
+
+	/** Async batch awaiting trace results */
+	struct FPendingSurfaceBatch
+	{
+		TArray<FHitResult> Hits;
+		int32 RemainingTraces = 0;
+		FOnSurfaceStatesReady OnComplete;
+	};
+
+	void HandleAsyncSurfaceTrace(const FTraceHandle& Handle, FTraceDatum& Datum, uint32 BatchId);
+
+	/** One cached state; CellKey + TileIndex + PhysMat form the tag */
+	struct FSurfaceCacheEntry
+	{
+		TObjectKey<UPhysicalMaterial> PhysMat;
+		FWorldCellKey CellKey;
+		int32 TileIndex = INDEX_NONE;
+		double CachedTime = 0.0;
+		FSurfaceState State;
+	};
+
+	static constexpr int32 SurfaceCacheSetCount = 256;
+	static constexpr int32 SurfaceCacheWays = 4;
+
+	/** First entry of the set a tile maps to */
+	static int32 GetSurfaceCacheSet(const FWorldCellKey& CellKey, int32 TileIndex);
+
+	void HandleSurfaceDeltasChanged(const IDeltaStore* Store, const FWorldCellKey& CellKey, int32 TileIndex, const FSurfaceTileDelta* AppendedDelta);
+
+	/** Sample one channel from the bound store; 0 without a store */
+	float SampleSurfaceChannel(const FVector& WorldLocation, ESurfaceDeltaChannel Channel) const;
+
+	/** World location plus the world origin offset */
+	FVector ToAbsoluteLocation(const FVector& WorldLocation) const;
+
+	/** Resident grid for a cell, built from the store on first use */
+	const FSurfaceChannelGrid* FindOrBuildSurfaceGrid(const FWorldCellKey& CellKey) const;
+
+	TWeakInterfacePtr<IDeltaStore> DeltaStore;
+
+	/** Channel grids per cell (lazily built, see FindOrBuildSurfaceGrid) */
+	mutable TMap<FWorldCellKey, FSurfaceChannelGrid> SurfaceGrids;
+
+	/** SurfaceCacheSetCount * SurfaceCacheWays entries, allocated at Initialize */
+	mutable TArray<FSurfaceCacheEntry> SurfaceCache;
+	mutable int64 SurfaceCacheHits = 0;
+	mutable int64 SurfaceCacheMisses = 0;
+	FDelegateHandle SurfaceDeltasChangedHandle;
+
+	TMap<uint32, FPendingSurfaceBatch> PendingBatches;
+	uint32 NextBatchId = 1;
 };
@@ -0,0 +1,187 @@
+// Copyright 2026 Threaded Pixel Factory
+// Licensed under the Apache License, Version 2.0 (the "License");
+// SPDX-License-Identifier: Apache-2.0
+
+/**
+ * Surface Texture Subsystem - GPU atlas of surface delta channels
+ *
+ * Purpose:
+ * Gives landscape and foliage materials snow depth, compaction, wetness and
+ * temperature without per-tile CPU queries. The cells around the view are kept
+ * resident in one RGBA16F texture, one texel per FSurfaceTileDelta tile:
+ * - R = SnowDepth (cm)
+ * - G = SnowCompaction (0-1)
+ * - B = Wetness (0-1)
+ * - A = TemperatureDelta (K); the live USurfaceThermalSubsystem field where simulated
+ *
+ * Layout:
+ * The atlas is a toroidal window of AtlasCellsPerAxis^2 cells. Cell (X, Y) always
+ * lives in slot (X mod N, Y mod N), so materials need no indirection table:
+ *   UV = frac((WorldPosition.xy + Mapping.xy) * Mapping.z)
+ * and the texture's wrap addressing makes bilinear filtering blend across cell
+ * borders into the neighbouring (resident) cell. Samples outside the window
+ * (SurfaceAtlasWindow, world space min/max XY) should be treated as 0.
+ *
+ * Updates:
+ * Values come from USurfaceQuerySubsystem's FSurfaceChannelGrid, so gameplay
+ * queries and materials read the same data.
+ * - A cell entering the window uploads its whole slot
+ * - IDeltaStore::OnSurfaceDeltasChanged marks the touched tile dirty; each tick
+ *   uploads the dirty rectangle of up to MaxSlotUploadsPerTick slots
+ * - Slots of thermally simulated cells re-upload every ThermalRefreshSeconds
+ * - Origin rebases only change the mapping parameters
+ *
+ * Material Parameters (SurfaceParameterCollection, or ApplyToMaterial):
+ * - SurfaceAtlasMapping: (OriginLocation.X, OriginLocation.Y, 1 / atlas size cm, CellSize)
+ * - SurfaceAtlasWindow: (MinX, MinY, MaxX, MaxY) of the resident cells, world space
+ * - SurfaceAtlas: the texture (ApplyToMaterial only; collections hold no textures)
+ *
+ * @see USurfaceQuerySubsystem for the CPU queries over the same grids
+ * @see FSurfaceChannelGrid for the source values
+ */
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "DeltaTypes.h"
+#include "SurfaceTextureSubsystem.generated.h"
+
+class UTexture2D;
+class UMaterialInstanceDynamic;
+class UMaterialParameterCollection;
+
+/**
+ * World subsystem streaming surface delta channels into a GPU texture atlas.
+ */
+UCLASS(Config = Game)
+class UETPFCORE_API USurfaceTextureSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	//--- UWorldSubsystem Interface ---
+	virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+
+	//--- UTickableWorldSubsystem Interface ---
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override { RETURN_QUICK_DECLARE_CYCLE_STAT(USurfaceTextureSubsystem, STATGROUP_Tickables); }
+
+	/** The atlas texture */
+	UFUNCTION(BlueprintPure, Category = "Surface|Texture")
+	UTexture2D* GetSurfaceAtlas() const { return AtlasTexture; }
+
+	/** SurfaceAtlasMapping parameter value (see class comment) */
+	UFUNCTION(BlueprintPure, Category = "Surface|Texture")
+	FLinearColor GetAtlasMapping() const;
+
+	/** SurfaceAtlasWindow parameter value (see class comment) */
+	UFUNCTION(BlueprintPure, Category = "Surface|Texture")
+	FLinearColor GetAtlasWindow() const;
+
+	/** Set the atlas texture and mapping parameters on a material instance */
+	UFUNCTION(BlueprintCallable, Category = "Surface|Texture")
+	void ApplyToMaterial(UMaterialInstanceDynamic* Material) const;
+
+	/** Re-upload every resident cell on the next ticks */
+	UFUNCTION(BlueprintCallable, Category = "Surface|Texture")
+	void InvalidateAtlas();
+
+	//==========================================================================
+	// CONFIGURATION
+	//==========================================================================
+
+	/** Delta grid cell size (cm); must match the size deltas are keyed with */
+	UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Surface|Texture", meta = (ClampMin = "100"))
+	float DeltaCellSize = 6400.0f;
+
+	/** Atlas slots per axis; the texture is AtlasCellsPerAxis * 64 texels square */
+	UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Surface|Texture", meta = (ClampMin = "1", ClampMax = "32"))
+	int32 AtlasCellsPerAxis = 8;
+
+	/** Cells around the view kept resident (square radius, clamped to fit the atlas) */
+	UPROPERTY(Config, EditAnywhere, BlueprintReadWrite, Category = "Surface|Texture", meta = (ClampMin = "0"))
+	int32 ResidentRadiusCells = 3;
+
+	/** Slots uploaded per tick; the rest stay dirty for the next tick */
+	UPROPERTY(Config, EditAnywhere, BlueprintReadWrite, Category = "Surface|Texture", meta = (ClampMin = "1"))
+	int32 MaxSlotUploadsPerTick = 8;
+
+	/** Seconds between atlas refreshes of the cells USurfaceThermalSubsystem simulates */
+	UPROPERTY(Config, EditAnywhere, BlueprintReadWrite, Category = "Surface|Texture", meta = (ClampMin = "0"))
+	float ThermalRefreshSeconds = 0.5f;
+
+	/** Optional collection receiving SurfaceAtlasMapping and SurfaceAtlasWindow */
+	UPROPERTY(Config, EditAnywhere, BlueprintReadWrite, Category = "Surface|Texture")
+	TSoftObjectPtr<UMaterialParameterCollection> SurfaceParameterCollection;
+
+private:
+	/** One cell's place in the atlas */
+	struct FAtlasSlot
+	{
+		FWorldCellKey CellKey;
+		bool bOccupied = false;
+
+		/** Dirty tiles, max exclusive; empty when the slot is current */
+		FIntRect DirtyTiles;
+
+		void MarkDirty(int32 TileX, int32 TileY)
+		{
+			const FIntRect Tile(TileX, TileY, TileX + 1, TileY + 1);
+			if (DirtyTiles.IsEmpty())
+			{
+				DirtyTiles = Tile;
+			}
+			else
+			{
+				DirtyTiles.Union(Tile);
+			}
+		}
+
+		void MarkAllDirty()
+		{
+			DirtyTiles = FIntRect(0, 0, FSurfaceTileDelta::TilesPerCellAxis, FSurfaceTileDelta::TilesPerCellAxis);
+		}
+	};
+
+	void HandleSurfaceDeltasChanged(const IDeltaStore* Store, const FWorldCellKey& CellKey, int32 TileIndex, const FSurfaceTileDelta* AppendedDelta);
+
+	void CreateAtlas();
+
+	/** Move the window to the view; cells entering it take over their slots */
+	void UpdateWindow();
+
+	/** Copy a slot's dirty tiles into the atlas and clear them */
+	void UploadSlot(FAtlasSlot& Slot, int32 SlotIndex);
+
+	void UpdateParameterCollection();
+
+	int32 GetSlotIndex(const FWorldCellKey& CellKey) const;
+	int32 GetEffectiveRadius() const { return FMath::Min(ResidentRadiusCells, (AtlasCellsPerAxis - 1) / 2); }
+
+	UPROPERTY(Transient)
+	TObjectPtr<UTexture2D> AtlasTexture;
+
+	TArray<FAtlasSlot> Slots;
+
+	/** Round-robin start for uploads, so busy slots can't starve the rest */
+	int32 NextUploadSlot = 0;
+
+	/** Time since simulated cells were last marked dirty */
+	float ThermalRefreshElapsed = 0.0f;
+
+	/** Store the atlas was filled from; a rebind re-uploads everything */
+	TWeakObjectPtr<UObject> SourceStore;
+
+	/** Window center, valid once the first view was found */
+	FWorldCellKey WindowCenter;
+	bool bHasWindow = false;
+
+	/** Last values written to the parameter collection */
+	FLinearColor PublishedMapping = FLinearColor::Transparent;
+	FLinearColor PublishedWindow = FLinearColor::Transparent;
+
+	FDelegateHandle SurfaceDeltasChangedHandle;
+};
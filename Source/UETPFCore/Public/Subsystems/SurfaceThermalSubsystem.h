@@ -0,0 +1,235 @@
+// Copyright 2026 Threaded Pixel Factory
+// Licensed under the Apache License, Version 2.0 (the "License");
+// SPDX-License-Identifier: Apache-2.0
+
+/**
+ * Surface Thermal Subsystem - Ground temperature simulation over delta cells
+ *
+ * Purpose:
+ * Turns the TemperatureDelta surface channel into a live field: heat spreads
+ * between tiles and the ground cools (or warms) back towards ambient, so fire,
+ * sun and snowmelt gameplay read one consistent temperature.
+ *
+ * Model (per 64x64 tile cell, deviation from AmbientTemperatureK):
+ * - Diffusion: dT/dt = alpha * laplacian(T), alpha = k / (rho * c)
+ * - Cooling:   dT/dt = -(h * (T - Ta) + eps * sigma * (T^4 - Ta^4)) / (rho * c * d)
+ *   integrated implicitly, so hot spots never overshoot ambient
+ * k, c and eps come from the FRuntimeSurfaceSpec of each tile's biome (sampled at
+ * MaterialSampleResolution); rho and the layer depth d are shared settings.
+ * Neighbouring simulated cells exchange a one-tile border each step.
+ *
+ * Deltas:
+ * - A cell is seeded from its TemperatureDelta tiles when it starts simulating
+ * - Newly appended TemperatureDelta deltas apply to the live field (heat injection)
+ * - Reloads and replication snapshots do not reset the live field
+ * - A cell leaving the simulation writes its decayed field back to the bound store
+ *   as TemperatureDelta Set deltas (tiles off by more than WritebackThresholdK),
+ *   so it reseeds cooled rather than from the heat originally recorded
+ * USurfaceTextureSubsystem reads the live field for the atlas alpha of simulated cells.
+ *
+ * Scheduling:
+ * Cells within ActiveRadiusCells of the view step every tick; cells out to
+ * SimulationRadiusCells step every DistantStepIntervalSeconds with a longer
+ * timestep. Steps run on worker threads, one cell per task, until
+ * TimeBudgetMs is spent; cells that miss a tick catch up on the next.
+ * Time follows UTimeSubsystem sim time (pause and time scale) times ThermalTimeScale.
+ *
+ * @see USurfaceQuerySubsystem::GetTemperatureAtLocation for the query path
+ * @see FRuntimeSurfaceSpec for the thermal properties
+ */
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "DeltaTypes.h"
+#include "SurfaceThermalSubsystem.generated.h"
+
+/**
+ * Live temperature of one cell. SoA planes; the temperature planes carry a
+ * one-tile halo so the stencil needs no edge cases.
+ */
+struct UETPFCORE_API FSurfaceThermalCell
+{
+	static constexpr int32 TilesPerAxis = FSurfaceTileDelta::TilesPerCellAxis;
+	static constexpr int32 PaddedAxis = TilesPerAxis + 2;
+	static constexpr int32 TilesPerPlane = TilesPerAxis * TilesPerAxis;
+
+	/** Deviation from ambient (K), PaddedAxis^2 */
+	TArray<float> Temperature;
+	TArray<float> Scratch;
+
+	/** Per tile (TilesPerPlane): alpha / tile size^2 (1/s) */
+	TArray<float> Diffusivity;
+
+	/** Per tile: h / (rho * c * d) (1/s) */
+	TArray<float> LinearCooling;
+
+	/** Per tile: eps * sigma / (rho * c * d) (1/(s*K^3)) */
+	TArray<float> RadiativeCooling;
+
+	/** Largest Diffusivity, bounds the stable step */
+	float MaxDiffusivity = 0.0f;
+
+	/** Sim time the cell has been advanced to */
+	double SimulatedTime = 0.0;
+
+	/** Within ActiveRadiusCells of the view */
+	bool bActive = false;
+
+	/** Allocate the planes: ambient everywhere, no conduction or cooling until filled */
+	void Init();
+
+	/** Advance by DeltaSeconds (one stable step; see GetStableStep) */
+	void Step(float DeltaSeconds, float AmbientK);
+
+	/** Longest step the explicit diffusion stays stable for */
+	float GetStableStep() const;
+
+	float GetTile(int32 TileIndex) const;
+	void SetTile(int32 TileIndex, float DeviationK);
+
+	/** Copy an edge row/column of this cell into a neighbour's halo */
+	void CopyEdgeToHalo(FSurfaceThermalCell& Neighbour, int32 DirX, int32 DirY) const;
+
+	/** Halo where there is no neighbour: mirror the edge (no flux) */
+	void MirrorHalo(int32 DirX, int32 DirY);
+
+	/** Halo corners from the adjacent halo edges (read by Sample only) */
+	void FillHaloCorners();
+
+	/** Bilinear sample between tile centers, reading the halo at the border */
+	float Sample(const FVector& AbsoluteLocation, const FWorldCellKey& CellKey, float CellSize) const;
+
+private:
+	static int32 PaddedIndex(int32 TileX, int32 TileY) { return (TileY + 1) * PaddedAxis + TileX + 1; }
+};
+
+/**
+ * World subsystem stepping the ground temperature of the cells around the view.
+ */
+UCLASS(Config = Game)
+class UETPFCORE_API USurfaceThermalSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	//--- UWorldSubsystem Interface ---
+	virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+
+	//--- UTickableWorldSubsystem Interface ---
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override { RETURN_QUICK_DECLARE_CYCLE_STAT(USurfaceThermalSubsystem, STATGROUP_Tickables); }
+
+	/**
+	 * Simulated deviation from ambient at an absolute location (world + origin).
+	 * @return false if the cell is not simulated
+	 */
+	bool SampleTemperatureDeviation(const FVector& AbsoluteLocation, float& OutDeviationK) const;
+
+	/** Ground temperature (K); ambient where no cell is simulated */
+	UFUNCTION(BlueprintPure, Category = "Surface|Thermal")
+	float GetSimulatedTemperatureAtLocation(const FVector& WorldLocation) const;
+
+	/** Cells currently simulated */
+	UFUNCTION(BlueprintPure, Category = "Surface|Thermal")
+	int32 GetSimulatedCellCount() const { return Cells.Num(); }
+
+	/** Live field of a simulated cell, null if not simulated. Valid until the next tick. */
+	const FSurfaceThermalCell* FindCell(const FWorldCellKey& CellKey) const { return Cells.Find(CellKey); }
+
+	/** Drop all live state; cells reseed from their deltas */
+	UFUNCTION(BlueprintCallable, Category = "Surface|Thermal")
+	void ResetSimulation();
+
+	//==========================================================================
+	// CONFIGURATION
+	//==========================================================================
+
+	/** Delta grid cell size (cm); must match the size deltas are keyed with */
+	UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Surface|Thermal", meta = (ClampMin = "100"))
+	float DeltaCellSize = 6400.0f;
+
+	/** Temperature the ground relaxes to (K) */
+	UPROPERTY(Config, EditAnywhere, BlueprintReadWrite, Category = "Surface|Thermal", meta = (ClampMin = "1"))
+	float AmbientTemperatureK = 288.0f;
+
+	/** Cells around the view stepped every tick (square radius) */
+	UPROPERTY(Config, EditAnywhere, BlueprintReadWrite, Category = "Surface|Thermal", meta = (ClampMin = "0"))
+	int32 ActiveRadiusCells = 1;
+
+	/** Cells around the view simulated at all (square radius); further cells are dropped */
+	UPROPERTY(Config, EditAnywhere, BlueprintReadWrite, Category = "Surface|Thermal", meta = (ClampMin = "0"))
+	int32 SimulationRadiusCells = 4;
+
+	/** Sim seconds between steps of cells outside ActiveRadiusCells */
+	UPROPERTY(Config, EditAnywhere, BlueprintReadWrite, Category = "Surface|Thermal", meta = (ClampMin = "0"))
+	float DistantStepIntervalSeconds = 2.0f;
+
+	/** Game-thread time per tick for seeding and stepping (ms); at least one cell always runs */
+	UPROPERTY(Config, EditAnywhere, BlueprintReadWrite, Category = "Surface|Thermal", meta = (ClampMin = "0"))
+	float TimeBudgetMs = 1.0f;
+
+	/** Stable substeps per cell update; longer gaps are dropped rather than integrated */
+	UPROPERTY(Config, EditAnywhere, BlueprintReadWrite, Category = "Surface|Thermal", meta = (ClampMin = "1"))
+	int32 MaxSubsteps = 8;
+
+	/**
+	 * Thermal seconds per sim second. Ground heat moves over hours; the default
+	 * compresses that so burns and melt read within minutes.
+	 */
+	UPROPERTY(Config, EditAnywhere, BlueprintReadWrite, Category = "Surface|Thermal", meta = (ClampMin = "0"))
+	float ThermalTimeScale = 60.0f;
+
+	/** Density of the simulated surface layer (kg/m^3) */
+	UPROPERTY(Config, EditAnywhere, BlueprintReadWrite, Category = "Surface|Thermal", meta = (ClampMin = "1"))
+	float LayerDensityKgM3 = 1800.0f;
+
+	/** Depth of the simulated surface layer (cm) */
+	UPROPERTY(Config, EditAnywhere, BlueprintReadWrite, Category = "Surface|Thermal", meta = (ClampMin = "0.1"))
+	float LayerDepthCm = 10.0f;
+
+	/** Convective exchange with the air (W/(m^2*K)) */
+	UPROPERTY(Config, EditAnywhere, BlueprintReadWrite, Category = "Surface|Thermal", meta = (ClampMin = "0"))
+	float ConvectiveCoefficientWm2K = 10.0f;
+
+	/** Biome samples per cell axis for thermal properties (nearest tile lookup) */
+	UPROPERTY(Config, EditAnywhere, BlueprintReadWrite, Category = "Surface|Thermal", meta = (ClampMin = "1", ClampMax = "64"))
+	int32 MaterialSampleResolution = 16;
+
+	/** Tiles of a dropped cell whose field differs from their deltas by more than this (K) are written back */
+	UPROPERTY(Config, EditAnywhere, BlueprintReadWrite, Category = "Surface|Thermal", meta = (ClampMin = "0"))
+	float WritebackThresholdK = 0.5f;
+
+private:
+	void HandleSurfaceDeltasChanged(const IDeltaStore* Store, const FWorldCellKey& CellKey, int32 TileIndex, const FSurfaceTileDelta* AppendedDelta);
+
+	/** Add cells entering the simulation radius, drop cells leaving it */
+	void UpdateCellSet(const FWorldCellKey& Center);
+
+	/** Properties from the biome specs, temperature from the cell's deltas */
+	void SeedCell(const FWorldCellKey& CellKey, FSurfaceThermalCell& Cell, double Now) const;
+
+	/** Record a dropped cell's field as Set deltas in the bound store */
+	void WriteBackCell(const FWorldCellKey& CellKey, const FSurfaceThermalCell& Cell) const;
+
+	/** Fill the halos of a cell from its neighbours */
+	void GatherHalo(const FWorldCellKey& CellKey, FSurfaceThermalCell& Cell) const;
+
+	double GetSimTime() const;
+
+	TMap<FWorldCellKey, FSurfaceThermalCell> Cells;
+
+	/** Cells waiting to be seeded (not yet in Cells), nearest first */
+	TArray<FWorldCellKey> PendingSeeds;
+
+	FWorldCellKey ViewCenter;
+	bool bHasView = false;
+
+	/** Last view Z, the start height for biome terrain sampling */
+	float ViewHeight = 0.0f;
+
+	FDelegateHandle SurfaceDeltasChangedHandle;
+};
@@ -15,6 +15,8 @@
  * - Time scale for fast-forward/slow-motion
  * - Fixed timestep mode for deterministic physics
  * - Negative time scale support (with bAllowNegativeTimeScale)
+ * - Multi-rate delivery: coalesced per-frame events and rate-limited subscriptions
+ * - Opt-in rewind keyframes: rewind and scrubbing jump to a snapshot and replay forward
  * 
  * Usage:
  *   UTimeSubsystem* Time = GameInstance->GetSubsystem<UTimeSubsystem>();
@@ -38,6 +40,21 @@
 
 DECLARE_MULTICAST_DELEGATE_OneParam(FOnSimTimeAdvanced, double);
 
+/** NewSimTimeSeconds, NumSteps (fixed steps taken this Advance; 1 in RealTime mode) */
+DECLARE_MULTICAST_DELEGATE_TwoParams(FOnSimTimeStepped, double, int32);
+
+/** NewSimTimeSeconds, ElapsedSimSeconds (since this subscriber was last called) */
+DECLARE_DELEGATE_TwoParams(FOnSimTimeInterval, double, double);
+
+/** Pause, time scale or clock mode changed, or ScrubToSimTime jumped: extrapolations from the last rate must resync */
+DECLARE_MULTICAST_DELEGATE(FOnSimClockChanged);
+
+/** KeyframeSimTimeSeconds: state was restored from this rewind keyframe, replay to the target follows */
+DECLARE_MULTICAST_DELEGATE_OneParam(FOnSimTimeRewound, double);
+
+/** Saves (Ar.IsSaving) or restores (Ar.IsLoading) a system's state in a rewind keyframe */
+DECLARE_DELEGATE_OneParam(FOnSerializeRewindState, FArchive& /*Ar*/);
+
 /**
  * Simulation clock mode - determines how time advances.
  */
@@ -76,6 +93,35 @@ enum class ESimClockMode : uint8
  * - Fixed timestep accumulates real delta and steps in discrete intervals
  * - Prevents floating point drift over long sessions
  * 
+ * Event Delivery (cost is O(listeners) per frame, not O(steps x listeners)):
+ * - OnSimTimeAdvanced / OnSimTimeStepped fire once per Advance, after all fixed
+ *   steps of the frame; OnSimTimeStepped carries the step count
+ * - SubscribeSimTime() listeners are called at most at their own real-time rate
+ *   with the sim time elapsed since their last call
+ * - MaxFixedStepsPerAdvance caps catch-up; steps beyond it are dropped
+ * - bBroadcastEachFixedStep restores one OnSimTimeAdvanced per step (bounded by the cap)
+ * - OnSimClockChanged fires when the clock rate changes or ScrubToSimTime jumps, so
+ *   systems that extrapolate sim time from a rate (e.g. the starfield's sidereal
+ *   rotation) can resync only then
+ * 
+ * Rewind Keyframes (opt-in, SetRewindKeyframesEnabled):
+ * - While time moves forward a keyframe is taken every RewindKeyframeInterval sim
+ *   seconds into a ring of MaxRewindKeyframes: the sim time plus each state
+ *   registered with RegisterRewindState. Only history-dependent state needs one;
+ *   state that is a function of sim time (the solar snapshot) just recomputes
+ * - Moving backward (negative time scale, ScrubToSimTime) can restore the latest
+ *   keyframe at or before the target, fire OnSimTimeRewound, then replay to the
+ *   target. That is only done when the keyframe holds registered state (restoring
+ *   just the clock gains nothing) and, with bBroadcastEachFixedStep, when the
+ *   replay takes no more per-step broadcasts than stepping back would; otherwise
+ *   rewind steps back as before. A slow continuous rewind therefore steps back,
+ *   while a long jump back lands on a keyframe
+ * - UWeatherFieldSubsystem registers its grid; the solar snapshot is a function of
+ *   sim time and needs no keyframe
+ * - ScrubToSimTime only moves backward, within the keyframe history, and needs
+ *   bAllowNegativeTimeScale; without registered state it just moves the clock
+ * - Moving forward from a rewound time drops the keyframes after it (a new timeline)
+ * 
  * @note Manages a central clock with pause, time scale, and deterministic fixed-step modes
  * @note All worlds tick from this unified time source via TimeWorldBridgeSubsystem
  */
@@ -145,10 +191,84 @@ public:
 	 * @note Rewind requires simulation state to be rewindable (snapshots/deltas)
 	 * @note Most physics simulations are not naturally rewindable
 	 * @note This is application-defined - subsystem only enforces the flag
+	 * @see SetRewindKeyframesEnabled to rewind from snapshots instead of step by step
 	 */
 	UFUNCTION(BlueprintCallable, Category="Time")
 	void SetAllowNegativeTimeScale(bool bAllow);
 
+	/**
+	 * Cap the fixed steps a single Advance may take. Time beyond the cap is dropped
+	 * rather than carried, so a slow frame can't snowball into the next.
+	 * 
+	 * @param InMaxSteps - Maximum steps per Advance (at least 1)
+	 */
+	UFUNCTION(BlueprintCallable, Category="Time")
+	void SetMaxFixedStepsPerAdvance(int32 InMaxSteps);
+
+	/**
+	 * Broadcast OnSimTimeAdvanced for every fixed step instead of once per Advance.
+	 * Only for listeners that integrate per step; expensive at high time scales.
+	 */
+	UFUNCTION(BlueprintCallable, Category="Time")
+	void SetBroadcastEachFixedStep(bool bEnable);
+
+	// ---- Rewind keyframes ----
+
+	/** Take rewind keyframes while time moves forward; disabling drops them */
+	UFUNCTION(BlueprintCallable, Category="Time|Rewind")
+	void SetRewindKeyframesEnabled(bool bEnable);
+
+	/** Sim seconds between keyframes; shorter replays, more keyframes for the same history */
+	UFUNCTION(BlueprintCallable, Category="Time|Rewind")
+	void SetRewindKeyframeInterval(double InSimSeconds);
+
+	/** Ring size; history reaches back about MaxKeyframes x interval. Drops the current keyframes. */
+	UFUNCTION(BlueprintCallable, Category="Time|Rewind")
+	void SetMaxRewindKeyframes(int32 InMaxKeyframes);
+
+	/**
+	 * Jump back to TargetSimTimeSeconds, restoring registered state from the latest
+	 * keyframe at or before it (just the clock when none is registered), then
+	 * broadcast OnSimClockChanged so rate extrapolations re-anchor.
+	 * 
+	 * @return false (time unchanged) without such a keyframe, for a target after the
+	 *         current time (keyframes can't replay ahead), or without bAllowNegativeTimeScale
+	 * @note Dispatches like an Advance of one step
+	 */
+	UFUNCTION(BlueprintCallable, Category="Time|Rewind")
+	bool ScrubToSimTime(double TargetSimTimeSeconds);
+
+	UFUNCTION(BlueprintPure, Category="Time|Rewind")
+	int32 GetNumRewindKeyframes() const { return NumRewindKeyframes; }
+
+	/** Sim time of the oldest keyframe, the limit of ScrubToSimTime (current time without keyframes) */
+	UFUNCTION(BlueprintPure, Category="Time|Rewind")
+	double GetEarliestRewindSimTime() const;
+
+	/**
+	 * Include a system's state in every keyframe. Delegate saves it at capture and
+	 * restores it when time rewinds onto the keyframe.
+	 * 
+	 * @param Name - Identifies the state across keyframes (one registration per name)
+	 * @return Handle for UnregisterRewindState (invalid if Name is taken)
+	 */
+	FDelegateHandle RegisterRewindState(FName Name, FOnSerializeRewindState Delegate);
+
+	void UnregisterRewindState(FDelegateHandle Handle);
+
+	// ---- Subscriptions ----
+
+	/**
+	 * Call Delegate when sim time advances, at most RateHz times per real second.
+	 * 
+	 * @param RateHz - Desired real-time update rate (0 = every Advance that moves time)
+	 * @param Delegate - Receives the new sim time and the sim seconds since its last call
+	 * @return Handle for UnsubscribeSimTime
+	 */
+	FDelegateHandle SubscribeSimTime(float RateHz, FOnSimTimeInterval Delegate);
+
+	void UnsubscribeSimTime(FDelegateHandle Handle);
+
 	// ---- Read ----
     UFUNCTION(BlueprintPure, Category="Time")
     float GetCurrentTimeOfDayHours() const
@@ -166,13 +286,26 @@ public:
 	UFUNCTION(BlueprintPure, Category="Time")
 	bool IsPaused() const { return bPaused; }
 
+	/** Sim seconds per second of world delta time: 0 when paused, else TimeScale */
+	UFUNCTION(BlueprintPure, Category="Time")
+	double GetSimRate() const { return bPaused ? 0.0 : TimeScale; }
+
 	UFUNCTION(BlueprintPure, Category="Time")
 	double GetStepSeconds() const { return (ClockMode == ESimClockMode::FixedStep) ? FixedStepSeconds : LastStepSeconds; }
 
 	// Broadcast for systems that want a single, authoritative “time advanced” signal.
-
+	// Fires once per Advance with the final time (see bBroadcastEachFixedStep).
 	FOnSimTimeAdvanced OnSimTimeAdvanced;
 
+	// Coalesced "advanced by N steps" signal, once per Advance.
+	FOnSimTimeStepped OnSimTimeStepped;
+
+	// Fires after SetPaused/SetTimeScale/SetClockMode change how fast sim time advances.
+	FOnSimClockChanged OnSimClockChanged;
+
+	// Fires when rewind restores a keyframe, before the replay's OnSimTimeAdvanced.
+	FOnSimTimeRewound OnSimTimeRewound;
+
 	// Called by world bridge (or any system) once per frame.
 	void Advance(double RealDeltaSeconds);
 
@@ -192,6 +325,62 @@ private:
 	// Accumulator for fixed-step
 	double Accumulator = 0.0;
 
+	// Catch-up cap and per-step compatibility mode
+	int32 MaxFixedStepsPerAdvance = 4096;
+	bool bBroadcastEachFixedStep = false;
+
+	struct FSimTimeSubscription
+	{
+		FOnSimTimeInterval Delegate;
+		double IntervalSeconds = 0.0;
+		double RealSecondsSinceCall = 0.0;
+		double LastSimTimeSeconds = 0.0;
+	};
+	TArray<FSimTimeSubscription> Subscriptions;
+
+	// Rewind keyframes
+	struct FRewindState
+	{
+		FName Name;
+		FOnSerializeRewindState Delegate;
+	};
+	TArray<FRewindState> RewindStates;
+
+	struct FRewindKeyframe
+	{
+		double SimTimeSeconds = 0.0;
+		TArray<TPair<FName, TArray<uint8>>> States;
+	};
+
+	// Ring, oldest at RewindHead; slots are reused so capture doesn't reallocate
+	TArray<FRewindKeyframe> RewindKeyframes;
+	int32 RewindHead = 0;
+	int32 NumRewindKeyframes = 0;
+
+	bool bRewindKeyframes = false;
+	double RewindKeyframeIntervalSeconds = 60.0;
+	int32 MaxRewindKeyframes = 256;
+
+	// Deliver this Advance's result to all listeners
+	void DispatchAdvance(double RealDeltaSeconds, int32 NumSteps);
+
+	// Keyframe Age from the oldest
+	const FRewindKeyframe& GetRewindKeyframe(int32 Age) const { return RewindKeyframes[(RewindHead + Age) % RewindKeyframes.Num()]; }
+
+	// Age of the latest keyframe at or before SimTime, INDEX_NONE without one (or with keyframes disabled)
+	int32 FindRewindKeyframe(double InSimTimeSeconds) const;
+
+	// Age of the keyframe to rewind onto instead of taking StepBackSteps steps back, INDEX_NONE to step back
+	int32 ChooseRewindKeyframe(double TargetSimTimeSeconds, int32 StepBackSteps) const;
+
+	// Restore the keyframe and replay to the target; leaves SimTimeSeconds at the target
+	void RewindToKeyframe(int32 Age, double TargetSimTimeSeconds);
+
+	// Take a keyframe if due after moving forward from PreviousSimTimeSeconds
+	void RecordRewindKeyframe(double PreviousSimTimeSeconds);
+
+	void ClearRewindKeyframes();
+
 	// Guards
 	void ClampAndValidate();
 };
@@ -0,0 +1,258 @@
+// Copyright 2026 Threaded Pixel Factory
+// Licensed under the Apache License, Version 2.0 (the "License");
+// SPDX-License-Identifier: Apache-2.0
+
+/**
+ * Weather Field Subsystem - Spatially varying weather around the view
+ *
+ * Purpose:
+ * Replaces the single global FRuntimeWeatherState with a coarse grid, so one
+ * valley can be under a storm while the next ridge is clear, and weather drifts
+ * in with the wind instead of switching everywhere at once.
+ *
+ * Grid:
+ * - GridCellsPerAxis^2 weather cells of FWorldCellKey at WeatherCellLOD
+ *   (512 m with the defaults), centered on the view and keyed by absolute position
+ * - Each cell stores every FRuntimeWeatherState channel (SoA planes), plus the
+ *   ground wetness rain has left behind
+ * - Cells entering the window as the view moves start at BaseWeather
+ *
+ * Step (every StepIntervalSeconds of sim time, on a worker thread):
+ * - Semi-Lagrangian advection of clouds, fog, rain, storm, humidity and wind by
+ *   the wind itself: each cell pulls its value from upwind, so any step is stable
+ * - Relaxation towards BaseWeather over BaseRelaxationSeconds
+ * - Queued weather stamps (regional storms, fog banks) blended in
+ * - Ground wetness rises with Precip01 and dries over GroundDryingSeconds
+ * The worker reads an immutable snapshot and builds a new one; the game thread
+ * swaps it in when done, so queries never wait on a step.
+ *
+ * Rewind:
+ * - The grid depends on its whole history, so it registers with
+ *   UTimeSubsystem::RegisterRewindState; rewinding onto a keyframe restores it
+ * - Stepping back in sim time without a keyframe leaves the weather as it is
+ *
+ * Consumers:
+ * - AUniversalSkyActor samples the field at the view (bUseWeatherField); its
+ *   ApplyEnvironment weather becomes BaseWeather
+ * - USurfaceQuerySubsystem::GetWetnessAtLocation adds the ground wetness
+ * Samples interpolate bilinearly between cell centers; outside the window they
+ * return BaseWeather (and no ground wetness).
+ *
+ * Usage:
+ *   UWeatherFieldSubsystem* Weather = World->GetSubsystem<UWeatherFieldSubsystem>();
+ *   FRuntimeWeatherState Storm;
+ *   Storm.CloudCover01 = 1.0f;
+ *   Storm.Precip01 = 0.9f;
+ *   Storm.Storm01 = 0.8f;
+ *   Weather->AddWeatherStamp(StormCenter, 300000.0f, Storm);
+ *
+ * @see FRuntimeWeatherState for the channels
+ * @see AUniversalSkyActor::bUseWeatherField
+ */
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Tasks/Task.h"
+#include "DeltaTypes.h"
+#include "Environment/UniversalSkyActor.h"
+#include "WeatherFieldSubsystem.generated.h"
+
+/**
+ * One snapshot of the weather grid. Planes are row-major, Size^2 cells, cell
+ * (0, 0) at Origin.
+ */
+struct UETPFCORE_API FWeatherFieldGrid
+{
+	/** Weather cell at index (0, 0) */
+	FWorldCellKey Origin;
+
+	/** Cells per axis */
+	int32 Size = 0;
+
+	/** Edge length of one weather cell (cm) */
+	float CellSize = 0.0f;
+
+	TArray<float> CloudCover;
+	TArray<float> Fog;
+	TArray<float> Precip;
+	TArray<float> Storm;
+	TArray<float> Humidity;
+
+	/** Wind velocity (m/s) */
+	TArray<float> WindX;
+	TArray<float> WindY;
+
+	/** Ground wetness left by precipitation (0-1); not advected */
+	TArray<float> GroundWetness;
+
+	/** Allocate Size^2 cells of Weather, dry ground */
+	void Init(const FWorldCellKey& InOrigin, int32 InSize, float InCellSize, const FRuntimeWeatherState& Weather);
+
+	/** Bilinear sample at an absolute location; Outside fills cells beyond the window */
+	FRuntimeWeatherState Sample(const FVector& AbsoluteLocation, const FRuntimeWeatherState& Outside) const;
+
+	/** Bilinear ground wetness at an absolute location (0 beyond the window) */
+	float SampleGroundWetness(const FVector& AbsoluteLocation) const;
+
+	/** Bilinear sample of one plane at grid coordinates (cell units, 0 = center of cell 0) */
+	float SamplePlane(const TArray<float>& Plane, float OutsideValue, double GridX, double GridY) const;
+
+	/** Grid coordinates of an absolute location */
+	FVector2D ToGrid(const FVector& AbsoluteLocation) const;
+
+	/** Save or load the whole grid (rewind keyframes) */
+	void Serialize(FArchive& Ar);
+
+	int32 Num() const { return Size * Size; }
+};
+
+/** Weather blended into the field around a point on the next step */
+struct FWeatherStamp
+{
+	FVector AbsoluteLocation = FVector::ZeroVector;
+	float Radius = 0.0f;
+	FRuntimeWeatherState Weather;
+	float Strength = 1.0f;
+};
+
+/**
+ * World subsystem advecting a coarse weather grid around the view.
+ */
+UCLASS(Config = Game)
+class UETPFCORE_API UWeatherFieldSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	//--- UWorldSubsystem Interface ---
+	virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+
+	//--- UTickableWorldSubsystem Interface ---
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override { RETURN_QUICK_DECLARE_CYCLE_STAT(UWeatherFieldSubsystem, STATGROUP_Tickables); }
+
+	/** Interpolated weather at a world location; BaseWeather outside the field */
+	UFUNCTION(BlueprintPure, Category = "Weather")
+	FRuntimeWeatherState SampleWeather(const FVector& WorldLocation) const;
+
+	/** SampleWeather at an absolute location (world + origin) */
+	FRuntimeWeatherState SampleWeatherAbsolute(const FVector& AbsoluteLocation) const;
+
+	/** Ground wetness from rain at a world location (0-1) */
+	UFUNCTION(BlueprintPure, Category = "Weather")
+	float GetGroundWetnessAtLocation(const FVector& WorldLocation) const;
+
+	/** GetGroundWetnessAtLocation at an absolute location (world + origin) */
+	float SampleGroundWetnessAbsolute(const FVector& AbsoluteLocation) const;
+
+	/** Weather the field relaxes to and fills new cells with */
+	UFUNCTION(BlueprintCallable, Category = "Weather")
+	void SetBaseWeather(const FRuntimeWeatherState& Weather);
+
+	UFUNCTION(BlueprintPure, Category = "Weather")
+	FRuntimeWeatherState GetBaseWeather() const { return BaseWeather; }
+
+	/**
+	 * Blend Weather into the field around WorldLocation on the next step, fully at
+	 * the center (times Strength) and fading out at RadiusCm. The stamp then drifts
+	 * with the wind and relaxes back to BaseWeather; stamp again to sustain it.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Weather")
+	void AddWeatherStamp(const FVector& WorldLocation, float RadiusCm, const FRuntimeWeatherState& Weather, float Strength = 1.0f);
+
+	/** Drop the field; it restarts at BaseWeather around the view */
+	UFUNCTION(BlueprintCallable, Category = "Weather")
+	void ResetField();
+
+	/** True once the first grid exists */
+	UFUNCTION(BlueprintPure, Category = "Weather")
+	bool HasField() const { return Field.IsValid(); }
+
+	//==========================================================================
+	// CONFIGURATION
+	//==========================================================================
+
+	/** Delta grid cell size (cm); weather cells are this at WeatherCellLOD */
+	UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Weather", meta = (ClampMin = "100"))
+	float DeltaCellSize = 6400.0f;
+
+	/** FWorldCellKey LOD of one weather cell (edge = DeltaCellSize * 2^LOD) */
+	UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Weather", meta = (ClampMin = "0", ClampMax = "12"))
+	int32 WeatherCellLOD = 3;
+
+	/** Weather cells per axis of the window around the view */
+	UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Weather", meta = (ClampMin = "2", ClampMax = "256"))
+	int32 GridCellsPerAxis = 32;
+
+	/** Sim seconds between advection steps */
+	UPROPERTY(Config, EditAnywhere, BlueprintReadWrite, Category = "Weather", meta = (ClampMin = "0"))
+	float StepIntervalSeconds = 1.0f;
+
+	/** Weather with no local disturbance; new cells start here and old ones relax to it */
+	UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Weather")
+	FRuntimeWeatherState BaseWeather;
+
+	/** Time constant of the relaxation to BaseWeather (sim seconds; 0 = never) */
+	UPROPERTY(Config, EditAnywhere, BlueprintReadWrite, Category = "Weather", meta = (ClampMin = "0"))
+	float BaseRelaxationSeconds = 1800.0f;
+
+	/** Sim seconds of full rain (Precip01 = 1) to soak dry ground */
+	UPROPERTY(Config, EditAnywhere, BlueprintReadWrite, Category = "Weather", meta = (ClampMin = "1"))
+	float GroundSoakSeconds = 600.0f;
+
+	/** Time constant of the ground drying out (sim seconds) */
+	UPROPERTY(Config, EditAnywhere, BlueprintReadWrite, Category = "Weather", meta = (ClampMin = "1"))
+	float GroundDryingSeconds = 3600.0f;
+
+private:
+	using FWeatherFieldPtr = TSharedPtr<const FWeatherFieldGrid, ESPMode::ThreadSafe>;
+
+	/** Settings a step runs with, copied so the worker touches no UObject */
+	struct FStepParams
+	{
+		FWorldCellKey Origin;
+		int32 Size = 0;
+		float CellSize = 0.0f;
+		float DeltaSeconds = 0.0f;
+		FRuntimeWeatherState Base;
+		float RelaxationSeconds = 0.0f;
+		float SoakSeconds = 1.0f;
+		float DryingSeconds = 1.0f;
+		TArray<FWeatherStamp> Stamps;
+	};
+
+	/** Build the next grid from Previous (worker thread) */
+	static FWeatherFieldPtr StepField(const FWeatherFieldGrid& Previous, const FStepParams& Params);
+
+	/** Swap in a finished step */
+	void CompleteStep();
+
+	/** Save or restore the grid and step time for a rewind keyframe */
+	void SerializeRewindState(FArchive& Ar);
+
+	/** Window origin placing the view's weather cell in the middle */
+	FWorldCellKey GetWindowOrigin(const FVector& AbsoluteViewLocation) const;
+
+	float GetWeatherCellSize() const;
+	double GetSimTime() const;
+	FVector ToAbsoluteLocation(const FVector& WorldLocation) const;
+
+	/** Latest published grid; read on the game thread, never mutated */
+	FWeatherFieldPtr Field;
+
+	/** In-flight step */
+	UE::Tasks::TTask<FWeatherFieldPtr> PendingStep;
+
+	/** Stamps waiting for the next step */
+	TArray<FWeatherStamp> PendingStamps;
+
+	/** Sim time the last step was launched at */
+	double LastStepSimTime = 0.0;
+
+	/** Registration with UTimeSubsystem's rewind keyframes */
+	FDelegateHandle RewindStateHandle;
+};
@@ -0,0 +1,73 @@
+// Copyright 2026 Threaded Pixel Factory
+// Licensed under the Apache License, Version 2.0 (the "License");
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include "Stats/Stats.h"
+#include "ProfilingDebugging/CsvProfiler.h"
+
+/**
+ * Profiling instrumentation shared by UETPFCore and the modules built on it.
+ *
+ * - `stat TPFCore` shows the cycle stats, per-frame counters and memory stats below
+ * - Insights picks up the cycle stats as named CPU scopes
+ * - `-csvprofile` records the TPFCore CSV category (frame-level scopes and counters)
+ *
+ * Per-call scopes (queries) use cycle stats only; CSV markers are reserved for
+ * once-per-frame work so they stay cheap in production captures.
+ *
+ * Startup and level transitions are timed per phase by TPFTimingRecorder.h.
+ */
+
+DECLARE_STATS_GROUP(TEXT("TPF Core"), STATGROUP_TPFCore, STATCAT_Advanced);
+
+// Cycle stats
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Surface Query"), STAT_TPF_SurfaceQuery, STATGROUP_TPFCore, UETPFCORE_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Surface Batch Build"), STAT_TPF_SurfaceBatchBuild, STATGROUP_TPFCore, UETPFCORE_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Surface Atlas Upload"), STAT_TPF_SurfaceAtlasUpload, STATGROUP_TPFCore, UETPFCORE_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Surface Thermal Step"), STAT_TPF_SurfaceThermalStep, STATGROUP_TPFCore, UETPFCORE_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Weather Field Step"), STAT_TPF_WeatherFieldStep, STATGROUP_TPFCore, UETPFCORE_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Environment Query"), STAT_TPF_EnvironmentQuery, STATGROUP_TPFCore, UETPFCORE_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Environment Batch Query"), STAT_TPF_EnvironmentBatchQuery, STATGROUP_TPFCore, UETPFCORE_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Environment Snapshot Build"), STAT_TPF_EnvironmentSnapshotBuild, STATGROUP_TPFCore, UETPFCORE_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Environment GPU Grid Bake"), STAT_TPF_EnvironmentGridBake, STATGROUP_TPFCore, UETPFCORE_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Biome Query"), STAT_TPF_BiomeQuery, STATGROUP_TPFCore, UETPFCORE_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("PhysicsIntegration Tick"), STAT_TPF_PhysicsIntegrationTick, STATGROUP_TPFCore, UETPFCORE_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Delta Flush (Game Thread)"), STAT_TPF_DeltaFlush, STATGROUP_TPFCore, UETPFCORE_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Delta Flush Write"), STAT_TPF_DeltaFlushWrite, STATGROUP_TPFCore, UETPFCORE_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Delta Journal Compaction"), STAT_TPF_DeltaCompaction, STATGROUP_TPFCore, UETPFCORE_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Delta Streaming Apply"), STAT_TPF_DeltaStreamingApply, STATGROUP_TPFCore, UETPFCORE_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Delta Replication Send"), STAT_TPF_DeltaReplication, STATGROUP_TPFCore, UETPFCORE_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Star Catalog Load"), STAT_TPF_StarCatalogLoad, STATGROUP_TPFCore, UETPFCORE_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("SpecPack Load"), STAT_TPF_SpecPackLoad, STATGROUP_TPFCore, UETPFCORE_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Sky Apply Environment"), STAT_TPF_SkyApplyEnvironment, STATGROUP_TPFCore, UETPFCORE_API);
+
+// Per-frame counters
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Surface Queries"), STAT_TPF_SurfaceQueries, STATGROUP_TPFCore, UETPFCORE_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Surface Cache Hits"), STAT_TPF_SurfaceCacheHits, STATGROUP_TPFCore, UETPFCORE_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Surface Atlas Texels Uploaded"), STAT_TPF_SurfaceAtlasTexels, STATGROUP_TPFCore, UETPFCORE_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Thermal Cells Stepped"), STAT_TPF_ThermalCellsStepped, STATGROUP_TPFCore, UETPFCORE_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Environment Queries"), STAT_TPF_EnvironmentQueries, STATGROUP_TPFCore, UETPFCORE_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Environment Volume Tests"), STAT_TPF_VolumeTests, STATGROUP_TPFCore, UETPFCORE_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Biome Queries"), STAT_TPF_BiomeQueries, STATGROUP_TPFCore, UETPFCORE_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Biome Tile Cache Hits"), STAT_TPF_BiomeTileCacheHits, STATGROUP_TPFCore, UETPFCORE_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Physics Bodies Serviced"), STAT_TPF_BodiesServiced, STATGROUP_TPFCore, UETPFCORE_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Physics Bodies Active"), STAT_TPF_BodiesActive, STATGROUP_TPFCore, UETPFCORE_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Impacts Queued"), STAT_TPF_ImpactsQueued, STATGROUP_TPFCore, UETPFCORE_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Sky Updates Applied"), STAT_TPF_SkyUpdatesApplied, STATGROUP_TPFCore, UETPFCORE_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Sky Updates Skipped"), STAT_TPF_SkyUpdatesSkipped, STATGROUP_TPFCore, UETPFCORE_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Streamed Deltas Applied"), STAT_TPF_StreamedDeltasApplied, STATGROUP_TPFCore, UETPFCORE_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Delta Replication Bytes"), STAT_TPF_DeltaReplicationBytes, STATGROUP_TPFCore, UETPFCORE_API);
+
+// Running totals
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Delta Resident Cells"), STAT_TPF_DeltaResidentCells, STATGROUP_TPFCore, UETPFCORE_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Delta Cell Evictions"), STAT_TPF_DeltaCellEvictions, STATGROUP_TPFCore, UETPFCORE_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Delta Cell Reloads"), STAT_TPF_DeltaCellReloads, STATGROUP_TPFCore, UETPFCORE_API);
+
+// Memory
+DECLARE_MEMORY_STAT_EXTERN(TEXT("Delta Cell Cache"), STAT_TPF_DeltaCacheMemory, STATGROUP_TPFCore, UETPFCORE_API);
+DECLARE_MEMORY_STAT_EXTERN(TEXT("Delta Pending Appends"), STAT_TPF_DeltaPendingMemory, STATGROUP_TPFCore, UETPFCORE_API);
+DECLARE_MEMORY_STAT_EXTERN(TEXT("Delta Cache Budget"), STAT_TPF_DeltaCacheBudget, STATGROUP_TPFCore, UETPFCORE_API);
+
+CSV_DECLARE_CATEGORY_MODULE_EXTERN(UETPFCORE_API, TPFCore);
@@ -0,0 +1,118 @@
+// Copyright 2026 Threaded Pixel Factory
+// Licensed under the Apache License, Version 2.0 (the "License");
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/CriticalSection.h"
+#include <atomic>
+
+class UWorld;
+
+/**
+ * Timing recorder for boot and level transitions.
+ *
+ * Complements TPFCoreStats.h, which covers steady-state frames. This one answers
+ * "where did the 8 seconds of startup go" with numbers CI can track per build.
+ *
+ * - A session spans one startup or one transition ("Startup", "Travel_Moon");
+ *   it is an Insights region of the same name
+ * - Phases inside it come from TPF_TIMING_SCOPE (also an Insights CPU scope) or
+ *   RecordPhase for work spanning frames; each records its start, duration,
+ *   bytes read (AddBytesRead) and the change in used physical memory
+ * - EndSession writes Saved/Profiling/TPFTiming/<Session>_<timestamp>.json
+ *
+ * Memory deltas are process-wide, so phases overlapping other work (worker
+ * threads, async loading) include that work's allocations too.
+ * Outside a session scopes still emit their Insights events but record nothing.
+ */
+
+/** One measured phase of a session */
+struct FTPFTimingPhase
+{
+	FString Name;
+
+	/** Since the session began (ms) */
+	double StartMs = 0.0;
+	double DurationMs = 0.0;
+
+	int64 BytesRead = 0;
+
+	/** Used physical memory at the end minus at the start (process-wide) */
+	int64 AllocatedBytes = 0;
+
+	bool bGameThread = true;
+};
+
+class UETPFCORE_API FTPFTimingRecorder
+{
+public:
+	static FTPFTimingRecorder& Get();
+
+	/**
+	 * Open a session (game thread). An open session is written (as incomplete) first.
+	 * @param EndOnMapLoaded - Map whose load closes the session, NAME_None to close it with EndSession
+	 */
+	void BeginSession(const FString& SessionName, FName EndOnMapLoaded = NAME_None);
+
+	/** Write and close the session if SessionName is the open one (game thread) */
+	void EndSession(const FString& SessionName, bool bCompleted = true);
+
+	bool IsSessionOpen() const { return bSessionOpen.load(std::memory_order_relaxed); }
+
+	/** Record a phase measured elsewhere, in FPlatformTime::Seconds (any thread) */
+	void RecordPhase(const FString& Name, double StartSeconds, double EndSeconds, int64 BytesRead = 0, int64 AllocatedBytes = 0);
+
+	/** Attribute bytes read to the innermost TPF_TIMING_SCOPE on this thread (no-op outside one) */
+	static void AddBytesRead(int64 Bytes);
+
+	/** Used physical memory now, the basis of the phase memory deltas */
+	static uint64 GetUsedPhysicalBytes();
+
+private:
+	friend class FTPFTimingScope;
+
+	void AddPhase(FTPFTimingPhase&& Phase, double StartSeconds);
+	void HandlePostLoadMap(UWorld* LoadedWorld);
+	void WriteSession(bool bCompleted);
+
+	mutable FCriticalSection Lock;
+
+	FString SessionName;
+	double SessionStartSeconds = 0.0;
+	uint64 SessionStartUsedPhysical = 0;
+	TArray<FTPFTimingPhase> Phases;
+
+	FName EndOnMapLoaded;
+	FDelegateHandle PostLoadMapHandle;
+
+	std::atomic<bool> bSessionOpen = false;
+};
+
+/** Times the enclosing scope as a phase of the open session */
+class UETPFCORE_API FTPFTimingScope
+{
+public:
+	explicit FTPFTimingScope(const TCHAR* InName);
+	explicit FTPFTimingScope(FString&& InName);
+	~FTPFTimingScope();
+
+	FTPFTimingScope(const FTPFTimingScope&) = delete;
+	FTPFTimingScope& operator=(const FTPFTimingScope&) = delete;
+
+	void AddBytesRead(int64 Bytes) { BytesRead += Bytes; }
+
+private:
+	void Begin();
+
+	FString Name;
+	double StartSeconds = 0.0;
+	uint64 StartUsedPhysical = 0;
+	int64 BytesRead = 0;
+	FTPFTimingScope* Outer = nullptr;
+	bool bRecording = false;
+	bool bTraced = false;
+};
+
+#define TPF_TIMING_SCOPE(Name) FTPFTimingScope ANONYMOUS_VARIABLE(TPFTimingScope_)(Name)
@@ -23,10 +23,12 @@ public class UETPFCore : ModuleRules
 
 		PrivateDependencyModuleNames.AddRange(new string[] { 
 			"Landscape",
+			"Json",
 			"RenderCore",
 			"RHI",
 			"Renderer",
-			"UnrealEd"  // Required for UMaterialFactoryNew
+			"NiagaraShader",
+			"VectorVM"
 		});
 	}
 }
@@ -10,7 +10,6 @@
 #include "Factories/MaterialFactoryNew.h"
 #include "AssetRegistry/AssetRegistryModule.h"
 #include "UObject/SavePackage.h"
-#include "NiagaraComponent.h"
 #include "Misc/PackageName.h"
 
 UMaterial* UMaterialCreator::CreateStarMaterial(
@@ -111,24 +110,6 @@ UMaterial* UMaterialCreator::CreateStarMaterial(
 	return Material;
 }
 
-void UMaterialCreator::ApplyMaterialToNiagara(
-	UNiagaraComponent* NiagaraComponent,
-	UMaterialInterface* Material,
-	int32 ElementIndex)
-{
-	if (!NiagaraComponent || !Material)
-	{
-		UE_LOG(LogTemp, Error, TEXT("MaterialCreator: Invalid NiagaraComponent or Material"));
-		return;
-	}
-
-	// Set material on Niagara renderer
-	NiagaraComponent->SetMaterial(ElementIndex, Material);
-
-	UE_LOG(LogTemp, Warning, TEXT("✅ MaterialCreator: Applied material %s to Niagara component at index %d"),
-		*Material->GetName(), ElementIndex);
-}
-
 UPackage* UMaterialCreator::CreateMaterialPackage(const FString& PackagePath, const FName& MaterialName)
 {
 	// Construct full package path
@@ -0,0 +1,34 @@
+// Copyright 2026 Threaded Pixel Factory
+// Licensed under the Apache License, Version 2.0 (the "License");
+// SPDX-License-Identifier: Apache-2.0
+
+#include "UETPFCoreEditor.h"
+#include "Materials/MaterialCreator.h"
+#include "HAL/IConsoleManager.h"
+#include "Modules/ModuleManager.h"
+
+namespace
+{
+	void CreateStarMaterialCommand(const TArray<FString>& Args)
+	{
+		const float Brightness = Args.Num() > 0 ? FCString::Atof(*Args[0]) : 1000.0f;
+		UMaterialCreator::CreateStarMaterial(TEXT("/Game/Core/Materials"), FName("M_StarProcedural"), Brightness);
+	}
+
+	FAutoConsoleCommand CreateStarMaterialConsoleCommand(
+		TEXT("TPF.Editor.CreateStarMaterial"),
+		TEXT("Create and save the starfield sprite material /Game/Core/Materials/M_StarProcedural. Args: [DefaultBrightness]"),
+		FConsoleCommandWithArgsDelegate::CreateStatic(&CreateStarMaterialCommand));
+}
+
+void FUETPFCoreEditorModule::StartupModule()
+{
+	UE_LOG(LogTemp, Log, TEXT("UETPFCoreEditor module starting up"));
+}
+
+void FUETPFCoreEditorModule::ShutdownModule()
+{
+	UE_LOG(LogTemp, Log, TEXT("UETPFCoreEditor module shutting down"));
+}
+
+IMPLEMENT_MODULE(FUETPFCoreEditorModule, UETPFCoreEditor)
@@ -10,11 +10,14 @@
 #include "MaterialCreator.generated.h"
 
 /**
- * WIP: Procedural material creation utility for runtime/editor material generation.
+ * WIP: Procedural material creation utility for editor material generation.
  * Provides type-safe API for creating physically-based materials from real-world values.
+ *
+ * Editor only: generated materials are saved as assets and cooked, then
+ * parameterized at runtime through UMaterialInstanceDynamic (see AUniversalSkyActor).
  */
 UCLASS()
-class UETPFCORE_API UMaterialCreator : public UObject
+class UETPFCOREEDITOR_API UMaterialCreator : public UObject
 {
 	GENERATED_BODY()
 
@@ -32,18 +35,6 @@ public:
 		const FName& MaterialName,
 		float DefaultBrightness = 1000.0f);
 
-	/**
-	 * Applies a procedurally-created material to a Niagara component.
-	 * 
-	 * @param NiagaraComponent Target component
-	 * @param Material Material to apply (must be Niagara-compatible)
-	 * @param ElementIndex Renderer element index (default 0)
-	 */
-	static void ApplyMaterialToNiagara(
-		class UNiagaraComponent* NiagaraComponent,
-		UMaterialInterface* Material,
-		int32 ElementIndex = 0);
-
 private:
 	/** Helper: Creates package and handles asset registration */
 	static UPackage* CreateMaterialPackage(const FString& PackagePath, const FName& MaterialName);
@@ -0,0 +1,26 @@
+// Copyright 2026 Threaded Pixel Factory
+// Licensed under the Apache License, Version 2.0 (the "License");
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Modules/ModuleInterface.h"
+
+/**
+ * UETPFCoreEditor Module
+ *
+ * Editor-only tooling for UETPFCore. Anything that needs UnrealEd (asset factories,
+ * package saving, shader-compiling asset generation) lives here so game builds
+ * never link it.
+ *
+ * Console commands:
+ * - TPF.Editor.CreateStarMaterial - (Re)generate the cooked starfield sprite material
+ *   (/Game/Core/Materials/M_StarProcedural) used by AUniversalSkyActor
+ */
+class FUETPFCoreEditorModule : public IModuleInterface
+{
+public:
+	virtual void StartupModule() override;
+	virtual void ShutdownModule() override;
+};
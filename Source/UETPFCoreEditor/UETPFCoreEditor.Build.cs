@@ -0,0 +1,25 @@
+// Copyright Threaded Pixel Factory. All Rights Reserved.
+// Licensed under the Apache License, Version 2.0. See LICENSE.txt in the project root for license information.
+
+using UnrealBuildTool;
+
+public class UETPFCoreEditor : ModuleRules
+{
+	public UETPFCoreEditor(ReadOnlyTargetRules Target) : base(Target)
+	{
+		PCHUsage = PCHUsageMode.UseExplicitOrSharedPCHs;
+		IWYUSupport = IWYUSupport.Full;
+
+		PublicDependencyModuleNames.AddRange(new string[] { 
+			"Core", 
+			"CoreUObject", 
+			"Engine",
+			"UETPFCore"
+		});
+
+		PrivateDependencyModuleNames.AddRange(new string[] { 
+			"AssetRegistry",
+			"UnrealEd"  // Required for UMaterialFactoryNew
+		});
+	}
+}